@@ -6,26 +6,538 @@
 **/
 
 #include <stdio.h>
+#include <string.h>
+#include <deque>
 
 #include "dpxfileio.h"
+#include "ajabase/system/event.h"
 #include "ajabase/system/file_io.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/memory.h"
+#include "ajabase/system/systemtime.h"
+#include "ajabase/system/thread.h"
 
 using std::string;
 using std::vector;
 
+#define AJA_DPX_IO_ALIGNMENT	4096	//	Buffer and read size alignment for unbuffered I/O
+
+
+static size_t RoundUp (const size_t inBytes, const size_t inAlignment)
+{
+	return (inBytes + inAlignment - 1) / inAlignment * inAlignment;
+}
+
+
+//	Answers with the payload size of the DPX file having the given header, or zero if it can't be determined.
+static size_t PayloadSize (DpxHdr & inHdr)
+{
+	const size_t imageSize = inHdr.get_ii_image_size();
+	if (imageSize != size_t(uint32_t(-1)))
+		return imageSize;
+	//	Unknown descriptor -- trust the file size in the header
+	const size_t fileSize = inHdr.get_fi_file_size(), imageOffset = inHdr.get_fi_image_offset();
+	return fileSize > imageOffset ? fileSize - imageOffset : 0;
+}
+
+
+//	Reads into the given aligned buffer until it's full or the end of the file is reached.
+static uint32_t ReadFully (AJAFileIO & inFile, uint8_t * pBuffer, const uint32_t inLength)
+{
+	uint32_t done = 0;
+	while (done < inLength)
+	{
+		const uint32_t bytesRead = inFile.Read (pBuffer + done, inLength - done);
+		if (!bytesRead)
+			break;
+		done += bytesRead;
+	}
+	return done;
+}
+
+
+//	Waits on an event that's cleared under the given lock, for at most the time remaining before a deadline.
+//	Returns false if the deadline has passed.
+static bool WaitUntil (AJAEvent & inEvent, const uint64_t inStartMs, const uint32_t inTimeoutMs)
+{
+	if (inTimeoutMs == 0xffffffff)
+	{
+		inEvent.WaitForSignal();
+		return true;
+	}
+	const uint64_t elapsedMs = AJATime::GetSystemMilliseconds() - inStartMs;
+	if (elapsedMs >= inTimeoutMs)
+		return false;
+	inEvent.WaitForSignal (uint32_t(inTimeoutMs - elapsedMs));
+	return true;
+}
+
+
+/**
+	Read-ahead engine for AJADPXFileIO. Keeps a window of frame buffers filled with the files at and after the
+	playback position, using a pool of reader threads. A buffer is only recycled once its frame falls out of the
+	window, so pausing or looping over a short sequence never re-reads anything.
+**/
+class AJADPXPrefetcher
+{
+	public:
+		AJADPXPrefetcher (const vector<string> & inFiles, const size_t inUniformBytes,
+						  const uint32_t inFramesAhead, const uint32_t inNumReaders)
+			:	mFiles			(inFiles),
+				mUniformBytes	(RoundUp(inUniformBytes, AJA_DPX_IO_ALIGNMENT)),
+				mWindow			(inFramesAhead < inFiles.size() ? inFramesAhead : uint32_t(inFiles.size())),
+				mCurrent		(0),
+				mLoop			(true),
+				mQuit			(false),
+				mWorkEvent		(true),
+				mReadyEvent		(true)
+		{
+			mSlots.resize(mWindow);
+			mReaders.resize(inNumReaders);
+			for (size_t ndx = 0;  ndx < mReaders.size();  ndx++)
+			{
+				mReaders[ndx] = new AJAThread;
+				mReaders[ndx]->Attach (ReaderThreadStatic, this);
+				mReaders[ndx]->Start();
+			}
+		}
+
+		~AJADPXPrefetcher ()
+		{
+			{
+				AJAAutoLock locker (&mLock);
+				mQuit = true;
+				mWorkEvent.Signal();
+			}
+			for (size_t ndx = 0;  ndx < mReaders.size();  ndx++)
+			{
+				mReaders[ndx]->Stop();
+				delete mReaders[ndx];
+			}
+			for (size_t ndx = 0;  ndx < mSlots.size();  ndx++)
+				AJAMemory::FreeAligned (mSlots[ndx].pBuffer);
+		}
+
+		//	Moves the read-ahead window to start at the given index
+		void SetPosition (const uint32_t inCurrent, const bool inLoop)
+		{
+			AJAAutoLock locker (&mLock);
+			mCurrent = inCurrent;
+			mLoop = inLoop;
+			mWorkEvent.Signal();
+		}
+
+		//	Waits for the given frame, then copies its header and payload out
+		AJAStatus Fetch (const uint32_t inIndex, uint8_t * pOutPayload, const uint32_t inPayloadBytes, DPX_header_t & outHdr)
+		{
+			Slot * pSlot = NULL;
+			while (!pSlot)
+			{
+				{
+					AJAAutoLock locker (&mLock);
+					for (size_t ndx = 0;  ndx < mSlots.size() && !pSlot;  ndx++)
+						if (mSlots[ndx].state == kReady && mSlots[ndx].index == inIndex)
+							pSlot = &mSlots[ndx];
+					if (!pSlot)
+						mReadyEvent.Clear();	//	Under the lock, so a completion can't slip by
+				}
+				if (!pSlot)
+					mReadyEvent.WaitForSignal();
+			}
+			//	The slot can't be recycled while inIndex is the playback position, so copy without the lock
+			if (pSlot->status != AJA_STATUS_SUCCESS)
+				return pSlot->status;
+			memcpy (&outHdr, pSlot->pBuffer, sizeof(DPX_header_t));
+			if (pSlot->payloadBytes > inPayloadBytes)
+				return AJA_STATUS_BAD_PARAM;
+			memcpy (pOutPayload, pSlot->pBuffer + pSlot->payloadOffset, pSlot->payloadBytes);
+			return AJA_STATUS_SUCCESS;
+		}
+
+	private:
+		enum {kEmpty, kLoading, kReady};
+
+		struct Slot
+		{
+			Slot () : state(kEmpty), index(0), pBuffer(NULL), capacity(0), payloadOffset(0), payloadBytes(0), status(AJA_STATUS_SUCCESS) {}
+			int			state;
+			uint32_t	index;
+			uint8_t *	pBuffer;
+			size_t		capacity;
+			size_t		payloadOffset;
+			size_t		payloadBytes;
+			AJAStatus	status;
+		};
+
+		//	Answers with the index that's the given number of frames ahead of the playback position (lock held)
+		bool IndexAhead (const uint32_t inAhead, uint32_t & outIndex) const
+		{
+			const uint32_t count (uint32_t(mFiles.size()));
+			if (mLoop)
+				outIndex = uint32_t((uint64_t(mCurrent) + inAhead) % count);
+			else
+				outIndex = mCurrent + inAhead;
+			return outIndex < count;
+		}
+
+		bool InWindow (const uint32_t inIndex) const
+		{
+			const uint32_t count (uint32_t(mFiles.size()));
+			const uint32_t ahead = mLoop ? (inIndex + count - mCurrent % count) % count : inIndex - mCurrent;
+			return (mLoop || inIndex >= mCurrent) && ahead < mWindow;
+		}
+
+		//	Picks the nearest frame in the window that isn't buffered, and a buffer to load it into (lock held)
+		Slot * ClaimSlot ()
+		{
+			for (uint32_t ahead = 0;  ahead < mWindow;  ahead++)
+			{
+				uint32_t index;
+				if (!IndexAhead (ahead, index))
+					break;
+				bool present = false;
+				for (size_t ndx = 0;  ndx < mSlots.size() && !present;  ndx++)
+					present = mSlots[ndx].state != kEmpty && mSlots[ndx].index == index;
+				if (present)
+					continue;
+				for (size_t ndx = 0;  ndx < mSlots.size();  ndx++)
+				{
+					Slot & slot (mSlots[ndx]);
+					if (slot.state == kEmpty || (slot.state == kReady && !InWindow(slot.index)))
+					{
+						slot.state = kLoading;
+						slot.index = index;
+						return &slot;
+					}
+				}
+				break;	//	Every buffer is busy or still wanted
+			}
+			return NULL;
+		}
+
+		static void ReaderThreadStatic (AJAThread * pThread, void * pContext)
+		{
+			AJA_UNUSED(pThread);
+			reinterpret_cast<AJADPXPrefetcher*>(pContext)->ReaderThread();
+		}
+
+		void ReaderThread ()
+		{
+			while (true)
+			{
+				Slot * pSlot;
+				string fileName;
+				{
+					AJAAutoLock locker (&mLock);
+					if (mQuit)
+						return;
+					pSlot = ClaimSlot();
+					if (pSlot)
+						fileName = mFiles[pSlot->index];
+					else
+						mWorkEvent.Clear();		//	Under the lock, so a position change can't slip by
+				}
+				if (!pSlot)
+				{
+					mWorkEvent.WaitForSignal();
+					continue;
+				}
+				Load (*pSlot, fileName);
+				AJAAutoLock locker (&mLock);
+				pSlot->state = kReady;
+				mReadyEvent.Signal();
+				mWorkEvent.Signal();	//	Another reader may now find a free buffer
+			}
+		}
+
+		bool Reserve (Slot & inSlot, const size_t inBytes)
+		{
+			if (inSlot.capacity >= inBytes)
+				return true;
+			AJAMemory::FreeAligned (inSlot.pBuffer);
+			inSlot.pBuffer = reinterpret_cast<uint8_t*>(AJAMemory::AllocateAligned (inBytes, AJA_DPX_IO_ALIGNMENT));
+			inSlot.capacity = inSlot.pBuffer ? inBytes : 0;
+			return inSlot.pBuffer != NULL;
+		}
+
+		//	Reads header and payload together, assuming the sequence's layout, and re-reads if this file is bigger
+		void Load (Slot & inSlot, const string & inFileName)
+		{
+			AJAFileIO file;
+			inSlot.status = file.Open (inFileName, eAJAReadOnly, eAJAUnbuffered);
+			if (inSlot.status != AJA_STATUS_SUCCESS)
+				return;
+			size_t wantBytes (mUniformBytes);
+			for (int attempt = 0;  attempt < 2;  attempt++)
+			{
+				if (!Reserve (inSlot, wantBytes))
+					{inSlot.status = AJA_STATUS_MEMORY;  return;}
+				if (attempt  &&  file.Seek (0, eAJASeekSet) != AJA_STATUS_SUCCESS)
+					{inSlot.status = AJA_STATUS_IO;  return;}
+				const uint32_t bytesRead (ReadFully (file, inSlot.pBuffer, uint32_t(wantBytes)));
+				if (bytesRead < sizeof(DPX_header_t))
+					{inSlot.status = AJA_STATUS_IO;  return;}
+
+				DpxHdr hdr;
+				memcpy (&hdr.GetHdr(), inSlot.pBuffer, sizeof(DPX_header_t));
+				if (!DPX_VALID(&hdr.GetHdr()))
+					{inSlot.status = AJA_STATUS_UNSUPPORTED;  return;}
+				inSlot.payloadOffset = hdr.get_fi_image_offset();
+				inSlot.payloadBytes = PayloadSize (hdr);
+				const size_t fileBytes (inSlot.payloadOffset + inSlot.payloadBytes);
+				if (!inSlot.payloadBytes)
+					{inSlot.status = AJA_STATUS_UNSUPPORTED;  return;}
+				if (fileBytes <= bytesRead)
+					return;		//	Got it all
+				if (bytesRead < wantBytes)
+					break;		//	Truncated file
+				wantBytes = RoundUp (fileBytes, AJA_DPX_IO_ALIGNMENT);	//	Not uniform -- read it again, all of it
+			}
+			inSlot.status = AJA_STATUS_IO;
+		}
+
+		const vector<string>	mFiles;
+		const size_t			mUniformBytes;	//	Bytes read per file (aligned header + payload size of the first file)
+		const uint32_t			mWindow;		//	Number of frames kept buffered
+		uint32_t				mCurrent;		//	Playback position
+		bool					mLoop;
+		bool					mQuit;
+		AJALock					mLock;
+		AJAEvent				mWorkEvent;		//	Signaled when the window moves or a buffer frees up
+		AJAEvent				mReadyEvent;	//	Signaled when a frame finishes loading
+		vector<Slot>			mSlots;
+		vector<AJAThread*>		mReaders;
+};	//	AJADPXPrefetcher
+
+
+/**
+	Write-behind engine for AJADPXFileIO. QueueWrite copies each frame into a pooled buffer, and a pool of writer
+	threads writes them out with unbuffered, preallocated writes.
+**/
+class AJADPXWriteBehind
+{
+	public:
+		AJADPXWriteBehind (const uint32_t inQueueDepth, const uint32_t inNumWriters)
+			:	mDepth			(inQueueDepth),
+				mActive			(0),
+				mStatus			(AJA_STATUS_SUCCESS),
+				mQuit			(false),
+				mWorkEvent		(true),
+				mRoomEvent		(true),
+				mIdleEvent		(true)
+		{
+			mRoomEvent.Signal();
+			mIdleEvent.Signal();
+			mWriters.resize(inNumWriters);
+			for (size_t ndx = 0;  ndx < mWriters.size();  ndx++)
+			{
+				mWriters[ndx] = new AJAThread;
+				mWriters[ndx]->Attach (WriterThreadStatic, this);
+				mWriters[ndx]->Start();
+			}
+		}
+
+		~AJADPXWriteBehind ()
+		{
+			{
+				AJAAutoLock locker (&mLock);
+				mQuit = true;
+				mWorkEvent.Signal();
+			}
+			for (size_t ndx = 0;  ndx < mWriters.size();  ndx++)
+			{
+				mWriters[ndx]->Stop();
+				delete mWriters[ndx];
+			}
+			for (size_t ndx = 0;  ndx < mFree.size();  ndx++)
+				AJAMemory::FreeAligned (mFree[ndx].pBuffer);
+			for (size_t ndx = 0;  ndx < mPending.size();  ndx++)
+				AJAMemory::FreeAligned (mPending[ndx].pBuffer);
+		}
+
+		AJAStatus Queue (const string & inFileName, const DPX_header_t & inHdr,
+						 const uint8_t * pInPayload, const uint32_t inPayloadBytes, const uint32_t inTimeoutMs)
+		{
+			const uint64_t startMs (AJATime::GetSystemMilliseconds());
+			Job job;
+			while (true)
+			{
+				{
+					AJAAutoLock locker (&mLock);
+					if (mStatus != AJA_STATUS_SUCCESS)
+						return mStatus;
+					if (mPending.size() + mActive < mDepth)
+					{
+						if (!mFree.empty())
+							{job = mFree.back();  mFree.pop_back();}
+						mActive++;		//	Counted as busy while the caller's thread fills it
+						mIdleEvent.Clear();
+						break;
+					}
+					mRoomEvent.Clear();		//	Under the lock, so a completion can't slip by
+				}
+				if (!inTimeoutMs  ||  !WaitUntil (mRoomEvent, startMs, inTimeoutMs))
+					return AJA_STATUS_BUSY;
+			}
+
+			//	The buffer is ours until it's queued, so fill it without the lock
+			job.fileName = inFileName;
+			job.bytes = sizeof(DPX_header_t) + inPayloadBytes;
+			if (job.capacity < job.bytes)
+			{
+				AJAMemory::FreeAligned (job.pBuffer);
+				job.capacity = RoundUp (job.bytes, AJA_DPX_IO_ALIGNMENT);
+				job.pBuffer = reinterpret_cast<uint8_t*>(AJAMemory::AllocateAligned (job.capacity, AJA_DPX_IO_ALIGNMENT));
+			}
+			if (job.pBuffer)
+			{
+				memcpy (job.pBuffer, &inHdr, sizeof(DPX_header_t));
+				memcpy (job.pBuffer + sizeof(DPX_header_t), pInPayload, inPayloadBytes);
+			}
+			AJAAutoLock locker (&mLock);
+			mActive--;
+			if (!job.pBuffer)
+			{
+				SignalIfIdle();
+				return AJA_STATUS_MEMORY;
+			}
+			mPending.push_back (job);
+			mWorkEvent.Signal();
+			return AJA_STATUS_SUCCESS;
+		}
+
+		AJAStatus Flush (const uint32_t inTimeoutMs)
+		{
+			const uint64_t startMs (AJATime::GetSystemMilliseconds());
+			while (true)
+			{
+				{
+					AJAAutoLock locker (&mLock);
+					if (mPending.empty()  &&  !mActive)
+					{
+						const AJAStatus status (mStatus);
+						mStatus = AJA_STATUS_SUCCESS;
+						return status;
+					}
+					mIdleEvent.Clear();		//	Under the lock, so the last completion can't slip by
+				}
+				if (!WaitUntil (mIdleEvent, startMs, inTimeoutMs))
+					return AJA_STATUS_TIMEOUT;
+			}
+		}
+
+		uint32_t Pending (void) const
+		{
+			AJAAutoLock locker (&mLock);
+			return uint32_t(mPending.size()) + mActive;
+		}
+
+	private:
+		struct Job
+		{
+			Job () : pBuffer(NULL), capacity(0), bytes(0) {}
+			string		fileName;
+			uint8_t *	pBuffer;
+			size_t		capacity;
+			size_t		bytes;
+		};
+
+		void SignalIfIdle (void)	//	Lock held
+		{
+			mRoomEvent.Signal();
+			if (mPending.empty()  &&  !mActive)
+				mIdleEvent.Signal();
+		}
+
+		static void WriterThreadStatic (AJAThread * pThread, void * pContext)
+		{
+			AJA_UNUSED(pThread);
+			reinterpret_cast<AJADPXWriteBehind*>(pContext)->WriterThread();
+		}
+
+		void WriterThread ()
+		{
+			while (true)
+			{
+				Job job;
+				bool haveJob = false;
+				{
+					AJAAutoLock locker (&mLock);
+					if (mQuit)
+						return;
+					if (mPending.empty())
+						mWorkEvent.Clear();		//	Under the lock, so a submission can't slip by
+					else
+					{
+						job = mPending.front();
+						mPending.pop_front();
+						mActive++;
+						haveJob = true;
+					}
+				}
+				if (!haveJob)
+				{
+					mWorkEvent.WaitForSignal();
+					continue;
+				}
+				const AJAStatus status (Write (job));
+				AJAAutoLock locker (&mLock);
+				if (status != AJA_STATUS_SUCCESS  &&  mStatus == AJA_STATUS_SUCCESS)
+					mStatus = status;
+				mFree.push_back (job);
+				mActive--;
+				SignalIfIdle();
+			}
+		}
+
+		static AJAStatus Write (const Job & inJob)
+		{
+			AJAFileIO file;
+			AJAStatus status (file.Open (inJob.fileName, eAJAWriteOnly, eAJAUnbuffered));
+			if (status != AJA_STATUS_SUCCESS)
+				return status;
+			file.Preallocate (0, int64_t(inJob.bytes));
+			//	The aligned bulk goes straight to disk;  the tail (if any) goes through the page cache
+			const uint32_t bulkBytes (uint32_t(inJob.bytes / AJA_DPX_IO_ALIGNMENT * AJA_DPX_IO_ALIGNMENT));
+			const uint32_t tailBytes (uint32_t(inJob.bytes) - bulkBytes);
+			if (bulkBytes  &&  file.Write (inJob.pBuffer, bulkBytes) != bulkBytes)
+				status = AJA_STATUS_IO;
+			if (tailBytes  &&  file.Write (inJob.pBuffer + bulkBytes, tailBytes) != tailBytes)
+				status = AJA_STATUS_IO;
+			file.Close();
+			return status;
+		}
+
+		const uint32_t			mDepth;
+		uint32_t				mActive;		//	Jobs being filled or written
+		AJAStatus				mStatus;		//	First write error since the last flush
+		bool					mQuit;
+		mutable AJALock			mLock;
+		AJAEvent				mWorkEvent;		//	Signaled while mPending isn't empty
+		AJAEvent				mRoomEvent;		//	Signaled when a job finishes
+		AJAEvent				mIdleEvent;		//	Signaled when nothing is queued or active
+		std::deque<Job>			mPending;
+		vector<Job>				mFree;
+		vector<AJAThread*>		mWriters;
+};	//	AJADPXWriteBehind
+
 
 AJADPXFileIO::AJADPXFileIO ()
 	:	mPathSet		(false),
 		mLoopMode		(true),
 		mPauseMode		(false),
 		mFileCount		(0),
-		mCurrentIndex	(0)
+		mCurrentIndex	(0),
+		mpPrefetch		(NULL),
+		mpWriteBehind	(NULL)
 {
 }	//	constructor
 
 
 AJADPXFileIO::~AJADPXFileIO ()
 {
+	StopWriteBehind();
+	StopPrefetch();
 	mFileList.clear();
 }	//	destructor
 
@@ -117,42 +629,50 @@ AJAStatus AJADPXFileIO::Read (uint8_t  &		buffer,
 	if (mCurrentIndex >= mFileCount)
 		return AJA_STATUS_RANGE;
 
-	//	Get the name of the next file to open, then do so
-	string fileName = mFileList [mCurrentIndex];
-	status = file.Open (fileName, eAJAReadOnly, eAJAUnbuffered);
-
-	//	Read the header from the file
-	if (AJA_STATUS_SUCCESS == status)
+	if (mpPrefetch)
 	{
-		uint32_t bytesRead = file.Read ((uint8_t*)&GetHdr(), uint32_t(GetHdrSize()));
-		if (bytesRead != GetHdrSize())
-			status = AJA_STATUS_IO;
+		//	Get it from the read-ahead buffers
+		status = mpPrefetch->Fetch (mCurrentIndex, &buffer, bufferSize, GetHdr());
 	}
-
-	//	Sanity check the "magic number"
-	if (AJA_STATUS_SUCCESS == status)
-	{
-		if (!DPX_VALID( &GetHdr() ))
-			status = AJA_STATUS_UNSUPPORTED;
-	}
-
-	//	Seek to the image payload
-	if (AJA_STATUS_SUCCESS == status)
-	{
-		status = file.Seek (get_fi_image_offset(), eAJASeekSet);
-	}
-
-	//	Read the payload
-	if (AJA_STATUS_SUCCESS == status)
+	else
 	{
-		uint32_t bytesRead = file.Read ((uint8_t*)&buffer, uint32_t(get_ii_image_size()));
-		if (bytesRead != get_ii_image_size())
-			status = AJA_STATUS_IO;
+		//	Get the name of the next file to open, then do so
+		string fileName = mFileList [mCurrentIndex];
+		status = file.Open (fileName, eAJAReadOnly, eAJAUnbuffered);
+
+		//	Read the header from the file
+		if (AJA_STATUS_SUCCESS == status)
+		{
+			uint32_t bytesRead = file.Read ((uint8_t*)&GetHdr(), uint32_t(GetHdrSize()));
+			if (bytesRead != GetHdrSize())
+				status = AJA_STATUS_IO;
+		}
+
+		//	Sanity check the "magic number"
+		if (AJA_STATUS_SUCCESS == status)
+		{
+			if (!DPX_VALID( &GetHdr() ))
+				status = AJA_STATUS_UNSUPPORTED;
+		}
+
+		//	Seek to the image payload
+		if (AJA_STATUS_SUCCESS == status)
+		{
+			status = file.Seek (get_fi_image_offset(), eAJASeekSet);
+		}
+
+		//	Read the payload
+		if (AJA_STATUS_SUCCESS == status)
+		{
+			uint32_t bytesRead = file.Read ((uint8_t*)&buffer, uint32_t(get_ii_image_size()));
+			if (bytesRead != get_ii_image_size())
+				status = AJA_STATUS_IO;
+		}
+
+		//	Done with the file
+		file.Close ();
 	}
 
-	//	Done with the file
-	file.Close ();
-
 	//	Report the current index in the sequence
 	index = mCurrentIndex;
 
@@ -171,15 +691,21 @@ AJAStatus AJADPXFileIO::Read (uint8_t  &		buffer,
 		mCurrentIndex++;
 	}
 
+	//	Slide the read-ahead window along
+	if (mpPrefetch)
+		mpPrefetch->SetPosition (mCurrentIndex, mLoopMode);
+
 	return status;
 }	//	Read
 
 
 void AJADPXFileIO::SetFileList (vector<string> & list)
 {
+	StopPrefetch();
 	mFileList.clear();
 
 	mFileList = list;
+	mFileCount = uint32_t(mFileList.size());
 }	//	SetFileList
 
 
@@ -189,6 +715,8 @@ AJAStatus AJADPXFileIO::SetIndex (const uint32_t &	index)
 		return AJA_STATUS_RANGE;
 
 	mCurrentIndex = index;
+	if (mpPrefetch)
+		mpPrefetch->SetPosition (mCurrentIndex, mLoopMode);
 
 	return AJA_STATUS_SUCCESS;
 }	//	SetIndex
@@ -197,6 +725,8 @@ AJAStatus AJADPXFileIO::SetIndex (const uint32_t &	index)
 void AJADPXFileIO::SetLoopMode (bool mode)
 {
 	mLoopMode = mode;
+	if (mpPrefetch)
+		mpPrefetch->SetPosition (mCurrentIndex, mLoopMode);
 }	//	SetLoopMode
 
 
@@ -210,6 +740,7 @@ AJAStatus AJADPXFileIO::SetPath (const string & path)
 {
 	AJAFileIO	file;
 
+	StopPrefetch();
 	mPath = path;
 	mFileList.clear();
 
@@ -243,10 +774,7 @@ AJAStatus AJADPXFileIO::Write (const uint8_t  & buffer,
 		return AJA_STATUS_INITIALIZE;
 
 	//	Construct the file name
-	char asciiSequence[9];
-	ajasnprintf (asciiSequence, 9, "%.8d", index);
-
-	fileName = mPath + "/" + asciiSequence + ".DPX";
+	fileName = MakeFileName (index);
 
 	//	Open the file or return an error code
 	status = file.Open (fileName, eAJAWriteOnly, eAJAUnbuffered);
@@ -274,3 +802,108 @@ AJAStatus AJADPXFileIO::Write (const uint8_t  & buffer,
 	return status;
 }	//	Write
 
+
+
+AJAStatus AJADPXFileIO::StartPrefetch (const uint32_t framesAhead, const uint32_t numReaders)
+{
+	//	Check that we've been initialzed
+	if (!mPathSet)
+		return AJA_STATUS_INITIALIZE;
+	if (!mFileCount  ||  mCurrentIndex >= mFileCount)
+		return AJA_STATUS_RANGE;
+	if (!framesAhead  ||  !numReaders)
+		return AJA_STATUS_BAD_PARAM;
+
+	StopPrefetch();
+
+	//	Parse the header of the current file once, and expect the rest of the sequence to match it
+	AJAFileIO	file;
+	DpxHdr		hdr;
+	AJAStatus	status = file.Open (mFileList [mCurrentIndex], eAJAReadOnly, eAJAUnbuffered);
+	if (AJA_STATUS_SUCCESS != status)
+		return status;
+	uint32_t bytesRead = file.Read ((uint8_t*)&hdr.GetHdr(), uint32_t(hdr.GetHdrSize()));
+	file.Close ();
+	if (bytesRead != hdr.GetHdrSize())
+		return AJA_STATUS_IO;
+	if (!DPX_VALID( &hdr.GetHdr() ))
+		return AJA_STATUS_UNSUPPORTED;
+	const size_t payloadSize = PayloadSize (hdr);
+	if (!payloadSize)
+		return AJA_STATUS_UNSUPPORTED;
+
+	mpPrefetch = new AJADPXPrefetcher (mFileList, hdr.get_fi_image_offset() + payloadSize, framesAhead, numReaders);
+	mpPrefetch->SetPosition (mCurrentIndex, mLoopMode);
+	return AJA_STATUS_SUCCESS;
+}	//	StartPrefetch
+
+
+AJAStatus AJADPXFileIO::StopPrefetch ()
+{
+	delete mpPrefetch;
+	mpPrefetch = NULL;
+	return AJA_STATUS_SUCCESS;
+}	//	StopPrefetch
+
+
+bool AJADPXFileIO::IsPrefetching () const
+{
+	return mpPrefetch != NULL;
+}	//	IsPrefetching
+
+
+AJAStatus AJADPXFileIO::StartWriteBehind (const uint32_t queueDepth, const uint32_t numWriters)
+{
+	//	Check that we've been initialzed
+	if (!mPathSet)
+		return AJA_STATUS_INITIALIZE;
+	if (!queueDepth  ||  !numWriters)
+		return AJA_STATUS_BAD_PARAM;
+
+	AJAStatus status = StopWriteBehind();
+	mpWriteBehind = new AJADPXWriteBehind (queueDepth, numWriters);
+	return status;
+}	//	StartWriteBehind
+
+
+AJAStatus AJADPXFileIO::QueueWrite (const uint8_t  & buffer,
+									const uint32_t	 bufferSize,
+									const uint32_t & index,
+									const uint32_t	 timeoutMs)
+{
+	if (!mpWriteBehind)
+		return AJA_STATUS_INITIALIZE;
+	return mpWriteBehind->Queue (MakeFileName (index), GetHdr(), &buffer, bufferSize, timeoutMs);
+}	//	QueueWrite
+
+
+AJAStatus AJADPXFileIO::FlushWrites (const uint32_t timeoutMs)
+{
+	if (!mpWriteBehind)
+		return AJA_STATUS_SUCCESS;
+	return mpWriteBehind->Flush (timeoutMs);
+}	//	FlushWrites
+
+
+AJAStatus AJADPXFileIO::StopWriteBehind ()
+{
+	AJAStatus status = FlushWrites ();
+	delete mpWriteBehind;
+	mpWriteBehind = NULL;
+	return status;
+}	//	StopWriteBehind
+
+
+uint32_t AJADPXFileIO::GetWritesPending () const
+{
+	return mpWriteBehind ? mpWriteBehind->Pending() : 0;
+}	//	GetWritesPending
+
+
+string AJADPXFileIO::MakeFileName (const uint32_t index) const
+{
+	char asciiSequence[9];
+	ajasnprintf (asciiSequence, 9, "%.8d", index);
+
+	return mPath + "/" + asciiSequence + ".DPX";
+}	//	MakeFileName
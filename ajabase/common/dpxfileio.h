@@ -11,6 +11,9 @@
 #include "ajabase/common/dpx_hdr.h"
 #include "ajabase/common/types.h"
 
+class AJADPXPrefetcher;
+class AJADPXWriteBehind;
+
 /**
  *	Class to support low level I/O for DPX files.
  *	@ingroup AJAFileIO
@@ -117,13 +120,84 @@ class AJADPXFileIO : public DpxHdr
 											   const uint32_t	inBufferSize,
 											   const uint32_t &	inIndex) const;
 
+		/**
+			@brief		Starts reading ahead of the playback position, so that Read returns frames from memory
+						instead of waiting on the disk. The frames read ahead follow SetIndex and the loop and
+						pause controls.
+			@param[in]	inFramesAhead	Specifies how many frames to keep buffered. This is also the number of
+											frame buffers allocated.
+			@param[in]	inNumReaders	Specifies how many reader threads to use. More readers keep more
+											requests in flight, which helps on RAIDs and NVMe drives.
+			@note		The header of the first file is parsed once up front. Each file is then read (header and
+						payload together) with one unbuffered, aligned read of that size. A file whose header
+						differs from the first is still read correctly, with a second read if it's larger.
+		**/
+		AJA_EXPORT AJAStatus					StartPrefetch (const uint32_t inFramesAhead = 8,
+															   const uint32_t inNumReaders = 2);
+
+		/**
+			@brief		Stops reading ahead, and frees the frame buffers. Read goes back to reading from disk.
+		**/
+		AJA_EXPORT AJAStatus					StopPrefetch ();
+
+		/**
+			@brief		Returns true if Read is being served by read-ahead.
+		**/
+		AJA_EXPORT bool							IsPrefetching () const;
+
+		/**
+			@brief		Starts the write-behind queue used by QueueWrite.
+			@param[in]	inQueueDepth	Specifies the maximum number of frames waiting to be written.
+			@param[in]	inNumWriters	Specifies how many writer threads to use.
+		**/
+		AJA_EXPORT AJAStatus					StartWriteBehind (const uint32_t inQueueDepth = 8,
+																  const uint32_t inNumWriters = 2);
+
+		/**
+			@brief		Copies the current header and the given payload into the write-behind queue, and returns
+						without waiting for the file to be written. The file is named as for Write.
+			@param[in]	inBuffer		Specifies the DPX file image payload.
+			@param[in]	inBufferSize	Specifies the number of payload bytes in inBuffer.
+			@param[in]	inIndex			Specifies the index number to be appended to the file name.
+			@param[in]	inTimeoutMs		Specifies how long to wait for room in the queue. Zero (the default)
+											doesn't wait.
+			@return		AJA_STATUS_SUCCESS if queued;  AJA_STATUS_BUSY if the queue stayed full;  or the
+						first error encountered writing an earlier frame.
+		**/
+		AJA_EXPORT AJAStatus					QueueWrite (const uint8_t  &	inBuffer,
+															const uint32_t	inBufferSize,
+															const uint32_t &	inIndex,
+															const uint32_t	inTimeoutMs = 0);
+
+		/**
+			@brief		Waits for every queued frame to be written.
+			@param[in]	inTimeoutMs		Specifies how long to wait, in milliseconds.
+			@return		AJA_STATUS_SUCCESS if all were written;  AJA_STATUS_TIMEOUT;  or the first write error.
+		**/
+		AJA_EXPORT AJAStatus					FlushWrites (const uint32_t inTimeoutMs = 0xffffffff);
+
+		/**
+			@brief		Writes every queued frame, then stops the write-behind threads.
+			@return		The result of the final FlushWrites.
+		**/
+		AJA_EXPORT AJAStatus					StopWriteBehind ();
+
+		/**
+			@brief		Returns the number of frames queued by QueueWrite that haven't been written yet.
+		**/
+		AJA_EXPORT uint32_t						GetWritesPending () const;
+
 
 	// Protected Instance Methods
 	protected:
+		std::string								MakeFileName (const uint32_t inIndex) const;
 
 
 	// Private Member Data
 	private:
+		AJADPXFileIO (const AJADPXFileIO & inObj);				//	Not copyable
+		AJADPXFileIO & operator = (const AJADPXFileIO & inRHS);	//	Not assignable
+
 		bool						mPathSet;		/// True if the path to use has been set, else false
 		bool						mLoopMode;		/// True if last sequence frame is followed by the first
 		bool						mPauseMode;		/// True if currently paused, else false
@@ -131,6 +205,8 @@ class AJADPXFileIO : public DpxHdr
 		uint32_t					mFileCount;		/// Number of DPX files in the path
 		uint32_t					mCurrentIndex;	/// Index into the vector below of the next file to read
 		std::vector<std::string>	mFileList;		/// File names of all the DPX files in the path
+		AJADPXPrefetcher *			mpPrefetch;		/// Read-ahead engine, if prefetching
+		AJADPXWriteBehind *			mpWriteBehind;	/// Write-behind engine, if started
 
 };	//	AJADPXFileIO
 
@@ -12,9 +12,9 @@
 
 const int kTCDigColon		= 10;			// index of ':' character
 const int kTCDigSemicolon	= 11;			// index of ';' character
-//const int kTCDigDash		= 12;			// index of '-' character		UNUSED
+const int kTCDigDash		= 12;			// index of '-' character
 const int kTCDigSpace		= 13;			// index of ' ' character
-//const int kTCDigAsterisk	= 14;			// index of '*' character		UNUSED
+const int kTCDigAsterisk	= 14;			// index of '*' character
 const int kTCMaxTCChars = 15;				// number of characters we know how to make
 
 
@@ -871,3 +871,778 @@ void AJATimeCodeBurn::writeYCbCr10PackedPlanerPixel (char **pBytePtr, int x, int
 		break;
 	}
 }
+
+
+//	AJATextBurn
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define AJA_TEXTBURN_SSE2	1
+#endif
+
+// how plane components are stored
+const int kTBLayout8Bit			= 0;		// one byte per component
+const int kTBLayout16Bit		= 1;		// little-endian 16-bit samples
+const int kTBLayoutWordLE		= 2;		// three components per little-endian 32-bit word
+const int kTBLayoutWordBE		= 3;		// three components per big-endian 32-bit word (DPX)
+const int kTBLayoutBitStream	= 4;		// components packed back to back, least significant bit first
+
+// component channels
+const int kTBChannelNone		= 0;		// left alone (alpha, padding)
+const int kTBChannelY			= 1;
+const int kTBChannelCb			= 2;
+const int kTBChannelCr			= 3;
+const int kTBChannelR			= 4;
+const int kTBChannelG			= 5;
+const int kTBChannelB			= 6;
+
+const int		kTBFirstGlyph	= 0x20;		// printable ASCII
+const int		kTBLastGlyph	= 0x7E;
+const int		kTBNumGlyphs	= kTBLastGlyph - kTBFirstGlyph + 1;
+const uint32_t	kTBAlphaOne		= 32768;	// blend weights are 1.15 fixed point
+const size_t	kTBMaxOverlays	= 256;		// raster/overlay pairs remembered before the least recently used is forgotten
+
+// 5x7 font for the characters the timecode font doesn't have, one byte per column, bit 0 at the top
+static const uint8_t TextFont[kTBNumGlyphs][5] =
+{
+	{0x00, 0x00, 0x00, 0x00, 0x00},		// ' '
+	{0x00, 0x00, 0x5F, 0x00, 0x00},		// '!'
+	{0x00, 0x07, 0x00, 0x07, 0x00},		// '"'
+	{0x14, 0x7F, 0x14, 0x7F, 0x14},		// '#'
+	{0x24, 0x2A, 0x7F, 0x2A, 0x12},		// '$'
+	{0x23, 0x13, 0x08, 0x64, 0x62},		// '%'
+	{0x36, 0x49, 0x55, 0x22, 0x50},		// '&'
+	{0x00, 0x05, 0x03, 0x00, 0x00},		// '''
+	{0x00, 0x1C, 0x22, 0x41, 0x00},		// '('
+	{0x00, 0x41, 0x22, 0x1C, 0x00},		// ')'
+	{0x08, 0x2A, 0x1C, 0x2A, 0x08},		// '*'
+	{0x08, 0x08, 0x3E, 0x08, 0x08},		// '+'
+	{0x00, 0x50, 0x30, 0x00, 0x00},		// ','
+	{0x08, 0x08, 0x08, 0x08, 0x08},		// '-'
+	{0x00, 0x60, 0x60, 0x00, 0x00},		// '.'
+	{0x20, 0x10, 0x08, 0x04, 0x02},		// '/'
+	{0x3E, 0x51, 0x49, 0x45, 0x3E},		// '0'
+	{0x00, 0x42, 0x7F, 0x40, 0x00},		// '1'
+	{0x42, 0x61, 0x51, 0x49, 0x46},		// '2'
+	{0x21, 0x41, 0x45, 0x4B, 0x31},		// '3'
+	{0x18, 0x14, 0x12, 0x7F, 0x10},		// '4'
+	{0x27, 0x45, 0x45, 0x45, 0x39},		// '5'
+	{0x3C, 0x4A, 0x49, 0x49, 0x30},		// '6'
+	{0x01, 0x71, 0x09, 0x05, 0x03},		// '7'
+	{0x36, 0x49, 0x49, 0x49, 0x36},		// '8'
+	{0x06, 0x49, 0x49, 0x29, 0x1E},		// '9'
+	{0x00, 0x36, 0x36, 0x00, 0x00},		// ':'
+	{0x00, 0x56, 0x36, 0x00, 0x00},		// ';'
+	{0x08, 0x14, 0x22, 0x41, 0x00},		// '<'
+	{0x14, 0x14, 0x14, 0x14, 0x14},		// '='
+	{0x00, 0x41, 0x22, 0x14, 0x08},		// '>'
+	{0x02, 0x01, 0x51, 0x09, 0x06},		// '?'
+	{0x32, 0x49, 0x79, 0x41, 0x3E},		// '@'
+	{0x7E, 0x11, 0x11, 0x11, 0x7E},		// 'A'
+	{0x7F, 0x49, 0x49, 0x49, 0x36},		// 'B'
+	{0x3E, 0x41, 0x41, 0x41, 0x22},		// 'C'
+	{0x7F, 0x41, 0x41, 0x22, 0x1C},		// 'D'
+	{0x7F, 0x49, 0x49, 0x49, 0x41},		// 'E'
+	{0x7F, 0x09, 0x09, 0x09, 0x01},		// 'F'
+	{0x3E, 0x41, 0x49, 0x49, 0x7A},		// 'G'
+	{0x7F, 0x08, 0x08, 0x08, 0x7F},		// 'H'
+	{0x00, 0x41, 0x7F, 0x41, 0x00},		// 'I'
+	{0x20, 0x40, 0x41, 0x3F, 0x01},		// 'J'
+	{0x7F, 0x08, 0x14, 0x22, 0x41},		// 'K'
+	{0x7F, 0x40, 0x40, 0x40, 0x40},		// 'L'
+	{0x7F, 0x02, 0x0C, 0x02, 0x7F},		// 'M'
+	{0x7F, 0x04, 0x08, 0x10, 0x7F},		// 'N'
+	{0x3E, 0x41, 0x41, 0x41, 0x3E},		// 'O'
+	{0x7F, 0x09, 0x09, 0x09, 0x06},		// 'P'
+	{0x3E, 0x41, 0x51, 0x21, 0x5E},		// 'Q'
+	{0x7F, 0x09, 0x19, 0x29, 0x46},		// 'R'
+	{0x46, 0x49, 0x49, 0x49, 0x31},		// 'S'
+	{0x01, 0x01, 0x7F, 0x01, 0x01},		// 'T'
+	{0x3F, 0x40, 0x40, 0x40, 0x3F},		// 'U'
+	{0x1F, 0x20, 0x40, 0x20, 0x1F},		// 'V'
+	{0x3F, 0x40, 0x38, 0x40, 0x3F},		// 'W'
+	{0x63, 0x14, 0x08, 0x14, 0x63},		// 'X'
+	{0x07, 0x08, 0x70, 0x08, 0x07},		// 'Y'
+	{0x61, 0x51, 0x49, 0x45, 0x43},		// 'Z'
+	{0x00, 0x7F, 0x41, 0x41, 0x00},		// '['
+	{0x02, 0x04, 0x08, 0x10, 0x20},		// '\'
+	{0x00, 0x41, 0x41, 0x7F, 0x00},		// ']'
+	{0x04, 0x02, 0x01, 0x02, 0x04},		// '^'
+	{0x40, 0x40, 0x40, 0x40, 0x40},		// '_'
+	{0x00, 0x01, 0x02, 0x04, 0x00},		// '`'
+	{0x20, 0x54, 0x54, 0x54, 0x78},		// 'a'
+	{0x7F, 0x48, 0x44, 0x44, 0x38},		// 'b'
+	{0x38, 0x44, 0x44, 0x44, 0x20},		// 'c'
+	{0x38, 0x44, 0x44, 0x48, 0x7F},		// 'd'
+	{0x38, 0x54, 0x54, 0x54, 0x18},		// 'e'
+	{0x08, 0x7E, 0x09, 0x01, 0x02},		// 'f'
+	{0x0C, 0x52, 0x52, 0x52, 0x3E},		// 'g'
+	{0x7F, 0x08, 0x04, 0x04, 0x78},		// 'h'
+	{0x00, 0x44, 0x7D, 0x40, 0x00},		// 'i'
+	{0x20, 0x40, 0x44, 0x3D, 0x00},		// 'j'
+	{0x7F, 0x10, 0x28, 0x44, 0x00},		// 'k'
+	{0x00, 0x41, 0x7F, 0x40, 0x00},		// 'l'
+	{0x7C, 0x04, 0x18, 0x04, 0x78},		// 'm'
+	{0x7C, 0x08, 0x04, 0x04, 0x78},		// 'n'
+	{0x38, 0x44, 0x44, 0x44, 0x38},		// 'o'
+	{0x7C, 0x14, 0x14, 0x14, 0x08},		// 'p'
+	{0x08, 0x14, 0x14, 0x18, 0x7C},		// 'q'
+	{0x7C, 0x08, 0x04, 0x04, 0x08},		// 'r'
+	{0x48, 0x54, 0x54, 0x54, 0x20},		// 's'
+	{0x04, 0x3F, 0x44, 0x40, 0x20},		// 't'
+	{0x3C, 0x40, 0x40, 0x20, 0x7C},		// 'u'
+	{0x1C, 0x20, 0x40, 0x20, 0x1C},		// 'v'
+	{0x3C, 0x40, 0x30, 0x40, 0x3C},		// 'w'
+	{0x44, 0x28, 0x10, 0x28, 0x44},		// 'x'
+	{0x0C, 0x50, 0x50, 0x50, 0x3C},		// 'y'
+	{0x44, 0x64, 0x54, 0x4C, 0x44},		// 'z'
+	{0x00, 0x08, 0x36, 0x41, 0x00},		// '{'
+	{0x00, 0x00, 0x7F, 0x00, 0x00},		// '|'
+	{0x00, 0x41, 0x36, 0x08, 0x00},		// '}'
+	{0x08, 0x04, 0x08, 0x10, 0x08},		// '~'
+};
+
+
+// intensity (0-3) of a font dot.  Timecode characters come from CharMap, so they look like
+// AJATimeCodeBurn's; the rest are the 5x7 font scaled to fill the same part of the cell.
+static int TextBurnDot (int glyphIndex, int x, int y)
+{
+	const char ch (char(glyphIndex + kTBFirstGlyph));
+	int tcChar (-1);
+	if (ch >= '0' && ch <= '9')
+		tcChar = ch - '0';
+	else if (ch == ':')
+		tcChar = kTCDigColon;
+	else if (ch == ';')
+		tcChar = kTCDigSemicolon;
+	else if (ch == '-')
+		tcChar = kTCDigDash;
+	else if (ch == ' ')
+		tcChar = kTCDigSpace;
+	else if (ch == '*')
+		tcChar = kTCDigAsterisk;
+	if (tcChar >= 0)
+		return CharMap[tcChar][y][x];
+
+	// 5x7 font columns are 4 dots wide and rows 2 dots high, starting 2 dots in
+	const int column ((x - 2) / 4), row ((y - 2) / 2);
+	if (x < 2 || y < 2 || column >= 5 || row >= 7)
+		return 0;
+	return (TextFont[glyphIndex][column] >> row) & 1 ? 3 : 0;
+}
+
+
+// blend a line of 8-bit components:  out = in * inv + premul
+static void TextBurnBlend8 (uint8_t * pLine, const uint16_t * pInv, const uint16_t * pPremul, uint32_t count)
+{
+	uint32_t ndx (0);
+#if defined(AJA_TEXTBURN_SSE2)
+	const __m128i zero (_mm_setzero_si128());
+	for ( ; ndx + 16 <= count; ndx += 16)
+	{
+		const __m128i in (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + ndx)));
+		__m128i lo (_mm_unpacklo_epi8(in, zero));
+		__m128i hi (_mm_unpackhi_epi8(in, zero));
+		lo = _mm_srli_epi16(_mm_mulhi_epu16(_mm_slli_epi16(lo, 8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInv + ndx))), 7);
+		hi = _mm_srli_epi16(_mm_mulhi_epu16(_mm_slli_epi16(hi, 8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInv + ndx + 8))), 7);
+		lo = _mm_add_epi16(lo, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPremul + ndx)));
+		hi = _mm_add_epi16(hi, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPremul + ndx + 8)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pLine + ndx), _mm_packus_epi16(lo, hi));
+	}
+#endif	//	AJA_TEXTBURN_SSE2
+	for ( ; ndx < count; ndx++)
+	{
+		const uint32_t value ((uint32_t(pLine[ndx]) * pInv[ndx] >> 15) + pPremul[ndx]);
+		pLine[ndx] = uint8_t(value > 0xFF ? 0xFF : value);
+	}
+}
+
+
+// blend a line of unpacked components of up to 15 bits:  out = in * inv + premul
+static void TextBurnBlend16 (uint16_t * pLine, const uint16_t * pInv, const uint16_t * pPremul, uint32_t count, int bits)
+{
+	const uint32_t maxValue ((1U << bits) - 1);
+	uint32_t ndx (0);
+#if defined(AJA_TEXTBURN_SSE2)
+	// scale up to 16 bits so mulhi keeps the precision, then back down:  (in * inv) >> 15
+	const __m128i up (_mm_cvtsi32_si128(16 - bits));
+	const __m128i down (_mm_cvtsi32_si128(15 - bits));
+	const __m128i maxVec (_mm_set1_epi16(short(maxValue)));
+	for ( ; ndx + 8 <= count; ndx += 8)
+	{
+		__m128i value (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pLine + ndx)));
+		value = _mm_srl_epi16(_mm_mulhi_epu16(_mm_sll_epi16(value, up), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInv + ndx))), down);
+		value = _mm_add_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPremul + ndx)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pLine + ndx), _mm_min_epi16(value, maxVec));
+	}
+#endif	//	AJA_TEXTBURN_SSE2
+	for ( ; ndx < count; ndx++)
+	{
+		const uint32_t value ((uint32_t(pLine[ndx]) * pInv[ndx] >> 15) + pPremul[ndx]);
+		pLine[ndx] = uint16_t(value > maxValue ? maxValue : value);
+	}
+}
+
+
+AJATextBurn::AJATextBurn(void) :
+	_numPixels(0),
+	_numLines(0),
+	_alignPixels(1),
+	_alignLines(1),
+	_dotWidth(0),
+	_dotHeight(0),
+	_cellWidth(0),
+	_cellHeight(0),
+	_isRGB(false),
+	_isLegalRGB(false),
+	_isSD(false),
+	_useCount(0)
+{
+	_textColor.Red = _textColor.Green = _textColor.Blue = _textColor.Alpha = 0xFF;
+	_backColor.Red = _backColor.Green = _backColor.Blue = 0;
+	_backColor.Alpha = 0xFF;
+}
+
+AJATextBurn::~AJATextBurn(void)
+{
+}
+
+
+AJATextBurn::Plane AJATextBurn::MakePlane (int layout, int bits, int groupPixels, int groupBytes, const char * pComps,
+											int vertSub, int rowBytesDiv, int shift)
+{
+	Plane plane;
+	plane.layout		= layout;
+	plane.bits			= bits;
+	plane.shift			= shift;
+	plane.fieldShift[0]	= 0;
+	plane.fieldShift[1]	= 10;
+	plane.fieldShift[2]	= 20;
+	plane.groupPixels	= groupPixels;
+	plane.groupBytes	= groupBytes;
+	plane.vertSub		= vertSub;
+	plane.rowBytesDiv	= rowBytesDiv;
+	plane.rowBytes		= 0;
+	plane.offset		= 0;
+	plane.cellComps		= 0;
+	plane.cellBytes		= 0;
+	plane.cellLines		= 0;
+
+	// pComps is a channel letter and pixel number per component, e.g. "U0Y0V0Y1" for 2vuy
+	for (const char * p = pComps;  p[0] && p[1];  p += 2)
+	{
+		Component comp;
+		comp.pixel = p[1] - '0';
+		comp.span = 1;
+		switch (p[0])
+		{
+			case 'Y':	comp.channel = kTBChannelY;								break;
+			case 'U':	comp.channel = kTBChannelCb;	comp.span = 2;			break;
+			case 'V':	comp.channel = kTBChannelCr;	comp.span = 2;			break;
+			case 'R':	comp.channel = kTBChannelR;								break;
+			case 'G':	comp.channel = kTBChannelG;								break;
+			case 'B':	comp.channel = kTBChannelB;								break;
+			default:	comp.channel = kTBChannelNone;							break;
+		}
+		plane.comps.push_back(comp);
+	}
+	return plane;
+}
+
+
+bool AJATextBurn::SetRasterFormat (AJA_PixelFormat pixelFormat, uint32_t numPixels, uint32_t numLines, uint32_t rowBytes)
+{
+	_planes.clear();
+	_glyphs.clear();
+	_overlays.clear();
+	_cellWidth = _cellHeight = 0;
+
+	std::vector<Plane> planes;
+	bool isRGB (false), isLegalRGB (false);
+	switch (pixelFormat)
+	{
+		case AJA_PixelFormat_YCbCr8:			planes.push_back(MakePlane(kTBLayout8Bit, 8, 2, 4, "U0Y0V0Y1"));		break;
+		case AJA_PixelFormat_YUY28:				planes.push_back(MakePlane(kTBLayout8Bit, 8, 2, 4, "Y0U0Y1V0"));		break;
+		case AJA_PixelFormat_ARGB8:				planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 4, "B0G0R0A0"));		isRGB = true;	break;
+		case AJA_PixelFormat_RGBA8:				planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 4, "A0R0G0B0"));		isRGB = true;	break;
+		case AJA_PixelFormat_ABGR8:				planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 4, "R0G0B0A0"));		isRGB = true;	break;
+		case AJA_PixelFormat_RGB8_PACK:			planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 3, "R0G0B0"));			isRGB = true;	break;
+		case AJA_PixelFormat_BGR8_PACK:			planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 3, "B0G0R0"));			isRGB = true;	break;
+		case AJA_PixelFormat_YCbCr10:			planes.push_back(MakePlane(kTBLayoutWordLE, 10, 6, 16, "U0Y0V0Y1U2Y2V2Y3U4Y4V4Y5"));	break;
+		case AJA_PixelFormat_RGB10:				planes.push_back(MakePlane(kTBLayoutWordLE, 10, 1, 4, "R0G0B0"));		isRGB = true;	break;
+		case AJA_PixelFormat_RGB12:				planes.push_back(MakePlane(kTBLayoutBitStream, 12, 2, 9, "R0G0B0R1G1B1"));	isRGB = true;	break;
+
+		case AJA_PixelFormat_RGB_DPX:
+		case AJA_PixelFormat_RGB_DPX_LE:
+			planes.push_back(MakePlane(pixelFormat == AJA_PixelFormat_RGB_DPX ? kTBLayoutWordBE : kTBLayoutWordLE, 10, 1, 4, "R0G0B0"));
+			planes.back().fieldShift[0] = 22;
+			planes.back().fieldShift[1] = 12;
+			planes.back().fieldShift[2] = 2;
+			isRGB = isLegalRGB = true;
+			break;
+
+		case AJA_PixelFormat_YCBCR8_420PL3:
+		case AJA_PixelFormat_YCBCR8_422PL3:
+		{
+			const int vertSub (pixelFormat == AJA_PixelFormat_YCBCR8_420PL3 ? 2 : 1);
+			planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 1, "Y0"));
+			planes.push_back(MakePlane(kTBLayout8Bit, 8, 2, 1, "U0", vertSub, 2));
+			planes.push_back(MakePlane(kTBLayout8Bit, 8, 2, 1, "V0", vertSub, 2));
+			break;
+		}
+		case AJA_PixelFormat_YCBCR8_420PL2:
+		case AJA_PixelFormat_YCBCR8_422PL2:
+			planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 1, "Y0"));
+			planes.push_back(MakePlane(kTBLayout8Bit, 8, 2, 2, "U0V0", pixelFormat == AJA_PixelFormat_YCBCR8_420PL2 ? 2 : 1));
+			break;
+
+		case AJA_PixelFormat_YCBCR10_420PL3LE:
+		case AJA_PixelFormat_YCBCR10_422PL3LE:
+		{
+			const int vertSub (pixelFormat == AJA_PixelFormat_YCBCR10_420PL3LE ? 2 : 1);
+			planes.push_back(MakePlane(kTBLayout16Bit, 10, 1, 2, "Y0"));
+			planes.push_back(MakePlane(kTBLayout16Bit, 10, 2, 2, "U0", vertSub, 2));
+			planes.push_back(MakePlane(kTBLayout16Bit, 10, 2, 2, "V0", vertSub, 2));
+			break;
+		}
+		case AJA_PixelFormat_YCBCR10_420PL2LE:		// P010 samples are in the high 10 bits
+			planes.push_back(MakePlane(kTBLayout16Bit, 10, 1, 2, "Y0", 1, 1, 6));
+			planes.push_back(MakePlane(kTBLayout16Bit, 10, 2, 4, "U0V0", 2, 1, 6));
+			break;
+		case AJA_PixelFormat_YCBCR10_422PL2LE:
+			planes.push_back(MakePlane(kTBLayout16Bit, 10, 1, 2, "Y0"));
+			planes.push_back(MakePlane(kTBLayout16Bit, 10, 2, 4, "U0V0"));
+			break;
+
+		// like AJATimeCodeBurn, only the luma plane of these
+		case AJA_PixelFormat_YCBCR10_420PL:
+		case AJA_PixelFormat_YCBCR10_422PL:		planes.push_back(MakePlane(kTBLayoutBitStream, 10, 4, 5, "Y0Y1Y2Y3"));	break;
+		case AJA_PixelFormat_YCBCR8_420PL:
+		case AJA_PixelFormat_YCBCR8_422PL:		planes.push_back(MakePlane(kTBLayout8Bit, 8, 1, 1, "Y0"));				break;
+
+		default:
+			return false;	//	we don't know how to do this pixel format...
+	}
+
+	// cells start on pixel groups, and on even lines for 4:2:0
+	uint32_t alignPixels (1), alignLines (1);
+	for (size_t ndx = 0;  ndx < planes.size();  ndx++)
+	{
+		while (alignPixels % uint32_t(planes[ndx].groupPixels))
+			alignPixels++;
+		if (uint32_t(planes[ndx].vertSub) > alignLines)
+			alignLines = uint32_t(planes[ndx].vertSub);
+	}
+	if (numPixels < alignPixels || numLines < alignLines)
+		return false;
+
+	if (!rowBytes)
+		rowBytes = pixelFormat == AJA_PixelFormat_YCbCr10  ?  AJA_CalcRowBytesForFormat(pixelFormat, numPixels)
+						:  (numPixels + planes[0].groupPixels - 1) / planes[0].groupPixels * planes[0].groupBytes;
+
+	// scale the characters based on the frame size they'll be used in, as AJATimeCodeBurn does
+	uint32_t dotScale (1);					// SD scale
+	if (numLines > 3600)
+		dotScale = 12;						// 8K
+	else if (numLines > 1800)
+		dotScale = 6;						// UHD/4K
+	else if (numLines > 900)
+		dotScale = 3;						// HD 1080
+	else if (numLines > 650)
+		dotScale = 2;						// HD 720
+	_dotWidth = dotScale;					// pixels per "dot"
+	_dotHeight = 2 * dotScale;				// frame lines per "dot"
+	if (numLines > 900 && numLines <= 1800 && numPixels <= 1440)
+		_dotWidth = 2;						// 1280x1080 or 1440x1080 have horizontally-scaled pixels
+	_cellWidth = kTCDigitDotWidth * _dotWidth;		// a multiple of 6, so whole v210 groups
+	_cellHeight = kTCDigitDotHeight * _dotHeight;	// always even
+
+	size_t offset (0);
+	for (size_t ndx = 0;  ndx < planes.size();  ndx++)
+	{
+		Plane & plane (planes[ndx]);
+		plane.rowBytes = rowBytes / uint32_t(plane.rowBytesDiv);
+		plane.offset = offset;
+		plane.cellComps = _cellWidth / uint32_t(plane.groupPixels) * uint32_t(plane.comps.size());
+		plane.cellBytes = _cellWidth / uint32_t(plane.groupPixels) * uint32_t(plane.groupBytes);
+		plane.cellLines = _cellHeight / uint32_t(plane.vertSub);
+		offset += size_t(plane.rowBytes) * (numLines / uint32_t(plane.vertSub));
+	}
+
+	_planes = planes;
+	_numPixels = numPixels;
+	_numLines = numLines;
+	_alignPixels = alignPixels;
+	_alignLines = alignLines;
+	_isRGB = isRGB;
+	_isLegalRGB = isLegalRGB;
+	_isSD = numLines < 720;
+	_glyphs.resize(kTBNumGlyphs);
+	return true;
+}
+
+
+void AJATextBurn::SetColors (const AJA_RGBAlphaPixel & textColor, const AJA_RGBAlphaPixel & backgroundColor)
+{
+	_textColor = textColor;
+	_backColor = backgroundColor;
+	_glyphs.clear();
+	_glyphs.resize(_planes.empty() ? 0 : kTBNumGlyphs);
+	_overlays.clear();
+}
+
+
+bool AJATextBurn::BurnText (void * pBaseVideoAddress, const std::string & inText, uint32_t inPixelX, uint32_t inLineY,
+							uint32_t inOverlayID, bool inRedrawAll)
+{
+	if (_planes.empty())
+		return false;	//	Uninitialized
+	if (!pBaseVideoAddress)
+		return false;	//	NULL address
+
+	const uint32_t pixelX (inPixelX - inPixelX % _alignPixels);
+	const uint32_t lineY (inLineY - inLineY % _alignLines);
+	if (lineY + _cellHeight > _numLines)
+		return false;	//	Off the bottom
+
+	size_t numCells (inText.length());
+	const size_t maxCells (pixelX < _numPixels  ?  (_numPixels - pixelX) / _cellWidth  :  0);
+	if (numCells > maxCells)
+		numCells = maxCells;
+
+	// find what this overlay last drew into this raster
+	const OverlayKey key (pBaseVideoAddress, inOverlayID);
+	OverlayMap::iterator it (_overlays.find(key));
+	if (it == _overlays.end())
+	{
+		if (_overlays.size() >= kTBMaxOverlays)
+		{
+			OverlayMap::iterator oldest (_overlays.begin());
+			for (OverlayMap::iterator check (_overlays.begin());  check != _overlays.end();  ++check)
+				if (check->second.lastUsed < oldest->second.lastUsed)
+					oldest = check;
+			_overlays.erase(oldest);
+		}
+		it = _overlays.insert(OverlayMap::value_type(key, Overlay())).first;
+		it->second.pixelX = pixelX;
+		it->second.lineY = lineY;
+	}
+	Overlay & overlay (it->second);
+	uint8_t * pRaster (reinterpret_cast<uint8_t*>(pBaseVideoAddress));
+
+	if (inRedrawAll)
+	{
+		// the raster has new content, so what was under the cells is gone
+		overlay.text.clear();
+		overlay.under.clear();
+	}
+	else if (overlay.pixelX != pixelX || overlay.lineY != lineY)
+	{
+		// moved: put the raster back the way it was
+		for (size_t cell = 0;  cell < overlay.text.length();  cell++)
+			RestoreCell(pRaster, overlay.pixelX + uint32_t(cell) * _cellWidth, overlay.lineY, overlay.under[cell]);
+		overlay.text.clear();
+		overlay.under.clear();
+	}
+	overlay.pixelX = pixelX;
+	overlay.lineY = lineY;
+	overlay.lastUsed = ++_useCount;
+
+	for (size_t cell = 0;  cell < numCells;  cell++)
+	{
+		const uint32_t cellX (pixelX + uint32_t(cell) * _cellWidth);
+		if (cell < overlay.text.length())
+		{
+			if (overlay.text[cell] == inText[cell])
+				continue;	//	Unchanged
+			if (_backColor.Alpha != 0xFF)
+				RestoreCell(pRaster, cellX, lineY, overlay.under[cell]);	// an opaque cell covers the old one anyway
+		}
+		else
+		{
+			overlay.under.push_back(std::vector<uint8_t>());
+			SaveCell(pRaster, cellX, lineY, overlay.under.back());
+		}
+		DrawCell(pRaster, cellX, lineY, GetGlyph(inText[cell]));
+	}
+
+	// put back what was under cells the text no longer reaches
+	for (size_t cell = numCells;  cell < overlay.text.length();  cell++)
+		RestoreCell(pRaster, pixelX + uint32_t(cell) * _cellWidth, lineY, overlay.under[cell]);
+	overlay.under.resize(numCells);
+	overlay.text.assign(inText, 0, numCells);
+	return true;
+}
+
+
+bool AJATextBurn::BurnTimeCode (void * pBaseVideoAddress, const std::string & inTimeCodeStr, uint32_t inYPercent,
+								uint32_t inOverlayID, bool inRedrawAll)
+{
+	if (_planes.empty())
+		return false;	//	Uninitialized
+
+	if (inYPercent > 100)
+		inYPercent = 100;	//	Limit to 100%
+	else if (!inYPercent)
+		inYPercent = 80;	//	0% ==> 80%
+
+	uint32_t lineY ((_numLines * inYPercent) / 100);
+	if (lineY + _cellHeight > _numLines)
+		lineY = _numLines - _cellHeight;
+
+	const uint32_t textWidth (uint32_t(inTimeCodeStr.length()) * _cellWidth);
+	const uint32_t pixelX (textWidth < _numPixels  ?  (_numPixels - textWidth) / 2  :  0);		// centered
+	return BurnText(pBaseVideoAddress, inTimeCodeStr, pixelX, lineY, inOverlayID, inRedrawAll);
+}
+
+
+void AJATextBurn::Invalidate (const void * pBaseVideoAddress)
+{
+	if (!pBaseVideoAddress)
+	{
+		_overlays.clear();
+		return;
+	}
+	for (OverlayMap::iterator it (_overlays.begin());  it != _overlays.end();  )
+	{
+		if (it->first.first == pBaseVideoAddress)
+			_overlays.erase(it++);
+		else
+			++it;
+	}
+}
+
+
+// value of a color channel in component units
+double AJATextBurn::ChannelValue (int channel, const AJA_RGBAlphaPixel & color, int bits) const
+{
+	const double r (color.Red / 255.0), g (color.Green / 255.0), b (color.Blue / 255.0);
+	const double scale8 (double(1 << (bits - 8)));		// 8-bit video levels ==> component levels
+	if (_isRGB)
+	{
+		double value (channel == kTBChannelR ? r : (channel == kTBChannelG ? g : b));
+		if (_isLegalRGB)
+			return (16.0 + 219.0 * value) * scale8;
+		return value * double((1 << bits) - 1);
+	}
+
+	const double kr (_isSD ? 0.299 : 0.2126), kb (_isSD ? 0.114 : 0.0722);
+	const double y (kr * r + (1.0 - kr - kb) * g + kb * b);
+	switch (channel)
+	{
+		case kTBChannelY:	return (16.0 + 219.0 * y) * scale8;
+		case kTBChannelCb:	return (128.0 + 224.0 * (b - y) / (2.0 * (1.0 - kb))) * scale8;
+		case kTBChannelCr:	return (128.0 + 224.0 * (r - y) / (2.0 * (1.0 - kr))) * scale8;
+		default:			break;
+	}
+	return 0.0;
+}
+
+
+const AJATextBurn::Glyph & AJATextBurn::GetGlyph (char inChar)
+{
+	int glyphIndex ('?' - kTBFirstGlyph);
+	if (inChar >= kTBFirstGlyph && inChar <= kTBLastGlyph)
+		glyphIndex = inChar - kTBFirstGlyph;
+
+	Glyph & glyph (_glyphs[size_t(glyphIndex)]);
+	if (glyph.lineUsed.empty())
+		RenderGlyph(glyphIndex, glyph);
+	return glyph;
+}
+
+
+void AJATextBurn::RenderGlyph (int glyphIndex, Glyph & outGlyph) const
+{
+	// coverage of each cell pixel, 0 - 3
+	std::vector<uint8_t> coverage(size_t(_cellWidth) * _cellHeight);
+	for (uint32_t y = 0;  y < _cellHeight;  y++)
+		for (uint32_t x = 0;  x < _cellWidth;  x++)
+			coverage[size_t(y) * _cellWidth + x] = uint8_t(TextBurnDot(glyphIndex, int(x / _dotWidth), int(y / _dotHeight)));
+
+	const double textAlpha (_textColor.Alpha / 255.0), backAlpha (_backColor.Alpha / 255.0);
+	outGlyph.inv.clear();
+	outGlyph.premul.clear();
+	outGlyph.lineUsed.clear();
+	for (size_t planeNdx = 0;  planeNdx < _planes.size();  planeNdx++)
+	{
+		const Plane & plane (_planes[planeNdx]);
+		const double maxValue (double((1 << plane.bits) - 1));
+		for (uint32_t line = 0;  line < plane.cellLines;  line++)
+		{
+			bool used (false);
+			for (uint32_t groupX = 0;  groupX < _cellWidth;  groupX += uint32_t(plane.groupPixels))
+				for (size_t compNdx = 0;  compNdx < plane.comps.size();  compNdx++)
+				{
+					const Component & comp (plane.comps[compNdx]);
+					if (comp.channel == kTBChannelNone)
+					{
+						outGlyph.inv.push_back(uint16_t(kTBAlphaOne));
+						outGlyph.premul.push_back(0);
+						continue;
+					}
+
+					// average the coverage of the pixels the component covers (chroma is subsampled)
+					uint32_t total (0), count (0);
+					for (uint32_t y = line * uint32_t(plane.vertSub);  y < (line + 1) * uint32_t(plane.vertSub);  y++)
+						for (uint32_t x = groupX + uint32_t(comp.pixel);  x < groupX + uint32_t(comp.pixel + comp.span);  x++, count++)
+							total += coverage[size_t(y) * _cellWidth + x];
+
+					// text over background over video
+					const double text (textAlpha * total / (3.0 * count));
+					const double alpha (text + backAlpha * (1.0 - text));
+					double premul (ChannelValue(comp.channel, _textColor, plane.bits) * text
+									+ ChannelValue(comp.channel, _backColor, plane.bits) * backAlpha * (1.0 - text));
+					if (premul > maxValue)
+						premul = maxValue;
+					const uint16_t inv (uint16_t((1.0 - alpha) * kTBAlphaOne + 0.5));
+					outGlyph.inv.push_back(inv);
+					outGlyph.premul.push_back(uint16_t(premul + 0.5));
+					if (inv != kTBAlphaOne || premul >= 0.5)
+						used = true;
+				}
+			outGlyph.lineUsed.push_back(used ? 1 : 0);
+		}
+	}
+}
+
+
+void AJATextBurn::SaveCell (const uint8_t * pRaster, uint32_t pixelX, uint32_t lineY, std::vector<uint8_t> & outBytes) const
+{
+	outBytes.clear();
+	for (size_t planeNdx = 0;  planeNdx < _planes.size();  planeNdx++)
+	{
+		const Plane & plane (_planes[planeNdx]);
+		const uint8_t * pLine (pRaster + plane.offset + size_t(lineY / uint32_t(plane.vertSub)) * plane.rowBytes
+								+ pixelX / uint32_t(plane.groupPixels) * uint32_t(plane.groupBytes));
+		for (uint32_t line = 0;  line < plane.cellLines;  line++, pLine += plane.rowBytes)
+			outBytes.insert(outBytes.end(), pLine, pLine + plane.cellBytes);
+	}
+}
+
+
+void AJATextBurn::RestoreCell (uint8_t * pRaster, uint32_t pixelX, uint32_t lineY, const std::vector<uint8_t> & inBytes) const
+{
+	const uint8_t * pSrc (inBytes.empty() ? NULL : &inBytes[0]);
+	for (size_t planeNdx = 0;  planeNdx < _planes.size();  planeNdx++)
+	{
+		const Plane & plane (_planes[planeNdx]);
+		uint8_t * pLine (pRaster + plane.offset + size_t(lineY / uint32_t(plane.vertSub)) * plane.rowBytes
+							+ pixelX / uint32_t(plane.groupPixels) * uint32_t(plane.groupBytes));
+		for (uint32_t line = 0;  line < plane.cellLines;  line++, pLine += plane.rowBytes, pSrc += plane.cellBytes)
+			memcpy(pLine, pSrc, plane.cellBytes);
+	}
+}
+
+
+void AJATextBurn::DrawCell (uint8_t * pRaster, uint32_t pixelX, uint32_t lineY, const Glyph & inGlyph)
+{
+	size_t compOffset (0), lineNdx (0);
+	for (size_t planeNdx = 0;  planeNdx < _planes.size();  planeNdx++)
+	{
+		const Plane & plane (_planes[planeNdx]);
+		uint8_t * pLine (pRaster + plane.offset + size_t(lineY / uint32_t(plane.vertSub)) * plane.rowBytes
+							+ pixelX / uint32_t(plane.groupPixels) * uint32_t(plane.groupBytes));
+		if (_line.size() < plane.cellComps)
+			_line.resize(plane.cellComps);
+		for (uint32_t line = 0;  line < plane.cellLines;  line++, pLine += plane.rowBytes, compOffset += plane.cellComps)
+		{
+			if (!inGlyph.lineUsed[lineNdx++])
+				continue;	//	Nothing to draw on this line
+			const uint16_t * pInv (&inGlyph.inv[compOffset]);
+			const uint16_t * pPremul (&inGlyph.premul[compOffset]);
+			if (plane.layout == kTBLayout8Bit)
+				TextBurnBlend8(pLine, pInv, pPremul, plane.cellComps);
+			else
+			{
+				UnpackLine(plane, pLine, &_line[0]);
+				TextBurnBlend16(&_line[0], pInv, pPremul, plane.cellComps, plane.bits);
+				PackLine(plane, &_line[0], pLine);
+			}
+		}
+	}
+}
+
+
+void AJATextBurn::UnpackLine (const Plane & plane, const uint8_t * pSrc, uint16_t * pLine)
+{
+	const uint32_t mask ((1U << plane.bits) - 1);
+	switch (plane.layout)
+	{
+		case kTBLayout16Bit:
+			for (uint32_t ndx = 0;  ndx < plane.cellComps;  ndx++)
+				pLine[ndx] = uint16_t(((uint32_t(pSrc[2 * ndx]) | (uint32_t(pSrc[2 * ndx + 1]) << 8)) >> plane.shift) & mask);
+			break;
+
+		case kTBLayoutWordLE:
+		case kTBLayoutWordBE:
+			for (uint32_t ndx = 0;  ndx < plane.cellComps;  ndx += 3, pSrc += 4)
+			{
+				const uint32_t word (plane.layout == kTBLayoutWordLE
+										?  uint32_t(pSrc[0]) | (uint32_t(pSrc[1]) << 8) | (uint32_t(pSrc[2]) << 16) | (uint32_t(pSrc[3]) << 24)
+										:  uint32_t(pSrc[3]) | (uint32_t(pSrc[2]) << 8) | (uint32_t(pSrc[1]) << 16) | (uint32_t(pSrc[0]) << 24));
+				for (int field = 0;  field < 3;  field++)
+					pLine[ndx + uint32_t(field)] = uint16_t((word >> plane.fieldShift[field]) & mask);
+			}
+			break;
+
+		case kTBLayoutBitStream:
+			for (uint32_t ndx = 0, bit = 0;  ndx < plane.cellComps;  ndx++, bit += uint32_t(plane.bits))
+			{
+				// a component of up to 12 bits spans at most 3 bytes
+				const uint8_t * p (pSrc + bit / 8);
+				const uint32_t numBytes ((bit % 8 + uint32_t(plane.bits) + 7) / 8);
+				uint32_t value (0);
+				for (uint32_t byte = 0;  byte < numBytes;  byte++)
+					value |= uint32_t(p[byte]) << (8 * byte);
+				pLine[ndx] = uint16_t((value >> (bit % 8)) & mask);
+			}
+			break;
+	}
+}
+
+
+void AJATextBurn::PackLine (const Plane & plane, const uint16_t * pLine, uint8_t * pDst)
+{
+	const uint32_t mask ((1U << plane.bits) - 1);
+	switch (plane.layout)
+	{
+		case kTBLayout16Bit:
+			for (uint32_t ndx = 0;  ndx < plane.cellComps;  ndx++)
+			{
+				const uint32_t value (uint32_t(pLine[ndx]) << plane.shift);
+				pDst[2 * ndx] = uint8_t(value);
+				pDst[2 * ndx + 1] = uint8_t(value >> 8);
+			}
+			break;
+
+		case kTBLayoutWordLE:
+		case kTBLayoutWordBE:
+		{
+			// keep the bits outside the components (v210 and DPX padding)
+			const uint32_t keep (~((mask << plane.fieldShift[0]) | (mask << plane.fieldShift[1]) | (mask << plane.fieldShift[2])));
+			for (uint32_t ndx = 0;  ndx < plane.cellComps;  ndx += 3, pDst += 4)
+			{
+				const int b0 (plane.layout == kTBLayoutWordLE ? 0 : 3), step (plane.layout == kTBLayoutWordLE ? 1 : -1);
+				uint32_t word (uint32_t(pDst[b0]) | (uint32_t(pDst[b0 + step]) << 8) | (uint32_t(pDst[b0 + 2 * step]) << 16) | (uint32_t(pDst[b0 + 3 * step]) << 24));
+				word &= keep;
+				for (int field = 0;  field < 3;  field++)
+					word |= uint32_t(pLine[ndx + uint32_t(field)]) << plane.fieldShift[field];
+				for (int byte = 0;  byte < 4;  byte++)
+					pDst[b0 + byte * step] = uint8_t(word >> (8 * byte));
+			}
+			break;
+		}
+
+		case kTBLayoutBitStream:
+			for (uint32_t ndx = 0, bit = 0;  ndx < plane.cellComps;  ndx++, bit += uint32_t(plane.bits))
+			{
+				uint8_t * p (pDst + bit / 8);
+				const uint32_t numBytes ((bit % 8 + uint32_t(plane.bits) + 7) / 8);
+				const uint32_t value (uint32_t(pLine[ndx]) << (bit % 8)), valueMask (mask << (bit % 8));
+				for (uint32_t byte = 0;  byte < numBytes;  byte++)
+					p[byte] = uint8_t((p[byte] & ~(valueMask >> (8 * byte))) | (value >> (8 * byte)));
+			}
+			break;
+	}
+}
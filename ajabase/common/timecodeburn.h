@@ -10,7 +10,10 @@
 
 #include "ajabase/common/export.h"
 #include "ajabase/common/videotypes.h"
+#include "ajabase/common/videoutilities.h"
+#include <map>
 #include <string>
+#include <vector>
 
 /**
  *	Class to support burning a simple timecode over raster.
@@ -66,4 +69,166 @@ private:
 	int					_rowBytes;
 };
 
+
+/**
+ *	Class to burn text overlays (timecode, channel names, frame counters, status) over raster.
+ *
+ *	Glyphs are rendered on first use into a per-format cache of component blend weights, then
+ *	alpha composited over the raster (with SSE2 where available).  Each overlay remembers what it
+ *	last drew into each raster, and redraws only the character cells that changed since then.
+ *	@ingroup AJATimeCodeBurn
+ */
+class AJATextBurn
+{
+public:
+	AJA_EXPORT AJATextBurn(void);
+	AJA_EXPORT virtual ~AJATextBurn(void);
+
+	/**
+	 *	Prepares for a raster format.  This needs to be called before BurnText or BurnText will fail.
+	 *	Supports 8-bit YCbCr and RGB, 10-bit YCbCr (v210), 10-bit RGB and DPX, 12-bit packed RGB,
+	 *	and the 8 and 10-bit planar YCbCr formats.
+	 *
+	 *	@param[in]	pixelFormat		Specifies the pixel format of the raster.
+	 *	@param[in]	numPixels		Specifies the raster width.
+	 *	@param[in]	numLines		Specifies the raster height.
+	 *	@param[in]	rowBytes		Specifies the bytes per line (of the luma plane for planar formats).
+	 *								If 0, uses the unpadded line size for the format.
+	 *	@returns	True if successful;	 otherwise false.
+	 */
+	AJA_EXPORT bool SetRasterFormat (AJA_PixelFormat pixelFormat, uint32_t numPixels, uint32_t numLines, uint32_t rowBytes = 0);
+
+	/**
+	 *	Sets the overlay colors, and forgets what was drawn.  The default is opaque white text on
+	 *	an opaque black background, which looks like AJATimeCodeBurn.
+	 *
+	 *	@param[in]	textColor		Text color.  Alpha is its opacity.
+	 *	@param[in]	backgroundColor	Color of the box behind each character.  Alpha 0 leaves the video visible.
+	 */
+	AJA_EXPORT void SetColors (const AJA_RGBAlphaPixel & textColor, const AJA_RGBAlphaPixel & backgroundColor);
+
+	/**
+	 *	@returns	The width of a character cell in pixels (zero before SetRasterFormat).
+	 */
+	AJA_EXPORT uint32_t GetCellWidth (void) const		{return _cellWidth;}
+
+	/**
+	 *	@returns	The height of a character cell in lines (zero before SetRasterFormat).
+	 */
+	AJA_EXPORT uint32_t GetCellHeight (void) const		{return _cellHeight;}
+
+	/**
+	 *	Burns a line of text.  Only the cells whose characters differ from what this overlay last
+	 *	drew into the same raster are redrawn, so the raster must not have been rewritten under the
+	 *	overlay since then -- pass inRedrawAll for a newly captured or rendered frame.
+	 *
+	 *	@param[in]	pBaseVideoAddress	Base address of Raster
+	 *	@param[in]	inText				The text.  Characters outside printable ASCII are drawn as '?'.
+	 *	@param[in]	inPixelX			Left edge in pixels, rounded down to the pixel format's alignment.
+	 *									Characters past the right edge of the raster are dropped.
+	 *	@param[in]	inLineY				Top edge in lines, rounded down to an even line for 4:2:0.
+	 *	@param[in]	inOverlayID			Identifies the overlay, so several can be burned into the same raster.
+	 *	@param[in]	inRedrawAll			If true, draws every cell, as the raster has new content.
+	 *	@returns	True if successful;	 otherwise false.
+	 */
+	AJA_EXPORT bool BurnText (void * pBaseVideoAddress, const std::string & inText, uint32_t inPixelX, uint32_t inLineY,
+								uint32_t inOverlayID = 0, bool inRedrawAll = false);
+
+	/**
+	 *	Burns a timecode centered horizontally, like AJATimeCodeBurn::BurnTimeCode.
+	 *
+	 *	@param[in]	pBaseVideoAddress	Base address of Raster
+	 *	@param[in]	inTimeCodeStr		A string containing something like "00:00:00:00"
+	 *	@param[in]	inYPercent			Percent down the screen. If 0, will make it 80.
+	 *	@param[in]	inOverlayID			Identifies the overlay, so several can be burned into the same raster.
+	 *	@param[in]	inRedrawAll			If true, draws every cell, as the raster has new content.
+	 *	@returns	True if successful;	 otherwise false.
+	 */
+	AJA_EXPORT bool BurnTimeCode (void * pBaseVideoAddress, const std::string & inTimeCodeStr, uint32_t inYPercent,
+									uint32_t inOverlayID = 0, bool inRedrawAll = false);
+
+	/**
+	 *	Forgets what was drawn into a raster, e.g. before its buffer is freed or reused for another
+	 *	format.  The next BurnText into it draws every cell.
+	 *
+	 *	@param[in]	pBaseVideoAddress	Base address of Raster.  If NULL, forgets every raster.
+	 */
+	AJA_EXPORT void Invalidate (const void * pBaseVideoAddress = NULL);
+
+private:
+	struct Component
+	{
+		int		channel;			// color channel, or none to leave it alone
+		int		pixel;				// first pixel it belongs to, within its group
+		int		span;				// pixels it covers (2 for 4:2:2 chroma)
+	};
+
+	struct Plane
+	{
+		int						layout;			// how the components are stored
+		int						bits;			// bits per component
+		int						shift;			// bit position of each 16-bit sample
+		int						fieldShift[3];	// bit positions of the components in each 32-bit word
+		int						groupPixels;	// pixels per group of components
+		int						groupBytes;		// bytes per group of components
+		int						vertSub;		// raster lines per plane line (2 for 4:2:0 chroma)
+		int						rowBytesDiv;	// plane row bytes = luma row bytes / rowBytesDiv
+		std::vector<Component>	comps;			// components of a group, in memory order
+		uint32_t				rowBytes;		// bytes per plane line
+		size_t					offset;			// offset of the plane from the base address
+		uint32_t				cellComps;		// components per cell line
+		uint32_t				cellBytes;		// bytes per cell line
+		uint32_t				cellLines;		// plane lines per cell
+	};
+
+	struct Glyph
+	{
+		std::vector<uint16_t>	inv;			// per component:  (1 - alpha) * 32768
+		std::vector<uint16_t>	premul;			// per component:  color * alpha
+		std::vector<uint8_t>	lineUsed;		// per cell line:  non-zero if the glyph changes it
+	};
+
+	struct Overlay
+	{
+		uint32_t							pixelX;		// position the cells were drawn at
+		uint32_t							lineY;
+		std::string							text;		// character drawn in each cell
+		std::vector<std::vector<uint8_t> >	under;		// raster bytes each cell covered before it was drawn
+		uint64_t							lastUsed;
+	};
+
+	typedef std::pair<const void *, uint32_t>	OverlayKey;
+	typedef std::map<OverlayKey, Overlay>		OverlayMap;
+
+	static Plane	MakePlane (int layout, int bits, int groupPixels, int groupBytes, const char * pComps,
+								int vertSub = 1, int rowBytesDiv = 1, int shift = 0);
+	double			ChannelValue (int channel, const AJA_RGBAlphaPixel & color, int bits) const;
+	const Glyph &	GetGlyph (char inChar);
+	void			RenderGlyph (int glyphIndex, Glyph & outGlyph) const;
+	void			SaveCell (const uint8_t * pRaster, uint32_t pixelX, uint32_t lineY, std::vector<uint8_t> & outBytes) const;
+	void			RestoreCell (uint8_t * pRaster, uint32_t pixelX, uint32_t lineY, const std::vector<uint8_t> & inBytes) const;
+	void			DrawCell (uint8_t * pRaster, uint32_t pixelX, uint32_t lineY, const Glyph & inGlyph);
+	static void		UnpackLine (const Plane & plane, const uint8_t * pSrc, uint16_t * pLine);
+	static void		PackLine (const Plane & plane, const uint16_t * pLine, uint8_t * pDst);
+
+	std::vector<Plane>		_planes;		// empty until SetRasterFormat succeeds
+	uint32_t				_numPixels;
+	uint32_t				_numLines;
+	uint32_t				_alignPixels;	// cells start on multiples of this many pixels
+	uint32_t				_alignLines;	// ...and lines
+	uint32_t				_dotWidth;		// pixels per font dot
+	uint32_t				_dotHeight;		// lines per font dot
+	uint32_t				_cellWidth;
+	uint32_t				_cellHeight;
+	bool					_isRGB;
+	bool					_isLegalRGB;	// RGB uses SMPTE range (DPX)
+	bool					_isSD;			// YCbCr uses the Rec. 601 matrix
+	AJA_RGBAlphaPixel		_textColor;
+	AJA_RGBAlphaPixel		_backColor;
+	std::vector<Glyph>		_glyphs;		// rendered on first use
+	OverlayMap				_overlays;
+	uint64_t				_useCount;
+	std::vector<uint16_t>	_line;			// one unpacked cell line
+};
+
 #endif	//	AJA_TIMECODEBURN_H
@@ -7,7 +7,13 @@
 
 #include "common.h"
 #include "videoutilities.h"
+#include "ajabase/system/threadpool.h"
 #include <string.h>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define AJA_YCBCR_CONVERT_SSE2	1
+#endif
 
 
 inline int FixedTrunc(int inFix)
@@ -1849,3 +1855,605 @@ inline int16_t CubicInterPolateAudioWord( int16_t *Input, int32_t Index)
 
 	return (int16_t)(InterPolatedValue&0xFFFF);
 }
+
+
+//***********************************************************************************************************
+// AJA_ConvertYCbCrFrame()
+//	Every row passes through 16-bit Y, Cb and Cr lines holding 10-bit samples, so each format needs only a
+//	reader and a writer. The source and destination are described by "views" that hold each plane's first row
+//	and the distance from one row to the next, so a field is just a view with half the rows at twice the stride.
+//	The work is split into bands of rows, each handled by one thread with its own small cache of source lines.
+//***********************************************************************************************************
+
+typedef enum
+{
+	kYCbCrPlanar,		//	2- or 3-plane
+	kYCbCrV210,			//	AJA_PixelFormat_YCbCr10
+	kYCbCr2vuy,			//	AJA_PixelFormat_YCbCr8:  Cb Y0 Cr Y1
+	kYCbCrYUY2			//	AJA_PixelFormat_YUY28:   Y0 Cb Y1 Cr
+} YCbCrPacking;
+
+typedef enum
+{
+	kYCbCrSample8Bit,		//	One byte per sample
+	kYCbCrSample10BitLSB,	//	Two bytes per sample (little-endian), in the low 10 bits
+	kYCbCrSample10BitMSB	//	Two bytes per sample (little-endian), in the high 10 bits (P010)
+} YCbCrSample;
+
+typedef struct YCbCrView
+{
+	YCbCrPacking	fPacking;
+	YCbCrSample		fSample;			//	Planar only
+	bool			fInterleaved;		//	Planar only:  true if Cb & Cr share a plane
+	uint32_t		fChromaVert;		//	Planar only:  2 for 4:2:0, otherwise 1
+	uint32_t		fWidth;
+	uint32_t		fHeight;			//	Luma rows
+	uint8_t *		fpPlane[3];			//	First row of each plane (packed formats use only the first)
+	size_t			fStride[3];			//	Bytes from one row of each plane to the next
+} YCbCrView;
+
+static bool MakeYCbCrView (const AJA_PixelFormat inFormat, const void * pInFrame, const uint32_t inWidth, const uint32_t inHeight, YCbCrView & outView)
+{
+	::memset(&outView, 0, sizeof(outView));
+	outView.fPacking = kYCbCrPlanar;
+	outView.fSample = kYCbCrSample8Bit;
+	outView.fChromaVert = 1;
+	switch (inFormat)
+	{
+		case AJA_PixelFormat_YCbCr10:			outView.fPacking = kYCbCrV210;		break;
+		case AJA_PixelFormat_YCbCr8:			outView.fPacking = kYCbCr2vuy;		break;
+		case AJA_PixelFormat_YUY28:				outView.fPacking = kYCbCrYUY2;		break;
+		case AJA_PixelFormat_YCBCR8_420PL3:		outView.fChromaVert = 2;			break;
+		case AJA_PixelFormat_YCBCR8_422PL3:											break;
+		case AJA_PixelFormat_YCBCR10_420PL3LE:	outView.fSample = kYCbCrSample10BitLSB;  outView.fChromaVert = 2;		break;
+		case AJA_PixelFormat_YCBCR10_422PL3LE:	outView.fSample = kYCbCrSample10BitLSB;									break;
+		case AJA_PixelFormat_YCBCR8_420PL2:		outView.fInterleaved = true;  outView.fChromaVert = 2;					break;
+		case AJA_PixelFormat_YCBCR8_422PL2:		outView.fInterleaved = true;											break;
+		case AJA_PixelFormat_YCBCR10_420PL2LE:	outView.fSample = kYCbCrSample10BitMSB;  outView.fInterleaved = true;  outView.fChromaVert = 2;	break;
+		case AJA_PixelFormat_YCBCR10_422PL2LE:	outView.fSample = kYCbCrSample10BitLSB;  outView.fInterleaved = true;	break;
+		default:								return false;
+	}
+	outView.fWidth = inWidth;
+	outView.fHeight = inHeight;
+	outView.fpPlane[0] = reinterpret_cast<uint8_t*>(const_cast<void*>(pInFrame));
+	if (outView.fPacking != kYCbCrPlanar)
+	{
+		outView.fStride[0] = AJA_CalcRowBytesForFormat(inFormat, inWidth);
+		return true;
+	}
+	const size_t sampleBytes (outView.fSample == kYCbCrSample8Bit ? 1 : 2);
+	const size_t chromaRows (inHeight / outView.fChromaVert);
+	outView.fStride[0] = inWidth * sampleBytes;
+	outView.fStride[1] = outView.fStride[2] = outView.fInterleaved ? inWidth * sampleBytes : inWidth / 2 * sampleBytes;
+	outView.fpPlane[1] = outView.fpPlane[0] + outView.fStride[0] * inHeight;
+	outView.fpPlane[2] = outView.fInterleaved ? NULL : outView.fpPlane[1] + outView.fStride[1] * chromaRows;
+	return true;
+}
+
+//	Answers with a view of the given field (0 or 1) of the given frame view
+static YCbCrView FieldOfYCbCrView (const YCbCrView & inFrame, const uint32_t inField)
+{
+	YCbCrView field (inFrame);
+	field.fHeight = inFrame.fHeight / 2;
+	for (int plane(0);  plane < 3;  plane++)
+		if (field.fpPlane[plane])
+		{
+			field.fpPlane[plane] += inField * field.fStride[plane];
+			field.fStride[plane] *= 2;
+		}
+	return field;
+}
+
+
+//	Rounds a 10-bit sample to 8 bits
+static inline uint8_t RoundTo8Bit (const uint16_t inSample)
+{
+	const uint16_t rounded ((inSample + 2) >> 2);
+	return uint8_t(rounded > 255 ? 255 : rounded);
+}
+
+//	Splits 2vuy or YUY2 pixel pairs into 10-bit Y, Cb & Cr
+static void Unpack8BitPairs (const uint8_t * pSrc, uint16_t * pY, uint16_t * pCb, uint16_t * pCr, const uint32_t inNumPairs, const bool inLumaFirst)
+{
+	uint32_t pair(0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i lowBytes (_mm_set1_epi16(0x00FF));
+	for (;  pair + 8 <= inNumPairs;  pair += 8, pSrc += 32)
+	{
+		const __m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+		const __m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16)));
+		const __m128i yA (inLumaFirst ? _mm_and_si128(a, lowBytes) : _mm_srli_epi16(a, 8));
+		const __m128i yB (inLumaFirst ? _mm_and_si128(b, lowBytes) : _mm_srli_epi16(b, 8));
+		__m128i cA (inLumaFirst ? _mm_srli_epi16(a, 8) : _mm_and_si128(a, lowBytes));	//	Cb0 Cr0 Cb1 Cr1 Cb2 Cr2 Cb3 Cr3
+		__m128i cB (inLumaFirst ? _mm_srli_epi16(b, 8) : _mm_and_si128(b, lowBytes));
+		cA = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(cA, _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0));	//	Cb0..3 Cr0..3
+		cB = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(cB, _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pY + pair * 2),     _mm_slli_epi16(yA, 2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pY + pair * 2 + 8), _mm_slli_epi16(yB, 2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pCb + pair), _mm_slli_epi16(_mm_unpacklo_epi64(cA, cB), 2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pCr + pair), _mm_slli_epi16(_mm_unpackhi_epi64(cA, cB), 2));
+	}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	const int yOffset (inLumaFirst ? 0 : 1),  cOffset (inLumaFirst ? 1 : 0);
+	for (;  pair < inNumPairs;  pair++, pSrc += 4)
+	{
+		pCb[pair]			= uint16_t(pSrc[cOffset]) << 2;
+		pY[pair * 2]		= uint16_t(pSrc[yOffset]) << 2;
+		pCr[pair]			= uint16_t(pSrc[cOffset + 2]) << 2;
+		pY[pair * 2 + 1]	= uint16_t(pSrc[yOffset + 2]) << 2;
+	}
+}
+
+//	Rounds 10-bit Y, Cb & Cr to 8 bits, and interleaves them into 2vuy or YUY2 pixel pairs
+static void Pack8BitPairs (const uint16_t * pY, const uint16_t * pCb, const uint16_t * pCr, uint8_t * pDst, const uint32_t inNumPairs, const bool inLumaFirst)
+{
+	uint32_t pair(0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i two (_mm_set1_epi16(2)),  maxByte (_mm_set1_epi16(0x00FF));
+	for (;  pair + 8 <= inNumPairs;  pair += 8, pDst += 32)
+	{
+		#define	ROUND8(__p__)	_mm_min_epi16(_mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(__p__)), two), 2), maxByte)
+		const __m128i yA (ROUND8(pY + pair * 2)),  yB (ROUND8(pY + pair * 2 + 8));
+		const __m128i cb (ROUND8(pCb + pair)),  cr (ROUND8(pCr + pair));
+		#undef	ROUND8
+		const __m128i cA (_mm_unpacklo_epi16(cb, cr)),  cB (_mm_unpackhi_epi16(cb, cr));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst),      inLumaFirst ? _mm_or_si128(yA, _mm_slli_epi16(cA, 8)) : _mm_or_si128(cA, _mm_slli_epi16(yA, 8)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 16), inLumaFirst ? _mm_or_si128(yB, _mm_slli_epi16(cB, 8)) : _mm_or_si128(cB, _mm_slli_epi16(yB, 8)));
+	}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	const int yOffset (inLumaFirst ? 0 : 1),  cOffset (inLumaFirst ? 1 : 0);
+	for (;  pair < inNumPairs;  pair++, pDst += 4)
+	{
+		pDst[cOffset]		= RoundTo8Bit(pCb[pair]);
+		pDst[yOffset]		= RoundTo8Bit(pY[pair * 2]);
+		pDst[cOffset + 2]	= RoundTo8Bit(pCr[pair]);
+		pDst[yOffset + 2]	= RoundTo8Bit(pY[pair * 2 + 1]);
+	}
+}
+
+//	Splits v210 into 10-bit Y, Cb & Cr, a whole 6-pixel group at a time (so up to 5 extra luma samples may be written)
+static void UnpackV210Row (const uint8_t * pSrc, uint16_t * pY, uint16_t * pCb, uint16_t * pCr, const uint32_t inWidth)
+{
+	const uint32_t * pWords (reinterpret_cast<const uint32_t*>(pSrc));
+	for (uint32_t pixel(0);  pixel < inWidth;  pixel += 6, pWords += 4, pY += 6, pCb += 3, pCr += 3)
+	{
+		const uint32_t w0(pWords[0]), w1(pWords[1]), w2(pWords[2]), w3(pWords[3]);
+		pCb[0] = w0 & 0x3FF;	pY[0] = (w0 >> 10) & 0x3FF;		pCr[0] = (w0 >> 20) & 0x3FF;
+		pY[1] = w1 & 0x3FF;		pCb[1] = (w1 >> 10) & 0x3FF;	pY[2] = (w1 >> 20) & 0x3FF;
+		pCr[1] = w2 & 0x3FF;	pY[3] = (w2 >> 10) & 0x3FF;		pCb[2] = (w2 >> 20) & 0x3FF;
+		pY[4] = w3 & 0x3FF;		pCr[2] = (w3 >> 10) & 0x3FF;	pY[5] = (w3 >> 20) & 0x3FF;
+	}
+}
+
+//	Packs 10-bit Y, Cb & Cr into v210, padding the last 6-pixel group with black
+static void PackV210Row (const uint16_t * pY, const uint16_t * pCb, const uint16_t * pCr, uint8_t * pDst, const uint32_t inWidth)
+{
+	uint32_t * pWords (reinterpret_cast<uint32_t*>(pDst));
+	for (uint32_t pixel(0);  pixel < inWidth;  pixel += 6, pWords += 4, pY += 6, pCb += 3, pCr += 3)
+	{
+		uint16_t y[6] = {CCIR601_10BIT_BLACK, CCIR601_10BIT_BLACK, CCIR601_10BIT_BLACK, CCIR601_10BIT_BLACK, CCIR601_10BIT_BLACK, CCIR601_10BIT_BLACK};
+		uint16_t cb[3] = {CCIR601_10BIT_CHROMAOFFSET, CCIR601_10BIT_CHROMAOFFSET, CCIR601_10BIT_CHROMAOFFSET};
+		uint16_t cr[3] = {CCIR601_10BIT_CHROMAOFFSET, CCIR601_10BIT_CHROMAOFFSET, CCIR601_10BIT_CHROMAOFFSET};
+		const uint32_t numPixels (inWidth - pixel < 6 ? inWidth - pixel : 6);
+		::memcpy(y, pY, numPixels * sizeof(uint16_t));
+		::memcpy(cb, pCb, numPixels / 2 * sizeof(uint16_t));
+		::memcpy(cr, pCr, numPixels / 2 * sizeof(uint16_t));
+		pWords[0] = uint32_t(cb[0] & 0x3FF) | (uint32_t(y[0] & 0x3FF) << 10) | (uint32_t(cr[0] & 0x3FF) << 20);
+		pWords[1] = uint32_t(y[1] & 0x3FF) | (uint32_t(cb[1] & 0x3FF) << 10) | (uint32_t(y[2] & 0x3FF) << 20);
+		pWords[2] = uint32_t(cr[1] & 0x3FF) | (uint32_t(y[3] & 0x3FF) << 10) | (uint32_t(cb[2] & 0x3FF) << 20);
+		pWords[3] = uint32_t(y[4] & 0x3FF) | (uint32_t(cr[2] & 0x3FF) << 10) | (uint32_t(y[5] & 0x3FF) << 20);
+	}
+}
+
+//	Reads one plane row of 8-bit or 16-bit samples into 10-bit samples
+static void ReadPlaneSamples (const uint8_t * pSrc, uint16_t * pDst, const uint32_t inCount, const YCbCrSample inSample)
+{
+	uint32_t ndx(0);
+	if (inSample == kYCbCrSample8Bit)
+	{
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+		const __m128i zero (_mm_setzero_si128());
+		for (;  ndx + 16 <= inCount;  ndx += 16)
+		{
+			const __m128i v (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + ndx)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx),     _mm_slli_epi16(_mm_unpacklo_epi8(v, zero), 2));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx + 8), _mm_slli_epi16(_mm_unpackhi_epi8(v, zero), 2));
+		}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+		for (;  ndx < inCount;  ndx++)
+			pDst[ndx] = uint16_t(pSrc[ndx]) << 2;
+		return;
+	}
+	const uint16_t * pWords (reinterpret_cast<const uint16_t*>(pSrc));
+	const int shift (inSample == kYCbCrSample10BitMSB ? 6 : 0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i mask (_mm_set1_epi16(0x03FF)),  count (_mm_cvtsi32_si128(shift));
+	for (;  ndx + 8 <= inCount;  ndx += 8)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx),
+						_mm_and_si128(_mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + ndx)), count), mask));
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	for (;  ndx < inCount;  ndx++)
+		pDst[ndx] = (pWords[ndx] >> shift) & 0x3FF;
+}
+
+//	Writes 10-bit samples into one plane row of 8-bit (rounded) or 16-bit samples
+static void WritePlaneSamples (const uint16_t * pSrc, uint8_t * pDst, const uint32_t inCount, const YCbCrSample inSample)
+{
+	uint32_t ndx(0);
+	if (inSample == kYCbCrSample8Bit)
+	{
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+		const __m128i two (_mm_set1_epi16(2));
+		for (;  ndx + 16 <= inCount;  ndx += 16)
+		{
+			const __m128i a (_mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + ndx)), two), 2));
+			const __m128i b (_mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + ndx + 8)), two), 2));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx), _mm_packus_epi16(a, b));	//	Saturates 256 to 255
+		}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+		for (;  ndx < inCount;  ndx++)
+			pDst[ndx] = RoundTo8Bit(pSrc[ndx]);
+		return;
+	}
+	uint16_t * pWords (reinterpret_cast<uint16_t*>(pDst));
+	const int shift (inSample == kYCbCrSample10BitMSB ? 6 : 0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i mask (_mm_set1_epi16(0x03FF)),  count (_mm_cvtsi32_si128(shift));
+	for (;  ndx + 8 <= inCount;  ndx += 8)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pWords + ndx),
+						_mm_sll_epi16(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + ndx)), mask), count));
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	for (;  ndx < inCount;  ndx++)
+		pWords[ndx] = uint16_t((pSrc[ndx] & 0x3FF) << shift);
+}
+
+//	Reads one row of an interleaved (2-plane) chroma plane into separate 10-bit Cb & Cr
+static void ReadInterleavedChroma (const uint8_t * pSrc, uint16_t * pCb, uint16_t * pCr, const uint32_t inNumPairs, const YCbCrSample inSample)
+{
+	uint32_t pair(0);
+	if (inSample == kYCbCrSample8Bit)
+	{
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+		const __m128i lowBytes (_mm_set1_epi16(0x00FF));
+		for (;  pair + 8 <= inNumPairs;  pair += 8)
+		{
+			const __m128i v (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + pair * 2)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pCb + pair), _mm_slli_epi16(_mm_and_si128(v, lowBytes), 2));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pCr + pair), _mm_slli_epi16(_mm_srli_epi16(v, 8), 2));
+		}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+		for (;  pair < inNumPairs;  pair++)
+			{pCb[pair] = uint16_t(pSrc[pair * 2]) << 2;  pCr[pair] = uint16_t(pSrc[pair * 2 + 1]) << 2;}
+		return;
+	}
+	const uint16_t * pWords (reinterpret_cast<const uint16_t*>(pSrc));
+	const int shift (inSample == kYCbCrSample10BitMSB ? 6 : 0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i mask (_mm_set1_epi16(0x03FF)),  count (_mm_cvtsi32_si128(shift));
+	for (;  pair + 8 <= inNumPairs;  pair += 8)
+	{
+		__m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + pair * 2)));		//	Cb0 Cr0 Cb1 Cr1 Cb2 Cr2 Cb3 Cr3
+		__m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + pair * 2 + 8)));
+		a = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0));	//	Cb0..3 Cr0..3
+		b = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(b, _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0)), _MM_SHUFFLE(3,1,2,0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pCb + pair), _mm_and_si128(_mm_srl_epi16(_mm_unpacklo_epi64(a, b), count), mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pCr + pair), _mm_and_si128(_mm_srl_epi16(_mm_unpackhi_epi64(a, b), count), mask));
+	}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	for (;  pair < inNumPairs;  pair++)
+		{pCb[pair] = (pWords[pair * 2] >> shift) & 0x3FF;  pCr[pair] = (pWords[pair * 2 + 1] >> shift) & 0x3FF;}
+}
+
+//	Writes separate 10-bit Cb & Cr into one row of an interleaved (2-plane) chroma plane
+static void WriteInterleavedChroma (const uint16_t * pCb, const uint16_t * pCr, uint8_t * pDst, const uint32_t inNumPairs, const YCbCrSample inSample)
+{
+	uint32_t pair(0);
+	if (inSample == kYCbCrSample8Bit)
+	{
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+		const __m128i two (_mm_set1_epi16(2)),  maxByte (_mm_set1_epi16(0x00FF));
+		for (;  pair + 8 <= inNumPairs;  pair += 8)
+		{
+			const __m128i cb (_mm_min_epi16(_mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCb + pair)), two), 2), maxByte));
+			const __m128i cr (_mm_min_epi16(_mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCr + pair)), two), 2), maxByte));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + pair * 2), _mm_or_si128(cb, _mm_slli_epi16(cr, 8)));
+		}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+		for (;  pair < inNumPairs;  pair++)
+		{
+			pDst[pair * 2]		= RoundTo8Bit(pCb[pair]);
+			pDst[pair * 2 + 1]	= RoundTo8Bit(pCr[pair]);
+		}
+		return;
+	}
+	uint16_t * pWords (reinterpret_cast<uint16_t*>(pDst));
+	const int shift (inSample == kYCbCrSample10BitMSB ? 6 : 0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i mask (_mm_set1_epi16(0x03FF)),  count (_mm_cvtsi32_si128(shift));
+	for (;  pair + 8 <= inNumPairs;  pair += 8)
+	{
+		const __m128i cb (_mm_sll_epi16(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCb + pair)), mask), count));
+		const __m128i cr (_mm_sll_epi16(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCr + pair)), mask), count));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pWords + pair * 2),     _mm_unpacklo_epi16(cb, cr));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pWords + pair * 2 + 8), _mm_unpackhi_epi16(cb, cr));
+	}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	for (;  pair < inNumPairs;  pair++)
+	{
+		pWords[pair * 2]		= uint16_t((pCb[pair] & 0x3FF) << shift);
+		pWords[pair * 2 + 1]	= uint16_t((pCr[pair] & 0x3FF) << shift);
+	}
+}
+
+//	4:2:2 ==> 4:2:0:  the chroma sample midway between rows 1 & 2 is (row0 + 3*row1 + 3*row2 + row3) / 8
+static void DownsampleChromaRows (const uint16_t * p0, const uint16_t * p1, const uint16_t * p2, const uint16_t * p3, uint16_t * pDst, const uint32_t inCount)
+{
+	uint32_t ndx(0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i four (_mm_set1_epi16(4));
+	for (;  ndx + 8 <= inCount;  ndx += 8)
+	{
+		const __m128i inner (_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p1 + ndx)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p2 + ndx))));
+		const __m128i outer (_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p0 + ndx)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p3 + ndx))));
+		const __m128i sum (_mm_add_epi16(_mm_add_epi16(outer, four), _mm_add_epi16(inner, _mm_slli_epi16(inner, 1))));	//	At most 8*1023+4:  no overflow
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx), _mm_srli_epi16(sum, 3));
+	}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	for (;  ndx < inCount;  ndx++)
+		pDst[ndx] = uint16_t((p0[ndx] + 3 * (p1[ndx] + p2[ndx]) + p3[ndx] + 4) >> 3);
+}
+
+//	4:2:0 ==> 4:2:2:  a row's chroma is (3*nearest + next nearest) / 4
+static void UpsampleChromaRows (const uint16_t * pNear, const uint16_t * pFar, uint16_t * pDst, const uint32_t inCount)
+{
+	uint32_t ndx(0);
+#if defined(AJA_YCBCR_CONVERT_SSE2)
+	const __m128i two (_mm_set1_epi16(2));
+	for (;  ndx + 8 <= inCount;  ndx += 8)
+	{
+		const __m128i nearRow (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pNear + ndx)));
+		const __m128i farRow (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pFar + ndx)));
+		const __m128i sum (_mm_add_epi16(_mm_add_epi16(nearRow, _mm_slli_epi16(nearRow, 1)), _mm_add_epi16(farRow, two)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx), _mm_srli_epi16(sum, 2));
+	}
+#endif	//	AJA_YCBCR_CONVERT_SSE2
+	for (;  ndx < inCount;  ndx++)
+		pDst[ndx] = uint16_t((3 * pNear[ndx] + pFar[ndx] + 2) >> 2);
+}
+
+
+//	A band's scratch lines:  a 4-row cache of source rows converted to 10-bit Y, Cb & Cr, plus one filtered chroma row
+class YCbCrLineCache
+{
+	public:
+		explicit YCbCrLineCache (const YCbCrView & inSrc)
+			:	mSrc (inSrc),
+				mLumaSamples ((inSrc.fWidth + 47) / 48 * 48 + 16)	//	Room for whole v210 groups
+		{
+			mLines.resize(mLumaSamples * 2 * 5);
+			for (int slot(0);  slot < 4;  slot++)
+				mLumaRow[slot] = mChromaRow[slot] = -1;
+		}
+
+		//	Answers with the given source row's 10-bit luma
+		const uint16_t * Luma (const uint32_t inRow)
+		{
+			const uint32_t slot (inRow & 3);
+			if (mLumaRow[slot] != int32_t(inRow))
+			{
+				if (mSrc.fPacking == kYCbCrPlanar)
+				{
+					ReadPlaneSamples(mSrc.fpPlane[0] + inRow * mSrc.fStride[0], Y(slot), mSrc.fWidth, mSrc.fSample);
+					mLumaRow[slot] = int32_t(inRow);
+				}
+				else
+					Unpack(inRow);
+			}
+			return Y(slot);
+		}
+
+		//	Answers with the given source chroma row's 10-bit Cb & Cr (chroma rows are luma rows, except for 4:2:0)
+		void Chroma (const uint32_t inChromaRow, const uint16_t * & outCb, const uint16_t * & outCr)
+		{
+			const uint32_t slot (inChromaRow & 3);
+			if (mChromaRow[slot] != int32_t(inChromaRow))
+			{
+				if (mSrc.fPacking != kYCbCrPlanar)
+					Unpack(inChromaRow);
+				else if (mSrc.fInterleaved)
+					ReadInterleavedChroma(mSrc.fpPlane[1] + inChromaRow * mSrc.fStride[1], Cb(slot), Cr(slot), mSrc.fWidth / 2, mSrc.fSample);
+				else
+				{
+					ReadPlaneSamples(mSrc.fpPlane[1] + inChromaRow * mSrc.fStride[1], Cb(slot), mSrc.fWidth / 2, mSrc.fSample);
+					ReadPlaneSamples(mSrc.fpPlane[2] + inChromaRow * mSrc.fStride[2], Cr(slot), mSrc.fWidth / 2, mSrc.fSample);
+				}
+				mChromaRow[slot] = int32_t(inChromaRow);
+			}
+			outCb = Cb(slot);
+			outCr = Cr(slot);
+		}
+
+		uint16_t *	FilteredCb (void)	{return &mLines[mLumaSamples * 8];}
+		uint16_t *	FilteredCr (void)	{return &mLines[mLumaSamples * 9];}
+
+	private:
+		uint16_t *	Y (const uint32_t inSlot)	{return &mLines[mLumaSamples * 2 * inSlot];}
+		uint16_t *	Cb (const uint32_t inSlot)	{return Y(inSlot) + mLumaSamples;}
+		uint16_t *	Cr (const uint32_t inSlot)	{return Y(inSlot) + mLumaSamples + mLumaSamples / 2;}
+
+		void Unpack (const uint32_t inRow)
+		{
+			const uint32_t slot (inRow & 3);
+			const uint8_t * pRow (mSrc.fpPlane[0] + inRow * mSrc.fStride[0]);
+			if (mSrc.fPacking == kYCbCrV210)
+				UnpackV210Row(pRow, Y(slot), Cb(slot), Cr(slot), mSrc.fWidth);
+			else
+				Unpack8BitPairs(pRow, Y(slot), Cb(slot), Cr(slot), mSrc.fWidth / 2, mSrc.fPacking == kYCbCrYUY2);
+			mLumaRow[slot] = mChromaRow[slot] = int32_t(inRow);
+		}
+
+		const YCbCrView &		mSrc;
+		const uint32_t			mLumaSamples;	//	Per luma line (chroma lines are half as long)
+		std::vector<uint16_t>	mLines;			//	4 slots of Y+Cb+Cr lines, then the filtered Cb & Cr lines
+		int32_t					mLumaRow[4];	//	Source row held in each slot's luma line, or -1
+		int32_t					mChromaRow[4];	//	Source chroma row held in each slot's chroma lines, or -1
+};
+
+static void WriteYCbCrLuma (const YCbCrView & inDst, const uint32_t inRow, const uint16_t * pY)
+{
+	WritePlaneSamples(pY, inDst.fpPlane[0] + inRow * inDst.fStride[0], inDst.fWidth, inDst.fSample);
+}
+
+static void WriteYCbCrChroma (const YCbCrView & inDst, const uint32_t inChromaRow, const uint16_t * pCb, const uint16_t * pCr)
+{
+	if (inDst.fInterleaved)
+		WriteInterleavedChroma(pCb, pCr, inDst.fpPlane[1] + inChromaRow * inDst.fStride[1], inDst.fWidth / 2, inDst.fSample);
+	else
+	{
+		WritePlaneSamples(pCb, inDst.fpPlane[1] + inChromaRow * inDst.fStride[1], inDst.fWidth / 2, inDst.fSample);
+		WritePlaneSamples(pCr, inDst.fpPlane[2] + inChromaRow * inDst.fStride[2], inDst.fWidth / 2, inDst.fSample);
+	}
+}
+
+typedef struct YCbCrConvertBand
+{
+	const YCbCrView *	fpSrc;		//	Source frame or field
+	const YCbCrView *	fpDst;		//	Destination frame or field
+	uint32_t			fFirst;		//	First destination chroma row to produce (luma rows 2x and 2x+1 for 4:2:0)
+	uint32_t			fEnd;		//	Destination chroma row to stop at
+} YCbCrConvertBand;
+
+typedef std::vector<YCbCrConvertBand>	YCbCrConvertBands;
+
+static void ConvertYCbCrBand (const YCbCrConvertBand & inBand)
+{
+	const YCbCrView & src (*inBand.fpSrc),  & dst (*inBand.fpDst);
+	const uint32_t numPairs (src.fWidth / 2);
+	const uint32_t lastRow (src.fHeight - 1),  lastChromaRow (src.fHeight / src.fChromaVert - 1);
+	const bool copyLuma (src.fPacking == kYCbCrPlanar  &&  dst.fPacking == kYCbCrPlanar  &&  src.fSample == dst.fSample);
+	const size_t lumaBytes (src.fWidth * (src.fSample == kYCbCrSample8Bit ? 1 : 2));
+	YCbCrLineCache cache (src);
+	const uint16_t * pCb (NULL);
+	const uint16_t * pCr (NULL);
+
+	if (dst.fChromaVert == 2)
+	{	//	4:2:0 destination (always planar):  each chroma row covers two luma rows...
+		for (uint32_t chromaRow(inBand.fFirst);  chromaRow < inBand.fEnd;  chromaRow++)
+		{
+			for (uint32_t row(chromaRow * 2);  row < chromaRow * 2 + 2;  row++)
+				if (copyLuma)
+					::memcpy(dst.fpPlane[0] + row * dst.fStride[0], src.fpPlane[0] + row * src.fStride[0], lumaBytes);
+				else
+					WriteYCbCrLuma(dst, row, cache.Luma(row));
+			if (src.fChromaVert == 2)
+				cache.Chroma(chromaRow, pCb, pCr);
+			else
+			{	//	...and is filtered from four 4:2:2 chroma rows
+				const uint16_t * pCb0(NULL), * pCr0(NULL), * pCb1(NULL), * pCr1(NULL);
+				const uint16_t * pCb2(NULL), * pCr2(NULL), * pCb3(NULL), * pCr3(NULL);
+				cache.Chroma(chromaRow ? chromaRow * 2 - 1 : 0, pCb0, pCr0);
+				cache.Chroma(chromaRow * 2, pCb1, pCr1);
+				cache.Chroma(chromaRow * 2 + 1, pCb2, pCr2);
+				cache.Chroma(chromaRow * 2 + 2 <= lastRow ? chromaRow * 2 + 2 : lastRow, pCb3, pCr3);
+				DownsampleChromaRows(pCb0, pCb1, pCb2, pCb3, cache.FilteredCb(), numPairs);
+				DownsampleChromaRows(pCr0, pCr1, pCr2, pCr3, cache.FilteredCr(), numPairs);
+				pCb = cache.FilteredCb();
+				pCr = cache.FilteredCr();
+			}
+			WriteYCbCrChroma(dst, chromaRow, pCb, pCr);
+		}
+		return;
+	}
+
+	//	4:2:2 destination:  one chroma row per luma row...
+	for (uint32_t row(inBand.fFirst);  row < inBand.fEnd;  row++)
+	{
+		if (src.fChromaVert == 1)
+			cache.Chroma(row, pCb, pCr);
+		else
+		{	//	...interpolated between the two nearest 4:2:0 chroma rows
+			const uint32_t nearRow (row / 2);
+			const uint32_t farRow (row & 1  ?  (nearRow < lastChromaRow ? nearRow + 1 : nearRow)  :  (nearRow ? nearRow - 1 : 0));
+			const uint16_t * pNearCb(NULL), * pNearCr(NULL), * pFarCb(NULL), * pFarCr(NULL);
+			cache.Chroma(nearRow, pNearCb, pNearCr);
+			cache.Chroma(farRow, pFarCb, pFarCr);
+			UpsampleChromaRows(pNearCb, pFarCb, cache.FilteredCb(), numPairs);
+			UpsampleChromaRows(pNearCr, pFarCr, cache.FilteredCr(), numPairs);
+			pCb = cache.FilteredCb();
+			pCr = cache.FilteredCr();
+		}
+		uint8_t * pDstRow (dst.fpPlane[0] + row * dst.fStride[0]);
+		if (dst.fPacking == kYCbCrV210)
+			PackV210Row(cache.Luma(row), pCb, pCr, pDstRow, dst.fWidth);
+		else if (dst.fPacking != kYCbCrPlanar)
+			Pack8BitPairs(cache.Luma(row), pCb, pCr, pDstRow, numPairs, dst.fPacking == kYCbCrYUY2);
+		else
+		{
+			if (copyLuma)
+				::memcpy(pDstRow, src.fpPlane[0] + row * src.fStride[0], lumaBytes);
+			else
+				WriteYCbCrLuma(dst, row, cache.Luma(row));
+			WriteYCbCrChroma(dst, row, pCb, pCr);
+		}
+	}
+}
+
+static void ConvertYCbCrBands (uint32_t inFirst, uint32_t inLast, void * pContext)
+{
+	const YCbCrConvertBands & bands (*reinterpret_cast<const YCbCrConvertBands*>(pContext));
+	for (uint32_t ndx(inFirst);  ndx < inLast;  ndx++)
+		ConvertYCbCrBand(bands.at(ndx));
+}
+
+static uint32_t DefaultYCbCrConvertThreadCount (void)
+{
+	//	Memory-bound, so more than 8 threads rarely helps...
+	const uint32_t numCPUs (AJAThreadPool::GetCPUCount());
+	return numCPUs > 8 ? 8 : numCPUs;
+}
+
+bool AJA_ConvertYCbCrFrame(const void* pSrcFrame, AJA_PixelFormat srcFormat, void* pDstFrame, AJA_PixelFormat dstFormat,
+						   uint32_t width, uint32_t height, bool interlaced, uint32_t numThreads)
+{
+	YCbCrView srcFrame, dstFrame;
+	if (!pSrcFrame  ||  !pDstFrame  ||  pSrcFrame == pDstFrame)
+		return false;
+	if (!MakeYCbCrView(srcFormat, pSrcFrame, width, height, srcFrame)  ||  !MakeYCbCrView(dstFormat, pDstFrame, width, height, dstFrame))
+		return false;
+	if (!width  ||  width % 2  ||  !height  ||  height % 2)
+		return false;
+	const bool any420 (srcFrame.fChromaVert == 2  ||  dstFrame.fChromaVert == 2);
+	if (interlaced  &&  any420  &&  height % 4)
+		return false;	//	Each field needs an even number of rows
+
+	//	Build the band list:  one picture per field (or one for the frame), split into bands of destination chroma rows...
+	const uint32_t threadCount (numThreads ? numThreads : DefaultYCbCrConvertThreadCount());
+	const uint32_t numPictures (interlaced ? 2 : 1);
+	YCbCrView srcPictures[2], dstPictures[2];
+	YCbCrConvertBands bands;
+	for (uint32_t picture(0);  picture < numPictures;  picture++)
+	{
+		srcPictures[picture] = interlaced ? FieldOfYCbCrView(srcFrame, picture) : srcFrame;
+		dstPictures[picture] = interlaced ? FieldOfYCbCrView(dstFrame, picture) : dstFrame;
+		const uint32_t chromaRows (dstPictures[picture].fHeight / dstPictures[picture].fChromaVert);
+		uint32_t rowsPerBand ((chromaRows * numPictures + threadCount - 1) / threadCount);
+		if (rowsPerBand < 16)
+			rowsPerBand = 16;	//	Not worth a thread
+		for (uint32_t row(0);  row < chromaRows;  row += rowsPerBand)
+		{
+			YCbCrConvertBand band;
+			band.fpSrc = &srcPictures[picture];
+			band.fpDst = &dstPictures[picture];
+			band.fFirst = row;
+			band.fEnd = row + rowsPerBand < chromaRows  ?  row + rowsPerBand  :  chromaRows;
+			bands.push_back(band);
+		}
+	}
+
+	//	Run the bands on the shared thread pool...
+	if (threadCount < 2  ||  bands.size() < 2)
+		ConvertYCbCrBands(0, uint32_t(bands.size()), &bands);
+	else
+		AJAThreadPool::GetDefault().ParallelFor(0, uint32_t(bands.size()), ConvertYCbCrBands, &bands, 1);
+	return true;
+}	//	AJA_ConvertYCbCrFrame
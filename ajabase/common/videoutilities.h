@@ -162,6 +162,35 @@ void AJA_EXPORT AJA_ConvertRGBAlpha10LineToYCbCr422(AJA_RGBAlpha10BitPixel * RGB
 																				 int32_t startPixel,
 																				 bool fUseRGBFullRange=false);
 
+/**
+ *	Converts a YCbCr frame between any two of these pixel formats:
+ *	- packed 4:2:2:		AJA_PixelFormat_YCbCr10 (v210), AJA_PixelFormat_YCbCr8 (2vuy), AJA_PixelFormat_YUY28;
+ *	- 3-plane:			AJA_PixelFormat_YCBCR8_420PL3 (I420), AJA_PixelFormat_YCBCR8_422PL3,
+ *						AJA_PixelFormat_YCBCR10_420PL3LE, AJA_PixelFormat_YCBCR10_422PL3LE;
+ *	- 2-plane:			AJA_PixelFormat_YCBCR8_420PL2 (NV12), AJA_PixelFormat_YCBCR8_422PL2 (NV16),
+ *						AJA_PixelFormat_YCBCR10_420PL2LE (P010), AJA_PixelFormat_YCBCR10_422PL2LE (NV20).
+ *	Planes are stored back-to-back with no row padding, and packed rows are AJA_CalcRowBytesForFormat bytes long,
+ *	so each frame occupies AJA_CalcRowBytesForFormat(format, width) * height bytes.
+ *	Chroma is sited as in MPEG-2, H.264 and HEVC (chroma_sample_loc_type 0):  co-sited with the even luma samples
+ *	horizontally, and (for 4:2:0) midway between two rows vertically. 4:2:2 to 4:2:0 conversion filters each column
+ *	of chroma with [1 3 3 1]/8;  4:2:0 to 4:2:2 interpolates between the two nearest chroma rows with [3 1]/4 weights.
+ *	Rows are split among several threads, and SSE2 is used where available.
+ *
+ *	@param[in]	pSrcFrame		Specifies the source frame.
+ *	@param[in]	srcFormat		Specifies the source pixel format.
+ *	@param[out]	pDstFrame		Specifies the destination frame, which must not overlap the source.
+ *	@param[in]	dstFormat		Specifies the destination pixel format.
+ *	@param[in]	width			Specifies the frame width, in pixels. Must be even.
+ *	@param[in]	height			Specifies the frame height, in rows. Must be even (a multiple of 4 for interlaced 4:2:0).
+ *	@param[in]	interlaced		Specify true to filter each field separately, storing 4:2:0 chroma rows field-interleaved.
+ *								Defaults to false (progressive).
+ *	@param[in]	numThreads		Specifies the number of threads to use, taken from AJAThreadPool::GetDefault. Defaults to zero,
+ *								which uses one per CPU (up to 8).
+ *	@return		True if successful;  false if a format isn't supported, or a pointer or dimension is invalid.
+ */
+bool AJA_EXPORT AJA_ConvertYCbCrFrame(const void* pSrcFrame, AJA_PixelFormat srcFormat, void* pDstFrame, AJA_PixelFormat dstFormat,
+									  uint32_t width, uint32_t height, bool interlaced = false, uint32_t numThreads = 0);
+
 inline	int16_t AJA_FixedRound(int32_t inFix)
 { 
   int16_t retValue;
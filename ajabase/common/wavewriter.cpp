@@ -9,8 +9,13 @@
 
 #include "ajabase/common/timebase.h"
 #include "ajabase/common/timecode.h"
+#include "ajabase/system/event.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/memory.h"
+#include "ajabase/system/thread.h"
 #include <time.h>
 #include <assert.h>
+#include <deque>
 
 #if defined(AJA_LINUX) || defined(AJA_BAREMETAL)
 #include <string.h>
@@ -24,6 +29,9 @@ const int sizeOf_riff	= 12;
 const int sizeOf_bext_v1= 610;
 const int sizeOf_fmt	= 24;
 const int sizeOf_data	= 8;
+const int sizeOf_ds64	= 36;	// "JUNK" placeholder, becomes "ds64" for RF64/BW64
+
+#define AJA_WAV_BLOCK_ALIGNMENT		4096
 
 #if defined(AJA_LITTLE_ENDIAN)
 #define AjaWavLittleEndianHw
@@ -64,6 +72,179 @@ const int sizeOf_data	= 8;
 	#define AjaWavBigEndian64(x)	  AjaWavSwap64(x)
 #endif
 
+/**
+ *	Write-behind engine for AJAWavWriter. The writer fills one block at a time while a background
+ *	thread writes full blocks to the file, in order.
+ */
+class AJAWavWriteBehind
+{
+public:
+	AJAWavWriteBehind(AJAFileIO& file, const uint32_t blockBytes, const uint32_t blockCount)
+		:	mFile(file), mBlockBytes(blockBytes), mpFill(NULL), mFillBytes(0), mError(false), mQuit(false), mBusy(false),
+			mWorkEvent(true), mFreeEvent(true)
+	{
+		for (uint32_t ndx = 0; ndx < blockCount; ndx++)
+		{
+			uint8_t* pBlock = (uint8_t*) AJAMemory::AllocateAligned(blockBytes, AJA_WAV_BLOCK_ALIGNMENT);
+			if (pBlock)
+				mFree.push_back(pBlock);
+		}
+		mFreeEvent.Signal();
+		mThread.Attach(FlushThreadStatic, this);
+		mThread.Start();
+	}
+
+	~AJAWavWriteBehind()
+	{
+		Flush();
+		{
+			AJAAutoLock locker(&mLock);
+			mQuit = true;
+			mWorkEvent.Signal();
+		}
+		mThread.Stop();
+		for (size_t ndx = 0; ndx < mFree.size(); ndx++)
+			AJAMemory::FreeAligned(mFree[ndx]);
+		AJAMemory::FreeAligned(mpFill);
+	}
+
+	bool Usable() const		{return mFree.size() >= 2;}
+
+	bool HasError() const
+	{
+		AJAAutoLock locker(&mLock);
+		return mError;
+	}
+
+	// Copies into the current block, handing each block to the flush thread as it fills
+	uint32_t Write(const uint8_t* pData, const uint32_t len)
+	{
+		uint32_t done = 0;
+		while (done < len)
+		{
+			if (!mpFill && !NextBlock())
+				break;
+			const uint32_t chunk = (len - done) < (mBlockBytes - mFillBytes) ? (len - done) : (mBlockBytes - mFillBytes);
+			memcpy(mpFill + mFillBytes, pData + done, chunk);
+			mFillBytes += chunk;
+			done += chunk;
+			if (mFillBytes == mBlockBytes)
+				Submit();
+		}
+		return done;
+	}
+
+	// Hands over the partly-filled block, then waits until everything is written
+	void Flush()
+	{
+		if (mpFill && mFillBytes)
+			Submit();
+		while (true)
+		{
+			{
+				AJAAutoLock locker(&mLock);
+				if (mFull.empty() && !mBusy)
+					return;
+				mFreeEvent.Clear();		// Under the lock, so a completion can't slip by
+			}
+			mFreeEvent.WaitForSignal();
+		}
+	}
+
+private:
+	struct Block
+	{
+		uint8_t*	pData;
+		uint32_t	bytes;
+	};
+
+	bool NextBlock()
+	{
+		while (true)
+		{
+			{
+				AJAAutoLock locker(&mLock);
+				if (mError)
+					return false;
+				if (!mFree.empty())
+				{
+					mpFill = mFree.back();
+					mFree.pop_back();
+					mFillBytes = 0;
+					return true;
+				}
+				mFreeEvent.Clear();		// Under the lock, so a completion can't slip by
+			}
+			mFreeEvent.WaitForSignal();	// Every block is waiting for the disk
+		}
+	}
+
+	void Submit()
+	{
+		AJAAutoLock locker(&mLock);
+		Block block = {mpFill, mFillBytes};
+		mFull.push_back(block);
+		mpFill = NULL;
+		mFillBytes = 0;
+		mWorkEvent.Signal();
+	}
+
+	static void FlushThreadStatic(AJAThread* pThread, void* pContext)
+	{
+		AJA_UNUSED(pThread);
+		reinterpret_cast<AJAWavWriteBehind*>(pContext)->FlushThread();
+	}
+
+	void FlushThread()
+	{
+		while (true)
+		{
+			Block block = {NULL, 0};
+			{
+				AJAAutoLock locker(&mLock);
+				if (mFull.empty())
+				{
+					if (mQuit)
+						return;
+					mWorkEvent.Clear();		// Under the lock, so a submission can't slip by
+				}
+				else
+				{
+					block = mFull.front();
+					mFull.pop_front();
+					mBusy = true;
+				}
+			}
+			if (!block.pData)
+			{
+				mWorkEvent.WaitForSignal();
+				continue;
+			}
+			// Full blocks are aligned in size and file offset, so only the final partial block can't bypass the cache
+			const bool ok = mError || mFile.Write(block.pData, block.bytes) == block.bytes;
+			AJAAutoLock locker(&mLock);
+			mError = mError || !ok;
+			mFree.push_back(block.pData);
+			mBusy = false;
+			mFreeEvent.Signal();
+		}
+	}
+
+	AJAFileIO&				mFile;
+	const uint32_t			mBlockBytes;
+	uint8_t*				mpFill;			// Block being filled (writer's thread only)
+	uint32_t				mFillBytes;
+	bool					mError;
+	bool					mQuit;
+	bool					mBusy;			// Flush thread is writing a block
+	mutable AJALock			mLock;
+	AJAEvent				mWorkEvent;		// Signaled while mFull isn't empty
+	AJAEvent				mFreeEvent;		// Signaled when a block has been written
+	std::deque<Block>		mFull;
+	std::vector<uint8_t*>	mFree;
+	AJAThread				mThread;
+};
+
 static void getDataAndTimeInBextFormat(std::string& formattedDate, std::string& formattedTime)
 {
 	char tmp[16];
@@ -80,7 +261,7 @@ AJAWavWriter::AJAWavWriter(const std::string & name, const AJAWavWriterAudioForm
 						   const std::string & startTimecode, AJAWavWriterChunkFlag flags,
 						   bool useFloatNotPCM)
 : AJAFileIO(), mFileName(name), mAudioFormat(audioFormat), mVideoFormat(videoFormat), mStartTimecode(startTimecode), mFlags(flags), mLittleEndian(true),
-  mUseFloatData(useFloatNotPCM)
+  mUseFloatData(useFloatNotPCM), mTotalBytes(0), mBlockBytes(0), mBlockCount(0), mpWriteBehind(NULL)
 {
 	mSizeOfHeader = sizeOf_riff + sizeOf_fmt + sizeOf_data;
 	
@@ -88,6 +269,17 @@ AJAWavWriter::AJAWavWriter(const std::string & name, const AJAWavWriterAudioForm
 	{
 		mSizeOfHeader += sizeOf_bext_v1;
 	}
+
+	if (mFlags & (AJAWavWriterChunkFlagRF64 | AJAWavWriterChunkFlagBW64))
+	{
+		mSizeOfHeader += sizeOf_ds64;
+	}
+}
+
+AJAWavWriter::~AJAWavWriter()
+{
+	if (IsOpen())
+		close();
 }
 
 // making this call not public
@@ -105,9 +297,21 @@ AJAStatus AJAWavWriter::Close(void)
 bool AJAWavWriter::open()
 {
 	bool retVal = false;
-	AJAStatus result = Open(mFileName,eAJACreateAlways | eAJAWriteOnly,eAJABuffered);
+	AJAStatus result = Open(mFileName,eAJACreateAlways | eAJAWriteOnly,mBlockBytes ? eAJAUnbuffered : eAJABuffered);
 	if(result == AJA_STATUS_SUCCESS)
 	{
+		mTotalBytes = 0;
+		if (mBlockBytes)
+		{
+			mpWriteBehind = new AJAWavWriteBehind(*this, mBlockBytes, mBlockCount);
+			if (!mpWriteBehind->Usable())
+			{
+				delete mpWriteBehind;
+				mpWriteBehind = NULL;
+				Close();
+				return false;
+			}
+		}
 		writeHeader();
 		retVal = true;
 	}
@@ -115,11 +319,70 @@ bool AJAWavWriter::open()
 	return retVal;
 }
 
+bool AJAWavWriter::setWriteBehind(uint32_t blockBytes, uint32_t blockCount)
+{
+	if (IsOpen() || (blockBytes && blockCount < 2))
+		return false;
+	// Keep blocks a multiple of the alignment, so every full block lands on an aligned file offset
+	mBlockBytes = (blockBytes + AJA_WAV_BLOCK_ALIGNMENT - 1) / AJA_WAV_BLOCK_ALIGNMENT * AJA_WAV_BLOCK_ALIGNMENT;
+	mBlockCount = blockCount;
+	return true;
+}
+
+bool AJAWavWriter::hasWriteError() const
+{
+	return mpWriteBehind && mpWriteBehind->HasError();
+}
+
 uint32_t AJAWavWriter::write(const char* data, uint32_t len)
 {
 	return writeRawData(data,len);
 }
 
+uint32_t AJAWavWriter::writePlanar(const char* const* channels, uint32_t samplesPerChannel)
+{
+	const uint32_t numChannels = uint32_t(mAudioFormat.channelCount);
+	const uint32_t sampleBytes = uint32_t(mAudioFormat.sampleSize / 8);
+	const uint32_t frameBytes = numChannels * sampleBytes;
+	if (!channels || !frameBytes)
+		return 0;
+
+	// Interleave a slice of sample frames at a time, so the scratch buffer stays small
+	const uint32_t framesPerSlice = 2048;
+	mInterleaved.resize(size_t(framesPerSlice) * frameBytes);
+	uint32_t bytesWritten = 0;
+	for (uint32_t first = 0; first < samplesPerChannel; first += framesPerSlice)
+	{
+		const uint32_t numFrames = (samplesPerChannel - first) < framesPerSlice ? (samplesPerChannel - first) : framesPerSlice;
+		for (uint32_t chan = 0; chan < numChannels; chan++)
+		{
+			const char* pSrc = channels[chan] + size_t(first) * sampleBytes;
+			char* pDst = &mInterleaved[0] + size_t(chan) * sampleBytes;
+			switch (sampleBytes)
+			{
+				case 2:
+					for (uint32_t frame = 0; frame < numFrames; frame++, pSrc += 2, pDst += frameBytes)
+						memcpy(pDst, pSrc, 2);
+					break;
+				case 4:
+					for (uint32_t frame = 0; frame < numFrames; frame++, pSrc += 4, pDst += frameBytes)
+						memcpy(pDst, pSrc, 4);
+					break;
+				default:
+					for (uint32_t frame = 0; frame < numFrames; frame++, pSrc += sampleBytes, pDst += frameBytes)
+						memcpy(pDst, pSrc, sampleBytes);
+					break;
+			}
+		}
+		const uint32_t sliceBytes = numFrames * frameBytes;
+		const uint32_t written = writeRawData(&mInterleaved[0], sliceBytes);
+		bytesWritten += written;
+		if (written != sliceBytes)
+			break;
+	}
+	return bytesWritten;
+}
+
 uint32_t AJAWavWriter::writeRawData(const char* data,uint32_t len)
 {
 	return writeRawData((char*)data,len);
@@ -127,53 +390,47 @@ uint32_t AJAWavWriter::writeRawData(const char* data,uint32_t len)
 
 uint32_t AJAWavWriter::writeRawData(char* data,uint32_t len)
 {
-	return Write((uint8_t*)data,len);
+	const uint32_t bytesWritten = mpWriteBehind ? mpWriteBehind->Write((uint8_t*)data,len) : Write((uint8_t*)data,len);
+	mTotalBytes += bytesWritten;
+	return bytesWritten;
 }
 
 uint32_t AJAWavWriter::writeRaw_uint8_t(uint8_t value, uint32_t count)
 {
-	uint32_t bytesWritten = 0;
-	
-	for(uint32_t i=0;i<count;i++)
-	{
-		bytesWritten += Write(&value,1);
-	}
-	
-	return bytesWritten;
+	std::vector<char> values(count, char(value));
+	return count ? writeRawData(&values[0], count) : 0;
 }
 
 uint32_t AJAWavWriter::writeRaw_uint16_t(uint16_t value, uint32_t count)
 {
-	uint32_t bytesWritten = 0;
-	
 	if(mLittleEndian)
 		value = AjaWavLittleEndian16(value);
 	else
 		value = AjaWavBigEndian16(value);
 	
-	for(uint32_t i=0;i<count;i++)
-	{
-		bytesWritten += Write((uint8_t*)&value, sizeof(uint16_t));
-	}
-	
-	return bytesWritten;
+	std::vector<uint16_t> values(count, value);
+	return count ? writeRawData((char*)&values[0], count * uint32_t(sizeof(uint16_t))) : 0;
 }
 
 uint32_t AJAWavWriter::writeRaw_uint32_t(uint32_t value, uint32_t count)
 {
-	uint32_t bytesWritten = 0;
-	
 	if(mLittleEndian)
 		value = AjaWavLittleEndian32(value);
 	else
 		value = AjaWavBigEndian32(value);
 	
-	for(uint32_t i=0;i<count;i++)
-	{
-		bytesWritten += Write((uint8_t*)&value, sizeof(uint32_t));
-	}
+	std::vector<uint32_t> values(count, value);
+	return count ? writeRawData((char*)&values[0], count * uint32_t(sizeof(uint32_t))) : 0;
+}
+
+uint32_t AJAWavWriter::writeRaw_uint64_t(uint64_t value)
+{
+	if(mLittleEndian)
+		value = AjaWavLittleEndian64(value);
+	else
+		value = AjaWavBigEndian64(value);
 	
-	return bytesWritten;
+	return writeRawData((char*)&value, uint32_t(sizeof(uint64_t)));
 }
 
 void AJAWavWriter::writeHeader()
@@ -186,6 +443,14 @@ void AJAWavWriter::writeHeader()
 	wtn += writeRawData("RIFF", 4);
 	wtn += writeRaw_uint32_t(0);						   // Placeholder for the RIFF chunk size (filled by close())
 	wtn += writeRawData("WAVE", 4);
+
+	if (mFlags & (AJAWavWriterChunkFlagRF64 | AJAWavWriterChunkFlagBW64))
+	{
+		// Room for a ds64 chunk, in case close() has to promote this to an RF64/BW64 file
+		wtn += writeRawData("JUNK", 4);
+		wtn += writeRaw_uint32_t(sizeOf_ds64 - 8);
+		wtn += writeRaw_uint8_t(0, sizeOf_ds64 - 8);
+	}
 	
 	if (mFlags & AJAWavWriterChunkFlagBextV1)
 	{
@@ -252,23 +517,50 @@ void AJAWavWriter::writeHeader()
 	wtn += writeRawData("data", 4);
 	wtn += writeRaw_uint32_t(0);							   // Placeholder for the data chunk size (filled by close())
 	AJA_UNUSED(wtn);
-	assert(Tell() == mSizeOfHeader);
+	assert(mTotalBytes == mSizeOfHeader);
 }
 
 void AJAWavWriter::close()
 {
+	// Write out anything still buffered
+	delete mpWriteBehind;
+	mpWriteBehind = NULL;
+
 	// Fill the header size placeholders
-	uint32_t fileSize = (uint32_t)Tell();
+	const int64_t fileSize = mTotalBytes;
+	const uint64_t riffSize = uint64_t(fileSize - sizeOf_data);
+	const uint64_t dataSize = uint64_t(fileSize - mSizeOfHeader);
 	
 	mLittleEndian = true;
 	
-	// RIFF chunk size
-	Seek(4,eAJASeekSet);
-	writeRaw_uint32_t(fileSize - sizeOf_data);
-	
-	// data chunk size
-	Seek(mSizeOfHeader-4,eAJASeekSet);
-	writeRaw_uint32_t(fileSize - mSizeOfHeader);
+	if ((mFlags & (AJAWavWriterChunkFlagRF64 | AJAWavWriterChunkFlagBW64)) && riffSize > 0xFFFFFFFFULL)
+	{
+		// Too big for RIFF -- promote to RF64/BW64, with the real sizes in the ds64 chunk
+		const uint16_t blockAlign = uint16_t(mAudioFormat.channelCount * mAudioFormat.sampleSize / 8);
+		Seek(0,eAJASeekSet);
+		writeRawData((mFlags & AJAWavWriterChunkFlagBW64) ? "BW64" : "RF64", 4);
+		writeRaw_uint32_t(0xFFFFFFFF);
+		Seek(sizeOf_riff,eAJASeekSet);
+		writeRawData("ds64", 4);
+		writeRaw_uint32_t(sizeOf_ds64 - 8);
+		writeRaw_uint64_t(riffSize);
+		writeRaw_uint64_t(dataSize);
+		writeRaw_uint64_t(blockAlign ? dataSize / blockAlign : 0);	// sample count
+		writeRaw_uint32_t(0);										// table length
+		Seek(mSizeOfHeader-4,eAJASeekSet);
+		writeRaw_uint32_t(0xFFFFFFFF);
+	}
+	else
+	{
+		// RIFF chunk size
+		Seek(4,eAJASeekSet);
+		writeRaw_uint32_t(uint32_t(riffSize));
+		
+		// data chunk size
+		Seek(mSizeOfHeader-4,eAJASeekSet);
+		writeRaw_uint32_t(uint32_t(dataSize));
+	}
 	
 	Close();
+	mTotalBytes = fileSize;
 }
@@ -10,6 +10,7 @@
 
 #include "public.h"
 #include "ajabase/system/file_io.h"
+#include <vector>
 
 
 class AJA_EXPORT AJAWavWriterAudioFormat
@@ -39,10 +40,14 @@ public:
 enum AJAWavWriterChunkFlag
 {
 	AJAWavWriterChunkFlagStandard = 1 << 0,
-	AJAWavWriterChunkFlagBextV1	  = 1 << 1
+	AJAWavWriterChunkFlagBextV1	  = 1 << 1,
+	AJAWavWriterChunkFlagRF64	  = 1 << 2,		///< Reserve a ds64 chunk, and become an RF64 file (EBU Tech 3306) upon close if over 4 GB
+	AJAWavWriterChunkFlagBW64	  = 1 << 3		///< Same as AJAWavWriterChunkFlagRF64, but become a BW64 file (ITU-R BS.2088)
 };
 
 
+class AJAWavWriteBehind;
+
 class AJA_EXPORT AJAWavWriter : public AJAFileIO
 {
 	
@@ -52,10 +57,44 @@ public:
 				 const AJAWavWriterVideoFormat & videoFormat = AJAWavWriterVideoFormat(),
 				 const std::string & startTimecode = "00:00:00;00", AJAWavWriterChunkFlag flags = AJAWavWriterChunkFlagStandard,
 				 bool useFloatNotPCM = false);
+	~AJAWavWriter();
 	bool open();
 	void close();
 	
 	uint32_t write(const char* data, uint32_t len);
+
+	/**
+	 *	Writes planar (one buffer per channel) audio, interleaving it into the file.
+	 *
+	 *	@param[in]	channels			One pointer per channel, each to samplesPerChannel packed samples of
+	 *									the sample size given in the audio format.
+	 *	@param[in]	samplesPerChannel	The number of samples in each channel's buffer.
+	 *
+	 *	@return		The number of bytes written.
+	 */
+	uint32_t writePlanar(const char* const* channels, uint32_t samplesPerChannel);
+
+	/**
+	 *	Selects write-behind mode, which must be done before open(). Audio is gathered into large aligned
+	 *	blocks that a background thread writes to the file with unbuffered I/O, so write() rarely makes a
+	 *	system call and never waits on the disk unless every block is full.
+	 *
+	 *	@param[in]	blockBytes		The size of each block, or zero to write straight through (the default).
+	 *	@param[in]	blockCount		The number of blocks (at least 2).
+	 *
+	 *	@return		True if successful, or false if already open or blockCount is too small.
+	 */
+	bool setWriteBehind(uint32_t blockBytes = 4 * 1024 * 1024, uint32_t blockCount = 4);
+
+	/**
+	 *	@return		The number of bytes accepted so far, including the header.
+	 */
+	int64_t getSize() const		{return mTotalBytes;}
+
+	/**
+	 *	@return		True if a background write has failed, after which write() accepts nothing more.
+	 */
+	bool hasWriteError() const;
 	
 protected:
 	AJAStatus Open(const std::string& fileName, int flags, AJAFileProperties properties);	 
@@ -67,6 +106,7 @@ private:
 	uint32_t writeRaw_uint8_t(uint8_t value,   uint32_t count=1);
 	uint32_t writeRaw_uint16_t(uint16_t value, uint32_t count=1);
 	uint32_t writeRaw_uint32_t(uint32_t value, uint32_t count=1);
+	uint32_t writeRaw_uint64_t(uint64_t value);
 	
 	void writeHeader();
 	
@@ -78,6 +118,11 @@ private:
 	bool						mLittleEndian;
 	int32_t						mSizeOfHeader;
 	bool						mUseFloatData;
+	int64_t						mTotalBytes;		// Bytes accepted, including the header
+	uint32_t					mBlockBytes;		// Write-behind block size, or zero
+	uint32_t					mBlockCount;		// Number of write-behind blocks
+	AJAWavWriteBehind*			mpWriteBehind;		// Write-behind engine, while open in write-behind mode
+	std::vector<char>			mInterleaved;		// Scratch buffer for writePlanar
 };
 
 #endif	//	AJAWAVEWRITER_H
@@ -693,3 +693,39 @@ uint64_t AJAThreadImpl::GetThreadId()
 #endif
 		return 0;
 }
+
+
+// bare metal threads are not migrated, there is nothing to pin
+AJAStatus AJAThreadImpl::SetAffinity(const std::vector<int>& cpus)
+{
+	AJA_UNUSED(cpus);
+	return AJA_STATUS_UNSUPPORTED;
+}
+
+AJAStatus AJAThreadImpl::GetAffinity(std::vector<int>& cpus)
+{
+	cpus.clear();
+	return AJA_STATUS_UNSUPPORTED;
+}
+
+int AJAThreadImpl::GetNUMANodeCount()
+{
+	return 1;
+}
+
+AJAStatus AJAThreadImpl::GetNUMANodeCPUs(int node, std::vector<int>& cpus)
+{
+	cpus.clear();
+	if (node != 0)
+		return AJA_STATUS_RANGE;
+	long numCPUs = sysconf(_SC_NPROCESSORS_CONF);
+	for (long cpu = 0; cpu < numCPUs; cpu++)
+		cpus.push_back(int(cpu));
+	return AJA_STATUS_SUCCESS;
+}
+
+AJAStatus AJAThreadImpl::SetCurrentThreadAffinity(const std::vector<int>& cpus)
+{
+	AJA_UNUSED(cpus);
+	return AJA_STATUS_UNSUPPORTED;
+}
@@ -18,10 +18,17 @@
 #if defined(AJA_LINUX) || defined(AJA_BAREMETAL)
 	#include <stdarg.h>
 #endif
+#if defined(AJA_LINUX)
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
 #include <assert.h>
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
+#include <limits.h>
+#include <stddef.h>
 #include <iostream>
 #include <iomanip>
 #include <map>
@@ -41,6 +48,60 @@ static bool sDebug = false;
 #define STAT_BIT_CLEAR		spShare->statAllocMask[inKey/(AJA_DEBUG_MAX_NUM_STATS/64)] &= 0xFFFFFFFFFFFFFFFF - STAT_BIT_SHIFT
 
 
+AJADebugMessageFilter::AJADebugMessageFilter()
+	:	fUnits		(AJA_DEBUG_UNIT_ARRAY_SIZE, true),
+		fSeverities	((1 << AJA_DebugSeverity_Size) - 1),
+		fPid		(0),
+		fTid		(0)
+{
+}
+
+void AJADebugMessageFilter::SetAllUnits (const bool inPass)
+{
+	fUnits.assign(AJA_DEBUG_UNIT_ARRAY_SIZE, inPass);
+}
+
+void AJADebugMessageFilter::SetUnit (const int32_t inUnit, const bool inPass)
+{
+	if (inUnit >= 0  &&  inUnit < AJA_DEBUG_UNIT_ARRAY_SIZE)
+		fUnits[size_t(inUnit)] = inPass;
+}
+
+bool AJADebugMessageFilter::HasUnit (const int32_t inUnit) const
+{
+	return inUnit >= 0  &&  inUnit < AJA_DEBUG_UNIT_ARRAY_SIZE  &&  fUnits[size_t(inUnit)];
+}
+
+void AJADebugMessageFilter::SetAllSeverities (const bool inPass)
+{
+	fSeverities = inPass ? (1 << AJA_DebugSeverity_Size) - 1 : 0;
+}
+
+void AJADebugMessageFilter::SetSeverity (const int32_t inSeverity, const bool inPass)
+{
+	if (inSeverity < 0  ||  inSeverity >= AJA_DebugSeverity_Size)
+		return;
+	if (inPass)
+		fSeverities |= 1 << inSeverity;
+	else
+		fSeverities &= ~(1 << inSeverity);
+}
+
+bool AJADebugMessageFilter::HasSeverity (const int32_t inSeverity) const
+{
+	return inSeverity >= 0  &&  inSeverity < AJA_DebugSeverity_Size  &&  (fSeverities & (1 << inSeverity));
+}
+
+bool AJADebugMessageFilter::Passes (const AJADebugMessage & inMessage) const
+{
+	return inMessage.destinationMask != AJA_DEBUG_DESTINATION_NONE
+		&&  HasUnit(inMessage.groupIndex)
+		&&  HasSeverity(inMessage.severity)
+		&&  (!fPid  ||  inMessage.pid == fPid)
+		&&  (!fTid  ||  inMessage.tid == fTid);
+}
+
+
 AJAStatus AJADebug::Open (bool incrementRefCount)
 {
 	if (!sLock.IsValid())
@@ -386,6 +447,19 @@ inline uint64_t report_common(int32_t index, int32_t severity, const char* pFile
 }
 
 
+inline void publish_message (void)
+{
+	// bump the publish counter, and only make the wake call if a reader is waiting on it
+	AJAAtomic::Increment(&spShare->messagesPublished);
+	if (spShare->messageWaiters)
+	{
+#if defined(AJA_LINUX)
+		syscall(SYS_futex, &spShare->messagesPublished, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+	}
+}
+
+
 void AJADebug::Report (int32_t index, int32_t severity, const char* pFileName, int32_t lineNumber, ...)
 {
 	if (!spShare)
@@ -413,6 +487,7 @@ void AJADebug::Report (int32_t index, int32_t severity, const char* pFileName, i
 			// set last to indicate message complete
 			AJAAtomic::Exchange(&spShare->messageRing[messageIndex].sequenceNumber, writeIndex);
 			AJAAtomic::Increment(&spShare->statsMessagesAccepted);
+			publish_message();
 		}
 	}
 	catch (...)
@@ -437,6 +512,7 @@ void AJADebug::Report (int32_t index, int32_t severity, const char* pFileName, i
 			// set last to indicate message complete
 			AJAAtomic::Exchange(&spShare->messageRing[messageIndex].sequenceNumber, writeIndex);
 			AJAAtomic::Increment(&spShare->statsMessagesAccepted);
+			publish_message();
 		}
 	}
 	catch (...)
@@ -488,6 +564,7 @@ void AJADebug::AssertWithMessage (const char* pFileName, int32_t lineNumber, con
 			// set last to indicate message complete
 			AJAAtomic::Exchange(&spShare->messageRing[messageIndex].sequenceNumber, writeIndex);
 			AJAAtomic::Increment(&spShare->statsMessagesAccepted);
+			publish_message();
 		}
 	}
 	catch (...)
@@ -833,6 +910,96 @@ AJAStatus AJADebug::GetMessagesIgnored (uint64_t & outCount)
 }
 
 
+AJAStatus AJADebug::GetMessages (uint64_t & ioSequenceNumber, std::vector<AJADebugMessage> & outMessages,
+								  const uint32_t inMaxMessages, const AJADebugMessageFilter & inFilter,
+								  uint64_t & outLostCount)
+{
+	outMessages.clear();
+	outLostCount = 0;
+	if (!spShare)
+		return AJA_STATUS_INITIALIZE;
+	if (!ioSequenceNumber)
+		ioSequenceNumber = 1;
+	try
+	{
+		const uint64_t writeIndex (spShare->writeIndex);
+
+		// anything older than a full ring has been overwritten
+		if (writeIndex >= AJA_DEBUG_MESSAGE_RING_SIZE  &&  ioSequenceNumber <= writeIndex - AJA_DEBUG_MESSAGE_RING_SIZE)
+		{
+			outLostCount += writeIndex - AJA_DEBUG_MESSAGE_RING_SIZE + 1 - ioSequenceNumber;
+			ioSequenceNumber = writeIndex - AJA_DEBUG_MESSAGE_RING_SIZE + 1;
+		}
+
+		for (uint32_t num(0);  num < inMaxMessages  &&  ioSequenceNumber <= writeIndex;  num++, ioSequenceNumber++)
+		{
+			const AJADebugMessage & entry (spShare->messageRing[ioSequenceNumber % AJA_DEBUG_MESSAGE_RING_SIZE]);
+			const uint64_t entrySequenceNumber (*static_cast<const volatile uint64_t *>(&entry.sequenceNumber));
+			if (entrySequenceNumber < ioSequenceNumber)
+				break;	// still being written
+			if (entrySequenceNumber > ioSequenceNumber)
+				{outLostCount++;  continue;}	// overwritten
+			if (!inFilter.Passes(entry))
+				continue;
+
+			// copy the fixed fields, and only as much of the strings as is used
+			outMessages.resize(outMessages.size() + 1);
+			AJADebugMessage & msg (outMessages.back());
+			::memcpy(&msg, &entry, offsetof(AJADebugMessage, fileName));
+			aja::safer_strncpy(msg.fileName, entry.fileName, AJA_DEBUG_FILE_NAME_MAX_SIZE, AJA_DEBUG_FILE_NAME_MAX_SIZE);
+			aja::safer_strncpy(msg.messageText, entry.messageText, AJA_DEBUG_MESSAGE_MAX_SIZE, AJA_DEBUG_MESSAGE_MAX_SIZE);
+
+			// a reporter that claimed this slot during the copy may have torn it
+			if (spShare->writeIndex - ioSequenceNumber >= AJA_DEBUG_MESSAGE_RING_SIZE)
+				{outMessages.pop_back();  outLostCount++;}
+		}
+	}
+	catch(...)
+	{
+		return AJA_STATUS_FAIL;
+	}
+	return AJA_STATUS_SUCCESS;
+}
+
+
+static inline bool message_available (const uint64_t sequenceNumber)
+{
+	const AJADebugMessage & entry (spShare->messageRing[sequenceNumber % AJA_DEBUG_MESSAGE_RING_SIZE]);
+	return sequenceNumber <= spShare->writeIndex
+		&&  *static_cast<const volatile uint64_t *>(&entry.sequenceNumber) >= sequenceNumber;
+}
+
+
+AJAStatus AJADebug::WaitForMessage (const uint64_t inSequenceNumber, const uint32_t inTimeoutMS)
+{
+	if (!spShare)
+		return AJA_STATUS_INITIALIZE;
+	const uint64_t deadline (AJATime::GetSystemMilliseconds() + inTimeoutMS);
+	while (true)
+	{
+		// sample the publish counter before checking, so a message published in between ends the wait immediately
+		const uint32_t published (spShare->messagesPublished);
+		if (message_available(inSequenceNumber))
+			return AJA_STATUS_SUCCESS;
+		const uint64_t now (AJATime::GetSystemMilliseconds());
+		if (now >= deadline)
+			return AJA_STATUS_TIMEOUT;
+#if defined(AJA_LINUX)
+		const uint64_t waitMS (deadline - now);
+		struct timespec ts;
+		ts.tv_sec = time_t(waitMS / 1000);
+		ts.tv_nsec = long((waitMS % 1000) * 1000000);
+		AJAAtomic::Increment(&spShare->messageWaiters);
+		syscall(SYS_futex, &spShare->messagesPublished, FUTEX_WAIT, published, &ts, NULL, 0);
+		AJAAtomic::Decrement(&spShare->messageWaiters);
+#else
+		(void) published;
+		AJATime::Sleep(1);
+#endif
+	}
+}
+
+
 const char* AJADebug::GetSeverityString (int32_t severity)
 {
 	if (severity < 0  ||  severity > 7)
@@ -236,6 +236,39 @@ class AJAMemory;
 AJA_EXPORT std::string AJAStatusToString (const AJAStatus inStatus, const bool inDetailed = false);
 
 
+/**
+ *	Selects which messages AJADebug::GetMessages copies out of the message ring.
+ *	By default, all messages pass.
+ *	@ingroup AJAGroupDebug
+ */
+class AJA_EXPORT AJADebugMessageFilter
+{
+public:
+	AJADebugMessageFilter();
+
+	void SetAllUnits (const bool inPass);						/**< Passes (or blocks) messages from all debug units */
+	void SetUnit (const int32_t inUnit, const bool inPass);		/**< Passes (or blocks) messages from the given debug unit */
+	bool HasUnit (const int32_t inUnit) const;					/**< Returns true if messages from the given debug unit pass */
+	void SetAllSeverities (const bool inPass);					/**< Passes (or blocks) messages of all severities */
+	void SetSeverity (const int32_t inSeverity, const bool inPass);	/**< Passes (or blocks) messages of the given severity */
+	bool HasSeverity (const int32_t inSeverity) const;			/**< Returns true if messages of the given severity pass */
+	inline void SetProcessId (const uint64_t inPid)	{fPid = inPid;}	/**< Passes only messages from the given process (zero passes all) */
+	inline void SetThreadId (const uint64_t inTid)	{fTid = inTid;}	/**< Passes only messages from the given thread (zero passes all) */
+
+	/**
+	 *	@return		True if the given message (in the ring) passes this filter.
+	 *	@note		Messages sent to ::AJA_DEBUG_DESTINATION_NONE never pass.
+	 */
+	bool Passes (const AJADebugMessage & inMessage) const;
+
+private:
+	std::vector<bool>	fUnits;			/**< Indexed by debug unit */
+	uint32_t			fSeverities;	/**< One bit per severity */
+	uint64_t			fPid;
+	uint64_t			fTid;
+};	//	AJADebugMessageFilter
+
+
 /** 
  *	Debug class to generate debug output and assertions.
  *	@ingroup AJAGroupDebug
@@ -571,6 +604,38 @@ public:
 	 */
 	static AJAStatus GetMessagesIgnored (uint64_t & outCount);
 
+	/**
+	 *	Copies a contiguous span of messages out of the message ring in one call, applying the given filter during the copy.
+	 *
+	 *	@param[in,out]	ioSequenceNumber	On entry, specifies the sequence number of the first message to read (the first
+	 *										message ever reported is number 1). On exit, receives the sequence number of the
+	 *										next message to read (i.e. pass it back in on the next call).
+	 *	@param[out]		outMessages			Receives the messages that passed the filter, in order. Its prior contents are lost.
+	 *	@param[in]		inMaxMessages		Specifies the maximum number of ring entries to examine.
+	 *	@param[in]		inFilter			Specifies which messages to copy. Filtered messages are skipped without copying
+	 *										their file name or text.
+	 *	@param[out]		outLostCount		Receives the number of messages that were overwritten before they could be read.
+	 *	@return		AJA_STATUS_SUCCESS			Messages (if any) returned
+	 *				AJA_STATUS_INITIALIZE		Debug system not open
+	 *	@note		Reading stops at the first message that's still being written, so messages are never returned out of order.
+	 */
+	static AJAStatus GetMessages (uint64_t & ioSequenceNumber, std::vector<AJADebugMessage> & outMessages,
+								  const uint32_t inMaxMessages, const AJADebugMessageFilter & inFilter,
+								  uint64_t & outLostCount);	//	New in SDK 17.5
+
+	/**
+	 *	Waits until the given message is available, or a timeout occurs.
+	 *	On Linux, this blocks in the kernel until a reporter wakes it, so there's no polling overhead.
+	 *	Other platforms poll once per millisecond.
+	 *
+	 *	@param[in]	inSequenceNumber		Specifies the sequence number of the message to wait for.
+	 *	@param[in]	inTimeoutMS				Specifies the maximum time to wait, in milliseconds.
+	 *	@return		AJA_STATUS_SUCCESS			The message is available
+	 *				AJA_STATUS_TIMEOUT			The message didn't arrive within the timeout
+	 *				AJA_STATUS_INITIALIZE		Debug system not open
+	 */
+	static AJAStatus WaitForMessage (const uint64_t inSequenceNumber, const uint32_t inTimeoutMS);	//	New in SDK 17.5
+
 	/**
 	 *	@param[in]	severity	The Severity of interest.
 	 *	@return					A human-readable string containing the name associated with the given Severity value.
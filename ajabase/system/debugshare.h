@@ -341,7 +341,9 @@ typedef struct _AJADebugShare
 	uint32_t			statCapacity;								/**< The number of stats that can be stored, or zero if no stat facility (new in SDK 16) */
 	uint32_t volatile	statAllocChanges;							/**< Number of changes to statAllocMask (new in SDK 16.0) */
 	uint64_t			statAllocMask[AJA_DEBUG_MAX_NUM_STATS/64];	/**< Stats allocation bitmask, 1 bit per stats measurement (new in SDK 16.0) */
-	uint32_t			reserved[128 - 1 - 1 - 2*AJA_DEBUG_MAX_NUM_STATS/64];	/**< Reserved (was [128] in version 110) */
+	uint32_t volatile	messagesPublished;							/**< Bumped after each message is complete -- readers wait on this (new in SDK 17.1) */
+	uint32_t volatile	messageWaiters;								/**< Number of readers waiting for messagesPublished to change (new in SDK 17.1) */
+	uint32_t			reserved[128 - 1 - 1 - 2*AJA_DEBUG_MAX_NUM_STATS/64 - 2];	/**< Reserved (was [128] in version 110) */
 	uint32_t			unitArray[AJA_DEBUG_UNIT_ARRAY_SIZE];		/**< Array of message destinations by unit */
 	AJADebugMessage		messageRing[AJA_DEBUG_MESSAGE_RING_SIZE];	/**< Message ring holding current message data */
 	AJADebugStat		stats[AJA_DEBUG_MAX_NUM_STATS];				/**< Per-stat measurement data (new in v111) */
@@ -8,9 +8,15 @@
 #include "ajabase/common/common.h"
 #include "ajabase/common/types.h"
 #include "ajabase/system/file_io.h"
+#include "ajabase/system/event.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/systemtime.h"
+#include "ajabase/system/thread.h"
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <deque>
 #include <sstream>
+#include <string.h>
 
 #if defined(AJA_WINDOWS)
 	// Windows includes
@@ -20,6 +26,7 @@
 	// TODO
 #else
 	// Posix includes
+	#include <errno.h>
 	#include <fcntl.h>
 	#include <dirent.h>
 	#include <fnmatch.h>
@@ -30,6 +37,24 @@
 	#include <unistd.h>
 #endif
 
+#if defined(AJA_LINUX)
+	#include <poll.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <sys/uio.h>
+	#if defined(__has_include)
+		#if __has_include(<linux/io_uring.h>)
+			#include <linux/io_uring.h>
+			#if defined(__NR_io_uring_setup)
+				#define AJA_FILEIO_IO_URING		//	Use io_uring for async I/O (falls back to threads at runtime)
+				#if !defined(IORING_FEAT_SINGLE_MMAP)
+					#define IORING_FEAT_SINGLE_MMAP	(1U << 0)
+				#endif
+			#endif
+		#endif
+	#endif
+#endif
+
 #if defined(AJA_MAC)
 	#include <mach-o/dyld.h>
 #endif
@@ -70,6 +95,383 @@ using std::vector;
 #endif
 
 
+//	Asynchronous I/O engines (see AJAFileIO::ReadAsync, WriteAsync & WaitAsync)
+
+#if defined(AJA_WINDOWS)
+	typedef HANDLE	AJAFileIONativeHandle;
+#else
+	typedef int		AJAFileIONativeHandle;
+#endif
+
+#define AJA_FILEIO_DEFAULT_QUEUE_DEPTH	8
+#define AJA_FILEIO_MAX_QUEUE_DEPTH		256
+
+#if defined(AJA_LINUX)
+// Reads or writes at the file pointer of a descriptor opened with O_DIRECT. O_DIRECT needs the buffer address,
+// length and file offset to be aligned, so anything else is done through the page cache.
+static ssize_t DirectIO(int fd, const bool isWrite, uint8_t* pBuffer, const uint32_t length, const uint32_t alignment)
+{
+	const off_t offset = lseek(fd, 0, SEEK_CUR);
+	const bool aligned = (uintptr_t(pBuffer) % alignment) == 0 && (length % alignment) == 0
+							&& offset >= 0 && (offset % alignment) == 0;
+	if (aligned)
+	{
+		const ssize_t result = isWrite ? write(fd, pBuffer, length) : read(fd, pBuffer, length);
+		if (result >= 0 || errno != EINVAL)
+			return result;
+		// EINVAL:	e.g. an O_APPEND write at an unaligned end of file -- fall through
+	}
+	const int flags = fcntl(fd, F_GETFL);
+	fcntl(fd, F_SETFL, flags & ~O_DIRECT);
+	const ssize_t result = isWrite ? write(fd, pBuffer, length) : read(fd, pBuffer, length);
+	fcntl(fd, F_SETFL, flags);
+	return result;
+}
+#endif	//	defined(AJA_LINUX)
+
+#if !defined(AJA_BAREMETAL)
+// Reads or writes the whole buffer at the given offset, without using or moving the file pointer.
+// Returns the number of bytes transferred (short at end of file), or -1 upon failure.
+static int64_t PositionalIO(AJAFileIONativeHandle handle, const bool isWrite, uint8_t* pBuffer, const uint32_t length, const int64_t offset)
+{
+	uint32_t done = 0;
+	while (done < length)
+	{
+#if defined(AJA_WINDOWS)
+		OVERLAPPED overlapped;
+		memset(&overlapped, 0, sizeof(overlapped));
+		overlapped.Offset = DWORD(offset + done);
+		overlapped.OffsetHigh = DWORD(uint64_t(offset + done) >> 32);
+		DWORD count = 0;
+		const BOOL ok = isWrite ? WriteFile(handle, pBuffer + done, length - done, &count, &overlapped)
+								: ReadFile(handle, pBuffer + done, length - done, &count, &overlapped);
+		if (!ok)
+			return (!isWrite && GetLastError() == ERROR_HANDLE_EOF) ? int64_t(done) : -1;
+		if (count == 0)
+			break;
+		done += count;
+#else
+		const ssize_t count = isWrite ? pwrite(handle, pBuffer + done, length - done, off_t(offset + done))
+									  : pread(handle, pBuffer + done, length - done, off_t(offset + done));
+		if (count < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		if (count == 0)
+			break;
+		done += uint32_t(count);
+#endif
+	}
+	return int64_t(done);
+}
+#endif	//	!defined(AJA_BAREMETAL)
+
+
+class AJAFileIOAsync
+{
+public:
+	AJAFileIOAsync(const uint32_t depth) : mDepth(depth), mInFlight(0) {}
+	virtual ~AJAFileIOAsync() {}
+
+	virtual AJAStatus Submit(const AJAFileIOCompletion& request) = 0;
+	virtual AJAStatus Wait(vector<AJAFileIOCompletion>& completions, const uint32_t minCompletions, const uint32_t timeoutMs) = 0;
+	virtual const char* Name() const = 0;
+	uint32_t InFlight() const	{return mInFlight;}
+
+protected:
+	const uint32_t	mDepth;
+	uint32_t		mInFlight;	// Submitted but not yet returned by Wait
+};
+
+
+#if !defined(AJA_BAREMETAL)
+// Portable engine:	a pool of worker threads, each doing positional reads and writes.
+class AJAFileIOThreadPool : public AJAFileIOAsync
+{
+public:
+	AJAFileIOThreadPool(AJAFileIONativeHandle handle, const uint32_t depth)
+		:	AJAFileIOAsync(depth), mHandle(handle), mQuit(false), mWorkEvent(true), mDoneEvent(true)
+	{
+		mWorkers.resize(depth);
+		for (size_t ndx = 0; ndx < mWorkers.size(); ndx++)
+		{
+			mWorkers[ndx] = new AJAThread;
+			mWorkers[ndx]->Attach(WorkerThreadStatic, this);
+			mWorkers[ndx]->Start();
+		}
+	}
+
+	virtual ~AJAFileIOThreadPool()
+	{
+		{
+			AJAAutoLock locker(&mLock);
+			mQuit = true;
+			mWorkEvent.Signal();
+		}
+		for (size_t ndx = 0; ndx < mWorkers.size(); ndx++)
+		{
+			mWorkers[ndx]->Stop();
+			delete mWorkers[ndx];
+		}
+	}
+
+	virtual AJAStatus Submit(const AJAFileIOCompletion& request)
+	{
+		AJAAutoLock locker(&mLock);
+		if (mInFlight >= mDepth)
+			return AJA_STATUS_BUSY;
+		mPending.push_back(request);
+		mInFlight++;
+		mWorkEvent.Signal();
+		return AJA_STATUS_SUCCESS;
+	}
+
+	virtual AJAStatus Wait(vector<AJAFileIOCompletion>& completions, const uint32_t minCompletions, const uint32_t timeoutMs)
+	{
+		const uint64_t startMs = AJATime::GetSystemMilliseconds();
+		uint32_t collected = 0;
+		while (true)
+		{
+			{
+				AJAAutoLock locker(&mLock);
+				while (!mDone.empty())
+				{
+					completions.push_back(mDone.front());
+					mDone.pop_front();
+					mInFlight--;
+					collected++;
+				}
+				if (collected >= minCompletions || mInFlight == 0)
+					return collected >= minCompletions ? AJA_STATUS_SUCCESS : AJA_STATUS_TIMEOUT;
+				mDoneEvent.Clear();		// Under the lock, so a completion can't slip by
+			}
+			const uint64_t elapsedMs = AJATime::GetSystemMilliseconds() - startMs;
+			if (timeoutMs != 0xffffffff && elapsedMs >= timeoutMs)
+				return AJA_STATUS_TIMEOUT;
+			mDoneEvent.WaitForSignal(timeoutMs == 0xffffffff ? 0xffffffff : uint32_t(timeoutMs - elapsedMs));
+		}
+	}
+
+	virtual const char* Name() const	{return "threads";}
+
+private:
+	static void WorkerThreadStatic(AJAThread* pThread, void* pContext)
+	{
+		(void) pThread;
+		reinterpret_cast<AJAFileIOThreadPool*>(pContext)->WorkerThread();
+	}
+
+	void WorkerThread()
+	{
+		while (true)
+		{
+			AJAFileIOCompletion request;
+			{
+				AJAAutoLock locker(&mLock);
+				if (mQuit)
+					return;
+				if (mPending.empty())
+				{
+					mWorkEvent.Clear();		// Under the lock, so a submission can't slip by
+					request.pBuffer = NULL;
+				}
+				else
+				{
+					request = mPending.front();
+					mPending.pop_front();
+				}
+			}
+			if (!request.pBuffer)
+			{
+				mWorkEvent.WaitForSignal();
+				continue;
+			}
+			const int64_t result = PositionalIO(mHandle, request.isWrite, request.pBuffer, request.length, request.offset);
+			request.transferred = result < 0 ? 0 : uint32_t(result);
+			request.status = result < 0 ? AJA_STATUS_IO : AJA_STATUS_SUCCESS;
+			AJAAutoLock locker(&mLock);
+			mDone.push_back(request);
+			mDoneEvent.Signal();
+		}
+	}
+
+	AJAFileIONativeHandle				mHandle;
+	bool								mQuit;
+	AJALock								mLock;
+	AJAEvent							mWorkEvent;		// Signaled while mPending isn't empty
+	AJAEvent							mDoneEvent;		// Signaled while mDone isn't empty
+	std::deque<AJAFileIOCompletion>		mPending;
+	std::deque<AJAFileIOCompletion>		mDone;
+	std::vector<AJAThread*>				mWorkers;
+};
+#endif	//	!defined(AJA_BAREMETAL)
+
+
+#if defined(AJA_FILEIO_IO_URING)
+// Linux engine:	one io_uring per file, driven with raw system calls (no liburing dependency).
+class AJAFileIOUring : public AJAFileIOAsync
+{
+public:
+	AJAFileIOUring(int fd, const uint32_t depth)
+		:	AJAFileIOAsync(depth), mFd(fd), mRingFd(-1), mpSQ(NULL), mpCQ(NULL), mpSQEs(NULL),
+			mSQSize(0), mCQSize(0), mSQEsSize(0), mRequests(depth), mIovecs(depth)
+	{
+		struct io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		mRingFd = int(syscall(__NR_io_uring_setup, depth, &params));
+		if (mRingFd < 0)
+			return;		// Kernel too old, or io_uring disallowed -- caller falls back to threads
+		mSQSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		mCQSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			mSQSize = mCQSize = (mSQSize > mCQSize) ? mSQSize : mCQSize;
+		mpSQ = (uint8_t*) mmap(NULL, mSQSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, mRingFd, IORING_OFF_SQ_RING);
+		if (mpSQ == MAP_FAILED)
+			{mpSQ = NULL;  Teardown();  return;}
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			mpCQ = mpSQ;
+		else
+		{
+			mpCQ = (uint8_t*) mmap(NULL, mCQSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, mRingFd, IORING_OFF_CQ_RING);
+			if (mpCQ == MAP_FAILED)
+				{mpCQ = NULL;  Teardown();  return;}
+		}
+		mSQEsSize = params.sq_entries * sizeof(struct io_uring_sqe);
+		mpSQEs = (struct io_uring_sqe*) mmap(NULL, mSQEsSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, mRingFd, IORING_OFF_SQES);
+		if (mpSQEs == MAP_FAILED)
+			{mpSQEs = NULL;  Teardown();  return;}
+		mpSQHead	= (unsigned*)(mpSQ + params.sq_off.head);
+		mpSQTail	= (unsigned*)(mpSQ + params.sq_off.tail);
+		mSQMask		= *(unsigned*)(mpSQ + params.sq_off.ring_mask);
+		mpSQArray	= (unsigned*)(mpSQ + params.sq_off.array);
+		mpCQHead	= (unsigned*)(mpCQ + params.cq_off.head);
+		mpCQTail	= (unsigned*)(mpCQ + params.cq_off.tail);
+		mCQMask		= *(unsigned*)(mpCQ + params.cq_off.ring_mask);
+		mpCQEs		= (struct io_uring_cqe*)(mpCQ + params.cq_off.cqes);
+		for (uint32_t slot = 0; slot < depth; slot++)
+			mFreeSlots.push_back(slot);
+	}
+
+	virtual ~AJAFileIOUring()
+	{
+		vector<AJAFileIOCompletion> discard;
+		while (mRingFd >= 0 && mInFlight)
+			if (Wait(discard, mInFlight, 0xffffffff) != AJA_STATUS_SUCCESS)
+				break;
+		Teardown();
+	}
+
+	bool IsValid() const	{return mRingFd >= 0;}
+
+	virtual AJAStatus Submit(const AJAFileIOCompletion& request)
+	{
+		if (mFreeSlots.empty())
+			return AJA_STATUS_BUSY;
+		const uint32_t slot = mFreeSlots.back();
+		mRequests[slot] = request;
+		mIovecs[slot].iov_base = request.pBuffer;
+		mIovecs[slot].iov_len = request.length;
+
+		// Only this thread writes the SQ tail;	the kernel advances the head as it consumes entries
+		const unsigned tail = *mpSQTail;
+		const unsigned index = tail & mSQMask;
+		struct io_uring_sqe* pSQE = &mpSQEs[index];
+		memset(pSQE, 0, sizeof(*pSQE));
+		pSQE->opcode	= request.isWrite ? IORING_OP_WRITEV : IORING_OP_READV;	// The vectored ops go back to the first io_uring kernels
+		pSQE->fd		= mFd;
+		pSQE->addr		= (uint64_t)(uintptr_t) &mIovecs[slot];
+		pSQE->len		= 1;
+		pSQE->off		= (uint64_t) request.offset;
+		pSQE->user_data	= slot;
+		mpSQArray[index] = index;
+		__atomic_store_n(mpSQTail, tail + 1, __ATOMIC_RELEASE);
+
+		int result;
+		do
+			result = int(syscall(__NR_io_uring_enter, mRingFd, 1, 0, 0, NULL, 0));
+		while (result < 0 && errno == EINTR);
+		if (result != 1)
+		{
+			__atomic_store_n(mpSQTail, tail, __ATOMIC_RELEASE);		// Not consumed -- take it back
+			return AJA_STATUS_IO;
+		}
+		mFreeSlots.pop_back();
+		mInFlight++;
+		return AJA_STATUS_SUCCESS;
+	}
+
+	virtual AJAStatus Wait(vector<AJAFileIOCompletion>& completions, const uint32_t minCompletions, const uint32_t timeoutMs)
+	{
+		const uint64_t startMs = AJATime::GetSystemMilliseconds();
+		uint32_t collected = 0;
+		while (true)
+		{
+			unsigned head = *mpCQHead;
+			const unsigned tail = __atomic_load_n(mpCQTail, __ATOMIC_ACQUIRE);
+			while (head != tail)
+			{
+				const struct io_uring_cqe& cqe = mpCQEs[head & mCQMask];
+				const uint32_t slot = uint32_t(cqe.user_data);
+				AJAFileIOCompletion& request = mRequests[slot];
+				request.transferred = cqe.res < 0 ? 0 : uint32_t(cqe.res);
+				request.status = cqe.res < 0 ? AJA_STATUS_IO : AJA_STATUS_SUCCESS;
+				completions.push_back(request);
+				mFreeSlots.push_back(slot);
+				mInFlight--;
+				collected++;
+				head++;
+			}
+			__atomic_store_n(mpCQHead, head, __ATOMIC_RELEASE);
+			if (collected >= minCompletions || mInFlight == 0)
+				return collected >= minCompletions ? AJA_STATUS_SUCCESS : AJA_STATUS_TIMEOUT;
+
+			// The ring descriptor polls readable while completions are waiting
+			const uint64_t elapsedMs = AJATime::GetSystemMilliseconds() - startMs;
+			if (timeoutMs != 0xffffffff && elapsedMs >= timeoutMs)
+				return AJA_STATUS_TIMEOUT;
+			struct pollfd pfd;
+			pfd.fd = mRingFd;
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+			if (poll(&pfd, 1, timeoutMs == 0xffffffff ? -1 : int(timeoutMs - elapsedMs)) < 0 && errno != EINTR)
+				return AJA_STATUS_FAIL;
+		}
+	}
+
+	virtual const char* Name() const	{return "io_uring";}
+
+private:
+	void Teardown()
+	{
+		if (mpSQEs)
+			munmap(mpSQEs, mSQEsSize);
+		if (mpCQ && mpCQ != mpSQ)
+			munmap(mpCQ, mCQSize);
+		if (mpSQ)
+			munmap(mpSQ, mSQSize);
+		if (mRingFd >= 0)
+			close(mRingFd);
+		mpSQEs = NULL;	mpCQ = mpSQ = NULL;	 mRingFd = -1;
+	}
+
+	int								mFd;
+	int								mRingFd;
+	uint8_t*						mpSQ;
+	uint8_t*						mpCQ;
+	struct io_uring_sqe*			mpSQEs;
+	size_t							mSQSize, mCQSize, mSQEsSize;
+	unsigned						*mpSQHead, *mpSQTail, *mpSQArray, mSQMask;
+	unsigned						*mpCQHead, *mpCQTail, mCQMask;
+	struct io_uring_cqe*			mpCQEs;
+	vector<AJAFileIOCompletion>		mRequests;		// Indexed by slot
+	vector<struct iovec>			mIovecs;		// Indexed by slot
+	vector<uint32_t>				mFreeSlots;
+};
+#endif	//	defined(AJA_FILEIO_IO_URING)
+
+
 AJAFileIO::AJAFileIO()
 {
 #if defined(AJA_WINDOWS)
@@ -83,7 +485,10 @@ AJAFileIO::AJAFileIO()
 #else
 	mIoModel		= eAJAIoDefault;
 #endif
-	
+	mDirectIO			= false;
+	mDirectIOAlignment	= 1;
+	mAsyncQueueDepth	= AJA_FILEIO_DEFAULT_QUEUE_DEPTH;
+	mpAsync				= NULL;
 }
 
 
@@ -181,6 +586,8 @@ AJAFileIO::Open(
 		if (INVALID_HANDLE_VALUE != mFileDescriptor)
 		{
 			status = AJA_STATUS_SUCCESS;
+			mDirectIO = (eAJAUnbuffered & properties) != 0;
+			mDirectIOAlignment = 4096;	// Safe for all sector sizes
 		}
 	}
 	return status;
@@ -250,6 +657,38 @@ AJAFileIO::Open(
 		if (true == flagsAndAttributes.empty())
 			return AJA_STATUS_BAD_PARAM;
 		
+#if defined(AJA_LINUX)
+		if ((eAJAUnbuffered | eAJANoCaching) & properties)
+		{
+			// Open with O_DIRECT (same semantics as the fopen mode), then do all I/O on the descriptor
+			int openFlags = O_RDONLY;
+			if (flagsAndAttributes == "w")
+				openFlags = O_WRONLY | O_CREAT | O_TRUNC;
+			else if (flagsAndAttributes == "w+")
+				openFlags = O_RDWR | O_CREAT | O_TRUNC;
+			else if (flagsAndAttributes == "a+")
+				openFlags = O_RDWR | O_CREAT | O_APPEND;
+			int fd = open(fileName.c_str(), openFlags | O_DIRECT, 0666);
+			mDirectIO = fd != -1;
+			if (fd == -1 && errno == EINVAL)
+				fd = open(fileName.c_str(), openFlags, 0666);	// File system can't do O_DIRECT (e.g. tmpfs)
+			if (fd == -1)
+				return AJA_STATUS_FAIL;
+			mpFile = fdopen(fd, flagsAndAttributes.c_str());
+			if (NULL == mpFile)
+			{
+				close(fd);
+				mDirectIO = false;
+				return AJA_STATUS_FAIL;
+			}
+			const long alignment = fpathconf(fd, _PC_REC_XFER_ALIGN);
+			mDirectIOAlignment = alignment >= 512 ? uint32_t(alignment) : 4096;
+			mIoModel = eAJAIoAlternate;		// Bypass stdio buffering
+			if (!mDirectIO && (eAJANoCaching & properties))
+				posix_fadvise(fd, 0, 0, POSIX_FADV_NOREUSE);
+			return AJA_STATUS_SUCCESS;
+		}
+#endif
 		// One can also change the buffering behavior via:
 		// setvbuf(FILE*, char* pBuffer, _IOFBF,  size_t size);
 		mpFile = fopen(fileName.c_str(), flagsAndAttributes.c_str());
@@ -283,6 +722,8 @@ AJAFileIO::Close()
 #if defined(AJA_WINDOWS)
 	AJAStatus status = AJA_STATUS_FAIL;
 
+	delete mpAsync;		// Waits for requests in flight
+	mpAsync = NULL;
 	if (INVALID_HANDLE_VALUE != mFileDescriptor)
 	{
 		if (TRUE == CloseHandle(mFileDescriptor))
@@ -291,6 +732,7 @@ AJAFileIO::Close()
 		}
 		mFileDescriptor = INVALID_HANDLE_VALUE;
 	}
+	mDirectIO = false;
 	return status;
 #elif defined(AJA_BAREMETAL)
 	// TODO
@@ -298,6 +740,8 @@ AJAFileIO::Close()
 #else
 	AJAStatus status = AJA_STATUS_FAIL;
 
+	delete mpAsync;		// Waits for requests in flight
+	mpAsync = NULL;
 	if (NULL != mpFile)
 	{
 		int retVal = 0;
@@ -308,6 +752,11 @@ AJAFileIO::Close()
 		
 		mpFile = NULL;
 	}
+#if !TARGET_CPU_ARM64
+	mIoModel = eAJAIoDefault;	// Open switches to the descriptor for direct I/O
+#endif
+	mDirectIO = false;
+	mDirectIOAlignment = 1;
 	return status;
 #endif
 }
@@ -343,6 +792,11 @@ AJAFileIO::Read(uint8_t* pBuffer, const uint32_t length)
 	if (NULL != mpFile)
 	{
 		size_t bytesRead;
+#if defined(AJA_LINUX)
+		if (mDirectIO)
+			bytesRead = DirectIO(fileno(mpFile), false, pBuffer, length, mDirectIOAlignment);
+		else
+#endif
 		if (mIoModel == eAJAIoAlternate)
 			bytesRead = read(fileno(mpFile), pBuffer, length);
 		else
@@ -395,6 +849,16 @@ AJAFileIO::Write(const uint8_t* pBuffer, const uint32_t length) const
 	if (NULL != mpFile)
 	{
 		size_t bytesWritten = 0;
+#if defined(AJA_LINUX)
+		if (mDirectIO)
+		{
+			if ((bytesWritten = DirectIO(fileno(mpFile), true, (uint8_t*) pBuffer, length, mDirectIOAlignment)) > 0)
+			{
+				retVal = uint32_t(bytesWritten);
+			}
+		}
+		else
+#endif
 		if (mIoModel == eAJAIoAlternate)
 		{
 			if ((bytesWritten = write(fileno(mpFile), pBuffer, length)) > 0)
@@ -623,6 +1087,227 @@ AJAFileIO::Seek(const int64_t distance, const AJAFileSetFlag flag) const
 }
 
 
+AJAStatus
+AJAFileIO::Preallocate(const int64_t offset, const int64_t length, const bool keepSize)
+{
+	if (offset < 0 || length <= 0)
+		return AJA_STATUS_BAD_PARAM;
+#if defined(AJA_WINDOWS)
+	AJAStatus status = AJA_STATUS_FAIL;
+	if (INVALID_HANDLE_VALUE != mFileDescriptor)
+	{
+		// Windows can only reserve space at the end of the file, which never changes its size
+		(void) keepSize;
+		FILE_ALLOCATION_INFO info;
+		info.AllocationSize.QuadPart = offset + length;
+		if (SetFileInformationByHandle(mFileDescriptor, FileAllocationInfo, &info, sizeof(info)))
+			status = AJA_STATUS_SUCCESS;
+	}
+	return status;
+#elif defined(AJA_BAREMETAL)
+	// TODO
+	return AJA_STATUS_FAIL;
+#else
+	AJAStatus status = AJA_STATUS_FAIL;
+	if (IsOpen())
+	{
+		int fd = fileno(mpFile);
+#if defined(AJA_LINUX)
+		if (fallocate(fd, keepSize ? FALLOC_FL_KEEP_SIZE : 0, off_t(offset), off_t(length)) == 0)
+			status = AJA_STATUS_SUCCESS;
+		else if (errno == EOPNOTSUPP && !keepSize)
+			status = posix_fallocate(fd, off_t(offset), off_t(length)) == 0 ? AJA_STATUS_SUCCESS : AJA_STATUS_FAIL;	// Emulated by writing zeroes
+		else if (errno == EOPNOTSUPP)
+			status = AJA_STATUS_UNSUPPORTED;
+#elif defined(AJA_MAC)
+		fstore_t store;
+		memset(&store, 0, sizeof(store));
+		store.fst_flags = F_ALLOCATECONTIG;
+		store.fst_posmode = F_PEOFPOSMODE;
+		store.fst_length = off_t(offset + length);
+		if (fcntl(fd, F_PREALLOCATE, &store) == -1)
+		{
+			store.fst_flags = F_ALLOCATEALL;	// Contiguous space unavailable -- settle for any
+			if (fcntl(fd, F_PREALLOCATE, &store) == -1)
+				return AJA_STATUS_FAIL;
+		}
+		status = AJA_STATUS_SUCCESS;
+		struct stat fileStatus;
+		if (!keepSize && fstat(fd, &fileStatus) == 0 && fileStatus.st_size < offset + length)
+			status = ftruncate(fd, off_t(offset + length)) == 0 ? AJA_STATUS_SUCCESS : AJA_STATUS_FAIL;
+#else
+		(void) fd;
+		(void) keepSize;
+		status = AJA_STATUS_UNSUPPORTED;
+#endif
+	}
+	return status;
+#endif
+}
+
+
+AJAStatus
+AJAFileIO::Advise(const int64_t offset, const int64_t length, const AJAFileAdvice advice)
+{
+	if (offset < 0 || length < 0)
+		return AJA_STATUS_BAD_PARAM;
+#if defined(AJA_WINDOWS)
+	// Windows takes access hints when the file is opened
+	(void) advice;
+	return IsOpen() ? AJA_STATUS_SUCCESS : AJA_STATUS_FAIL;
+#elif defined(AJA_BAREMETAL)
+	// TODO
+	(void) advice;
+	return AJA_STATUS_FAIL;
+#else
+	if (!IsOpen())
+		return AJA_STATUS_FAIL;
+	int fd = fileno(mpFile);
+#if defined(AJA_LINUX)
+	int posixAdvice = POSIX_FADV_NORMAL;
+	switch (advice)
+	{
+		case eAJAAdviseNormal:		posixAdvice = POSIX_FADV_NORMAL;		break;
+		case eAJAAdviseSequential:	posixAdvice = POSIX_FADV_SEQUENTIAL;	break;
+		case eAJAAdviseRandom:		posixAdvice = POSIX_FADV_RANDOM;		break;
+		case eAJAAdviseWillNeed:	posixAdvice = POSIX_FADV_WILLNEED;		break;
+		case eAJAAdviseDontNeed:	posixAdvice = POSIX_FADV_DONTNEED;		break;
+		case eAJAAdviseNoReuse:		posixAdvice = POSIX_FADV_NOREUSE;		break;
+		default:					return AJA_STATUS_BAD_PARAM;
+	}
+	if (advice == eAJAAdviseDontNeed)
+		fdatasync(fd);		// Dirty pages can't be dropped until they're written
+	return posix_fadvise(fd, off_t(offset), off_t(length), posixAdvice) == 0 ? AJA_STATUS_SUCCESS : AJA_STATUS_FAIL;
+#elif defined(AJA_MAC)
+	switch (advice)
+	{
+		case eAJAAdviseSequential:
+		case eAJAAdviseNormal:
+			return fcntl(fd, F_RDAHEAD, 1) != -1 ? AJA_STATUS_SUCCESS : AJA_STATUS_FAIL;
+		case eAJAAdviseRandom:
+			return fcntl(fd, F_RDAHEAD, 0) != -1 ? AJA_STATUS_SUCCESS : AJA_STATUS_FAIL;
+		case eAJAAdviseWillNeed:
+		{
+			struct radvisory ra;
+			ra.ra_offset = off_t(offset);
+			ra.ra_count = length > INT_MAX ? INT_MAX : int(length);
+			return fcntl(fd, F_RDADVISE, &ra) != -1 ? AJA_STATUS_SUCCESS : AJA_STATUS_FAIL;
+		}
+		case eAJAAdviseDontNeed:
+		case eAJAAdviseNoReuse:
+			return AJA_STATUS_SUCCESS;
+		default:
+			return AJA_STATUS_BAD_PARAM;
+	}
+#else
+	(void) fd;
+	(void) advice;
+	return AJA_STATUS_SUCCESS;
+#endif
+#endif
+}
+
+
+AJAStatus
+AJAFileIO::ReadAsync(uint8_t* pBuffer, const uint32_t length, const int64_t offset, const uint64_t cookie)
+{
+	return SubmitAsync(pBuffer, length, offset, cookie, false);
+}
+
+
+AJAStatus
+AJAFileIO::WriteAsync(const uint8_t* pBuffer, const uint32_t length, const int64_t offset, const uint64_t cookie)
+{
+	return SubmitAsync((uint8_t*) pBuffer, length, offset, cookie, true);
+}
+
+
+AJAStatus
+AJAFileIO::SubmitAsync(uint8_t* pBuffer, const uint32_t length, const int64_t offset, const uint64_t cookie, const bool isWrite)
+{
+#if defined(AJA_BAREMETAL)
+	// TODO
+	(void) pBuffer; (void) length; (void) offset; (void) cookie; (void) isWrite;
+	return AJA_STATUS_FAIL;
+#else
+	if (!IsOpen())
+		return AJA_STATUS_FAIL;
+	if (!pBuffer)
+		return AJA_STATUS_NULL;
+	if (!length || offset < 0)
+		return AJA_STATUS_BAD_PARAM;
+	if (mDirectIO && ((uintptr_t(pBuffer) | length | uint64_t(offset)) % mDirectIOAlignment))
+		return AJA_STATUS_ALIGN;	// Unlike Read/Write, there's no page cache fallback for requests in flight
+
+	if (!mpAsync)
+	{
+#if defined(AJA_WINDOWS)
+		AJAFileIONativeHandle handle = mFileDescriptor;
+#else
+		AJAFileIONativeHandle handle = fileno(mpFile);
+#endif
+#if defined(AJA_FILEIO_IO_URING)
+		AJAFileIOUring* pUring = new AJAFileIOUring(handle, mAsyncQueueDepth);
+		if (pUring->IsValid())
+			mpAsync = pUring;
+		else
+			delete pUring;
+#endif
+		if (!mpAsync)
+			mpAsync = new AJAFileIOThreadPool(handle, mAsyncQueueDepth);
+	}
+
+	AJAFileIOCompletion request;
+	request.cookie		= cookie;
+	request.offset		= offset;
+	request.pBuffer		= pBuffer;
+	request.length		= length;
+	request.transferred	= 0;
+	request.isWrite		= isWrite;
+	request.status		= AJA_STATUS_SUCCESS;
+	return mpAsync->Submit(request);
+#endif
+}
+
+
+AJAStatus
+AJAFileIO::WaitAsync(std::vector<AJAFileIOCompletion>& completions, const uint32_t minCompletions, const uint32_t timeoutMs)
+{
+	if (!mpAsync || !mpAsync->InFlight())
+		return minCompletions ? AJA_STATUS_FAIL : AJA_STATUS_SUCCESS;
+	const uint32_t inFlight = mpAsync->InFlight();
+	return mpAsync->Wait(completions, minCompletions < inFlight ? minCompletions : inFlight, timeoutMs);
+}
+
+
+AJAStatus
+AJAFileIO::SetAsyncQueueDepth(const uint32_t depth)
+{
+	if (!depth || depth > AJA_FILEIO_MAX_QUEUE_DEPTH)
+		return AJA_STATUS_RANGE;
+	if (mpAsync && mpAsync->InFlight())
+		return AJA_STATUS_BUSY;
+	delete mpAsync;		// Recreated on next use
+	mpAsync = NULL;
+	mAsyncQueueDepth = depth;
+	return AJA_STATUS_SUCCESS;
+}
+
+
+uint32_t
+AJAFileIO::GetAsyncPending() const
+{
+	return mpAsync ? mpAsync->InFlight() : 0;
+}
+
+
+std::string
+AJAFileIO::GetAsyncEngine() const
+{
+	return mpAsync ? string(mpAsync->Name()) : string();
+}
+
+
 AJAStatus
 AJAFileIO::FileInfo(int64_t& createTime, int64_t& modTime, int64_t& size)
 {
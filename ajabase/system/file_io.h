@@ -57,6 +57,34 @@ typedef enum
 } AJAIOModel;
 
 
+typedef enum
+{
+	eAJAAdviseNormal,		// No particular access pattern
+	eAJAAdviseSequential,	// Expect sequential access (read ahead more)
+	eAJAAdviseRandom,		// Expect random access (don't read ahead)
+	eAJAAdviseWillNeed,		// Expect access soon (start reading ahead now)
+	eAJAAdviseDontNeed,		// Not needed again soon (drop from the page cache)
+	eAJAAdviseNoReuse		// Accessed only once
+} AJAFileAdvice;	//	New in SDK 17.5
+
+
+/**
+ *	Describes a completed asynchronous read or write (see AJAFileIO::WaitAsync).
+ */
+typedef struct AJAFileIOCompletion
+{
+	uint64_t	cookie;			// The cookie passed to ReadAsync/WriteAsync
+	int64_t		offset;			// File offset of the request
+	uint8_t *	pBuffer;		// Buffer of the request
+	uint32_t	length;			// Number of bytes requested
+	uint32_t	transferred;	// Number of bytes actually transferred (less than length at end of file)
+	bool		isWrite;		// True for a write, false for a read
+	AJAStatus	status;			// AJA_STATUS_SUCCESS, or AJA_STATUS_IO if the request failed
+} AJAFileIOCompletion;	//	New in SDK 17.5
+
+class AJAFileIOAsync;
+
+
 /**
  *	The File I/O class proper.
  *	@ingroup AJAGroupSystem
@@ -76,6 +104,10 @@ public:
 	 *
 	 *	@return		AJA_STATUS_SUCCESS	A file has been successfully opened
 	 *				AJA_STATUS_FAIL		A file could not be opened
+	 *
+	 *	On Linux, eAJAUnbuffered or eAJANoCaching opens the file with O_DIRECT, bypassing stdio and the page cache,
+	 *	if the file system supports it (see IsDirectIO). Reads and writes whose buffer address, length or file offset
+	 *	aren't multiples of GetDirectIOAlignment still work, but go through the page cache.
 	 */
 	AJAStatus Open(
 				const std::string &		fileName,
@@ -174,6 +206,102 @@ public:
 	 */
 	AJAStatus Seek(const int64_t distance, const AJAFileSetFlag flag) const;
 
+	/**
+	 *	Reserves disk space for the file, so that later writes don't have to allocate it (and are less fragmented).
+	 *
+	 *	@param[in]	offset				The file offset of the region to reserve
+	 *	@param[in]	length				The length of the region to reserve, in bytes
+	 *	@param[in]	keepSize			If true, the file size doesn't change;	otherwise the file grows to cover the region
+	 *
+	 *	@return		AJA_STATUS_SUCCESS	The space was reserved
+	 *				AJA_STATUS_UNSUPPORTED	The platform or file system can't reserve space
+	 */
+	AJAStatus Preallocate(const int64_t offset, const int64_t length, const bool keepSize = false);	//	New in SDK 17.5
+
+	/**
+	 *	Tells the system how the given region of the file will be accessed, so it can tune read-ahead and caching.
+	 *
+	 *	@param[in]	offset				The file offset of the region
+	 *	@param[in]	length				The length of the region, in bytes (zero means to the end of the file)
+	 *	@param[in]	advice				The expected access pattern
+	 *
+	 *	@return		AJA_STATUS_SUCCESS	The advice was taken (or is meaningless on this platform)
+	 */
+	AJAStatus Advise(const int64_t offset, const int64_t length, const AJAFileAdvice advice);	//	New in SDK 17.5
+
+	/**
+	 *	@return		bool				'true' if the file was opened for direct (unbuffered, uncached) I/O
+	 */
+	bool IsDirectIO() const	{return mDirectIO;}	//	New in SDK 17.5
+
+	/**
+	 *	@return		uint32_t			The alignment of buffer addresses, lengths and offsets needed for direct I/O,
+	 *									or 1 if the file isn't open for direct I/O (see AJAMemory::AllocateAligned)
+	 */
+	uint32_t GetDirectIOAlignment() const	{return mDirectIO ? mDirectIOAlignment : 1;}	//	New in SDK 17.5
+
+	/**
+	 *	Queues an asynchronous read at the given file offset. The file pointer is not used or changed.
+	 *	Up to GetAsyncQueueDepth requests can be in flight at once; collect them with WaitAsync.
+	 *
+	 *	@param[out] pBuffer				The buffer to read into, which must stay valid until the read completes
+	 *	@param[in]	length				The number of bytes to read
+	 *	@param[in]	offset				The file offset to read from
+	 *	@param[in]	cookie				Identifies the request in its AJAFileIOCompletion
+	 *
+	 *	@return		AJA_STATUS_SUCCESS	The read was queued
+	 *				AJA_STATUS_BUSY		The queue is full -- call WaitAsync first
+	 *				AJA_STATUS_ALIGN	The request isn't aligned for direct I/O
+	 */
+	AJAStatus ReadAsync(uint8_t* pBuffer, const uint32_t length, const int64_t offset, const uint64_t cookie = 0);	//	New in SDK 17.5
+
+	/**
+	 *	Queues an asynchronous write at the given file offset. The file pointer is not used or changed.
+	 *
+	 *	@param[in]	pBuffer				The buffer to write, which must stay valid until the write completes
+	 *	@param[in]	length				The number of bytes to write
+	 *	@param[in]	offset				The file offset to write to
+	 *	@param[in]	cookie				Identifies the request in its AJAFileIOCompletion
+	 *
+	 *	@return		AJA_STATUS_SUCCESS	The write was queued
+	 *				AJA_STATUS_BUSY		The queue is full -- call WaitAsync first
+	 *				AJA_STATUS_ALIGN	The request isn't aligned for direct I/O
+	 */
+	AJAStatus WriteAsync(const uint8_t* pBuffer, const uint32_t length, const int64_t offset, const uint64_t cookie = 0);	//	New in SDK 17.5
+
+	/**
+	 *	Waits for queued asynchronous requests to complete.
+	 *
+	 *	@param[out] completions			Receives the completed requests (appended)
+	 *	@param[in]	minCompletions		The number of completions to wait for (clamped to the number in flight)
+	 *	@param[in]	timeoutMs			The maximum time to wait, in milliseconds
+	 *
+	 *	@return		AJA_STATUS_SUCCESS	At least minCompletions requests completed
+	 *				AJA_STATUS_TIMEOUT	Fewer completed before the timeout (those that did are still returned)
+	 */
+	AJAStatus WaitAsync(std::vector<AJAFileIOCompletion>& completions, const uint32_t minCompletions = 1,
+						const uint32_t timeoutMs = 0xffffffff);	//	New in SDK 17.5
+
+	/**
+	 *	Sets the maximum number of asynchronous requests in flight. Fails if any are in flight.
+	 *
+	 *	@param[in]	depth				The queue depth (1 thru 256, default 8)
+	 *
+	 *	@return		AJA_STATUS_SUCCESS	The depth was changed
+	 */
+	AJAStatus SetAsyncQueueDepth(const uint32_t depth);	//	New in SDK 17.5
+	uint32_t GetAsyncQueueDepth() const		{return mAsyncQueueDepth;}	//	New in SDK 17.5
+
+	/**
+	 *	@return		uint32_t			The number of asynchronous requests queued but not yet collected by WaitAsync
+	 */
+	uint32_t GetAsyncPending() const;	//	New in SDK 17.5
+
+	/**
+	 *	@return		std::string			The asynchronous I/O engine in use:	"io_uring", "threads", or empty if none yet
+	 */
+	std::string GetAsyncEngine() const;	//	New in SDK 17.5
+
 	/**
 	 *	Get some basic file info
 	 *
@@ -345,6 +473,7 @@ public:
 #endif
 
 private:
+	AJAStatus SubmitAsync(uint8_t* pBuffer, const uint32_t length, const int64_t offset, const uint64_t cookie, const bool isWrite);
 
 #if defined(AJA_WINDOWS)
 	HANDLE		mFileDescriptor;
@@ -352,6 +481,10 @@ private:
 	FILE*		mpFile;
 #endif
 	AJAIOModel	mIoModel;
+	bool		mDirectIO;				// Opened with O_DIRECT
+	uint32_t	mDirectIOAlignment;		// Alignment needed for O_DIRECT transfers
+	uint32_t	mAsyncQueueDepth;		// Max async requests in flight
+	AJAFileIOAsync * mpAsync;			// Async engine, created on first use
 };
 
 #endif // AJA_FILE_IO_H
@@ -15,8 +15,72 @@
 #include <sys/prctl.h>
 #include <unistd.h>
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
 
 static const size_t STACK_SIZE = 1024 * 1024;
+static const char* NUMA_NODE_PATH = "/sys/devices/system/node";
+
+// parses a kernel cpu/node list such as "0-7,16-23"
+static bool ParseKernelList(const std::string& list, std::vector<int>& values)
+{
+	values.clear();
+	const char* p = list.c_str();
+	while (*p && *p != '\n')
+	{
+		char* end = NULL;
+		long first = strtol(p, &end, 10);
+		if (end == p || first < 0)
+			return false;
+		long last = first;
+		p = end;
+		if (*p == '-')
+		{
+			last = strtol(p + 1, &end, 10);
+			if (end == p + 1 || last < first)
+				return false;
+			p = end;
+		}
+		for (long v = first; v <= last; v++)
+			values.push_back(int(v));
+		if (*p == ',')
+			p++;
+	}
+	return true;
+}
+
+static bool ReadKernelList(const std::string& path, std::vector<int>& values)
+{
+	FILE* pFile = fopen(path.c_str(), "r");
+	if (pFile == NULL)
+		return false;
+	char buffer[4096];
+	bool ok = fgets(buffer, sizeof(buffer), pFile) != NULL;
+	fclose(pFile);
+	return ok && ParseKernelList(buffer, values);
+}
+
+// an empty list means every configured cpu
+static bool MakeCPUSet(const std::vector<int>& cpus, cpu_set_t& cpuSet)
+{
+	CPU_ZERO(&cpuSet);
+	if (cpus.empty())
+	{
+		long numCPUs = sysconf(_SC_NPROCESSORS_CONF);
+		for (long cpu = 0; cpu < numCPUs && cpu < CPU_SETSIZE; cpu++)
+			CPU_SET(int(cpu), &cpuSet);
+		return true;
+	}
+	for (size_t i = 0; i < cpus.size(); i++)
+	{
+		if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE)
+			return false;
+		CPU_SET(cpus[i], &cpuSet);
+	}
+	return true;
+}
 
 bool is_pthread_alive(pthread_t thread)
 {
@@ -528,6 +592,60 @@ AJAThreadImpl::SetRealTime(AJAThreadRealTimePolicy policy, int priority)
 }
 
 
+AJAStatus
+AJAThreadImpl::SetAffinity(const std::vector<int>& cpus)
+{
+	AJAAutoLock lock(&mLock);
+
+	cpu_set_t cpuSet;
+	if (!MakeCPUSet(cpus, cpuSet))
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread(%p)::SetAffinity: cpu number out of range", mpThreadContext);
+		return AJA_STATUS_RANGE;
+	}
+	mAffinity = cpus;
+
+	// if the thread is not running the affinity is applied when it starts
+	if (!Active())
+		return AJA_STATUS_SUCCESS;
+
+	int rc = pthread_setaffinity_np(mThread, sizeof(cpuSet), &cpuSet);
+	if (rc)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread(%p)::SetAffinity: error %d setting affinity", mpThreadContext, rc);
+		return AJA_STATUS_FAIL;
+	}
+	return AJA_STATUS_SUCCESS;
+}
+
+
+AJAStatus
+AJAThreadImpl::GetAffinity(std::vector<int>& cpus)
+{
+	AJAAutoLock lock(&mLock);
+
+	cpus.clear();
+	if (!Active())
+	{
+		cpus = mAffinity;
+		return AJA_STATUS_SUCCESS;
+	}
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	int rc = pthread_getaffinity_np(mThread, sizeof(cpuSet), &cpuSet);
+	if (rc)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread(%p)::GetAffinity: error %d getting affinity", mpThreadContext, rc);
+		return AJA_STATUS_FAIL;
+	}
+	for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		if (CPU_ISSET(cpu, &cpuSet))
+			cpus.push_back(cpu);
+	return AJA_STATUS_SUCCESS;
+}
+
+
 AJAStatus
 AJAThreadImpl::Attach(AJAThreadFunction* pThreadFunction, void* pUserContext)
 {
@@ -557,6 +675,16 @@ AJAThreadImpl::ThreadProcStatic(void* pThreadImplContext)
 	if (errno == 0)							// theoretically gettid() cannot fail, so by extension syscall(SYS_gettid) can't either...?
 		pThreadImpl->mTid = myTid;
 
+	// apply an affinity requested before the thread started (Start holds mLock until we signal)
+	if (!pThreadImpl->mAffinity.empty())
+	{
+		cpu_set_t cpuSet;
+		MakeCPUSet(pThreadImpl->mAffinity, cpuSet);
+		int err = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		if (err)
+			AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread(%p)::ThreadProcStatic error %d setting affinity", pThreadImpl->mpThreadContext, err);
+	}
+
 
 	// signal parent we've started
 	int rc = pthread_mutex_lock(&pThreadImpl->mStartMutex);
@@ -645,3 +773,48 @@ uint64_t AJAThreadImpl::GetThreadId()
 	else
 		return 0;
 }
+
+int AJAThreadImpl::GetNUMANodeCount()
+{
+	std::vector<int> nodes;
+	if (!ReadKernelList(std::string(NUMA_NODE_PATH) + "/online", nodes) || nodes.empty())
+		return 1;
+	return *std::max_element(nodes.begin(), nodes.end()) + 1;
+}
+
+AJAStatus AJAThreadImpl::GetNUMANodeCPUs(int node, std::vector<int>& cpus)
+{
+	cpus.clear();
+	if (node < 0)
+		return AJA_STATUS_RANGE;
+
+	char path[128];
+	snprintf(path, sizeof(path), "%s/node%d/cpulist", NUMA_NODE_PATH, node);
+	if (ReadKernelList(path, cpus))
+		return AJA_STATUS_SUCCESS;
+
+	// kernels built without NUMA have no node directory, treat the machine as node 0
+	if (node == 0 && access(NUMA_NODE_PATH, F_OK) != 0)
+	{
+		long numCPUs = sysconf(_SC_NPROCESSORS_CONF);
+		for (long cpu = 0; cpu < numCPUs; cpu++)
+			cpus.push_back(int(cpu));
+		return AJA_STATUS_SUCCESS;
+	}
+	return AJA_STATUS_RANGE;
+}
+
+AJAStatus AJAThreadImpl::SetCurrentThreadAffinity(const std::vector<int>& cpus)
+{
+	cpu_set_t cpuSet;
+	if (!MakeCPUSet(cpus, cpuSet))
+		return AJA_STATUS_RANGE;
+
+	int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+	if (rc)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread::SetCurrentThreadAffinity: error %d setting affinity", rc);
+		return AJA_STATUS_FAIL;
+	}
+	return AJA_STATUS_SUCCESS;
+}
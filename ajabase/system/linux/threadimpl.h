@@ -36,10 +36,16 @@ public:
 
 	AJAStatus		SetRealTime(AJAThreadRealTimePolicy policy, int priority);
 
+	AJAStatus		SetAffinity(const std::vector<int>& cpus);
+	AJAStatus		GetAffinity(std::vector<int>& cpus);
+
 	AJAStatus		Attach(AJAThreadFunction* pThreadFunction, void* pUserContext);
 	AJAStatus		SetThreadName(const char *name);
 
 	static uint64_t GetThreadId();
+	static int		GetNUMANodeCount();
+	static AJAStatus GetNUMANodeCPUs(int node, std::vector<int>& cpus);
+	static AJAStatus SetCurrentThreadAffinity(const std::vector<int>& cpus);
 	static void*	ThreadProcStatic(void* pThreadImplContext);
 
 public:
@@ -50,6 +56,7 @@ public:
 	AJAThreadFunction*	mThreadFunc;
 	void*				mpUserContext;
 	AJALock				mLock;
+	std::vector<int>	mAffinity;
 
 	bool				mThreadStarted;
 	pthread_mutex_t		mStartMutex;
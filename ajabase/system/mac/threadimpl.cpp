@@ -18,6 +18,7 @@
 #include <mach/thread_policy.h>
 #include <mach/thread_act.h>
 #include <mach/mach_time.h>
+#include <unistd.h>
 
 static const size_t STACK_SIZE = 1024 * 1024;
 
@@ -494,3 +495,39 @@ uint64_t AJAThreadImpl::GetThreadId()
 	pthread_threadid_np(NULL, &tid);
 	return tid;
 }
+
+
+// macOS only takes affinity hints (thread affinity tags), not cpu masks
+AJAStatus AJAThreadImpl::SetAffinity(const std::vector<int>& cpus)
+{
+	AJA_UNUSED(cpus);
+	return AJA_STATUS_UNSUPPORTED;
+}
+
+AJAStatus AJAThreadImpl::GetAffinity(std::vector<int>& cpus)
+{
+	cpus.clear();
+	return AJA_STATUS_UNSUPPORTED;
+}
+
+int AJAThreadImpl::GetNUMANodeCount()
+{
+	return 1;
+}
+
+AJAStatus AJAThreadImpl::GetNUMANodeCPUs(int node, std::vector<int>& cpus)
+{
+	cpus.clear();
+	if (node != 0)
+		return AJA_STATUS_RANGE;
+	long numCPUs = sysconf(_SC_NPROCESSORS_CONF);
+	for (long cpu = 0; cpu < numCPUs; cpu++)
+		cpus.push_back(int(cpu));
+	return AJA_STATUS_SUCCESS;
+}
+
+AJAStatus AJAThreadImpl::SetCurrentThreadAffinity(const std::vector<int>& cpus)
+{
+	AJA_UNUSED(cpus);
+	return AJA_STATUS_UNSUPPORTED;
+}
@@ -17,12 +17,23 @@
 	#include <sys/types.h>
 	#include <unistd.h>
 	#include <string.h> //	for strerror
+	#include <stdio.h>
+	#if defined(AJA_LINUX)
+		#include <sys/syscall.h>
+	#endif
 #elif defined(MSWindows)
     #include "ajabase/system/system.h"  //  for Windows API #includes
 #elif defined(AJA_BAREMETAL)
   #include <malloc.h>
 #endif
 #include <iostream>
+#include <map>
+
+#if defined(AJA_LINUX)
+	// from <numaif.h>, defined here so there is no libnuma dependency
+	#define AJA_MPOL_PREFERRED	1
+	#define AJA_MAX_NUMA_NODES	1024
+#endif
 
 // structure to track shared memory allocations
 struct SharedData
@@ -57,6 +68,176 @@ static AJALock sSharedLock;
 // list of allocated shared memory
 static std::list<SharedData> sSharedList;
 
+// structure to track page mapped allocations (huge pages or NUMA placed)
+struct MappedData
+{
+	size_t		length;
+	size_t		pageSize;
+};
+
+// lock for page mapped allocation/free
+static AJALock sMappedLock;
+
+// page mapped allocations by address
+static std::map<void*, MappedData> sMappedMap;
+
+static size_t BasePageSize()
+{
+#if defined(AJA_WINDOWS)
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	return size_t(sysInfo.dwPageSize);
+#elif defined(AJA_BAREMETAL)
+	return 4096;
+#else
+	return size_t(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+#if defined(AJA_LINUX)
+// transparent huge page size, or 0 if transparent huge pages are disabled
+static size_t ReadTHPPageSize()
+{
+	char mode[128] = "";
+	FILE* pFile = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+	if (pFile != NULL)
+	{
+		if (fgets(mode, sizeof(mode), pFile) == NULL)
+			mode[0] = 0;
+		fclose(pFile);
+	}
+	if (strstr(mode, "[never]") != NULL || mode[0] == 0)
+		return 0;
+
+	unsigned long thpSize = 0;
+	pFile = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+	if (pFile != NULL)
+	{
+		if (fscanf(pFile, "%lu", &thpSize) != 1)
+			thpSize = 0;
+		fclose(pFile);
+	}
+	return size_t(thpSize);
+}
+
+// maps anonymous memory of length bytes (a multiple of the page size) aligned to alignment
+static char* MapAnonymous(size_t length, size_t alignment, int extraFlags)
+{
+	const size_t slack = alignment > BasePageSize() ? alignment : 0;
+	char* pBase = (char*)mmap(NULL, length + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+	if (pBase == (char*)MAP_FAILED)
+		return NULL;
+	if (slack)
+	{
+		// trim to the requested alignment
+		char* pAligned = (char*)((uintptr_t(pBase) + alignment - 1) / alignment * alignment);
+		size_t head = size_t(pAligned - pBase);
+		if (head)
+			munmap(pBase, head);
+		if (slack - head)
+			munmap(pAligned + length, slack - head);
+		pBase = pAligned;
+	}
+	return pBase;
+}
+
+static void BindToNUMANode(void* pMemory, size_t length, int numaNode)
+{
+	// prefer the node, the kernel falls back to other nodes when it is full
+	unsigned long nodeMask[AJA_MAX_NUMA_NODES / (8 * sizeof(unsigned long))];
+	memset(nodeMask, 0, sizeof(nodeMask));
+	nodeMask[numaNode / (8 * sizeof(unsigned long))] = 1UL << (numaNode % (8 * sizeof(unsigned long)));
+	if (syscall(SYS_mbind, pMemory, length, AJA_MPOL_PREFERRED, nodeMask, (unsigned long)AJA_MAX_NUMA_NODES, 0) != 0)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory	could not bind to NUMA node %d error=%s", numaNode, strerror(errno));
+	}
+}
+#endif	//	AJA_LINUX
+
+#if defined(AJA_LINUX) || defined(AJA_WINDOWS)
+// maps pages for AllocateHugePages and the NUMA form of AllocateAligned, and records them for FreeAligned
+//	hugePageSize:	0 for ordinary pages, otherwise the requested huge page size
+//	numaNode:		negative for no preference
+static void* MapPages(size_t size, size_t alignment, size_t hugePageSize, int numaNode, size_t* pActualPageSize)
+{
+	size_t basePage = BasePageSize();
+	size_t pageSize = basePage;
+	size_t length = 0;
+	void* pMemory = NULL;
+
+#if defined(AJA_WINDOWS)
+	const DWORD node = numaNode >= 0 ? DWORD(numaNode) : NUMA_NO_PREFERRED_NODE;
+	const size_t largePage = size_t(GetLargePageMinimum());
+
+	// large pages need the "lock pages in memory" privilege, without it fall back to ordinary pages
+	if (hugePageSize > basePage && largePage)
+	{
+		length = (size + largePage - 1) / largePage * largePage;
+		pMemory = VirtualAllocExNuma(GetCurrentProcess(), NULL, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, node);
+		if (pMemory != NULL)
+			pageSize = largePage;
+	}
+	if (pMemory == NULL)
+	{
+		length = (size + basePage - 1) / basePage * basePage;
+		pMemory = VirtualAllocExNuma(GetCurrentProcess(), NULL, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+	}
+	if (pMemory == NULL)
+		return NULL;
+#else
+	if (numaNode >= AJA_MAX_NUMA_NODES)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory	bad NUMA node %d", numaNode);
+		return NULL;
+	}
+
+	if (hugePageSize > basePage)
+	{
+		// reserved hugetlbfs pages of the requested size
+		int sizeShift = 0;
+		while ((size_t(1) << sizeShift) < hugePageSize)
+			sizeShift++;
+		length = (size + hugePageSize - 1) / hugePageSize * hugePageSize;
+		pMemory = MapAnonymous(length, 0, MAP_HUGETLB | (sizeShift << MAP_HUGE_SHIFT));
+		if (pMemory != NULL)
+			pageSize = hugePageSize;
+		else
+		{
+			// none reserved, ask for transparent huge pages -- only a hint, the kernel may still use
+			// base pages (e.g. when memory is fragmented), so the base page size is reported
+			size_t thpSize = ReadTHPPageSize();
+			if (thpSize > basePage)
+			{
+				length = (size + thpSize - 1) / thpSize * thpSize;
+				pMemory = MapAnonymous(length, thpSize, 0);
+				if (pMemory != NULL && madvise(pMemory, length, MADV_HUGEPAGE) != 0)
+					AJA_REPORT(0, AJA_DebugSeverity_Warning, "AJAMemory	transparent huge pages unavailable error=%s", strerror(errno));
+			}
+		}
+	}
+	if (pMemory == NULL)
+	{
+		length = (size + basePage - 1) / basePage * basePage;
+		pMemory = MapAnonymous(length, alignment, 0);
+	}
+	if (pMemory == NULL)
+		return NULL;
+
+	if (numaNode >= 0)
+		BindToNUMANode(pMemory, length, numaNode);
+#endif
+
+	if (pActualPageSize)
+		*pActualPageSize = pageSize;
+
+	AJAAutoLock lock(&sMappedLock);
+	MappedData& data = sMappedMap[pMemory];
+	data.length = length;
+	data.pageSize = pageSize;
+	return pMemory;
+}
+#endif
+
 AJAMemory::AJAMemory()
 {
 }
@@ -141,6 +322,115 @@ AJAMemory::AllocateAligned(size_t size, size_t alignment)
 }
 
 
+void* 
+AJAMemory::AllocateAligned(size_t size, size_t alignment, int numaNode)
+{
+	if (numaNode < 0)
+		return AllocateAligned(size, alignment);
+
+	if (size == 0)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateAligned	size is 0");
+		return NULL;
+	}
+
+#if defined(AJA_WINDOWS)
+	// VirtualAlloc regions are aligned to the allocation granularity (64KB)
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	if (alignment > sysInfo.dwAllocationGranularity)
+		return AllocateAligned(size, alignment);
+#endif
+
+#if defined(AJA_LINUX) || defined(AJA_WINDOWS)
+	void* pMemory = MapPages(size, alignment, 0, numaNode, NULL);
+	if (pMemory == NULL)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateAligned	allocation failed size=%d alignment=%d node=%d", (int)size, (int)alignment, numaNode);
+	}
+	return pMemory;
+#else
+	// no NUMA placement on this platform
+	return AllocateAligned(size, alignment);
+#endif
+}
+
+
+void* 
+AJAMemory::AllocateHugePages(size_t size, size_t pageSize, int numaNode, size_t* pActualPageSize)
+{
+	if (pActualPageSize)
+		*pActualPageSize = 0;
+
+	if (size == 0)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateHugePages	size is 0");
+		return NULL;
+	}
+	if (pageSize & (pageSize - 1))
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateHugePages	page size %d is not a power of 2", (int)pageSize);
+		return NULL;
+	}
+	if (pageSize == 0)
+		pageSize = GetHugePageSize();
+
+#if defined(AJA_LINUX) || defined(AJA_WINDOWS)
+	void* pMemory = MapPages(size, 0, pageSize, numaNode, pActualPageSize);
+#else
+	// no huge pages on this platform, fall back to ordinary pages
+	void* pMemory = AllocateAligned(size, BasePageSize());
+	if (pMemory && pActualPageSize)
+		*pActualPageSize = BasePageSize();
+#endif
+	if (pMemory == NULL)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAMemory::AllocateHugePages	allocation failed size=%d page size=%d node=%d", (int)size, (int)pageSize, numaNode);
+	}
+	return pMemory;
+}
+
+
+size_t 
+AJAMemory::GetPageSize(const void* pMemory)
+{
+	if (pMemory != NULL)
+	{
+		AJAAutoLock lock(&sMappedLock);
+		std::map<void*, MappedData>::const_iterator mapIter = sMappedMap.find(const_cast<void*>(pMemory));
+		if (mapIter != sMappedMap.end())
+			return mapIter->second.pageSize;
+	}
+	return BasePageSize();
+}
+
+
+size_t 
+AJAMemory::GetHugePageSize()
+{
+#if defined(AJA_WINDOWS)
+	return size_t(GetLargePageMinimum());
+#elif defined(AJA_LINUX)
+	// the default hugetlbfs page size, e.g. "Hugepagesize:	2048 kB"
+	FILE* pFile = fopen("/proc/meminfo", "r");
+	if (pFile != NULL)
+	{
+		char line[256];
+		unsigned long kiloBytes = 0;
+		while (fgets(line, sizeof(line), pFile) != NULL)
+			if (sscanf(line, "Hugepagesize: %lu kB", &kiloBytes) == 1)
+				break;
+		fclose(pFile);
+		if (kiloBytes)
+			return size_t(kiloBytes) * 1024;
+	}
+	return ReadTHPPageSize();
+#else
+	return 0;
+#endif
+}
+
+
 void 
 AJAMemory::FreeAligned(void* pMemory)
 {
@@ -155,6 +445,22 @@ AJAMemory::FreeAligned(void* pMemory)
 		return;
 	}
 
+	// memory mapped by AllocateHugePages or the NUMA form of AllocateAligned is unmapped
+	{
+		AJAAutoLock lock(&sMappedLock);
+		std::map<void*, MappedData>::iterator mapIter = sMappedMap.find(pMemory);
+		if (mapIter != sMappedMap.end())
+		{
+#if defined(AJA_WINDOWS)
+			VirtualFree(pMemory, 0, MEM_RELEASE);
+#elif defined(AJA_LINUX)
+			munmap(pMemory, mapIter->second.length);
+#endif
+			sMappedMap.erase(mapIter);
+			return;
+		}
+	}
+
 	// free aligned memory
 #if defined(AJA_WINDOWS)
 	_aligned_free(pMemory);
@@ -46,7 +46,59 @@ public:
 	static void* AllocateAligned(size_t size, size_t alignment);
 
 	/**
-	 *	Free memory allocated using AllocateAligned().
+	 *	Allocate memory aligned to alignment bytes, backed by pages on a NUMA node.
+	 *
+	 *	Use with AJAThread::SetNUMANode and CNTV2Card::GetNUMANode to keep capture buffers on the
+	 *	node the card is attached to.  The node is a preference: if it has no free memory the
+	 *	pages come from another node.  Where NUMA placement is not supported this is the same
+	 *	as AllocateAligned(size, alignment).
+	 *
+	 *	@param[in]	size		Bytes of memory to allocate.
+	 *	@param[in]	alignment	Alignment of allocated memory in bytes.
+	 *	@param[in]	numaNode	NUMA node to allocate from.  A negative number means no preference.
+	 *	@return					Address of allocated memory.  NULL if allocation fails.
+	 */
+	static void* AllocateAligned(size_t size, size_t alignment, int numaNode);
+
+	/**
+	 *	Allocate memory backed by huge pages.
+	 *
+	 *	Large DMA buffers backed by huge pages need far fewer page table entries, which makes
+	 *	locking them for DMA and walking them with the CPU cheaper.  On Linux reserved hugetlbfs
+	 *	pages of the requested size are used (see /proc/sys/vm/nr_hugepages); if none are free
+	 *	the memory is marked for transparent huge pages, and failing that ordinary pages are used.
+	 *	The kernel is free to back transparent huge page memory with ordinary pages, so it is
+	 *	reported as having the system page size (it is still aligned to the huge page size).
+	 *	On Windows large pages need the "Lock pages in memory" privilege.  The size is rounded up
+	 *	to a whole number of pages, and the memory is aligned to the page size obtained.
+	 *
+	 *	@param[in]	size			Bytes of memory to allocate.
+	 *	@param[in]	pageSize		Requested page size in bytes (e.g. 2MB or 1GB), a power of 2.  Zero
+	 *								requests the system default huge page size (see GetHugePageSize).
+	 *	@param[in]	numaNode		NUMA node to allocate from.  A negative number means no preference.
+	 *	@param[out]	pActualPageSize	If not NULL, receives the page size actually obtained.
+	 *	@return						Address of allocated memory.  NULL if allocation fails.  Free with FreeAligned().
+	 */
+	static void* AllocateHugePages(size_t size, size_t pageSize = 0, int numaNode = -1, size_t* pActualPageSize = NULL);
+
+	/**
+	 *	Get the size of the pages backing memory allocated by this class.
+	 *
+	 *	@param[in]	pMemory		Address returned by AllocateHugePages() or AllocateAligned().
+	 *	@return					Page size in bytes.  The system page size for memory not mapped by
+	 *							AllocateHugePages() or the NUMA form of AllocateAligned().
+	 */
+	static size_t GetPageSize(const void* pMemory);
+
+	/**
+	 *	Get the system default huge page size.
+	 *
+	 *	@return					Huge page size in bytes.  Zero if huge pages are not available.
+	 */
+	static size_t GetHugePageSize();
+
+	/**
+	 *	Free memory allocated using either form of AllocateAligned() or AllocateHugePages().
 	 *
 	 *	@param[in]	pMemory		Address of memory to free.
 	 */
@@ -9,9 +9,10 @@
 #include "ajabase/common/common.h"
 #include "ajabase/system/systemtime.h"
 #include "ajabase/common/types.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/lock.h"
 #if defined(AJA_COLLECT_SLEEP_STATS)
 	#include "ajabase/common/timer.h"
-	#include "ajabase/system/atomic.h"
 	#include "ajabase/system/thread.h"
 	#include <sstream>
 #endif	//	defined(AJA_COLLECT_SLEEP_STATS)
@@ -248,6 +249,295 @@ uint64_t AJATime::GetSystemNanoseconds (void)
 }
 
 
+//	The fast clock reads the TSC directly where the OS trusts it, otherwise the OS's raw monotonic clock
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))  &&  (defined(AJA_LINUX) || defined(AJA_WINDOWS))
+	#define	AJA_FASTCLOCK_TSC
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+		#include <cpuid.h>
+	#endif
+	#if defined(AJA_LINUX)
+		#include <fstream>
+	#endif
+#endif
+#if defined(AJA_LINUX) && defined(AJA_USE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC_RAW)
+	#define	AJA_FASTCLOCK_MONOTONIC_RAW
+#endif
+
+//	Conversion parameters. Recalibration fills the next set and then publishes its index, so a
+//	reader never sees a half-written set.
+typedef struct FastClockParams
+{
+	uint64_t	frequency;			//	Counter ticks per second
+	uint64_t	baseTicks;			//	Counter value at baseNanoseconds
+	uint64_t	baseNanoseconds;
+	uint32_t	mult;				//	nanoseconds = ticks * mult >> shift
+	uint32_t	shift;
+	int64_t		frameStampOffset;	//	Driver time minus fast clock time, in nanoseconds
+} FastClockParams;
+
+static const uint32_t		kNumFastClockParams	= 4;
+static FastClockParams		sFastClockParams[kNumFastClockParams];
+static volatile uint32_t	sFastClockIndex		= 0;
+static volatile uint32_t	sFastClockInit		= 0;
+static bool					sFastClockTSC		= false;
+static AJALock				sFastClockLock;
+
+
+static inline uint64_t ReadOSCounter (void)
+{
+#if defined(AJA_FASTCLOCK_MONOTONIC_RAW)
+	//	Not slewed by NTP, so it measures the TSC frequency without adjustment skew
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+#else
+	return uint64_t(AJATime::GetSystemCounter());
+#endif
+}
+
+
+static uint64_t OSCounterFrequency (void)
+{
+#if defined(AJA_FASTCLOCK_MONOTONIC_RAW)
+	return 1000000000ULL;
+#else
+	return uint64_t(AJATime::GetSystemFrequency());
+#endif
+}
+
+
+static inline uint64_t ReadFastCounter (void)
+{
+#if defined(AJA_FASTCLOCK_TSC)
+	if (sFastClockTSC)
+		return __rdtsc();
+#endif
+	return ReadOSCounter();
+}
+
+
+//	Returns the current driver (FRAME_STAMP) time, in nanoseconds
+static int64_t ReadDriverNanoseconds (void)
+{
+#if defined(AJA_LINUX) && defined(AJA_USE_CLOCK_GETTIME)
+	//	The Linux driver uses the wall clock
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return int64_t(ts.tv_sec) * 1000000000LL + int64_t(ts.tv_nsec);
+#elif defined(AJA_WINDOWS)
+	//	The Windows driver uses the performance counter
+	return int64_t(util_mul_div64(uint64_t(AJATime::GetSystemCounter()), 1000000000ULL, uint64_t(AJATime::GetSystemFrequency())));
+#else
+	//	The Mac driver uses mach_absolute_time
+	return int64_t(AJATime::GetSystemNanoseconds());
+#endif
+}
+
+
+static bool FastCounterIsTSC (void)
+{
+#if defined(AJA_FASTCLOCK_TSC)
+	//	CPUID 80000007h EDX bit 8:  invariant TSC (constant rate, runs in all C-states)
+	uint32_t edx(0);
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, int(0x80000000));
+		if (uint32_t(info[0]) < 0x80000007)
+			return false;
+		__cpuid(info, int(0x80000007));
+		edx = uint32_t(info[3]);
+	#else
+		unsigned int eax(0), ebx(0), ecx(0), edxReg(0);
+		if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edxReg))
+			return false;
+		edx = edxReg;
+	#endif
+	if (!(edx & 0x100))
+		return false;
+	#if defined(AJA_LINUX)
+		//	The kernel stops using the TSC if it finds it unsynchronized across sockets, or unstable under a hypervisor
+		std::ifstream ifs("/sys/devices/system/clocksource/clocksource0/current_clocksource");
+		std::string clockSource;
+		ifs >> clockSource;
+		return clockSource == "tsc";
+	#else
+		return true;
+	#endif
+#else
+	return false;
+#endif
+}
+
+
+//	Reads the fast counter and the OS counter (or driver time) as close together as possible
+static void ReadCounterPair (uint64_t & outTicks, int64_t & outOther, const bool inDriverTime)
+{
+	int64_t bestSpan(-1);
+	for (int tries(0);  tries < 5;  tries++)
+	{
+		const uint64_t	before	(ReadFastCounter());
+		const int64_t	other	(inDriverTime ? ReadDriverNanoseconds() : int64_t(ReadOSCounter()));
+		const uint64_t	after	(ReadFastCounter());
+		const int64_t	span	(int64_t(after - before));
+		if (bestSpan < 0  ||  span < bestSpan)
+		{
+			bestSpan = span;
+			outTicks = before + (after - before) / 2;
+			outOther = other;
+		}
+	}
+}
+
+
+//	Splits the ticks so the 32 x 32 bit products can't overflow
+static inline uint64_t ScaleFastTicks (const uint64_t inTicks, const FastClockParams & inParams)
+{
+	const uint64_t hi ((inTicks >> 32) * inParams.mult);
+	const uint64_t lo ((inTicks & 0xFFFFFFFFULL) * inParams.mult);
+	return (hi << (32 - inParams.shift)) + (lo >> inParams.shift);
+}
+
+
+static inline uint64_t ScaleFastCounter (const uint64_t inTicks, const FastClockParams & inParams)
+{
+	if (inTicks >= inParams.baseTicks)
+		return inParams.baseNanoseconds + ScaleFastTicks(inTicks - inParams.baseTicks, inParams);
+	const uint64_t back (ScaleFastTicks(inParams.baseTicks - inTicks, inParams));
+	return back < inParams.baseNanoseconds  ?  inParams.baseNanoseconds - back  :  0;
+}
+
+
+static void InitFastClock (void)
+{
+	AJAAutoLock lock(&sFastClockLock);
+	if (!sFastClockInit)
+		AJATime::CalibrateFastClock();
+}
+
+
+static inline const FastClockParams & CurrentFastClockParams (void)
+{
+	if (!sFastClockInit)
+		InitFastClock();
+	return sFastClockParams[sFastClockIndex % kNumFastClockParams];
+}
+
+
+bool AJATime::CalibrateFastClock (const uint32_t inMilliseconds)
+{
+	AJAAutoLock lock(&sFastClockLock);
+	const bool firstTime (!sFastClockInit);
+	if (firstTime)
+		sFastClockTSC = FastCounterIsTSC();
+
+	FastClockParams params;
+	params.frequency = OSCounterFrequency();
+#if defined(AJA_FASTCLOCK_TSC)
+	if (sFastClockTSC)
+	{
+		uint64_t	startTicks(0), endTicks(0);
+		int64_t		startOS(0), endOS(0);
+		const uint32_t milliseconds (inMilliseconds ? inMilliseconds : 1);
+		ReadCounterPair(startTicks, startOS, false);
+		//	Not AJATime::Sleep, so calibration doesn't show up in its AJA_COLLECT_SLEEP_STATS statistics
+		#if defined(AJA_WINDOWS)
+			::Sleep(DWORD(milliseconds));
+		#else
+			usleep(useconds_t(milliseconds) * 1000);
+		#endif
+		ReadCounterPair(endTicks, endOS, false);
+		if (endOS > startOS  &&  endTicks > startTicks)
+			params.frequency = uint64_t(double(endTicks - startTicks) * double(params.frequency) / double(endOS - startOS) + 0.5);
+		else if (firstTime)
+			sFastClockTSC = false;	//	Fall back to the OS clock
+		else
+			return false;
+	}
+#else
+	AJA_UNUSED(inMilliseconds);
+#endif
+	if (!params.frequency)
+		return false;
+
+	//	The largest shift that keeps the multiplier in 32 bits gives the most precision
+	params.shift = 32;
+	while (params.shift  &&  ((1000000000ULL << params.shift) / params.frequency) > 0xFFFFFFFFULL)
+		params.shift--;
+	params.mult = uint32_t((1000000000ULL << params.shift) / params.frequency);
+
+	//	Stay continuous with the previous calibration
+	uint64_t	ticks(0);
+	int64_t		driverNanoseconds(0);
+	ReadCounterPair(ticks, driverNanoseconds, true);
+	params.baseTicks = ticks;
+	if (firstTime)
+	{
+		const uint64_t osTicks (ReadOSCounter());
+		const uint64_t osFrequency (OSCounterFrequency());
+		params.baseNanoseconds = uint64_t(double(osTicks) / double(osFrequency) * 1000000000.0);
+	}
+	else
+		params.baseNanoseconds = ScaleFastCounter(ticks, sFastClockParams[sFastClockIndex % kNumFastClockParams]);
+	params.frameStampOffset = driverNanoseconds - int64_t(params.baseNanoseconds);
+
+	const uint32_t next (firstTime  ?  sFastClockIndex  :  sFastClockIndex + 1);
+	sFastClockParams[next % kNumFastClockParams] = params;
+	AJAAtomic::Exchange(&sFastClockIndex, next);
+	AJAAtomic::Exchange(&sFastClockInit, 1);
+	return true;
+}
+
+
+uint64_t AJATime::GetFastCounter (void)
+{
+	if (!sFastClockInit)
+		InitFastClock();
+	return ReadFastCounter();
+}
+
+
+uint64_t AJATime::GetFastFrequency (void)
+{
+	return CurrentFastClockParams().frequency;
+}
+
+
+uint64_t AJATime::GetFastNanoseconds (void)
+{
+	const FastClockParams & params (CurrentFastClockParams());
+	return ScaleFastCounter(ReadFastCounter(), params);
+}
+
+
+uint64_t AJATime::FastCounterToNanoseconds (const uint64_t inTicks)
+{
+	return ScaleFastCounter(inTicks, CurrentFastClockParams());
+}
+
+
+bool AJATime::IsFastCounterTSC (void)
+{
+	CurrentFastClockParams();
+	return sFastClockTSC;
+}
+
+
+int64_t AJATime::FastNanosecondsToFrameStampTime (const uint64_t inNanoseconds)
+{
+	return (int64_t(inNanoseconds) + CurrentFastClockParams().frameStampOffset) / 100;
+}
+
+
+uint64_t AJATime::FrameStampTimeToFastNanoseconds (const int64_t inFrameStampTime)
+{
+	const int64_t nanoseconds (inFrameStampTime * 100 - CurrentFastClockParams().frameStampOffset);
+	return nanoseconds > 0  ?  uint64_t(nanoseconds)  :  0;
+}
+
+
 #if defined(AJA_COLLECT_SLEEP_STATS)
 	static uint64_t		sMonThreadID	= 0;//   1    2    3    4    5    6    7     8     9     10     11     12     13      14      15      16
 	static const double	sPercentiles[]	= {	1.0, 1.1, 1.2, 1.5, 2.0, 3.0, 6.0, 11.0, 21.0, 51.0, 101.0, 201.0, 501.0, 1001.0, 2001.0, 5001.0, 10001.0};
@@ -74,6 +74,71 @@
 		**/
 		static uint64_t GetSystemNanoseconds (void);
 
+		/**
+			@brief		Returns the current value of the host's fast counter. This is the CPU time stamp counter
+						where it's invariant and the OS uses it for its own clock, otherwise the OS's raw
+						monotonic clock. Reading it takes a few nanoseconds, so it's suitable for timing
+						per-frame and per-DMA work.
+			@return		The current value of the fast counter, in ticks of GetFastFrequency().
+			@note		The fast clock is opt-in:  AJATimer and the GetSystem... functions don't use it. The first
+						use of the fast clock calibrates it, which blocks for about 10 milliseconds. To avoid that
+						stall in a time-critical thread, call CalibrateFastClock during setup.
+			@note		New in SDK 17.5.
+		**/
+		static uint64_t	GetFastCounter (void);
+
+		/**
+			@brief		Returns the frequency of the fast counter, calibrating it on first use (see CalibrateFastClock).
+			@return		The fast counter frequency in ticks per second.
+		**/
+		static uint64_t	GetFastFrequency (void);
+
+		/**
+			@brief		Returns the current value of the fast clock, in nanoseconds.
+			@return		Current value of the fast clock, in nanoseconds since an arbitrary start point.
+		**/
+		static uint64_t	GetFastNanoseconds (void);
+
+		/**
+			@brief		Converts a GetFastCounter() value into GetFastNanoseconds() time. Uses a fixed-point
+						multiply and shift, so it's cheap enough to convert every timestamp.
+			@param[in]	inTicks		A value returned from GetFastCounter().
+			@return		The equivalent GetFastNanoseconds() time.
+		**/
+		static uint64_t	FastCounterToNanoseconds (const uint64_t inTicks);
+
+		/**
+			@return		True if the fast counter is the CPU time stamp counter;  false if it's an OS clock.
+		**/
+		static bool		IsFastCounterTSC (void);
+
+		/**
+			@brief		Converts a GetFastNanoseconds() time into the time base the driver uses for FRAME_STAMP
+						and other timestamps (100 ns units).
+			@param[in]	inNanoseconds	A GetFastNanoseconds() time.
+			@return		The equivalent driver time, in 100 ns units.
+			@note		On Linux the driver time base is the wall clock (CLOCK_REALTIME), which can be stepped
+						by NTP or an administrator. Call CalibrateFastClock to pick up such changes.
+		**/
+		static int64_t	FastNanosecondsToFrameStampTime (const uint64_t inNanoseconds);
+
+		/**
+			@brief		Converts a driver FRAME_STAMP time (100 ns units) into GetFastNanoseconds() time.
+			@param[in]	inFrameStampTime	A driver timestamp, e.g. FRAME_STAMP::acFrameTime.
+			@return		The equivalent GetFastNanoseconds() time.
+		**/
+		static uint64_t	FrameStampTimeToFastNanoseconds (const int64_t inFrameStampTime);
+
+		/**
+			@brief		Measures the fast counter frequency against the OS clock, and the offset between the
+						fast clock and the driver time base. Happens automatically on first use of the fast clock.
+						GetFastNanoseconds() stays continuous across calls.
+			@param[in]	inMilliseconds	Specifies how long to measure the frequency, in milliseconds.
+										Longer is more accurate. Ignored if the fast counter isn't the TSC.
+			@return		True if successful;  otherwise false.
+		**/
+		static bool		CalibrateFastClock (const uint32_t inMilliseconds = 10);
+
 		/**
 			@brief		Suspends execution of the current thread for a given number of milliseconds.
 			@param		inMilliseconds		Specifies the sleep time, in milliseconds.
@@ -156,6 +156,40 @@ AJAThread::SetRealTime(AJAThreadRealTimePolicy policy, int priority)
 }
 
 
+AJAStatus
+AJAThread::SetAffinity(const std::vector<int>& cpus)
+{
+	if(mpImpl)
+		return mpImpl->SetAffinity(cpus);
+	return AJA_STATUS_FAIL;
+}
+
+
+AJAStatus
+AJAThread::GetAffinity(std::vector<int>& cpus)
+{
+	if(mpImpl)
+		return mpImpl->GetAffinity(cpus);
+	return AJA_STATUS_FAIL;
+}
+
+
+AJAStatus
+AJAThread::SetNUMANode(int node)
+{
+	std::vector<int> cpus;
+	if (node >= 0)
+	{
+		AJAStatus status = GetNUMANodeCPUs(node, cpus);
+		if (status != AJA_STATUS_SUCCESS)
+			return status;
+		if (cpus.empty())
+			return AJA_STATUS_RANGE;
+	}
+	return SetAffinity(cpus);
+}
+
+
 bool 
 AJAThread::Terminate()
 {
@@ -181,3 +215,19 @@ uint64_t AJAThread::GetThreadId()
 {
 	return AJAThreadImpl::GetThreadId();
 }
+
+int AJAThread::GetNUMANodeCount()
+{
+	return AJAThreadImpl::GetNUMANodeCount();
+}
+
+AJAStatus AJAThread::GetNUMANodeCPUs(int node, std::vector<int>& cpus)
+{
+	cpus.clear();
+	return AJAThreadImpl::GetNUMANodeCPUs(node, cpus);
+}
+
+AJAStatus AJAThread::SetCurrentThreadAffinity(const std::vector<int>& cpus)
+{
+	return AJAThreadImpl::SetCurrentThreadAffinity(cpus);
+}
@@ -9,6 +9,7 @@
 #define AJA_THREAD_H
 
 #include "ajabase/common/public.h"
+#include <vector>
 
 // forward declarations
 class AJAThread;
@@ -146,6 +147,46 @@ public:
 	 */
 	virtual AJAStatus SetRealTime(AJAThreadRealTimePolicy policy, int priority);
 
+	/**
+	 *	Restrict the thread to a set of logical CPUs.
+	 *
+	 *	May be called before or after Start().  If the thread is not running the affinity is
+	 *	remembered and applied when it starts.
+	 *
+	 *	@param[in]	cpus					Logical CPU numbers the thread may run on.  An empty list
+	 *										removes the restriction.
+	 *	@return		AJA_STATUS_SUCCESS		Affinity set
+	 *				AJA_STATUS_RANGE		A CPU number is out of range
+	 *				AJA_STATUS_UNSUPPORTED	Affinity is not supported on this platform
+	 *				AJA_STATUS_FAIL			Affinity not set
+	 */
+	virtual AJAStatus SetAffinity(const std::vector<int>& cpus);
+
+	/**
+	 *	Get the logical CPUs the thread is restricted to.
+	 *
+	 *	@param[out]	cpus					Receives the CPU numbers.  Empty if the thread is unrestricted
+	 *										and not yet running.
+	 *	@return		AJA_STATUS_SUCCESS		Affinity returned
+	 *				AJA_STATUS_UNSUPPORTED	Affinity is not supported on this platform
+	 *				AJA_STATUS_FAIL			Affinity could not be read
+	 */
+	virtual AJAStatus GetAffinity(std::vector<int>& cpus);
+
+	/**
+	 *	Restrict the thread to the CPUs of a NUMA node.
+	 *
+	 *	Typically used to keep a capture or playout thread on the node the card is attached to
+	 *	(see CNTV2Card::GetNUMANode).
+	 *
+	 *	@param[in]	node					NUMA node number.  A negative number removes the restriction.
+	 *	@return		AJA_STATUS_SUCCESS		Affinity set
+	 *				AJA_STATUS_RANGE		No such node
+	 *				AJA_STATUS_UNSUPPORTED	Affinity is not supported on this platform
+	 *				AJA_STATUS_FAIL			Affinity not set
+	 */
+	virtual AJAStatus SetNUMANode(int node);
+
 	/**
 	 *	Controlling function for the new thread.
 	 *
@@ -227,6 +268,37 @@ public:
 	 */
 	static uint64_t GetThreadId();
 
+	/**
+	 *	Get the number of NUMA nodes in the system.
+	 *
+	 *	@return The number of nodes; 1 on non-NUMA systems and on platforms that do not report nodes.
+	 */
+	static int GetNUMANodeCount();
+
+	/**
+	 *	Get the logical CPUs that belong to a NUMA node.
+	 *
+	 *	@param[in]	node					NUMA node number.
+	 *	@param[out]	cpus					Receives the node's CPU numbers, in ascending order.
+	 *	@return		AJA_STATUS_SUCCESS		CPUs returned
+	 *				AJA_STATUS_RANGE		No such node
+	 *				AJA_STATUS_UNSUPPORTED	Topology is not available on this platform
+	 */
+	static AJAStatus GetNUMANodeCPUs(int node, std::vector<int>& cpus);
+
+	/**
+	 *	Restrict the calling thread to a set of logical CPUs.
+	 *
+	 *	Useful for threads not created by AJAThread (e.g. the main thread).
+	 *
+	 *	@param[in]	cpus					Logical CPU numbers.  An empty list removes the restriction.
+	 *	@return		AJA_STATUS_SUCCESS		Affinity set
+	 *				AJA_STATUS_RANGE		A CPU number is out of range
+	 *				AJA_STATUS_UNSUPPORTED	Affinity is not supported on this platform
+	 *				AJA_STATUS_FAIL			Affinity not set
+	 */
+	static AJAStatus SetCurrentThreadAffinity(const std::vector<int>& cpus);
+
 private:
 
 	AJAThreadImpl* mpImpl;
@@ -0,0 +1,394 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		threadpool.cpp
+	@brief		Implements the AJAThreadPool class.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+#include "ajabase/system/threadpool.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/systemtime.h"
+#include "ajabase/system/thread.h"
+#include <deque>
+#if defined(AJA_WINDOWS)
+	#include "ajabase/system/system.h"	//	for GetSystemInfo
+#elif defined(AJA_LINUX) || defined(AJA_MAC)
+	#include <unistd.h>					//	for sysconf
+#endif
+
+// how long an idle worker sleeps before looking for work again (a safety net, workers are signaled)
+static const uint32_t kIdleWaitMs = 100;
+
+// how many times a waiting thread yields before it starts to sleep between polls
+static const uint32_t kWaitSpinCount = 64;
+static const int32_t  kWaitSleepUs = 20;
+
+// the shared pool
+static AJALock			sDefaultLock;
+static AJAThreadPool*	spDefaultPool = NULL;
+
+
+// worker thread with its own task deque
+class AJAThreadPoolWorker : public AJAThread
+{
+public:
+	AJAThreadPoolWorker(AJAThreadPool* pPool, int index)
+		:	mpPool(pPool), mIndex(index), mWake(false), mQuit(false), mThreadId(0)
+	{
+	}
+
+	virtual AJAStatus ThreadRun()
+	{
+		mThreadId = GetThreadId();
+		mpPool->mStarted.WaitForSignal();
+		while (!mQuit && !Terminate())
+		{
+			AJAThreadPool::Task task;
+			if (mpPool->FindTask(mIndex, task))
+				mpPool->RunTask(task);
+			else
+				mWake.WaitForSignal(kIdleWaitMs);
+		}
+		return AJA_STATUS_SUCCESS;
+	}
+
+	AJAThreadPool*					mpPool;
+	int								mIndex;
+	AJALock							mQueueLock;
+	std::deque<AJAThreadPool::Task>	mQueue;		// owner works at the back, thieves take from the front
+	AJAEvent						mWake;		// auto reset
+	volatile bool					mQuit;
+	volatile uint64_t				mThreadId;
+};
+
+
+AJAThreadPoolGroup::AJAThreadPoolGroup()
+	:	mPending(0)
+{
+}
+
+
+bool
+AJAThreadPoolGroup::Done() const
+{
+	return mPending == 0;
+}
+
+
+AJAThreadPool::AJAThreadPool(uint32_t numThreads)
+	:	mNextWorker(0)
+{
+	if (numThreads == 0)
+		numThreads = GetCPUCount();
+
+	for (uint32_t ndx = 0; ndx < numThreads; ndx++)
+	{
+		AJAThreadPoolWorker* pWorker = new AJAThreadPoolWorker(this, int(mWorkers.size()));
+		if (AJA_FAILURE(pWorker->Start()))
+		{
+			AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThreadPool(%p) could not start worker %d", this, int(ndx));
+			delete pWorker;
+			break;
+		}
+		mWorkers.push_back(pWorker);
+	}
+	mStarted.Signal();
+}
+
+
+AJAThreadPool::~AJAThreadPool()
+{
+	for (size_t ndx = 0; ndx < mWorkers.size(); ndx++)
+	{
+		mWorkers[ndx]->mQuit = true;
+		mWorkers[ndx]->mWake.Signal();
+	}
+	for (size_t ndx = 0; ndx < mWorkers.size(); ndx++)
+		mWorkers[ndx]->Stop();
+
+	// run anything still queued so no group is left waiting
+	Task task;
+	while (FindTask(-1, task))
+		RunTask(task);
+
+	for (size_t ndx = 0; ndx < mWorkers.size(); ndx++)
+		delete mWorkers[ndx];
+	mWorkers.clear();
+}
+
+
+uint32_t
+AJAThreadPool::GetThreadCount() const
+{
+	return uint32_t(mWorkers.size());
+}
+
+
+AJAStatus
+AJAThreadPool::SetAffinity(const std::vector<int>& cpus)
+{
+	AJAAutoLock lock(&mAffinityLock);
+
+	AJAStatus result = AJA_STATUS_SUCCESS;
+	for (size_t ndx = 0; ndx < mWorkers.size(); ndx++)
+	{
+		std::vector<int> workerCPUs;
+		if (!cpus.empty())
+			workerCPUs.push_back(cpus[ndx % cpus.size()]);
+		AJAStatus status = mWorkers[ndx]->SetAffinity(workerCPUs);
+		if (AJA_FAILURE(status) && AJA_SUCCESS(result))
+			result = status;
+	}
+	return result;
+}
+
+
+AJAStatus
+AJAThreadPool::SetNUMANode(int node)
+{
+	std::vector<int> cpus;
+	if (node >= 0)
+	{
+		AJAStatus status = AJAThread::GetNUMANodeCPUs(node, cpus);
+		if (AJA_FAILURE(status))
+			return status;
+		if (cpus.empty())
+			return AJA_STATUS_RANGE;
+	}
+	return SetAffinity(cpus);
+}
+
+
+AJAStatus
+AJAThreadPool::Submit(AJAThreadPoolTask* pTask, void* pContext, AJAThreadPoolGroup* pGroup)
+{
+	if (pTask == NULL)
+		return AJA_STATUS_NULL;
+
+	Task task;
+	task.pTask = pTask;
+	task.pRangeTask = NULL;
+	task.pContext = pContext;
+	task.first = 0;
+	task.last = 0;
+	task.pGroup = pGroup;
+	if (pGroup != NULL)
+		AJAAtomic::Increment(&pGroup->mPending);
+
+	if (mWorkers.empty())
+		RunTask(task);
+	else
+		Push(&task, 1);
+	return AJA_STATUS_SUCCESS;
+}
+
+
+AJAStatus
+AJAThreadPool::Wait(AJAThreadPoolGroup& group)
+{
+	const int self = CurrentWorker();
+	uint32_t idle = 0;
+	while (!group.Done())
+	{
+		Task task;
+		if (FindTask(self, task))
+		{
+			RunTask(task);
+			idle = 0;
+		}
+		else if (++idle < kWaitSpinCount)
+			AJATime::Sleep(0);
+		else
+			AJATime::SleepInMicroseconds(kWaitSleepUs);
+	}
+
+	// full barrier so the caller sees everything the tasks wrote
+	AJAAtomic::Exchange(&group.mPending, 0);
+	return AJA_STATUS_SUCCESS;
+}
+
+
+AJAStatus
+AJAThreadPool::ParallelFor(uint32_t first, uint32_t last, AJAThreadPoolRangeTask* pTask, void* pContext, uint32_t grain)
+{
+	if (pTask == NULL)
+		return AJA_STATUS_NULL;
+	if (last <= first)
+		return AJA_STATUS_SUCCESS;
+
+	const uint32_t count = last - first;
+	if (grain == 0)
+	{
+		grain = count / ((GetThreadCount() + 1) * 4);
+		if (grain == 0)
+			grain = 1;
+	}
+	if (mWorkers.empty() || count <= grain)
+	{
+		(*pTask)(first, last, pContext);
+		return AJA_STATUS_SUCCESS;
+	}
+
+	// queue every chunk but the first, which this thread runs before it helps with the rest
+	AJAThreadPoolGroup group;
+	std::vector<Task> tasks;
+	tasks.reserve((count - 1) / grain);
+	for (uint32_t chunk = first + grain; chunk < last; )
+	{
+		Task task;
+		task.pTask = NULL;
+		task.pRangeTask = pTask;
+		task.pContext = pContext;
+		task.first = chunk;
+		task.last = last - chunk > grain ? chunk + grain : last;
+		task.pGroup = &group;
+		tasks.push_back(task);
+		chunk = task.last;
+	}
+	group.mPending = int32_t(tasks.size());
+	Push(&tasks[0], tasks.size());
+
+	try
+	{
+		(*pTask)(first, first + grain, pContext);
+	}
+	catch (...)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThreadPool(%p)::ParallelFor exception in task", this);
+	}
+	return Wait(group);
+}
+
+
+AJAThreadPool&
+AJAThreadPool::GetDefault()
+{
+	AJAAutoLock lock(&sDefaultLock);
+	if (spDefaultPool == NULL)
+		spDefaultPool = new AJAThreadPool();	// never deleted, SDK routines may use it during static destruction
+	return *spDefaultPool;
+}
+
+
+uint32_t
+AJAThreadPool::GetCPUCount()
+{
+#if defined(AJA_WINDOWS)
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	const long numCPUs = long(sysInfo.dwNumberOfProcessors);
+#elif defined(AJA_LINUX) || defined(AJA_MAC)
+	const long numCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+	const long numCPUs = 1;
+#endif
+	return numCPUs < 1 ? 1 : uint32_t(numCPUs);
+}
+
+
+int
+AJAThreadPool::CurrentWorker() const
+{
+	const uint64_t threadId = AJAThread::GetThreadId();
+	for (size_t ndx = 0; ndx < mWorkers.size(); ndx++)
+		if (mWorkers[ndx]->mThreadId == threadId)
+			return int(ndx);
+	return -1;
+}
+
+
+void
+AJAThreadPool::Push(const Task* pTasks, size_t numTasks)
+{
+	const size_t numWorkers = mWorkers.size();
+	const int self = CurrentWorker();
+	size_t numWoken = numTasks < numWorkers ? numTasks : numWorkers;
+
+	if (self >= 0)
+	{
+		// a task forking more work keeps it local, idle workers steal it
+		AJAThreadPoolWorker* pSelf = mWorkers[size_t(self)];
+		{
+			AJAAutoLock lock(&pSelf->mQueueLock);
+			pSelf->mQueue.insert(pSelf->mQueue.end(), pTasks, pTasks + numTasks);
+		}
+		if (numWoken == numWorkers)
+			numWoken--;
+		for (size_t ndx = 1; ndx <= numWoken; ndx++)
+			mWorkers[(size_t(self) + ndx) % numWorkers]->mWake.Signal();
+		return;
+	}
+
+	// from outside the pool, deal the tasks out round robin
+	const size_t start = AJAAtomic::Increment(&mNextWorker);
+	for (size_t offset = 0; offset < numWoken; offset++)
+	{
+		AJAThreadPoolWorker* pWorker = mWorkers[(start + offset) % numWorkers];
+		{
+			AJAAutoLock lock(&pWorker->mQueueLock);
+			for (size_t ndx = offset; ndx < numTasks; ndx += numWorkers)
+				pWorker->mQueue.push_back(pTasks[ndx]);
+		}
+		pWorker->mWake.Signal();
+	}
+}
+
+
+bool
+AJAThreadPool::FindTask(int worker, Task& task)
+{
+	const size_t numWorkers = mWorkers.size();
+	if (numWorkers == 0)
+		return false;
+
+	// newest local task first
+	if (worker >= 0)
+	{
+		AJAThreadPoolWorker* pSelf = mWorkers[size_t(worker)];
+		AJAAutoLock lock(&pSelf->mQueueLock);
+		if (!pSelf->mQueue.empty())
+		{
+			task = pSelf->mQueue.back();
+			pSelf->mQueue.pop_back();
+			return true;
+		}
+	}
+
+	// then steal the oldest task from another worker
+	const size_t start = worker >= 0 ? size_t(worker) : size_t(mNextWorker);
+	for (size_t offset = 1; offset <= numWorkers; offset++)
+	{
+		AJAThreadPoolWorker* pVictim = mWorkers[(start + offset) % numWorkers];
+		if (pVictim->mIndex == worker)
+			continue;
+		AJAAutoLock lock(&pVictim->mQueueLock);
+		if (!pVictim->mQueue.empty())
+		{
+			task = pVictim->mQueue.front();
+			pVictim->mQueue.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void
+AJAThreadPool::RunTask(const Task& task)
+{
+	try
+	{
+		if (task.pRangeTask != NULL)
+			(*task.pRangeTask)(task.first, task.last, task.pContext);
+		else
+			(*task.pTask)(task.pContext);
+	}
+	catch (...)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThreadPool(%p) exception in task", this);
+	}
+
+	if (task.pGroup != NULL)
+		AJAAtomic::Decrement(&task.pGroup->mPending);
+}
@@ -0,0 +1,204 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		threadpool.h
+	@brief		Declares the AJAThreadPool class.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+#ifndef AJA_THREADPOOL_H
+#define AJA_THREADPOOL_H
+
+#include "ajabase/common/public.h"
+#include "ajabase/system/event.h"
+#include "ajabase/system/lock.h"
+#include <vector>
+
+// forward declarations
+class AJAThreadPoolWorker;
+
+/**
+ *	Template for a task function run by AJAThreadPool::Submit.
+ *	@relates AJAThreadPool
+ */
+typedef void AJAThreadPoolTask(void* pContext);
+
+/**
+ *	Template for a range task function run by AJAThreadPool::ParallelFor.
+ *	Processes items first through last - 1 (e.g. raster rows).
+ *	@relates AJAThreadPool
+ */
+typedef void AJAThreadPoolRangeTask(uint32_t first, uint32_t last, void* pContext);
+
+/**
+ *	Tracks a set of tasks submitted to an AJAThreadPool so they can be waited for together.
+ *	@relates AJAThreadPool
+ */
+class AJA_EXPORT AJAThreadPoolGroup
+{
+public:
+	AJAThreadPoolGroup();
+
+	/**
+	 *	@return		True if every task submitted with this group has finished.
+	 */
+	bool Done() const;
+
+private:
+	friend class AJAThreadPool;
+	volatile int32_t mPending;
+};
+
+/**
+ *	Pool of worker threads for fork/join parallel processing, such as per-frame work on UHD/8K rasters.
+ *
+ *	Each worker owns a task deque.  A worker runs its own newest task first (keeping the data it just
+ *	touched in cache), and when its deque is empty it steals the oldest task from another worker.
+ *	Threads that wait for a group (see Wait and ParallelFor) run queued tasks while they wait, so
+ *	tasks may themselves submit and wait for work without tying up the pool.
+ *
+ *	SDK routines use the shared pool returned by GetDefault() rather than starting threads per call.
+ *	@ingroup AJAGroupSystem
+ */
+class AJA_EXPORT AJAThreadPool
+{
+public:
+
+	/**
+	 *	Constructor starts the worker threads.
+	 *
+	 *	@param[in]	numThreads	Number of worker threads.  Zero uses one per online CPU.
+	 */
+	AJAThreadPool(uint32_t numThreads = 0);
+	virtual ~AJAThreadPool();
+
+	/**
+	 *	Get the number of worker threads.
+	 *
+	 *	@return		The number of workers that started.  Zero if none did, in which case tasks run on
+	 *				the thread that waits for them.
+	 */
+	uint32_t GetThreadCount() const;
+
+	/**
+	 *	Pin the workers to a set of logical CPUs, one CPU per worker in turn.
+	 *
+	 *	@param[in]	cpus					Logical CPU numbers.  An empty list removes the restriction.
+	 *	@return		AJA_STATUS_SUCCESS		Workers pinned
+	 *				AJA_STATUS_RANGE		A CPU number is out of range
+	 *				AJA_STATUS_UNSUPPORTED	Affinity is not supported on this platform
+	 *				AJA_STATUS_FAIL			A worker could not be pinned
+	 */
+	virtual AJAStatus SetAffinity(const std::vector<int>& cpus);
+
+	/**
+	 *	Pin the workers to the CPUs of a NUMA node, one CPU per worker in turn.
+	 *
+	 *	Typically used with the node the card is attached to (see CNTV2Card::GetNUMANode).
+	 *
+	 *	@param[in]	node					NUMA node number.  A negative number removes the restriction.
+	 *	@return		AJA_STATUS_SUCCESS		Workers pinned
+	 *				AJA_STATUS_RANGE		No such node
+	 *				AJA_STATUS_UNSUPPORTED	Affinity is not supported on this platform
+	 *				AJA_STATUS_FAIL			A worker could not be pinned
+	 */
+	virtual AJAStatus SetNUMANode(int node);
+
+	/**
+	 *	Queue a task.
+	 *
+	 *	@param[in]	pTask					Task function.
+	 *	@param[in]	pContext				Context passed to the task function.
+	 *	@param[in]	pGroup					Optional group to wait for the task with (see Wait).
+	 *	@return		AJA_STATUS_SUCCESS		Task queued
+	 *				AJA_STATUS_NULL			pTask is NULL
+	 */
+	virtual AJAStatus Submit(AJAThreadPoolTask* pTask, void* pContext, AJAThreadPoolGroup* pGroup = NULL);
+
+	/**
+	 *	Wait for all tasks in a group to finish, running queued tasks meanwhile.
+	 *
+	 *	@param[in]	group					Group to wait for.
+	 *	@return		AJA_STATUS_SUCCESS		All tasks in the group finished
+	 */
+	virtual AJAStatus Wait(AJAThreadPoolGroup& group);
+
+	/**
+	 *	Run a range task over first through last - 1 in parallel, and wait for it to finish.
+	 *
+	 *	The range is split into chunks of grain items, which the workers and the calling thread share.
+	 *
+	 *	@param[in]	first					First item, e.g. the first raster row.
+	 *	@param[in]	last					One past the last item.
+	 *	@param[in]	pTask					Range task function, called once per chunk.
+	 *	@param[in]	pContext				Context passed to the task function.
+	 *	@param[in]	grain					Items per chunk.  Zero splits the range into about four chunks
+	 *										per thread.
+	 *	@return		AJA_STATUS_SUCCESS		The range was processed
+	 *				AJA_STATUS_NULL			pTask is NULL
+	 */
+	virtual AJAStatus ParallelFor(uint32_t first, uint32_t last, AJAThreadPoolRangeTask* pTask, void* pContext, uint32_t grain = 0);
+
+	/**
+	 *	Run a function object over first through last - 1 in parallel, and wait for it to finish.
+	 *
+	 *	@param[in]	first					First item.
+	 *	@param[in]	last					One past the last item.
+	 *	@param[in]	func					Function object called as func(chunkFirst, chunkLast) from several
+	 *										threads at once.
+	 *	@param[in]	grain					Items per chunk.  Zero picks a chunk size.
+	 *	@return		AJA_STATUS_SUCCESS		The range was processed
+	 */
+	template <typename Func>
+	AJAStatus ParallelFor(uint32_t first, uint32_t last, const Func& func, uint32_t grain = 0)
+	{
+		return ParallelFor(first, last, &RangeTaskThunk<Func>, const_cast<Func*>(&func), grain);
+	}
+
+	/**
+	 *	Get the shared pool, starting it on first use.
+	 *
+	 *	@return		The process wide pool, with one worker per online CPU.
+	 */
+	static AJAThreadPool& GetDefault();
+
+	/**
+	 *	Get the number of online CPUs.
+	 *
+	 *	@return		The number of CPUs, at least 1.
+	 */
+	static uint32_t GetCPUCount();
+
+private:
+	friend class AJAThreadPoolWorker;
+
+	struct Task
+	{
+		AJAThreadPoolTask*		pTask;
+		AJAThreadPoolRangeTask*	pRangeTask;
+		void*					pContext;
+		uint32_t				first;
+		uint32_t				last;
+		AJAThreadPoolGroup*		pGroup;
+	};
+
+	template <typename Func>
+	static void RangeTaskThunk(uint32_t first, uint32_t last, void* pContext)
+	{
+		(*static_cast<const Func*>(pContext))(first, last);
+	}
+
+	AJAThreadPool(const AJAThreadPool&);
+	AJAThreadPool& operator=(const AJAThreadPool&);
+
+	int		CurrentWorker() const;
+	void	Push(const Task* pTasks, size_t numTasks);
+	bool	FindTask(int worker, Task& task);
+	void	RunTask(const Task& task);
+
+	std::vector<AJAThreadPoolWorker*>	mWorkers;
+	volatile uint32_t					mNextWorker;
+	AJAEvent							mStarted;	// workers wait for this before touching mWorkers
+	AJALock								mAffinityLock;
+};
+
+#endif	//	AJA_THREADPOOL_H
@@ -8,6 +8,24 @@
 #include "ajabase/system/windows/threadimpl.h"
 #include "ajabase/system/debug.h"
 
+// an empty list means every cpu the process may use
+static bool MakeAffinityMask(const std::vector<int>& cpus, DWORD_PTR& mask)
+{
+	mask = 0;
+	if (cpus.empty())
+	{
+		DWORD_PTR systemMask = 0;
+		return GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask) != 0;
+	}
+	for (size_t i = 0; i < cpus.size(); i++)
+	{
+		if (cpus[i] < 0 || cpus[i] >= int(sizeof(DWORD_PTR) * 8))
+			return false;
+		mask |= DWORD_PTR(1) << cpus[i];
+	}
+	return true;
+}
+
 
 AJAThreadImpl::AJAThreadImpl(AJAThread* pThread)
 {
@@ -38,9 +56,11 @@ AJAThreadImpl::Start()
 		return AJA_STATUS_SUCCESS;
 	}
 
-	// create the thread
+	// create the thread, suspended if it must be pinned before it runs
 	mTerminate = false;
-	mhThreadHandle = CreateThread(NULL, 0, ThreadProcStatic, this, 0, &mThreadID);
+	DWORD_PTR affinityMask = 0;
+	bool pinned = !mAffinity.empty() && MakeAffinityMask(mAffinity, affinityMask);
+	mhThreadHandle = CreateThread(NULL, 0, ThreadProcStatic, this, pinned ? CREATE_SUSPENDED : 0, &mThreadID);
 	if (mhThreadHandle == 0)
 	{
 		mThreadID = 0;
@@ -50,6 +70,15 @@ AJAThreadImpl::Start()
 	// set the thread priority
 	SetPriority(mPriority);
 
+	if (pinned)
+	{
+		if (SetThreadAffinityMask(mhThreadHandle, affinityMask) == 0)
+		{
+			AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread(%p)::Start error %d setting affinity", mpThread, GetLastError());
+		}
+		ResumeThread(mhThreadHandle);
+	}
+
 	return AJA_STATUS_SUCCESS;
 }
 
@@ -224,6 +253,43 @@ AJAThreadImpl::SetRealTime(AJAThreadRealTimePolicy policy, int priority)
 }
 
 
+AJAStatus
+AJAThreadImpl::SetAffinity(const std::vector<int>& cpus)
+{
+	AJAAutoLock lock(&mLock);
+
+	DWORD_PTR mask = 0;
+	if (!MakeAffinityMask(cpus, mask))
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread(%p)::SetAffinity: cpu number out of range", mpThread);
+		return AJA_STATUS_RANGE;
+	}
+	mAffinity = cpus;
+
+	// if the thread is not running the affinity is applied when it starts
+	if (!Active())
+		return AJA_STATUS_SUCCESS;
+
+	if (SetThreadAffinityMask(mhThreadHandle, mask) == 0)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread(%p)::SetAffinity: error %d setting affinity", mpThread, GetLastError());
+		return AJA_STATUS_FAIL;
+	}
+	return AJA_STATUS_SUCCESS;
+}
+
+
+AJAStatus
+AJAThreadImpl::GetAffinity(std::vector<int>& cpus)
+{
+	AJAAutoLock lock(&mLock);
+
+	// windows has no call to read a thread's mask, so report what was requested
+	cpus = mAffinity;
+	return AJA_STATUS_SUCCESS;
+}
+
+
 AJAStatus
 AJAThreadImpl::Attach(AJAThreadFunction* pThreadFunction, void* pUserContext)
 {
@@ -278,3 +344,38 @@ uint64_t AJAThreadImpl::GetThreadId()
 {
 	return uint64_t(GetCurrentThreadId());
 }
+
+int AJAThreadImpl::GetNUMANodeCount()
+{
+	ULONG highestNode = 0;
+	if (!GetNumaHighestNodeNumber(&highestNode))
+		return 1;
+	return int(highestNode) + 1;
+}
+
+AJAStatus AJAThreadImpl::GetNUMANodeCPUs(int node, std::vector<int>& cpus)
+{
+	cpus.clear();
+	ULONGLONG mask = 0;
+	if (node < 0 || node >= GetNUMANodeCount() || !GetNumaNodeProcessorMask(UCHAR(node), &mask))
+		return AJA_STATUS_RANGE;
+
+	for (int cpu = 0; cpu < 64; cpu++)
+		if (mask & (ULONGLONG(1) << cpu))
+			cpus.push_back(cpu);
+	return AJA_STATUS_SUCCESS;
+}
+
+AJAStatus AJAThreadImpl::SetCurrentThreadAffinity(const std::vector<int>& cpus)
+{
+	DWORD_PTR mask = 0;
+	if (!MakeAffinityMask(cpus, mask))
+		return AJA_STATUS_RANGE;
+
+	if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+	{
+		AJA_REPORT(0, AJA_DebugSeverity_Error, "AJAThread::SetCurrentThreadAffinity: error %d setting affinity", GetLastError());
+		return AJA_STATUS_FAIL;
+	}
+	return AJA_STATUS_SUCCESS;
+}
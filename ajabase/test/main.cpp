@@ -17,19 +17,27 @@
 
 #include "ajabase/common/bytestream.h"
 #include "ajabase/common/commandline.h"
+#include "ajabase/common/dpxfileio.h"
 #include "ajabase/common/common.h"
 #include "ajabase/common/guid.h"
 #include "ajabase/common/performance.h"
 #include "ajabase/common/timebase.h"
 #include "ajabase/common/timecode.h"
+#include "ajabase/common/timecodeburn.h"
 #include "ajabase/common/timer.h"
+#include "ajabase/common/videoutilities.h"
+#include "ajabase/common/wavewriter.h"
 #include "ajabase/common/ajamovingavg.h"
 #include "ajabase/persistence/persistence.h"
 #include "ajabase/system/atomic.h"
+#include "ajabase/system/debug.h"
 #include "ajabase/system/file_io.h"
 #include "ajabase/system/info.h"
+#include "ajabase/system/memory.h"
+#include "ajabase/system/process.h"
 #include "ajabase/system/systemtime.h"
 #include "ajabase/system/thread.h"
+#include "ajabase/system/threadpool.h"
 
 #include <algorithm>
 #include <clocale>
@@ -1097,6 +1105,57 @@ TEST_SUITE("time" * doctest::description("functions in ajabase/system/systemtime
 // 		}
 	}
 
+	TEST_CASE("AJATime fast clock")
+	{
+		const uint64_t freq (AJATime::GetFastFrequency());
+		std::cout << "Fast clock: " << (AJATime::IsFastCounterTSC() ? "TSC" : "OS clock") << " at " << freq << " Hz" << std::endl;
+		CHECK(freq >= 1000000);
+
+		//	Monotonic
+		uint64_t last (AJATime::GetFastNanoseconds());
+		bool monotonic (true);
+		for (int n(0);  n < 100000;  n++)
+		{
+			const uint64_t now (AJATime::GetFastNanoseconds());
+			if (now < last)
+				monotonic = false;
+			last = now;
+		}
+		CHECK(monotonic);
+
+		//	Agrees with the system clock, and stays continuous across recalibration. The system clock is read
+		//	either side of each fast clock read, so preemption between the reads can't fail the check, and
+		//	calibration error is allowed for with a generous tolerance.
+		const uint64_t sysBefore1 (AJATime::GetSystemNanoseconds());
+		const uint64_t fastStart (AJATime::GetFastNanoseconds());
+		const uint64_t sysAfter1 (AJATime::GetSystemNanoseconds());
+		AJATime::Sleep(20);
+		CHECK(AJATime::CalibrateFastClock(5));
+		const uint64_t sysBefore2 (AJATime::GetSystemNanoseconds());
+		const uint64_t fastDelta (AJATime::GetFastNanoseconds() - fastStart);
+		const uint64_t sysAfter2 (AJATime::GetSystemNanoseconds());
+		const uint64_t sysMinDelta (sysBefore2 - sysAfter1),  sysMaxDelta (sysAfter2 - sysBefore1);
+		CHECK(fastDelta >= sysMinDelta - sysMinDelta / 10);
+		CHECK(fastDelta <= sysMaxDelta + sysMaxDelta / 10);
+		const uint64_t ticks (AJATime::GetFastCounter());
+		const uint64_t calibratedFreq (AJATime::GetFastFrequency());	//	Recalibration changed the frequency
+		CHECK(AJATime::FastCounterToNanoseconds(ticks + calibratedFreq) - AJATime::FastCounterToNanoseconds(ticks) == doctest::Approx(1.0e9).epsilon(0.000001));
+
+		//	Driver FRAME_STAMP time base round trip
+		const uint64_t nanoseconds (AJATime::GetFastNanoseconds());
+		const int64_t frameStampTime (AJATime::FastNanosecondsToFrameStampTime(nanoseconds));
+		const uint64_t roundTrip (AJATime::FrameStampTimeToFastNanoseconds(frameStampTime));
+		CHECK(roundTrip <= nanoseconds);
+		CHECK(nanoseconds - roundTrip < 200);
+		CHECK_EQ(AJATime::FastNanosecondsToFrameStampTime(nanoseconds + 1000000) - frameStampTime, 10000);
+#if defined(AJA_LINUX)
+		//	The Linux driver time base is the wall clock
+		const int64_t wallClock (int64_t(time(NULL)) * 10000000);
+		CHECK(frameStampTime > wallClock - 20000000);
+		CHECK(frameStampTime < wallClock + 20000000);
+#endif
+	}
+
 } //time
 
 
@@ -1262,6 +1321,159 @@ TEST_SUITE("thread" * doctest::description("functions in ajabase/system/thread.h
 		}
 		tt.Terminate();
 	}
+
+	class IdleThread : public AJAThread {
+	public:
+		AJAStatus ThreadRun(void) override {
+			while (!Terminate())
+				AJATime::Sleep(1);
+			return AJA_STATUS_SUCCESS;
+		}
+	};
+	TEST_CASE("AJAThread::SetAffinity")
+	{
+		CHECK(AJAThread::GetNUMANodeCount() >= 1);
+		std::vector<int> nodeCPUs;
+		CHECK(AJAThread::GetNUMANodeCPUs(-1, nodeCPUs) == AJA_STATUS_RANGE);
+#if defined(AJA_LINUX) || defined(AJA_WINDOWS)
+		CHECK(AJAThread::GetNUMANodeCPUs(0, nodeCPUs) == AJA_STATUS_SUCCESS);
+		CHECK_FALSE(nodeCPUs.empty());
+
+		// find a cpu this process may run on
+		std::vector<int> cpus;
+		IdleThread unpinned;
+		CHECK(unpinned.Start() == AJA_STATUS_SUCCESS);
+		CHECK(unpinned.GetAffinity(cpus) == AJA_STATUS_SUCCESS);
+		REQUIRE_FALSE(cpus.empty());
+		const std::vector<int> oneCPU(1, cpus.front());
+
+		// pin a running thread
+		CHECK(unpinned.SetAffinity(oneCPU) == AJA_STATUS_SUCCESS);
+		CHECK(unpinned.GetAffinity(cpus) == AJA_STATUS_SUCCESS);
+		CHECK(cpus == oneCPU);
+		CHECK(unpinned.Stop() == AJA_STATUS_SUCCESS);
+
+		// pin a thread before it starts
+		IdleThread pinned;
+		CHECK(pinned.SetAffinity(std::vector<int>(1, -1)) == AJA_STATUS_RANGE);
+		CHECK(pinned.SetAffinity(oneCPU) == AJA_STATUS_SUCCESS);
+		CHECK(pinned.GetAffinity(cpus) == AJA_STATUS_SUCCESS);
+		CHECK(cpus == oneCPU);
+		CHECK(pinned.Start() == AJA_STATUS_SUCCESS);
+		CHECK(pinned.GetAffinity(cpus) == AJA_STATUS_SUCCESS);
+		CHECK(cpus == oneCPU);
+		CHECK(pinned.Stop() == AJA_STATUS_SUCCESS);
+
+		// pin to a node
+		IdleThread local;
+		CHECK(local.SetNUMANode(AJAThread::GetNUMANodeCount() + 1000) == AJA_STATUS_RANGE);
+		CHECK(local.SetNUMANode(0) == AJA_STATUS_SUCCESS);
+		CHECK(local.GetAffinity(cpus) == AJA_STATUS_SUCCESS);
+		CHECK(cpus == nodeCPUs);
+		CHECK(local.SetNUMANode(-1) == AJA_STATUS_SUCCESS);
+		CHECK(local.GetAffinity(cpus) == AJA_STATUS_SUCCESS);
+		CHECK(cpus.empty());
+#endif
+	}
+
+	TEST_CASE("AJAMemory::AllocateAligned NUMA node")
+	{
+		const size_t size = 1920 * 1080 * 4 + 123;
+		const size_t alignments[] = {64, 4096, 2 * 1024 * 1024};
+		for (size_t i = 0; i < sizeof(alignments) / sizeof(alignments[0]); i++)
+		{
+			uint8_t* pBuffer = (uint8_t*) AJAMemory::AllocateAligned(size, alignments[i], 0);
+			REQUIRE(pBuffer != NULL);
+			CHECK(uintptr_t(pBuffer) % alignments[i] == 0);
+			memset(pBuffer, 0x5a, size);
+			CHECK(pBuffer[0] == 0x5a);
+			CHECK(pBuffer[size - 1] == 0x5a);
+			AJAMemory::FreeAligned(pBuffer);
+		}
+
+		// no preference is the plain allocator
+		void* pBuffer = AJAMemory::AllocateAligned(4096, 64, -1);
+		REQUIRE(pBuffer != NULL);
+		AJAMemory::FreeAligned(pBuffer);
+		CHECK(AJAMemory::AllocateAligned(0, 64, 0) == NULL);
+	}
+
+	TEST_CASE("AJAMemory::AllocateHugePages")
+	{
+		const size_t size = 3 * 1024 * 1024 + 5;
+		const size_t pageSizes[] = {0, 2 * 1024 * 1024, 1024 * 1024 * 1024};
+		for (size_t i = 0; i < sizeof(pageSizes) / sizeof(pageSizes[0]); i++)
+		{
+			size_t actualPageSize = 0;
+			uint8_t* pBuffer = (uint8_t*) AJAMemory::AllocateHugePages(size, pageSizes[i], -1, &actualPageSize);
+			REQUIRE(pBuffer != NULL);
+			CHECK(actualPageSize >= AJAMemory::GetPageSize(NULL));
+			CHECK(AJAMemory::GetPageSize(pBuffer) == actualPageSize);
+			CHECK(uintptr_t(pBuffer) % actualPageSize == 0);
+			memset(pBuffer, 0xa5, size);
+			CHECK(pBuffer[size - 1] == 0xa5);
+			AJAMemory::FreeAligned(pBuffer);
+		}
+
+		CHECK(AJAMemory::AllocateHugePages(size, 3 * 1024 * 1024) == NULL);
+		CHECK(AJAMemory::AllocateHugePages(0) == NULL);
+	}
+
+	static void CountTask(void* pContext)
+	{
+		AJAAtomic::Increment((int32_t volatile*)pContext);
+	}
+	TEST_CASE("AJAThreadPool")
+	{
+		AJAThreadPool pool(4);
+		CHECK(pool.GetThreadCount() == 4);
+		CHECK(&AJAThreadPool::GetDefault() == &AJAThreadPool::GetDefault());
+		CHECK(AJAThreadPool::GetDefault().GetThreadCount() == AJAThreadPool::GetCPUCount());
+
+		// every row visited exactly once, for several chunk sizes
+		const uint32_t numRows = 4321;
+		const uint32_t grains[] = {0, 1, 7, 1000, numRows, numRows * 2};
+		for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++)
+		{
+			std::vector<int> visits(numRows, 0);
+			CHECK(pool.ParallelFor(0, numRows, [&visits](uint32_t first, uint32_t last)
+				{
+					for (uint32_t row = first; row < last; row++)
+						visits[row]++;
+				}, grains[g]) == AJA_STATUS_SUCCESS);
+			CHECK(std::count(visits.begin(), visits.end(), 1) == int(numRows));
+		}
+		CHECK(pool.ParallelFor(5, 5, [](uint32_t, uint32_t) {CHECK(false);}) == AJA_STATUS_SUCCESS);
+		CHECK(pool.ParallelFor(0, 1, (AJAThreadPoolRangeTask*)NULL, NULL) == AJA_STATUS_NULL);
+
+		// nested fork/join from inside tasks
+		int32_t volatile total = 0;
+		pool.ParallelFor(0, 16, [&pool, &total](uint32_t first, uint32_t last)
+			{
+				for (uint32_t outer = first; outer < last; outer++)
+					pool.ParallelFor(0, 100, [&total](uint32_t innerFirst, uint32_t innerLast)
+						{
+							for (uint32_t inner = innerFirst; inner < innerLast; inner++)
+								AJAAtomic::Increment(&total);
+						}, 10);
+			}, 1);
+		CHECK(total == 1600);
+
+		// submitted tasks
+		int32_t volatile count = 0;
+		AJAThreadPoolGroup group;
+		for (int ndx = 0; ndx < 1000; ndx++)
+			CHECK(pool.Submit(CountTask, (void*)&count, &group) == AJA_STATUS_SUCCESS);
+		CHECK(pool.Wait(group) == AJA_STATUS_SUCCESS);
+		CHECK(group.Done());
+		CHECK(count == 1000);
+		CHECK(pool.Submit(NULL, NULL) == AJA_STATUS_NULL);
+
+#if defined(AJA_LINUX) || defined(AJA_WINDOWS)
+		CHECK(pool.SetNUMANode(AJAThread::GetNUMANodeCount() + 1000) == AJA_STATUS_RANGE);
+		CHECK(pool.SetAffinity(std::vector<int>()) == AJA_STATUS_SUCCESS);
+#endif
+	}
 }
 
 void bytestream_marker() {}
@@ -1908,6 +2120,80 @@ TEST_SUITE("atomic" * doctest::description("functions in ajabase/system/atomic.h
 
 } //atomic
 
+void debug_marker() {}
+static void ReportLaterThread (AJAThread * pThread, void * pContext)
+{	(void) pThread;  (void) pContext;
+	AJATime::Sleep(50);
+	AJA_REPORT(AJA_DebugUnit_Testing, AJA_DebugSeverity_Error, "wake up");
+}
+
+TEST_SUITE("debug" * doctest::description("functions in ajabase/system/debug.h")) {
+
+	TEST_CASE("AJADebug::GetMessages")
+	{
+		REQUIRE(AJA_SUCCESS(AJADebug::Open(true)));
+		uint32_t oldDestination(AJA_DEBUG_DESTINATION_NONE);
+		AJADebug::GetDestination(AJA_DebugUnit_Testing, oldDestination);
+		AJADebug::Enable(AJA_DebugUnit_Testing, AJA_DEBUG_DESTINATION_DEBUG);
+
+		AJADebugMessageFilter filter;
+		filter.SetAllUnits(false);
+		filter.SetUnit(AJA_DebugUnit_Testing, true);
+		filter.SetSeverity(AJA_DebugSeverity_Info, false);
+		filter.SetProcessId(AJAProcess::GetPid());
+		CHECK(filter.HasUnit(AJA_DebugUnit_Testing));
+		CHECK_FALSE(filter.HasUnit(AJA_DebugUnit_Critical));
+		CHECK_FALSE(filter.HasSeverity(AJA_DebugSeverity_Info));
+		CHECK(filter.HasSeverity(AJA_DebugSeverity_Error));
+
+		uint64_t seqNum(0), lostCount(0);
+		REQUIRE(AJA_SUCCESS(AJADebug::GetSequenceNumber(seqNum)));
+		seqNum++;
+		CHECK(AJADebug::WaitForMessage(seqNum, 10) == AJA_STATUS_TIMEOUT);
+
+		//	Batch read, with filtering...
+		const uint64_t firstSeqNum(seqNum);
+		for (int num(0);  num < 10;  num++)
+			AJA_REPORT(AJA_DebugUnit_Testing, num & 1 ? AJA_DebugSeverity_Error : AJA_DebugSeverity_Info, "msg %d", num);
+		CHECK(AJA_SUCCESS(AJADebug::WaitForMessage(seqNum, 10)));
+		std::vector<AJADebugMessage> msgs;
+		CHECK(AJA_SUCCESS(AJADebug::GetMessages(seqNum, msgs, 1000, filter, lostCount)));
+		CHECK_EQ(seqNum, firstSeqNum + 10);
+		CHECK_EQ(lostCount, 0);
+		REQUIRE_EQ(msgs.size(), 5);
+		for (size_t ndx(0);  ndx < msgs.size();  ndx++)
+		{
+			CHECK_EQ(msgs.at(ndx).sequenceNumber, firstSeqNum + 2*ndx + 1);
+			CHECK_EQ(msgs.at(ndx).severity, AJA_DebugSeverity_Error);
+			CHECK_EQ(std::string(msgs.at(ndx).messageText), "msg " + aja::to_string(int(2*ndx + 1)));
+		}
+		CHECK(AJA_SUCCESS(AJADebug::GetMessages(seqNum, msgs, 1000, filter, lostCount)));
+		CHECK(msgs.empty());
+
+		//	Ring wrap...
+		for (uint32_t num(0);  num < AJADebug::MessageRingCapacity() + 10;  num++)
+			AJA_REPORT(AJA_DebugUnit_Testing, AJA_DebugSeverity_Error, "wrap %u", num);
+		CHECK(AJA_SUCCESS(AJADebug::GetMessages(seqNum, msgs, AJADebug::MessageRingCapacity(), filter, lostCount)));
+		CHECK(lostCount >= 10);
+		CHECK(msgs.size() + lostCount <= AJADebug::MessageRingCapacity() + 10);
+		CHECK(AJA_SUCCESS(AJADebug::GetSequenceNumber(lostCount)));
+		CHECK_EQ(seqNum, lostCount + 1);
+
+		//	Wakeup...
+		AJAThread reporter;
+		reporter.Attach(ReportLaterThread, NULL);
+		const uint64_t startMS(AJATime::GetSystemMilliseconds());
+		REQUIRE(AJA_SUCCESS(reporter.Start()));
+		CHECK(AJA_SUCCESS(AJADebug::WaitForMessage(seqNum, 5000)));
+		CHECK(AJATime::GetSystemMilliseconds() - startMS < 2500);
+		reporter.Stop();
+
+		AJADebug::SetDestination(AJA_DebugUnit_Testing, oldDestination);
+		AJADebug::Close(true);
+	}
+
+} //debug
+
 void info_marker() {}
 TEST_SUITE("info" * doctest::description("functions in ajabase/system/info.h")) {
 
@@ -2201,4 +2487,420 @@ TEST_SUITE("file" * doctest::description("functions in ajabase/system/file_io.h"
 		}
 	}
 
+	TEST_CASE("AJAFileIO Direct & Async")
+	{
+		std::string path;
+		REQUIRE(AJAFileIO::TempDirectory(path) == AJA_STATUS_SUCCESS);
+		aja::rstrip(path, pathSepStr);
+		path += pathSepStr + "AJAFileIO_direct_" + aja::to_string((unsigned long)AJATime::GetSystemMilliseconds()) + ".dat";
+
+		const uint32_t blockSize(64 * 1024), numBlocks(16);
+		uint8_t* pBlocks = (uint8_t*) AJAMemory::AllocateAligned(blockSize * numBlocks, 4096);
+		REQUIRE(pBlocks != NULL);
+		for (uint32_t ndx = 0; ndx < blockSize * numBlocks; ndx++)
+			pBlocks[ndx] = uint8_t(ndx * 7 + ndx / blockSize);
+
+		AJAFileIO file;
+		REQUIRE(file.Open(path, eAJAReadWrite|eAJATruncateExisting, eAJAUnbuffered) == AJA_STATUS_SUCCESS);
+		CHECK(blockSize % file.GetDirectIOAlignment() == 0);
+		CHECK(file.Preallocate(0, blockSize * numBlocks, true) != AJA_STATUS_FAIL);
+		CHECK(file.Advise(0, 0, eAJAAdviseSequential) == AJA_STATUS_SUCCESS);
+
+		//	Aligned and unaligned synchronous writes...
+		CHECK_EQ(file.Write(pBlocks, blockSize), blockSize);
+		CHECK_EQ(file.Write(pBlocks + blockSize, 100), 100);
+		CHECK_EQ(file.Tell(), int64_t(blockSize + 100));
+
+		//	Queue-depth-4 asynchronous writes of every block...
+		CHECK(file.SetAsyncQueueDepth(4) == AJA_STATUS_SUCCESS);
+		std::vector<AJAFileIOCompletion> done;
+		uint32_t submitted(0);
+		while (done.size() < numBlocks)
+		{
+			while (submitted < numBlocks && file.WriteAsync(pBlocks + submitted * blockSize, blockSize, int64_t(submitted) * blockSize, submitted) == AJA_STATUS_SUCCESS)
+				submitted++;
+			CHECK(file.GetAsyncPending() <= 4);
+			REQUIRE(file.WaitAsync(done, 1, 5000) == AJA_STATUS_SUCCESS);
+		}
+		CHECK_FALSE(file.GetAsyncEngine().empty());
+		CHECK_EQ(file.GetAsyncPending(), 0);
+		for (size_t ndx = 0; ndx < done.size(); ndx++)
+		{
+			CHECK(done[ndx].isWrite);
+			CHECK(done[ndx].status == AJA_STATUS_SUCCESS);
+			CHECK_EQ(done[ndx].transferred, blockSize);
+		}
+		if (file.IsDirectIO())
+			CHECK(file.WriteAsync(pBlocks + 1, blockSize, 0) == AJA_STATUS_ALIGN);
+
+		//	Read it all back asynchronously, in reverse...
+		uint8_t* pReadBack = (uint8_t*) AJAMemory::AllocateAligned(blockSize * numBlocks, 4096);
+		REQUIRE(pReadBack != NULL);
+		memset(pReadBack, 0, blockSize * numBlocks);
+		done.clear();
+		for (uint32_t ndx = 0; ndx < numBlocks; ndx++)
+		{
+			const uint32_t block = numBlocks - 1 - ndx;
+			if (file.ReadAsync(pReadBack + block * blockSize, blockSize, int64_t(block) * blockSize, block) == AJA_STATUS_BUSY)
+			{
+				REQUIRE(file.WaitAsync(done, 1, 5000) == AJA_STATUS_SUCCESS);
+				CHECK(file.ReadAsync(pReadBack + block * blockSize, blockSize, int64_t(block) * blockSize, block) == AJA_STATUS_SUCCESS);
+			}
+		}
+		CHECK(file.WaitAsync(done, numBlocks, 5000) == AJA_STATUS_SUCCESS);
+		CHECK_EQ(done.size(), numBlocks);
+		CHECK(memcmp(pReadBack, pBlocks, blockSize * numBlocks) == 0);
+
+		//	Unaligned synchronous read...
+		CHECK(file.Seek(3, eAJASeekSet) == AJA_STATUS_SUCCESS);
+		std::string readBack;
+		CHECK_EQ(file.Read(readBack, 10), 10);
+		CHECK(memcmp(readBack.data(), pBlocks + 3, 10) == 0);
+
+		CHECK(file.Close() == AJA_STATUS_SUCCESS);
+		CHECK_FALSE(file.IsDirectIO());
+		AJAMemory::FreeAligned(pReadBack);
+		AJAMemory::FreeAligned(pBlocks);
+		CHECK(AJAFileIO::Delete(path) == AJA_STATUS_SUCCESS);
+	}
+
 } //file
+
+TEST_SUITE("dpxfileio" * doctest::description("functions in ajabase/common/dpxfileio.h")) {
+
+	TEST_CASE("AJADPXFileIO Prefetch & Write-Behind")
+	{
+		const std::string pathSepStr(1, AJA_PATHSEP);
+		std::string dir;
+		REQUIRE(AJAFileIO::TempDirectory(dir) == AJA_STATUS_SUCCESS);
+		aja::rstrip(dir, pathSepStr);
+		dir += pathSepStr + "ajadpx_tmp_dir_" + aja::to_string((unsigned long)AJATime::GetSystemMilliseconds());
+#if defined(AJA_WINDOWS)
+		_mkdir(dir.c_str());
+#else
+		mkdir(dir.c_str(), ACCESSPERMS);
+#endif
+		REQUIRE(AJAFileIO::DoesDirectoryExist(dir) == AJA_STATUS_SUCCESS);
+
+		//	A 480x4 10-bit YCbCr image:  480 * 4 * 8 / 3 payload bytes
+		const uint32_t numFrames(5), payloadSize(480 * 4 * 8 / 3);
+		std::vector<uint8_t> payload(payloadSize);
+		AJADPXFileIO writer;
+		REQUIRE(writer.SetPath(dir) == AJA_STATUS_SUCCESS);
+		writer.set_ie_descriptor(100);
+		writer.set_ie_bit_size(10);
+		writer.set_ii_pixels(480);
+		writer.set_ii_lines(4);
+		writer.set_fi_image_offset(writer.GetHdrSize());
+		CHECK(writer.QueueWrite(payload[0], payloadSize, 0) == AJA_STATUS_INITIALIZE);
+		REQUIRE(writer.StartWriteBehind(2, 2) == AJA_STATUS_SUCCESS);
+		for (uint32_t frame = 0; frame < numFrames; frame++)
+		{
+			std::fill(payload.begin(), payload.end(), uint8_t(0xA0 + frame));
+			CHECK(writer.QueueWrite(payload[0], payloadSize, frame, 5000) == AJA_STATUS_SUCCESS);
+			CHECK(writer.GetWritesPending() <= 2);
+		}
+		CHECK(writer.StopWriteBehind() == AJA_STATUS_SUCCESS);
+		CHECK_EQ(writer.GetWritesPending(), 0);
+
+		AJADPXFileIO reader;
+		REQUIRE(reader.SetPath(dir) == AJA_STATUS_SUCCESS);
+		REQUIRE_EQ(reader.GetFileCount(), numFrames);
+		std::sort(reader.GetFileList().begin(), reader.GetFileList().end());
+		REQUIRE(reader.StartPrefetch(3, 2) == AJA_STATUS_SUCCESS);
+		CHECK(reader.IsPrefetching());
+
+		//	Looping:  plays through twice, wrapping around
+		std::vector<uint8_t> frameBuffer(payloadSize);
+		for (uint32_t ndx = 0; ndx < numFrames * 2; ndx++)
+		{
+			uint32_t index(99);
+			CHECK(reader.Read(frameBuffer[0], payloadSize, index) == AJA_STATUS_SUCCESS);
+			CHECK_EQ(index, ndx % numFrames);
+			CHECK_EQ(frameBuffer.front(), uint8_t(0xA0 + index));
+			CHECK_EQ(frameBuffer.back(), uint8_t(0xA0 + index));
+			CHECK_EQ(reader.get_ii_pixels(), 480);
+		}
+
+		//	Paused:  the same frame repeats
+		reader.SetPauseMode(true);
+		CHECK(reader.SetIndex(3) == AJA_STATUS_SUCCESS);
+		for (uint32_t ndx = 0; ndx < 3; ndx++)
+		{
+			uint32_t index(99);
+			CHECK(reader.Read(frameBuffer[0], payloadSize, index) == AJA_STATUS_SUCCESS);
+			CHECK_EQ(index, 3);
+			CHECK_EQ(frameBuffer[0], uint8_t(0xA3));
+		}
+		reader.SetPauseMode(false);
+
+		//	Not looping:  stops at the end
+		reader.SetLoopMode(false);
+		uint32_t index(99);
+		CHECK(reader.Read(frameBuffer[0], payloadSize, index) == AJA_STATUS_SUCCESS);
+		CHECK(reader.Read(frameBuffer[0], payloadSize, index) == AJA_STATUS_SUCCESS);
+		CHECK_EQ(index, 4);
+		CHECK(reader.Read(frameBuffer[0], payloadSize, index) == AJA_STATUS_RANGE);
+		CHECK(reader.SetIndex(1) == AJA_STATUS_SUCCESS);
+		CHECK(reader.Read(frameBuffer[0], payloadSize - 1, index) == AJA_STATUS_BAD_PARAM);
+
+		CHECK(reader.StopPrefetch() == AJA_STATUS_SUCCESS);
+		CHECK_FALSE(reader.IsPrefetching());
+		CHECK(reader.Read(frameBuffer[0], payloadSize, index) == AJA_STATUS_SUCCESS);
+		CHECK_EQ(index, 2);
+		CHECK_EQ(frameBuffer[0], uint8_t(0xA2));
+
+		for (size_t ndx = 0; ndx < reader.GetFileList().size(); ndx++)
+			CHECK(AJAFileIO::Delete(reader.GetFileList().at(ndx)) == AJA_STATUS_SUCCESS);
+#if defined(AJA_WINDOWS)
+		_rmdir(dir.c_str());
+#else
+		rmdir(dir.c_str());
+#endif
+	}
+
+} //dpxfileio
+
+TEST_SUITE("wavewriter" * doctest::description("functions in ajabase/common/wavewriter.h")) {
+
+	TEST_CASE("AJAWavWriter Write-Behind & Planar")
+	{
+		const std::string pathSepStr(1, AJA_PATHSEP);
+		std::string path;
+		REQUIRE(AJAFileIO::TempDirectory(path) == AJA_STATUS_SUCCESS);
+		aja::rstrip(path, pathSepStr);
+		path += pathSepStr + "ajawav_" + aja::to_string((unsigned long)AJATime::GetSystemMilliseconds()) + ".wav";
+
+		//	16 channels of 32-bit audio, one planar buffer per channel
+		const int numChannels(16);
+		const uint32_t numSamples(3000), numWrites(3);
+		std::vector<std::vector<uint32_t> > planes(numChannels, std::vector<uint32_t>(numSamples));
+		std::vector<const char*> channels(numChannels);
+		for (int chan = 0; chan < numChannels; chan++)
+		{
+			for (uint32_t sample = 0; sample < numSamples; sample++)
+				planes[chan][sample] = (uint32_t(chan) << 24) | sample;
+			channels[chan] = reinterpret_cast<const char*>(&planes[chan][0]);
+		}
+
+		{
+			AJAWavWriter writer(path, AJAWavWriterAudioFormat(numChannels, 48000, 32), AJAWavWriterVideoFormat(),
+								"00:00:00;00", AJAWavWriterChunkFlag(AJAWavWriterChunkFlagBextV1 | AJAWavWriterChunkFlagRF64));
+			CHECK_FALSE(writer.setWriteBehind(8192, 1));
+			REQUIRE(writer.setWriteBehind(8192, 3));
+			REQUIRE(writer.open());
+			CHECK_FALSE(writer.setWriteBehind());
+			for (uint32_t ndx = 0; ndx < numWrites; ndx++)
+				CHECK_EQ(writer.writePlanar(&channels[0], numSamples), numSamples * numChannels * 4);
+			CHECK_FALSE(writer.hasWriteError());
+			writer.close();
+			CHECK_FALSE(writer.IsOpen());
+		}
+
+		AJAFileIO file;
+		REQUIRE(file.Open(path, eAJAReadOnly, 0) == AJA_STATUS_SUCCESS);
+		std::string contents;
+		const uint32_t headerSize(12 + 36 + 610 + 24 + 8), dataSize(numWrites * numSamples * numChannels * 4);
+		CHECK_EQ(file.Read(contents, headerSize + dataSize + 1), headerSize + dataSize);
+		file.Close();
+		CHECK(AJAFileIO::Delete(path) == AJA_STATUS_SUCCESS);
+		REQUIRE_EQ(contents.size(), headerSize + dataSize);
+
+		uint32_t value;
+		CHECK_EQ(contents.substr(0, 4), "RIFF");		//	Not over 4 GB, so still RIFF
+		memcpy(&value, &contents[4], 4);
+		CHECK_EQ(value, headerSize + dataSize - 8);
+		CHECK_EQ(contents.substr(12, 4), "JUNK");
+		CHECK_EQ(contents.substr(48, 4), "bext");
+		CHECK_EQ(contents.substr(headerSize - 8, 4), "data");
+		memcpy(&value, &contents[headerSize - 4], 4);
+		CHECK_EQ(value, dataSize);
+
+		//	Interleaved:  sample frame by sample frame, channel by channel
+		bool interleaved(true);
+		for (uint32_t frame = 0; frame < numWrites * numSamples && interleaved; frame++)
+			for (int chan = 0; chan < numChannels && interleaved; chan++)
+			{
+				memcpy(&value, &contents[headerSize + (frame * numChannels + chan) * 4], 4);
+				interleaved = value == ((uint32_t(chan) << 24) | (frame % numSamples));
+			}
+		CHECK(interleaved);
+	}
+
+} //wavewriter
+
+
+TEST_SUITE("videoutilities" * doctest::description("functions in ajabase/common/videoutilities.h")) {
+
+	TEST_CASE("AJA_ConvertYCbCrFrame")
+	{
+		//	70 pixels wide exercises the scalar tails and a partial v210 group
+		const uint32_t width(70), height(36);
+		const uint32_t bytes2vuy(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCbCr8, width) * height);
+		std::vector<uint8_t> src2vuy(bytes2vuy), back2vuy(bytes2vuy);
+		for (uint32_t row = 0; row < height; row++)
+			for (uint32_t pair = 0; pair < width / 2; pair++)
+			{
+				uint8_t * pPair = &src2vuy[(row * width + pair * 2) * 2];
+				pPair[0] = uint8_t(16 + pair * 3);			//	Cb varies across, not down
+				pPair[1] = uint8_t(16 + (row * 7 + pair * 13) % 220);
+				pPair[2] = uint8_t(240 - pair * 2);			//	Cr
+				pPair[3] = uint8_t(16 + (row * 11 + pair * 5) % 220);
+			}
+
+		//	Vertically constant chroma survives 4:2:2 ==> 4:2:0 ==> 4:2:2 exactly
+		std::vector<uint8_t> nv12(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCBCR8_420PL2, width) * height);
+		CHECK_EQ(nv12.size(), size_t(width * height * 3 / 2));
+		CHECK(AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_YCbCr8, &nv12[0], AJA_PixelFormat_YCBCR8_420PL2, width, height));
+		CHECK_EQ(nv12[1], src2vuy[3]);								//	Y1
+		CHECK_EQ(nv12[width * height], src2vuy[0]);					//	Cb0
+		CHECK_EQ(nv12[width * height + 1], src2vuy[2]);				//	Cr0
+		CHECK(AJA_ConvertYCbCrFrame(&nv12[0], AJA_PixelFormat_YCBCR8_420PL2, &back2vuy[0], AJA_PixelFormat_YCbCr8, width, height));
+		CHECK(back2vuy == src2vuy);
+
+		//	8-bit ==> v210 ==> P010 ==> YUY2 ==> 2vuy is lossless too
+		std::vector<uint8_t> v210(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCbCr10, width) * height);
+		std::vector<uint8_t> p010(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCBCR10_420PL2LE, width) * height);
+		std::vector<uint8_t> yuy2(bytes2vuy);
+		CHECK(AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_YCbCr8, &v210[0], AJA_PixelFormat_YCbCr10, width, height));
+		CHECK(AJA_ConvertYCbCrFrame(&v210[0], AJA_PixelFormat_YCbCr10, &p010[0], AJA_PixelFormat_YCBCR10_420PL2LE, width, height));
+		uint16_t y0(0);
+		memcpy(&y0, &p010[0], 2);
+		CHECK_EQ(y0, uint16_t(src2vuy[1]) << 8);					//	P010 samples are MSB-justified
+		CHECK(AJA_ConvertYCbCrFrame(&p010[0], AJA_PixelFormat_YCBCR10_420PL2LE, &yuy2[0], AJA_PixelFormat_YUY28, width, height));
+		CHECK_EQ(yuy2[0], src2vuy[1]);
+		CHECK_EQ(yuy2[1], src2vuy[0]);
+		CHECK(AJA_ConvertYCbCrFrame(&yuy2[0], AJA_PixelFormat_YUY28, &back2vuy[0], AJA_PixelFormat_YCbCr8, width, height));
+		CHECK(back2vuy == src2vuy);
+
+		//	Chroma ramping down the frame is filtered to the midpoint between rows (chroma_sample_loc_type 0)
+		for (uint32_t row = 0; row < height; row++)
+			for (uint32_t pair = 0; pair < width / 2; pair++)
+				src2vuy[(row * width + pair * 2) * 2] = uint8_t(row * 4);
+		std::vector<uint8_t> i420(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCBCR8_420PL3, width) * height);
+		CHECK(AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_YCbCr8, &i420[0], AJA_PixelFormat_YCBCR8_420PL3, width, height));
+		const uint8_t * pCb(&i420[width * height]);
+		CHECK_EQ(pCb[0], 3);									//	Top row clamped:  (0 + 0*3 + 4*3 + 8) / 8
+		CHECK_EQ(pCb[5 * width / 2], 5 * 8 + 2);				//	Midway between rows 10 and 11
+		CHECK_EQ(pCb[(height / 2 - 1) * width / 2 + 7], 138);	//	Bottom row clamped:  (132 + 136*3 + 140*3 + 140) / 8, rounded
+		CHECK(AJA_ConvertYCbCrFrame(&i420[0], AJA_PixelFormat_YCBCR8_420PL3, &back2vuy[0], AJA_PixelFormat_YCbCr8, width, height));
+		CHECK_EQ(back2vuy[(10 * width) * 2], 40);				//	Row 10:  (3*42 + 34) / 4
+		CHECK_EQ(back2vuy[(11 * width) * 2], 44);				//	Row 11:  (3*42 + 50) / 4
+
+		//	Threads & fields
+		std::vector<uint8_t> one(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCBCR10_420PL3LE, width) * height), many(one.size());
+		CHECK(AJA_ConvertYCbCrFrame(&v210[0], AJA_PixelFormat_YCbCr10, &one[0], AJA_PixelFormat_YCBCR10_420PL3LE, width, height, true, 1));
+		CHECK(AJA_ConvertYCbCrFrame(&v210[0], AJA_PixelFormat_YCbCr10, &many[0], AJA_PixelFormat_YCBCR10_420PL3LE, width, height, true, 4));
+		CHECK(one == many);
+		const uint32_t bigWidth(1920), bigHeight(1080);
+		std::vector<uint8_t> bigSrc(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCbCr8, bigWidth) * bigHeight);
+		for (size_t ndx = 0; ndx < bigSrc.size(); ndx++)
+			bigSrc[ndx] = uint8_t(16 + (ndx * 7919) % 220);
+		std::vector<uint8_t> bigOne(bigWidth * bigHeight * 3 / 2), bigMany(bigOne.size());
+		CHECK(AJA_ConvertYCbCrFrame(&bigSrc[0], AJA_PixelFormat_YCbCr8, &bigOne[0], AJA_PixelFormat_YCBCR8_420PL3, bigWidth, bigHeight, false, 1));
+		CHECK(AJA_ConvertYCbCrFrame(&bigSrc[0], AJA_PixelFormat_YCbCr8, &bigMany[0], AJA_PixelFormat_YCBCR8_420PL3, bigWidth, bigHeight, false, 8));
+		CHECK(bigOne == bigMany);
+
+		//	Bad parameters
+		CHECK_FALSE(AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_RGB8_PACK, &nv12[0], AJA_PixelFormat_YCBCR8_420PL2, width, height));
+		CHECK_FALSE(AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_YCbCr8, &nv12[0], AJA_PixelFormat_YCBCR8_420PL2, width - 1, height));
+		CHECK_FALSE(AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_YCbCr8, &nv12[0], AJA_PixelFormat_YCBCR8_420PL2, width, height - 2, true));
+		CHECK_FALSE(AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_YCbCr8, &src2vuy[0], AJA_PixelFormat_YCbCr8, width, height));
+	}
+
+} //videoutilities
+
+TEST_SUITE("timecodeburn" * doctest::description("functions in ajabase/common/timecodeburn.h")) {
+
+	TEST_CASE("AJATextBurn")
+	{
+		const uint32_t width(1920), height(1080);
+		std::vector<uint8_t> src2vuy(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCbCr8, width) * height);
+		for (size_t ndx = 0; ndx < src2vuy.size(); ndx++)
+			src2vuy[ndx] = uint8_t(16 + (ndx * 7919) % 220);
+
+		AJATextBurn burner;
+		CHECK_FALSE(burner.BurnText(&src2vuy[0], "x", 0, 0));					//	Not set up yet
+		CHECK_FALSE(burner.SetRasterFormat(AJA_PixelFormat_RAW10, width, height));
+		CHECK(burner.SetRasterFormat(AJA_PixelFormat_YCbCr8, width, height));
+		CHECK_EQ(burner.GetCellWidth(), 72);
+		CHECK_EQ(burner.GetCellHeight(), 108);
+		CHECK_FALSE(burner.BurnText(NULL, "x", 0, 0));
+		CHECK_FALSE(burner.BurnText(&src2vuy[0], "x", 0, height - 100));		//	Off the bottom
+
+		//	The defaults draw exactly what AJATimeCodeBurn does
+		std::vector<uint8_t> frame(src2vuy), legacyFrame(src2vuy);
+		AJATimeCodeBurn legacy;
+		CHECK(legacy.RenderTimeCodeFont(AJA_PixelFormat_YCbCr8, width, height));
+		CHECK(legacy.BurnTimeCode(&legacyFrame[0], "01:23:45;67", 50));
+		CHECK(burner.BurnTimeCode(&frame[0], "01:23:45;67", 50, 0, true));
+		CHECK(frame == legacyFrame);
+
+		//	Over the video, only changed cells are redrawn, and text can shrink, grow and move
+		AJA_RGBAlphaPixel text, clear;
+		text.Red = 0xFF;  text.Green = 0xC0;  text.Blue = 0x00;  text.Alpha = 0xC0;
+		clear.Red = clear.Green = clear.Blue = clear.Alpha = 0;
+		burner.SetColors(text, clear);
+		frame = src2vuy;
+		CHECK(burner.BurnText(&frame[0], "Ch 1: 12", 101, 200, 1, true));
+		CHECK(frame != src2vuy);
+		CHECK(std::equal(frame.begin(), frame.begin() + 200 * width * 2, src2vuy.begin()));
+		std::vector<uint8_t> burned(frame);
+		CHECK(burner.BurnText(&frame[0], "Ch 1: 12", 101, 200, 1));			//	Blending again would change it
+		CHECK(frame == burned);
+
+		std::vector<uint8_t> expected(src2vuy);
+		CHECK(burner.BurnText(&expected[0], "Ch 1: 13 fps", 100, 200, 1, true));
+		CHECK(burner.BurnText(&frame[0], "Ch 1: 13 fps", 101, 200, 1));
+		CHECK(frame == expected);
+		expected = src2vuy;
+		CHECK(burner.BurnText(&expected[0], "Ch 1", 100, 200, 1, true));
+		CHECK(burner.BurnText(&frame[0], "Ch 1", 101, 200, 1));
+		CHECK(frame == expected);
+		expected = src2vuy;
+		CHECK(burner.BurnText(&expected[0], "Ch 1", 300, 400, 1, true));
+		CHECK(burner.BurnText(&frame[0], "Ch 1", 300, 400, 1));
+		CHECK(frame == expected);
+		CHECK(burner.BurnText(&frame[0], "", 300, 400, 1));
+		CHECK(frame == src2vuy);
+
+		//	Each format round-trips the raster exactly where nothing is drawn
+		const AJA_PixelFormat formats[] = {AJA_PixelFormat_YUY28, AJA_PixelFormat_YCbCr10, AJA_PixelFormat_YCBCR8_420PL3,
+											AJA_PixelFormat_YCBCR8_422PL2, AJA_PixelFormat_YCBCR10_420PL3LE, AJA_PixelFormat_YCBCR10_420PL2LE,
+											AJA_PixelFormat_ARGB8, AJA_PixelFormat_RGB8_PACK, AJA_PixelFormat_RGB10, AJA_PixelFormat_RGB_DPX,
+											AJA_PixelFormat_RGB12, AJA_PixelFormat_YCBCR10_420PL};
+		for (size_t fmt = 0; fmt < sizeof(formats) / sizeof(formats[0]); fmt++)
+		{
+			std::vector<uint8_t> raster(AJA_CalcRowBytesForFormat(formats[fmt], width) * height);
+			if (!AJA_ConvertYCbCrFrame(&src2vuy[0], AJA_PixelFormat_YCbCr8, &raster[0], formats[fmt], width, height))
+				for (size_t ndx = 0; ndx < raster.size(); ndx++)
+					raster[ndx] = uint8_t(ndx * 7919 >> 3);
+			const std::vector<uint8_t> original(raster);
+			CHECK(burner.SetRasterFormat(formats[fmt], width, height));
+			burner.SetColors(clear, clear);
+			CHECK(burner.BurnText(&raster[0], "Hello", 0, 0, 0, true));
+			CHECK(raster == original);
+			burner.SetColors(text, clear);
+			CHECK(burner.BurnText(&raster[0], "Hello", 0, 0, 0, true));
+			CHECK(raster != original);
+			CHECK(burner.BurnText(&raster[0], "", 0, 0));
+			CHECK(raster == original);
+		}
+
+		//	Opaque white luma in the 10-bit formats
+		AJA_RGBAlphaPixel white;
+		white.Red = white.Green = white.Blue = white.Alpha = 0xFF;
+		std::vector<uint8_t> p010(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCBCR10_420PL2LE, width) * height);
+		CHECK(burner.SetRasterFormat(AJA_PixelFormat_YCBCR10_420PL2LE, width, height));
+		burner.SetColors(white, clear);
+		CHECK(burner.BurnText(&p010[0], "1", 0, 0, 0, true));
+		const uint32_t dot(14 * 6 * width + 12 * 3);							//	Dot 12 of font row 14 is lit in '1'
+		CHECK_EQ(p010[2 * dot] | (p010[2 * dot + 1] << 8), 940 << 6);
+		std::vector<uint8_t> v210(AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCbCr10, width) * height);
+		CHECK(burner.SetRasterFormat(AJA_PixelFormat_YCbCr10, width, height));
+		CHECK(burner.BurnText(&v210[0], "1", 0, 0, 0, true));
+		const uint32_t * pWords(reinterpret_cast<const uint32_t*>(&v210[14 * 6 * AJA_CalcRowBytesForFormat(AJA_PixelFormat_YCbCr10, width)]));
+		CHECK_EQ((pWords[(12 * 3) / 6 * 4] >> 10) & 0x3FF, 940);				//	Y0 of the v210 group holding pixel 36
+	}
+
+} //timecodeburn
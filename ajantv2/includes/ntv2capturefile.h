@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2capturefile.h
+	@brief		Declares the CNTV2CaptureFileWriter and CNTV2CaptureFileReader classes, and the capture file format.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+#ifndef NTV2CAPTUREFILE_H
+#define NTV2CAPTUREFILE_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include "ajabase/system/file_io.h"
+#include <string>
+#include <vector>
+
+/**
+	@page	ntv2capturefileformat	NTV2 Capture File Format
+
+	An NTV2 capture file holds a sequence of captured frames, each with its video, audio, F1 and F2 ancillary data,
+	frame stamp and timecodes, followed by an index for random access. Everything is little-endian, and every
+	structure and section starts on a ::NTV2_CAPTUREFILE_ALIGNMENT boundary, so the file can be written with
+	unbuffered (direct) I/O, and each section of a memory-mapped file is page-aligned (suitable for DMA).
+
+	-	<b>File header</b> (::NTV2CaptureFileHeader), at offset zero, padded to ::NTV2_CAPTUREFILE_ALIGNMENT bytes.
+	-	<b>Frame records</b>, one per frame, back to back. Each starts with an ::NTV2CaptureFileRecord, followed by
+		its video, audio, ancillary F1 and ancillary F2 sections (at the offsets given in the record, each padded).
+	-	<b>Index</b>, an array of ::NTV2CaptureFileIndexEntry (one per record), at the offset given in the file
+		header's fIndexOffset. The header's fIndexOffset and fFrameCount are only filled in when the file is
+		closed; a reader rebuilds the index by walking the records if they're zero (e.g. after a crash).
+**/
+
+#define	NTV2_CAPTUREFILE_MAGIC			"NTV2CAPF"	///< @brief	NTV2CaptureFileHeader::fMagic
+#define	NTV2_CAPTUREFILE_RECORD_MAGIC	"FRAM"		///< @brief	NTV2CaptureFileRecord::fMagic
+#define	NTV2_CAPTUREFILE_VERSION		1			///< @brief	NTV2CaptureFileHeader::fVersion
+#define	NTV2_CAPTUREFILE_ALIGNMENT		4096		///< @brief	Alignment of every structure and section, in bytes
+#define	NTV2_CAPTUREFILE_MAX_TIMECODES	32			///< @brief	Timecode slots per record, indexed by NTV2TCIndex
+
+/**
+	@brief	The capture file header, at the start of the file. Describes the content of every frame record.
+**/
+typedef struct NTV2CaptureFileHeader
+{
+	char		fMagic[8];				///< @brief	NTV2_CAPTUREFILE_MAGIC
+	ULWord		fVersion;				///< @brief	NTV2_CAPTUREFILE_VERSION
+	ULWord		fAlignment;				///< @brief	NTV2_CAPTUREFILE_ALIGNMENT
+	ULWord		fVideoFormat;			///< @brief	NTV2VideoFormat of the video
+	ULWord		fPixelFormat;			///< @brief	NTV2PixelFormat of the video
+	ULWord		fWidth;					///< @brief	Video width, in pixels (zero if unknown)
+	ULWord		fHeight;				///< @brief	Video height, in lines (zero if unknown)
+	ULWord		fRowBytes;				///< @brief	Video bytes per line (zero if unknown)
+	ULWord		fNumAudioChannels;		///< @brief	Audio channels (interleaved 32-bit samples, as captured)
+	ULWord		fAudioSampleRate;		///< @brief	Audio sample rate, in Hz
+	ULWord		fReserved;
+	ULWord64	fFrameCount;			///< @brief	Number of frame records (zero if not closed cleanly)
+	ULWord64	fIndexOffset;			///< @brief	File offset of the index (zero if not closed cleanly)
+	char		fDescription[256];		///< @brief	Application-defined, NUL-terminated
+} NTV2CaptureFileHeader;
+
+/**
+	@brief	The header of each frame record. Section offsets are from the start of the record.
+**/
+typedef struct NTV2CaptureFileRecord
+{
+	char		fMagic[4];				///< @brief	NTV2_CAPTUREFILE_RECORD_MAGIC
+	ULWord		fRecordBytes;			///< @brief	Size of the whole record, including padding
+	ULWord64	fFrameNumber;			///< @brief	Zero-based position in the file
+	ULWord		fVideoOffset,	fVideoBytes;	///< @brief	Video section
+	ULWord		fAudioOffset,	fAudioBytes;	///< @brief	Audio section
+	ULWord		fAncF1Offset,	fAncF1Bytes;	///< @brief	Ancillary data field 1 section
+	ULWord		fAncF2Offset,	fAncF2Bytes;	///< @brief	Ancillary data field 2 section
+	//	From the FRAME_STAMP:
+	LWord64		fFrameTime;				///< @brief	FRAME_STAMP::acFrameTime
+	LWord64		fCurrentTime;			///< @brief	FRAME_STAMP::acCurrentTime
+	ULWord64	fAudioClockTimeStamp;	///< @brief	FRAME_STAMP::acAudioClockTimeStamp
+	ULWord64	fUserCookie;			///< @brief	FRAME_STAMP::acCurrentUserCookie
+	ULWord		fAudioInStartAddress;	///< @brief	FRAME_STAMP::acAudioInStartAddress
+	ULWord		fAudioInStopAddress;	///< @brief	FRAME_STAMP::acAudioInStopAddress
+	ULWord		fStartSample;			///< @brief	FRAME_STAMP::acStartSample
+	ULWord		fCurrentReps;			///< @brief	FRAME_STAMP::acCurrentReps (frames dropped)
+	ULWord		fFrame;					///< @brief	FRAME_STAMP::acFrame (device frame buffer number)
+	ULWord		fTimeCodeMask;			///< @brief	Bit N set if fTimeCodes[N] was captured
+	NTV2_RP188	fTimeCodes[NTV2_CAPTUREFILE_MAX_TIMECODES];	///< @brief	Captured timecodes, indexed by NTV2TCIndex
+} NTV2CaptureFileRecord;
+
+/**
+	@brief	One entry in the index at the end of the file.
+**/
+typedef struct NTV2CaptureFileIndexEntry
+{
+	ULWord64	fOffset;				///< @brief	File offset of the frame record
+	LWord64		fFrameTime;				///< @brief	The record's fFrameTime, for seeking by time
+} NTV2CaptureFileIndexEntry;
+
+
+/**
+	@brief	The content of one frame to write with CNTV2CaptureFileWriter::WriteFrame. The buffers aren't retained.
+**/
+typedef struct AJAExport NTV2CaptureFrame
+{
+	NTV2Buffer		fVideo;				///< @brief	Video data (may be empty)
+	NTV2Buffer		fAudio;				///< @brief	Audio data (may be empty)
+	NTV2Buffer		fAncF1;				///< @brief	Ancillary data, field 1 (may be empty)
+	NTV2Buffer		fAncF2;				///< @brief	Ancillary data, field 2 (may be empty)
+	FRAME_STAMP		fFrameStamp;		///< @brief	Frame stamp
+	NTV2TimeCodes	fTimeCodes;			///< @brief	Timecodes
+
+	/**
+		@brief		Refers to the buffers, byte counts, frame stamp and timecodes of the given completed capture transfer.
+		@param[in]	inXfer	Specifies the AUTOCIRCULATE_TRANSFER that was passed to CNTV2Card::AutoCirculateTransfer.
+	**/
+	void			Set (const AUTOCIRCULATE_TRANSFER & inXfer);
+} NTV2CaptureFrame;
+
+
+/**
+	@brief	Writes an NTV2 capture file (see @ref ntv2capturefileformat) with unbuffered, asynchronous I/O.
+			WriteFrame copies the frame into one of a small pool of aligned record buffers, hands it to the
+			file's asynchronous I/O engine (see AJAFileIO::WriteAsync), and returns without waiting for the disk
+			(unless every buffer is still being written).
+**/
+class AJAExport CNTV2CaptureFileWriter
+{
+	public:
+									CNTV2CaptureFileWriter ();
+		virtual						~CNTV2CaptureFileWriter ();		///< @brief	Closes the file (if open).
+
+		/**
+			@brief		Creates the file and writes its header.
+			@param[in]	inPath			Specifies the path of the file to create. An existing file is replaced.
+			@param[in]	inHeader		Specifies the header fields to write. Only the content-describing fields are used
+										(fVideoFormat through fAudioSampleRate, and fDescription).
+			@param[in]	inQueueDepth	Specifies the number of frames that can be in flight to the disk at once.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				Open (const std::string & inPath, const NTV2CaptureFileHeader & inHeader, const ULWord inQueueDepth = 4);
+
+		/**
+			@brief		Queues the given frame to be written.
+			@param[in]	inFrame		Specifies the frame content.
+			@return		True if successful;  false if not open, or if an earlier write failed.
+		**/
+		virtual bool				WriteFrame (const NTV2CaptureFrame & inFrame);
+
+		/**
+			@brief		Waits for all writes to finish, appends the index, completes the header, and closes the file.
+			@return		True if everything was written successfully;  otherwise false.
+		**/
+		virtual bool				Close (void);
+
+		virtual inline bool			IsOpen (void) const			{return mFile.IsOpen();}				///< @return	True if I'm open.
+		virtual inline ULWord64		GetFrameCount (void) const	{return ULWord64(mIndex.size());}		///< @return	The number of frames written (or queued).
+		virtual inline ULWord64		GetFileSize (void) const	{return mNextOffset;}					///< @return	The size of the file so far, in bytes.
+
+	protected:
+		virtual bool				Reap (const ULWord inMinCompletions);	///< @brief	Collects completed writes, recycling their buffers
+
+	private:
+									CNTV2CaptureFileWriter (const CNTV2CaptureFileWriter & inObj);		//	Not copyable
+		CNTV2CaptureFileWriter &	operator = (const CNTV2CaptureFileWriter & inRHS);					//	Not assignable
+
+		mutable AJAFileIO						mFile;
+		NTV2CaptureFileHeader					mHeader;
+		std::vector<NTV2Buffer*>				mBuffers;		///< @brief	Aligned record buffers
+		std::vector<ULWord>						mFree;			///< @brief	Indexes of buffers not being written
+		std::vector<NTV2CaptureFileIndexEntry>	mIndex;
+		ULWord64								mNextOffset;	///< @brief	Where the next record goes
+		bool									mFailed;		///< @brief	A write failed
+};	//	CNTV2CaptureFileWriter
+
+
+/**
+	@brief	A frame in a file opened by CNTV2CaptureFileReader. The buffers refer directly to the memory-mapped file,
+			so they're read-only, and only valid until the reader is closed.
+**/
+typedef struct AJAExport NTV2CaptureFileFrame
+{
+	const NTV2CaptureFileRecord *	fRecord;	///< @brief	The record header (frame stamp and timecodes)
+	NTV2Buffer						fVideo;		///< @brief	Video section
+	NTV2Buffer						fAudio;		///< @brief	Audio section
+	NTV2Buffer						fAncF1;		///< @brief	Ancillary data field 1 section
+	NTV2Buffer						fAncF2;		///< @brief	Ancillary data field 2 section
+
+	/**
+		@brief		Answers with a captured timecode.
+		@param[out]	outTimeCode		Receives the timecode.
+		@param[in]	inTCIndex		Specifies which timecode.
+		@return		True if that timecode was captured;  otherwise false.
+	**/
+	bool							GetTimeCode (NTV2_RP188 & outTimeCode, const NTV2TCIndex inTCIndex = NTV2_TCINDEX_SDI1) const;
+} NTV2CaptureFileFrame;
+
+
+/**
+	@brief	Reads an NTV2 capture file (see @ref ntv2capturefileformat) by memory-mapping it, so frames are never copied,
+			and any frame can be reached in constant time through the index.
+**/
+class AJAExport CNTV2CaptureFileReader
+{
+	public:
+									CNTV2CaptureFileReader ();
+		virtual						~CNTV2CaptureFileReader ();		///< @brief	Closes the file (if open).
+
+		/**
+			@brief		Opens and maps the file, and loads its index (or rebuilds it, if the file wasn't closed cleanly).
+			@param[in]	inPath		Specifies the path of the file to open.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				Open (const std::string & inPath);
+		virtual void				Close (void);		///< @brief	Unmaps and closes the file.
+
+		virtual inline bool			IsOpen (void) const			{return mpBase != AJA_NULL;}		///< @return	True if I'm open.
+		virtual inline ULWord64		GetFrameCount (void) const	{return ULWord64(mIndex.size());}	///< @return	The number of frames in the file.
+		virtual inline bool			WasRecovered (void) const	{return mRecovered;}				///< @return	True if the index had to be rebuilt.
+
+		/**
+			@return		The file header, describing every frame's content.
+		**/
+		virtual const NTV2CaptureFileHeader &	GetHeader (void) const;
+
+		/**
+			@brief		Answers with the given frame.
+			@param[in]	inFrameNumber	Specifies the zero-based frame number.
+			@param[out]	outFrame		Receives the frame, referring to the mapped file.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				GetFrame (const ULWord64 inFrameNumber, NTV2CaptureFileFrame & outFrame) const;
+
+		/**
+			@brief		Answers with the number of the last frame captured at or before the given time.
+			@param[in]	inFrameTime		Specifies the time, in FRAME_STAMP::acFrameTime units.
+			@param[out]	outFrameNumber	Receives the frame number.
+			@return		True if successful;  false if the file is empty, or every frame is later.
+		**/
+		virtual bool				FindFrame (const LWord64 inFrameTime, ULWord64 & outFrameNumber) const;
+
+	protected:
+		virtual bool				IsValidRecord (const ULWord64 inOffset) const;
+
+	private:
+									CNTV2CaptureFileReader (const CNTV2CaptureFileReader & inObj);		//	Not copyable
+		CNTV2CaptureFileReader &	operator = (const CNTV2CaptureFileReader & inRHS);					//	Not assignable
+
+		const UByte *							mpBase;			///< @brief	Start of the mapping
+		ULWord64								mMappedBytes;	///< @brief	Size of the mapping
+		std::vector<NTV2CaptureFileIndexEntry>	mIndex;
+		bool									mRecovered;
+};	//	CNTV2CaptureFileReader
+
+#endif	//	NTV2CAPTUREFILE_H
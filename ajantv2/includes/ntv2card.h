@@ -130,6 +130,17 @@ public:
 	**/
 	AJA_VIRTUAL bool				GetPCIDeviceID (ULWord & outPCIDeviceID);
 
+	/**
+		@brief	Answers with the NUMA node of the PCIe slot I'm plugged into. Threads and host buffers that
+				stream to or from me perform best on this node (see AJAThread::SetNUMANode and the NUMA form
+				of AJAMemory::AllocateAligned).
+		@param[out]		outNode		Receives my NUMA node number, or -1 if it's unknown.
+		@return True if successful;	 otherwise false (e.g. non-NUMA host, remote device, or unsupported platform).
+		@note	Currently implemented only on Linux, where the node is read from sysfs. Older drivers
+				that don't link their device node to the PCI device always fail.
+	**/
+	AJA_VIRTUAL bool				GetNUMANode (int & outNode);
+
 	/**
 		@return My current breakout box hardware type, if any is attached.
 	**/
@@ -288,6 +299,20 @@ public:
 											const ULWord	inSegmentHostPitch,
 											const ULWord	inSegmentCardPitch);
 
+	/**
+		@brief		Transfers a region of a device frame, such as a rectangular crop of the raster or every Nth line of it,
+					into a compact host buffer.
+		@param[in]	inFrameNumber		Specifies the zero-based frame number of the frame to be read from the device.
+		@param		outBuffer			Specifies the host buffer that is to receive the region. It must be large enough to hold it.
+		@param[in]	inSegmentInfo		Specifies the region to transfer, typically from NTV2FormatDescriptor::GetRegionOfInterestXferInfo.
+										The source aspect describes the device frame, and the destination aspect the host buffer.
+		@return		True if successful; otherwise false.
+		@note		This function will block and not return until the transfer has finished or failed.
+		@see		CNTV2Card::DMAReadSegments, AUTOCIRCULATE_TRANSFER::SetVideoRegionOfInterest, \ref vidop-fbaccess
+	**/
+	AJA_VIRTUAL bool	DMAReadRegionOfInterest (const ULWord inFrameNumber, NTV2Buffer & outBuffer,
+												const NTV2SegmentedXferInfo & inSegmentInfo);	//	New in SDK 17.5
+
 	/**
 		@brief		Performs a segmented data transfer from the host to the AJA device.
 		@param[in]	inFrameNumber		Specifies the zero-based frame number of the frame to be written on the device.
@@ -4320,9 +4345,10 @@ public:
 					is connected to. A zero value in the register means that the input is not connected to anything.
 					To simplify this process of routing widgets on the device, a set of signal paths (i.e., interconnects)
 					are built and then applied to the device in this function call.
-					This function iterates over each connection that's specified in the given routing table and updates
-					the appropriate register in the device.
-		@see		\ref ntv2signalrouting, CNTV2SignalRouter
+					Only the crosspoints that differ from the device's current routing are written, all in one batch.
+					Connections the device doesn't support are skipped (and logged), the rest are applied, and
+					the function returns false.
+		@see		\ref ntv2signalrouting, CNTV2SignalRouter, CNTV2Card::ApplySignalRoute(const NTV2XptConnections&, const bool, NTV2XptConnections&)
 	**/
 	AJA_VIRTUAL bool	ApplySignalRoute (const CNTV2SignalRouter & inRouter, const bool inReplace = false);
 
@@ -4341,16 +4367,36 @@ public:
 					is connected to. A zero value in the register means that the input is not connected to anything.
 					To simplify this process of routing widgets on the device, a set of signal paths (i.e., interconnects)
 					are built and then applied to the device in this function call.
-					This function iterates over each connection that's specified in the given routing table and updates
-					the appropriate register in the device.
-		@see		\ref ntv2signalrouting
+					Only the crosspoints that differ from the device's current routing are written, all in one batch.
+					Connections the device doesn't support are skipped (and logged), the rest are applied, and
+					the function returns false. To apply all of them or none, call CNTV2Card::ApplySignalRoute(const NTV2XptConnections&, const bool, NTV2XptConnections&).
+		@see		\ref ntv2signalrouting, CNTV2Card::ApplySignalRoute(const NTV2XptConnections&, const bool, NTV2XptConnections&)
 	**/
 	AJA_VIRTUAL bool	ApplySignalRoute (const NTV2XptConnections & inConnections, const bool inReplace = false);
 
+	/**
+		@brief		Applies the given widget routing connections to the AJA device as a single transaction.
+		@return		True if successful; otherwise false.
+		@param[in]	inConnections	Specifies the routing connections to be applied to the device.
+		@param[in]	inReplace		If true, existing connections whose input isn't in "inConnections" are disconnected.
+									If false, they're left alone.
+		@param[out]	outChanges		Receives the connections that were written (disconnects are to ::NTV2_XptBlack).
+		@details	The current routing is read in one batch, and the whole desired routing is validated against the
+					device's widgets (and its crosspoint ROM, if it has one) before anything is written. Then only the
+					crosspoints that differ are written, with one masked write per crosspoint select register, in a
+					single call to CNTV2Card::WriteRegisters. This avoids the intermediate states (and the many register
+					accesses) of calling CNTV2Card::Connect for each connection.
+		@see		\ref ntv2signalrouting, CNTV2SignalRouter::DiffConnections, CNTV2SignalRouter::ValidateConnections,
+					CNTV2SignalRouter::SolveRoute
+	**/
+	AJA_VIRTUAL bool	ApplySignalRoute (const NTV2XptConnections & inConnections, const bool inReplace, NTV2XptConnections & outChanges);	//	New in SDK 17.5
+
 	/**
 		@brief		Removes the given widget routing connections from the AJA device.
 		@return		True if successful; otherwise false.
 		@param[in]	inConnections	Specifies the routing connections to be removed from the device.
+		@details	The inputs are disconnected in one batch. Inputs the device doesn't have are skipped (and logged),
+					and the function returns false.
 		@see		\ref ntv2signalrouting
 	**/
 	AJA_VIRTUAL bool	RemoveConnections (const NTV2XptConnections & inConnections);
@@ -6592,7 +6638,47 @@ private:
 
 	AJA_VIRTUAL bool	IsMultiFormatActive (void); ///< @return	True if the device supports the multi format feature and it's enabled; otherwise false.
 	AJA_VIRTUAL bool	CopyVideoFormat(const NTV2Channel inSrc, const NTV2Channel inFirst, const NTV2Channel inLast);
+
+	//	AutoCirculateTransfer per-channel context (New in SDK 17.5)
+	typedef struct ACXferContext
+	{
+		uint32_t				fPrepared;		///< @brief	ACXferStale, ACXferPreparing or ACXferPrepared (read & written atomically)
+		NTV2Crosspoint			fCrosspoint;	///< @brief	The channel's AutoCirculate crosspoint
+		NTV2EveryFrameTaskMode	fTaskMode;		///< @brief	Task mode
+		bool					fIsProgressive;	///< @brief	True if playout channel's standard is progressive
+		bool					fIs2110;		///< @brief	True if SMPTE 2110 device
+		bool					fIsIoIP2110;	///< @brief	True if IoIP 2110 device
+		size_t					fF1AncBytes;	///< @brief	2110 playout F1 anc buffer size
+		size_t					fF2AncBytes;	///< @brief	2110 playout F2 anc buffer size
+		NTV2Buffer				fAncF1;			///< @brief	2110 scratch F1 anc buffer, used in lieu of a missing or too-small client buffer
+		NTV2Buffer				fAncF2;			///< @brief	2110 scratch F2 anc buffer, used in lieu of a missing or too-small client buffer
+		NTV2Buffer				fSavedAncF1;	///< @brief	Saved content of client's 2110 playout F1 anc buffer
+		NTV2Buffer				fSavedAncF2;	///< @brief	Saved content of client's 2110 playout F2 anc buffer
+		ACXferContext() : fPrepared(0), fCrosspoint(NTV2CROSSPOINT_INVALID), fTaskMode(NTV2_OEM_TASKS), fIsProgressive(false),
+						fIs2110(false), fIsIoIP2110(false), fF1AncBytes(0), fF2AncBytes(0)	{}
+	} ACXferContext;
+
+	/**
+		@brief		Caches everything AutoCirculateTransfer needs to know about the channel that doesn't change
+					between transfers, so that steady-state transfers need no register reads or heap allocations.
+		@param[in]	inChannel	Specifies the channel (FrameStore) of interest.
+		@return		True if successful;	 otherwise false.
+	**/
+	AJA_VIRTUAL bool	PrepareACXferContext (const NTV2Channel inChannel);
+	AJA_VIRTUAL void	InvalidateACXferContext (const NTV2Channel inChannel = NTV2_CHANNEL_INVALID);	///< @brief	Invalidates one (or all) channel's cached transfer context
+
+	/**
+		@brief		Writes the crosspoints that differ between the device's current routing and the given connections,
+					in one batch. Used by CNTV2Card::ApplySignalRoute, after it has validated the connections.
+		@param[in]	inConnections	Specifies the desired routing connections.
+		@param[in]	inReplace		If true, existing connections whose input isn't in "inConnections" are disconnected.
+		@param[out]	outChanges		Receives the connections that were written.
+		@return		True if successful;	 otherwise false.
+	**/
+	AJA_VIRTUAL bool	WriteRoutingChanges (const NTV2XptConnections & inConnections, const bool inReplace, NTV2XptConnections & outChanges);
+
 	class DeviceCapabilities	mDevCap;
+	ACXferContext				mACXferContexts[NTV2_MAX_NUM_CHANNELS];
 };	//	CNTV2Card
 
 
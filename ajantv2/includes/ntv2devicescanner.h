@@ -231,8 +231,48 @@ AJAExport	std::ostream &	operator << (std::ostream & inOutStr, const NTV2AudioPh
 #endif	//	!defined(NTV2_DEPRECATE_17_1)
 
 
+/**
+	@brief	Identifies the AJA devices that CNTV2DeviceScanner keeps in its device inventory. The default source
+			opens the local host's devices by index number. Install a different one using CNTV2DeviceScanner::SetDeviceSource,
+			e.g. to simulate devices being attached and detached.
+	@note	New in SDK 17.5.
+**/
+class AJAExport NTV2DeviceSource
+{
+	public:
+		virtual			~NTV2DeviceSource ()	{}
+
+		/**
+			@brief		Cheaply identifies the device at the given index number, without probing its capabilities.
+			@return		True if there's a device at the given index;  false if not, which ends the scan.
+			@param[in]	inIndex				Specifies the zero-based device index number.
+			@param[out]	outDeviceID			Receives the device's ID.
+			@param[out]	outSerialNumber		Receives the device's serial number, or an empty string if it has none.
+		**/
+		virtual bool	IdentifyDevice (const ULWord inIndex, NTV2DeviceID & outDeviceID, std::string & outSerialNumber) = 0;
+
+		/**
+			@brief		Opens the device at the given index number, to probe its capabilities or hand it to a client.
+			@return		True if successful; otherwise false.
+			@param[in]	inIndex				Specifies the zero-based device index number.
+			@param[out]	outDevice			Receives the open CNTV2Card instance.
+		**/
+		virtual bool	OpenDevice (const ULWord inIndex, CNTV2Card & outDevice) = 0;
+
+		/**
+			@return		True if I call CNTV2DeviceScanner::DevicesChanged whenever devices are attached or detached,
+						so the scanner can trust its inventory in between;  otherwise false.
+		**/
+		virtual bool	IsMonitored (void) const	{return false;}
+};	//	NTV2DeviceSource
+
+
 /**
 	@brief	This class is used to enumerate AJA devices that are attached and known to the local host computer.
+	@note	Each device is probed once, when it first appears, and its information is cached in a device inventory.
+			Lookups re-identify the attached devices (without re-probing the ones already known), unless hot-plug
+			monitoring is enabled (see EnableHotplug), in which case they trust the inventory until a device is
+			attached or detached.
 **/
 class AJAExport CNTV2DeviceScanner
 {
@@ -295,7 +335,45 @@ public:
 	**/
 	static bool									GetFirstDeviceFromArgument (const std::string & inArgument, CNTV2Card & outDevice);
 
-	static size_t		GetNumDevices (void);	///< @deprecated	Do not use
+	static size_t		GetNumDevices (void);	///< @return	The number of devices in the inventory, rescanning only if it may be stale.
+
+	/**
+		@brief		Returns the device ID and serial number of a device in the inventory, rescanning only if it may be stale.
+		@return		True if successful; otherwise false.
+		@param[in]	inDeviceIndexNumber Specifies the device using a zero-based index number.
+		@param[out] outDeviceID			Receives the device's ID.
+		@param[out] outSerialNumber		Receives the device's serial number, or an empty string if it has none.
+	**/
+	static bool			GetDeviceIdentity (const ULWord inDeviceIndexNumber, NTV2DeviceID & outDeviceID, std::string & outSerialNumber);	//	New in SDK 17.5
+
+	/**
+		@brief		Re-identifies the attached devices, probing only those not already in the inventory.
+		@return		True if any devices were attached, detached or re-numbered;  otherwise false.
+	**/
+	static bool			Refresh (void);	//	New in SDK 17.5
+
+	/**
+		@brief		Tells the scanner that devices may have been attached or detached, so the next lookup rescans.
+					Called by the hot-plug monitor (see EnableHotplug), and by device sources that monitor their devices
+					(see NTV2DeviceSource::IsMonitored).
+	**/
+	static void			DevicesChanged (void);	//	New in SDK 17.5
+
+	/**
+		@brief		Starts or stops monitoring the host for devices being attached or detached (see AJAPnp).
+					While monitoring, lookups use the inventory without rescanning until a device comes or goes.
+		@return		True if successful; otherwise false.
+		@param[in]	inEnable	Specify true to start monitoring, false to stop.
+		@note		macOS:  requires a run loop.  Windows:  doesn't work in a service.
+	**/
+	static bool			EnableHotplug (const bool inEnable = true);	//	New in SDK 17.5
+
+	/**
+		@brief		Replaces the source of devices, discarding the inventory.
+		@param		pInSource	Specifies the device source, which must outlive its use. Specify NULL to restore the
+								default source (the local host's devices).
+	**/
+	static void			SetDeviceSource (NTV2DeviceSource * pInSource);	//	New in SDK 17.5
 
 	/**
 		@param[in]	inDevice			The CNTV2Card instance that's open for the device of interest.
@@ -349,6 +427,8 @@ private:
 	static bool 	GetCP2ConfigPath(string & outCP2ConfigPath);
 #endif	//	defined(VIRTUAL_DEVICES_SUPPORT)
 #endif	//	!defined(NTV2_DEPRECATE_17_1)
+private:
+	static bool		UpdateDeviceInventory (const bool inForce = false, const bool inReprobe = false);
 };	//	CNTV2DeviceScanner
 
 #endif	//	NTV2DEVICESCANNER_H
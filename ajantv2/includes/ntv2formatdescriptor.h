@@ -294,6 +294,27 @@ public:
 	**/
 	NTV2SegmentedXferInfo &			GetSegmentedXferInfo (NTV2SegmentedXferInfo & inSegmentInfo, const bool inIsSource = true) const;
 
+	/**
+		@brief		Sets the given ::NTV2SegmentedXferInfo to transfer a rectangular region of my visible raster,
+					optionally keeping only every Nth line, into a compact, tightly-packed destination buffer.
+		@param[out]	outSegmentInfo	Receives the segmented transfer info. The source describes my raster (i.e. the device
+									frame buffer), and the destination describes the compact host buffer.
+		@param[in]	inLeft			Specifies the left edge of the region, in pixels.
+		@param[in]	inTop			Specifies the top edge of the region, in visible raster lines.
+		@param[in]	inWidth			Specifies the width of the region, in pixels.
+		@param[in]	inHeight		Specifies the height of the region, in visible raster lines.
+		@param[in]	inLineStep		Optionally specifies that only every Nth line of the region is transferred.
+									Defaults to 1 (every line). Use 2 with an inTop of 0 or 1 to transfer a single field.
+		@return		True if successful;  otherwise false.
+		@note		The region's left edge and width must fall on a pixel boundary that starts a whole 32-bit word
+					(e.g. multiples of 6 pixels for ::NTV2_FBF_10BIT_YCBCR, or 2 pixels for ::NTV2_FBF_8BIT_YCBCR).
+					Planar and compressed pixel formats are not supported.
+	**/
+	bool							GetRegionOfInterestXferInfo (NTV2SegmentedXferInfo & outSegmentInfo,
+																const ULWord inLeft, const ULWord inTop,
+																const ULWord inWidth, const ULWord inHeight,
+																const ULWord inLineStep = 1) const;	//	New in SDK 17.5
+
 	/**
 		@return	True if I'm equal to the given NTV2FormatDescriptor.
 		@param[in]	inRHS	The right-hand-side operand that I'll be compared with.
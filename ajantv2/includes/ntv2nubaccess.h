@@ -20,6 +20,7 @@ typedef std::pair<NTV2DeviceID, ULWord64>		NTV2DeviceIDSerialPair;		///< @brief
 typedef std::vector<NTV2DeviceIDSerialPair>		NTV2DeviceIDSerialPairs;	///< @brief	An ordered sequence of NTV2DeviceIDSerialPairs
 typedef NTV2DeviceIDSerialPairs::iterator		NTV2DeviceIDSerialPairsIter;
 typedef NTV2DeviceIDSerialPairs::const_iterator	NTV2DeviceIDSerialPairsConstIter;
+typedef uint64_t								NTV2RPCRequestID;			///< @brief	Identifies an outstanding pipelined RPC request (zero is invalid)
 
 //	Supported NTV2ConnectParams:
 #define	kConnectParamScheme		"Scheme"		///< @brief	URL scheme
@@ -237,6 +238,8 @@ class AJAExport NTV2RPCBase
 };	//	NTV2RPCBase
 
 
+class NTV2RPCClientPipe;	//	Private pipelining state
+
 /**
 	@brief	An object that can connect to, and operate remote or fake devices. I have three general API groups:
 			-	connection:  NTV2Connect, IsConnected, NTV2Disconnect;
@@ -347,8 +350,90 @@ class AJAExport NTV2RPCClientAPI : public NTV2RPCBase
 		virtual bool	NTV2OpenRemote	(void);
 		virtual bool	NTV2CloseRemote	(void);
 
+	public:
+		/**
+			@name	Batched & Pipelined Device Operation (New in SDK 17.5)
+			@details	These let a client have many requests in flight at once, instead of paying one network round-trip
+						per register access. Plugins whose transports support it should override NTV2SubmitMessageRemote
+						to send the request without waiting for its reply, then call PostCompletion from their receive
+						thread when the reply arrives (or CancelRequest if it can't be sent). The base class implementations are synchronous, so existing plugins
+						work unchanged.
+			@note		These are declared after all older virtual functions, so plugins built against earlier SDKs
+						keep their vtable layout.
+		**/
+		///@{
+		/**
+			@brief		Reads all of the given registers using a single NTV2GetRegisters message (falls back to individual reads).
+			@param[in,out]	inOutValues		Specifies the registers to read, and receives their values.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool	NTV2ReadRegistersRemote (NTV2RegReads & inOutValues);
+
+		/**
+			@brief		Writes all of the given registers using a single NTV2SetRegisters message (falls back to individual writes).
+			@param[in]	inRegWrites			Specifies the register writes to perform, in order.
+			@param[out]	outFailedWrites		Receives the register writes that failed, if any.
+			@return		True if all writes succeeded;  otherwise false.
+		**/
+		virtual bool	NTV2WriteRegistersRemote (const NTV2RegWrites & inRegWrites, NTV2RegWrites & outFailedWrites);
+
+		/**
+			@brief		Submits the given message to the remote/fake device without waiting for its completion.
+			@param		pInMessage		Points to the message. It, and any buffers it references, must remain valid
+										until NTV2CompleteMessageRemote returns for the request.
+			@param[out]	outRequestID	Receives the request identifier to pass to NTV2CompleteMessageRemote.
+			@return		True if the request was successfully submitted;  otherwise false.
+		**/
+		virtual bool	NTV2SubmitMessageRemote (NTV2_HEADER * pInMessage, NTV2RPCRequestID & outRequestID);
+
+		/**
+			@brief		Waits for a request previously submitted by NTV2SubmitMessageRemote to complete.
+			@param[in]	inRequestID		Specifies the request to wait for.
+			@param[in]	inTimeoutMs		Specifies the maximum time to wait, in milliseconds.
+			@return		True if the request completed successfully;  false if it failed or timed out. Returns false
+						immediately if the request isn't pending (e.g. it was never submitted, or was already collected).
+		**/
+		virtual bool	NTV2CompleteMessageRemote (const NTV2RPCRequestID inRequestID, const ULWord inTimeoutMs = 0xFFFFFFFF);
+
+		/**
+			@return		The number of submitted requests that haven't yet been collected by NTV2CompleteMessageRemote.
+		**/
+		virtual size_t	NTV2OutstandingRemote (void) const;
+
+		/**
+			@brief		Requests the remote host to push notifications for the given interrupt, instead of having
+						NTV2WaitForInterruptRemote poll for it.
+			@param[in]	inInterrupt		Specifies the interrupt of interest.
+			@param[in]	inSubscribe		Specify true to subscribe, false to unsubscribe. Defaults to true.
+			@return		True if successful;  false if unsupported (the default) or failed.
+			@note		Plugins that support server-pushed interrupts override this to notify their server, then call
+						SetInterruptSubscribed. Their receive thread calls PostInterrupt for each notification, and their
+						NTV2WaitForInterruptRemote calls WaitForPostedInterrupt.
+		**/
+		virtual bool	NTV2SubscribeInterruptRemote (const INTERRUPT_ENUMS inInterrupt, const bool inSubscribe = true);
+
+		/**
+			@return		True if the given interrupt is currently being pushed to me by the remote host.
+		**/
+		virtual bool	IsInterruptSubscribed (const INTERRUPT_ENUMS inInterrupt) const;
+		///@}
+
+	protected:
+		/**
+			@name	Pipelining Support for Subclasses
+		**/
+		///@{
+		NTV2RPCRequestID	NextRequestID (void);	///< @return	A new, unique request identifier, counted as outstanding until collected or cancelled
+		bool				CancelRequest (const NTV2RPCRequestID inRequestID);	///< @brief	Forgets the given request, e.g. if it couldn't be sent. Call this before failing NTV2SubmitMessageRemote, so it isn't counted as outstanding.
+		bool				PostCompletion (const NTV2RPCRequestID inRequestID, const bool inSuccess);	///< @brief	Records completion of the given request, waking its waiter
+		bool				SetInterruptSubscribed (const INTERRUPT_ENUMS inInterrupt, const bool inSubscribed);	///< @brief	Starts/stops accepting pushed notifications for the given interrupt
+		bool				PostInterrupt (const INTERRUPT_ENUMS inInterrupt);	///< @brief	Records a server-pushed notification for the given interrupt, waking its waiter
+		bool				WaitForPostedInterrupt (const INTERRUPT_ENUMS inInterrupt, const ULWord inTimeoutMs);	///< @brief	Waits for a PostInterrupt for the given interrupt (returns at once if any were posted since the last wait)
+		///@}
+
 	protected:
-		uint32_t	mSpare[1024];		///< @brief	Reserved
+		NTV2RPCClientPipe *	mpPipe;		///< @brief	My pipelining state (takes the place of the first mSpare words)
+		uint32_t	mSpare[1024 - sizeof(void*) / sizeof(uint32_t)];	///< @brief	Reserved
 };	//	NTV2RPCClientAPI
 
 typedef NTV2RPCClientAPI NTV2RPCAPI;
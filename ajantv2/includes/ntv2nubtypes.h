@@ -10,6 +10,10 @@
 
 #include "ntv2endian.h"
 #include <vector>
+#include <cstring>
+#if defined(__SSSE3__)
+	#include <tmmintrin.h>
+#endif	//	__SSSE3__
 
 #define NTV2NUBPORT		7575	//	Default port we listen on
 
@@ -77,7 +81,7 @@ namespace ntv2nub
 
 	inline void POPU64 (uint64_t & outVal, const std::vector<uint8_t> & inArr, std::size_t & inOutNdx, const bool dontSwap = false)
 	{
-		uint32_t _u64(0);
+		uint64_t _u64(0);
 		UByte * _pU8(reinterpret_cast<UByte*>(&_u64));
 		_pU8[0] = inArr.at(inOutNdx++); _pU8[1] = inArr.at(inOutNdx++);
 		_pU8[2] = inArr.at(inOutNdx++); _pU8[3] = inArr.at(inOutNdx++);
@@ -86,6 +90,278 @@ namespace ntv2nub
 		outVal = (NTV2HostIsBigEndian || dontSwap) ? _u64 : NTV2EndianSwap64BtoH(_u64);
 	}
 
+	/**
+		@name	Bulk Encode/Decode
+		@brief	These reserve/bounds-check once per call, and byte-swap entire arrays (using SIMD, if available),
+				instead of handling one byte at a time like the PUSHUxx/POPUxx functions above.
+	**/
+	///@{
+	/**
+		@brief		Copies the given number of 32-bit values from one place to another, byte-swapping each one.
+		@param[in]	pInSrc		Points to the source values. Need not be aligned.
+		@param[out]	pOutDst		Points to the destination. Need not be aligned. Must not partially overlap the source.
+		@param[in]	inCount		Specifies the number of 32-bit values to copy & swap.
+	**/
+	inline void SwapCopyU32s (const void * pInSrc, void * pOutDst, const size_t inCount)
+	{
+		const UByte *	pSrc (reinterpret_cast<const UByte*>(pInSrc));
+		UByte *			pDst (reinterpret_cast<UByte*>(pOutDst));
+		size_t			ndx(0);
+#if defined(__SSSE3__)
+		const __m128i	kShuf (_mm_set_epi8(12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3));
+		for (;  ndx + 4 <= inCount;  ndx += 4)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx*4),
+							_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + ndx*4)), kShuf));
+#endif	//	__SSSE3__
+		for (;  ndx < inCount;  ndx++)
+		{	uint32_t u32(0);
+			std::memcpy(&u32, pSrc + ndx*4, 4);
+			u32 = NTV2EndianSwap32(u32);
+			std::memcpy(pDst + ndx*4, &u32, 4);
+		}
+	}
+
+	/**
+		@brief		Copies the given number of 64-bit values from one place to another, byte-swapping each one.
+		@param[in]	pInSrc		Points to the source values. Need not be aligned.
+		@param[out]	pOutDst		Points to the destination. Need not be aligned. Must not partially overlap the source.
+		@param[in]	inCount		Specifies the number of 64-bit values to copy & swap.
+	**/
+	inline void SwapCopyU64s (const void * pInSrc, void * pOutDst, const size_t inCount)
+	{
+		const UByte *	pSrc (reinterpret_cast<const UByte*>(pInSrc));
+		UByte *			pDst (reinterpret_cast<UByte*>(pOutDst));
+		size_t			ndx(0);
+#if defined(__SSSE3__)
+		const __m128i	kShuf (_mm_set_epi8(8,9,10,11,12,13,14,15, 0,1,2,3,4,5,6,7));
+		for (;  ndx + 2 <= inCount;  ndx += 2)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + ndx*8),
+							_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + ndx*8)), kShuf));
+#endif	//	__SSSE3__
+		for (;  ndx < inCount;  ndx++)
+		{	uint64_t u64(0);
+			std::memcpy(&u64, pSrc + ndx*8, 8);
+			u64 = NTV2EndianSwap64(u64);
+			std::memcpy(pDst + ndx*8, &u64, 8);
+		}
+	}
+
+	/**
+		@brief		Grows the capacity of the given blob, if necessary, to accommodate the given number of additional bytes.
+		@note		Call this once before a long run of PUSHUxx calls to avoid repeated reallocation.
+	**/
+	inline void RESERVE (std::vector<uint8_t> & inArr, const size_t inAdditionalBytes)
+	{
+		if (inArr.capacity() < inArr.size() + inAdditionalBytes)
+			inArr.reserve(inArr.size() + inAdditionalBytes);
+	}
+
+	inline void PUSHU8s (const void * pInVals, const size_t inCount, std::vector<uint8_t> & inArr)
+	{
+		if (!pInVals || !inCount)
+			return;
+		const uint8_t * pU8s (reinterpret_cast<const uint8_t*>(pInVals));
+		inArr.insert(inArr.end(), pU8s, pU8s + inCount);
+	}
+
+	inline void PUSHU32s (const uint32_t * pInVals, const size_t inCount, std::vector<uint8_t> & inArr, const bool dontSwap = false)
+	{
+		if (!pInVals || !inCount)
+			return;
+		if (NTV2HostIsBigEndian || dontSwap)
+			return PUSHU8s(pInVals, inCount * sizeof(uint32_t), inArr);
+		const size_t ndx (inArr.size());
+		inArr.resize(ndx + inCount * sizeof(uint32_t));
+		SwapCopyU32s(pInVals, &inArr[ndx], inCount);
+	}
+
+	inline void PUSHU64s (const uint64_t * pInVals, const size_t inCount, std::vector<uint8_t> & inArr, const bool dontSwap = false)
+	{
+		if (!pInVals || !inCount)
+			return;
+		if (NTV2HostIsBigEndian || dontSwap)
+			return PUSHU8s(pInVals, inCount * sizeof(uint64_t), inArr);
+		const size_t ndx (inArr.size());
+		inArr.resize(ndx + inCount * sizeof(uint64_t));
+		SwapCopyU64s(pInVals, &inArr[ndx], inCount);
+	}
+
+	/**
+		@return		True if the given blob has at least the given number of bytes remaining at the given index.
+	**/
+	inline bool CANPOP (const std::vector<uint8_t> & inArr, const std::size_t inNdx, const size_t inByteCount)
+	{
+		return inNdx <= inArr.size()  &&  inByteCount <= inArr.size() - inNdx;
+	}
+
+	inline bool POPU8s (void * pOutVals, const size_t inCount, const std::vector<uint8_t> & inArr, std::size_t & inOutNdx)
+	{
+		if (!CANPOP(inArr, inOutNdx, inCount))
+			return false;
+		if (inCount)
+			std::memcpy(pOutVals, &inArr[inOutNdx], inCount);
+		inOutNdx += inCount;
+		return true;
+	}
+
+	inline bool POPU32s (uint32_t * pOutVals, const size_t inCount, const std::vector<uint8_t> & inArr, std::size_t & inOutNdx, const bool dontSwap = false)
+	{
+		if (NTV2HostIsBigEndian || dontSwap)
+			return POPU8s(pOutVals, inCount * sizeof(uint32_t), inArr, inOutNdx);
+		if (!CANPOP(inArr, inOutNdx, inCount * sizeof(uint32_t)))
+			return false;
+		if (inCount)
+			SwapCopyU32s(&inArr[inOutNdx], pOutVals, inCount);
+		inOutNdx += inCount * sizeof(uint32_t);
+		return true;
+	}
+
+	inline bool POPU64s (uint64_t * pOutVals, const size_t inCount, const std::vector<uint8_t> & inArr, std::size_t & inOutNdx, const bool dontSwap = false)
+	{
+		if (NTV2HostIsBigEndian || dontSwap)
+			return POPU8s(pOutVals, inCount * sizeof(uint64_t), inArr, inOutNdx);
+		if (!CANPOP(inArr, inOutNdx, inCount * sizeof(uint64_t)))
+			return false;
+		if (inCount)
+			SwapCopyU64s(&inArr[inOutNdx], pOutVals, inCount);
+		inOutNdx += inCount * sizeof(uint64_t);
+		return true;
+	}
+
+	/**
+		@brief		Zero-copy decode: answers with the address of the next run of bytes in the blob, without copying them.
+		@param[out]	outPtr			Receives the address of the payload inside the blob. Only valid while the blob is unmodified.
+		@param[in]	inByteCount		Specifies the payload size, in bytes.
+		@return		True if successful;  false if the blob is too short.
+	**/
+	inline bool POPREF (const uint8_t * & outPtr, const size_t inByteCount, const std::vector<uint8_t> & inArr, std::size_t & inOutNdx)
+	{
+		outPtr = AJA_NULL;
+		if (!CANPOP(inArr, inOutNdx, inByteCount))
+			return false;
+		if (inByteCount)
+			outPtr = &inArr[inOutNdx];
+		inOutNdx += inByteCount;
+		return true;
+	}
+	///@}
+
+
+	/**
+		@brief	One contiguous run of bytes in a gather list -- see NubGatherBlob::GetSegments.
+	**/
+	typedef struct NubIOSegment
+	{
+		const uint8_t *	fAddr;		///< @brief	Start address
+		size_t			fByteCount;	///< @brief	Length, in bytes
+	} NubIOSegment;
+	typedef std::vector<NubIOSegment>	NubIOSegments;
+
+	/**
+		@brief	An encode-side blob that can reference large payloads (e.g. frame or audio buffers) in place,
+				rather than copying them into its byte vector. Small values are encoded into the inline blob
+				using the usual PUSHUxx functions; PushRef records a pointer/length at the current position.
+				Transports can send the result with a single gather write (e.g. writev/sendmsg/WSASend) from
+				GetSegments, or call Flatten if they need one contiguous buffer.
+		@note	Referenced memory must remain valid and unmodified until the blob has been sent.
+	**/
+	class NubGatherBlob
+	{
+		public:
+			static const size_t	kDefaultMinRefBytes = 4096;	///< @brief	Payloads smaller than this are copied inline
+
+			explicit inline	NubGatherBlob (const size_t inReserveBytes = 256, const size_t inMinRefBytes = kDefaultMinRefBytes)
+				:	mRefBytes(0), mMinRefBytes(inMinRefBytes)
+			{
+				mBlob.reserve(inReserveBytes);
+			}
+
+			/**
+				@return		A reference to my inline byte vector, for use with the PUSHUxx functions.
+			**/
+			inline std::vector<uint8_t> &	Blob (void)			{return mBlob;}
+
+			/**
+				@brief		Appends a reference to the given payload. Payloads below my minimum reference size are copied.
+				@param[in]	pInData			Points to the payload. Its bytes are sent as-is (the caller handles byte order).
+				@param[in]	inByteCount		Specifies the payload size, in bytes.
+			**/
+			inline void		PushRef (const void * pInData, const size_t inByteCount)
+			{
+				if (!pInData || !inByteCount)
+					return;
+				if (inByteCount < mMinRefBytes)
+					return PUSHU8s(pInData, inByteCount, mBlob);
+				const PayloadRef ref = {mBlob.size(), reinterpret_cast<const uint8_t*>(pInData), inByteCount};
+				mRefs.push_back(ref);
+				mRefBytes += inByteCount;
+			}
+
+			/**
+				@return		The total number of bytes in the encoded message (inline bytes plus referenced payloads).
+			**/
+			inline size_t	GetByteCount (void) const			{return mBlob.size() + mRefBytes;}
+
+			/**
+				@return		The number of payloads referenced (i.e. not copied) so far.
+			**/
+			inline size_t	GetRefCount (void) const			{return mRefs.size();}
+
+			/**
+				@brief		Answers with the ordered list of contiguous segments that make up the encoded message.
+				@param[out]	outSegs		Receives the segments. Pointers into my inline blob are only valid until it changes.
+			**/
+			inline void		GetSegments (NubIOSegments & outSegs) const
+			{
+				outSegs.clear();
+				outSegs.reserve(mRefs.size() * 2 + 1);
+				size_t blobNdx(0);
+				for (size_t ndx(0);  ndx < mRefs.size();  ndx++)
+				{
+					const PayloadRef & ref (mRefs[ndx]);
+					if (ref.fBlobOffset > blobNdx)
+						{const NubIOSegment seg = {&mBlob[blobNdx], ref.fBlobOffset - blobNdx};  outSegs.push_back(seg);}
+					const NubIOSegment seg = {ref.fAddr, ref.fByteCount};
+					outSegs.push_back(seg);
+					blobNdx = ref.fBlobOffset;
+				}
+				if (mBlob.size() > blobNdx)
+					{const NubIOSegment seg = {&mBlob[blobNdx], mBlob.size() - blobNdx};  outSegs.push_back(seg);}
+			}
+
+			/**
+				@brief		Copies the entire encoded message into a single contiguous byte vector.
+				@param[out]	outBlob		Receives the flattened message.
+			**/
+			inline void		Flatten (std::vector<uint8_t> & outBlob) const
+			{
+				NubIOSegments segs;
+				GetSegments(segs);
+				outBlob.clear();
+				outBlob.reserve(GetByteCount());
+				for (size_t ndx(0);  ndx < segs.size();  ndx++)
+					PUSHU8s(segs[ndx].fAddr, segs[ndx].fByteCount, outBlob);
+			}
+
+			/**
+				@brief		Resets me for re-use, keeping my inline blob's capacity.
+			**/
+			inline void		Clear (void)						{mBlob.clear();  mRefs.clear();  mRefBytes = 0;}
+
+		private:
+			typedef struct PayloadRef
+			{
+				size_t			fBlobOffset;	//	Inline blob offset at which the payload is inserted
+				const uint8_t *	fAddr;
+				size_t			fByteCount;
+			} PayloadRef;
+
+			std::vector<uint8_t>	mBlob;			//	Inline bytes
+			std::vector<PayloadRef>	mRefs;			//	Referenced payloads, in blob-offset order
+			size_t					mRefBytes;		//	Total referenced bytes
+			size_t					mMinRefBytes;	//	Payloads smaller than this get copied
+	};	//	NubGatherBlob
+
 }	//	namespace ntv2nub
 
 #endif	//	__NTV2NUBTYPES_H
@@ -6234,6 +6234,28 @@ typedef enum
 				**/
 				bool			Allocate (const size_t inByteCount, const bool inPageAligned = false);
 
+				/**
+					@brief		Allocates (or re-allocates) my user-space storage using huge pages, optionally from a
+								given NUMA node. Huge pages make locking large buffers for DMA, and walking whole
+								frames with the CPU, much cheaper. Falls back to transparent huge pages and then to
+								ordinary pages if the requested page size isn't available (see AJAMemory::AllocateHugePages).
+								I assume full responsibility for any memory that I allocate.
+					@param[in]	inByteCount		Specifies the number of bytes to allocate.
+					@param[in]	inPageSize		Optionally specifies the requested page size, in bytes (e.g. 2MB or 1GB).
+												Zero (the default) uses the host's default huge page size. Specify
+												HostPageSize() for ordinary pages on a given NUMA node.
+					@param[in]	inNUMANode		Optionally specifies the NUMA node to allocate from (see CNTV2Card::GetNUMANode).
+												Negative (the default) means no preference.
+					@return		True if successful;	 otherwise false.
+					@note		Call GetPageSize to learn the page size actually obtained.
+				**/
+				bool			AllocateHugePages (const size_t inByteCount, const size_t inPageSize = 0, const int inNUMANode = -1);	//	New in SDK 17.5
+
+				/**
+					@return		The size of the pages backing my host storage, in bytes, or zero if I'm NULL.
+				**/
+				size_t			GetPageSize (void) const;	//	New in SDK 17.5
+
 				/**
 					@brief		Deallocates my user-space storage (if I own it -- i.e. from a prior call to Allocate).
 					@return		True if successful;	 otherwise false.
@@ -8504,6 +8526,22 @@ typedef enum
 					@return		True if segmented DMAs are currently enabled;  otherwise false.
 				**/
 				bool									SegmentedDMAsEnabled (void) const;
+
+				/**
+					@brief		Sets my video buffer to receive (or supply) only a region of the device frame, such as a rectangular
+								crop of the raster, or every Nth line of it, as described by the given ::NTV2SegmentedXferInfo.
+								The source aspect of the transfer info describes the device frame, and the destination aspect the host buffer.
+					@param[in]	pInVideoBuffer		Specifies the host buffer address.
+					@param[in]	inVideoByteCount	Specifies the size of the host buffer, in bytes. Must be large enough to hold
+													the entire region.
+					@param[in]	inSegmentInfo		Specifies the region to transfer, typically from NTV2FormatDescriptor::GetRegionOfInterestXferInfo.
+					@return		True if successful;	 otherwise false.
+					@note		This sets my acInVideoDMAOffset, acInSegmentedDMAInfo and acVideoBuffer (whose byte count
+								holds the segment byte count -- see EnableSegmentedDMAs). Call SetVideoBuffer and DisableSegmentedDMAs
+								to revert to whole-frame transfers.
+				**/
+				bool									SetVideoRegionOfInterest (ULWord * pInVideoBuffer, const ULWord inVideoByteCount,
+																					const NTV2SegmentedXferInfo & inSegmentInfo);	//	New in SDK 17.5
 				///@}
 
 				/**
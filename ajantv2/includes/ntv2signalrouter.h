@@ -44,6 +44,25 @@ typedef NTV2PossibleConnections::const_iterator			NTV2PossibleConnectionsConstIt
 AJAExport std::ostream & operator << (std::ostream & inOutStream, const NTV2XptConnection & inObj);
 AJAExport std::ostream & operator << (std::ostream & inOutStream, const NTV2XptConnections & inObj);
 
+/**
+	@brief	Describes one signal path for CNTV2SignalRouter::SolveRoute to build:  the signal from a source widget,
+			delivered to a given widget input, in a given pixel format.
+**/
+typedef struct NTV2RouteConstraint
+{
+	NTV2WidgetID	source;		///< @brief	The widget that originates the signal (e.g. ::NTV2_WgtFrameBuffer1, ::NTV2_Wgt3GSDIIn1)
+	NTV2InputXptID	sink;		///< @brief	The widget input that is to receive the signal (e.g. ::NTV2_XptSDIOut1Input)
+	NTV2PixelFormat	format;		///< @brief	The pixel format of the FrameStore(s) at either end, which determines if they send/receive RGB or YUV
+
+	explicit inline NTV2RouteConstraint (const NTV2WidgetID inSource = NTV2_WIDGET_INVALID,
+										const NTV2InputXptID inSink = NTV2_INPUT_CROSSPOINT_INVALID,
+										const NTV2PixelFormat inFormat = NTV2_FBF_10BIT_YCBCR)
+		:	source(inSource), sink(inSink), format(inFormat)	{}
+} NTV2RouteConstraint;	//	New in SDK 17.5
+
+typedef std::vector <NTV2RouteConstraint>				NTV2RouteConstraints;		///< @brief An ordered sequence of ::NTV2RouteConstraint values.
+typedef NTV2RouteConstraints::const_iterator			NTV2RouteConstraintsConstIter;
+
 /**
 	@brief	This class is a collection of widget input-to-output connections that can be applied all-at-once to an NTV2 device.
 			Call AddConnection to connect a widget input (specified by ::NTV2InputXptID) to a widget's output (specified by ::NTV2OutputXptID).
@@ -510,6 +529,65 @@ class AJAExport CNTV2SignalRouter
 														NTV2XptConnections & outNew,
 														NTV2XptConnections & outRemoved);	//	New in SDK 16.0
 
+		/**
+			@brief		Determines the minimal set of crosspoint changes that turns one routing into another.
+			@param[in]	inCurrent	Specifies the current connections (perhaps obtained from CNTV2Card::GetConnections).
+			@param[in]	inDesired	Specifies the desired connections.
+			@param[in]	inReplace	If true, current connections whose input isn't in "inDesired" are disconnected.
+									If false, they're left alone.
+			@param[out]	outChanges	Receives the connections to be written. Disconnects are connections to ::NTV2_XptBlack.
+			@return		True if no changes are needed;  otherwise false.
+		**/
+		static bool					DiffConnections (const NTV2XptConnections & inCurrent,
+													const NTV2XptConnections & inDesired,
+													const bool inReplace,
+													NTV2XptConnections & outChanges);	//	New in SDK 17.5
+
+		/**
+			@brief		Checks that the given connections can be made on the given device.
+			@param[in]	inDeviceID		Specifies the device of interest.
+			@param[in]	inConnections	Specifies the connections to be checked.
+			@param[out]	outInvalid		Receives the connections that can't be made.
+			@param[in]	inPossible		Optionally specifies the device's implemented connections (perhaps obtained from
+										CNTV2Card::GetPossibleConnections). If empty, only the widget tables are consulted.
+			@return		True if every connection is valid;	otherwise false.
+			@details	A connection is invalid if the device lacks the widget that owns its input or output crosspoint,
+						if it feeds YUV into an RGB-only input (or vice-versa), or if it's not among "inPossible".
+		**/
+		static bool					ValidateConnections (const NTV2DeviceID inDeviceID,
+														const NTV2XptConnections & inConnections,
+														NTV2XptConnections & outInvalid,
+														const NTV2PossibleConnections & inPossible = NTV2PossibleConnections());	//	New in SDK 17.5
+
+		/**
+			@brief		Returns the register writes that will make the given connections, with one write per
+						crosspoint select register, no matter how many of its crosspoints change.
+			@param[in]	inConnections	Specifies the connections to be made.
+			@param[out]	outRegWrites	Receives the masked register writes, in register order.
+			@return		True if successful;	 otherwise false.
+		**/
+		static bool					GetConnectionRegisterWrites (const NTV2XptConnections & inConnections,
+																NTV2RegisterWrites & outRegWrites);	//	New in SDK 17.5
+
+		/**
+			@brief		Builds the connections that satisfy the given route constraints on the given device.
+			@param[in]	inDeviceID		Specifies the device of interest.
+			@param[in]	inConstraints	Specifies the signal paths to build, in priority order.
+			@param[out]	outConnections	Receives the connections. It will be empty if this function fails.
+			@param[in]	inPossible		Optionally specifies the device's implemented connections (perhaps obtained from
+										CNTV2Card::GetPossibleConnections). If empty, only the widget tables are consulted.
+			@return		True if every constraint was satisfied;	 otherwise false.
+			@details	Each signal leaves its source as RGB if the source is a FrameStore with an RGB pixel format,
+						otherwise as YUV. It must arrive at an RGB-only input as RGB, at a YUV-only or SDI output input
+						as YUV, and at a FrameStore as the pixel format dictates. Where the two differ, a free CSC is
+						inserted, preferring the one on the same channel as the source.
+			@note		Multi-link (dual-link, quad-link, 425 mux) paths aren't solved -- specify one constraint per link.
+		**/
+		static bool					SolveRoute (const NTV2DeviceID inDeviceID,
+												const NTV2RouteConstraints & inConstraints,
+												NTV2XptConnections & outConnections,
+												const NTV2PossibleConnections & inPossible = NTV2PossibleConnections());	//	New in SDK 17.5
+
 		/**
 			@brief		Decodes a given string into a map of crosspoint connections.
 			@param[in]	inString			Specifies the string to be parsed. It can contain the pnemonics that
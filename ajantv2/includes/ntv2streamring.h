@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2streamring.h
+	@brief		Declares the NTV2StreamRing class.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+#ifndef NTV2STREAMRING_H
+#define NTV2STREAMRING_H
+
+#include "ajaexport.h"
+#include "ntv2card.h"
+#include "ntv2timingrecorder.h"
+#include "ajabase/system/lock.h"
+#include <iostream>
+#include <vector>
+
+
+/**
+	@brief	Statistics reported by NTV2StreamRing::GetStats.
+**/
+typedef struct NTV2StreamRingStats
+{
+	ULWord64			fQueued;			///< @brief	Number of buffers queued to the driver.
+	ULWord64			fCompleted;			///< @brief	Number of buffers the driver transferred and released.
+	ULWord64			fFlushed;			///< @brief	Number of buffers the driver released without transferring them.
+	ULWord64			fStarved;			///< @brief	Number of times the driver queue ran dry, counting each dry spell once (capture:  frames dropped;  playout:  see fRepeated).
+	ULWord64			fRepeated;			///< @brief	Number of frames the driver repeated for lack of a queued buffer (from NTV2StreamChannel).
+	ULWord				fQueueDepth;		///< @brief	Number of buffers currently queued to the driver.
+	ULWord				fMinQueueDepth;		///< @brief	Smallest queue depth seen after the ring was started.
+	ULWord				fMaxQueueDepth;		///< @brief	Largest queue depth seen.
+	NTV2TimingHistogram	fLatency;			///< @brief	Time from queue to completion of each transferred buffer, in microseconds.
+} NTV2StreamRingStats;
+
+
+/**
+	@brief	Keeps a ring of pre-locked host buffers flowing through a stream channel (see CNTV2Card::StreamBufferQueue),
+			with AutoCirculate-like convenience:  the application calls AcquireBuffer to get a buffer, and SubmitBuffer
+			to hand it back. The device transfers directly from and into the ring's buffers, so nothing is copied.
+			-	Playout:	AcquireBuffer returns a free buffer to fill;  SubmitBuffer queues it for output.
+			-	Capture:	AcquireBuffer returns the oldest captured buffer;  SubmitBuffer returns it to the ring to be refilled.
+	@note	Completed buffers are recycled by Service, which AcquireBuffer calls by default. An application can instead
+			call WaitAndService from a dedicated thread (after calling SetAutoService(false)). Either way, the free, returned
+			and ready lists are lock-free single-producer/single-consumer queues, so AcquireBuffer and SubmitBuffer must be
+			called from a single thread, and Service from a single (possibly different) thread.
+**/
+class AJAExport NTV2StreamRing
+{
+	public:
+		/**
+			@brief		Constructs me for the given device and stream channel.
+			@param[in]	inDevice	Specifies the open device to stream with. It must outlive me.
+			@param[in]	inChannel	Specifies the stream channel.
+			@param[in]	inMode		Specifies NTV2_MODE_CAPTURE or NTV2_MODE_DISPLAY (playout).
+		**/
+									NTV2StreamRing (CNTV2Card & inDevice, const NTV2Channel inChannel, const NTV2Mode inMode);
+		virtual						~NTV2StreamRing ();		///< @brief	Closes me (if open).
+
+		/**
+			@brief		Allocates and locks my buffers, and takes ownership of the stream channel.
+			@param[in]	inNumBuffers	Specifies the number of buffers in the ring. Must be at least 2.
+			@param[in]	inBufferBytes	Specifies the size of each buffer, in bytes.
+			@param[in]	inTargetDepth	Specifies how many buffers to keep queued to the driver. Zero (the default) uses
+										all but two buffers. Playout AcquireBuffer returns nothing while this many are queued.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				Open (const ULWord inNumBuffers, const ULWord inBufferBytes, const ULWord inTargetDepth = 0);
+
+		/**
+			@brief		Starts the stream. For playout, at least one buffer should have been submitted (prerolled) first.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				Start (void);
+
+		/**
+			@brief		Stops the stream. For playout, the buffer on air stays on air.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				Stop (void);
+
+		/**
+			@brief		Flushes and releases the stream channel, then unlocks and frees my buffers.
+		**/
+		virtual void				Close (void);
+
+		/**
+			@brief		Playout:  gets a free buffer to fill.  Capture:  gets the oldest captured buffer.
+			@param[in]	inTimeoutMs		Specifies how long to wait for a buffer, in milliseconds. Zero (the default) doesn't wait.
+			@return		A pointer to one of my buffers, or NULL if none is available.
+			@note		The buffer stays mine. Hand it back with SubmitBuffer.
+		**/
+		virtual NTV2Buffer *		AcquireBuffer (const ULWord inTimeoutMs = 0);
+
+		/**
+			@brief		Playout:  queues the given filled buffer for output.  Capture:  returns the given buffer to be refilled.
+			@param[in]	pInBuffer	Specifies a buffer obtained from AcquireBuffer.
+			@return		True if successful;  otherwise false, in which case the buffer is still the caller's.
+		**/
+		virtual bool				SubmitBuffer (NTV2Buffer * pInBuffer);
+
+		/**
+			@brief		Retrieves the buffers the driver has released, recycles them, and (for capture) tops up the driver queue.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				Service (void);
+
+		/**
+			@brief		Waits for the next stream event (typically the next frame), then calls Service.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				WaitAndService (void);
+
+		/**
+			@brief		Determines whether AcquireBuffer and SubmitBuffer call Service themselves (the default).
+			@param[in]	inAutoService	Specify false if another thread calls WaitAndService.
+		**/
+		virtual inline void			SetAutoService (const bool inAutoService)	{mAutoService = inAutoService;}
+
+		virtual inline bool			IsOpen (void) const				{return !mBuffers.empty();}			///< @return	True if I'm open.
+		virtual inline bool			IsRunning (void) const			{return mRunning;}					///< @return	True if I've been started.
+		virtual inline bool			IsCapture (void) const			{return mMode == NTV2_MODE_CAPTURE;}	///< @return	True if I capture;  false if I play out.
+		virtual inline NTV2Channel	GetChannel (void) const			{return mChannel;}					///< @return	My stream channel.
+		virtual inline ULWord		GetBufferCount (void) const		{return ULWord(mBuffers.size());}	///< @return	The number of buffers in my ring.
+		virtual inline ULWord		GetTargetDepth (void) const		{return mTargetDepth;}				///< @return	The number of buffers I try to keep queued.
+		virtual inline ULWord		GetQueueDepth (void) const		{return mQueueDepth;}				///< @return	The number of buffers queued to the driver.
+
+		/**
+			@brief		Answers with my statistics.
+			@param[out]	outStats	Receives my statistics.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool				GetStats (NTV2StreamRingStats & outStats) const;
+		virtual void				ResetStats (void);		///< @brief	Clears my statistics.
+		virtual std::ostream &		Print (std::ostream & oss) const;
+
+	protected:
+		/**
+			@brief	A lock-free single-producer/single-consumer queue of buffer indexes. Each slot holds an index + 1, or
+					zero if empty. Slots are claimed and published with an atomic exchange, so the producer and consumer
+					never share anything but the slot itself.
+		**/
+		class IndexQueue
+		{
+			public:
+				void	Reset (const ULWord inCapacity);
+				bool	Push (const ULWord inIndex);
+				bool	Pop (ULWord & outIndex);
+			private:
+				std::vector<uint32_t>	mSlots;
+				ULWord					mHead;	///< @brief	Next slot to pop (consumer only)
+				ULWord					mTail;	///< @brief	Next slot to push (producer only)
+		};
+
+		virtual bool				QueueToDriver (const ULWord inIndex);
+		virtual bool				ReleaseFromDriver (void);
+		virtual bool				IndexOf (const NTV2Buffer * pInBuffer, ULWord & outIndex) const;
+
+	private:
+									NTV2StreamRing (const NTV2StreamRing & inObj);				//	Not copyable
+		NTV2StreamRing &			operator = (const NTV2StreamRing & inRHS);					//	Not assignable
+
+		CNTV2Card &					mDevice;
+		const NTV2Channel			mChannel;
+		const NTV2Mode				mMode;
+		std::vector<NTV2Buffer>		mBuffers;		///< @brief	My ring of locked host buffers
+		std::vector<bool>			mHeld;			///< @brief	Which buffers the application holds (acquirer thread only)
+		IndexQueue					mFree;			///< @brief	Buffers ready to fill (playout) or to queue (capture);  only Service pushes
+		IndexQueue					mReturned;		///< @brief	Capture buffers handed back by SubmitBuffer, moved to mFree by Service
+		IndexQueue					mReady;			///< @brief	Captured buffers waiting for AcquireBuffer
+		ULWord						mTargetDepth;
+		uint32_t					mQueueDepth;	///< @brief	Buffers queued to the driver (atomic)
+		bool						mRunning;
+		bool						mAutoService;
+		bool						mStarving;		///< @brief	True while the driver queue is dry (Service thread only)
+		mutable AJALock				mStatsLock;
+		NTV2StreamRingStats			mStats;
+};	//	NTV2StreamRing
+
+inline std::ostream & operator << (std::ostream & oss, const NTV2StreamRing & inRing)	{return inRing.Print(oss);}
+
+#endif	//	NTV2STREAMRING_H
@@ -113,6 +113,37 @@ public:
 	static bool			DumpDeviceSDRAM (CNTV2Card & inDevice,
 										const std::string & inFilePath,
 										std::ostream & msgStream);	//	New in SDK 16.0
+
+	/**
+		@brief		Dumps the device's SDRAM into a file, overlapping the DMA transfers with the file writes.
+		@param		inDevice		Specifies the open device whose SDRAM is to be dumped.
+		@param[in]	inFilePath		Specifies the path of the file to be written.
+		@param		msgStream		Receives error messages, periodic progress reports and the final throughput report.
+		@param[in]	inCompress		If true, constant runs of frame memory are run-length encoded, and the file must be
+									expanded with ExpandDeviceSDRAMDump before use. Otherwise the file contains the raw frames.
+		@param[in]	inNumBuffers	Optionally specifies the number of frame buffers in the DMA/write pipeline (2-8).
+									Defaults to 3.
+		@return		True if successful;  otherwise false.
+		@note		Frames that fail to DMA are omitted from the file.
+	**/
+	static bool			DumpDeviceSDRAM (CNTV2Card & inDevice,
+										const std::string & inFilePath,
+										std::ostream & msgStream,
+										const bool inCompress,
+										const UWord inNumBuffers = 3);	//	New in SDK 17.5
+
+	/**
+		@brief		Expands a compressed SDRAM dump made by DumpDeviceSDRAM into a raw file.
+		@param[in]	inDumpPath		Specifies the path of the compressed dump file.
+		@param[in]	inRawPath		Specifies the path of the raw file to be written.
+		@param		msgStream		Receives error messages.
+		@return		True if successful;  otherwise false.
+		@note		Frames missing from the dump (that failed to DMA) are zero-filled, so every frame in the raw file
+					is at its frame number times the frame size.
+	**/
+	static bool			ExpandDeviceSDRAMDump (const std::string & inDumpPath,
+											const std::string & inRawPath,
+											std::ostream & msgStream);	//	New in SDK 17.5
 };	//	CNTV2SupportLogger
 
 
@@ -0,0 +1,293 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2timingrecorder.h
+	@brief		Declares the CNTV2TimingRecorder, NTV2TimingHistogram and NTV2ScopedTimer classes.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+#ifndef NTV2TIMINGRECORDER_H
+#define NTV2TIMINGRECORDER_H
+
+#include "ajaexport.h"
+#include "ntv2publicinterface.h"
+#include "ntv2formatdescriptor.h"
+#include "ajabase/system/lock.h"
+#include "ajabase/system/systemtime.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+
+
+/**
+	@brief	Identifies a timing measurement made by CNTV2TimingRecorder.
+**/
+typedef enum
+{
+	NTV2_TIMING_CAPTURE_LATENCY,	///< @brief	Input VBI (start of frame) to the frame's capture transfer in the driver.
+	NTV2_TIMING_DMA_DURATION,		///< @brief	Host time spent in CNTV2Card::AutoCirculateTransfer.
+	NTV2_TIMING_HOST_PROCESSING,	///< @brief	Host time from the end of a capture transfer to the start of the output transfer of the same frame.
+	NTV2_TIMING_OUTPUT_LATENCY,		///< @brief	Output transfer in the driver to the VBI at which the frame went out the jack.
+	NTV2_TIMING_VBI_JITTER,			///< @brief	Deviation of each input VBI timestamp from the nominal frame period.
+	NTV2_TIMING_END_TO_END,			///< @brief	Loopback only: output transfer of a frame to its capture transfer on the input.
+	NTV2_TIMING_NUM_METRICS,
+	NTV2_TIMING_INVALID	= NTV2_TIMING_NUM_METRICS
+} NTV2TimingMetric;
+
+#define	NTV2_IS_VALID_TIMING_METRIC(__m__)		((__m__) >= NTV2_TIMING_CAPTURE_LATENCY  &&  (__m__) < NTV2_TIMING_NUM_METRICS)
+
+AJAExport std::string NTV2TimingMetricToString (const NTV2TimingMetric inMetric, const bool inCompact = false);	//	New in SDK 17.5
+
+
+/**
+	@brief	A single timing measurement, in microseconds.
+**/
+typedef struct NTV2TimingSample
+{
+	NTV2Channel			fChannel;		///< @brief	The channel that was measured.
+	NTV2TimingMetric	fMetric;		///< @brief	What was measured.
+	ULWord64			fFrame;			///< @brief	The frame's user cookie or loopback frame counter, if any.
+	int64_t				fTimestamp;		///< @brief	Driver timestamp (100ns units) of the VBI or transfer the sample relates to.
+	int64_t				fValue;			///< @brief	The measured value, in microseconds.
+} NTV2TimingSample;
+
+typedef std::vector<NTV2TimingSample>	NTV2TimingSamples;
+
+
+/**
+	@brief	Accumulates min/max/mean/standard deviation and a fixed-width histogram of a series of values.
+**/
+class AJAExport NTV2TimingHistogram
+{
+	public:
+		/**
+			@brief		Constructs me with the given bin layout.
+			@param[in]	inMinValue	Specifies the value at the low edge of the first bin. Smaller values are counted in the first bin.
+			@param[in]	inBinWidth	Specifies the width of each bin. Must be non-zero.
+			@param[in]	inNumBins	Specifies the number of bins. Values past the last bin are counted in the last bin.
+		**/
+		explicit				NTV2TimingHistogram (const int64_t inMinValue = 0, const int64_t inBinWidth = 100, const ULWord inNumBins = 500);
+
+		void					Add (const int64_t inValue);	///< @brief	Accumulates the given value.
+		void					Reset (void);					///< @brief	Discards all accumulated values, keeping my bin layout.
+
+		inline uint64_t			GetCount (void) const			{return mCount;}						///< @return	The number of values accumulated.
+		inline int64_t			GetMin (void) const				{return mCount ? mMin : 0;}				///< @return	The smallest value accumulated.
+		inline int64_t			GetMax (void) const				{return mCount ? mMax : 0;}				///< @return	The largest value accumulated.
+		inline double			GetMean (void) const			{return mMean;}							///< @return	The mean of the values accumulated.
+		double					GetStdDev (void) const;													///< @return	The standard deviation of the values accumulated.
+		inline int64_t			GetMinValue (void) const		{return mMinValue;}						///< @return	The value at the low edge of my first bin.
+		inline int64_t			GetBinWidth (void) const		{return mBinWidth;}						///< @return	The width of each of my bins.
+		inline const std::vector<uint64_t> &	GetBins (void) const	{return mBins;}					///< @return	My bin counts.
+
+		/**
+			@param[in]	inPercentile	Specifies the percentile of interest, 0.0 thru 100.0.
+			@return		The value at the upper edge of the bin that contains the given percentile.
+		**/
+		int64_t					GetPercentile (const double inPercentile) const;
+
+		/**
+			@brief		Writes a human-readable text histogram into the given stream, skipping empty leading and trailing bins.
+			@param		inOutStream		Specifies the output stream.
+			@param[in]	inMaxBarWidth	Specifies the width of the longest bar, in characters.
+			@return		The output stream.
+		**/
+		std::ostream &			Print (std::ostream & inOutStream, const size_t inMaxBarWidth = 50) const;
+
+	private:
+		int64_t					mMinValue;
+		int64_t					mBinWidth;
+		std::vector<uint64_t>	mBins;
+		uint64_t				mCount;
+		int64_t					mMin;
+		int64_t					mMax;
+		double					mMean;
+		double					mM2;
+};	//	NTV2TimingHistogram
+
+
+/**
+	@brief	Times the scope it's declared in using the AJATime fast clock, and adds the elapsed time to a histogram
+			when it goes out of scope. It costs a few nanoseconds, so it can bracket every transfer or wait in a
+			capture or playout loop.
+	@note	NTV2TimingHistogram isn't thread-safe. Pass a lock if other threads add to the same histogram.
+	@note	The first use of the fast clock calibrates it (see AJATime::CalibrateFastClock).
+	@note	New in SDK 17.5.
+**/
+class AJAExport NTV2ScopedTimer
+{
+	public:
+		/**
+			@brief		Starts timing.
+			@param		inHistogram			Specifies the histogram to add the elapsed time to.
+			@param[in]	inNanosecsPerUnit	Specifies the histogram's units, in nanoseconds. Defaults to microseconds.
+			@param[in]	pInLock				Optionally specifies a lock to hold while adding to the histogram.
+		**/
+		explicit				NTV2ScopedTimer (NTV2TimingHistogram & inHistogram, const uint64_t inNanosecsPerUnit = 1000, AJALock * pInLock = AJA_NULL);
+								~NTV2ScopedTimer ();	///< @brief	Adds the elapsed time to the histogram, unless cancelled.
+
+		uint64_t				GetElapsedNanoseconds (void) const;		///< @return	The time since I was constructed, in nanoseconds.
+		inline void				Cancel (void)							{mCancelled = true;}	///< @brief	Don't add anything to the histogram, e.g. if the timed operation failed.
+
+	private:
+								NTV2ScopedTimer (const NTV2ScopedTimer & inObj);
+		NTV2ScopedTimer &		operator = (const NTV2ScopedTimer & inRHS);
+
+		NTV2TimingHistogram &	mHistogram;
+		AJALock *				mpLock;
+		uint64_t				mNanosecsPerUnit;
+		uint64_t				mStartTicks;	///< @brief	AJATime::GetFastCounter at construction
+		bool					mCancelled;
+};	//	NTV2ScopedTimer
+
+
+/**
+	@brief	Aggregates the ::FRAME_STAMP timing information returned by AutoCirculate transfers into per-channel
+			latency, DMA duration and VBI jitter histograms, counts dropped (capture) and repeated (playout) frames,
+			and writes the results as text, CSV or JSON.
+	@note	Driver timestamps (::FRAME_STAMP::acFrameTime, ::FRAME_STAMP::acCurrentTime, etc.) are only ever compared
+			with other driver timestamps, and host times (e.g. from AJATime::GetSystemMicroseconds) with other host times.
+			To relate the two, convert AJATime::GetFastNanoseconds times with AJATime::FastNanosecondsToFrameStampTime.
+	@note	This class is thread-safe, so capture and playout threads may record into the same instance.
+**/
+class AJAExport CNTV2TimingRecorder
+{
+	public:
+						CNTV2TimingRecorder ();
+		virtual			~CNTV2TimingRecorder ();
+
+		virtual void	Reset (void);	///< @brief	Discards all recorded samples and statistics.
+
+		/**
+			@brief		Sets the nominal frame rate of the given channel, which enables VBI jitter measurement.
+			@param[in]	inChannel		Specifies the channel.
+			@param[in]	inFrameRate		Specifies the frame rate.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool	SetFrameRate (const NTV2Channel inChannel, const NTV2FrameRate inFrameRate);
+
+		/**
+			@brief		Limits the number of individual samples I retain for CSV output. Statistics and histograms
+						continue to accumulate after the limit is reached.
+			@param[in]	inMaxSamples	Specifies the maximum number of samples. Zero retains no samples.
+		**/
+		virtual void	SetMaxSamples (const size_t inMaxSamples);
+
+		/**
+			@brief		Records the timing of a capture transfer.
+			@param[in]	inChannel			Specifies the input channel.
+			@param[in]	inXfer				Specifies the AUTOCIRCULATE_TRANSFER that was just used to capture the frame.
+			@param[in]	inStartMicrosecs	Specifies the host time immediately before the transfer was issued.
+			@param[in]	inEndMicrosecs		Specifies the host time immediately after the transfer completed.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool	RecordCaptureTransfer (const NTV2Channel inChannel, const AUTOCIRCULATE_TRANSFER & inXfer,
+												const uint64_t inStartMicrosecs, const uint64_t inEndMicrosecs);
+
+		/**
+			@brief		Records the timing of a playout transfer. The frame's AUTOCIRCULATE_TRANSFER::acInUserCookie
+						identifies it when it later goes out the jack (see RecordOutputFrameStamp), so it should be unique.
+			@param[in]	inChannel				Specifies the output channel.
+			@param[in]	inXfer					Specifies the AUTOCIRCULATE_TRANSFER that was just used to play the frame.
+			@param[in]	inStartMicrosecs		Specifies the host time immediately before the transfer was issued.
+			@param[in]	inEndMicrosecs			Specifies the host time immediately after the transfer completed.
+			@param[in]	inCaptureEndMicrosecs	Optionally specifies the host time at which the capture transfer of the
+												same frame completed, for measuring host processing time. Zero if none.
+			@return		True if successful;  otherwise false.
+		**/
+		virtual bool	RecordOutputTransfer (const NTV2Channel inChannel, const AUTOCIRCULATE_TRANSFER & inXfer,
+												const uint64_t inStartMicrosecs, const uint64_t inEndMicrosecs,
+												const uint64_t inCaptureEndMicrosecs = 0);
+
+		/**
+			@brief		Records the output latency of the frame that was going out the jack at the last VBI, if it
+						was transferred by RecordOutputTransfer and hasn't already been recorded.
+			@param[in]	inChannel		Specifies the output channel.
+			@param[in]	inFrameStamp	Specifies the ::FRAME_STAMP from CNTV2Card::AutoCirculateGetFrameStamp.
+			@return		True if a latency sample was recorded;  otherwise false.
+		**/
+		virtual bool	RecordOutputFrameStamp (const NTV2Channel inChannel, const FRAME_STAMP & inFrameStamp);
+
+		/**
+			@brief		Records the end-to-end latency of a frame that was played out, looped back and captured again.
+			@param[in]	inInputChannel		Specifies the input channel that captured the frame.
+			@param[in]	inOutputChannel		Specifies the output channel that played the frame.
+			@param[in]	inCookie			Specifies the user cookie the frame was played with, typically decoded from the
+											captured picture using DecodeFrameCounter.
+			@param[in]	inCaptureXfer		Specifies the AUTOCIRCULATE_TRANSFER that captured the frame.
+			@return		True if a latency sample was recorded;  otherwise false.
+		**/
+		virtual bool	RecordLoopback (const NTV2Channel inInputChannel, const NTV2Channel inOutputChannel,
+										const ULWord64 inCookie, const AUTOCIRCULATE_TRANSFER & inCaptureXfer);
+
+		/**
+			@brief		Records an arbitrary sample.
+			@param[in]	inSample		Specifies the sample to record.
+		**/
+		virtual void	RecordSample (const NTV2TimingSample & inSample);
+
+		/**
+			@return		A copy of the histogram for the given channel and metric (empty if nothing was recorded).
+			@param[in]	inChannel		Specifies the channel.
+			@param[in]	inMetric		Specifies the metric.
+		**/
+		virtual NTV2TimingHistogram	GetHistogram (const NTV2Channel inChannel, const NTV2TimingMetric inMetric) const;
+		virtual uint64_t			GetDroppedFrames (const NTV2Channel inChannel) const;	///< @return	The number of frames dropped by the given input channel.
+		virtual uint64_t			GetRepeatedFrames (const NTV2Channel inChannel) const;	///< @return	The number of frames repeated by the given output channel.
+		virtual NTV2TimingSamples	GetSamples (void) const;								///< @return	A copy of the samples I've retained.
+
+		virtual std::ostream &		Print (std::ostream & inOutStream, const bool inWithHistograms = true) const;	///< @brief	Writes a human-readable report into the given stream.
+		virtual bool				WriteCSV (std::ostream & inOutStream) const;	///< @brief	Writes my retained samples into the given stream as CSV.
+		virtual bool				WriteJSON (std::ostream & inOutStream) const;	///< @brief	Writes my statistics and histograms into the given stream as JSON.
+
+		/**
+			@brief		Encodes a frame counter into the top lines of the given frame as a row of black and white
+						blocks, which survives an SDI loopback and is read back by DecodeFrameCounter.
+			@param		ioFrame			Specifies the host frame buffer to modify.
+			@param[in]	inFormatDesc	Describes the frame. Only ::NTV2_FBF_8BIT_YCBCR and ::NTV2_FBF_10BIT_YCBCR are supported.
+			@param[in]	inCounter		Specifies the counter value.
+			@return		True if successful;  otherwise false.
+		**/
+		static bool		EncodeFrameCounter (NTV2Buffer & ioFrame, const NTV2FormatDescriptor & inFormatDesc, const ULWord inCounter);
+
+		/**
+			@brief		Decodes a frame counter encoded by EncodeFrameCounter.
+			@param[in]	inFrame			Specifies the host frame buffer.
+			@param[in]	inFormatDesc	Describes the frame.
+			@param[out]	outCounter		Receives the counter value.
+			@return		True if a valid counter was found;  otherwise false.
+		**/
+		static bool		DecodeFrameCounter (const NTV2Buffer & inFrame, const NTV2FormatDescriptor & inFormatDesc, ULWord & outCounter);
+
+	protected:
+		typedef std::pair<NTV2Channel, NTV2TimingMetric>		HistoKey;
+		typedef std::map<HistoKey, NTV2TimingHistogram>			HistoMap;
+		typedef std::map<ULWord64, int64_t>						CookieTimes;
+
+		typedef struct ChannelState
+		{
+			int64_t		fFramePeriod;		///< @brief	Nominal frame period, in 100ns units (0 if unknown)
+			int64_t		fLastFrameTime;		///< @brief	Last input VBI timestamp
+			ULWord		fLastDropCount;		///< @brief	Last AUTOCIRCULATE_TRANSFER_STATUS::acFramesDropped
+			bool		fHaveDropCount;
+			uint64_t	fDropped;			///< @brief	Frames dropped (capture)
+			uint64_t	fRepeated;			///< @brief	Frames repeated (playout)
+			CookieTimes	fPending;			///< @brief	Output transfer time of frames not yet seen going out the jack
+			CookieTimes	fPlayed;			///< @brief	Output transfer time of recently played frames, for loopback
+			ChannelState() : fFramePeriod(0), fLastFrameTime(0), fLastDropCount(0), fHaveDropCount(false), fDropped(0), fRepeated(0)	{}
+		} ChannelState;
+		typedef std::map<NTV2Channel, ChannelState>				ChannelStates;
+
+		virtual void	AddSample (const NTV2Channel inChannel, const NTV2TimingMetric inMetric, const ULWord64 inFrame,
+									const int64_t inTimestamp, const int64_t inValue);	///< @note	Caller must hold mLock.
+		virtual void	UpdateDropCount (ChannelState & inState, const AUTOCIRCULATE_TRANSFER & inXfer, const bool inIsInput);
+
+	private:
+		mutable AJALock		mLock;
+		HistoMap			mHistograms;
+		ChannelStates		mChannels;
+		NTV2TimingSamples	mSamples;
+		size_t				mMaxSamples;
+};	//	CNTV2TimingRecorder
+
+#endif	//	NTV2TIMINGRECORDER_H
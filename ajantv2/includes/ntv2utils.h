@@ -62,6 +62,42 @@ AJAExport void CopyToQuadrant (uint8_t* srcBuffer, uint32_t srcHeight, uint32_t
 //	END SECTION MOVED FROM 'videoutilities.h'
 //////////////////////////////////////////////////////
 
+/**
+	@brief	Describes how a UHD/4K or UHD2/8K frame is laid out in a host buffer. (New in SDK 17.5)
+	@note	In the sub-image layouts, each plane holds four stacked quarter-size sub-images (0 thru 3),
+			each having half the raster's lines and half its bytes-per-row.
+**/
+typedef enum
+{
+	NTV2_QUADLAYOUT_RASTER,		///< @brief	One full-size image in ordinary raster order
+	NTV2_QUADLAYOUT_SQUARES,	///< @brief	Square division: sub-images 0..3 are the upper-left, upper-right, lower-left and lower-right quadrants
+	NTV2_QUADLAYOUT_TSI,		///< @brief	SMPTE ST 425-5 two-sample interleave: sub-images 0/1 hold the even/odd pixel pairs of even lines,
+								///			and sub-images 2/3 hold the even/odd pixel pairs of odd lines (also used for UHD2/8K over 4 links)
+	NTV2_QUADLAYOUT_INVALID
+} NTV2QuadLayout;
+
+#define NTV2_IS_VALID_QUADLAYOUT(__x__)		((__x__) >= NTV2_QUADLAYOUT_RASTER  &&  (__x__) < NTV2_QUADLAYOUT_INVALID)
+
+/**
+	@brief		Reorders a UHD/4K or UHD2/8K frame between raster, square-division and two-sample-interleave (TSI) layouts.
+				Work is split into bands of rows that are processed concurrently, and SSE2 non-temporal stores are used
+				(where available) to keep the destination from evicting the source from the cache.
+	@param[in]	inSrcBuffer		Specifies the source frame buffer. Must be at least inDescriptor.GetTotalBytes() in size.
+	@param[in]	inSrcLayout		Specifies the source layout.
+	@param		outDstBuffer	Specifies the destination frame buffer. Must be at least inDescriptor.GetTotalBytes() in size,
+								and must not overlap the source.
+	@param[in]	inDstLayout		Specifies the destination layout.
+	@param[in]	inDescriptor	Describes the full-size raster (e.g. 3840x2160 or 7680x4320). Packed and planar formats
+								are supported if two adjacent pixels occupy a whole number of bytes in each plane.
+								::NTV2_FBF_10BIT_YCBCR is also supported. Its width must be a multiple of 4, and its plane heights must be even.
+	@param[in]	inNumThreads	Specifies the number of threads to use, taken from AJAThreadPool::GetDefault. Defaults to zero,
+								which uses one per CPU (up to 8).
+	@return		True if successful;	 otherwise false.
+**/
+AJAExport bool	ReformatQuadFrame (const NTV2Buffer & inSrcBuffer, const NTV2QuadLayout inSrcLayout,
+									NTV2Buffer & outDstBuffer, const NTV2QuadLayout inDstLayout,
+									const NTV2FormatDescriptor & inDescriptor, const UWord inNumThreads = 0);	//	New in SDK 17.5
+
 /**
 	@brief		Unpacks a line of NTV2_FBF_10BIT_YCBCR video into 16-bit-per-component YUV data.
 	@param[in]	pIn10BitYUVLine		A valid, non-NULL pointer to the start of the line that contains the NTV2_FBF_10BIT_YCBCR data
@@ -625,8 +625,13 @@ typedef enum
 	kVRegHDMIOutStatus1						= VIRTUALREG_START+641,
 	kVRegAudioOutputToneSelect				= VIRTUALREG_START+642,
 	kVRegDynFirmwareUpdateCounts			= VIRTUALREG_START+643,		//	MS 16 bits: # attempts;  LS 16 bits: # successful
+	kVRegDmaPageCacheHits					= VIRTUALREG_START+644,		//	DMA locked buffer cache lookups that found a buffer (all clients)
+	kVRegDmaPageCacheMisses					= VIRTUALREG_START+645,		//	DMA locked buffer cache lookups that found no buffer (all clients)
+	kVRegDmaPageCacheEvictions				= VIRTUALREG_START+646,		//	DMA locked buffers unlocked to stay under the max lock size (all clients)
+	kVRegDmaPageCacheBuffers				= VIRTUALREG_START+647,		//	DMA locked buffers currently cached (all clients)
+	kVRegDmaPageCacheKBytes					= VIRTUALREG_START+648,		//	DMA locked buffer KB currently pinned (all clients)
 
-	kVRegLastAJA							= VIRTUALREG_START+644,		///< @brief The last AJA virtual register slot
+	kVRegLastAJA							= VIRTUALREG_START+649,		///< @brief The last AJA virtual register slot
 	kVRegFirstOEM							= kVRegLastAJA + 1,			///< @brief The first virtual register slot available for general use
 	kVRegLast								= VIRTUALREG_START + MAX_NUM_VIRTUAL_REGISTERS - 1	///< @brief Last virtual register slot
 
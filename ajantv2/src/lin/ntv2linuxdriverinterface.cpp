@@ -7,8 +7,12 @@
 #include "ntv2linuxdriverinterface.h"
 #include "ntv2linuxpublicinterface.h"
 #include "ntv2utils.h"
+#include "ntv2registerexpert.h"
 #include "ajabase/system/debug.h"
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 
@@ -40,6 +44,9 @@ using namespace std;
 CNTV2LinuxDriverInterface::CNTV2LinuxDriverInterface()
 	:	_bitfileDirectory			("../xilinx")
 		,_hDevice					(INVALID_HANDLE_VALUE)
+		,_hEventDevice				(-1)
+		,_pMappedRegisters			(AJA_NULL)
+		,_mappedRegistersSize		(0)
 #if !defined(NTV2_DEPRECATE_16_0)
 		,_pDMADriverBufferAddress	(AJA_NULL)
 		,_BA0MemorySize				(0)
@@ -88,6 +95,7 @@ bool CNTV2LinuxDriverInterface::OpenLocalPhysical (const UWord inDeviceIndex)
         {LDIFAIL("Failed to open device index '" << inDeviceIndex << "'");  return false;}
 
 	_boardNumber = inDeviceIndex;
+	_devicePath = boardStr;
 	if (!CNTV2DriverInterface::ReadRegister(kRegBoardID, _boardID))
 	{
 		LDIFAIL ("ReadRegister failed for 'kRegBoardID': ndx=" << inDeviceIndex << " hDev=" << _hDevice << " id=" << HEX8(_boardID));
@@ -113,9 +121,12 @@ bool CNTV2LinuxDriverInterface::CloseLocalPhysical (void)
 #endif	//	!defined(NTV2_DEPRECATE_16_0)
 
 	LDIINFO ("Closed deviceID=" << HEX8(_boardID) << " ndx=" << DEC(_boardNumber) << " hDev=" << _hDevice);
+	SubscribeInterruptEvents(NTV2InterruptSet());	//	Closes the event descriptor
+	EnableMappedRegisterReads(false);				//	Unmaps the register window
 	if (_hDevice != INVALID_HANDLE_VALUE)
 		close(int(_hDevice));
 	_hDevice = INVALID_HANDLE_VALUE;
+	_devicePath.clear();
 	_boardOpened = false;
 	_boardID = DEVICE_ID_NOTFOUND;
 	_boardNumber = NTV2_MAXBOARDS;
@@ -142,6 +153,12 @@ bool CNTV2LinuxDriverInterface::ReadRegister (const ULWord inRegNum,  ULWord & o
 #endif	//	defined(NTV2_NUB_CLIENT_SUPPORT)
 	if ((_hDevice == INVALID_HANDLE_VALUE) || (_hDevice == 0))
 		return false;
+	ULWord mappedValue(0);
+	if (ReadMappedRegister(inRegNum, mappedValue))
+	{	//	Fast path:	whitelisted register, read straight from the mapping...
+		outValue = (mappedValue & inMask) >> inShift;
+		return true;
+	}
 
 	REGISTER_ACCESS ra;
 	ra.RegisterNumber = inRegNum;
@@ -193,6 +210,112 @@ bool CNTV2LinuxDriverInterface::WriteRegister (const ULWord inRegNum,  const ULW
 	return true;
 }
 
+NTV2StringSet CNTV2LinuxDriverInterface::DefaultMappedRegisterClasses (void)
+{
+	NTV2StringSet result;
+	result.insert(kRegClass_Input);
+	result.insert(kRegClass_Output);
+	result.insert(kRegClass_VPID);
+	result.insert(kRegClass_Timecode);
+	result.insert(kRegClass_Interrupt);
+	result.insert(kRegClass_SDIError);
+	result.insert(kRegClass_ReadOnly);
+	return result;
+}
+
+bool CNTV2LinuxDriverInterface::EnableMappedRegisterReads (const bool inEnable, const NTV2StringSet & inRegClasses)
+{
+	if (_pMappedRegisters)
+	{	//	Always start by unmapping...
+		munmap(const_cast<ULWord*>(_pMappedRegisters), _mappedRegistersSize);
+		_pMappedRegisters = AJA_NULL;
+		_mappedRegistersSize = 0;
+		_mappedRegisterOK.clear();
+		LDIDBG("Register mapping disabled");
+	}
+	if (!inEnable)
+		return true;
+	if (IsRemote())
+		{LDIFAIL("Not supported for remote devices");  return false;}
+	if ((_hDevice == INVALID_HANDLE_VALUE) || (_hDevice == 0))
+		{LDIFAIL("_hDevice is invalid (0 or -1)");  return false;}
+
+	//	The window covers the device's real registers, and no more -- the driver's ReadReg won't read past them either...
+	const ULWord maxRegNum (GetNumSupported(kDeviceGetMaxRegisterNumber));
+	if (!maxRegNum  ||  maxRegNum >= VIRTUALREG_START)
+		{LDIFAIL("Bad max register number " << DEC(maxRegNum) << " for " << ::NTV2DeviceIDToString(_boardID));  return false;}
+	const NTV2StringSet regClasses (inRegClasses.empty() ? DefaultMappedRegisterClasses() : inRegClasses);
+	vector<bool> regOK;
+	const size_t numOK (MappedRegisterWhitelist(regClasses, maxRegNum + 1, regOK));
+	if (!numOK)
+		{LDIFAIL("No registers to map in " << DEC(regClasses.size()) << " class(es)");  return false;}
+	const ULWord pageSize (ULWord(::getpagesize()));
+	const ULWord mapSize ((ULWord(regOK.size() * sizeof(ULWord)) + pageSize - 1) / pageSize * pageSize);
+
+	//	Offset 0x3000 asks the driver for a read-only, uncached mapping of the register window. The driver
+	//	refuses if register access is disabled (e.g. the device is suspended) or the window is too big...
+	void * pMapping (mmap(AJA_NULL, mapSize, PROT_READ, MAP_SHARED, int(_hDevice), 0x3000));
+	if (pMapping == MAP_FAILED)
+		{LDIFAIL("mmap failed, errno=" << DEC(errno) << ": " << ::strerror(errno));  return false;}
+
+	_pMappedRegisters = reinterpret_cast<const volatile ULWord*>(pMapping);
+	_mappedRegistersSize = mapSize;
+	_mappedRegisterOK = regOK;
+	LDIINFO("Register mapping enabled for " << DEC(numOK) << " register(s) in " << DEC(regClasses.size()) << " class(es)");
+	return true;
+}
+
+size_t CNTV2LinuxDriverInterface::MappedRegisterWhitelist (const NTV2StringSet & inRegClasses, const ULWord inNumRegs, vector<bool> & outRegOK)
+{
+	//	Only real registers that lie inside the window, and none with read side-effects...
+	outRegOK.assign(inNumRegs, false);
+	size_t numOK(0);
+	for (NTV2StringSetConstIter it(inRegClasses.begin());  it != inRegClasses.end();  ++it)
+	{
+		const NTV2RegNumSet regs (CNTV2RegisterExpert::GetRegistersForClass(*it));
+		for (NTV2RegNumSetConstIter regIt(regs.begin());  regIt != regs.end();	++regIt)
+		{
+			const ULWord regNum(*regIt);
+			if (regNum >= inNumRegs  ||  regNum >= VIRTUALREG_START  ||  outRegOK.at(regNum))
+				continue;
+			if (CNTV2RegisterExpert::IsRegisterInClass(regNum, kRegClass_Virtual)
+				||  CNTV2RegisterExpert::IsWriteOnly(regNum)
+				||  CNTV2RegisterExpert::IsRegisterInClass(regNum, kRegClass_Serial))
+					continue;	//	The driver intercepts UART regs, and write-only regs read back garbage
+			outRegOK.at(regNum) = true;
+			numOK++;
+		}
+	}
+	return numOK;
+}
+
+bool CNTV2LinuxDriverInterface::ReadMappedRegister (const ULWord inRegNum, ULWord & outValue) const
+{
+	if (!_pMappedRegisters)
+		return false;	//	Not enabled
+	if (inRegNum >= VIRTUALREG_START)
+		return false;	//	Virtual registers live in the driver
+	if (inRegNum >= ULWord(_mappedRegisterOK.size())  ||  inRegNum >= _mappedRegistersSize / sizeof(ULWord))
+		return false;	//	Outside the register window
+	if (!_mappedRegisterOK[inRegNum])
+		return false;	//	Not whitelisted
+	const ULWord value (_pMappedRegisters[inRegNum]);
+	if (value == 0xFFFFFFFF)
+		return false;	//	All ones means the device is suspended or went away -- let the driver sort that out
+	outValue = value;
+	return true;
+}
+
+NTV2RegNumSet CNTV2LinuxDriverInterface::GetMappedRegisterNumbers (void) const
+{
+	NTV2RegNumSet result;
+	if (_pMappedRegisters)
+		for (ULWord regNum(0);	regNum < ULWord(_mappedRegisterOK.size());	regNum++)
+			if (_mappedRegisterOK[regNum])
+				result.insert(regNum);
+	return result;
+}
+
 bool CNTV2LinuxDriverInterface::RestoreHardwareProcampRegisters (void)
 {
 	if (IsRemote())
@@ -316,6 +439,82 @@ bool CNTV2LinuxDriverInterface::WaitForInterrupt (const INTERRUPT_ENUMS eInterru
 	return waitIntrStruct.success != 0;
 }
 
+bool CNTV2LinuxDriverInterface::SubscribeInterruptEvents (const NTV2InterruptSet & inInterrupts)
+{
+	if (IsRemote())
+		return false;
+	if (inInterrupts.empty())
+	{
+		if (_hEventDevice >= 0)
+			close(_hEventDevice);
+		_hEventDevice = -1;
+		return true;
+	}
+	if (!IsOpen()  ||  _devicePath.empty())
+		return false;
+
+	NTV2_INTERRUPT_EVENTS_STRUCT eventsStruct;
+	::memset(&eventsStruct, 0, sizeof(eventsStruct));
+	for (NTV2InterruptSet::const_iterator it(inInterrupts.begin());  it != inInterrupts.end();  ++it)
+		if (NTV2_IS_VALID_INTERRUPT_ENUM(*it))
+			eventsStruct.subscribeMask |= ULWord64(1) << *it;
+	eventsStruct.setMask = 1;
+
+	//	Events are tracked per open file, so use a descriptor of our own rather than _hDevice...
+	if (_hEventDevice < 0)
+		_hEventDevice = open(_devicePath.c_str(), O_RDWR | O_CLOEXEC);
+	if (_hEventDevice < 0)
+		{LDIFAIL("Failed to open '" << _devicePath << "' for interrupt events");  return false;}
+	if (ioctl(_hEventDevice, IOCTL_NTV2_INTERRUPT_EVENTS, &eventsStruct))
+	{
+		LDIFAIL("IOCTL_NTV2_INTERRUPT_EVENTS failed -- driver may not support interrupt events");
+		close(_hEventDevice);
+		_hEventDevice = -1;
+		return false;
+	}
+	LDIDBG("Subscribed to interrupt mask " << HEX16(eventsStruct.subscribeMask) << " on fd " << _hEventDevice);
+	return true;
+}
+
+bool CNTV2LinuxDriverInterface::ReadInterruptEvents (NTV2InterruptEvents & outEvents)
+{
+	outEvents.clear();
+	if (_hEventDevice < 0)
+		return false;
+	NTV2_INTERRUPT_EVENTS_STRUCT eventsStruct;
+	::memset(&eventsStruct, 0, sizeof(eventsStruct));
+	if (ioctl(_hEventDevice, IOCTL_NTV2_INTERRUPT_EVENTS, &eventsStruct))
+		{LDIFAIL("IOCTL_NTV2_INTERRUPT_EVENTS failed");  return false;}
+	for (int intr(0);  eventsStruct.eventMask  &&  intr < eNumInterruptTypes;  intr++)
+		if (eventsStruct.eventMask & (ULWord64(1) << intr))
+		{
+			NTV2InterruptEvent event;
+			event.fInterrupt = INTERRUPT_ENUMS(intr);
+			event.fCount = eventsStruct.eventCount[intr];
+			event.fTime = eventsStruct.eventTime[intr];
+			outEvents.push_back(event);
+			BumpEventCount(event.fInterrupt);
+		}
+	return true;
+}
+
+bool CNTV2LinuxDriverInterface::WaitForInterruptEvents (NTV2InterruptEvents & outEvents, const ULWord inTimeoutMs)
+{
+	outEvents.clear();
+	if (_hEventDevice < 0)
+		return false;
+	struct pollfd pfd;
+	pfd.fd = _hEventDevice;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	const int result (poll(&pfd, 1, int(inTimeoutMs)));
+	if (result < 0)
+		{LDIFAIL("poll failed, errno=" << errno);  return false;}
+	if (result == 0  ||  !(pfd.revents & POLLIN))
+		return false;	//	Timed out
+	return ReadInterruptEvents(outEvents)  &&  !outEvents.empty();
+}
+
 // Method: ControlDriverDebugMessages
 // Output: True on successs, false on failure (ioctl failed or interrupt didn't happen)
 bool CNTV2LinuxDriverInterface::ControlDriverDebugMessages (NTV2_DriverDebugMessageSet msgSet, bool enable)
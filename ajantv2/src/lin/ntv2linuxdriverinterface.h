@@ -12,6 +12,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <string>
+#include <set>
 
 #define CopyMemory(a,b,c) memcpy((a),(b),(c))
 
@@ -19,6 +20,19 @@
 #include <vector>
 typedef std::vector<ULWord *> DMA_LOCKED_VEC;
 
+/**
+	@brief	An interrupt event read by CNTV2LinuxDriverInterface::ReadInterruptEvents.
+**/
+typedef struct NTV2InterruptEvent
+{
+	INTERRUPT_ENUMS	fInterrupt;	///< @brief	The interrupt that fired
+	ULWord			fCount;		///< @brief	Number of times it fired since the last read (more than 1 means some weren't serviced)
+	int64_t			fTime;		///< @brief	Host time of the latest one, in 100 ns units (same clock as FRAME_STAMP)
+} NTV2InterruptEvent;
+
+typedef std::vector<NTV2InterruptEvent>	NTV2InterruptEvents;	//	New in SDK 17.5
+typedef std::set<INTERRUPT_ENUMS>		NTV2InterruptSet;		//	New in SDK 17.5
+
 /**
 	@brief	Linux implementation of CNTV2DriverInterface.
 **/
@@ -69,6 +83,65 @@ class CNTV2LinuxDriverInterface : public CNTV2DriverInterface
 	AJA_VIRTUAL bool GetInterruptCount (const INTERRUPT_ENUMS eInterrupt, ULWord & outCount);
 	AJA_VIRTUAL bool WaitForInterrupt (INTERRUPT_ENUMS eInterrupt, ULWord timeOutMs = 68);	// default of 68 ms timeout is enough time for 2K at 14.98 HZ
 
+	/**
+		@brief		Subscribes to the given interrupts as events on a separate file descriptor that polls readable while
+					events are pending. One thread can then service every channel from a single poll/epoll loop, instead
+					of parking a thread per interrupt in WaitForInterrupt.
+		@param[in]	inInterrupts	Specifies the interrupts of interest. An empty set unsubscribes and closes the descriptor.
+		@return		True if successful;  otherwise false.
+		@note		The interrupts must still be enabled (e.g. with ConfigureInterrupt). Requires driver support.
+	**/
+	AJA_VIRTUAL bool SubscribeInterruptEvents (const NTV2InterruptSet & inInterrupts);	//	New in SDK 17.5
+
+	/**
+		@return		The file descriptor to add to poll/select/epoll, or -1 if not subscribed.
+	**/
+	AJA_VIRTUAL inline int InterruptEventDescriptor (void) const	{return _hEventDevice;}	//	New in SDK 17.5
+
+	/**
+		@brief		Reads the pending interrupt events without blocking.
+		@param[out]	outEvents		Receives one event per subscribed interrupt that fired since the last read.
+		@return		True if successful (even if there were no events);  otherwise false.
+	**/
+	AJA_VIRTUAL bool ReadInterruptEvents (NTV2InterruptEvents & outEvents);	//	New in SDK 17.5
+
+	/**
+		@brief		Waits for any subscribed interrupt to fire, then reads the pending interrupt events.
+		@param[out]	outEvents		Receives one event per subscribed interrupt that fired since the last read.
+		@param[in]	inTimeoutMs		Specifies the maximum time to wait, in milliseconds.
+		@return		True if at least one event was read;  false upon timeout or failure.
+	**/
+	AJA_VIRTUAL bool WaitForInterruptEvents (NTV2InterruptEvents & outEvents, const ULWord inTimeoutMs = 68);	//	New in SDK 17.5
+
+	/**
+		@brief		Enables or disables the mapped register read fast path. When enabled, ReadRegister reads whitelisted
+					registers directly from a read-only, uncached mapping of the register BAR, instead of making a driver
+					call for each read. All other registers (including all virtual registers) are still read by the driver.
+		@param[in]	inEnable		Specify true to map the registers and enable the fast path;  false to disable and unmap.
+		@param[in]	inRegClasses	Specifies the register classes to whitelist (see CNTV2RegisterExpert). If empty (the default),
+									uses DefaultMappedRegisterClasses. Virtual, write-only and serial port registers are never
+									whitelisted.
+		@return		True if successful;  otherwise false.
+		@note		Enable this before other threads start reading registers on this instance. Requires driver support.
+	**/
+	AJA_VIRTUAL bool EnableMappedRegisterReads (const bool inEnable = true, const NTV2StringSet & inRegClasses = NTV2StringSet());	//	New in SDK 17.5
+
+	/**
+		@return		True if the mapped register read fast path is enabled;  otherwise false.
+	**/
+	AJA_VIRTUAL inline bool HasMappedRegisterReads (void) const		{return _pMappedRegisters != AJA_NULL;}	//	New in SDK 17.5
+
+	/**
+		@return		The numbers of the registers that ReadRegister reads from the register mapping (empty if not enabled).
+	**/
+	AJA_VIRTUAL NTV2RegNumSet GetMappedRegisterNumbers (void) const;	//	New in SDK 17.5
+
+	/**
+		@return		The register classes whitelisted by default by EnableMappedRegisterReads -- i.e. input and output
+					(frame) registers, VPID, timecode, interrupt/status, SDI error counters and read-only registers.
+	**/
+	static NTV2StringSet DefaultMappedRegisterClasses (void);	//	New in SDK 17.5
+
 	AJA_VIRTUAL bool AutoCirculate (AUTOCIRCULATE_DATA &autoCircData);
 	AJA_VIRTUAL bool NTV2Message (NTV2_HEADER * pInOutMessage);
 	AJA_VIRTUAL bool ControlDriverDebugMessages(NTV2_DriverDebugMessageSet msgSet,
@@ -127,9 +200,36 @@ protected:	//	PRIVATE METHODS
 	AJA_VIRTUAL bool	CloseLocalPhysical	(void);
 #endif	//	!defined(NTV2_NULL_DEVICE)
 
+protected:	//	MAPPED REGISTER READS
+	/**
+		@brief		Reads a register from the register mapping, applying the same checks the driver applies to a
+					register read:  the register must be a real register inside the mapped register window (which
+					never extends past the device's highest register number), and it must be whitelisted.
+		@param[in]	inRegNum	Specifies the register number.
+		@param[out]	outValue	Receives the register value.
+		@return		True if the register was read from the mapping;  false if the driver must read it.
+		@note		A register that reads as all ones is left to the driver, which refuses register access while
+					the device is suspended or gone.
+	**/
+	AJA_VIRTUAL bool	ReadMappedRegister (const ULWord inRegNum, ULWord & outValue) const;
+
+	/**
+		@brief		Builds the mapped register read whitelist.
+		@param[in]	inRegClasses	Specifies the register classes to whitelist (see EnableMappedRegisterReads).
+		@param[in]	inNumRegs		Specifies the number of registers in the register window.
+		@param[out]	outRegOK		Receives the whitelist, indexed by register number, with inNumRegs entries.
+		@return		The number of whitelisted registers.
+	**/
+	static size_t		MappedRegisterWhitelist (const NTV2StringSet & inRegClasses, const ULWord inNumRegs, std::vector<bool> & outRegOK);
+
 protected:	//	INSTANCE DATA
 	std::string		_bitfileDirectory;
 	HANDLE			_hDevice;
+	std::string		_devicePath;		///< @brief	Path of the device node I opened
+	int				_hEventDevice;		///< @brief	Interrupt event descriptor (see SubscribeInterruptEvents)
+	const volatile ULWord *	_pMappedRegisters;	///< @brief	Read-only register mapping (see EnableMappedRegisterReads)
+	ULWord			_mappedRegistersSize;	///< @brief	Size of the register mapping, in bytes
+	std::vector<bool>	_mappedRegisterOK;	///< @brief	Whitelist of registers to read from the mapping, indexed by register number
 #if !defined(NTV2_DEPRECATE_16_0)
 	ULWord *		_pDMADriverBufferAddress;
 	ULWord			_BA0MemorySize;
@@ -67,6 +67,12 @@
 #define IOCTL_NTV2_WAITFOR_INTERRUPT \
 			_IOW(NTV2_DEVICE_TYPE, 221, NTV2_WAITFOR_INTERRUPT_STRUCT)
 
+// Subscribe to interrupt events on this file descriptor, and read the pending events.
+// The descriptor polls readable while a subscribed interrupt has unread events.
+//
+#define IOCTL_NTV2_INTERRUPT_EVENTS \
+			_IOWR(NTV2_DEVICE_TYPE, 222, NTV2_INTERRUPT_EVENTS_STRUCT)
+
 // Control debug messages.
 //
 #define IOCTL_NTV2_CONTROL_DRIVER_DEBUG_MESSAGES \
@@ -211,6 +217,17 @@ typedef struct
    ULWord			success;		// On return, nonzero if interrupt occured
 } NTV2_WAITFOR_INTERRUPT_STRUCT, *P_NTV2_WAITFOR_INTERRUPT_STRUCT;
 
+// Structure to subscribe to and read interrupt events
+typedef struct
+{
+   ULWord64			subscribeMask;						// In: bit per INTERRUPT_ENUMS to subscribe to (if setMask is nonzero)
+   ULWord64			eventMask;							// Out: bit per INTERRUPT_ENUMS that had events since the last read
+   ULWord			setMask;							// In: nonzero replaces the subscription with subscribeMask, and discards pending events
+   ULWord			reserved;
+   LWord64			eventTime[eNumInterruptTypes];		// Out: time of the latest interrupt (100 ns units, same clock as FRAME_STAMP)
+   ULWord			eventCount[eNumInterruptTypes];		// Out: number of interrupts since the last read
+} NTV2_INTERRUPT_EVENTS_STRUCT, *P_NTV2_INTERRUPT_EVENTS_STRUCT;
+
 // Structure to control driver debug messages
 typedef struct
 {
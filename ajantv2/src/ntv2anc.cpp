@@ -128,6 +128,7 @@ bool CNTV2Card::AncSetFrameBufferSize (const ULWord inF1Size, const ULWord inF2S
 	bool ok(true);
 	if (ok) ok = WriteRegister(kVRegAncField1Offset, inF1Size + inF2Size);
 	if (ok) ok = WriteRegister(kVRegAncField2Offset, inF2Size);
+	InvalidateACXferContext();	//	2110 playout anc buffer sizes are cached per channel
 	return ok;
 }
 
@@ -10,6 +10,7 @@
 #include "ntv2rp188.h"
 #include "ntv2endian.h"
 #include "ajabase/system/lock.h"
+#include "ajabase/system/atomic.h"
 #include "ajabase/system/debug.h"
 #include "ajaanc/includes/ancillarylist.h"
 #include "ajaanc/includes/ancillarydata_timecode_atc.h"
@@ -341,6 +342,7 @@ bool CNTV2Card::AutoCirculateInitForInput ( const NTV2Channel		inChannel,
 			}
 		}
 		#endif
+		PrepareACXferContext(inChannel);	//	Cache what AutoCirculateTransfer needs for each frame
 		ACINFO("Input Ch" << DEC(inChannel+1) << " initialized using frames " << DEC(startFrameNumber) << "-" << DEC(endFrameNumber));
 	}
 	else
@@ -491,6 +493,7 @@ bool CNTV2Card::AutoCirculateInitForOutput (const NTV2Channel		inChannel,
 			}
 		}
 		#endif
+		PrepareACXferContext(inChannel);	//	Cache what AutoCirculateTransfer needs for each frame
 		ACINFO("Output Ch" << DEC(inChannel+1) << " initialized using frames " << DEC(startFrameNumber) << "-" << DEC(endFrameNumber));
 	}
 	else
@@ -535,6 +538,7 @@ bool CNTV2Card::AutoCirculateStop (const NTV2Channel inChannel, const bool inAbo
 		ACFAIL("Failed to stop Ch" << DEC(inChannel+1));
 		return false;	//	Both failed
 	}
+	InvalidateACXferContext(inChannel);
 	if (inAbort)
 	{
 		ACINFO("Aborted Ch" << DEC(inChannel+1));
@@ -692,6 +696,93 @@ bool CNTV2Card::AutoCirculateSetActiveFrame (const NTV2Channel inChannel, const
 }	//	AutoCirculateSetActiveFrame
 
 
+//	Temporarily points an AUTOCIRCULATE_TRANSFER anc buffer at a (zeroed) scratch buffer that's prefilled with the
+//	client buffer's content, and remembers the client's buffer (if any) so it can be put back afterward...
+static void BorrowScratchAncBuffer (NTV2Buffer & inOutXferBuffer, NTV2Buffer & inScratch, const size_t inByteCount, NTV2Buffer & outClientBuffer)
+{
+	inScratch.Allocate(inByteCount);	//	Only allocates if byte count changed -- otherwise just zeroes it
+	if (inOutXferBuffer  &&  inScratch)
+		inScratch.CopyFrom(inOutXferBuffer, 0, 0, std::min(inOutXferBuffer.GetByteCount(), inScratch.GetByteCount()));
+	outClientBuffer.Set(inOutXferBuffer.GetHostPointer(), inOutXferBuffer.GetByteCount());
+	inOutXferBuffer.Set(inScratch.GetHostPointer(), inScratch.GetByteCount());
+}
+
+
+//	ACXferContext::fPrepared states -- InvalidateACXferContext can be called from any thread, even mid-prepare
+static const uint32_t	ACXferStale		(0);
+static const uint32_t	ACXferPrepared	(1);
+static const uint32_t	ACXferPreparing	(2);
+
+bool CNTV2Card::PrepareACXferContext (const NTV2Channel inChannel)
+{
+	if (!NTV2_IS_VALID_CHANNEL(inChannel))
+		return false;
+	ACXferContext & ctx (mACXferContexts[inChannel]);
+	AJAAtomic::Exchange(&ctx.fPrepared, ACXferPreparing);
+	if (!GetCurrentACChannelCrosspoint (*this, inChannel, ctx.fCrosspoint))
+		return false;
+	if (!NTV2_IS_VALID_NTV2CROSSPOINT(ctx.fCrosspoint))
+		return false;
+	ctx.fTaskMode = NTV2_OEM_TASKS;
+	GetEveryFrameServices(ctx.fTaskMode);
+	ctx.fIsProgressive = false;
+	if (NTV2_IS_OUTPUT_CROSSPOINT(ctx.fCrosspoint))
+		IsProgressiveStandard(ctx.fIsProgressive, inChannel);
+	ctx.fIs2110 = IsSupported(kDeviceCanDo2110);
+	ctx.fIsIoIP2110 = (_boardID == DEVICE_ID_IOIP_2110) || (_boardID == DEVICE_ID_IOIP_2110_RGB12);
+	ctx.fF1AncBytes = ctx.fF2AncBytes = 0;
+
+	if (ctx.fIs2110  &&  NTV2_IS_OUTPUT_CROSSPOINT(ctx.fCrosspoint))
+	{	//	Size the S2110 playout anc buffers...
+		ULWord	F1OffsetFromBottom(0),	F2OffsetFromBottom(0);
+		if (GetAncRegionOffsetFromBottom(F1OffsetFromBottom, NTV2_AncRgn_Field1)
+			&&	GetAncRegionOffsetFromBottom(F2OffsetFromBottom, NTV2_AncRgn_Field2))
+		{
+			ctx.fF2AncBytes = size_t(F2OffsetFromBottom);
+			if (F2OffsetFromBottom < F1OffsetFromBottom)
+				ctx.fF1AncBytes = size_t(F1OffsetFromBottom - F2OffsetFromBottom);
+			else
+				ctx.fF1AncBytes = size_t(F2OffsetFromBottom - F1OffsetFromBottom);
+		}
+		if (ctx.fIsIoIP2110)
+		{	//	IoIP 2110 Playout requires room for RTP+GUMP per anc buffer, to also operate SDI5 Mon output
+			ULWord	F1MonOffsetFromBottom(0),  F2MonOffsetFromBottom(0);
+			const bool good (GetAncRegionOffsetFromBottom(F1MonOffsetFromBottom, NTV2_AncRgn_MonField1)
+							 &&	 GetAncRegionOffsetFromBottom(F2MonOffsetFromBottom, NTV2_AncRgn_MonField2));
+			if (good	//	Driver expects anc regions in this order (from bottom): F2Mon, F2, F1Mon, F1
+				&&	F2MonOffsetFromBottom < F2OffsetFromBottom
+				&&	F2OffsetFromBottom < F1MonOffsetFromBottom
+				&&	F1MonOffsetFromBottom < F1OffsetFromBottom)
+			{
+				ctx.fF1AncBytes = size_t(F1OffsetFromBottom - F2OffsetFromBottom);
+				ctx.fF2AncBytes = size_t(F2OffsetFromBottom);
+			}
+			else
+			{	//	Anc regions out of order!
+				XMTWARN("IoIP 2110 playout anc rgns disordered (offsets from bottom): F2Mon=" << HEX0N(F2MonOffsetFromBottom,8)
+						<< " F2=" << HEX0N(F2OffsetFromBottom,8) << " F1Mon=" << HEX0N(F1MonOffsetFromBottom,8)
+						<< " F1=" << HEX0N(F1OffsetFromBottom,8));
+				ctx.fF1AncBytes = ctx.fF2AncBytes = 0;	//	Out of order, don't do Anc
+			}
+		}	//	if IoIP 2110 playout
+	}	//	if SMPTE 2110 playout
+	if (AJAAtomic::Exchange(&ctx.fPrepared, ACXferPrepared) != ACXferPreparing)
+		AJAAtomic::Exchange(&ctx.fPrepared, ACXferStale);	//	Invalidated while I was preparing -- prepare again next time
+	ACDBG("Ch" << DEC(inChannel+1) << " transfer context prepared: " << " crosspoint=" << DEC(ctx.fCrosspoint)
+			<< (ctx.fIs2110 ? " 2110" : "") << " F1AncBytes=" << DEC(ctx.fF1AncBytes) << " F2AncBytes=" << DEC(ctx.fF2AncBytes));
+	return true;
+
+}	//	PrepareACXferContext
+
+
+void CNTV2Card::InvalidateACXferContext (const NTV2Channel inChannel)
+{
+	for (NTV2Channel ch(NTV2_CHANNEL1);  ch < NTV2_MAX_NUM_CHANNELS;  ch = NTV2Channel(ch+1))
+		if (inChannel == ch  ||  !NTV2_IS_VALID_CHANNEL(inChannel))
+			AJAAtomic::Exchange(&mACXferContexts[ch].fPrepared, ACXferStale);
+}
+
+
 bool CNTV2Card::AutoCirculateTransfer (const NTV2Channel inChannel, AUTOCIRCULATE_TRANSFER & inOutXferInfo)
 {
 	if (!_boardOpened)
@@ -700,20 +791,20 @@ bool CNTV2Card::AutoCirculateTransfer (const NTV2Channel inChannel, AUTOCIRCULAT
 		NTV2_ASSERT (inOutXferInfo.NTV2_IS_STRUCT_VALID ());
 	#endif
 
-	NTV2Crosspoint			crosspoint	(NTV2CROSSPOINT_INVALID);
-	NTV2EveryFrameTaskMode	taskMode	(NTV2_OEM_TASKS);
-	if (!GetCurrentACChannelCrosspoint (*this, inChannel, crosspoint))
+	//	Everything that doesn't change from frame to frame was cached by AutoCirculateInitForInput/Output...
+	if (!NTV2_IS_VALID_CHANNEL(inChannel))
 		return false;
-	if (!NTV2_IS_VALID_NTV2CROSSPOINT(crosspoint))
+	ACXferContext &					ctx			(mACXferContexts[inChannel]);
+	if (*static_cast<const uint32_t volatile*>(&ctx.fPrepared) != ACXferPrepared  &&  !PrepareACXferContext(inChannel))
 		return false;
-	GetEveryFrameServices(taskMode);
+	const NTV2Crosspoint			crosspoint	(ctx.fCrosspoint);
+	const NTV2EveryFrameTaskMode	taskMode	(ctx.fTaskMode);
 
 	if (NTV2_IS_INPUT_CROSSPOINT(crosspoint))
 		inOutXferInfo.acTransferStatus.acFrameStamp.acTimeCodes.Fill(ULWord(0xFFFFFFFF));	//	Invalidate old timecodes
 	else if (NTV2_IS_OUTPUT_CROSSPOINT(crosspoint))
 	{
-		bool isProgressive (false);
-		IsProgressiveStandard(isProgressive, inChannel);
+		const bool isProgressive (ctx.fIsProgressive);
 		if (inOutXferInfo.acRP188.IsValid())
 			inOutXferInfo.SetAllOutputTimeCodes(inOutXferInfo.acRP188, /*alsoSetF2*/!isProgressive);
 
@@ -722,80 +813,65 @@ bool CNTV2Card::AutoCirculateTransfer (const NTV2Channel inChannel, AUTOCIRCULAT
 			inOutXferInfo.SetAllOutputTimeCodes(pArray[NTV2_TCINDEX_DEFAULT], /*alsoSetF2*/!isProgressive);
 	}
 
-	bool		tmpLocalF1AncBuffer(false),	 tmpLocalF2AncBuffer(false);
-	NTV2Buffer	savedAncF1,	 savedAncF2;
-	if (IsSupported(kDeviceCanDo2110)  &&  NTV2_IS_OUTPUT_CROSSPOINT(crosspoint))
+	NTV2Buffer &	xferAncF1	(inOutXferInfo.acANCBuffer);
+	NTV2Buffer &	xferAncF2	(inOutXferInfo.acANCField2Buffer);
+	NTV2Buffer		clientAncF1,  clientAncF2;	//	Client's anc buffers, while the xfer struct points to scratch buffers
+	bool			borrowedF1(false),  borrowedF2(false),  savedF1(false),  savedF2(false);
+	if (ctx.fIs2110  &&  NTV2_IS_OUTPUT_CROSSPOINT(crosspoint))
 	{
 		//	S2110 Playout:	So that most Retail & OEM playout apps "just work" with S2110 RTP Anc streams,
 		//					our classic SDI Anc data that device firmware normally embeds into SDI output
 		//					as derived from registers -- VPID & RP188 -- the SDK here automatically inserts
 		//					these packets into the outgoing RTP streams, even if the client didn't provide
 		//					Anc buffers in the AUTOCIRCULATE_TRANSFER object, or specify AUTOCIRCULATE_WITH_ANC.
-		ULWord	F1OffsetFromBottom(0),	F2OffsetFromBottom(0);
-		size_t	F1SizeInBytes(0), F2SizeInBytes(0);
-		if (GetAncRegionOffsetFromBottom(F1OffsetFromBottom, NTV2_AncRgn_Field1)
-			&&	GetAncRegionOffsetFromBottom(F2OffsetFromBottom, NTV2_AncRgn_Field2))
-		{
-			F2SizeInBytes = size_t(F2OffsetFromBottom);
-			if (F2OffsetFromBottom < F1OffsetFromBottom)
-				F1SizeInBytes = size_t(F1OffsetFromBottom - F2OffsetFromBottom);
-			else
-				F1SizeInBytes = size_t(F2OffsetFromBottom - F1OffsetFromBottom);
-		}
-		if ((_boardID == DEVICE_ID_IOIP_2110) || (_boardID == DEVICE_ID_IOIP_2110_RGB12))
+		//					Missing (or too-small) client buffers are replaced with the context's scratch buffers
+		//					for the duration of the transfer, and the client's buffer content is preserved.
+		if (ctx.fIsIoIP2110)
 		{	//	IoIP 2110 Playout requires room for RTP+GUMP per anc buffer, to also operate SDI5 Mon output
-			ULWord	F1MonOffsetFromBottom(0),  F2MonOffsetFromBottom(0);
-			const bool good (GetAncRegionOffsetFromBottom(F1MonOffsetFromBottom, NTV2_AncRgn_MonField1)
-							 &&	 GetAncRegionOffsetFromBottom(F2MonOffsetFromBottom, NTV2_AncRgn_MonField2));
-			if (good	//	Driver expects anc regions in this order (from bottom): F2Mon, F2, F1Mon, F1
-				&&	F2MonOffsetFromBottom < F2OffsetFromBottom
-				&&	F2OffsetFromBottom < F1MonOffsetFromBottom
-				&&	F1MonOffsetFromBottom < F1OffsetFromBottom)
+			if (xferAncF1.GetByteCount() < ctx.fF1AncBytes  &&  xferAncF1.IsProvidedByClient())
+				{BorrowScratchAncBuffer(xferAncF1, ctx.fAncF1, ctx.fF1AncBytes, clientAncF1);  borrowedF1 = true;}
+			else
 			{
-				F1SizeInBytes = size_t(F1OffsetFromBottom - F2OffsetFromBottom);
-				F2SizeInBytes = size_t(F2OffsetFromBottom);
+				ctx.fSavedAncF1 = xferAncF1;	//	copy
+				savedF1 = true;
+				if (xferAncF1.GetByteCount() < ctx.fF1AncBytes)
+				{	//	Enlarge SDK-allocated acANCBuffer, and copy everything from saved copy into it...
+					xferAncF1.Allocate(ctx.fF1AncBytes);
+					xferAncF1.CopyFrom(ctx.fSavedAncF1, 0, 0, ctx.fSavedAncF1.GetByteCount());
+				}
 			}
+			if (xferAncF2.GetByteCount() < ctx.fF2AncBytes  &&  xferAncF2.IsProvidedByClient())
+				{BorrowScratchAncBuffer(xferAncF2, ctx.fAncF2, ctx.fF2AncBytes, clientAncF2);  borrowedF2 = true;}
 			else
-			{	//	Anc regions out of order!
-				XMTWARN("IoIP 2110 playout anc rgns disordered (offsets from bottom): F2Mon=" << HEX0N(F2MonOffsetFromBottom,8)
-						<< " F2=" << HEX0N(F2OffsetFromBottom,8) << " F1Mon=" << HEX0N(F1MonOffsetFromBottom,8)
-						<< " F1=" << HEX0N(F1OffsetFromBottom,8));
-				F1SizeInBytes = F2SizeInBytes = 0;	//	Out of order, don't do Anc
-			}
-			savedAncF1 = inOutXferInfo.acANCBuffer;			//	copy
-			savedAncF2 = inOutXferInfo.acANCField2Buffer;	//	copy
-			if (inOutXferInfo.acANCBuffer.GetByteCount() < F1SizeInBytes)
-			{	//	Enlarge acANCBuffer, and copy everything from savedAncF1 into it...
-				inOutXferInfo.acANCBuffer.Allocate(F1SizeInBytes);
-				inOutXferInfo.acANCBuffer.Fill(uint64_t(0));
-				inOutXferInfo.acANCBuffer.CopyFrom(savedAncF1, 0, 0, savedAncF1.GetByteCount());
-			}
-			if (inOutXferInfo.acANCField2Buffer.GetByteCount() < F2SizeInBytes)
-			{	//	Enlarge acANCField2Buffer, and copy everything from savedAncF2 into it...
-				inOutXferInfo.acANCField2Buffer.Allocate(F2SizeInBytes);
-				inOutXferInfo.acANCField2Buffer.Fill(uint64_t(0));
-				inOutXferInfo.acANCField2Buffer.CopyFrom(savedAncF2, 0, 0, savedAncF2.GetByteCount());
+			{
+				ctx.fSavedAncF2 = xferAncF2;	//	copy
+				savedF2 = true;
+				if (xferAncF2.GetByteCount() < ctx.fF2AncBytes)
+				{	//	Enlarge SDK-allocated acANCField2Buffer, and copy everything from saved copy into it...
+					xferAncF2.Allocate(ctx.fF2AncBytes);
+					xferAncF2.CopyFrom(ctx.fSavedAncF2, 0, 0, ctx.fSavedAncF2.GetByteCount());
+				}
 			}
 		}	//	if IoIP 2110 playout
 		else
 		{	//	else KonaIP 2110 playout
-			if (inOutXferInfo.acANCBuffer.IsNULL())
-				tmpLocalF1AncBuffer = inOutXferInfo.acANCBuffer.Allocate(F1SizeInBytes);
+			if (xferAncF1.IsNULL())
+				{BorrowScratchAncBuffer(xferAncF1, ctx.fAncF1, ctx.fF1AncBytes, clientAncF1);  borrowedF1 = true;}
 			else
-				savedAncF1 = inOutXferInfo.acANCBuffer; //	copy
-			if (inOutXferInfo.acANCField2Buffer.IsNULL())
-				tmpLocalF2AncBuffer = inOutXferInfo.acANCField2Buffer.Allocate(F2SizeInBytes);
+				{ctx.fSavedAncF1 = xferAncF1;  savedF1 = true;}	//	copy
+			if (xferAncF2.IsNULL())
+				{BorrowScratchAncBuffer(xferAncF2, ctx.fAncF2, ctx.fF2AncBytes, clientAncF2);  borrowedF2 = true;}
 			else
-				savedAncF2 = inOutXferInfo.acANCField2Buffer;	//	copy
+				{ctx.fSavedAncF2 = xferAncF2;  savedF2 = true;}	//	copy
 		}	//	else KonaIP 2110 playout
 		S2110DeviceAncToXferBuffers(inChannel, inOutXferInfo);
 	}	//	if SMPTE 2110 playout
-	else if (IsSupported(kDeviceCanDo2110)  &&  NTV2_IS_INPUT_CROSSPOINT(crosspoint))
+	else if (ctx.fIs2110  &&  NTV2_IS_INPUT_CROSSPOINT(crosspoint))
 	{	//	Need local host buffers to receive 2110 Anc VPID & ATC
-		if (inOutXferInfo.acANCBuffer.IsNULL())
-			tmpLocalF1AncBuffer = inOutXferInfo.acANCBuffer.Allocate(2048);
-		if (inOutXferInfo.acANCField2Buffer.IsNULL())
-			tmpLocalF2AncBuffer = inOutXferInfo.acANCField2Buffer.Allocate(2048);
+		if (xferAncF1.IsNULL())
+			{BorrowScratchAncBuffer(xferAncF1, ctx.fAncF1, 2048, clientAncF1);  borrowedF1 = true;}
+		if (xferAncF2.IsNULL())
+			{BorrowScratchAncBuffer(xferAncF2, ctx.fAncF2, 2048, clientAncF2);  borrowedF2 = true;}
 	}	//	if SMPTE 2110 capture
 
 	/////////////////////////////////////////////////////////////////////////////
@@ -806,7 +882,7 @@ bool CNTV2Card::AutoCirculateTransfer (const NTV2Channel inChannel, AUTOCIRCULAT
 
 	if (result	&&	NTV2_IS_INPUT_CROSSPOINT(crosspoint))
 	{
-		if (IsSupported(kDeviceCanDo2110))
+		if (ctx.fIs2110)
 		{	//	S2110:	decode VPID and timecode anc packets from RTP, and put into A/C Xfer and device regs
 			S2110DeviceAncFromXferBuffers(inChannel, inOutXferInfo);
 		}
@@ -856,16 +932,16 @@ bool CNTV2Card::AutoCirculateTransfer (const NTV2Channel inChannel, AUTOCIRCULAT
 	}	//	if NTV2Message OK && capturing
 	if (result	&&	NTV2_IS_OUTPUT_CROSSPOINT(crosspoint))
 	{
-		if (savedAncF1)
-			inOutXferInfo.acANCBuffer = savedAncF1;			//	restore
-		if (savedAncF2)
-			inOutXferInfo.acANCField2Buffer = savedAncF2;	//	restore
+		if (savedF1  &&  ctx.fSavedAncF1)
+			xferAncF1 = ctx.fSavedAncF1;	//	restore
+		if (savedF2  &&  ctx.fSavedAncF2)
+			xferAncF2 = ctx.fSavedAncF2;	//	restore
 	}	//	if successful playout
 
-	if (tmpLocalF1AncBuffer)
-		inOutXferInfo.acANCBuffer.Deallocate();
-	if (tmpLocalF2AncBuffer)
-		inOutXferInfo.acANCField2Buffer.Deallocate();
+	if (borrowedF1)
+		xferAncF1.Set(clientAncF1.GetHostPointer(), clientAncF1.GetByteCount());	//	Give back client's buffer
+	if (borrowedF2)
+		xferAncF2.Set(clientAncF2.GetHostPointer(), clientAncF2.GetByteCount());	//	Give back client's buffer
 
 	#if defined (AJA_NTV2_CLEAR_DEVICE_ANC_BUFFER_AFTER_CAPTURE_XFER)
 		if (result	&&	NTV2_IS_INPUT_CROSSPOINT(crosspoint))
@@ -0,0 +1,415 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2capturefile.cpp
+	@brief		Implementation of the CNTV2CaptureFileWriter and CNTV2CaptureFileReader classes.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+#include "ntv2capturefile.h"
+#include "ntv2utils.h"
+#include "ajabase/system/debug.h"
+#include <algorithm>
+#include <string.h>
+#if defined(AJA_WINDOWS)
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+#define	INSTP(_p_)			xHEX0N(uint64_t(_p_),16)
+#define	CFWFAIL(__x__)		AJA_sERROR	(AJA_DebugUnit_App_DiskWrite, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	CFWINFO(__x__)		AJA_sINFO	(AJA_DebugUnit_App_DiskWrite, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	CFRFAIL(__x__)		AJA_sERROR	(AJA_DebugUnit_App_DiskRead, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	CFRWARN(__x__)		AJA_sWARNING(AJA_DebugUnit_App_DiskRead, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+
+#define	NTV2_CAPTUREFILE_SYNC_COOKIE	0xFFFFFFFFFFFFFFFFULL	//	Cookie for header & index writes (no record buffer)
+
+static inline ULWord64 AlignUp (const ULWord64 inBytes)
+{
+	return (inBytes + NTV2_CAPTUREFILE_ALIGNMENT - 1) / NTV2_CAPTUREFILE_ALIGNMENT * NTV2_CAPTUREFILE_ALIGNMENT;
+}
+
+static inline bool IsAtOrBefore (const NTV2CaptureFileIndexEntry & inLHS, const LWord64 inRHS)
+{
+	return inLHS.fFrameTime <= inRHS;
+}
+
+
+//////////////////////////////////////////	NTV2CaptureFrame
+
+void NTV2CaptureFrame::Set (const AUTOCIRCULATE_TRANSFER & inXfer)
+{
+	fVideo.Set (inXfer.GetVideoBuffer().GetHostPointer(), inXfer.GetVideoBuffer().GetByteCount());
+	fAudio.Set (inXfer.GetAudioBuffer().GetHostPointer(), inXfer.GetCapturedAudioByteCount());
+	fAncF1.Set (inXfer.GetAncBuffer(false).GetHostPointer(), inXfer.GetCapturedAncByteCount(false));
+	fAncF2.Set (inXfer.GetAncBuffer(true).GetHostPointer(), inXfer.GetCapturedAncByteCount(true));
+	fFrameStamp = inXfer.GetFrameInfo();
+	fTimeCodes.clear();
+	NTV2TimeCodeList tcs;
+	if (fFrameStamp.GetInputTimeCodes(tcs))
+		for (size_t ndx(0);  ndx < tcs.size();  ndx++)
+			if (tcs.at(ndx).IsValid())
+				fTimeCodes[NTV2TCIndex(ndx)] = tcs.at(ndx);
+}
+
+
+//////////////////////////////////////////	CNTV2CaptureFileWriter
+
+CNTV2CaptureFileWriter::CNTV2CaptureFileWriter ()
+	:	mNextOffset	(0),
+		mFailed		(false)
+{
+	::memset(&mHeader, 0, sizeof(mHeader));
+}
+
+CNTV2CaptureFileWriter::~CNTV2CaptureFileWriter ()
+{
+	Close();
+}
+
+bool CNTV2CaptureFileWriter::Open (const string & inPath, const NTV2CaptureFileHeader & inHeader, const ULWord inQueueDepth)
+{
+	if (IsOpen())
+		{CFWFAIL("Already open");  return false;}
+	if (!inQueueDepth)
+		{CFWFAIL("Zero queue depth");  return false;}
+	if (AJA_FAILURE(mFile.Open(inPath, eAJAWriteOnly | eAJACreateAlways | eAJATruncateExisting, eAJAUnbuffered)))
+		{CFWFAIL("Can't create '" << inPath << "'");  return false;}
+	if (AJA_FAILURE(mFile.SetAsyncQueueDepth(inQueueDepth + 1)))	//	+1 for header & index writes
+		{CFWFAIL("Can't set queue depth " << DEC(inQueueDepth));  mFile.Close();  return false;}
+
+	mHeader = inHeader;
+	::memcpy(mHeader.fMagic, NTV2_CAPTUREFILE_MAGIC, sizeof(mHeader.fMagic));
+	mHeader.fVersion = NTV2_CAPTUREFILE_VERSION;
+	mHeader.fAlignment = NTV2_CAPTUREFILE_ALIGNMENT;
+	mHeader.fReserved = 0;
+	mHeader.fFrameCount = mHeader.fIndexOffset = 0;
+	mHeader.fDescription[sizeof(mHeader.fDescription) - 1] = 0;
+	mIndex.clear();
+	mFailed = false;
+	mBuffers.resize(inQueueDepth);
+	mFree.clear();
+	for (ULWord ndx(0);  ndx < inQueueDepth;  ndx++)
+	{
+		mBuffers[ndx] = new NTV2Buffer;
+		mFree.push_back(inQueueDepth - 1 - ndx);
+	}
+
+	//	Write the header now (incomplete), so the file is readable even if it's never closed
+	NTV2Buffer headerPage;
+	if (!headerPage.Allocate(NTV2_CAPTUREFILE_ALIGNMENT, true))
+		{CFWFAIL("Can't allocate header");  Close();  return false;}
+	::memcpy(headerPage.GetHostPointer(), &mHeader, sizeof(mHeader));
+	if (AJA_FAILURE(mFile.WriteAsync(headerPage, headerPage.GetByteCount(), 0, NTV2_CAPTUREFILE_SYNC_COOKIE))  ||  !Reap(1))
+		{CFWFAIL("Can't write header to '" << inPath << "'");  Close();  return false;}
+	mNextOffset = NTV2_CAPTUREFILE_ALIGNMENT;
+	CFWINFO("Opened '" << inPath << "' using '" << mFile.GetAsyncEngine() << "' engine, queue depth " << DEC(inQueueDepth)
+			<< (mFile.IsDirectIO() ? ", direct I/O" : ", buffered I/O"));
+	return true;
+}
+
+bool CNTV2CaptureFileWriter::WriteFrame (const NTV2CaptureFrame & inFrame)
+{
+	if (!IsOpen())
+		return false;
+	if (mFailed)
+		return false;
+	if (mFree.empty())
+		if (!Reap(1))	//	Every buffer is still being written -- wait for one
+			return false;
+	if (mFree.empty())
+		return false;
+
+	//	Lay out the record
+	NTV2CaptureFileRecord rec;
+	rec = NTV2CaptureFileRecord();
+	::memcpy(rec.fMagic, NTV2_CAPTUREFILE_RECORD_MAGIC, sizeof(rec.fMagic));
+	rec.fVideoOffset = ULWord(AlignUp(sizeof(rec)));				rec.fVideoBytes = inFrame.fVideo.GetByteCount();
+	rec.fAudioOffset = ULWord(rec.fVideoOffset + AlignUp(rec.fVideoBytes));	rec.fAudioBytes = inFrame.fAudio.GetByteCount();
+	rec.fAncF1Offset = ULWord(rec.fAudioOffset + AlignUp(rec.fAudioBytes));	rec.fAncF1Bytes = inFrame.fAncF1.GetByteCount();
+	rec.fAncF2Offset = ULWord(rec.fAncF1Offset + AlignUp(rec.fAncF1Bytes));	rec.fAncF2Bytes = inFrame.fAncF2.GetByteCount();
+	rec.fRecordBytes = ULWord(rec.fAncF2Offset + AlignUp(rec.fAncF2Bytes));
+	rec.fFrameNumber = ULWord64(mIndex.size());
+	const FRAME_STAMP & stamp (inFrame.fFrameStamp);
+	rec.fFrameTime				= stamp.acFrameTime;
+	rec.fCurrentTime			= stamp.acCurrentTime;
+	rec.fAudioClockTimeStamp	= stamp.acAudioClockTimeStamp;
+	rec.fUserCookie				= stamp.acCurrentUserCookie;
+	rec.fAudioInStartAddress	= stamp.acAudioInStartAddress;
+	rec.fAudioInStopAddress		= stamp.acAudioInStopAddress;
+	rec.fStartSample			= stamp.acStartSample;
+	rec.fCurrentReps			= stamp.acCurrentReps;
+	rec.fFrame					= stamp.acFrame;
+	for (NTV2TimeCodesConstIter it(inFrame.fTimeCodes.begin());  it != inFrame.fTimeCodes.end();  ++it)
+		if (ULWord(it->first) < NTV2_CAPTUREFILE_MAX_TIMECODES)
+		{
+			rec.fTimeCodeMask |= 1UL << ULWord(it->first);
+			rec.fTimeCodes[it->first] = it->second;
+		}
+
+	//	Fill a record buffer
+	const ULWord bufferNdx (mFree.back());
+	NTV2Buffer & buffer (*mBuffers.at(bufferNdx));
+	if (buffer.GetByteCount() < rec.fRecordBytes)
+		if (!buffer.Allocate(rec.fRecordBytes, true))
+			{CFWFAIL("Can't allocate " << DEC(rec.fRecordBytes) << "-byte record buffer");  return false;}
+	mFree.pop_back();
+	UByte * pRecord (buffer);
+	::memset(pRecord, 0, rec.fVideoOffset);
+	::memcpy(pRecord, &rec, sizeof(rec));
+	if (rec.fVideoBytes)	::memcpy(pRecord + rec.fVideoOffset, inFrame.fVideo.GetHostPointer(), rec.fVideoBytes);
+	if (rec.fAudioBytes)	::memcpy(pRecord + rec.fAudioOffset, inFrame.fAudio.GetHostPointer(), rec.fAudioBytes);
+	if (rec.fAncF1Bytes)	::memcpy(pRecord + rec.fAncF1Offset, inFrame.fAncF1.GetHostPointer(), rec.fAncF1Bytes);
+	if (rec.fAncF2Bytes)	::memcpy(pRecord + rec.fAncF2Offset, inFrame.fAncF2.GetHostPointer(), rec.fAncF2Bytes);
+
+	//	Queue it
+	AJAStatus status (mFile.WriteAsync(pRecord, rec.fRecordBytes, int64_t(mNextOffset), bufferNdx));
+	if (status == AJA_STATUS_BUSY  &&  Reap(1))
+		status = mFile.WriteAsync(pRecord, rec.fRecordBytes, int64_t(mNextOffset), bufferNdx);
+	if (AJA_FAILURE(status))
+	{
+		CFWFAIL("WriteAsync failed for frame " << DEC(rec.fFrameNumber) << ": " << ::AJAStatusToString(status));
+		mFree.push_back(bufferNdx);
+		return false;
+	}
+	NTV2CaptureFileIndexEntry entry;
+	entry.fOffset = mNextOffset;
+	entry.fFrameTime = rec.fFrameTime;
+	mIndex.push_back(entry);
+	mNextOffset += rec.fRecordBytes;
+	return true;
+}
+
+bool CNTV2CaptureFileWriter::Reap (const ULWord inMinCompletions)
+{
+	vector<AJAFileIOCompletion> done;
+	const AJAStatus status (mFile.WaitAsync(done, inMinCompletions));
+	for (size_t ndx(0);  ndx < done.size();  ndx++)
+	{
+		const AJAFileIOCompletion & completion (done.at(ndx));
+		if (AJA_FAILURE(completion.status)  ||  completion.transferred != completion.length)
+		{
+			if (!mFailed)
+				CFWFAIL("Write failed at offset " << xHEX0N(completion.offset,16) << ": " << DEC(completion.transferred)
+						<< " of " << DEC(completion.length) << " bytes written");
+			mFailed = true;
+		}
+		if (completion.cookie < ULWord64(mBuffers.size()))
+			mFree.push_back(ULWord(completion.cookie));
+	}
+	return AJA_SUCCESS(status)  &&  !mFailed;
+}
+
+bool CNTV2CaptureFileWriter::Close (void)
+{
+	if (!IsOpen())
+		return false;
+
+	//	Finish writing the frames
+	while (mFile.GetAsyncPending())
+		Reap(mFile.GetAsyncPending());
+
+	if (!mFailed  &&  mNextOffset)
+	{
+		//	Append the index...
+		const ULWord64 indexBytes (mIndex.size() * sizeof(NTV2CaptureFileIndexEntry));
+		NTV2Buffer page;
+		if (indexBytes  &&  page.Allocate(size_t(AlignUp(indexBytes)), true))
+		{
+			::memcpy(page.GetHostPointer(), &mIndex[0], size_t(indexBytes));
+			if (AJA_SUCCESS(mFile.WriteAsync(page, page.GetByteCount(), int64_t(mNextOffset), NTV2_CAPTUREFILE_SYNC_COOKIE)))
+				Reap(1);
+			else
+				mFailed = true;
+		}
+
+		//	...then complete the header
+		if (!mFailed  &&  page.Allocate(NTV2_CAPTUREFILE_ALIGNMENT, true))
+		{
+			mHeader.fFrameCount = ULWord64(mIndex.size());
+			mHeader.fIndexOffset = indexBytes ? mNextOffset : 0;
+			::memcpy(page.GetHostPointer(), &mHeader, sizeof(mHeader));
+			if (AJA_SUCCESS(mFile.WriteAsync(page, page.GetByteCount(), 0, NTV2_CAPTUREFILE_SYNC_COOKIE)))
+				Reap(1);
+			else
+				mFailed = true;
+		}
+		if (mFailed)
+			CFWFAIL("Failed to write index and header");
+		else
+			CFWINFO(DEC(mIndex.size()) << " frame(s), " << DEC(mNextOffset + AlignUp(indexBytes)) << " bytes");
+	}
+
+	mFile.Close();
+	for (size_t ndx(0);  ndx < mBuffers.size();  ndx++)
+		delete mBuffers[ndx];
+	mBuffers.clear();
+	mFree.clear();
+	mNextOffset = 0;
+	return !mFailed;
+}
+
+
+//////////////////////////////////////////	NTV2CaptureFileFrame
+
+bool NTV2CaptureFileFrame::GetTimeCode (NTV2_RP188 & outTimeCode, const NTV2TCIndex inTCIndex) const
+{
+	if (!fRecord  ||  ULWord(inTCIndex) >= NTV2_CAPTUREFILE_MAX_TIMECODES)
+		return false;
+	if (!(fRecord->fTimeCodeMask & (1UL << ULWord(inTCIndex))))
+		return false;
+	outTimeCode = fRecord->fTimeCodes[inTCIndex];
+	return true;
+}
+
+
+//////////////////////////////////////////	CNTV2CaptureFileReader
+
+CNTV2CaptureFileReader::CNTV2CaptureFileReader ()
+	:	mpBase			(AJA_NULL),
+		mMappedBytes	(0),
+		mRecovered		(false)
+{
+}
+
+CNTV2CaptureFileReader::~CNTV2CaptureFileReader ()
+{
+	Close();
+}
+
+bool CNTV2CaptureFileReader::Open (const string & inPath)
+{
+	Close();
+
+	//	Map the whole file read-only
+#if defined(AJA_WINDOWS)
+	HANDLE hFile (::CreateFileA(inPath.c_str(), GENERIC_READ, FILE_SHARE_READ, AJA_NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, AJA_NULL));
+	if (hFile == INVALID_HANDLE_VALUE)
+		{CFRFAIL("Can't open '" << inPath << "'");  return false;}
+	LARGE_INTEGER fileSize;
+	if (::GetFileSizeEx(hFile, &fileSize)  &&  fileSize.QuadPart >= NTV2_CAPTUREFILE_ALIGNMENT)
+	{
+		HANDLE hMapping (::CreateFileMappingA(hFile, AJA_NULL, PAGE_READONLY, 0, 0, AJA_NULL));
+		if (hMapping)
+		{
+			mpBase = reinterpret_cast<const UByte*>(::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+			::CloseHandle(hMapping);	//	The view keeps the mapping alive
+		}
+		mMappedBytes = ULWord64(fileSize.QuadPart);
+	}
+	::CloseHandle(hFile);
+#else
+	const int fd (::open(inPath.c_str(), O_RDONLY));
+	if (fd < 0)
+		{CFRFAIL("Can't open '" << inPath << "'");  return false;}
+	struct stat info;
+	if (::fstat(fd, &info) == 0  &&  info.st_size >= NTV2_CAPTUREFILE_ALIGNMENT)
+	{
+		void * pMap (::mmap(AJA_NULL, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0));
+		if (pMap != MAP_FAILED)
+			mpBase = reinterpret_cast<const UByte*>(pMap);
+		mMappedBytes = ULWord64(info.st_size);
+	}
+	::close(fd);	//	The mapping keeps the file open
+#endif
+	if (!mpBase)
+		{CFRFAIL("Can't map '" << inPath << "', " << DEC(mMappedBytes) << " bytes");  mMappedBytes = 0;  return false;}
+
+	const NTV2CaptureFileHeader & hdr (GetHeader());
+	if (::memcmp(hdr.fMagic, NTV2_CAPTUREFILE_MAGIC, sizeof(hdr.fMagic))  ||  hdr.fVersion > NTV2_CAPTUREFILE_VERSION
+		||  hdr.fAlignment != NTV2_CAPTUREFILE_ALIGNMENT)
+			{CFRFAIL("'" << inPath << "' isn't an NTV2 capture file, or is an unsupported version");  Close();  return false;}
+
+	//	Load the index...
+	const ULWord64 indexBytes (hdr.fFrameCount * sizeof(NTV2CaptureFileIndexEntry));
+	if (hdr.fIndexOffset  &&  hdr.fFrameCount  &&  hdr.fIndexOffset + indexBytes <= mMappedBytes
+		&&  indexBytes / sizeof(NTV2CaptureFileIndexEntry) == hdr.fFrameCount)
+	{
+		const NTV2CaptureFileIndexEntry * pIndex (reinterpret_cast<const NTV2CaptureFileIndexEntry*>(mpBase + hdr.fIndexOffset));
+		mIndex.assign(pIndex, pIndex + hdr.fFrameCount);
+		return true;
+	}
+
+	//	...or rebuild it by walking the records
+	mRecovered = true;
+	for (ULWord64 offset(NTV2_CAPTUREFILE_ALIGNMENT);  IsValidRecord(offset);  )
+	{
+		const NTV2CaptureFileRecord * pRec (reinterpret_cast<const NTV2CaptureFileRecord*>(mpBase + offset));
+		NTV2CaptureFileIndexEntry entry;
+		entry.fOffset = offset;
+		entry.fFrameTime = pRec->fFrameTime;
+		mIndex.push_back(entry);
+		offset += pRec->fRecordBytes;
+	}
+	CFRWARN("'" << inPath << "' wasn't closed cleanly -- recovered " << DEC(mIndex.size()) << " frame(s)");
+	return true;
+}
+
+void CNTV2CaptureFileReader::Close (void)
+{
+	if (mpBase)
+	{
+#if defined(AJA_WINDOWS)
+		::UnmapViewOfFile(mpBase);
+#else
+		::munmap(const_cast<UByte*>(mpBase), size_t(mMappedBytes));
+#endif
+	}
+	mpBase = AJA_NULL;
+	mMappedBytes = 0;
+	mIndex.clear();
+	mRecovered = false;
+}
+
+const NTV2CaptureFileHeader & CNTV2CaptureFileReader::GetHeader (void) const
+{
+	static const NTV2CaptureFileHeader sEmpty = NTV2CaptureFileHeader();
+	return mpBase ? *reinterpret_cast<const NTV2CaptureFileHeader*>(mpBase) : sEmpty;
+}
+
+bool CNTV2CaptureFileReader::IsValidRecord (const ULWord64 inOffset) const
+{
+	if (!mpBase  ||  inOffset % NTV2_CAPTUREFILE_ALIGNMENT  ||  inOffset + sizeof(NTV2CaptureFileRecord) > mMappedBytes)
+		return false;
+	const NTV2CaptureFileRecord & rec (*reinterpret_cast<const NTV2CaptureFileRecord*>(mpBase + inOffset));
+	if (::memcmp(rec.fMagic, NTV2_CAPTUREFILE_RECORD_MAGIC, sizeof(rec.fMagic)))
+		return false;
+	if (rec.fRecordBytes < sizeof(rec)  ||  rec.fRecordBytes % NTV2_CAPTUREFILE_ALIGNMENT  ||  inOffset + rec.fRecordBytes > mMappedBytes)
+		return false;
+	return ULWord64(rec.fVideoOffset) + rec.fVideoBytes <= rec.fRecordBytes
+		&&  ULWord64(rec.fAudioOffset) + rec.fAudioBytes <= rec.fRecordBytes
+		&&  ULWord64(rec.fAncF1Offset) + rec.fAncF1Bytes <= rec.fRecordBytes
+		&&  ULWord64(rec.fAncF2Offset) + rec.fAncF2Bytes <= rec.fRecordBytes;
+}
+
+bool CNTV2CaptureFileReader::GetFrame (const ULWord64 inFrameNumber, NTV2CaptureFileFrame & outFrame) const
+{
+	outFrame.fRecord = AJA_NULL;
+	if (inFrameNumber >= GetFrameCount())
+		return false;
+	const ULWord64 offset (mIndex[size_t(inFrameNumber)].fOffset);
+	if (!IsValidRecord(offset))
+		{CFRFAIL("Frame " << DEC(inFrameNumber) << " at offset " << xHEX0N(offset,16) << " is corrupt");  return false;}
+	const UByte * pRecord (mpBase + offset);
+	const NTV2CaptureFileRecord * pRec (reinterpret_cast<const NTV2CaptureFileRecord*>(pRecord));
+	outFrame.fRecord = pRec;
+	outFrame.fVideo.Set(pRec->fVideoBytes ? pRecord + pRec->fVideoOffset : AJA_NULL, pRec->fVideoBytes);
+	outFrame.fAudio.Set(pRec->fAudioBytes ? pRecord + pRec->fAudioOffset : AJA_NULL, pRec->fAudioBytes);
+	outFrame.fAncF1.Set(pRec->fAncF1Bytes ? pRecord + pRec->fAncF1Offset : AJA_NULL, pRec->fAncF1Bytes);
+	outFrame.fAncF2.Set(pRec->fAncF2Bytes ? pRecord + pRec->fAncF2Offset : AJA_NULL, pRec->fAncF2Bytes);
+	return true;
+}
+
+bool CNTV2CaptureFileReader::FindFrame (const LWord64 inFrameTime, ULWord64 & outFrameNumber) const
+{
+	//	Frame times increase through the file, so binary-search the index
+	vector<NTV2CaptureFileIndexEntry>::const_iterator it (std::lower_bound(mIndex.begin(), mIndex.end(), inFrameTime, IsAtOrBefore));
+	if (it == mIndex.begin())
+		return false;
+	outFrameNumber = ULWord64(it - mIndex.begin()) - 1;
+	return true;
+}
@@ -12,6 +12,9 @@
 #include "ntv2utils.h"
 #include <sstream>
 #include "ajabase/common/common.h"
+#if defined(AJALinux)
+	#include <fstream>
+#endif
 //#include "ajabase/system/info.h"	//	for AJASystemInfo
 
 using namespace std;
@@ -252,6 +255,24 @@ bool CNTV2Card::GetSerialNumberString (string & outStr)
 }	//	GetSerialNumberString
 
 
+bool CNTV2Card::GetNUMANode (int & outNode)
+{
+	outNode = -1;
+	if (!IsOpen()  ||  IsRemote())
+		return false;
+#if defined(AJALinux)
+	//	The driver parents each device node to its PCI device, whose NUMA node sysfs exposes...
+	ostringstream path;  path << "/sys/class/ajantv2/ajantv2" << DEC(GetIndexNumber()) << "/device/numa_node";
+	ifstream ifs(path.str().c_str());
+	if (!(ifs >> outNode))
+		{outNode = -1;  return false;}	//	Older driver without a parent device
+	return outNode >= 0;	//	-1 means the host isn't NUMA
+#else
+	return false;
+#endif
+}	//	GetNUMANode
+
+
 bool CNTV2Card::IS_CHANNEL_INVALID (const NTV2Channel inChannel) const
 {
 	if (!NTV2_IS_VALID_CHANNEL (inChannel))
@@ -10,6 +10,7 @@
 #include "ntv2utils.h"
 #include "ajabase/common/common.h"
 #include "ajabase/system/lock.h"
+#include "ajabase/pnp/pnp.h"
 #include <sstream>
 
 using namespace std;
@@ -20,6 +21,7 @@ using namespace std;
 	typedef struct NTV2DeviceInfo
 	{
 		NTV2DeviceID	deviceID;
+		ULWord			deviceIndex;
 		string			serialNumber;
 		string			deviceIdentifier;
 	#if defined(VIRTUAL_DEVICES_SUPPORT)
@@ -95,131 +97,192 @@ bool CNTV2DeviceScanner::IsLegalSerialNumber (const string & inStr)
 
 static NTV2DeviceInfoList	sDevInfoList;
 static AJALock				sDevInfoListLock;
+static bool					sDevInfoListStale	(true);		//	Devices may have come or gone since the last scan
+static NTV2DeviceSource *	spDevSource			(AJA_NULL);	//	Client-installed device source, if any
+static AJAPnp *				spDevHotplug		(AJA_NULL);	//	Hot-plug monitor, if enabled
 
-size_t CNTV2DeviceScanner::GetNumDevices (void)
+
+//	The default device source:  the local host's devices, by index number
+class NTV2LocalDeviceSource : public NTV2DeviceSource
 {
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	return sDevInfoList.size();
+	public:
+		virtual bool	IdentifyDevice (const ULWord inIndex, NTV2DeviceID & outDeviceID, string & outSerialNumber)
+		{
+			CNTV2Card dev;
+			if (!dev.Open(UWord(inIndex)))
+				return false;
+			outDeviceID = dev.GetDeviceID();
+			if (!dev.GetSerialNumberString(outSerialNumber))
+				outSerialNumber.clear();
+			return true;
+		}
+		virtual bool	OpenDevice (const ULWord inIndex, CNTV2Card & outDevice)	{return outDevice.Open(UWord(inIndex));}
+};
+static NTV2LocalDeviceSource	sLocalDevSource;
+
+static inline NTV2DeviceSource & DeviceSource (void)
+{
+	return spDevSource ? *spDevSource : sLocalDevSource;
 }
 
-#if defined(NTV2_DEPRECATE_17_1)
-	void ScanHardware (void)
-	{
-		AJAAutoLock tmpLock(&sDevInfoListLock);
-		sDevInfoList.clear();
-		UWord ndx(0);
-		do
-		{
-			CNTV2Card tmpDev(ndx);
-			if (!tmpDev.IsOpen())
-				break;
-			NTV2DeviceInfo info;
-			info.deviceID = tmpDev.GetDeviceID();
-			tmpDev.GetSerialNumberString(info.serialNumber);
-			info.deviceIdentifier = tmpDev.GetDisplayName();
-			sDevInfoList.push_back(info);
-			ndx++;
-		} while (ndx < 16);
-	}
-#else	//	!defined(NTV2_DEPRECATE_17_1)
-CNTV2DeviceScanner::CNTV2DeviceScanner (const bool inScanNow)
+static void DeviceHotplugCallback (AJAPnpMessage inMessage, void * pInRefCon)
 {
-	if (inScanNow)
-		ScanHardware();
+	(void) pInRefCon;
+	if (inMessage == AJA_Pnp_DeviceAdded  ||  inMessage == AJA_Pnp_DeviceRemoved
+		||  inMessage == AJA_Pnp_DeviceOnline  ||  inMessage == AJA_Pnp_DeviceOffline)
+			CNTV2DeviceScanner::DevicesChanged();
 }
 
-	#if !defined(NTV2_DEPRECATE_16_3)
-		CNTV2DeviceScanner::CNTV2DeviceScanner (bool inScanNow, UWord inDeviceMask)
-		{
-			(void)inDeviceMask;
-			if (inScanNow)
-				ScanHardware();
-		}
-	#endif	//	!defined(NTV2_DEPRECATE_16_3)
+static string DeviceIdentifier (const string & inName, const ULWord inIndex)
+{
+	ostringstream oss;
+	oss << inName << " - " << inIndex;
+	return oss.str();
+}
 
-NTV2DeviceInfoList	GetDeviceInfoList (void)
+//	Opens the device at the given inventory position. Caller must hold sDevInfoListLock.
+static bool OpenInventoryDevice (const size_t inPosition, CNTV2Card & outDevice)
 {
-	AJAAutoLock tmpLock(&sDevInfoListLock);
-	return sDevInfoList;
+	if (inPosition >= sDevInfoList.size())
+		return false;
+	if (DeviceSource().OpenDevice(sDevInfoList.at(inPosition).deviceIndex, outDevice))
+		return true;
+	sDevInfoListStale = true;	//	Must have been detached
+	return false;
 }
 
+#if !defined(NTV2_DEPRECATE_17_1)
+	static void ProbeDeviceCapabilities (CNTV2Card & tmpDev, NTV2DeviceInfo & info)
+	{
+		const ULWordSet wgtIDs (tmpDev.GetSupportedItems(kNTV2EnumsID_WidgetID));
+		info.numVidInputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoInputs);
+		info.numVidOutputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoOutputs);
+		info.numAnlgVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoOutputs);
+		info.numAnlgVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoInputs);
+		info.numHDMIVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoOutputs);
+		info.numHDMIVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoInputs);
+		info.numInputConverters		= tmpDev.GetNumSupported(kDeviceGetNumInputConverters);
+		info.numOutputConverters	= tmpDev.GetNumSupported(kDeviceGetNumOutputConverters);
+		info.numUpConverters		= tmpDev.GetNumSupported(kDeviceGetNumUpConverters);
+		info.numDownConverters		= tmpDev.GetNumSupported(kDeviceGetNumDownConverters);
+		info.downConverterDelay		= tmpDev.GetNumSupported(kDeviceGetDownConverterDelay);
+		info.dvcproHDSupport		= tmpDev.IsSupported(kDeviceCanDoDVCProHD);
+		info.qrezSupport			= tmpDev.IsSupported(kDeviceCanDoQREZ);
+		info.hdvSupport				= tmpDev.IsSupported(kDeviceCanDoHDV);
+		info.quarterExpandSupport	= tmpDev.IsSupported(kDeviceCanDoQuarterExpand);
+		info.colorCorrectionSupport	= tmpDev.IsSupported(kDeviceCanDoColorCorrection);
+		info.programmableCSCSupport	= tmpDev.IsSupported(kDeviceCanDoProgrammableCSC);
+		info.rgbAlphaOutputSupport	= tmpDev.IsSupported(kDeviceCanDoRGBPlusAlphaOut);
+		info.breakoutBoxSupport		= tmpDev.IsSupported(kDeviceCanDoBreakoutBox);
+		info.vidProcSupport			= tmpDev.IsSupported(kDeviceCanDoVideoProcessing);
+		info.dualLinkSupport		= tmpDev.IsSupported(kDeviceCanDoDualLink);
+		info.numDMAEngines			= UWord(tmpDev.GetNumSupported(kDeviceGetNumDMAEngines));
+		info.pingLED				= tmpDev.GetNumSupported(kDeviceGetPingLED);
+		info.has2KSupport			= tmpDev.IsSupported(kDeviceCanDo2KVideo);
+		info.has4KSupport			= tmpDev.IsSupported(kDeviceCanDo4KVideo);
+		info.has8KSupport			= tmpDev.IsSupported(kDeviceCanDo8KVideo);
+		info.has3GLevelConversion   = tmpDev.IsSupported(kDeviceCanDo3GLevelConversion);
+		info.isoConvertSupport		= tmpDev.IsSupported(kDeviceCanDoIsoConvert);
+		info.rateConvertSupport		= tmpDev.IsSupported(kDeviceCanDoRateConvert);
+		info.proResSupport			= tmpDev.IsSupported(kDeviceCanDoProRes);
+		info.sdi3GSupport			= wgtIDs.find(NTV2_Wgt3GSDIOut1) != wgtIDs.end();
+		info.sdi12GSupport			= tmpDev.IsSupported(kDeviceCanDo12GSDI);
+		info.ipSupport				= tmpDev.IsSupported(kDeviceCanDoIP);
+		info.biDirectionalSDI		= tmpDev.IsSupported(kDeviceHasBiDirectionalSDI);
+		info.ltcInSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCInputs) > 0;
+		info.ltcOutSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCOutputs) > 0;
+		info.ltcInOnRefPort			= tmpDev.IsSupported(kDeviceCanDoLTCInOnRefPort);
+		info.stereoOutSupport		= tmpDev.IsSupported(kDeviceCanDoStereoOut);
+		info.stereoInSupport		= tmpDev.IsSupported(kDeviceCanDoStereoIn);
+		info.multiFormat			= tmpDev.IsSupported(kDeviceCanDoMultiFormat);
+		info.numSerialPorts			= tmpDev.GetNumSupported(kDeviceGetNumSerialPorts);
+		info.procAmpSupport			= false;
+	}
+#endif	//	!defined(NTV2_DEPRECATE_17_1)
 
-void CNTV2DeviceScanner::ScanHardware (void)
+
+bool CNTV2DeviceScanner::UpdateDeviceInventory (const bool inForce, const bool inReprobe)
 {
 	AJAAutoLock tmpLock(&sDevInfoListLock);
-	sDevInfoList.clear();
+	const bool monitored (spDevHotplug  ||  (spDevSource && spDevSource->IsMonitored()));
+	if (!inForce  &&  monitored  &&  !sDevInfoListStale)
+		return false;	//	Nothing came or went
+	sDevInfoListStale = false;
+
+	NTV2DeviceSource &	source (DeviceSource());
+	NTV2DeviceInfoList	oldList;
+	if (!inReprobe)
+		for (NTV2DeviceInfoListConstIter it(sDevInfoList.begin());  it != sDevInfoList.end();  ++it)
+		{
+#if defined(VIRTUAL_DEVICES_SUPPORT)
+			if (it->isVirtualDevice)
+				continue;	//	Virtual devices are re-added from their hardware device below
+#endif	//	defined(VIRTUAL_DEVICES_SUPPORT)
+			oldList.push_back(*it);
+		}
+	vector<bool>		reused (oldList.size(), false);
+	NTV2DeviceInfoList	newList;
+	bool				changed (inReprobe);
 
-	for (UWord boardNum(0);   ;   boardNum++)
+	for (ULWord boardNum(0);   ;   boardNum++)
 	{
-		CNTV2Card tmpDev(boardNum);
-		if (!tmpDev.IsOpen())
+		NTV2DeviceID	deviceID (DEVICE_ID_NOTFOUND);
+		string			serialNum;
+		if (!source.IdentifyDevice(boardNum, deviceID, serialNum))
 			break;
-		const NTV2DeviceID	deviceID (tmpDev.GetDeviceID());
+		if (deviceID == DEVICE_ID_NOTFOUND)
+			continue;
+
+		//	Reuse what was probed earlier if the device was already here, even if it's been re-numbered...
+		size_t oldNdx(0);
+		while (oldNdx < oldList.size()  &&  (reused.at(oldNdx)  ||  oldList.at(oldNdx).deviceID != deviceID
+												||  oldList.at(oldNdx).serialNumber != serialNum))
+			oldNdx++;
+		if (oldNdx < oldList.size())
+		{
+			reused.at(oldNdx) = true;
+			newList.push_back(oldList.at(oldNdx));
+			NTV2DeviceInfo & info (newList.back());
+			if (info.deviceIndex != boardNum)
+			{
+				const size_t pos (info.deviceIdentifier.rfind(" - "));
+				info.deviceIdentifier = DeviceIdentifier(info.deviceIdentifier.substr(0, pos), boardNum);
+				info.deviceIndex = boardNum;
+				changed = true;
+			}
+			continue;
+		}
 
-		if (deviceID != DEVICE_ID_NOTFOUND)
+		//	New device -- probe it...
+		newList.push_back(NTV2DeviceInfo());
+		NTV2DeviceInfo & info (newList.back());
+		info.deviceIndex	= boardNum;
+		info.deviceID		= deviceID;
+		info.serialNumber	= serialNum;
+		CNTV2Card tmpDev;
+		const bool isOpen (source.OpenDevice(boardNum, tmpDev));
+#if defined(NTV2_DEPRECATE_17_1)
+		info.deviceIdentifier = isOpen ? tmpDev.GetDisplayName() : DeviceIdentifier(::NTV2DeviceIDToString(deviceID), boardNum);
+#else	//	!defined(NTV2_DEPRECATE_17_1)
+		info.deviceIdentifier = DeviceIdentifier(::NTV2DeviceIDToString(deviceID, isOpen && tmpDev.IsSupported(kDeviceHasMicrophoneInput)), boardNum);
+		if (isOpen)
 		{
-			ostringstream	oss;
-			NTV2DeviceInfo	info;
-			info.deviceIndex		= boardNum;
-			info.deviceID			= deviceID;
-			tmpDev.GetSerialNumberString(info.serialNumber);
-
-			oss << ::NTV2DeviceIDToString (deviceID, tmpDev.IsSupported(kDeviceHasMicrophoneInput)) << " - " << boardNum;
-
-			const ULWordSet wgtIDs (tmpDev.GetSupportedItems(kNTV2EnumsID_WidgetID));
-			info.deviceIdentifier		= oss.str();
-			info.numVidInputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoInputs);
-			info.numVidOutputs			= tmpDev.GetNumSupported(kDeviceGetNumVideoOutputs);
-			info.numAnlgVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoOutputs);
-			info.numAnlgVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumAnalogVideoInputs);
-			info.numHDMIVidOutputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoOutputs);
-			info.numHDMIVidInputs		= tmpDev.GetNumSupported(kDeviceGetNumHDMIVideoInputs);
-			info.numInputConverters		= tmpDev.GetNumSupported(kDeviceGetNumInputConverters);
-			info.numOutputConverters	= tmpDev.GetNumSupported(kDeviceGetNumOutputConverters);
-			info.numUpConverters		= tmpDev.GetNumSupported(kDeviceGetNumUpConverters);
-			info.numDownConverters		= tmpDev.GetNumSupported(kDeviceGetNumDownConverters);
-			info.downConverterDelay		= tmpDev.GetNumSupported(kDeviceGetDownConverterDelay);
-			info.dvcproHDSupport		= tmpDev.IsSupported(kDeviceCanDoDVCProHD);
-			info.qrezSupport			= tmpDev.IsSupported(kDeviceCanDoQREZ);
-			info.hdvSupport				= tmpDev.IsSupported(kDeviceCanDoHDV);
-			info.quarterExpandSupport	= tmpDev.IsSupported(kDeviceCanDoQuarterExpand);
-			info.colorCorrectionSupport	= tmpDev.IsSupported(kDeviceCanDoColorCorrection);
-			info.programmableCSCSupport	= tmpDev.IsSupported(kDeviceCanDoProgrammableCSC);
-			info.rgbAlphaOutputSupport	= tmpDev.IsSupported(kDeviceCanDoRGBPlusAlphaOut);
-			info.breakoutBoxSupport		= tmpDev.IsSupported(kDeviceCanDoBreakoutBox);
-			info.vidProcSupport			= tmpDev.IsSupported(kDeviceCanDoVideoProcessing);
-			info.dualLinkSupport		= tmpDev.IsSupported(kDeviceCanDoDualLink);
-			info.numDMAEngines			= UWord(tmpDev.GetNumSupported(kDeviceGetNumDMAEngines));
-			info.pingLED				= tmpDev.GetNumSupported(kDeviceGetPingLED);
-			info.has2KSupport			= tmpDev.IsSupported(kDeviceCanDo2KVideo);
-			info.has4KSupport			= tmpDev.IsSupported(kDeviceCanDo4KVideo);
-			info.has8KSupport			= tmpDev.IsSupported(kDeviceCanDo8KVideo);
-			info.has3GLevelConversion   = tmpDev.IsSupported(kDeviceCanDo3GLevelConversion);
-			info.isoConvertSupport		= tmpDev.IsSupported(kDeviceCanDoIsoConvert);
-			info.rateConvertSupport		= tmpDev.IsSupported(kDeviceCanDoRateConvert);
-			info.proResSupport			= tmpDev.IsSupported(kDeviceCanDoProRes);
-			info.sdi3GSupport			= wgtIDs.find(NTV2_Wgt3GSDIOut1) != wgtIDs.end();
-			info.sdi12GSupport			= tmpDev.IsSupported(kDeviceCanDo12GSDI);
-			info.ipSupport				= tmpDev.IsSupported(kDeviceCanDoIP);
-			info.biDirectionalSDI		= tmpDev.IsSupported(kDeviceHasBiDirectionalSDI);
-			info.ltcInSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCInputs) > 0;
-			info.ltcOutSupport			= tmpDev.GetNumSupported(kDeviceGetNumLTCOutputs) > 0;
-			info.ltcInOnRefPort			= tmpDev.IsSupported(kDeviceCanDoLTCInOnRefPort);
-			info.stereoOutSupport		= tmpDev.IsSupported(kDeviceCanDoStereoOut);
-			info.stereoInSupport		= tmpDev.IsSupported(kDeviceCanDoStereoIn);
-			info.multiFormat			= tmpDev.IsSupported(kDeviceCanDoMultiFormat);
-			info.numSerialPorts			= tmpDev.GetNumSupported(kDeviceGetNumSerialPorts);
-			info.procAmpSupport			= false;
+			ProbeDeviceCapabilities(tmpDev, info);
 			SetAudioAttributes(info, tmpDev);
-			sDevInfoList.push_back(info);
 		}
+#endif	//	!defined(NTV2_DEPRECATE_17_1)
 		tmpDev.Close();
+		changed = true;
 	}	//	boardNum loop
 
+	if (std::find(reused.begin(), reused.end(), false) != reused.end())
+		changed = true;	//	Detached
+	sDevInfoList = newList;
+
 #if defined(VIRTUAL_DEVICES_SUPPORT)
 	NTV2SerialToVirtualDevices vdMap;
 	GetSerialToVirtualDeviceMap(vdMap);
-	NTV2DeviceInfoList hwList = GetDeviceInfoList();
+	NTV2DeviceInfoList hwList = sDevInfoList;
 	int vdIndex = 100;
 	for (auto hwInfo : hwList)
 	{
@@ -234,18 +297,115 @@ void CNTV2DeviceScanner::ScanHardware (void)
 				hwInfo.isVirtualDevice = true;
 				hwInfo.virtualDeviceID = vdev.vdID;
 				hwInfo.virtualDeviceName =  vdev.vdName;
-				GetDeviceInfoList().push_back(hwInfo);
+				sDevInfoList.push_back(hwInfo);
 			}
 		}
 	}
 #endif	//	defined(VIRTUAL_DEVICES_SUPPORT)
+	return changed;
+}	//	UpdateDeviceInventory
+
+
+size_t CNTV2DeviceScanner::GetNumDevices (void)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	UpdateDeviceInventory();
+	return sDevInfoList.size();
+}
+
+
+bool CNTV2DeviceScanner::GetDeviceIdentity (const ULWord inDeviceIndexNumber, NTV2DeviceID & outDeviceID, string & outSerialNumber)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	UpdateDeviceInventory();
+	if (size_t(inDeviceIndexNumber) >= sDevInfoList.size())
+		return false;
+	outDeviceID = sDevInfoList.at(inDeviceIndexNumber).deviceID;
+	outSerialNumber = sDevInfoList.at(inDeviceIndexNumber).serialNumber;
+	return true;
+}
+
+
+bool CNTV2DeviceScanner::Refresh (void)
+{
+	return UpdateDeviceInventory(true);
+}
+
+
+void CNTV2DeviceScanner::DevicesChanged (void)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	sDevInfoListStale = true;
+}
+
+
+bool CNTV2DeviceScanner::EnableHotplug (const bool inEnable)
+{
+	AJAPnp * pHotplug (AJA_NULL);
+	{
+		AJAAutoLock tmpLock(&sDevInfoListLock);
+		if (inEnable == (spDevHotplug != AJA_NULL))
+			return true;	//	Already in that state
+		if (inEnable)
+		{
+			spDevHotplug = new AJAPnp;
+			if (AJA_FAILURE(spDevHotplug->Install(DeviceHotplugCallback, AJA_NULL, AJA_Pnp_PciVideoDevices)))
+				{delete spDevHotplug;  spDevHotplug = AJA_NULL;  return false;}
+			sDevInfoListStale = true;	//	Anything may have happened before monitoring started
+			return true;
+		}
+		pHotplug = spDevHotplug;
+		spDevHotplug = AJA_NULL;
+	}
+	//	Uninstall without the lock, as the monitor thread may be waiting for it in DevicesChanged
+	pHotplug->Uninstall();
+	delete pHotplug;
+	return true;
+}
+
+
+void CNTV2DeviceScanner::SetDeviceSource (NTV2DeviceSource * pInSource)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	spDevSource = pInSource;
+	sDevInfoList.clear();
+	sDevInfoListStale = true;
+}
+
+#if !defined(NTV2_DEPRECATE_17_1)
+CNTV2DeviceScanner::CNTV2DeviceScanner (const bool inScanNow)
+{
+	if (inScanNow)
+		ScanHardware();
+}
+
+	#if !defined(NTV2_DEPRECATE_16_3)
+		CNTV2DeviceScanner::CNTV2DeviceScanner (bool inScanNow, UWord inDeviceMask)
+		{
+			(void)inDeviceMask;
+			if (inScanNow)
+				ScanHardware();
+		}
+	#endif	//	!defined(NTV2_DEPRECATE_16_3)
+
+NTV2DeviceInfoList	CNTV2DeviceScanner::GetDeviceInfoList (void)
+{
+	AJAAutoLock tmpLock(&sDevInfoListLock);
+	UpdateDeviceInventory();
+	return sDevInfoList;
+}
+
+
+void CNTV2DeviceScanner::ScanHardware (void)
+{
+	UpdateDeviceInventory(true, true);	//	Re-probe everything
 }	//	ScanHardware
 
 bool CNTV2DeviceScanner::DeviceIDPresent (const NTV2DeviceID inDeviceID, const bool inRescan)
 {
 	AJAAutoLock tmpLock(&sDevInfoListLock);
 	if (inRescan)
-		ScanHardware();
+		Refresh();
 
 	for (NTV2DeviceInfoListConstIter iter(sDevInfoList.begin());  iter != sDevInfoList.end();  ++iter)
 		if (iter->deviceID == inDeviceID)
@@ -259,7 +419,7 @@ bool CNTV2DeviceScanner::GetDeviceInfo (const ULWord inDeviceIndexNumber, NTV2De
 {
 	AJAAutoLock tmpLock(&sDevInfoListLock);
 	if (inRescan)
-		ScanHardware();
+		Refresh();
 
 	if (inDeviceIndexNumber < sDevInfoList.size())
 	{
@@ -275,10 +435,8 @@ bool CNTV2DeviceScanner::GetDeviceAtIndex (const ULWord inDeviceIndexNumber, CNT
 {
 	outDevice.Close();
 	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
-	return size_t(inDeviceIndexNumber) < sDevInfoList.size()
-				? outDevice.Open(UWord(inDeviceIndexNumber))
-				: false;
+	UpdateDeviceInventory();
+	return OpenInventoryDevice(size_t(inDeviceIndexNumber), outDevice);
 
 }	//	GetDeviceAtIndex
 
@@ -287,10 +445,10 @@ bool CNTV2DeviceScanner::GetFirstDeviceWithID (const NTV2DeviceID inDeviceID, CN
 {
 	outDevice.Close();
 	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
+	UpdateDeviceInventory();
 	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
 		if (sDevInfoList.at(ndx).deviceID == inDeviceID)
-			return outDevice.Open(UWord(ndx));	//	Found!
+			return OpenInventoryDevice(ndx, outDevice);	//	Found!
 	return false;	//	Not found
 
 }	//	GetFirstDeviceWithID
@@ -307,13 +465,13 @@ bool CNTV2DeviceScanner::GetFirstDeviceWithName (const string & inNameSubString,
 	}
 
 	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
+	UpdateDeviceInventory();
 	string	nameSubString(inNameSubString);  aja::lower(nameSubString);
 	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
 	{
 		string deviceName(sDevInfoList.at(ndx).deviceIdentifier);  aja::lower(deviceName);
 		if (deviceName.find(nameSubString) != string::npos)
-			return outDevice.Open(UWord(ndx));	//	Found!
+			return OpenInventoryDevice(ndx, outDevice);	//	Found!
 	}
 	if (nameSubString == "io4kplus")
 	{	//	Io4K+ == DNXIV...
@@ -322,7 +480,7 @@ bool CNTV2DeviceScanner::GetFirstDeviceWithName (const string & inNameSubString,
 		{
 			string deviceName(sDevInfoList.at(ndx).deviceIdentifier);  aja::lower(deviceName);
 			if (deviceName.find(nameSubString) != string::npos)
-				return outDevice.Open(UWord(ndx));	//	Found!
+				return OpenInventoryDevice(ndx, outDevice);	//	Found!
 		}
 	}
 	return false;	//	Not found
@@ -334,17 +492,16 @@ bool CNTV2DeviceScanner::GetFirstDeviceWithSerial (const string & inSerialStr, C
 {
 	outDevice.Close();
 	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
+	UpdateDeviceInventory();
 	string searchSerialStr(inSerialStr);  aja::lower(searchSerialStr);
 	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
 	{
-		CNTV2Card dev(UWord(ndx+0));
-		string serNumStr;
-		if (dev.GetSerialNumberString(serNumStr))
+		string serNumStr(sDevInfoList.at(ndx).serialNumber);
+		if (!serNumStr.empty())
 		{
 			aja::lower(serNumStr);
 			if (serNumStr.find(searchSerialStr) != string::npos)
-				return outDevice.Open(UWord(ndx));
+				return OpenInventoryDevice(ndx, outDevice);
 		}
 	}
 	return false;
@@ -363,10 +520,10 @@ bool CNTV2DeviceScanner::GetDeviceWithSerial (const string & inSerialNumber, CNT
 {
 	outDevice.Close();
 	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
+	UpdateDeviceInventory();
 	for (size_t ndx(0);  ndx < sDevInfoList.size();  ndx++)
 		if (sDevInfoList.at(ndx).serialNumber == inSerialNumber)
-			return outDevice.Open(UWord(ndx));
+			return OpenInventoryDevice(ndx, outDevice);
 	return false;
 }
 
@@ -379,7 +536,7 @@ bool CNTV2DeviceScanner::GetFirstDeviceFromArgument (const string & inArgument,
 
 	//	Special case:  'LIST' or '?'  ---  print an enumeration of available devices to stdout, then bail
 	AJAAutoLock tmpLock(&sDevInfoListLock);
-	ScanHardware();
+	UpdateDeviceInventory();
 	string upperArg(inArgument);  aja::upper(upperArg);
 	if (upperArg == "LIST" || upperArg == "?")
 	{
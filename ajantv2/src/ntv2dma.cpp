@@ -100,6 +100,26 @@ bool CNTV2Card::DMAReadSegments (	const ULWord		inFrameNumber,
 }
 
 
+bool CNTV2Card::DMAReadRegionOfInterest (const ULWord inFrameNumber, NTV2Buffer & outBuffer,
+											const NTV2SegmentedXferInfo & inSegmentInfo)
+{
+	if (!outBuffer  ||  !inSegmentInfo.isValid())
+		return false;
+	if (inSegmentInfo.getDestOffset()  ||  inSegmentInfo.isSourceBottomUp()  ||  inSegmentInfo.isDestBottomUp())
+		return false;	//	Segmented DMAs always start at the host buffer address, top-down
+	const ULWord	elemBytes	(inSegmentInfo.getElementLength());
+	const ULWord	segBytes	(inSegmentInfo.getSegmentLength() * elemBytes);
+	const ULWord	hostPitch	(inSegmentInfo.getDestPitch() * elemBytes);
+	if (hostPitch * (inSegmentInfo.getSegmentCount() - 1) + segBytes > outBuffer.GetByteCount())
+		return false;	//	Host buffer too small
+	ULWord *	pHostBuffer	(reinterpret_cast <ULWord *> (outBuffer.GetHostPointer()));
+	if (inSegmentInfo.getSegmentCount() == 1)
+		return DMARead (inFrameNumber, pHostBuffer, inSegmentInfo.getSourceOffset() * elemBytes, segBytes);
+	return DMAReadSegments (inFrameNumber, pHostBuffer, inSegmentInfo.getSourceOffset() * elemBytes, segBytes,
+							inSegmentInfo.getSegmentCount(), hostPitch, inSegmentInfo.getSourcePitch() * elemBytes);
+}
+
+
 bool CNTV2Card::DMAWriteSegments (	const ULWord		inFrameNumber,
 									const ULWord *		pFrameBuffer,
 									const ULWord		inOffsetBytes,
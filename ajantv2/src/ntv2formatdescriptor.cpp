@@ -1287,6 +1287,62 @@ NTV2SegmentedXferInfo & NTV2FormatDescriptor::GetSegmentedXferInfo (NTV2Segmente
 }
 
 
+bool NTV2FormatDescriptor::GetRegionOfInterestXferInfo (NTV2SegmentedXferInfo & outSegmentInfo,
+														const ULWord inLeft, const ULWord inTop,
+														const ULWord inWidth, const ULWord inHeight,
+														const ULWord inLineStep) const
+{
+	outSegmentInfo = NTV2SegmentedXferInfo();
+	if (!IsValid()  ||  IsPlanar())
+		return false;
+	if (!inWidth  ||  !inHeight  ||  !inLineStep)
+		return false;
+	if (inLeft + inWidth > GetRasterWidth()  ||  inTop + inHeight > GetVisibleRasterHeight())
+		return false;
+
+	//	Smallest run of pixels that starts on a 32-bit word boundary (same grouping as CopyRaster)...
+	ULWord	pixelsPerGroup(0), bytesPerGroup(0);
+	switch (GetPixelFormat())
+	{
+		case NTV2_FBF_10BIT_YCBCR:
+		case NTV2_FBF_10BIT_YCBCR_DPX:		pixelsPerGroup = 6;	bytesPerGroup = 16;	break;
+
+		case NTV2_FBF_8BIT_YCBCR:
+		case NTV2_FBF_8BIT_YCBCR_YUY2:		pixelsPerGroup = 2;	bytesPerGroup = 4;	break;
+
+		case NTV2_FBF_ARGB:
+		case NTV2_FBF_RGBA:
+		case NTV2_FBF_ABGR:
+		case NTV2_FBF_10BIT_DPX:
+		case NTV2_FBF_10BIT_DPX_LE:
+		case NTV2_FBF_10BIT_RGB:			pixelsPerGroup = 1;	bytesPerGroup = 4;	break;
+
+		case NTV2_FBF_24BIT_RGB:
+		case NTV2_FBF_24BIT_BGR:			pixelsPerGroup = 4;	bytesPerGroup = 12;	break;
+
+		case NTV2_FBF_48BIT_RGB:			pixelsPerGroup = 2;	bytesPerGroup = 12;	break;
+
+		default:							return false;	//	Unsupported pixel format
+	}
+	if (inLeft % pixelsPerGroup  ||  inWidth % pixelsPerGroup)
+		return false;	//	Region doesn't start/end on a pixel group boundary
+
+	const ULWord	leftBytes	(inLeft / pixelsPerGroup * bytesPerGroup);
+	const ULWord	rowBytes	(inWidth / pixelsPerGroup * bytesPerGroup);
+	if (leftBytes + rowBytes > GetBytesPerRow())
+		return false;
+
+	outSegmentInfo.setElementLength(1)
+				.setSegmentCount((inHeight + inLineStep - 1) / inLineStep)
+				.setSegmentLength(rowBytes)
+				.setSourceOffset((GetFirstActiveLine() + inTop) * GetBytesPerRow()  +  leftBytes)
+				.setSourcePitch(GetBytesPerRow() * inLineStep)
+				.setDestOffset(0)
+				.setDestPitch(rowBytes);
+	return true;
+}
+
+
 //	Q:	WHY IS NTV2SmpteLineNumber's CONSTRUCTOR & GetLastLine IMPLEMENTATION HERE?
 //	A:	TO USE THE SAME LineNumbersF1/LineNumbersF2 TABLES (above)
 
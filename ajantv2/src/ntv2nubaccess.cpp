@@ -13,7 +13,9 @@
 #include "ajabase/common/common.h"
 #include "ajabase/system/systemtime.h"
 #include "ajabase/system/thread.h"
+#include "ajabase/system/event.h"
 #include <iomanip>
+#include <set>
 #if !defined(NTV2_PREVENT_PLUGIN_LOAD)
 	#include <fstream>
 	#include "mbedtls/x509.h"
@@ -1927,8 +1929,46 @@ string NTV2RPCBase::AJAFingerprint (const bool inLowerCase, const bool inStripCo
 	NTV2RPCClientAPI
 *****************************************************************************************************************************************************/
 
+//	Pipelining state, kept out of NTV2RPCClientAPI so its layout matches plugins built against older SDKs
+class NTV2RPCClientPipe
+{
+	public:
+		typedef std::map<NTV2RPCRequestID, bool>		Completions;	//	Completed requests not yet collected (true == success)
+		typedef std::map<NTV2RPCRequestID, AJAEvent*>	Waiters;		//	Auto-reset event of each thread waiting for a request
+		typedef std::set<NTV2RPCRequestID>				InFlight;		//	Requests handed out and not yet collected
+
+		NTV2RPCClientPipe ()
+			:	mLastRequestID(0), mSubscribedInts(0)
+		{
+			for (size_t ndx(0);  ndx < size_t(eNumInterruptTypes);  ndx++)
+				{mIntCounts[ndx] = 0;  mpIntEvents[ndx] = AJA_NULL;}
+		}
+		~NTV2RPCClientPipe ()
+		{
+			for (size_t ndx(0);  ndx < size_t(eNumInterruptTypes);  ndx++)
+				delete mpIntEvents[ndx];
+		}
+		inline bool	IsSubscribed (const INTERRUPT_ENUMS inInterrupt) const	{return (mSubscribedInts & (ULWord64(1) << inInterrupt)) != 0;}
+		inline void	RemoveWaiter (const NTV2RPCRequestID inRequestID, AJAEvent * pInEvent)	//	Caller must hold mLock
+		{	Waiters::iterator it (mWaiters.find(inRequestID));
+			if (it != mWaiters.end()  &&  it->second == pInEvent)
+				mWaiters.erase(it);
+		}
+
+		mutable AJALock		mLock;
+		NTV2RPCRequestID	mLastRequestID;		//	Last request ID handed out
+		Completions			mCompletions;
+		Waiters				mWaiters;
+		InFlight			mInFlight;
+		ULWord64			mSubscribedInts;	//	Bit mask of subscribed (server-pushed) interrupts
+		ULWord				mIntCounts[eNumInterruptTypes];		//	Pushed notifications not yet consumed by a waiter
+		AJAEvent *			mpIntEvents[eNumInterruptTypes];	//	Auto-reset, created when first subscribed
+};	//	NTV2RPCClientPipe
+
+
 NTV2RPCClientAPI::NTV2RPCClientAPI (NTV2ConnectParams inParams, void * pRefCon)
-	:	NTV2RPCBase(inParams, reinterpret_cast<ULWord*>(pRefCon))
+	:	NTV2RPCBase(inParams, reinterpret_cast<ULWord*>(pRefCon)),
+		mpPipe	(new NTV2RPCClientPipe)
 {
 	AJADebug::Open();
 	AJAAtomic::Increment(&gClientConstructCount);
@@ -1939,6 +1979,8 @@ NTV2RPCClientAPI::~NTV2RPCClientAPI ()
 {
 	if (IsConnected())
 		NTV2Disconnect();
+	delete mpPipe;
+	mpPipe = AJA_NULL;
 	AJAAtomic::Increment(&gClientDestructCount);
 	PDBGX(DEC(gClientConstructCount) << " created, " << DEC(gClientDestructCount) << " destroyed");
 }
@@ -2007,7 +2049,9 @@ bool NTV2RPCClientAPI::NTV2AutoCirculateRemote (AUTOCIRCULATE_DATA & autoCircDat
 }
 
 bool NTV2RPCClientAPI::NTV2WaitForInterruptRemote (const INTERRUPT_ENUMS eInterrupt, const ULWord timeOutMs)
-{	(void) eInterrupt; (void) timeOutMs;
+{
+	if (IsInterruptSubscribed(eInterrupt))
+		return WaitForPostedInterrupt(eInterrupt, timeOutMs);	//	Server pushes this one
 	return false;	//	UNIMPLEMENTED
 }
 
@@ -2057,6 +2101,202 @@ bool NTV2RPCClientAPI::NTV2MessageRemote (NTV2_HEADER * pInMessage)
 	return false;	//	UNIMPLEMENTED
 }
 
+bool NTV2RPCClientAPI::NTV2ReadRegistersRemote (NTV2RegReads & inOutValues)
+{
+	if (inOutValues.empty())
+		return true;	//	Nothing to do
+	NTV2GetRegisters getRegsParams (inOutValues);
+	if (NTV2MessageRemote(getRegsParams))
+		return getRegsParams.GetRegisterValues(inOutValues);
+
+	//	Plugin doesn't handle NTV2GetRegisters -- fall back to one-at-a-time...
+	for (NTV2RegReadsIter it(inOutValues.begin());  it != inOutValues.end();  ++it)
+		if (!NTV2ReadRegisterRemote (it->registerNumber, it->registerValue, it->registerMask, it->registerShift))
+			return false;
+	return true;
+}
+
+bool NTV2RPCClientAPI::NTV2WriteRegistersRemote (const NTV2RegWrites & inRegWrites, NTV2RegWrites & outFailedWrites)
+{
+	outFailedWrites.clear();
+	if (inRegWrites.empty())
+		return true;	//	Nothing to do
+	NTV2SetRegisters setRegsParams (inRegWrites);
+	if (NTV2MessageRemote(setRegsParams))
+	{
+		if (setRegsParams.GetNumFailedWrites())
+			setRegsParams.GetFailedRegisterWrites(outFailedWrites);
+		return outFailedWrites.empty();
+	}
+
+	//	Plugin doesn't handle NTV2SetRegisters -- fall back to one-at-a-time...
+	for (NTV2RegWritesConstIter it(inRegWrites.begin());  it != inRegWrites.end();  ++it)
+		if (!NTV2WriteRegisterRemote (it->registerNumber, it->registerValue, it->registerMask, it->registerShift))
+			outFailedWrites.push_back(*it);
+	return outFailedWrites.empty();
+}
+
+bool NTV2RPCClientAPI::NTV2SubmitMessageRemote (NTV2_HEADER * pInMessage, NTV2RPCRequestID & outRequestID)
+{
+	//	Default implementation is synchronous:  perform the request now, and post its result for later collection...
+	outRequestID = NextRequestID();
+	return PostCompletion (outRequestID, NTV2MessageRemote(pInMessage));
+}
+
+bool NTV2RPCClientAPI::NTV2CompleteMessageRemote (const NTV2RPCRequestID inRequestID, const ULWord inTimeoutMs)
+{
+	if (!inRequestID)
+		return false;
+	const uint64_t deadline (AJATime::GetSystemMilliseconds() + inTimeoutMs);
+	AJAEvent wakeup(/*manualReset*/false);	//	Only signaled when MY request completes
+	bool result(false), done(false);
+	while (!done)
+	{
+		{	AJAAutoLock tmp(&mpPipe->mLock);
+			NTV2RPCClientPipe::Completions::iterator it (mpPipe->mCompletions.find(inRequestID));
+			if (it != mpPipe->mCompletions.end())
+			{
+				result = it->second;
+				mpPipe->mCompletions.erase(it);
+				mpPipe->mInFlight.erase(inRequestID);
+				done = true;
+			}
+			else if (mpPipe->mInFlight.find(inRequestID) == mpPipe->mInFlight.end())
+			{	//	Never submitted, cancelled, or already collected -- nothing will ever complete it
+				NBFAIL("Request " << DEC(inRequestID) << " isn't pending");
+				mpPipe->RemoveWaiter(inRequestID, &wakeup);
+				return false;
+			}
+			else
+			{
+				AJAEvent* & pWaiter (mpPipe->mWaiters[inRequestID]);
+				if (pWaiter  &&  pWaiter != &wakeup)
+					{NBFAIL("Request " << DEC(inRequestID) << " already being waited for");  return false;}
+				pWaiter = &wakeup;	//	PostCompletion signals me
+			}
+			if (done)
+				{mpPipe->RemoveWaiter(inRequestID, &wakeup);  break;}
+		}
+		const uint64_t now (AJATime::GetSystemMilliseconds());
+		if (now >= deadline)
+			break;
+		wakeup.WaitForSignal(uint32_t(deadline - now));	//	Re-check either way
+	}
+	if (!done)
+	{	AJAAutoLock tmp(&mpPipe->mLock);
+		mpPipe->RemoveWaiter(inRequestID, &wakeup);
+		NBWARN("Request " << DEC(inRequestID) << " timed out after " << DEC(inTimeoutMs) << "ms");
+	}
+	return result;
+}
+
+size_t NTV2RPCClientAPI::NTV2OutstandingRemote (void) const
+{
+	AJAAutoLock tmp(&mpPipe->mLock);
+	return mpPipe->mInFlight.size();
+}
+
+NTV2RPCRequestID NTV2RPCClientAPI::NextRequestID (void)
+{
+	AJAAutoLock tmp(&mpPipe->mLock);
+	const NTV2RPCRequestID requestID (++mpPipe->mLastRequestID);
+	mpPipe->mInFlight.insert(requestID);	//	Outstanding until collected by NTV2CompleteMessageRemote, or cancelled
+	return requestID;
+}
+
+bool NTV2RPCClientAPI::CancelRequest (const NTV2RPCRequestID inRequestID)
+{
+	AJAAutoLock tmp(&mpPipe->mLock);
+	if (!mpPipe->mInFlight.erase(inRequestID))
+		return false;	//	Not pending
+	mpPipe->mCompletions.erase(inRequestID);
+	NTV2RPCClientPipe::Waiters::iterator it (mpPipe->mWaiters.find(inRequestID));
+	if (it != mpPipe->mWaiters.end())
+		it->second->Signal();	//	Its waiter will find it's no longer pending
+	return true;
+}
+
+bool NTV2RPCClientAPI::PostCompletion (const NTV2RPCRequestID inRequestID, const bool inSuccess)
+{
+	if (!inRequestID)
+		return false;
+	AJAAutoLock tmp(&mpPipe->mLock);
+	if (mpPipe->mInFlight.find(inRequestID) == mpPipe->mInFlight.end())
+		return false;	//	Cancelled or unknown
+	mpPipe->mCompletions[inRequestID] = inSuccess;
+	NTV2RPCClientPipe::Waiters::iterator it (mpPipe->mWaiters.find(inRequestID));
+	if (it != mpPipe->mWaiters.end())
+		it->second->Signal();	//	Wake only the thread waiting for this request
+	return true;
+}
+
+bool NTV2RPCClientAPI::NTV2SubscribeInterruptRemote (const INTERRUPT_ENUMS inInterrupt, const bool inSubscribe)
+{	(void) inInterrupt;  (void) inSubscribe;
+	return false;	//	UNIMPLEMENTED -- plugins that support server-pushed interrupts must override
+}
+
+bool NTV2RPCClientAPI::IsInterruptSubscribed (const INTERRUPT_ENUMS inInterrupt) const
+{
+	if (!NTV2_IS_VALID_INTERRUPT_ENUM(inInterrupt))
+		return false;
+	AJAAutoLock tmp(&mpPipe->mLock);
+	return mpPipe->IsSubscribed(inInterrupt);
+}
+
+bool NTV2RPCClientAPI::SetInterruptSubscribed (const INTERRUPT_ENUMS inInterrupt, const bool inSubscribed)
+{
+	if (!NTV2_IS_VALID_INTERRUPT_ENUM(inInterrupt))
+		return false;
+	AJAAutoLock tmp(&mpPipe->mLock);
+	mpPipe->mIntCounts[inInterrupt] = 0;
+	if (inSubscribed)
+	{
+		if (!mpPipe->mpIntEvents[inInterrupt])
+			mpPipe->mpIntEvents[inInterrupt] = new AJAEvent(/*manualReset*/false);
+		mpPipe->mSubscribedInts |= ULWord64(1) << inInterrupt;
+	}
+	else
+	{
+		mpPipe->mSubscribedInts &= ~(ULWord64(1) << inInterrupt);
+		if (mpPipe->mpIntEvents[inInterrupt])
+			mpPipe->mpIntEvents[inInterrupt]->Signal();	//	Release any waiter
+	}
+	return true;
+}
+
+bool NTV2RPCClientAPI::PostInterrupt (const INTERRUPT_ENUMS inInterrupt)
+{
+	if (!NTV2_IS_VALID_INTERRUPT_ENUM(inInterrupt))
+		return false;
+	AJAAutoLock tmp(&mpPipe->mLock);
+	if (!mpPipe->IsSubscribed(inInterrupt))
+		return false;	//	Not subscribed
+	mpPipe->mIntCounts[inInterrupt]++;	//	Counted, so a notification that arrives before the wait isn't lost
+	return AJA_SUCCESS(mpPipe->mpIntEvents[inInterrupt]->Signal());
+}
+
+bool NTV2RPCClientAPI::WaitForPostedInterrupt (const INTERRUPT_ENUMS inInterrupt, const ULWord inTimeoutMs)
+{
+	if (!NTV2_IS_VALID_INTERRUPT_ENUM(inInterrupt))
+		return false;
+	const uint64_t deadline (AJATime::GetSystemMilliseconds() + inTimeoutMs);
+	while (true)
+	{
+		AJAEvent * pEvent(AJA_NULL);
+		{	AJAAutoLock tmp(&mpPipe->mLock);
+			if (!mpPipe->IsSubscribed(inInterrupt))
+				return false;	//	Not (or no longer) subscribed
+			if (mpPipe->mIntCounts[inInterrupt])
+				{mpPipe->mIntCounts[inInterrupt] = 0;  return true;}	//	Consume all notifications posted since the last wait
+			pEvent = mpPipe->mpIntEvents[inInterrupt];
+		}
+		const uint64_t now (AJATime::GetSystemMilliseconds());
+		if (now >= deadline)
+			return false;
+		pEvent->WaitForSignal(uint32_t(deadline - now));	//	Re-check the count either way
+	}
+}
+
 bool NTV2RPCClientAPI::NTV2GetBoolParamRemote (const ULWord inParamID,  ULWord & outValue)
 {	(void) inParamID;
 	outValue = 0;
@@ -2148,7 +2388,9 @@ NTV2RPCServerAPI * NTV2RPCServerAPI::CreateServer (const string & inURL)	//	CLAS
 }
 
 NTV2RPCServerAPI::NTV2RPCServerAPI (NTV2ConnectParams inParams, void * pRefCon)
-	:	NTV2RPCBase(inParams, reinterpret_cast<ULWord*>(pRefCon))
+	:	NTV2RPCBase(inParams, reinterpret_cast<ULWord*>(pRefCon)),
+		mRunning	(false),
+		mTerminate	(false)
 {
 	NTV2Buffer spare(&mSpare, sizeof(mSpare));  spare.Fill(0ULL);
 	AJADebug::Open();
@@ -648,8 +648,7 @@ bool NTV2Buffer::AppendU8s (UByteSequence & outU8s) const
 	const size_t maxSize (GetByteCount());
 	try
 	{
-		for (size_t ndx(0);	 ndx < maxSize;	 ndx++)
-			outU8s.push_back(*pU8++);
+		outU8s.insert(outU8s.end(), pU8, pU8 + maxSize);
 	}
 	catch (...)
 	{
@@ -1680,6 +1679,34 @@ bool NTV2Buffer::Allocate (const size_t inByteCount, const bool inPageAligned)
 }
 
 
+bool NTV2Buffer::AllocateHugePages (const size_t inByteCount, const size_t inPageSize, const int inNUMANode)
+{
+	bool result(Set(AJA_NULL, 0));	//	Jettison existing buffer (if any)
+	if (inByteCount)
+	{
+		UByte * pBuffer(reinterpret_cast<UByte*>(AJAMemory::AllocateHugePages(inByteCount, inPageSize, inNUMANode)));
+		result = false;
+		if (pBuffer	 &&	 Set(pBuffer, inByteCount))
+		{	//	SDK owns this memory -- freed with AJAMemory::FreeAligned, same as page-aligned
+			result = true;
+			fFlags |= NTV2Buffer_ALLOCATED | NTV2Buffer_PAGE_ALIGNED;
+			Fill(UByte(0));	//	Zero it (which also faults in the pages)
+		}
+		else if (pBuffer)
+			AJAMemory::FreeAligned(pBuffer);
+	}
+	return result;
+}
+
+
+size_t NTV2Buffer::GetPageSize (void) const
+{
+	if (IsNULL())
+		return 0;
+	return AJAMemory::GetPageSize(GetHostPointer());
+}
+
+
 bool NTV2Buffer::Deallocate (void)
 {
 	if (IsAllocatedBySDK())
@@ -2854,6 +2881,29 @@ bool AUTOCIRCULATE_TRANSFER::SegmentedDMAsEnabled (void) const
 }
 
 
+bool AUTOCIRCULATE_TRANSFER::SetVideoRegionOfInterest (ULWord * pInVideoBuffer, const ULWord inVideoByteCount,
+														const NTV2SegmentedXferInfo & inSegmentInfo)
+{
+	NTV2_ASSERT_STRUCT_VALID;
+	if (!pInVideoBuffer  ||  !inSegmentInfo.isValid())
+		return false;
+	const ULWord	elemBytes	(inSegmentInfo.getElementLength());
+	const ULWord	segBytes	(inSegmentInfo.getSegmentLength() * elemBytes);
+	const ULWord	hostPitch	(inSegmentInfo.getDestPitch() * elemBytes);
+	const ULWord	devPitch	(inSegmentInfo.getSourcePitch() * elemBytes);
+	if (inSegmentInfo.getDestOffset()  ||  inSegmentInfo.isSourceBottomUp()  ||  inSegmentInfo.isDestBottomUp())
+		return false;	//	Driver transfers always start at the host buffer address, top-down
+	if (inSegmentInfo.getSegmentCount() > 1  &&  (hostPitch < segBytes  ||  devPitch < segBytes))
+		return false;	//	Overlapping segments
+	if (hostPitch * (inSegmentInfo.getSegmentCount() - 1) + segBytes > inVideoByteCount)
+		return false;	//	Host buffer too small
+
+	acVideoBuffer.Set (pInVideoBuffer, segBytes);	//	For segmented DMAs, the video byte count holds the segment byte count
+	acInVideoDMAOffset = inSegmentInfo.getSourceOffset() * elemBytes;
+	return EnableSegmentedDMAs (inSegmentInfo.getSegmentCount(), segBytes, hostPitch, devPitch);
+}
+
+
 bool AUTOCIRCULATE_TRANSFER::GetInputTimeCodes (NTV2TimeCodeList & outValues) const
 {
 	NTV2_ASSERT_STRUCT_VALID;
@@ -3164,7 +3214,8 @@ bool NTV2GetRegisters::GetRegisterValues (NTV2RegisterReads & outValues) const
 			NTV2RegValueMapConstIter mapIter(regValMap.find(it->registerNumber));
 			if (mapIter == regValMap.end())
 				missingTally++; //	Missing register
-			it->registerValue = mapIter->second;
+			else
+				it->registerValue = mapIter->second;
 		}
 		return !missingTally;
 	}
@@ -3602,11 +3653,7 @@ using namespace ntv2nub;
 		POPU32(flags, inBlob, inOutIndex);						//	ULWord		fFlags
 		if (!Allocate(byteCount, flags & NTV2Buffer_PAGE_ALIGNED))
 			return false;
-		if ((inOutIndex + byteCount) > inBlob.size())
-			return false;	//	past end of inBlob
-		for (ULWord cnt(0);  cnt < byteCount;  cnt++)
-			U8(int(cnt)) = inBlob.at(inOutIndex++);	//	Caller is responsible for byte-swapping if needed
-		return true;
+		return POPU8s(GetHostPointer(), byteCount, inBlob, inOutIndex);	//	Caller is responsible for byte-swapping if needed
 	}
 
 	bool NTV2GetRegisters::RPCEncode (UByteSequence & outBlob)
@@ -4155,10 +4202,8 @@ using namespace ntv2nub;
 		ok &= mBuffer.RPCEncode(outBlob);						//		NTV2Buffer				mBuffer
 		PUSHU32(mFlags, outBlob);								//		ULWord					mFlags
 		PUSHU32(mStatus, outBlob);								//		ULWord					mStatus
-		for (size_t ndx(0);  ndx < 16;  ndx++)
-			PUSHU32(mRegisters[ndx], outBlob);					//		ULWord					mRegisters[16]
-		for (size_t ndx(0);  ndx < 32;  ndx++)
-			PUSHU32(mReserved[ndx], outBlob);					//		ULWord					mReserved[32]
+		PUSHU32s(mRegisters, 16, outBlob);						//		ULWord					mRegisters[16]
+		PUSHU32s(mReserved, 32, outBlob);						//		ULWord					mReserved[32]
 		ok &= mTrailer.RPCEncode(outBlob);						//	NTV2_TRAILER			mTrailer
 		return ok;
 	}
@@ -4169,10 +4214,8 @@ using namespace ntv2nub;
 		ok &= mBuffer.RPCDecode(inBlob, inOutIndex);			//		NTV2Buffer				mBuffer
 		POPU32(mFlags, inBlob, inOutIndex);						//		ULWord					mFlags
 		POPU32(mStatus, inBlob, inOutIndex);					//		ULWord					mStatus
-		for (size_t ndx(0);  ndx < 16;  ndx++)
-			POPU32(mRegisters[ndx], inBlob, inOutIndex);		//		ULWord					mRegisters[16]
-		for (size_t ndx(0);  ndx < 16;  ndx++)
-			POPU32(mReserved[ndx], inBlob, inOutIndex);			//		ULWord					mReserved[16]
+		ok &= POPU32s(mRegisters, 16, inBlob, inOutIndex);		//		ULWord					mRegisters[16]
+		ok &= POPU32s(mReserved, 32, inBlob, inOutIndex);		//		ULWord					mReserved[32]
 		ok &= mTrailer.RPCDecode(inBlob, inOutIndex);			//	NTV2_TRAILER			mTrailer
 		return ok;
 	}
@@ -4255,6 +4298,8 @@ using namespace ntv2nub;
 		PUSHU32(maxTasks, outBlob);					//	ULWord	maxTasks
 		PUSHU64(ULWord64(taskArray), outBlob);		//	ULWord	taskArray
 		if (taskArray && numTasks)
+		{
+			RESERVE(outBlob, numTasks * sizeof(AutoCircGenericTask));
 			for (ULWord num(0);  num < numTasks;  num++)
 			{
 				const AutoCircGenericTask &	task (taskArray[num]);
@@ -4265,9 +4310,9 @@ using namespace ntv2nub;
 					numWords = sizeof(AutoCircRegisterTask)/sizeof(ULWord);
 				else if (NTV2_IS_TIMECODE_TASK(task.taskType))
 					numWords = sizeof(AutoCircTimeCodeTask)/sizeof(ULWord);
-				for (ULWord word(0);  word < numWords;  word++)
-					PUSHU32(pULWords[word], outBlob);
+				PUSHU32s(pULWords, numWords, outBlob);
 			}
+		}
 		return true;
 	}
 
@@ -4291,8 +4336,8 @@ using namespace ntv2nub;
 					numWords = sizeof(AutoCircRegisterTask)/sizeof(ULWord);
 				else if (NTV2_IS_TIMECODE_TASK(task.taskType))
 					numWords = sizeof(AutoCircTimeCodeTask)/sizeof(ULWord);
-				for (ULWord word(0);  word < numWords;  word++)
-					POPU32(pULWords[word], inBlob, inOutIndex);
+				if (!POPU32s(pULWords, numWords, inBlob, inOutIndex))
+					return false;
 			}
 		return true;
 	}
@@ -178,6 +178,7 @@ static const ULWord gChannelToSDIInputProgressiveShift []	= { kRegShiftInput1Pro
 // Output: NONE
 bool CNTV2Card::SetEveryFrameServices (NTV2EveryFrameTaskMode mode)
 {
+	InvalidateACXferContext();	//	All channels' cached task mode is stale
 	return WriteRegister(kVRegEveryFrameTaskFilter, ULWord(mode));
 }
 
@@ -212,6 +213,7 @@ bool CNTV2Card::SetVideoFormat (const NTV2VideoFormat value, const bool inIsReta
 #endif
 	const NTV2Channel channel(IsMultiFormatActive() ? inChannel : NTV2_CHANNEL1);
 	int hOffset(0),	 vOffset(0);
+	InvalidateACXferContext();	//	Format change can affect any channel's cached transfer context
 
 	if (ajaRetail)
 	{	// Get the current H and V timing offsets
@@ -806,6 +808,7 @@ bool CNTV2Card::GetVideoVOffset (int & outVOffset, const UWord inOutputSpigot)
 // Output: NONE
 bool CNTV2Card::SetStandard (NTV2Standard value, NTV2Channel inChannel)
 {
+	InvalidateACXferContext();	//	Standard change can affect any channel's cached transfer context
 	if (IsMultiRasterWidgetChannel(inChannel))
 		return WriteRegister (kRegMROutControl, value, kRegMaskStandard, kRegShiftStandard);
 	if (!IsMultiFormatActive())
@@ -1610,6 +1613,7 @@ bool CNTV2Card::SetMode (const NTV2Channel inChannel, const NTV2Mode inValue,  c
 		return inValue == NTV2_MODE_INPUT;
 	if (IS_CHANNEL_INVALID(inChannel))
 		return false;
+	InvalidateACXferContext(inChannel);	//	Mode determines the cached A/C crosspoint
 	return WriteRegister (gChannelToControlRegNum[inChannel], inValue, kRegMaskMode, kRegShiftMode);
 }
 
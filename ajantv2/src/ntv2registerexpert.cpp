@@ -1710,6 +1710,11 @@ private:
 		DEF_REG	(kVRegHDMIOutStatus1,					mDecodeHDMIOutputStatus,READWRITE,	kRegClass_HDMI, kRegClass_Output, kRegClass_NULL);
 		DEF_REG	(kVRegAudioOutputToneSelect,			mDefaultRegDecoder, READWRITE, kRegClass_Audio,kRegClass_Output, kRegClass_NULL);
 		DEF_REG	(kVRegDynFirmwareUpdateCounts,			mDecodeDynFWUpdateCounts,READWRITE,kRegClass_NULL,kRegClass_NULL,kRegClass_NULL);
+		DEF_REG	(kVRegDmaPageCacheHits,					mDefaultRegDecoder, READONLY, kRegClass_DMA, kRegClass_NULL, kRegClass_NULL);
+		DEF_REG	(kVRegDmaPageCacheMisses,				mDefaultRegDecoder, READONLY, kRegClass_DMA, kRegClass_NULL, kRegClass_NULL);
+		DEF_REG	(kVRegDmaPageCacheEvictions,			mDefaultRegDecoder, READONLY, kRegClass_DMA, kRegClass_NULL, kRegClass_NULL);
+		DEF_REG	(kVRegDmaPageCacheBuffers,				mDefaultRegDecoder, READONLY, kRegClass_DMA, kRegClass_NULL, kRegClass_NULL);
+		DEF_REG	(kVRegDmaPageCacheKBytes,				mDefaultRegDecoder, READONLY, kRegClass_DMA, kRegClass_NULL, kRegClass_NULL);
 
 		DEF_REGNAME	(kVRegLastAJA);
 		DEF_REGNAME	(kVRegFirstOEM);
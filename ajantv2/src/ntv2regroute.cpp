@@ -276,37 +276,88 @@ bool CNTV2Card::SupportedOutputXptsForInputXpt (const NTV2InputXptID inInputXptI
 
 bool CNTV2Card::ApplySignalRoute (const CNTV2SignalRouter & inRouter, const bool inReplace)
 {
-	if (inReplace)
-		if (!ClearRouting ())
-			return false;
+	return ApplySignalRoute (inRouter.GetConnections(), inReplace);
+}
 
-	NTV2RegisterWrites	registerWrites;
-	if (!inRouter.GetRegisterWrites (registerWrites))
-		return false;
+bool CNTV2Card::ApplySignalRoute (const NTV2XptConnections & inConnections, const bool inReplace)
+{
+	//	Best effort (as it always was):  skip what this device can't do, apply the rest...
+	NTV2PossibleConnections possible;
+	if (IsSupported(kDeviceHasXptConnectROM))
+		GetPossibleConnections(possible);
+	NTV2XptConnections invalid, valid, changes;
+	NTV2WidgetIDSet widgetIDs;
+	const bool haveWidgets (CNTV2SignalRouter::GetWidgetIDs(GetDeviceID(), widgetIDs));
+	if (haveWidgets)
+		CNTV2SignalRouter::ValidateConnections (GetDeviceID(), inConnections, invalid, possible);
+	for (NTV2XptConnectionsConstIter it(inConnections.begin());  it != inConnections.end();  ++it)
+	{	uint32_t regNum(0), ndx(999);
+		if (!CNTV2RegisterExpert::GetCrosspointSelectGroupRegisterInfo (it->first, regNum, ndx)  ||  !regNum  ||  ndx > 3)
+			invalid.insert(*it);	//	No crosspoint select register
+		else if (invalid.find(it->first) == invalid.end())
+			valid.insert(*it);		//	Valid (or no widget table to say otherwise)
+	}
+	if (!invalid.empty())
+		ROUTEWARN(GetDisplayName() << ": Skipped " << DEC(invalid.size()) << " unsupported connection(s): " << invalid);
+	const bool result (WriteRoutingChanges (valid, inReplace, changes));
+	return result  &&  invalid.empty();
+}
 
-	return WriteRegisters (registerWrites);
+bool CNTV2Card::ApplySignalRoute (const NTV2XptConnections & inConnections, const bool inReplace, NTV2XptConnections & outChanges)
+{
+	outChanges.clear();
+
+	//	Validate everything before touching anything...
+	NTV2PossibleConnections possible;
+	NTV2XptConnections invalid;
+	if (IsSupported(kDeviceHasXptConnectROM))
+		if (!GetPossibleConnections(possible))
+			ROUTEWARN(GetDisplayName() << ": Failed to read crosspoint ROM, validating against widget tables only");
+	if (!CNTV2SignalRouter::ValidateConnections (GetDeviceID(), inConnections, invalid, possible))
+		{ROUTEFAIL(GetDisplayName() << ": " << DEC(invalid.size()) << " unsupported connection(s), nothing changed: " << invalid);  return false;}
+	return WriteRoutingChanges (inConnections, inReplace, outChanges);
 }
 
-bool CNTV2Card::ApplySignalRoute (const NTV2XptConnections & inConnections, const bool inReplace)
+bool CNTV2Card::WriteRoutingChanges (const NTV2XptConnections & inConnections, const bool inReplace, NTV2XptConnections & outChanges)
 {
-	if (inReplace)
-		if (!ClearRouting ())
+	//	Only write what differs from the current routing...
+	NTV2XptConnections current;
+	outChanges.clear();
+	if (!GetConnections(current))
+	{	//	No widget table to read it with -- write everything, as Connect would...
+		ROUTEWARN(GetDisplayName() << ": Failed to read current routing, writing all " << DEC(inConnections.size()) << " connection(s)");
+		if (inReplace  &&  !ClearRouting())
 			return false;
-
-	unsigned failures(0);
-	for (NTV2XptConnectionsConstIter iter(inConnections.begin());  iter != inConnections.end();	 ++iter)
-		if (!Connect(iter->first, iter->second, IsSupported(kDeviceHasXptConnectROM)))
-			failures++;
-	return failures == 0;
+		outChanges = inConnections;
+		if (outChanges.empty())
+			return true;
+	}
+	else if (CNTV2SignalRouter::DiffConnections (current, inConnections, inReplace, outChanges))
+		{ROUTEDBG(GetDisplayName() << ": Routing unchanged");  return true;}
+
+	NTV2RegisterWrites regWrites;
+	if (!CNTV2SignalRouter::GetConnectionRegisterWrites (outChanges, regWrites))
+		{ROUTEFAIL(GetDisplayName() << ": Failed to make register writes for " << outChanges);  outChanges.clear();  return false;}
+	const ULWord maxRegNum (GetNumSupported(kDeviceGetMaxRegisterNumber));
+	for (NTV2RegisterWritesConstIter it(regWrites.begin());  it != regWrites.end();  ++it)
+		if (maxRegNum  &&  it->registerNumber > maxRegNum)
+			{ROUTEFAIL(GetDisplayName() << ": Routing register " << DEC(it->registerNumber) << " > max " << DEC(maxRegNum));  outChanges.clear();  return false;}
+
+	//	One batch for all crosspoint registers...
+	if (!WriteRegisters(regWrites))
+		{ROUTEFAIL(GetDisplayName() << ": Failed to write " << DEC(regWrites.size()) << " routing register(s) for " << outChanges);  return false;}
+	if (LOGGING_ROUTING_CHANGES)
+		ROUTENOTE(GetDisplayName() << ": " << DEC(outChanges.size()) << " connection(s) changed in " << DEC(regWrites.size())
+					<< " register write(s): " << outChanges);
+	return true;
 }
 
 bool CNTV2Card::RemoveConnections (const NTV2XptConnections & inConnections)
 {
-	unsigned failures(0);
+	NTV2XptConnections disconnects;
 	for (NTV2XptConnectionsConstIter iter(inConnections.begin());  iter != inConnections.end();	 ++iter)
-		if (!Disconnect(iter->first))
-			failures++;
-	return failures == 0;
+		disconnects.insert(NTV2XptConnection(iter->first, NTV2_XptBlack));
+	return ApplySignalRoute (disconnects, false);	//	Best effort
 }
 
 
@@ -667,6 +667,209 @@ bool CNTV2SignalRouter::CompareConnections (const NTV2XptConnections & inLHS,
 }
 
 
+bool CNTV2SignalRouter::DiffConnections (const NTV2XptConnections & inCurrent,
+										const NTV2XptConnections & inDesired,
+										const bool inReplace,
+										NTV2XptConnections & outChanges)	//	STATIC
+{
+	outChanges.clear();
+	//	Desired connections that differ from what's current...
+	for (NTV2XptConnectionsConstIter it(inDesired.begin());	 it != inDesired.end();	 ++it)
+	{
+		NTV2XptConnectionsConstIter curIt(inCurrent.find(it->first));
+		const NTV2OutputXptID curOutputXpt (curIt != inCurrent.end()  ?  curIt->second  :  NTV2_XptBlack);
+		if (curOutputXpt != it->second)
+			outChanges.insert(*it);
+	}
+	//	Current connections that aren't wanted anymore...
+	if (inReplace)
+		for (NTV2XptConnectionsConstIter it(inCurrent.begin());	 it != inCurrent.end();	 ++it)
+			if (it->second != NTV2_XptBlack  &&  inDesired.find(it->first) == inDesired.end())
+				outChanges.insert(NTV2XptConnection(it->first, NTV2_XptBlack));
+	return outChanges.empty();
+}
+
+
+//	True if the output xpt can legally feed the input xpt, as far as color space and the (optional) ROM are concerned
+static bool CanFeed (const NTV2InputXptID inInputXpt, const NTV2OutputXptID inOutputXpt, const NTV2PossibleConnections & inPossible)
+{
+	if (inOutputXpt == NTV2_XptBlack)
+		return true;	//	Every input xpt can connect to XptBlack
+	const bool isRGB (NTV2_IS_RGB_OutputCrosspointID(inOutputXpt) ? true : false);
+	if (isRGB  &&  CNTV2SignalRouter::IsYUVOnlyInputXpt(inInputXpt))
+		return false;
+	if (!isRGB	&&	CNTV2SignalRouter::IsRGBOnlyInputXpt(inInputXpt))
+		return false;
+	if (inPossible.empty())
+		return true;
+	for (NTV2PossibleConnectionsConstIter it(inPossible.lower_bound(inInputXpt));  it != inPossible.upper_bound(inInputXpt);  ++it)
+		if (it->second == inOutputXpt)
+			return true;
+	return false;
+}
+
+
+bool CNTV2SignalRouter::ValidateConnections (const NTV2DeviceID inDeviceID,
+											const NTV2XptConnections & inConnections,
+											NTV2XptConnections & outInvalid,
+											const NTV2PossibleConnections & inPossible)	//	STATIC
+{
+	outInvalid.clear();
+	NTV2WidgetIDSet widgetIDs;
+	if (!GetWidgetIDs (inDeviceID, widgetIDs))
+		{outInvalid = inConnections;  return inConnections.empty();}
+
+	NTV2InputXptIDSet	inputXpts;
+	NTV2OutputXptIDSet	outputXpts;
+	for (NTV2WidgetIDSetConstIter it(widgetIDs.begin());  it != widgetIDs.end();  ++it)
+	{
+		NTV2InputXptIDSet	inputs;
+		NTV2OutputXptIDSet	outputs;
+		GetWidgetInputs (*it, inputs);
+		GetWidgetOutputs (*it, outputs);
+		inputXpts.insert(inputs.begin(), inputs.end());
+		outputXpts.insert(outputs.begin(), outputs.end());
+	}
+
+	for (NTV2XptConnectionsConstIter it(inConnections.begin());	 it != inConnections.end();	 ++it)
+		if (inputXpts.find(it->first) == inputXpts.end())
+			outInvalid.insert(*it);		//	No such input on this device
+		else if (it->second != NTV2_XptBlack  &&  outputXpts.find(it->second) == outputXpts.end())
+			outInvalid.insert(*it);		//	No such output on this device
+		else if (!CanFeed(it->first, it->second, inPossible))
+			outInvalid.insert(*it);		//	Wrong color space, or not implemented in firmware
+	if (!outInvalid.empty())
+		SRWARN(outInvalid.size() << " invalid connection(s) for '" << ::NTV2DeviceIDToString(inDeviceID) << "': " << outInvalid);
+	return outInvalid.empty();
+}
+
+
+bool CNTV2SignalRouter::GetConnectionRegisterWrites (const NTV2XptConnections & inConnections, NTV2RegisterWrites & outRegWrites)	//	STATIC
+{
+	outRegWrites.clear();
+	typedef map<uint32_t, NTV2RegInfo>	RegWriteMap;
+	RegWriteMap regWrites;
+	for (NTV2XptConnectionsConstIter it(inConnections.begin());	 it != inConnections.end();	 ++it)
+	{
+		uint32_t regNum(0), ndx(999);
+		if (!CNTV2RegisterExpert::GetCrosspointSelectGroupRegisterInfo (it->first, regNum, ndx)	 ||	 !regNum  ||  ndx > 3)
+			{SRFAIL("No crosspoint select register for input " << ::NTV2InputCrosspointIDToString(it->first));	return false;}
+
+		//	Fold this crosspoint's byte lane into its register's write...
+		RegWriteMap::iterator regIt(regWrites.find(regNum));
+		if (regIt == regWrites.end())
+			regIt = regWrites.insert(RegWriteMap::value_type(regNum, NTV2RegInfo(regNum, 0, 0, 0))).first;
+		regIt->second.registerValue |= (ULWord(it->second) << sSignalRouterRegShifts[ndx]) & sSignalRouterRegMasks[ndx];
+		regIt->second.registerMask	|= sSignalRouterRegMasks[ndx];
+	}
+	for (RegWriteMap::const_iterator it(regWrites.begin());	 it != regWrites.end();	 ++it)
+		outRegWrites.push_back(it->second);
+	return true;
+}
+
+
+//	Answers with the widget on the device that owns the given input xpt
+static NTV2WidgetID DeviceWidgetForInput (const NTV2WidgetIDSet & inDeviceWidgets, const NTV2InputXptID inInputXpt)
+{
+	NTV2WidgetIDSet wgts;
+	CNTV2SignalRouter::GetWidgetsForInput (inInputXpt, wgts);
+	for (NTV2WidgetIDSetConstIter it(wgts.begin());	 it != wgts.end();	++it)
+		if (inDeviceWidgets.find(*it) != inDeviceWidgets.end())
+			return *it;
+	return NTV2_WIDGET_INVALID;
+}
+
+
+//	Adds the connections for one route constraint to inOutConnections, without disturbing those already there
+static bool SolveOneRoute (const NTV2WidgetIDSet & inDeviceWidgets, const NTV2RouteConstraint & inRoute,
+							const NTV2PossibleConnections & inPossible, NTV2XptConnections & inOutConnections)
+{
+	const bool fmtIsRGB (NTV2_IS_FBF_RGB(inRoute.format) ? true : false);
+	if (inDeviceWidgets.find(inRoute.source) == inDeviceWidgets.end())
+		{SRFAIL("Source widget " << ::NTV2WidgetIDToString(inRoute.source) << " not on device");  return false;}
+	const NTV2WidgetID sinkWidget (DeviceWidgetForInput(inDeviceWidgets, inRoute.sink));
+	if (sinkWidget == NTV2_WIDGET_INVALID)
+		{SRFAIL("Sink " << ::NTV2InputCrosspointIDToString(inRoute.sink) << " not on device");  return false;}
+	if (inOutConnections.find(inRoute.sink) != inOutConnections.end())
+		{SRFAIL("Sink " << ::NTV2InputCrosspointIDToString(inRoute.sink) << " already used by another route");	return false;}
+
+	//	Which color space leaves the source?  Pick the source's first (primary) output of that color space...
+	const bool srcIsFrameStore (CNTV2SignalRouter::WidgetIDToType(inRoute.source) == NTV2WidgetType_FrameStore);
+	const bool srcWantRGB (srcIsFrameStore && fmtIsRGB);
+	NTV2OutputXptIDSet srcOutputs;
+	CNTV2SignalRouter::GetWidgetOutputs (inRoute.source, srcOutputs);
+	NTV2OutputXptID srcXpt (NTV2_OUTPUT_CROSSPOINT_INVALID);
+	for (NTV2OutputXptIDSetConstIter it(srcOutputs.begin());  it != srcOutputs.end()  &&  srcXpt == NTV2_OUTPUT_CROSSPOINT_INVALID;	++it)
+		if ((NTV2_IS_RGB_OutputCrosspointID(*it) ? true : false) == srcWantRGB)
+			srcXpt = *it;
+	if (srcXpt == NTV2_OUTPUT_CROSSPOINT_INVALID  &&  !srcOutputs.empty())
+		srcXpt = *srcOutputs.begin();	//	Source only has the other color space
+	if (srcXpt == NTV2_OUTPUT_CROSSPOINT_INVALID)
+		{SRFAIL("Source widget " << ::NTV2WidgetIDToString(inRoute.source) << " has no outputs");	return false;}
+	const bool srcIsRGB (NTV2_IS_RGB_OutputCrosspointID(srcXpt) ? true : false);
+
+	//	Which color space must arrive at the sink?
+	const NTV2WidgetType sinkType (CNTV2SignalRouter::WidgetIDToType(sinkWidget));
+	bool sinkIsRGB (srcIsRGB);	//	By default, no conversion
+	if (CNTV2SignalRouter::IsRGBOnlyInputXpt(inRoute.sink))
+		sinkIsRGB = true;
+	else if (CNTV2SignalRouter::IsYUVOnlyInputXpt(inRoute.sink)	 ||	 CNTV2SignalRouter::IsSDIOutputWidgetType(sinkType))
+		sinkIsRGB = false;
+	else if (sinkType == NTV2WidgetType_FrameStore)
+		sinkIsRGB = fmtIsRGB;
+
+	//	Direct connection?
+	if (srcIsRGB == sinkIsRGB  &&  CanFeed(inRoute.sink, srcXpt, inPossible))
+		{inOutConnections[inRoute.sink] = srcXpt;	return true;}
+
+	//	Insert a free CSC -- try the one on the source's channel first...
+	const NTV2Channel srcChannel (CNTV2SignalRouter::WidgetIDToChannel(inRoute.source));
+	vector<NTV2WidgetID> cscs;
+	for (NTV2WidgetIDSetConstIter it(inDeviceWidgets.begin());	it != inDeviceWidgets.end();  ++it)
+		if (CNTV2SignalRouter::WidgetIDToType(*it) == NTV2WidgetType_CSC)
+		{
+			if (CNTV2SignalRouter::WidgetIDToChannel(*it) == srcChannel)
+				cscs.insert(cscs.begin(), *it);
+			else
+				cscs.push_back(*it);
+		}
+	for (size_t ndx(0);	 ndx < cscs.size();	 ndx++)
+	{
+		const NTV2Channel		cscChannel	(CNTV2SignalRouter::WidgetIDToChannel(cscs[ndx]));
+		const NTV2InputXptID	cscInput	(::GetCSCInputXptFromChannel(cscChannel));
+		const NTV2OutputXptID	cscOutput	(::GetCSCOutputXptFromChannel(cscChannel, false/*isKey*/, sinkIsRGB));
+		NTV2XptConnectionsConstIter cscIt(inOutConnections.find(cscInput));
+		if (cscIt != inOutConnections.end()  &&  cscIt->second != srcXpt)
+			continue;	//	In use by another route (if it's fed from the same source, share it)
+		if (!CanFeed(cscInput, srcXpt, inPossible)	||	!CanFeed(inRoute.sink, cscOutput, inPossible))
+			continue;
+		inOutConnections[cscInput] = srcXpt;
+		inOutConnections[inRoute.sink] = cscOutput;
+		return true;
+	}
+	SRFAIL("No route from " << ::NTV2WidgetIDToString(inRoute.source) << " to " << ::NTV2InputCrosspointIDToString(inRoute.sink)
+			<< " as " << (sinkIsRGB ? "RGB" : "YUV"));
+	return false;
+}
+
+
+bool CNTV2SignalRouter::SolveRoute (const NTV2DeviceID inDeviceID,
+									const NTV2RouteConstraints & inConstraints,
+									NTV2XptConnections & outConnections,
+									const NTV2PossibleConnections & inPossible)	//	STATIC
+{
+	outConnections.clear();
+	NTV2WidgetIDSet widgetIDs;
+	if (!GetWidgetIDs (inDeviceID, widgetIDs))
+		{SRFAIL("No widgets for '" << ::NTV2DeviceIDToString(inDeviceID) << "'");  return false;}
+	for (NTV2RouteConstraintsConstIter it(inConstraints.begin());  it != inConstraints.end();  ++it)
+		if (!SolveOneRoute (widgetIDs, *it, inPossible, outConnections))
+			{outConnections.clear();  return false;}
+	SRDBG(inConstraints.size() << " route(s) for '" << ::NTV2DeviceIDToString(inDeviceID) << "': " << outConnections);
+	return true;
+}
+
+
 bool CNTV2SignalRouter::CreateFromString (const string & inString, NTV2XptConnections & outConnections) //	STATIC
 {
 	NTV2StringList	lines;
@@ -0,0 +1,398 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2streamring.cpp
+	@brief		Implementation of the NTV2StreamRing class.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+#include "ntv2streamring.h"
+#include "ntv2utils.h"
+#include "ajabase/system/atomic.h"
+#include "ajabase/system/debug.h"
+#include "ajabase/system/memory.h"
+#include "ajabase/system/systemtime.h"
+#include <iomanip>
+
+using namespace std;
+
+#define	INSTP(_p_)			xHEX0N(uint64_t(_p_),16)
+#define	SRFAIL(__x__)		AJA_sERROR	(AJA_DebugUnit_Stream, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	SRWARN(__x__)		AJA_sWARNING(AJA_DebugUnit_Stream, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	SRINFO(__x__)		AJA_sINFO	(AJA_DebugUnit_Stream, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+#define	SRDBG(__x__)		AJA_sDEBUG	(AJA_DebugUnit_Stream, INSTP(this) << "::" << AJAFUNC << ": " << __x__)
+
+#define	NTV2_STREAMRING_LATENCY_BIN		500		//	Latency histogram bin width, in microseconds
+#define	NTV2_STREAMRING_LATENCY_BINS	1000	//	Latency histogram bin count (up to 500 ms)
+#define	NTV2_STREAMRING_START_WAITS		10		//	Max stream events to wait for the preroll buffer to go idle
+
+
+//////////////////////////////////////////	NTV2StreamRing::IndexQueue
+
+void NTV2StreamRing::IndexQueue::Reset (const ULWord inCapacity)
+{
+	mSlots.assign(inCapacity, 0);
+	mHead = mTail = 0;
+}
+
+bool NTV2StreamRing::IndexQueue::Push (const ULWord inIndex)
+{
+	if (mSlots.empty())
+		return false;
+	uint32_t volatile * pSlot (&mSlots[mTail]);
+	if (*pSlot)
+		return false;	//	Full -- the consumer hasn't taken this slot yet
+	AJAAtomic::Exchange(pSlot, uint32_t(inIndex + 1));
+	mTail = (mTail + 1) % ULWord(mSlots.size());
+	return true;
+}
+
+bool NTV2StreamRing::IndexQueue::Pop (ULWord & outIndex)
+{
+	if (mSlots.empty())
+		return false;
+	const uint32_t slot (AJAAtomic::Exchange(&mSlots[mHead], uint32_t(0)));
+	if (!slot)
+		return false;	//	Empty
+	outIndex = ULWord(slot - 1);
+	mHead = (mHead + 1) % ULWord(mSlots.size());
+	return true;
+}
+
+
+//////////////////////////////////////////	NTV2StreamRing
+
+NTV2StreamRing::NTV2StreamRing (CNTV2Card & inDevice, const NTV2Channel inChannel, const NTV2Mode inMode)
+	:	mDevice			(inDevice),
+		mChannel		(inChannel),
+		mMode			(inMode),
+		mTargetDepth	(0),
+		mQueueDepth		(0),
+		mRunning		(false),
+		mAutoService	(true),
+		mStarving		(false)
+{
+	mFree.Reset(0);
+	mReturned.Reset(0);
+	mReady.Reset(0);
+	ResetStats();
+}
+
+NTV2StreamRing::~NTV2StreamRing ()
+{
+	Close();
+}
+
+bool NTV2StreamRing::Open (const ULWord inNumBuffers, const ULWord inBufferBytes, const ULWord inTargetDepth)
+{
+	if (IsOpen())
+		{SRFAIL("Already open");  return false;}
+	if (!mDevice.IsOpen())
+		{SRFAIL("Device not open");  return false;}
+	if (!NTV2_IS_VALID_CHANNEL(mChannel)  ||  (mMode != NTV2_MODE_CAPTURE  &&  mMode != NTV2_MODE_DISPLAY))
+		{SRFAIL("Bad channel " << DEC(mChannel) << " or mode " << DEC(mMode));  return false;}
+	if (inNumBuffers < 2  ||  !inBufferBytes  ||  inTargetDepth >= inNumBuffers)
+		{SRFAIL("Bad buffer count " << DEC(inNumBuffers) << ", size " << DEC(inBufferBytes) << " or target depth " << DEC(inTargetDepth));  return false;}
+
+	//	Take ownership of the stream, putting it in a known state...
+	if (mDevice.StreamChannelInitialize(mChannel) != NTV2_STREAM_STATUS_SUCCESS)
+		{SRFAIL("StreamChannelInitialize failed for channel " << DEC(mChannel+1));  return false;}
+
+	//	Frame-sized buffers go on huge pages (cheaper to lock, fewer TLB misses), near the card if it's on a NUMA host...
+	int numaNode(-1);
+	mDevice.GetNUMANode(numaNode);
+	const size_t hugePageSize(AJAMemory::GetHugePageSize());
+	const bool useHugePages(hugePageSize  &&  inBufferBytes >= hugePageSize);
+	mBuffers.resize(inNumBuffers);
+	for (ULWord ndx(0);  ndx < inNumBuffers;  ndx++)
+	{
+		NTV2Buffer & buffer (mBuffers.at(ndx));
+		const bool allocated (useHugePages  ||  numaNode >= 0
+								?  buffer.AllocateHugePages(inBufferBytes, useHugePages ? hugePageSize : NTV2Buffer::HostPageSize(), numaNode)
+								:  buffer.Allocate(inBufferBytes, /*pageAligned*/true));
+		if (!allocated)
+			{SRFAIL("Failed to allocate " << DEC(inBufferBytes) << "-byte buffer " << DEC(ndx));  Close();  return false;}
+		if (!mDevice.DMABufferLock(buffer, /*map*/true))
+			{SRFAIL("Failed to lock buffer " << DEC(ndx));  Close();  return false;}
+	}
+	mHeld.assign(inNumBuffers, false);
+	mFree.Reset(inNumBuffers);
+	mReturned.Reset(inNumBuffers);
+	mReady.Reset(inNumBuffers);
+	for (ULWord ndx(0);  ndx < inNumBuffers;  ndx++)
+		mFree.Push(ndx);
+	mTargetDepth = inTargetDepth ? inTargetDepth : (inNumBuffers > 2 ? inNumBuffers - 2 : 1);
+	mQueueDepth = 0;
+	mStarving = false;
+	ResetStats();
+	SRINFO("Opened " << (IsCapture() ? "capture" : "playout") << " ring on channel " << DEC(mChannel+1) << ": "
+			<< DEC(inNumBuffers) << " x " << DEC(inBufferBytes) << " bytes, " << DEC(mBuffers.front().GetPageSize()) << "-byte pages, NUMA node "
+			<< DEC(numaNode) << ", target depth " << DEC(mTargetDepth));
+	return true;
+}
+
+bool NTV2StreamRing::Start (void)
+{
+	if (!IsOpen())
+		{SRFAIL("Not open");  return false;}
+	if (mRunning)
+		return true;
+	NTV2StreamChannel strStatus;
+	if (IsCapture())
+	{
+		if (!Service())		//	Queues up to the target depth
+			return false;
+	}
+	else
+	{
+		if (!mQueueDepth)
+			SRWARN("Starting playout with nothing prerolled");
+		//	Stopping an initialized stream puts the first queued buffer on air;  wait for it to go idle, then start...
+		if (mDevice.StreamChannelStop(mChannel, strStatus) != NTV2_STREAM_STATUS_SUCCESS)
+			{SRFAIL("StreamChannelStop failed for channel " << DEC(mChannel+1));  return false;}
+		for (int waits(0);  waits < NTV2_STREAMRING_START_WAITS  &&  !strStatus.IsIdle();  waits++)
+			if (mDevice.StreamChannelWait(mChannel, strStatus) != NTV2_STREAM_STATUS_SUCCESS)
+				break;
+	}
+	if (mDevice.StreamChannelStart(mChannel, strStatus) != NTV2_STREAM_STATUS_SUCCESS)
+		{SRFAIL("StreamChannelStart failed for channel " << DEC(mChannel+1));  return false;}
+	mRunning = true;
+	SRDBG("Started with " << DEC(mQueueDepth) << " buffer(s) queued");
+	return true;
+}
+
+bool NTV2StreamRing::Stop (void)
+{
+	if (!IsOpen())
+		return false;
+	if (!mRunning)
+		return true;
+	mRunning = false;
+	NTV2StreamChannel strStatus;
+	if (mDevice.StreamChannelStop(mChannel, strStatus) != NTV2_STREAM_STATUS_SUCCESS)
+		{SRFAIL("StreamChannelStop failed for channel " << DEC(mChannel+1));  return false;}
+	return true;
+}
+
+void NTV2StreamRing::Close (void)
+{
+	if (mBuffers.empty())
+		return;
+	mRunning = false;
+	if (mDevice.IsOpen())
+	{
+		mDevice.StreamChannelInitialize(mChannel);		//	Stops the stream and releases the queue
+		NTV2StreamBuffer bfrStatus;
+		while (mDevice.StreamBufferRelease(mChannel, bfrStatus) == NTV2_STREAM_STATUS_SUCCESS)
+			;
+		mDevice.StreamChannelRelease(mChannel);
+		for (size_t ndx(0);  ndx < mBuffers.size();  ndx++)
+			if (!mBuffers.at(ndx).IsNULL())
+				mDevice.DMABufferUnlock(mBuffers.at(ndx));
+	}
+	mBuffers.clear();
+	mHeld.clear();
+	mFree.Reset(0);
+	mReturned.Reset(0);
+	mReady.Reset(0);
+	mTargetDepth = mQueueDepth = 0;
+	SRINFO("Closed channel " << DEC(mChannel+1));
+}
+
+NTV2Buffer * NTV2StreamRing::AcquireBuffer (const ULWord inTimeoutMs)
+{
+	if (!IsOpen())
+		return AJA_NULL;
+	IndexQueue & queue (IsCapture() ? mReady : mFree);
+	const uint64_t deadline (AJATime::GetSystemMilliseconds() + inTimeoutMs);
+	do
+	{
+		//	Playout holds off while the driver queue is full, so the application paces itself to the stream...
+		ULWord ndx(0);
+		bool gotOne ((IsCapture() || mQueueDepth < mTargetDepth)  &&  queue.Pop(ndx));
+		if (!gotOne  &&  mAutoService  &&  Service())
+			gotOne = (IsCapture() || mQueueDepth < mTargetDepth)  &&  queue.Pop(ndx);
+		if (gotOne)
+		{
+			mHeld.at(ndx) = true;
+			return &mBuffers.at(ndx);
+		}
+		if (!inTimeoutMs)
+			break;
+		//	Nothing yet -- wait for the next stream event...
+		if (mAutoService)
+			WaitAndService();
+		else
+		{
+			NTV2StreamChannel strStatus;
+			mDevice.StreamChannelWait(mChannel, strStatus);
+		}
+	} while (AJATime::GetSystemMilliseconds() < deadline);
+	return AJA_NULL;
+}
+
+bool NTV2StreamRing::SubmitBuffer (NTV2Buffer * pInBuffer)
+{
+	ULWord ndx(0);
+	if (!IndexOf(pInBuffer, ndx))
+		{SRFAIL("Buffer " << INSTP(pInBuffer) << " isn't mine");  return false;}
+	if (!mHeld.at(ndx))
+		{SRFAIL("Buffer " << DEC(ndx) << " wasn't acquired");  return false;}
+	if (IsCapture())
+	{	//	Hand it back to Service, which may be running on another thread, to be queued...
+		mHeld.at(ndx) = false;
+		mReturned.Push(ndx);	//	Can't fail:  there's a slot for every buffer
+		return mAutoService ? Service() : true;
+	}
+	if (!QueueToDriver(ndx))
+		return false;	//	Still held by the caller
+	mHeld.at(ndx) = false;
+	return true;
+}
+
+bool NTV2StreamRing::Service (void)
+{
+	if (!IsOpen())
+		return false;
+	if (!ReleaseFromDriver())
+		return false;
+	if (!IsCapture())
+		return true;
+
+	//	Capture:  collect the buffers the application handed back...
+	ULWord ndx(0);
+	while (mReturned.Pop(ndx))
+		mFree.Push(ndx);
+
+	//	...and keep the driver queue topped up...
+	while (mQueueDepth < mTargetDepth)
+	{
+		if (!mFree.Pop(ndx))
+			break;	//	The application holds the rest
+		if (!QueueToDriver(ndx))
+		{
+			mFree.Push(ndx);	//	In capture, only this thread touches the free list, so this can't fail
+			return false;
+		}
+	}
+
+	//	Count each dry spell once, not every Service call during it...
+	const bool starving (mRunning  &&  !mQueueDepth);
+	if (starving  &&  !mStarving)
+	{
+		AJAAutoLock autoLock(&mStatsLock);
+		mStats.fStarved++;
+	}
+	mStarving = starving;
+	return true;
+}
+
+bool NTV2StreamRing::WaitAndService (void)
+{
+	if (!IsOpen())
+		return false;
+	NTV2StreamChannel strStatus;
+	if (mDevice.StreamChannelWait(mChannel, strStatus) != NTV2_STREAM_STATUS_SUCCESS)
+		return false;
+	return Service();
+}
+
+bool NTV2StreamRing::QueueToDriver (const ULWord inIndex)
+{
+	//	Count it first, in case another thread's Service releases it before StreamBufferQueue returns...
+	const ULWord depth (AJAAtomic::Increment(&mQueueDepth));
+	NTV2StreamBuffer bfrStatus;
+	if (mDevice.StreamBufferQueue(mChannel, mBuffers.at(inIndex), ULWord64(inIndex), bfrStatus) != NTV2_STREAM_STATUS_SUCCESS)
+	{
+		AJAAtomic::Decrement(&mQueueDepth);
+		SRFAIL("StreamBufferQueue failed for buffer " << DEC(inIndex) << ", status " << xHEX0N(bfrStatus.mStatus,8));
+		return false;
+	}
+	AJAAutoLock autoLock(&mStatsLock);
+	mStats.fQueued++;
+	if (depth > mStats.fMaxQueueDepth)
+		mStats.fMaxQueueDepth = depth;
+	return true;
+}
+
+bool NTV2StreamRing::ReleaseFromDriver (void)
+{
+	NTV2StreamBuffer bfrStatus;
+	while (mDevice.StreamBufferRelease(mChannel, bfrStatus) == NTV2_STREAM_STATUS_SUCCESS)
+	{
+		const ULWord ndx (ULWord(bfrStatus.mBufferCookie));
+		if (ndx >= GetBufferCount())
+			{SRFAIL("Released buffer has bad cookie " << bfrStatus.mBufferCookie);  return false;}
+		const ULWord depth (AJAAtomic::Decrement(&mQueueDepth));
+		const bool completed ((bfrStatus.mBufferState & NTV2_STREAM_BUFFER_STATE_COMPLETED)  &&  !(bfrStatus.mBufferState & NTV2_STREAM_BUFFER_STATE_FLUSHED));
+		{
+			AJAAutoLock autoLock(&mStatsLock);
+			if (completed)
+			{
+				mStats.fCompleted++;
+				if (bfrStatus.mCompleteTime > bfrStatus.mQueueTime  &&  bfrStatus.mQueueTime)
+					mStats.fLatency.Add((bfrStatus.mCompleteTime - bfrStatus.mQueueTime) / 10);	//	100ns units to microseconds
+			}
+			else
+				mStats.fFlushed++;
+			if (mRunning  &&  depth < mStats.fMinQueueDepth)
+				mStats.fMinQueueDepth = depth;
+		}
+		if (IsCapture()  &&  completed)
+			mReady.Push(ndx);	//	Can't fail:  there's a slot for every buffer
+		else
+			mFree.Push(ndx);
+	}
+	return true;
+}
+
+bool NTV2StreamRing::IndexOf (const NTV2Buffer * pInBuffer, ULWord & outIndex) const
+{
+	if (!pInBuffer  ||  mBuffers.empty())
+		return false;
+	const NTV2Buffer * pFirst (&mBuffers.front());
+	if (pInBuffer < pFirst  ||  pInBuffer > &mBuffers.back())
+		return false;
+	outIndex = ULWord(pInBuffer - pFirst);
+	return true;
+}
+
+bool NTV2StreamRing::GetStats (NTV2StreamRingStats & outStats) const
+{
+	{
+		AJAAutoLock autoLock(&mStatsLock);
+		outStats = mStats;
+	}
+	outStats.fQueueDepth = mQueueDepth;
+	if (!outStats.fQueued  ||  outStats.fMinQueueDepth > outStats.fMaxQueueDepth)
+		outStats.fMinQueueDepth = 0;
+	if (!IsOpen())
+		return true;
+	NTV2StreamChannel strStatus;
+	if (mDevice.StreamChannelStatus(mChannel, strStatus) != NTV2_STREAM_STATUS_SUCCESS)
+		return false;
+	outStats.fRepeated = strStatus.mRepeatCount;
+	return true;
+}
+
+void NTV2StreamRing::ResetStats (void)
+{
+	AJAAutoLock autoLock(&mStatsLock);
+	mStats.fQueued = mStats.fCompleted = mStats.fFlushed = mStats.fStarved = mStats.fRepeated = 0;
+	mStats.fQueueDepth = mStats.fMaxQueueDepth = 0;
+	mStats.fMinQueueDepth = 0xFFFFFFFF;
+	mStats.fLatency = NTV2TimingHistogram(0, NTV2_STREAMRING_LATENCY_BIN, NTV2_STREAMRING_LATENCY_BINS);
+}
+
+ostream & NTV2StreamRing::Print (ostream & oss) const
+{
+	NTV2StreamRingStats stats;
+	GetStats(stats);
+	oss << (IsCapture() ? "Capture" : "Playout") << " ring ch" << DEC(mChannel+1)
+		<< ": " << DEC(GetBufferCount()) << " buffers, depth " << DEC(stats.fQueueDepth) << "/" << DEC(mTargetDepth)
+		<< " (min " << DEC(stats.fMinQueueDepth) << " max " << DEC(stats.fMaxQueueDepth) << ")"
+		<< ", queued " << DEC(stats.fQueued) << ", completed " << DEC(stats.fCompleted)
+		<< ", flushed " << DEC(stats.fFlushed) << ", starved " << DEC(stats.fStarved) << ", repeated " << DEC(stats.fRepeated);
+	if (stats.fLatency.GetCount())
+		oss << ", latency " << DEC(stats.fLatency.GetMin()) << "/" << DEC(int64_t(stats.fLatency.GetMean() + 0.5))
+			<< "/" << DEC(stats.fLatency.GetMax()) << " us min/avg/max";
+	return oss;
+}
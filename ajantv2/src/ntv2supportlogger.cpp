@@ -12,9 +12,14 @@
 #include "ntv2registersmb.h"
 #include "ntv2rp188.h"
 #include "ajabase/common/common.h"
+#include "ajabase/common/circularbuffer.h"
 #include "ajabase/persistence/persistence.h"
 #include "ajabase/system/info.h"
+#include "ajabase/system/systemtime.h"
+#include "ajabase/system/thread.h"
 #include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <sstream>
 #include <vector>
 #include <iterator>
@@ -1097,6 +1102,164 @@ string CNTV2SupportLogger::InventLogFilePathAndName (CNTV2Card & inDevice, const
 }
 
 bool CNTV2SupportLogger::DumpDeviceSDRAM (CNTV2Card & inDevice, const string & inFilePath, ostream & msgStrm)
+{
+	return DumpDeviceSDRAM (inDevice, inFilePath, msgStrm, false);
+}
+
+
+//	Compressed SDRAM dump file layout (all values little-endian ULWords):
+//		"NTV2SDRZ" signature, frame byte count, frame count, then for each frame:
+//		frame number, encoded byte count, encoded data.
+//	Encoded data is a sequence of tokens:  if bit 31 is set, the ULWord that follows is repeated (token & 0x7FFFFFFF)
+//	times;  otherwise "token" literal ULWords follow.
+static const char		kSDRAMDumpSignature[]	= "NTV2SDRZ";
+static const size_t		kSDRAMDumpSignatureSize	= 8;
+static const ULWord		kSDRAMDumpRunFlag		= 0x80000000;
+static const ULWord		kSDRAMDumpMinRun		= 4;		//	Shorter runs are cheaper as literals
+
+static void EncodeSDRAMFrame (const ULWord * pInWords, const ULWord inNumWords, vector<ULWord> & outEncoded)
+{
+	outEncoded.clear();
+	ULWord ndx(0), literalStart(0);
+	while (ndx < inNumWords)
+	{
+		ULWord runEnd(ndx + 1);
+		while (runEnd < inNumWords  &&  pInWords[runEnd] == pInWords[ndx]  &&  runEnd - ndx < ~kSDRAMDumpRunFlag)
+			runEnd++;
+		if (runEnd - ndx < kSDRAMDumpMinRun)
+			{ndx = runEnd;  continue;}
+		if (ndx > literalStart)
+		{	//	Flush pending literals
+			outEncoded.push_back(ndx - literalStart);
+			outEncoded.insert(outEncoded.end(), pInWords + literalStart, pInWords + ndx);
+		}
+		outEncoded.push_back(kSDRAMDumpRunFlag | (runEnd - ndx));
+		outEncoded.push_back(pInWords[ndx]);
+		ndx = literalStart = runEnd;
+	}
+	if (inNumWords > literalStart)
+	{
+		outEncoded.push_back(inNumWords - literalStart);
+		outEncoded.insert(outEncoded.end(), pInWords + literalStart, pInWords + inNumWords);
+	}
+}
+
+static bool DecodeSDRAMFrame (const vector<ULWord> & inEncoded, ULWord * pOutWords, const ULWord inNumWords)
+{
+	ULWord outNdx(0);
+	for (size_t ndx(0);  ndx < inEncoded.size();  )
+	{
+		const ULWord token(inEncoded[ndx++]),  count(token & ~kSDRAMDumpRunFlag);
+		if (count > inNumWords - outNdx)
+			return false;
+		if (token & kSDRAMDumpRunFlag)
+		{
+			if (ndx >= inEncoded.size())
+				return false;
+			const ULWord value(inEncoded[ndx++]);
+			for (ULWord n(0);  n < count;  n++)
+				pOutWords[outNdx++] = value;
+		}
+		else
+		{
+			if (count > inEncoded.size() - ndx)
+				return false;
+			::memcpy(pOutWords + outNdx, &inEncoded[ndx], count * sizeof(ULWord));
+			outNdx += count;
+			ndx += count;
+		}
+	}
+	return outNdx == inNumWords;
+}
+
+static bool WriteSDRAMDumpWord (ofstream & ofs, const ULWord inValue)
+{
+	const ULWord value(NTV2EndianSwap32HtoL(inValue));
+	return ofs.write(reinterpret_cast<const char*>(&value), streamsize(sizeof(value))).good();
+}
+
+static bool ReadSDRAMDumpWord (ifstream & ifs, ULWord & outValue)
+{
+	ULWord value(0);
+	if (!ifs.read(reinterpret_cast<char*>(&value), streamsize(sizeof(value))).good())
+		return false;
+	outValue = NTV2EndianSwap32LtoH(value);
+	return true;
+}
+
+static bool ZeroFillSDRAMFrames (ofstream & ofs, NTV2Buffer & zeroes, const ULWord inByteCount, const ULWord inNumFrames)
+{
+	if (inNumFrames  &&  zeroes.IsNULL()  &&  (!zeroes.Allocate(inByteCount)  ||  !zeroes.Fill(ULWord(0))))
+		return false;
+	for (ULWord ndx(0);  ndx < inNumFrames;  ndx++)
+		if (!ofs.write(zeroes, streamsize(inByteCount)).good())
+			return false;
+	return true;
+}
+
+typedef struct SDRAMDumpFrame
+{
+	NTV2Buffer	fBuffer;
+	ULWord		fFrameNdx;
+	bool		fDMAOK;
+	bool		fLast;		///< @brief	End-of-dump sentinel
+} SDRAMDumpFrame;
+
+typedef struct SDRAMDumpWriter
+{
+	AJACircularBuffer<SDRAMDumpFrame*> *	fpRing;
+	ofstream *			fpFile;
+	bool				fCompress;
+	NTV2ULWordVector	fGoodFrames;
+	NTV2ULWordVector	fBadWrites;
+	uint64_t			fBytesWritten;
+} SDRAMDumpWriter;
+
+static void SDRAMDumpWriterThread (AJAThread * pThread, void * pContext)
+{	(void) pThread;
+	SDRAMDumpWriter & writer (*reinterpret_cast<SDRAMDumpWriter*>(pContext));
+	vector<ULWord> encoded;
+	while (true)
+	{
+		SDRAMDumpFrame * pFrame (writer.fpRing->StartConsumeNextBuffer());
+		if (!pFrame)
+			break;
+		const bool isLast (pFrame->fLast);
+		if (!isLast  &&  pFrame->fDMAOK)
+		{
+			bool ok (true);
+			if (writer.fCompress)
+			{
+				EncodeSDRAMFrame(pFrame->fBuffer, pFrame->fBuffer.GetByteCount() / sizeof(ULWord), encoded);
+				const ULWord encodedBytes (ULWord(encoded.size() * sizeof(ULWord)));
+				if (NTV2HostIsBigEndian)
+					for (size_t ndx(0);  ndx < encoded.size();  ndx++)
+						encoded[ndx] = NTV2EndianSwap32HtoL(encoded[ndx]);
+				ok = WriteSDRAMDumpWord(*writer.fpFile, pFrame->fFrameNdx)
+					&&  WriteSDRAMDumpWord(*writer.fpFile, encodedBytes)
+					&&  (encoded.empty()  ||  writer.fpFile->write(reinterpret_cast<const char*>(&encoded[0]), streamsize(encodedBytes)).good());
+				if (ok)
+					writer.fBytesWritten += 2 * sizeof(ULWord) + encodedBytes;
+			}
+			else
+			{
+				ok = writer.fpFile->write(pFrame->fBuffer, streamsize(pFrame->fBuffer.GetByteCount())).good();
+				if (ok)
+					writer.fBytesWritten += pFrame->fBuffer.GetByteCount();
+			}
+			if (ok)
+				writer.fGoodFrames.push_back(pFrame->fFrameNdx);
+			else
+				writer.fBadWrites.push_back(pFrame->fFrameNdx);
+		}
+		writer.fpRing->EndConsumeNextBuffer();
+		if (isLast)
+			break;
+	}
+}
+
+bool CNTV2SupportLogger::DumpDeviceSDRAM (CNTV2Card & inDevice, const string & inFilePath, ostream & msgStrm,
+											const bool inCompress, const UWord inNumBuffers)
 {
 	if (!inDevice.IsOpen())
 		return false;
@@ -1105,32 +1268,133 @@ bool CNTV2SupportLogger::DumpDeviceSDRAM (CNTV2Card & inDevice, const string & i
 	NTV2Framesize frmsz(NTV2_FRAMESIZE_INVALID);
 	const ULWord maxBytes(::NTV2DeviceGetActiveMemorySize(inDevice.GetDeviceID()));
 	inDevice.GetFrameBufferSize(NTV2_CHANNEL1, frmsz);
-	const ULWord byteCount(::NTV2FramesizeToByteCount(frmsz)), megs(byteCount/1024/1024), numFrames(maxBytes / byteCount);
-	NTV2Buffer buffer(byteCount);
-	NTV2ULWordVector goodFrames, badDMAs, badWrites;
+	const ULWord byteCount(::NTV2FramesizeToByteCount(frmsz));
+	if (!byteCount)
+		{msgStrm << "## ERROR: Unable to determine frame size" << endl;	return false;}
+	const ULWord megs(byteCount/1024/1024), numFrames(maxBytes / byteCount);
+	const UWord numBuffers(inNumBuffers < 2 ? 2 : (inNumBuffers > 8 ? 8 : inNumBuffers));
+	NTV2ULWordVector badDMAs;
 	ofstream ofs(inFilePath.c_str(), ofstream::out | ofstream::binary);
 	if (!ofs)
 		{msgStrm << "## ERROR: Unable to open '" << inFilePath << "' for writing" << endl;	return false;}
+	if (inCompress)
+	{
+		ofs.write(kSDRAMDumpSignature, streamsize(kSDRAMDumpSignatureSize));
+		if (!WriteSDRAMDumpWord(ofs, byteCount)  ||  !WriteSDRAMDumpWord(ofs, numFrames))
+			{msgStrm << "## ERROR: Unable to write '" << inFilePath << "'" << endl;	return false;}
+	}
 
-	for (ULWord frameNdx(0);  frameNdx < numFrames;	 frameNdx++)
+	//	Allocate the pipeline frames...
+	vector<SDRAMDumpFrame> frames(numBuffers);
+	AJACircularBuffer<SDRAMDumpFrame*> ring;
+	for (UWord ndx(0);  ndx < numBuffers;  ndx++)
 	{
-		if (!inDevice.DMAReadFrame(frameNdx, buffer, byteCount, NTV2_CHANNEL1))
-			{badDMAs.push_back(frameNdx);  continue;}
-		if (!ofs.write(buffer, streamsize(buffer.GetByteCount())).good())
-			{badWrites.push_back(frameNdx);	 continue;}
-		goodFrames.push_back(frameNdx);
+		if (!frames[ndx].fBuffer.Allocate(byteCount, /*pageAligned*/true))
+			{msgStrm << "## ERROR: Unable to allocate " << DEC(megs) << "MB buffer" << endl;	return false;}
+		ring.Add(&frames[ndx]);
+	}
+
+	//	The writer thread drains frames while this thread DMAs the next ones...
+	SDRAMDumpWriter writer;
+	writer.fpRing = &ring;
+	writer.fpFile = &ofs;
+	writer.fCompress = inCompress;
+	writer.fBytesWritten = 0;
+	AJAThread writerThread;
+	if (AJA_FAILURE(writerThread.Attach(SDRAMDumpWriterThread, &writer))  ||  AJA_FAILURE(writerThread.Start()))
+		{msgStrm << "## ERROR: Unable to start writer thread" << endl;	return false;}
+
+	const uint64_t startMS(AJATime::GetSystemMilliseconds());
+	uint64_t lastReportMS(startMS);
+	for (ULWord frameNdx(0);  frameNdx <= numFrames;  frameNdx++)
+	{
+		SDRAMDumpFrame * pFrame (ring.StartProduceNextBuffer());
+		if (!pFrame)
+			break;
+		const bool isLast (frameNdx == numFrames);
+		pFrame->fFrameNdx = frameNdx;
+		pFrame->fLast = isLast;
+		pFrame->fDMAOK = !isLast  &&  inDevice.DMAReadFrame(frameNdx, pFrame->fBuffer, byteCount, NTV2_CHANNEL1);
+		if (!isLast  &&  !pFrame->fDMAOK)
+			badDMAs.push_back(frameNdx);
+		ring.EndProduceNextBuffer();	//	Hand it to the writer
+
+		const uint64_t nowMS(AJATime::GetSystemMilliseconds());
+		if (!isLast  &&  nowMS - lastReportMS >= 1000)
+		{
+			const double mbRead (double(frameNdx + 1) * double(byteCount) / 1024.0 / 1024.0);
+			msgStrm << "## NOTE: " << DEC(frameNdx + 1) << " of " << DEC(numFrames) << " frames, "
+					<< fDEC(mbRead, 1, 0) << "MB read, " << fDEC(mbRead * 1000.0 / double(nowMS - startMS), 1, 1) << "MB/s" << endl;
+			lastReportMS = nowMS;
+		}
 	}	//	for each frame
+	writerThread.Stop();	//	Returns once the writer has drained the pipeline
+	ofs.close();
+	const uint64_t elapsedMS(AJATime::GetSystemMilliseconds() - startMS);
+
 	if (!badDMAs.empty())
 	{
 		msgStrm << "## ERROR: DMARead failed for " << DEC(badDMAs.size()) << " " << DEC(megs) << "MB frame(s): ";
 		::NTV2PrintULWordVector(badDMAs, msgStrm); msgStrm << endl;
 	}
-	if (!badWrites.empty())
+	if (!writer.fBadWrites.empty())
+	{
+		msgStrm << "## ERROR: Write failures for " << DEC(writer.fBadWrites.size()) << " " << DEC(megs) << "MB frame(s): ";
+		::NTV2PrintULWordVector(writer.fBadWrites, msgStrm); msgStrm << endl;
+	}
+	const double mbDumped (double(writer.fGoodFrames.size()) * double(byteCount) / 1024.0 / 1024.0);
+	msgStrm << "## NOTE: " << DEC(writer.fGoodFrames.size()) << " x " << DEC(megs) << "MB frames from device '"
+						<< CNTV2DeviceScanner::GetDeviceRefName(inDevice) << "' written to '" << inFilePath << "' in "
+						<< fDEC(double(elapsedMS) / 1000.0, 1, 1) << " secs (" << fDEC(elapsedMS ? mbDumped * 1000.0 / double(elapsedMS) : 0.0, 1, 1) << "MB/s)";
+	if (inCompress  &&  writer.fBytesWritten)
+		msgStrm << ", compressed " << fDEC(mbDumped * 1024.0 * 1024.0 / double(writer.fBytesWritten), 1, 1) << ":1";
+	msgStrm << endl;
+	return true;
+}
+
+bool CNTV2SupportLogger::ExpandDeviceSDRAMDump (const string & inDumpPath, const string & inRawPath, ostream & msgStrm)
+{
+	ifstream ifs(inDumpPath.c_str(), ifstream::in | ifstream::binary);
+	if (!ifs)
+		{msgStrm << "## ERROR: Unable to open '" << inDumpPath << "' for reading" << endl;	return false;}
+	char signature[kSDRAMDumpSignatureSize];
+	ULWord byteCount(0), numFrames(0);
+	if (!ifs.read(signature, streamsize(kSDRAMDumpSignatureSize)).good()
+		||  ::memcmp(signature, kSDRAMDumpSignature, kSDRAMDumpSignatureSize)
+		||  !ReadSDRAMDumpWord(ifs, byteCount)  ||  !ReadSDRAMDumpWord(ifs, numFrames)
+		||  !byteCount  ||  byteCount % sizeof(ULWord))
+			{msgStrm << "## ERROR: '" << inDumpPath << "' is not a compressed SDRAM dump" << endl;	return false;}
+	ofstream ofs(inRawPath.c_str(), ofstream::out | ofstream::binary);
+	if (!ofs)
+		{msgStrm << "## ERROR: Unable to open '" << inRawPath << "' for writing" << endl;	return false;}
+
+	NTV2Buffer frame(byteCount), zeroes;
+	vector<ULWord> encoded;
+	ULWord frameNdx(0), encodedBytes(0), framesExpanded(0), nextFrameNdx(0);
+	while (ReadSDRAMDumpWord(ifs, frameNdx))
 	{
-		msgStrm << "## ERROR: Write failures for " << DEC(badWrites.size()) << " " << DEC(megs) << "MB frame(s): ";
-		::NTV2PrintULWordVector(badWrites, msgStrm); msgStrm << endl;
+		if (!ReadSDRAMDumpWord(ifs, encodedBytes)  ||  encodedBytes % sizeof(ULWord)  ||  encodedBytes > byteCount * 2
+			||  frameNdx < nextFrameNdx  ||  frameNdx >= numFrames)
+				{msgStrm << "## ERROR: Bad frame header at frame " << DEC(frameNdx) << " in '" << inDumpPath << "'" << endl;	return false;}
+		//	Zero-fill frames that DumpDeviceSDRAM omitted (DMA failures), so each frame lands at frameNdx * byteCount...
+		if (!ZeroFillSDRAMFrames(ofs, zeroes, byteCount, frameNdx - nextFrameNdx))
+			{msgStrm << "## ERROR: Unable to write '" << inRawPath << "'" << endl;	return false;}
+		nextFrameNdx = frameNdx + 1;
+		encoded.resize(encodedBytes / sizeof(ULWord));
+		if (encodedBytes  &&  !ifs.read(reinterpret_cast<char*>(&encoded[0]), streamsize(encodedBytes)).good())
+			{msgStrm << "## ERROR: Truncated frame " << DEC(frameNdx) << " in '" << inDumpPath << "'" << endl;	return false;}
+		if (NTV2HostIsBigEndian)
+			for (size_t ndx(0);  ndx < encoded.size();  ndx++)
+				encoded[ndx] = NTV2EndianSwap32LtoH(encoded[ndx]);
+		if (!DecodeSDRAMFrame(encoded, frame, byteCount / sizeof(ULWord)))
+			{msgStrm << "## ERROR: Corrupt frame " << DEC(frameNdx) << " in '" << inDumpPath << "'" << endl;	return false;}
+		if (!ofs.write(frame, streamsize(byteCount)).good())
+			{msgStrm << "## ERROR: Unable to write '" << inRawPath << "'" << endl;	return false;}
+		framesExpanded++;
 	}
-	msgStrm << "## NOTE: " << DEC(goodFrames.size()) << " x " << DEC(megs) << "MB frames from device '"
-						<< CNTV2DeviceScanner::GetDeviceRefName(inDevice) << "' written to '" << inFilePath << "'" << endl;
+	if (!ZeroFillSDRAMFrames(ofs, zeroes, byteCount, numFrames - nextFrameNdx))	//	Trailing omitted frames
+		{msgStrm << "## ERROR: Unable to write '" << inRawPath << "'" << endl;	return false;}
+	msgStrm << "## NOTE: " << DEC(framesExpanded) << " of " << DEC(numFrames) << " frames expanded from '" << inDumpPath
+			<< "' to '" << inRawPath << "'" << endl;
 	return true;
 }
@@ -0,0 +1,533 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2timingrecorder.cpp
+	@brief		Implementation of the CNTV2TimingRecorder, NTV2TimingHistogram and NTV2ScopedTimer classes.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+#include "ntv2timingrecorder.h"
+#include "ntv2utils.h"
+#include <cmath>
+#include <iomanip>
+#include <set>
+
+using namespace std;
+
+#define	NTV2_TIMING_MAX_COOKIES		256			//	Output frames remembered for output latency & loopback
+#define	NTV2_TIMING_COUNTER_MARKER	0xA5C3		//	Marks a frame counter encoded by EncodeFrameCounter
+#define	NTV2_TIMING_COUNTER_BITS	48			//	Marker (16) + counter (32)
+#define	NTV2_TIMING_COUNTER_CELL	12			//	Pixels per bit (two 6-pixel groups for 10-bit YCbCr)
+#define	NTV2_TIMING_COUNTER_LINES	4			//	Lines the counter is repeated on
+
+
+string NTV2TimingMetricToString (const NTV2TimingMetric inMetric, const bool inCompact)
+{
+	switch (inMetric)
+	{
+		case NTV2_TIMING_CAPTURE_LATENCY:	return inCompact ? "captureLatency"	: "Capture Latency";
+		case NTV2_TIMING_DMA_DURATION:		return inCompact ? "dmaDuration"	: "DMA Duration";
+		case NTV2_TIMING_HOST_PROCESSING:	return inCompact ? "hostProcessing"	: "Host Processing";
+		case NTV2_TIMING_OUTPUT_LATENCY:	return inCompact ? "outputLatency"	: "Output Latency";
+		case NTV2_TIMING_VBI_JITTER:		return inCompact ? "vbiJitter"		: "VBI Jitter";
+		case NTV2_TIMING_END_TO_END:		return inCompact ? "endToEnd"		: "End-to-End Latency";
+		case NTV2_TIMING_NUM_METRICS:		break;
+	}
+	return "";
+}
+
+
+//////////////////////////////////////////	NTV2TimingHistogram
+
+NTV2TimingHistogram::NTV2TimingHistogram (const int64_t inMinValue, const int64_t inBinWidth, const ULWord inNumBins)
+	:	mMinValue	(inMinValue),
+		mBinWidth	(inBinWidth > 0 ? inBinWidth : 1),
+		mBins		(inNumBins ? inNumBins : 1, 0)
+{
+	Reset();
+}
+
+void NTV2TimingHistogram::Reset (void)
+{
+	mBins.assign(mBins.size(), 0);
+	mCount = 0;
+	mMin = mMax = 0;
+	mMean = mM2 = 0.0;
+}
+
+void NTV2TimingHistogram::Add (const int64_t inValue)
+{
+	mCount++;
+	if (mCount == 1  ||  inValue < mMin)
+		mMin = inValue;
+	if (mCount == 1  ||  inValue > mMax)
+		mMax = inValue;
+	//	Welford's running mean/variance...
+	const double delta (double(inValue) - mMean);
+	mMean += delta / double(mCount);
+	mM2 += delta * (double(inValue) - mMean);
+
+	int64_t bin ((inValue - mMinValue) / mBinWidth);
+	if (inValue < mMinValue)
+		bin = 0;
+	else if (bin >= int64_t(mBins.size()))
+		bin = int64_t(mBins.size()) - 1;
+	mBins[size_t(bin)]++;
+}
+
+double NTV2TimingHistogram::GetStdDev (void) const
+{
+	return mCount > 1 ? ::sqrt(mM2 / double(mCount - 1)) : 0.0;
+}
+
+int64_t NTV2TimingHistogram::GetPercentile (const double inPercentile) const
+{
+	if (!mCount)
+		return 0;
+	const double target (double(mCount) * (inPercentile < 0.0 ? 0.0 : (inPercentile > 100.0 ? 100.0 : inPercentile)) / 100.0);
+	uint64_t cumulative (0);
+	for (size_t bin(0);  bin < mBins.size();  bin++)
+	{
+		cumulative += mBins[bin];
+		if (double(cumulative) >= target  &&  mBins[bin])
+		{
+			const int64_t upperEdge (mMinValue + int64_t(bin + 1) * mBinWidth);
+			return upperEdge < mMax  &&  bin + 1 < mBins.size() ? upperEdge : mMax;	//	Last bin holds the overflow
+		}
+	}
+	return mMax;
+}
+
+ostream & NTV2TimingHistogram::Print (ostream & inOutStream, const size_t inMaxBarWidth) const
+{
+	if (!mCount)
+		return inOutStream;
+	size_t firstBin(0), lastBin(mBins.size() - 1);
+	uint64_t maxCount(0);
+	while (firstBin < lastBin  &&  !mBins[firstBin])
+		firstBin++;
+	while (lastBin > firstBin  &&  !mBins[lastBin])
+		lastBin--;
+	for (size_t bin(firstBin);  bin <= lastBin;  bin++)
+		if (mBins[bin] > maxCount)
+			maxCount = mBins[bin];
+	for (size_t bin(firstBin);  bin <= lastBin;  bin++)
+	{
+		const size_t barWidth (maxCount ? size_t(mBins[bin] * inMaxBarWidth / maxCount) : 0);
+		inOutStream << setw(10) << (mMinValue + int64_t(bin) * mBinWidth) << " " << setw(10) << mBins[bin]
+					<< " " << string(barWidth, '#') << endl;
+	}
+	return inOutStream;
+}
+
+
+//////////////////////////////////////////	NTV2ScopedTimer
+
+NTV2ScopedTimer::NTV2ScopedTimer (NTV2TimingHistogram & inHistogram, const uint64_t inNanosecsPerUnit, AJALock * pInLock)
+	:	mHistogram			(inHistogram),
+		mpLock				(pInLock),
+		mNanosecsPerUnit	(inNanosecsPerUnit ? inNanosecsPerUnit : 1),
+		mStartTicks			(AJATime::GetFastCounter()),
+		mCancelled			(false)
+{
+}
+
+NTV2ScopedTimer::~NTV2ScopedTimer ()
+{
+	if (mCancelled)
+		return;
+	const int64_t value (int64_t(GetElapsedNanoseconds() / mNanosecsPerUnit));
+	if (mpLock)
+	{
+		AJAAutoLock lock(mpLock);
+		mHistogram.Add(value);
+	}
+	else
+		mHistogram.Add(value);
+}
+
+uint64_t NTV2ScopedTimer::GetElapsedNanoseconds (void) const
+{
+	const uint64_t now (AJATime::GetFastCounter());
+	return AJATime::FastCounterToNanoseconds(now) - AJATime::FastCounterToNanoseconds(mStartTicks);
+}
+
+
+//////////////////////////////////////////	CNTV2TimingRecorder
+
+static NTV2TimingHistogram MakeHistogram (const NTV2TimingMetric inMetric)
+{
+	switch (inMetric)
+	{
+		case NTV2_TIMING_VBI_JITTER:	return NTV2TimingHistogram(-2000, 10, 400);		//	+/- 2 msec in 10 usec bins
+		case NTV2_TIMING_END_TO_END:	return NTV2TimingHistogram(0, 500, 500);		//	0 - 250 msec in 500 usec bins
+		default:						break;
+	}
+	return NTV2TimingHistogram(0, 100, 500);	//	0 - 50 msec in 100 usec bins
+}
+
+static void TrimCookies (map<ULWord64, int64_t> & inOutCookies)
+{
+	while (inOutCookies.size() > NTV2_TIMING_MAX_COOKIES)
+		inOutCookies.erase(inOutCookies.begin());	//	Cookies normally increase, so the oldest go first
+}
+
+
+CNTV2TimingRecorder::CNTV2TimingRecorder ()
+	:	mMaxSamples	(1000000)
+{
+}
+
+CNTV2TimingRecorder::~CNTV2TimingRecorder ()
+{
+}
+
+void CNTV2TimingRecorder::Reset (void)
+{
+	AJAAutoLock locker(&mLock);
+	mHistograms.clear();
+	mSamples.clear();
+	for (ChannelStates::iterator it(mChannels.begin());  it != mChannels.end();  ++it)
+	{	//	Keep frame rates
+		const int64_t framePeriod (it->second.fFramePeriod);
+		it->second = ChannelState();
+		it->second.fFramePeriod = framePeriod;
+	}
+}
+
+bool CNTV2TimingRecorder::SetFrameRate (const NTV2Channel inChannel, const NTV2FrameRate inFrameRate)
+{
+	ULWord numerator(0), denominator(0);
+	if (!NTV2_IS_VALID_CHANNEL(inChannel))
+		return false;
+	if (!::GetFramesPerSecond(inFrameRate, numerator, denominator)  ||  !numerator)
+		return false;
+	AJAAutoLock locker(&mLock);
+	mChannels[inChannel].fFramePeriod = int64_t(10000000) * int64_t(denominator) / int64_t(numerator);
+	return true;
+}
+
+void CNTV2TimingRecorder::SetMaxSamples (const size_t inMaxSamples)
+{
+	AJAAutoLock locker(&mLock);
+	mMaxSamples = inMaxSamples;
+	if (mSamples.size() > mMaxSamples)
+		mSamples.resize(mMaxSamples);
+}
+
+void CNTV2TimingRecorder::AddSample (const NTV2Channel inChannel, const NTV2TimingMetric inMetric, const ULWord64 inFrame,
+									const int64_t inTimestamp, const int64_t inValue)
+{
+	const HistoKey key (inChannel, inMetric);
+	HistoMap::iterator it (mHistograms.find(key));
+	if (it == mHistograms.end())
+		it = mHistograms.insert(HistoMap::value_type(key, MakeHistogram(inMetric))).first;
+	it->second.Add(inValue);
+	if (mSamples.size() < mMaxSamples)
+	{
+		NTV2TimingSample sample;
+		sample.fChannel = inChannel;	sample.fMetric = inMetric;		sample.fFrame = inFrame;
+		sample.fTimestamp = inTimestamp;	sample.fValue = inValue;
+		mSamples.push_back(sample);
+	}
+}
+
+void CNTV2TimingRecorder::RecordSample (const NTV2TimingSample & inSample)
+{
+	if (!NTV2_IS_VALID_TIMING_METRIC(inSample.fMetric))
+		return;
+	AJAAutoLock locker(&mLock);
+	AddSample(inSample.fChannel, inSample.fMetric, inSample.fFrame, inSample.fTimestamp, inSample.fValue);
+}
+
+void CNTV2TimingRecorder::UpdateDropCount (ChannelState & inState, const AUTOCIRCULATE_TRANSFER & inXfer, const bool inIsInput)
+{
+	const ULWord dropCount (inXfer.GetTransferStatus().acFramesDropped);
+	if (inState.fHaveDropCount  &&  dropCount > inState.fLastDropCount)
+	{	//	For playout, "dropped" frames are frames the device had to repeat
+		if (inIsInput)
+			inState.fDropped += dropCount - inState.fLastDropCount;
+		else
+			inState.fRepeated += dropCount - inState.fLastDropCount;
+	}
+	inState.fLastDropCount = dropCount;
+	inState.fHaveDropCount = true;
+}
+
+bool CNTV2TimingRecorder::RecordCaptureTransfer (const NTV2Channel inChannel, const AUTOCIRCULATE_TRANSFER & inXfer,
+												const uint64_t inStartMicrosecs, const uint64_t inEndMicrosecs)
+{
+	if (!NTV2_IS_VALID_CHANNEL(inChannel))
+		return false;
+	const FRAME_STAMP & stamp (inXfer.GetFrameInfo());
+	if (!stamp.acFrameTime  ||  stamp.acCurrentTime < stamp.acFrameTime)
+		return false;	//	Transfer failed or no frame stamp
+
+	AJAAutoLock locker(&mLock);
+	ChannelState & state (mChannels[inChannel]);
+	AddSample(inChannel, NTV2_TIMING_CAPTURE_LATENCY, inXfer.acInUserCookie, stamp.acFrameTime, (stamp.acCurrentTime - stamp.acFrameTime) / 10);
+	if (inEndMicrosecs >= inStartMicrosecs)
+		AddSample(inChannel, NTV2_TIMING_DMA_DURATION, inXfer.acInUserCookie, stamp.acCurrentTime, int64_t(inEndMicrosecs - inStartMicrosecs));
+	if (state.fFramePeriod  &&  state.fLastFrameTime  &&  stamp.acFrameTime > state.fLastFrameTime)
+	{	//	Jitter only between consecutive frames -- gaps are counted as drops
+		const int64_t delta (stamp.acFrameTime - state.fLastFrameTime);
+		const int64_t numFrames ((delta + state.fFramePeriod / 2) / state.fFramePeriod);
+		if (numFrames == 1)
+			AddSample(inChannel, NTV2_TIMING_VBI_JITTER, inXfer.acInUserCookie, stamp.acFrameTime, (delta - state.fFramePeriod) / 10);
+	}
+	state.fLastFrameTime = stamp.acFrameTime;
+	UpdateDropCount(state, inXfer, true);
+	return true;
+}
+
+bool CNTV2TimingRecorder::RecordOutputTransfer (const NTV2Channel inChannel, const AUTOCIRCULATE_TRANSFER & inXfer,
+												const uint64_t inStartMicrosecs, const uint64_t inEndMicrosecs,
+												const uint64_t inCaptureEndMicrosecs)
+{
+	if (!NTV2_IS_VALID_CHANNEL(inChannel))
+		return false;
+	const FRAME_STAMP & stamp (inXfer.GetFrameInfo());
+	if (!stamp.acCurrentTime)
+		return false;	//	Transfer failed
+
+	AJAAutoLock locker(&mLock);
+	ChannelState & state (mChannels[inChannel]);
+	if (inEndMicrosecs >= inStartMicrosecs)
+		AddSample(inChannel, NTV2_TIMING_DMA_DURATION, inXfer.acInUserCookie, stamp.acCurrentTime, int64_t(inEndMicrosecs - inStartMicrosecs));
+	if (inCaptureEndMicrosecs  &&  inStartMicrosecs >= inCaptureEndMicrosecs)
+		AddSample(inChannel, NTV2_TIMING_HOST_PROCESSING, inXfer.acInUserCookie, stamp.acCurrentTime, int64_t(inStartMicrosecs - inCaptureEndMicrosecs));
+	state.fPending[inXfer.acInUserCookie] = stamp.acCurrentTime;
+	state.fPlayed[inXfer.acInUserCookie] = stamp.acCurrentTime;
+	TrimCookies(state.fPending);
+	TrimCookies(state.fPlayed);
+	UpdateDropCount(state, inXfer, false);
+	return true;
+}
+
+bool CNTV2TimingRecorder::RecordOutputFrameStamp (const NTV2Channel inChannel, const FRAME_STAMP & inFrameStamp)
+{
+	if (!NTV2_IS_VALID_CHANNEL(inChannel))
+		return false;
+	AJAAutoLock locker(&mLock);
+	ChannelState & state (mChannels[inChannel]);
+	CookieTimes::iterator it (state.fPending.find(inFrameStamp.acCurrentUserCookie));
+	if (it == state.fPending.end())
+		return false;	//	Unknown, or already recorded
+	const int64_t xferTime (it->second);
+	state.fPending.erase(it);
+	if (inFrameStamp.acCurrentFrameTime < xferTime)
+		return false;
+	AddSample(inChannel, NTV2_TIMING_OUTPUT_LATENCY, inFrameStamp.acCurrentUserCookie, inFrameStamp.acCurrentFrameTime,
+				(inFrameStamp.acCurrentFrameTime - xferTime) / 10);
+	return true;
+}
+
+bool CNTV2TimingRecorder::RecordLoopback (const NTV2Channel inInputChannel, const NTV2Channel inOutputChannel,
+										const ULWord64 inCookie, const AUTOCIRCULATE_TRANSFER & inCaptureXfer)
+{
+	if (!NTV2_IS_VALID_CHANNEL(inInputChannel)  ||  !NTV2_IS_VALID_CHANNEL(inOutputChannel))
+		return false;
+	const int64_t captureTime (inCaptureXfer.GetFrameInfo().acCurrentTime);
+	AJAAutoLock locker(&mLock);
+	ChannelState & state (mChannels[inOutputChannel]);
+	CookieTimes::iterator it (state.fPlayed.find(inCookie));
+	if (it == state.fPlayed.end()  ||  captureTime < it->second)
+		return false;
+	AddSample(inInputChannel, NTV2_TIMING_END_TO_END, inCookie, captureTime, (captureTime - it->second) / 10);
+	state.fPlayed.erase(it);	//	Count each frame once, even if the input captured it repeatedly
+	return true;
+}
+
+NTV2TimingHistogram CNTV2TimingRecorder::GetHistogram (const NTV2Channel inChannel, const NTV2TimingMetric inMetric) const
+{
+	AJAAutoLock locker(&mLock);
+	HistoMap::const_iterator it (mHistograms.find(HistoKey(inChannel, inMetric)));
+	return it != mHistograms.end() ? it->second : MakeHistogram(inMetric);
+}
+
+uint64_t CNTV2TimingRecorder::GetDroppedFrames (const NTV2Channel inChannel) const
+{
+	AJAAutoLock locker(&mLock);
+	ChannelStates::const_iterator it (mChannels.find(inChannel));
+	return it != mChannels.end() ? it->second.fDropped : 0;
+}
+
+uint64_t CNTV2TimingRecorder::GetRepeatedFrames (const NTV2Channel inChannel) const
+{
+	AJAAutoLock locker(&mLock);
+	ChannelStates::const_iterator it (mChannels.find(inChannel));
+	return it != mChannels.end() ? it->second.fRepeated : 0;
+}
+
+NTV2TimingSamples CNTV2TimingRecorder::GetSamples (void) const
+{
+	AJAAutoLock locker(&mLock);
+	return mSamples;
+}
+
+ostream & CNTV2TimingRecorder::Print (ostream & inOutStream, const bool inWithHistograms) const
+{
+	AJAAutoLock locker(&mLock);
+	const ios_base::fmtflags savedFlags (inOutStream.flags());	//	Restored before returning,
+	const streamsize savedPrecision (inOutStream.precision());	//	so the caller's formatting is unchanged
+	set<NTV2Channel> channels;
+	for (HistoMap::const_iterator it(mHistograms.begin());  it != mHistograms.end();  ++it)
+		channels.insert(it->first.first);
+	for (ChannelStates::const_iterator it(mChannels.begin());  it != mChannels.end();  ++it)
+		channels.insert(it->first);
+
+	for (set<NTV2Channel>::const_iterator chIt(channels.begin());  chIt != channels.end();  ++chIt)
+	{
+		ChannelStates::const_iterator stIt (mChannels.find(*chIt));
+		inOutStream << ::NTV2ChannelToString(*chIt, true) << ":";
+		if (stIt != mChannels.end())
+			inOutStream << "  dropped=" << stIt->second.fDropped << " repeated=" << stIt->second.fRepeated;
+		inOutStream << endl;
+		for (int metric(0);  metric < NTV2_TIMING_NUM_METRICS;  metric++)
+		{
+			HistoMap::const_iterator it (mHistograms.find(HistoKey(*chIt, NTV2TimingMetric(metric))));
+			if (it == mHistograms.end()  ||  !it->second.GetCount())
+				continue;
+			const NTV2TimingHistogram & histo (it->second);
+			inOutStream << "  " << left << setw(20) << ::NTV2TimingMetricToString(NTV2TimingMetric(metric)) << right
+						<< " n=" << histo.GetCount() << " min=" << histo.GetMin() << " max=" << histo.GetMax()
+						<< " mean=" << fixed << setprecision(1) << histo.GetMean() << " stddev=" << histo.GetStdDev()
+						<< " p50=" << histo.GetPercentile(50.0) << " p99=" << histo.GetPercentile(99.0) << " (usec)" << endl;
+			if (inWithHistograms)
+				histo.Print(inOutStream);
+		}
+	}
+	inOutStream.flags(savedFlags);
+	inOutStream.precision(savedPrecision);
+	return inOutStream;
+}
+
+bool CNTV2TimingRecorder::WriteCSV (ostream & inOutStream) const
+{
+	AJAAutoLock locker(&mLock);
+	inOutStream << "channel,metric,frame,timestamp,value_us" << endl;
+	for (NTV2TimingSamples::const_iterator it(mSamples.begin());  it != mSamples.end();  ++it)
+		inOutStream << DEC(it->fChannel + 1) << "," << ::NTV2TimingMetricToString(it->fMetric, true) << "," << it->fFrame
+					<< "," << it->fTimestamp << "," << it->fValue << endl;
+	return inOutStream.good();
+}
+
+bool CNTV2TimingRecorder::WriteJSON (ostream & inOutStream) const
+{
+	AJAAutoLock locker(&mLock);
+	const ios_base::fmtflags savedFlags (inOutStream.flags());	//	Restored before returning,
+	const streamsize savedPrecision (inOutStream.precision());	//	so the caller's formatting is unchanged
+	set<NTV2Channel> channels;
+	for (HistoMap::const_iterator it(mHistograms.begin());  it != mHistograms.end();  ++it)
+		channels.insert(it->first.first);
+	for (ChannelStates::const_iterator it(mChannels.begin());  it != mChannels.end();  ++it)
+		channels.insert(it->first);
+
+	inOutStream << "{\"channels\": [";
+	for (set<NTV2Channel>::const_iterator chIt(channels.begin());  chIt != channels.end();  ++chIt)
+	{
+		ChannelStates::const_iterator stIt (mChannels.find(*chIt));
+		inOutStream << (chIt == channels.begin() ? "" : ",") << endl
+					<< "  {\"channel\": " << DEC(*chIt + 1)
+					<< ", \"dropped\": " << (stIt != mChannels.end() ? stIt->second.fDropped : 0)
+					<< ", \"repeated\": " << (stIt != mChannels.end() ? stIt->second.fRepeated : 0)
+					<< ", \"metrics\": {";
+		bool first(true);
+		for (int metric(0);  metric < NTV2_TIMING_NUM_METRICS;  metric++)
+		{
+			HistoMap::const_iterator it (mHistograms.find(HistoKey(*chIt, NTV2TimingMetric(metric))));
+			if (it == mHistograms.end())
+				continue;
+			const NTV2TimingHistogram & histo (it->second);
+			inOutStream << (first ? "" : ",") << endl << "    \"" << ::NTV2TimingMetricToString(NTV2TimingMetric(metric), true) << "\": {"
+						<< "\"count\": " << histo.GetCount() << ", \"min\": " << histo.GetMin() << ", \"max\": " << histo.GetMax()
+						<< ", \"mean\": " << fixed << setprecision(1) << histo.GetMean() << ", \"stddev\": " << histo.GetStdDev()
+						<< ", \"p50\": " << histo.GetPercentile(50.0) << ", \"p99\": " << histo.GetPercentile(99.0)
+						<< ", \"histogram\": {\"min\": " << histo.GetMinValue() << ", \"binWidth\": " << histo.GetBinWidth() << ", \"bins\": [";
+			for (size_t bin(0);  bin < histo.GetBins().size();  bin++)
+				inOutStream << (bin ? "," : "") << histo.GetBins()[bin];
+			inOutStream << "]}}";
+			first = false;
+		}
+		inOutStream << "}}";
+	}
+	inOutStream << endl << "]}" << endl;
+	inOutStream.flags(savedFlags);
+	inOutStream.precision(savedPrecision);
+	return inOutStream.good();
+}
+
+
+//////////////////////////////////////////	Loopback frame counter
+
+static bool CounterLineOffset (const NTV2Buffer & inFrame, const NTV2FormatDescriptor & inFD, const ULWord inLine, ULWord & outOffset)
+{
+	if (!inFD.IsValid()  ||  inFD.IsPlanar())
+		return false;
+	if (inFD.GetPixelFormat() != NTV2_FBF_8BIT_YCBCR  &&  inFD.GetPixelFormat() != NTV2_FBF_10BIT_YCBCR)
+		return false;
+	if (inFD.GetRasterWidth() < NTV2_TIMING_COUNTER_BITS * NTV2_TIMING_COUNTER_CELL  ||  inFD.GetVisibleRasterHeight() < NTV2_TIMING_COUNTER_LINES)
+		return false;
+	outOffset = (inFD.GetFirstActiveLine() + inLine) * inFD.GetBytesPerRow();
+	return inFrame.GetByteCount() >= outOffset + inFD.GetBytesPerRow();
+}
+
+bool CNTV2TimingRecorder::EncodeFrameCounter (NTV2Buffer & ioFrame, const NTV2FormatDescriptor & inFD, const ULWord inCounter)
+{
+	const ULWord64 bits ((ULWord64(NTV2_TIMING_COUNTER_MARKER) << 32) | ULWord64(inCounter));
+	for (ULWord line(0);  line < NTV2_TIMING_COUNTER_LINES;  line++)
+	{
+		ULWord lineOffset(0);
+		if (!CounterLineOffset(ioFrame, inFD, line, lineOffset))
+			return false;
+		for (ULWord bit(0);  bit < NTV2_TIMING_COUNTER_BITS;  bit++)
+		{
+			const bool isSet ((bits >> (NTV2_TIMING_COUNTER_BITS - 1 - bit)) & 1);
+			if (inFD.GetPixelFormat() == NTV2_FBF_8BIT_YCBCR)
+			{	//	Cb Y0 Cr Y1 ...
+				const UByte luma (isSet ? 235 : 16);
+				UByte * pCell (reinterpret_cast<UByte*>(ioFrame.GetHostAddress(lineOffset + bit * NTV2_TIMING_COUNTER_CELL * 2)));
+				for (ULWord pair(0);  pair < NTV2_TIMING_COUNTER_CELL / 2;  pair++)
+					{pCell[pair*4+0] = 0x80;  pCell[pair*4+1] = luma;  pCell[pair*4+2] = 0x80;  pCell[pair*4+3] = luma;}
+			}
+			else
+			{	//	Two v210 6-pixel groups
+				const ULWord luma (isSet ? 940 : 64);
+				ULWord * pCell (reinterpret_cast<ULWord*>(ioFrame.GetHostAddress(lineOffset + bit * NTV2_TIMING_COUNTER_CELL / 6 * 16)));
+				for (ULWord group(0);  group < NTV2_TIMING_COUNTER_CELL / 6;  group++)
+				{
+					pCell[group*4+0] = 512 | (luma << 10) | (512 << 20);	//	Cb0 Y0 Cr0
+					pCell[group*4+1] = luma | (512 << 10) | (luma << 20);	//	Y1 Cb1 Y2
+					pCell[group*4+2] = 512 | (luma << 10) | (512 << 20);	//	Cr1 Y3 Cb2
+					pCell[group*4+3] = luma | (512 << 10) | (luma << 20);	//	Y4 Cr2 Y5
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool CNTV2TimingRecorder::DecodeFrameCounter (const NTV2Buffer & inFrame, const NTV2FormatDescriptor & inFD, ULWord & outCounter)
+{
+	ULWord lineOffset(0);
+	if (!CounterLineOffset(inFrame, inFD, 1, lineOffset))	//	Away from the top edge
+		return false;
+	ULWord64 bits(0);
+	for (ULWord bit(0);  bit < NTV2_TIMING_COUNTER_BITS;  bit++)
+	{
+		bool isSet(false);
+		if (inFD.GetPixelFormat() == NTV2_FBF_8BIT_YCBCR)
+		{	//	Luma of the middle pixel pair
+			const UByte * pCell (reinterpret_cast<const UByte*>(inFrame.GetHostAddress(lineOffset + bit * NTV2_TIMING_COUNTER_CELL * 2)));
+			isSet = pCell[NTV2_TIMING_COUNTER_CELL + 1] >= 128;
+		}
+		else
+		{	//	Y1 of the second group
+			const ULWord * pCell (reinterpret_cast<const ULWord*>(inFrame.GetHostAddress(lineOffset + bit * NTV2_TIMING_COUNTER_CELL / 6 * 16)));
+			isSet = (pCell[5] & 0x3FF) >= 512;
+		}
+		bits = (bits << 1) | (isSet ? 1 : 0);
+	}
+	if ((bits >> 32) != NTV2_TIMING_COUNTER_MARKER)
+		return false;
+	outCounter = ULWord(bits & 0xFFFFFFFF);
+	return true;
+}
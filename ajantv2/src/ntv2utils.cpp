@@ -16,12 +16,17 @@
 #include "ntv2version.h"
 #include "ntv2devicefeatures.h"	//	Required for NTV2DeviceCanDoVideoFormat
 #include "ajabase/system/lock.h"
+#include "ajabase/system/threadpool.h"
 #include "ajabase/common/common.h"
 #if defined(AJALinux)
 	#include <string.h>	 // For memset
 	#include <stdint.h>
 
 #endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define NTV2_REFORMAT_SSE2	1
+#endif
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -508,6 +513,337 @@ void CopyToQuadrant(uint8_t* srcBuffer, uint32_t srcHeight, uint32_t srcRowBytes
 //////////////////////////////////////////////////////
 
 
+//--------------------------------------------------------------------------------------------------------------------
+//	ReformatQuadFrame()
+//
+//	Every sub-image row 'r' is built from (or scattered into) one or two raster rows, so the work is split into
+//	bands of sub-image rows, each band visiting all four sub-images. This keeps each band's raster rows in cache
+//	while they're being split (or merged), and lets the bands run concurrently with no overlapping writes.
+//--------------------------------------------------------------------------------------------------------------------
+typedef struct QuadReformatBand
+{
+	const UByte *	fpSrc;			//	Source plane
+	UByte *			fpDst;			//	Destination plane
+	ULWord			fRowBytes;		//	Full raster bytes per row in this plane
+	ULWord			fSubRows;		//	Number of rows per sub-image in this plane
+	ULWord			fPairBytes;		//	Bytes per pair of adjacent pixels (zero for NTV2_FBF_10BIT_YCBCR)
+	ULWord			fNumPixels;		//	Full raster width
+	NTV2QuadLayout	fSrcLayout;
+	NTV2QuadLayout	fDstLayout;
+	ULWord			fFirstRow;		//	First sub-image row to process
+	ULWord			fEndRow;		//	Sub-image row to stop at
+} QuadReformatBand;
+
+typedef std::vector<QuadReformatBand>	QuadReformatBands;
+
+//	Copies a row segment, using non-temporal stores for the bulk of it when possible
+static inline void StreamCopy (UByte * pDst, const UByte * pSrc, size_t inByteCount)
+{
+#if defined(NTV2_REFORMAT_SSE2)
+	if (inByteCount >= 256)
+	{
+		const size_t prefix ((16 - (uintptr_t(pDst) & 15)) & 15);
+		::memcpy(pDst, pSrc, prefix);
+		pDst += prefix;  pSrc += prefix;  inByteCount -= prefix;
+		for (;  inByteCount >= 64;  inByteCount -= 64, pDst += 64, pSrc += 64)
+		{
+			const __m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+			const __m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16)));
+			const __m128i c (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 32)));
+			const __m128i d (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 48)));
+			_mm_stream_si128(reinterpret_cast<__m128i*>(pDst),      a);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(pDst + 16), b);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(pDst + 32), c);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(pDst + 48), d);
+		}
+	}
+#endif	//	NTV2_REFORMAT_SSE2
+	::memcpy(pDst, pSrc, inByteCount);
+}
+
+//	Splits a raster row segment into its even & odd pixel pairs
+static void DeinterleavePairs (const UByte * pSrc, UByte * pEven, UByte * pOdd, ULWord inNumPairs, const ULWord inPairBytes)
+{
+#if defined(NTV2_REFORMAT_SSE2)
+	if (inPairBytes == 4  ||  inPairBytes == 8)
+	{
+		const bool nonTemporal (((uintptr_t(pEven) | uintptr_t(pOdd)) & 15) == 0);
+		const ULWord pairsPerLoop (32 / inPairBytes);
+		for (;  inNumPairs >= pairsPerLoop;  inNumPairs -= pairsPerLoop, pSrc += 32, pEven += 16, pOdd += 16)
+		{
+			__m128i a (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+			__m128i b (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16)));
+			if (inPairBytes == 4)
+			{	//	e0 o0 e1 o1 ==> e0 e1 o0 o1
+				a = _mm_shuffle_epi32(a, _MM_SHUFFLE(3,1,2,0));
+				b = _mm_shuffle_epi32(b, _MM_SHUFFLE(3,1,2,0));
+			}
+			const __m128i even (_mm_unpacklo_epi64(a, b)),  odd (_mm_unpackhi_epi64(a, b));
+			if (nonTemporal)
+			{
+				_mm_stream_si128(reinterpret_cast<__m128i*>(pEven), even);
+				_mm_stream_si128(reinterpret_cast<__m128i*>(pOdd), odd);
+			}
+			else
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pEven), even);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pOdd), odd);
+			}
+		}
+	}
+#endif	//	NTV2_REFORMAT_SSE2
+	for (;  inNumPairs;  inNumPairs -= 2, pSrc += 2 * inPairBytes, pEven += inPairBytes, pOdd += inPairBytes)
+	{
+		::memcpy(pEven, pSrc, inPairBytes);
+		::memcpy(pOdd, pSrc + inPairBytes, inPairBytes);
+	}
+}
+
+//	Merges even & odd pixel pairs into a raster row segment
+static void InterleavePairs (const UByte * pEven, const UByte * pOdd, UByte * pDst, ULWord inNumPairs, const ULWord inPairBytes)
+{
+#if defined(NTV2_REFORMAT_SSE2)
+	if (inPairBytes == 4  ||  inPairBytes == 8)
+	{
+		const bool nonTemporal ((uintptr_t(pDst) & 15) == 0);
+		const ULWord pairsPerLoop (32 / inPairBytes);
+		for (;  inNumPairs >= pairsPerLoop;  inNumPairs -= pairsPerLoop, pEven += 16, pOdd += 16, pDst += 32)
+		{
+			const __m128i even (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pEven)));
+			const __m128i odd (_mm_loadu_si128(reinterpret_cast<const __m128i*>(pOdd)));
+			__m128i a (_mm_unpacklo_epi64(even, odd)),  b (_mm_unpackhi_epi64(even, odd));
+			if (inPairBytes == 4)
+			{	//	e0 e1 o0 o1 ==> e0 o0 e1 o1
+				a = _mm_shuffle_epi32(a, _MM_SHUFFLE(3,1,2,0));
+				b = _mm_shuffle_epi32(b, _MM_SHUFFLE(3,1,2,0));
+			}
+			if (nonTemporal)
+			{
+				_mm_stream_si128(reinterpret_cast<__m128i*>(pDst), a);
+				_mm_stream_si128(reinterpret_cast<__m128i*>(pDst + 16), b);
+			}
+			else
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), a);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 16), b);
+			}
+		}
+	}
+#endif	//	NTV2_REFORMAT_SSE2
+	for (;  inNumPairs;  inNumPairs -= 2, pEven += inPairBytes, pOdd += inPairBytes, pDst += 2 * inPairBytes)
+	{
+		::memcpy(pDst, pEven, inPairBytes);
+		::memcpy(pDst + inPairBytes, pOdd, inPairBytes);
+	}
+}
+
+//	Extracts component 0, 1 or 2 from an NTV2_FBF_10BIT_YCBCR word
+#define	V210COMP(__w__,__c__)	(((__w__) >> (10 * (__c__))) & 0x3FF)
+
+//	Splits one 12-pixel NTV2_FBF_10BIT_YCBCR block (8 words, components c0..c23) into its even & odd pixel pairs (4 words each)
+static inline void SplitV210Block (const ULWord * pBlock, ULWord * pEven, ULWord * pOdd)
+{
+	const ULWord w0(pBlock[0]), w1(pBlock[1]), w2(pBlock[2]), w3(pBlock[3]), w4(pBlock[4]), w5(pBlock[5]), w6(pBlock[6]), w7(pBlock[7]);
+	pEven[0] = w0 & 0x3FFFFFFF;																	//	c0  c1  c2
+	pEven[1] = V210COMP(w1,0) | (V210COMP(w2,2) << 10) | (V210COMP(w3,0) << 20);				//	c3  c8  c9
+	pEven[2] = V210COMP(w3,1) | (V210COMP(w3,2) << 10) | (V210COMP(w5,1) << 20);				//	c10 c11 c16
+	pEven[3] = V210COMP(w5,2) | (V210COMP(w6,0) << 10) | (V210COMP(w6,1) << 20);				//	c17 c18 c19
+	pOdd[0]  = V210COMP(w1,1) | (V210COMP(w1,2) << 10) | (V210COMP(w2,0) << 20);				//	c4  c5  c6
+	pOdd[1]  = V210COMP(w2,1) | (V210COMP(w4,0) << 10) | (V210COMP(w4,1) << 20);				//	c7  c12 c13
+	pOdd[2]  = V210COMP(w4,2) | (V210COMP(w5,0) << 10) | (V210COMP(w6,2) << 20);				//	c14 c15 c20
+	pOdd[3]  = w7 & 0x3FFFFFFF;																	//	c21 c22 c23
+}
+
+//	Merges even & odd pixel pairs (4 words each) into one 12-pixel NTV2_FBF_10BIT_YCBCR block (8 words)
+static inline void MergeV210Block (const ULWord * pEven, const ULWord * pOdd, ULWord * pBlock)
+{
+	const ULWord e0(pEven[0]), e1(pEven[1]), e2(pEven[2]), e3(pEven[3]), o0(pOdd[0]), o1(pOdd[1]), o2(pOdd[2]), o3(pOdd[3]);
+	pBlock[0] = e0 & 0x3FFFFFFF;																//	c0  c1  c2
+	pBlock[1] = V210COMP(e1,0) | (V210COMP(o0,0) << 10) | (V210COMP(o0,1) << 20);				//	c3  c4  c5
+	pBlock[2] = V210COMP(o0,2) | (V210COMP(o1,0) << 10) | (V210COMP(e1,1) << 20);				//	c6  c7  c8
+	pBlock[3] = V210COMP(e1,2) | (V210COMP(e2,0) << 10) | (V210COMP(e2,1) << 20);				//	c9  c10 c11
+	pBlock[4] = V210COMP(o1,1) | (V210COMP(o1,2) << 10) | (V210COMP(o2,0) << 20);				//	c12 c13 c14
+	pBlock[5] = V210COMP(o2,1) | (V210COMP(e2,2) << 10) | (V210COMP(e3,0) << 20);				//	c15 c16 c17
+	pBlock[6] = V210COMP(e3,1) | (V210COMP(e3,2) << 10) | (V210COMP(o2,2) << 20);				//	c18 c19 c20
+	pBlock[7] = o3 & 0x3FFFFFFF;																//	c21 c22 c23
+}
+
+//	Splits (or merges) one raster row to (or from) two sub-image rows
+static void ReformatQuadRow (const QuadReformatBand & inBand, const UByte * pRaster, UByte * pRasterOut,
+							const UByte * pSubA, const UByte * pSubB, UByte * pSubAOut, UByte * pSubBOut,
+							const NTV2QuadLayout inSubLayout, std::vector<UWord> & inOutScratch)
+{
+	const ULWord halfRowBytes (inBand.fRowBytes / 2);
+	const ULWord numPixels (inBand.fNumPixels),  subPixels (numPixels / 2);
+	if (inBand.fPairBytes  ||  (inSubLayout == NTV2_QUADLAYOUT_SQUARES  &&  numPixels % 48 == 0))
+	{	//	Byte-granular pixel pairs, or NTV2_FBF_10BIT_YCBCR halves with no padding
+		if (inSubLayout == NTV2_QUADLAYOUT_SQUARES)
+		{
+			if (pRaster)
+				{StreamCopy(pSubAOut, pRaster, halfRowBytes);  StreamCopy(pSubBOut, pRaster + halfRowBytes, halfRowBytes);}
+			else
+				{StreamCopy(pRasterOut, pSubA, halfRowBytes);  StreamCopy(pRasterOut + halfRowBytes, pSubB, halfRowBytes);}
+		}
+		else if (pRaster)
+			DeinterleavePairs(pRaster, pSubAOut, pSubBOut, inBand.fNumPixels / 2, inBand.fPairBytes);
+		else
+			InterleavePairs(pSubA, pSubB, pRasterOut, inBand.fNumPixels / 2, inBand.fPairBytes);
+		return;
+	}
+
+	//	NTV2_FBF_10BIT_YCBCR:  6 pixels per 16 bytes...
+	if (inSubLayout == NTV2_QUADLAYOUT_TSI  &&  numPixels % 12 == 0)
+	{	//	Each 12-pixel block holds 3 even & 3 odd pixel pairs, which pack into one 6-pixel group apiece
+		for (ULWord block(0);  block < numPixels / 12;  block++)
+			if (pRaster)
+				SplitV210Block(reinterpret_cast<const ULWord*>(pRaster) + block * 8,
+								reinterpret_cast<ULWord*>(pSubAOut) + block * 4,  reinterpret_cast<ULWord*>(pSubBOut) + block * 4);
+			else
+				MergeV210Block(reinterpret_cast<const ULWord*>(pSubA) + block * 4,  reinterpret_cast<const ULWord*>(pSubB) + block * 4,
+								reinterpret_cast<ULWord*>(pRasterOut) + block * 8);
+		return;
+	}
+	//	...otherwise unpack to 4 components per pixel pair, then repack...
+	UWord * pFull (&inOutScratch[0]);
+	UWord * pA (pFull + numPixels * 2 + 12);
+	UWord * pB (pA + subPixels * 2 + 12);
+	if (pRaster)
+		::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(pRaster), pFull, numPixels);
+	else
+	{
+		::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(pSubA), pA, subPixels);
+		::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(pSubB), pB, subPixels);
+	}
+	for (ULWord pair(0);  pair < subPixels / 2;  pair++)
+	{
+		UWord * pRasterA (inSubLayout == NTV2_QUADLAYOUT_SQUARES  ?  pFull + pair * 4  :  pFull + pair * 8);
+		UWord * pRasterB (inSubLayout == NTV2_QUADLAYOUT_SQUARES  ?  pFull + subPixels * 2 + pair * 4  :  pFull + pair * 8 + 4);
+		if (pRaster)
+			{::memcpy(pA + pair * 4, pRasterA, 4 * sizeof(UWord));  ::memcpy(pB + pair * 4, pRasterB, 4 * sizeof(UWord));}
+		else
+			{::memcpy(pRasterA, pA + pair * 4, 4 * sizeof(UWord));  ::memcpy(pRasterB, pB + pair * 4, 4 * sizeof(UWord));}
+	}
+	if (pRaster)
+	{
+		::PackLine_16BitYUVto10BitYUV(pA, reinterpret_cast<ULWord*>(pSubAOut), subPixels);
+		::PackLine_16BitYUVto10BitYUV(pB, reinterpret_cast<ULWord*>(pSubBOut), subPixels);
+	}
+	else
+		::PackLine_16BitYUVto10BitYUV(pFull, reinterpret_cast<ULWord*>(pRasterOut), numPixels);
+}
+
+static void ReformatQuadBand (const QuadReformatBand & inBand, std::vector<UWord> & inOutScratch)
+{
+	const bool toRaster (inBand.fDstLayout == NTV2_QUADLAYOUT_RASTER);
+	const NTV2QuadLayout subLayout (toRaster ? inBand.fSrcLayout : inBand.fDstLayout);
+	const ULWord rowBytes (inBand.fRowBytes),  subRowBytes (rowBytes / 2);
+	const ULWord subImageBytes (inBand.fSubRows * subRowBytes);
+	if (!inBand.fPairBytes)
+		inOutScratch.resize(size_t(inBand.fNumPixels) * 4 + 48, 0);
+	for (ULWord row(inBand.fFirstRow);  row < inBand.fEndRow;  row++)
+		for (ULWord upperLower(0);  upperLower < 2;  upperLower++)	//	Sub-images 0 & 1, then 2 & 3
+		{
+			const ULWord rasterRow (subLayout == NTV2_QUADLAYOUT_SQUARES  ?  row + upperLower * inBand.fSubRows  :  row * 2 + upperLower);
+			const ULWord subOffsetA (2 * upperLower * subImageBytes + row * subRowBytes);
+			const ULWord subOffsetB (subOffsetA + subImageBytes);
+			if (toRaster)
+				ReformatQuadRow(inBand, AJA_NULL, inBand.fpDst + rasterRow * rowBytes, inBand.fpSrc + subOffsetA, inBand.fpSrc + subOffsetB,
+								AJA_NULL, AJA_NULL, subLayout, inOutScratch);
+			else
+				ReformatQuadRow(inBand, inBand.fpSrc + rasterRow * rowBytes, AJA_NULL, AJA_NULL, AJA_NULL,
+								inBand.fpDst + subOffsetA, inBand.fpDst + subOffsetB, subLayout, inOutScratch);
+		}
+#if defined(NTV2_REFORMAT_SSE2)
+	_mm_sfence();	//	Make non-temporal stores visible before this band is reported done
+#endif	//	NTV2_REFORMAT_SSE2
+}
+
+static void ReformatQuadBands (uint32_t inFirst, uint32_t inLast, void * pContext)
+{
+	const QuadReformatBands & bands (*reinterpret_cast<const QuadReformatBands*>(pContext));
+	std::vector<UWord> scratch;
+	for (uint32_t ndx(inFirst);  ndx < inLast;  ndx++)
+		ReformatQuadBand(bands.at(ndx), scratch);
+}
+
+static UWord DefaultReformatThreadCount (void)
+{
+	//	Memory-bound, so more than 8 threads rarely helps...
+	const uint32_t numCPUs (AJAThreadPool::GetCPUCount());
+	return UWord(numCPUs > 8 ? 8 : numCPUs);
+}
+
+bool ReformatQuadFrame (const NTV2Buffer & inSrcBuffer, const NTV2QuadLayout inSrcLayout,
+						NTV2Buffer & outDstBuffer, const NTV2QuadLayout inDstLayout,
+						const NTV2FormatDescriptor & inDescriptor, const UWord inNumThreads)
+{
+	if (!inDescriptor.IsValid())
+		return false;
+	if (!NTV2_IS_VALID_QUADLAYOUT(inSrcLayout)  ||  !NTV2_IS_VALID_QUADLAYOUT(inDstLayout))
+		return false;
+	const ULWord totalBytes (inDescriptor.GetTotalBytes()),  numPixels (inDescriptor.GetRasterWidth());
+	if (inSrcBuffer.IsNULL()  ||  outDstBuffer.IsNULL())
+		return false;
+	if (inSrcBuffer.GetByteCount() < totalBytes  ||  outDstBuffer.GetByteCount() < totalBytes)
+		return false;
+	if (inSrcBuffer.GetHostPointer() == outDstBuffer.GetHostPointer())
+		return false;	//	In-place reformatting not supported
+	if (numPixels % 4)
+		return false;
+	if (inSrcLayout == inDstLayout)
+		return outDstBuffer.CopyFrom(inSrcBuffer, 0, 0, totalBytes);
+	if (inSrcLayout != NTV2_QUADLAYOUT_RASTER  &&  inDstLayout != NTV2_QUADLAYOUT_RASTER)
+	{	//	Squares <==> TSI:  go by way of raster...
+		NTV2Buffer raster(totalBytes);
+		return ReformatQuadFrame(inSrcBuffer, inSrcLayout, raster, NTV2_QUADLAYOUT_RASTER, inDescriptor, inNumThreads)
+			&& ReformatQuadFrame(raster, NTV2_QUADLAYOUT_RASTER, outDstBuffer, inDstLayout, inDescriptor, inNumThreads);
+	}
+
+	//	Build the per-plane band list...
+	const UWord numThreads (inNumThreads ? inNumThreads : DefaultReformatThreadCount());
+	QuadReformatBands bands;
+	ULWord planeOffset (0);
+	for (UWord plane(0);  plane < inDescriptor.GetNumPlanes();  plane++)
+	{
+		const ULWord rowBytes (inDescriptor.GetBytesPerRow(plane));
+		const ULWord vertRatio (inDescriptor.GetVerticalSampleRatio(plane));
+		const ULWord planeRows (vertRatio ? inDescriptor.GetFullRasterHeight() / vertRatio : 0);
+		ULWord pairBytes (0);
+		if ((rowBytes * 2) % numPixels == 0)
+			pairBytes = rowBytes * 2 / numPixels;
+		else if (inDescriptor.GetPixelFormat() != NTV2_FBF_10BIT_YCBCR)
+			return false;	//	Pixel pairs don't fall on byte boundaries
+		if (!planeRows  ||  planeRows % 2  ||  rowBytes % 2)
+			return false;
+
+		QuadReformatBand band;
+		band.fpSrc		= reinterpret_cast<const UByte*>(inSrcBuffer.GetHostPointer()) + planeOffset;
+		band.fpDst		= reinterpret_cast<UByte*>(outDstBuffer.GetHostPointer()) + planeOffset;
+		band.fRowBytes	= rowBytes;
+		band.fSubRows	= planeRows / 2;
+		band.fPairBytes	= pairBytes;
+		band.fNumPixels	= numPixels;
+		band.fSrcLayout	= inSrcLayout;
+		band.fDstLayout	= inDstLayout;
+		const ULWord rowsPerBand ((band.fSubRows + numThreads - 1) / numThreads);
+		for (ULWord row(0);  row < band.fSubRows;  row += rowsPerBand)
+		{
+			band.fFirstRow = row;
+			band.fEndRow = row + rowsPerBand < band.fSubRows  ?  row + rowsPerBand  :  band.fSubRows;
+			bands.push_back(band);
+		}
+		planeOffset += rowBytes * planeRows;
+	}
+
+	//	Run the bands on the shared thread pool...
+	if (numThreads < 2  ||  bands.size() < 2)
+		ReformatQuadBands(0, uint32_t(bands.size()), &bands);
+	else
+		AJAThreadPool::GetDefault().ParallelFor(0, uint32_t(bands.size()), ReformatQuadBands, &bands, 1);
+	return true;
+}	//	ReformatQuadFrame
+
+
 void UnpackLine_10BitYUVto16BitYUV (const ULWord * pIn10BitYUVLine, UWord * pOut16BitYUVLine, const ULWord inNumPixels)
 {
 	NTV2_ASSERT (pIn10BitYUVLine && pOut16BitYUVLine && "UnpackLine_10BitYUVto16BitYUV -- NULL buffer pointer(s)");
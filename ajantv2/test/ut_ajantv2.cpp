@@ -14,20 +14,37 @@
 #include "ntv2bitfile.h"
 #include "ntv2card.h"
 #include "ntv2debug.h"
+#include "ntv2devicescanner.h"
 #include "ntv2endian.h"
+#include "ntv2nubaccess.h"
+#include "ntv2nubtypes.h"
+#include "ntv2registerexpert.h"
 #include "ntv2signalrouter.h"
+#include "ntv2supportlogger.h"
 #include "ntv2routingexpert.h"
 #include "ntv2transcode.h"
 #include "ntv2utils.h"
 #include "ntv2vpid.h"
 #include "ntv2version.h"
 #include "ntv2testpatterngen.h"
+#include "ntv2timingrecorder.h"
+#include "ntv2streamring.h"
+#include "ntv2capturefile.h"
 #include "ajabase/system/debug.h"
 #include "ajabase/common/common.h"
+#include "ajabase/system/systemtime.h"
+#include "ajabase/system/thread.h"
 #include <vector>
+#include <deque>
 #include <algorithm>
 #include <iomanip>
+#include <fstream>
 #include <iterator>    //      For std::inserter
+#if defined(AJA_LINUX)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+#endif
 
 using namespace std;
 
@@ -652,6 +669,152 @@ TEST_SUITE("ntv2utils" * doctest::description("ntv2 utils functions")) {
 			}	//	for each pixel format
 		}	//	for each standard
 	}	//	TEST_CASE("SetRasterLinesBlack")
+
+	TEST_CASE("ReformatQuadFrame")
+	{
+		static const NTV2PixelFormat pixFmts[] = {NTV2_FBF_8BIT_YCBCR, NTV2_FBF_10BIT_YCBCR, NTV2_FBF_ARGB, NTV2_FBF_10BIT_RGB,
+													NTV2_FBF_24BIT_RGB, NTV2_FBF_48BIT_RGB, NTV2_FBF_8BIT_YCBCR_420PL3};
+		static const NTV2VideoFormat vidFmts[] = {NTV2_FORMAT_4x3840x2160p_2997, NTV2_FORMAT_4x4096x2160p_2997};
+		for (size_t vfNdx(0);  vfNdx < sizeof(vidFmts) / sizeof(NTV2VideoFormat);  vfNdx++)
+			for (size_t pfNdx(0);  pfNdx < sizeof(pixFmts) / sizeof(NTV2PixelFormat);  pfNdx++)
+		{
+			const NTV2PixelFormat pf(pixFmts[pfNdx]);
+			const NTV2FormatDescriptor fd(vidFmts[vfNdx], pf);
+			const bool isV210(pf == NTV2_FBF_10BIT_YCBCR);
+			const ULWord rowBytes(fd.GetBytesPerRow()),  width(fd.GetRasterWidth()),  height(fd.GetFullRasterHeight());
+			INFO(::NTV2VideoFormatToString(vidFmts[vfNdx]) << " " << ::NTV2FrameBufferFormatToString(pf));
+			NTV2Buffer raster(fd.GetTotalBytes()), squares(fd.GetTotalBytes()), tsi(fd.GetTotalBytes()), result(fd.GetTotalBytes());
+			if (isV210)
+			{	//	Must be legal 10-bit components, with zeroed padding, to survive unpack/repack...
+				raster.Fill(0ULL);
+				vector<UWord> comps(width * 2 + 12, 0);
+				for (ULWord line(0);  line < height;  line++)
+				{
+					for (ULWord ndx(0);  ndx < width * 2;  ndx++)
+						comps[ndx] = UWord((line * 7 + ndx * 13) & 0x3FF);
+					::PackLine_16BitYUVto10BitYUV(&comps[0], reinterpret_cast<ULWord*>(raster.GetHostAddress(line * rowBytes)), width);
+				}
+			}
+			else
+				for (ULWord ndx(0);  ndx < raster.GetByteCount();  ndx++)
+					raster.U8(int(ndx)) = UByte(ndx * 131 + (ndx >> 12));
+
+			//	Raster ==> Squares, compare with StackQuadrants...
+			CHECK(::ReformatQuadFrame(raster, NTV2_QUADLAYOUT_RASTER, squares, NTV2_QUADLAYOUT_SQUARES, fd));
+			if (!isV210  &&  !fd.IsPlanar())
+			{
+				result.Fill(0ULL);
+				::StackQuadrants(raster, width, height, rowBytes, result);
+				CHECK(result.IsContentEqual(squares));
+			}
+
+			//	Raster ==> TSI, compare sub-image pixel pairs with raster...
+			CHECK(::ReformatQuadFrame(raster, NTV2_QUADLAYOUT_RASTER, tsi, NTV2_QUADLAYOUT_TSI, fd, 4));
+			if (!isV210)
+			{
+				const ULWord pairBytes(rowBytes * 2 / width),  subImageBytes(height / 2 * rowBytes / 2);
+				bool same(true);
+				for (ULWord line(0);  line < height  &&  same;  line += 3)
+					for (ULWord pair(0);  pair < width / 2;  pair += 5)
+					{
+						const ULWord subImage((line & 1) * 2 + (pair & 1));
+						const UByte * pRaster(reinterpret_cast<const UByte*>(raster.GetHostAddress(line * rowBytes + pair * pairBytes)));
+						const UByte * pSub(reinterpret_cast<const UByte*>(tsi.GetHostAddress(subImage * subImageBytes + line / 2 * rowBytes / 2 + pair / 2 * pairBytes)));
+						same = ::memcmp(pRaster, pSub, pairBytes) == 0;
+					}
+				CHECK(same);
+			}
+			else
+			{
+				vector<UWord> rasterComps(width * 2 + 12), subComps(width + 12);
+				for (ULWord line(0);  line < 4;  line++)
+				{
+					::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(raster.GetHostAddress(line * rowBytes)), &rasterComps[0], width);
+					for (ULWord subImage((line & 1) * 2);  subImage < (line & 1) * 2 + 2;  subImage++)
+					{
+						::UnpackLine_10BitYUVto16BitYUV(reinterpret_cast<const ULWord*>(tsi.GetHostAddress(subImage * (height / 2) * (rowBytes / 2) + line / 2 * rowBytes / 2)),
+														&subComps[0], width / 2);
+						for (ULWord pair(0);  pair < width / 4;  pair++)
+							CHECK(std::equal(&subComps[pair * 4], &subComps[pair * 4 + 4], &rasterComps[(pair * 2 + (subImage & 1)) * 4]));
+					}
+				}
+			}
+
+			//	Round trips, single & multi-threaded, and Squares <==> TSI...
+			result.Fill(0ULL);
+			CHECK(::ReformatQuadFrame(squares, NTV2_QUADLAYOUT_SQUARES, result, NTV2_QUADLAYOUT_RASTER, fd, 1));
+			CHECK(result.IsContentEqual(raster));
+			result.Fill(0ULL);
+			CHECK(::ReformatQuadFrame(tsi, NTV2_QUADLAYOUT_TSI, result, NTV2_QUADLAYOUT_RASTER, fd));
+			CHECK(result.IsContentEqual(raster));
+			result.Fill(0ULL);
+			CHECK(::ReformatQuadFrame(squares, NTV2_QUADLAYOUT_SQUARES, result, NTV2_QUADLAYOUT_TSI, fd, 3));
+			CHECK(result.IsContentEqual(tsi));
+		}
+
+		//	Bad parameters...
+		const NTV2FormatDescriptor fd(NTV2_FORMAT_4x3840x2160p_2997, NTV2_FBF_8BIT_YCBCR);
+		NTV2Buffer src(fd.GetTotalBytes()), dst(fd.GetTotalBytes()), tooSmall(fd.GetTotalBytes() - 1);
+		CHECK_FALSE(::ReformatQuadFrame(src, NTV2_QUADLAYOUT_RASTER, tooSmall, NTV2_QUADLAYOUT_TSI, fd));
+		CHECK_FALSE(::ReformatQuadFrame(src, NTV2_QUADLAYOUT_RASTER, src, NTV2_QUADLAYOUT_TSI, fd));
+		CHECK_FALSE(::ReformatQuadFrame(src, NTV2_QUADLAYOUT_INVALID, dst, NTV2_QUADLAYOUT_TSI, fd));
+		CHECK_FALSE(::ReformatQuadFrame(src, NTV2_QUADLAYOUT_RASTER, dst, NTV2_QUADLAYOUT_TSI, NTV2FormatDescriptor()));
+		CHECK_FALSE(::ReformatQuadFrame(src, NTV2_QUADLAYOUT_RASTER, dst, NTV2_QUADLAYOUT_TSI,
+										NTV2FormatDescriptor(NTV2_FORMAT_4x3840x2160p_2997, NTV2_FBF_10BIT_YCBCR_DPX)));
+	}	//	TEST_CASE("ReformatQuadFrame")
+
+	TEST_CASE("RegionOfInterestXferInfo")
+	{
+		NTV2SegmentedXferInfo xfer;
+		const NTV2FormatDescriptor fd(NTV2_FORMAT_1080p_5994_A, NTV2_FBF_10BIT_YCBCR);
+		const ULWord rowBytes(fd.GetBytesPerRow());
+
+		//	Crop...
+		CHECK(fd.GetRegionOfInterestXferInfo(xfer, 960, 540, 480, 270));
+		CHECK_EQ(xfer.getSegmentCount(), 270);
+		CHECK_EQ(xfer.getSegmentLength(), 480 * 16 / 6);
+		CHECK_EQ(xfer.getSourceOffset(), 540 * rowBytes + 960 * 16 / 6);
+		CHECK_EQ(xfer.getSourcePitch(), rowBytes);
+		CHECK_EQ(xfer.getDestOffset(), 0);
+		CHECK_EQ(xfer.getDestPitch(), 480 * 16 / 6);
+
+		//	Every 4th line, full width...
+		CHECK(fd.GetRegionOfInterestXferInfo(xfer, 0, 0, 1920, 1080, 4));
+		CHECK_EQ(xfer.getSegmentCount(), 270);
+		CHECK_EQ(xfer.getSegmentLength(), rowBytes);
+		CHECK_EQ(xfer.getSourcePitch(), rowBytes * 4);
+
+		//	Field 2 of an interlaced raster, with the host buffer contents checked against the raster...
+		const NTV2FormatDescriptor fdi(NTV2_FORMAT_1080i_5994, NTV2_FBF_8BIT_YCBCR);
+		CHECK(fdi.GetRegionOfInterestXferInfo(xfer, 0, 1, 1920, 1079, 2));
+		CHECK_EQ(xfer.getSegmentCount(), 540);
+		NTV2Buffer frame(fdi.GetTotalBytes()), field(xfer.getTotalBytes());
+		for (ULWord line(0);  line < fdi.GetFullRasterHeight();  line++)
+			::memset(frame.GetHostAddress(line * fdi.GetBytesPerRow()), int(line & 0xFF), fdi.GetBytesPerRow());
+		CHECK(field.CopyFrom(frame, xfer));
+		CHECK_EQ(*reinterpret_cast<const UByte*>(field.GetHostAddress(0)), 1);
+		CHECK_EQ(*reinterpret_cast<const UByte*>(field.GetHostAddress(fdi.GetBytesPerRow())), 3);
+
+		//	AutoCirculate transfer setup...
+		AUTOCIRCULATE_TRANSFER xferStruct;
+		CHECK(xferStruct.SetVideoRegionOfInterest(reinterpret_cast<ULWord*>(field.GetHostPointer()), field.GetByteCount(), xfer));
+		CHECK(xferStruct.SegmentedDMAsEnabled());
+		CHECK_EQ(xferStruct.acVideoBuffer.GetByteCount(), fdi.GetBytesPerRow());
+		CHECK_EQ(xferStruct.acInVideoDMAOffset, fdi.GetBytesPerRow());
+		CHECK_EQ(xferStruct.acInSegmentedDMAInfo.acNumSegments, 540);
+		CHECK_EQ(xferStruct.acInSegmentedDMAInfo.acSegmentHostPitch, fdi.GetBytesPerRow());
+		CHECK_EQ(xferStruct.acInSegmentedDMAInfo.acSegmentDevicePitch, fdi.GetBytesPerRow() * 2);
+		CHECK_FALSE(xferStruct.SetVideoRegionOfInterest(reinterpret_cast<ULWord*>(field.GetHostPointer()), field.GetByteCount() - 1, xfer));
+
+		//	Bad parameters...
+		CHECK_FALSE(fd.GetRegionOfInterestXferInfo(xfer, 1, 0, 480, 270));		//	Not on a 6-pixel boundary
+		CHECK_FALSE(fd.GetRegionOfInterestXferInfo(xfer, 0, 0, 484, 270));		//	Not on a 6-pixel boundary
+		CHECK_FALSE(fd.GetRegionOfInterestXferInfo(xfer, 1920, 0, 6, 270));		//	Off the right edge
+		CHECK_FALSE(fd.GetRegionOfInterestXferInfo(xfer, 0, 1000, 6, 81));		//	Off the bottom edge
+		CHECK_FALSE(fd.GetRegionOfInterestXferInfo(xfer, 0, 0, 6, 270, 0));		//	Zero line step
+		CHECK_FALSE(xfer.isValid());
+		CHECK_FALSE(NTV2FormatDescriptor(NTV2_FORMAT_1080p_5994_A, NTV2_FBF_8BIT_YCBCR_420PL2).GetRegionOfInterestXferInfo(xfer, 0, 0, 6, 6));
+	}	//	TEST_CASE("RegionOfInterestXferInfo")
 }	//	TEST_SUITE("ntv2utils")
 
 void ntv2devicescanner_marker() {}
@@ -751,6 +914,84 @@ TEST_SUITE("ntv2devicescanner" * doctest::description("ntv2 device scanner funct
 		CHECK(geom_set.count(NTV2_FG_4x4096x2160) == 0);
 	}
 
+	class FakeDeviceSource : public NTV2DeviceSource
+	{
+		public:
+			explicit FakeDeviceSource (const bool inMonitored) : fMonitored(inMonitored), fIdentified(0), fOpened(0)	{}
+			virtual bool IdentifyDevice (const ULWord inIndex, NTV2DeviceID & outDeviceID, std::string & outSerialNumber)
+			{
+				fIdentified++;
+				if (inIndex >= fDevices.size())
+					return false;
+				outDeviceID = fDevices.at(inIndex).first;
+				outSerialNumber = fDevices.at(inIndex).second;
+				return true;
+			}
+			virtual bool OpenDevice (const ULWord inIndex, CNTV2Card & outDevice)	{(void)inIndex;  (void)outDevice;  fOpened++;  return false;}
+			virtual bool IsMonitored (void) const	{return fMonitored;}
+			void Attach (const NTV2DeviceID inDeviceID, const std::string & inSerial)
+			{
+				fDevices.push_back(std::make_pair(inDeviceID, inSerial));
+				if (fMonitored)
+					CNTV2DeviceScanner::DevicesChanged();
+			}
+			void Detach (const size_t inIndex)
+			{
+				fDevices.erase(fDevices.begin() + inIndex);
+				if (fMonitored)
+					CNTV2DeviceScanner::DevicesChanged();
+			}
+			bool fMonitored;
+			int fIdentified, fOpened;
+			std::vector<std::pair<NTV2DeviceID, std::string> > fDevices;
+	};
+
+	TEST_CASE("CNTV2DeviceScanner inventory")
+	{
+		NTV2DeviceID deviceID (DEVICE_ID_INVALID);
+		std::string serial;
+		FakeDeviceSource source(true);
+		source.Attach(DEVICE_ID_KONA4, "00T12345");
+		source.Attach(DEVICE_ID_IO4K, "00X54321");
+		CNTV2DeviceScanner::SetDeviceSource(&source);
+		CHECK_EQ(CNTV2DeviceScanner::GetNumDevices(), 2);
+		CHECK_EQ(source.fOpened, 2);	//	Each device probed once
+		const int identified (source.fIdentified);
+		CHECK_EQ(CNTV2DeviceScanner::GetNumDevices(), 2);
+		CHECK_EQ(source.fIdentified, identified);	//	Monitored -- no rescan
+		CHECK(CNTV2DeviceScanner::GetDeviceIdentity(1, deviceID, serial));
+		CHECK_EQ(deviceID, DEVICE_ID_IO4K);
+		CHECK_EQ(serial, "00X54321");
+		CHECK_FALSE(CNTV2DeviceScanner::GetDeviceIdentity(2, deviceID, serial));
+
+		//	Hot-plug...
+		source.Attach(DEVICE_ID_KONA5, "00Y11111");
+		CHECK_EQ(CNTV2DeviceScanner::GetNumDevices(), 3);
+		CHECK_EQ(source.fOpened, 3);	//	Only the new device probed
+		source.Detach(0);
+		CHECK_EQ(CNTV2DeviceScanner::GetNumDevices(), 2);
+		CHECK_EQ(source.fOpened, 3);	//	Re-numbered, not re-probed
+		CHECK(CNTV2DeviceScanner::GetDeviceIdentity(0, deviceID, serial));
+		CHECK_EQ(deviceID, DEVICE_ID_IO4K);
+		CHECK(CNTV2DeviceScanner::GetDeviceIdentity(1, deviceID, serial));
+		CHECK_EQ(deviceID, DEVICE_ID_KONA5);
+		CHECK_FALSE(CNTV2DeviceScanner::Refresh());
+		CNTV2Card card;
+		CHECK_FALSE(CNTV2DeviceScanner::GetDeviceWithSerial("00T12345", card));	//	Detached
+
+		//	Unmonitored source -- each lookup re-identifies, but still probes each device only once...
+		FakeDeviceSource unmonitored(false);
+		unmonitored.Attach(DEVICE_ID_KONA4, "00T12345");
+		CNTV2DeviceScanner::SetDeviceSource(&unmonitored);
+		CHECK_EQ(CNTV2DeviceScanner::GetNumDevices(), 1);
+		unmonitored.Attach(DEVICE_ID_IO4K, "00X54321");
+		CHECK_EQ(CNTV2DeviceScanner::GetNumDevices(), 2);
+		CHECK_EQ(CNTV2DeviceScanner::GetNumDevices(), 2);
+		CHECK_EQ(unmonitored.fOpened, 2);
+		CHECK_EQ(unmonitored.fIdentified, 2 + 3 + 3);
+		CNTV2DeviceScanner::SetDeviceSource(AJA_NULL);
+	}
+
 } // ntv2devicescanner
 
 void ntv2vpid_marker() {}
@@ -3038,6 +3279,30 @@ TEST_SUITE("NTV2Buffer" * doctest::description("NTV2Buffer tests"))
 			CHECK(buff16.Truncate(buff16.GetByteCount()-1));	//	Keep shortening by 1 byte
 	}	//	truncate_test
 
+	TEST_CASE("huge_pages")
+	{
+		const size_t byteCount(7680 * 4320 * 4);	//	8K 8-bit RGBA frame
+		NTV2Buffer buff;
+		CHECK_EQ(buff.GetPageSize(), 0);
+		REQUIRE(buff.AllocateHugePages(byteCount));
+		CHECK(buff.IsAllocatedBySDK());
+		CHECK(buff.IsPageAligned());
+		CHECK_EQ(buff.GetByteCount(), byteCount);
+		const size_t pageSize(buff.GetPageSize());
+		CHECK(pageSize >= NTV2Buffer::HostPageSize());
+		CHECK_EQ(uint64_t(buff.GetHostPointer()) % pageSize, 0);
+		CHECK(buff.IsContentEqual(NTV2Buffer(byteCount)));	//	Zeroed
+		CHECK(buff.Fill(UByte(0xA5)));
+		CHECK_EQ(buff.U8(int(byteCount) - 1), 0xA5);
+
+		//	Ordinary pages on NUMA node 0
+		REQUIRE(buff.AllocateHugePages(byteCount, NTV2Buffer::HostPageSize(), 0));
+		CHECK_EQ(buff.GetPageSize(), NTV2Buffer::HostPageSize());
+		CHECK(buff.Deallocate());
+		CHECK(buff.IsNULL());
+		CHECK_FALSE(buff.AllocateHugePages(byteCount, 3 * 1024 * 1024));	//	Not a power of 2
+	}	//	huge_pages
+
 	TEST_CASE("hexstring")
 	{
 		NTV2Buffer orig(256);
@@ -3185,6 +3450,202 @@ TEST_SUITE("signal router" * doctest::description("CNTV2SignalRouter & RoutingEx
 		CHECK(CNTV2SignalRouter::IsHDMIOutWidgetType(NTV2WidgetType_HDMIOutV5) == true);
 		CHECK(CNTV2SignalRouter::IsHDMIOutWidgetType(NTV2WidgetType_HDMIInV2) == false);
 	}
+
+	//	Stands in for an open device, capturing its register traffic
+	class RoutingMockDevice : public CNTV2Card
+	{
+		public:
+			explicit RoutingMockDevice (const NTV2DeviceID inDeviceID)
+				:	fReads(0), fBatchReads(0), fWrites(0), fBatchWrites(0)
+			{
+				_boardID = inDeviceID;
+				_boardOpened = true;
+				fRegs[kRegBoardID] = ULWord(inDeviceID);
+			}
+			virtual ~RoutingMockDevice ()	{_boardOpened = false;}
+			virtual bool IsSupported (const NTV2BoolParamID inParamID)
+			{
+				return inParamID == kDeviceHasXptConnectROM ? false : CNTV2Card::IsSupported(inParamID);
+			}
+			virtual bool ReadRegister (const ULWord inRegNum, ULWord & outValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+			{
+				fReads++;
+				outValue = (fRegs[inRegNum] & inMask) >> inShift;
+				return true;
+			}
+			virtual bool ReadRegisters (NTV2RegisterReads & inOutValues)
+			{
+				fBatchReads++;
+				for (size_t ndx(0);  ndx < inOutValues.size();  ndx++)
+					inOutValues[ndx].registerValue = (fRegs[inOutValues[ndx].registerNumber] & inOutValues[ndx].registerMask) >> inOutValues[ndx].registerShift;
+				return true;
+			}
+			virtual bool WriteRegister (const ULWord inRegNum, const ULWord inValue, const ULWord inMask = 0xFFFFFFFF, const ULWord inShift = 0)
+			{
+				fWrites++;
+				fRegs[inRegNum] = (fRegs[inRegNum] & ~inMask) | ((inValue << inShift) & inMask);
+				return true;
+			}
+			virtual bool WriteRegisters (const NTV2RegisterWrites & inRegWrites)
+			{
+				fBatchWrites++;
+				fLastBatch = inRegWrites;
+				for (size_t ndx(0);  ndx < inRegWrites.size();  ndx++)
+				{
+					const NTV2RegInfo & info (inRegWrites[ndx]);
+					fRegs[info.registerNumber] = (fRegs[info.registerNumber] & ~info.registerMask) | ((info.registerValue << info.registerShift) & info.registerMask);
+				}
+				return true;
+			}
+			std::map<ULWord, ULWord>	fRegs;
+			NTV2RegisterWrites			fLastBatch;
+			int	fReads, fBatchReads, fWrites, fBatchWrites;
+	};
+
+	TEST_CASE("CNTV2SignalRouter route transactions") {
+		//	Diff...
+		NTV2XptConnections current, desired, changes;
+		current[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer1YUV;
+		current[NTV2_XptSDIOut2Input] = NTV2_XptFrameBuffer2YUV;
+		desired[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer1YUV;
+		desired[NTV2_XptSDIOut3Input] = NTV2_XptFrameBuffer3YUV;
+		CHECK_FALSE(CNTV2SignalRouter::DiffConnections(current, desired, false, changes));
+		CHECK_EQ(changes.size(), 1);
+		CHECK_EQ(changes[NTV2_XptSDIOut3Input], NTV2_XptFrameBuffer3YUV);
+		CHECK_FALSE(CNTV2SignalRouter::DiffConnections(current, desired, true, changes));
+		CHECK_EQ(changes.size(), 2);
+		CHECK_EQ(changes[NTV2_XptSDIOut2Input], NTV2_XptBlack);
+		CHECK(CNTV2SignalRouter::DiffConnections(current, current, true, changes));
+		CHECK(changes.empty());
+
+		//	One masked write per crosspoint select register...
+		NTV2RegisterWrites regWrites;
+		std::set<ULWord> regNums;
+		CHECK(CNTV2SignalRouter::GetConnectionRegisterWrites(current, regWrites));
+		for (NTV2XptConnectionsConstIter it(current.begin());  it != current.end();  ++it)
+		{
+			ULWord regNum(0), ndx(0);
+			CHECK(CNTV2RegisterExpert::GetCrosspointSelectGroupRegisterInfo(it->first, regNum, ndx));
+			regNums.insert(regNum);
+			NTV2RegisterWritesConstIter regIt (::FindFirstMatchingRegisterNumber(regNum, regWrites));
+			REQUIRE(regIt != regWrites.end());
+			CHECK_EQ((regIt->registerMask >> (ndx * 8)) & 0xFF, 0xFF);
+			CHECK_EQ((regIt->registerValue >> (ndx * 8)) & 0xFF, ULWord(it->second));
+		}
+		CHECK_EQ(regWrites.size(), regNums.size());
+
+		//	Validation against the widget tables and (optional) ROM...
+		NTV2XptConnections invalid, conns;
+		conns[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer1YUV;
+		conns[NTV2_XptLUT1Input] = NTV2_XptFrameBuffer1RGB;
+		CHECK(CNTV2SignalRouter::ValidateConnections(DEVICE_ID_KONA5, conns, invalid));
+		conns[NTV2_XptLUT2Input] = NTV2_XptFrameBuffer2YUV;		//	YUV into RGB-only input
+		conns[NTV2_XptSDIOut2Input] = NTV2_OUTPUT_CROSSPOINT_INVALID;
+		CHECK_FALSE(CNTV2SignalRouter::ValidateConnections(DEVICE_ID_KONA5, conns, invalid));
+		CHECK_EQ(invalid.size(), 2);
+		CHECK(invalid.find(NTV2_XptLUT2Input) != invalid.end());
+		NTV2PossibleConnections possible;
+		possible.insert(NTV2XptConnection(NTV2_XptSDIOut1Input, NTV2_XptFrameBuffer2YUV));
+		conns.clear();
+		conns[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer1YUV;
+		CHECK_FALSE(CNTV2SignalRouter::ValidateConnections(DEVICE_ID_KONA5, conns, invalid, possible));
+		conns[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer2YUV;
+		CHECK(CNTV2SignalRouter::ValidateConnections(DEVICE_ID_KONA5, conns, invalid, possible));
+
+		//	Solver:  RGB FrameStores to SDI outputs need CSCs, YUV ones don't...
+		NTV2RouteConstraints routes;
+		NTV2XptConnections solved;
+		for (NTV2Channel ch(NTV2_CHANNEL1);  ch < NTV2_CHANNEL4;  ch = NTV2Channel(ch+1))
+			routes.push_back(NTV2RouteConstraint(CNTV2SignalRouter::WidgetIDFromTypeAndChannel(NTV2WidgetType_FrameStore, ch),
+												::GetSDIOutputInputXpt(ch), NTV2_FBF_ABGR));
+		routes.push_back(NTV2RouteConstraint(NTV2_WgtFrameBuffer4, NTV2_XptSDIOut4Input, NTV2_FBF_10BIT_YCBCR));
+		CHECK(CNTV2SignalRouter::SolveRoute(DEVICE_ID_KONA5, routes, solved));
+		CHECK_EQ(solved.size(), 7);
+		CHECK_EQ(solved[NTV2_XptCSC1VidInput], NTV2_XptFrameBuffer1RGB);
+		CHECK_EQ(solved[NTV2_XptSDIOut1Input], NTV2_XptCSC1VidYUV);
+		CHECK_EQ(solved[NTV2_XptCSC3VidInput], NTV2_XptFrameBuffer3RGB);
+		CHECK_EQ(solved[NTV2_XptSDIOut3Input], NTV2_XptCSC3VidYUV);
+		CHECK_EQ(solved[NTV2_XptSDIOut4Input], NTV2_XptFrameBuffer4YUV);
+		CHECK(CNTV2SignalRouter::ValidateConnections(DEVICE_ID_KONA5, solved, invalid));
+
+		//	Capture:  SDI input into an RGB FrameStore...
+		routes.clear();
+		routes.push_back(NTV2RouteConstraint(NTV2_Wgt3GSDIIn2, NTV2_XptFrameBuffer2Input, NTV2_FBF_10BIT_RGB));
+		CHECK(CNTV2SignalRouter::SolveRoute(DEVICE_ID_KONA5, routes, solved));
+		CHECK_EQ(solved.size(), 2);
+		CHECK_EQ(solved[NTV2_XptCSC2VidInput], NTV2_XptSDIIn2);
+		CHECK_EQ(solved[NTV2_XptFrameBuffer2Input], NTV2_XptCSC2VidRGB);
+
+		//	Unsatisfiable:  sink used twice, or widget not on device...
+		routes.push_back(NTV2RouteConstraint(NTV2_WgtFrameBuffer1, NTV2_XptFrameBuffer2Input, NTV2_FBF_10BIT_RGB));
+		CHECK_FALSE(CNTV2SignalRouter::SolveRoute(DEVICE_ID_KONA5, routes, solved));
+		CHECK(solved.empty());
+		routes.clear();
+		routes.push_back(NTV2RouteConstraint(NTV2_WgtAnalogIn1, NTV2_XptSDIOut1Input));
+		CHECK_FALSE(CNTV2SignalRouter::SolveRoute(DEVICE_ID_KONA5, routes, solved));
+
+		//	Apply to the mock device in one batch, then apply only what changed...
+		routes.clear();
+		for (NTV2Channel ch(NTV2_CHANNEL1);  ch <= NTV2_CHANNEL4;  ch = NTV2Channel(ch+1))
+			routes.push_back(NTV2RouteConstraint(CNTV2SignalRouter::WidgetIDFromTypeAndChannel(NTV2WidgetType_FrameStore, ch),
+												::GetSDIOutputInputXpt(ch), NTV2_FBF_ABGR));
+		REQUIRE(CNTV2SignalRouter::SolveRoute(DEVICE_ID_KONA5, routes, solved));
+		RoutingMockDevice device(DEVICE_ID_KONA5);
+		CHECK(device.ApplySignalRoute(solved, true, changes));
+		CHECK_EQ(changes, solved);
+		CHECK_EQ(device.fBatchWrites, 1);
+		CHECK_EQ(device.fWrites, 0);
+		CHECK(CNTV2SignalRouter::GetConnectionRegisterWrites(solved, regWrites));
+		CHECK_EQ(device.fLastBatch.size(), regWrites.size());
+		CHECK(regWrites.size() < solved.size());	//	Byte lanes folded
+		CHECK(device.GetConnections(current));
+		CHECK_EQ(current, solved);
+
+		CHECK(device.ApplySignalRoute(solved));		//	No change -- no writes
+		CHECK_EQ(device.fBatchWrites, 1);
+
+		desired = solved;
+		desired[NTV2_XptSDIOut4Input] = NTV2_XptFrameBuffer4YUV;
+		desired.erase(NTV2_XptCSC4VidInput);
+		CHECK(device.ApplySignalRoute(desired, true, changes));
+		CHECK_EQ(changes.size(), 2);
+		CHECK_EQ(changes[NTV2_XptCSC4VidInput], NTV2_XptBlack);
+		CHECK_EQ(device.fBatchWrites, 2);
+		CHECK(device.GetConnections(current));
+		CHECK_EQ(current, desired);
+
+		conns.clear();
+		conns[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer2YUV;
+		conns[NTV2_XptLUT1Input] = NTV2_XptFrameBuffer1YUV;		//	Invalid -- nothing gets written
+		CHECK_FALSE(device.ApplySignalRoute(conns, false, changes));
+		CHECK_EQ(device.fBatchWrites, 2);
+		CHECK(device.GetConnections(current));
+		CHECK_EQ(current, desired);
+
+		//	The legacy overload is best effort:  it skips the invalid connection, applies the rest, and fails...
+		CHECK_FALSE(device.ApplySignalRoute(conns));
+		CHECK_EQ(device.fBatchWrites, 3);
+		desired[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer2YUV;
+		CHECK(device.GetConnections(current));
+		CHECK_EQ(current, desired);
+
+		conns = desired;
+		conns[NTV2_XptAnalogOutInput] = NTV2_XptBlack;	//	No analog output on this device -- skipped
+		CHECK_FALSE(device.RemoveConnections(conns));
+		CHECK_EQ(device.fBatchWrites, 4);
+		CHECK(device.GetConnections(current));
+		CHECK(current.empty());
+		CHECK_EQ(device.fWrites, 0);
+
+		//	No widget table to validate against:  the legacy overload still applies the connections...
+		RoutingMockDevice unknown(DEVICE_ID_NOTFOUND);
+		conns.clear();
+		conns[NTV2_XptSDIOut1Input] = NTV2_XptFrameBuffer1YUV;
+		CHECK_FALSE(unknown.ApplySignalRoute(conns, false, changes));	//	Can't validate -- all or nothing
+		CHECK_EQ(unknown.fBatchWrites, 0);
+		CHECK(unknown.ApplySignalRoute(conns));
+		CHECK_EQ(unknown.fBatchWrites, 1);
+	}
 }
 
 
@@ -3672,3 +4133,939 @@ TEST_SUITE("NTV2ScanMethod" * doctest::description("NTV2ScanMethod tests"))
 		}
 	}	//	TEST_CASE("ScanMethodMacros")
 }	//	TEST_SUITE("NTV2ScanMethod")
+
+
+void ntv2nub_marker() {}
+TEST_SUITE("ntv2nub" * doctest::description("ntv2 nub RPC encode/decode functions")) {
+
+	TEST_CASE("PUSH/POP Scalars")
+	{
+		using namespace ntv2nub;
+		UByteSequence blob;
+		PUSHU8(0x12, blob);
+		PUSHU16(0x3456, blob);
+		PUSHU32(0x789ABCDE, blob);
+		PUSHU64(0x0123456789ABCDEFULL, blob);
+		CHECK_EQ(blob.size(), size_t(15));
+		CHECK_EQ(blob.at(1), 0x34);		//	BigEndian on the wire
+		CHECK_EQ(blob.at(3), 0x78);
+		CHECK_EQ(blob.at(7), 0x01);
+		size_t ndx(0);
+		uint8_t u8(0);  uint16_t u16(0);  uint32_t u32(0);  uint64_t u64(0);
+		POPU8(u8, blob, ndx);
+		POPU16(u16, blob, ndx);
+		POPU32(u32, blob, ndx);
+		POPU64(u64, blob, ndx);
+		CHECK_EQ(u8, 0x12);
+		CHECK_EQ(u16, 0x3456);
+		CHECK_EQ(u32, 0x789ABCDE);
+		CHECK_EQ(u64, 0x0123456789ABCDEFULL);
+		CHECK_EQ(ndx, blob.size());
+	}	//	TEST_CASE("PUSH/POP Scalars")
+
+	TEST_CASE("PUSH/POP Arrays")
+	{
+		using namespace ntv2nub;
+		vector<uint32_t> u32s;  vector<uint64_t> u64s;
+		for (uint32_t n(0);  n < 37;  n++)	//	Odd count exercises SIMD tail handling
+			{u32s.push_back(0x01020304 * n + n);  u64s.push_back(0x0102030405060708ULL * n + n);}
+		UByteSequence bulk, scalar;
+		RESERVE(bulk, u32s.size() * 4 + u64s.size() * 8);
+		CHECK(bulk.capacity() >= u32s.size() * 4 + u64s.size() * 8);
+		PUSHU32s(&u32s[0], u32s.size(), bulk);
+		PUSHU64s(&u64s[0], u64s.size(), bulk);
+		for (size_t n(0);  n < u32s.size();  n++)
+			PUSHU32(u32s[n], scalar);
+		for (size_t n(0);  n < u64s.size();  n++)
+			PUSHU64(u64s[n], scalar);
+		CHECK(bulk == scalar);	//	Bulk & scalar encodings must be identical
+
+		vector<uint32_t> outU32s(u32s.size());  vector<uint64_t> outU64s(u64s.size());
+		size_t ndx(0);
+		CHECK(POPU32s(&outU32s[0], outU32s.size(), bulk, ndx));
+		CHECK(POPU64s(&outU64s[0], outU64s.size(), bulk, ndx));
+		CHECK(outU32s == u32s);
+		CHECK(outU64s == u64s);
+		CHECK_EQ(ndx, bulk.size());
+		CHECK_FALSE(POPU32s(&outU32s[0], 1, bulk, ndx));	//	Past end
+		CHECK_EQ(ndx, bulk.size());							//	Index unchanged on failure
+
+		const uint8_t * pRef(AJA_NULL);
+		ndx = 4;
+		CHECK(POPREF(pRef, 8, bulk, ndx));
+		CHECK_EQ(pRef, &bulk[4]);
+		CHECK_EQ(ndx, size_t(12));
+		CHECK_FALSE(POPREF(pRef, bulk.size(), bulk, ndx));
+	}	//	TEST_CASE("PUSH/POP Arrays")
+
+	TEST_CASE("NubGatherBlob")
+	{
+		using namespace ntv2nub;
+		vector<uint8_t> bigPayload(64 * 1024), smallPayload(16);
+		for (size_t n(0);  n < bigPayload.size();  n++)
+			bigPayload[n] = uint8_t(n * 7);
+		for (size_t n(0);  n < smallPayload.size();  n++)
+			smallPayload[n] = uint8_t(n + 100);
+
+		NubGatherBlob gb;
+		PUSHU32(uint32_t(bigPayload.size()), gb.Blob());
+		gb.PushRef(&bigPayload[0], bigPayload.size());		//	Referenced, not copied
+		PUSHU32(uint32_t(smallPayload.size()), gb.Blob());
+		gb.PushRef(&smallPayload[0], smallPayload.size());	//	Small -- copied inline
+		PUSHU32(0xFEEDFACE, gb.Blob());
+		CHECK_EQ(gb.GetRefCount(), size_t(1));
+		CHECK_EQ(gb.Blob().size(), size_t(4 + 4 + 16 + 4));
+		CHECK_EQ(gb.GetByteCount(), gb.Blob().size() + bigPayload.size());
+
+		NubIOSegments segs;
+		gb.GetSegments(segs);
+		REQUIRE_EQ(segs.size(), size_t(3));
+		CHECK_EQ(segs.at(1).fAddr, &bigPayload[0]);
+		CHECK_EQ(segs.at(1).fByteCount, bigPayload.size());
+
+		UByteSequence flat;
+		gb.Flatten(flat);
+		CHECK_EQ(flat.size(), gb.GetByteCount());
+		size_t ndx(0);  uint32_t u32(0);
+		POPU32(u32, flat, ndx);
+		CHECK_EQ(u32, bigPayload.size());
+		const uint8_t * pRef(AJA_NULL);
+		CHECK(POPREF(pRef, u32, flat, ndx));
+		CHECK(std::equal(bigPayload.begin(), bigPayload.end(), pRef));
+		POPU32(u32, flat, ndx);
+		CHECK_EQ(u32, smallPayload.size());
+		CHECK(POPREF(pRef, u32, flat, ndx));
+		CHECK(std::equal(smallPayload.begin(), smallPayload.end(), pRef));
+		POPU32(u32, flat, ndx);
+		CHECK_EQ(u32, 0xFEEDFACE);
+		CHECK_EQ(ndx, flat.size());
+
+		gb.Clear();
+		CHECK_EQ(gb.GetByteCount(), size_t(0));
+	}	//	TEST_CASE("NubGatherBlob")
+}	//	TEST_SUITE("ntv2nub")
+
+
+//	A loopback NTV2RPCServerAPI/NTV2RPCClientAPI pair that simulates a network link with a fixed round-trip time.
+//	The server owns a simulated register file, and services requests on its own thread once each one's
+//	round-trip time has elapsed. It counts the messages it receives, and the most it ever had in flight,
+//	so one-at-a-time, batched and pipelined register access can be compared without relying on timing.
+//	While paused, it queues requests without servicing them. While refusing, it rejects them, like a dropped link.
+class LoopbackClient;
+class LoopbackServer : public NTV2RPCServerAPI
+{
+	public:
+		typedef struct Request
+		{
+			NTV2RPCRequestID	fID;
+			LoopbackClient *	fpClient;
+			NTV2_HEADER *		fpMessage;		//	NTV2SetRegisters message, or...
+			NTV2RegInfo *		fpRegRead;		//	...single register read, or...
+			INTERRUPT_ENUMS		fInterrupt;		//	...interrupt notification (if fID is zero)
+			uint64_t			fDueUs;
+		} Request;
+
+		explicit LoopbackServer (const uint32_t inRTTMicroseconds)
+			:	NTV2RPCServerAPI(NTV2ConfigParams(), AJA_NULL), mRTTus(inRTTMicroseconds), mNumMessages(0), mMaxPending(0), mPaused(false), mRefusing(false)
+		{
+			mThread.Attach(ServerThreadStatic, this);
+			mThread.Start();
+		}
+		virtual ~LoopbackServer ()
+		{
+			Stop();
+			mThread.Stop();
+		}
+		virtual void	RunServer (void);
+		bool			Enqueue (LoopbackClient * pClient, const NTV2RPCRequestID inID, NTV2_HEADER * pMsg, NTV2RegInfo * pRegRead)
+		{
+			const Request req = {inID, pClient, pMsg, pRegRead, eNumInterruptTypes, AJATime::GetSystemMicroseconds() + mRTTus};
+			AJAAutoLock tmp(&mLock);
+			if (mRefusing)
+				return false;
+			mQueue.push_back(req);
+			mNumMessages++;
+			if (mQueue.size() > mMaxPending)
+				mMaxPending = uint32_t(mQueue.size());
+			return true;
+		}
+		void			PushInterrupt (LoopbackClient * pClient, const INTERRUPT_ENUMS inInterrupt)
+		{
+			const Request req = {0, pClient, AJA_NULL, AJA_NULL, inInterrupt, AJATime::GetSystemMicroseconds() + mRTTus / 2};
+			AJAAutoLock tmp(&mLock);
+			mQueue.push_back(req);
+		}
+		ULWord			Register (const ULWord inRegNum)	{AJAAutoLock tmp(&mLock);  return mRegs[inRegNum];}
+		uint32_t		NumMessages (void) const			{AJAAutoLock tmp(&mLock);  return mNumMessages;}
+		void			ResetNumMessages (void)				{AJAAutoLock tmp(&mLock);  mNumMessages = mMaxPending = 0;}
+		uint32_t		MaxPending (void) const				{AJAAutoLock tmp(&mLock);  return mMaxPending;}	//	Most requests ever in flight
+		size_t			Pending (void) const				{AJAAutoLock tmp(&mLock);  return mQueue.size();}
+		void			Pause (const bool inPause = true)	{AJAAutoLock tmp(&mLock);  mPaused = inPause;}
+		void			Refuse (const bool inRefuse = true)	{AJAAutoLock tmp(&mLock);  mRefusing = inRefuse;}
+
+	private:
+		static void		ServerThreadStatic (AJAThread * pThread, void * pContext)
+		{	(void) pThread;
+			reinterpret_cast<LoopbackServer*>(pContext)->RunServer();
+		}
+
+		AJAThread				mThread;
+		mutable AJALock			mLock;
+		std::deque<Request>		mQueue;
+		NTV2RegisterValueMap	mRegs;
+		const uint32_t			mRTTus;
+		uint32_t				mNumMessages;
+		uint32_t				mMaxPending;
+		bool					mPaused;
+		bool					mRefusing;
+};	//	LoopbackServer
+
+class LoopbackClient : public NTV2RPCClientAPI
+{
+	public:
+		explicit LoopbackClient (LoopbackServer & inServer)
+			:	NTV2RPCClientAPI(NTV2ConnectParams(), AJA_NULL), mServer(inServer)	{}
+		virtual bool	IsConnected (void) const	{return true;}
+		virtual bool	NTV2CloseRemote (void)		{return true;}
+		virtual bool	NTV2SubmitMessageRemote (NTV2_HEADER * pInMessage, NTV2RPCRequestID & outRequestID)
+		{
+			if (!pInMessage  ||  pInMessage->GetType() != NTV2_TYPE_SETREGS)
+				return false;	//	Loopback only handles NTV2SetRegisters
+			outRequestID = NextRequestID();
+			if (mServer.Enqueue(this, outRequestID, pInMessage, AJA_NULL))
+				return true;
+			CancelRequest(outRequestID);	//	Couldn't send it
+			return false;
+		}
+		virtual bool	NTV2MessageRemote (NTV2_HEADER * pInMessage)
+		{
+			NTV2RPCRequestID id(0);
+			return NTV2SubmitMessageRemote(pInMessage, id)  &&  NTV2CompleteMessageRemote(id, 1000);
+		}
+		virtual bool	NTV2ReadRegisterRemote (const ULWord regNum, ULWord & outRegValue, const ULWord regMask, const ULWord regShift)
+		{
+			NTV2RegInfo regInfo(regNum, 0, regMask, regShift);
+			const NTV2RPCRequestID id(NextRequestID());
+			if (!mServer.Enqueue(this, id, AJA_NULL, &regInfo))
+				{CancelRequest(id);  return false;}
+			if (!NTV2CompleteMessageRemote(id, 1000))
+				return false;
+			outRegValue = regInfo.registerValue;
+			return true;
+		}
+		virtual bool	NTV2WriteRegisterRemote (const ULWord regNum, const ULWord regValue, const ULWord regMask, const ULWord regShift)
+		{
+			NTV2SetRegisters setRegs(NTV2RegWrites(1, NTV2RegInfo(regNum, regValue, regMask, regShift)));
+			return NTV2MessageRemote(setRegs);
+		}
+		virtual bool	NTV2SubscribeInterruptRemote (const INTERRUPT_ENUMS inInterrupt, const bool inSubscribe = true)
+		{
+			return SetInterruptSubscribed(inInterrupt, inSubscribe);	//	Loopback server always pushes
+		}
+		using NTV2RPCClientAPI::PostCompletion;
+		using NTV2RPCClientAPI::PostInterrupt;
+
+	private:
+		LoopbackServer &	mServer;
+};	//	LoopbackClient
+
+void LoopbackServer::RunServer (void)
+{
+	mRunning = true;
+	while (!mTerminate  &&  !mThread.Terminate())
+	{
+		Request req;
+		{	AJAAutoLock tmp(&mLock);
+			if (mPaused  ||  mQueue.empty()  ||  mQueue.front().fDueUs > AJATime::GetSystemMicroseconds())
+				req.fpClient = AJA_NULL;
+			else
+				{req = mQueue.front();  mQueue.pop_front();}
+		}
+		if (!req.fpClient)
+			{AJATime::SleepInMicroseconds(20);  continue;}
+		if (!req.fID)
+			{req.fpClient->PostInterrupt(req.fInterrupt);  continue;}
+		bool ok(true);
+		if (req.fpRegRead)
+		{	AJAAutoLock tmp(&mLock);
+			req.fpRegRead->registerValue = (mRegs[req.fpRegRead->registerNumber] & req.fpRegRead->registerMask) >> req.fpRegRead->registerShift;
+		}
+		else
+		{	NTV2RegWrites regWrites;
+			ok = reinterpret_cast<NTV2SetRegisters*>(req.fpMessage)->GetRequestedRegisterWrites(regWrites);
+			AJAAutoLock tmp(&mLock);
+			for (size_t ndx(0);  ndx < regWrites.size();  ndx++)
+			{	const NTV2RegInfo & ri (regWrites.at(ndx));
+				ULWord & reg (mRegs[ri.registerNumber]);
+				reg = (reg & ~ri.registerMask) | ((ri.registerValue << ri.registerShift) & ri.registerMask);
+			}
+		}
+		req.fpClient->PostCompletion(req.fID, ok);
+	}
+	mRunning = false;
+}	//	RunServer
+
+TEST_SUITE("ntv2rpc" * doctest::description("ntv2 RPC client batching & pipelining")) {
+
+	TEST_CASE("NTV2RPCClientAPI Loopback")
+	{
+		static const uint32_t	kRTTus		(200);	//	Simulated round-trip time
+		static const ULWord		kNumRegs	(100);
+		LoopbackServer	server(kRTTus);
+		LoopbackClient	client(server);
+		NTV2RegWrites	regWrites;
+		for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+			regWrites.push_back(NTV2RegInfo(1000 + ndx, 0xA5000000 | ndx));
+
+		SUBCASE("One-at-a-time vs. batched vs. pipelined")
+		{
+			//	One message & round-trip per register write...
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				CHECK(client.NTV2WriteRegisterRemote(regWrites.at(ndx).registerNumber, regWrites.at(ndx).registerValue, 0xFFFFFFFF, 0));
+			CHECK_EQ(server.NumMessages(), kNumRegs);
+			CHECK_EQ(server.MaxPending(), 1);	//	Each write waited for the previous one's round-trip
+
+			//	One message for all register writes...
+			server.ResetNumMessages();
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				regWrites.at(ndx).registerValue ^= 0x00FF0000;
+			NTV2RegWrites failures;
+			CHECK(client.NTV2WriteRegistersRemote(regWrites, failures));
+			CHECK(failures.empty());
+			CHECK_EQ(server.NumMessages(), 1);
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				CHECK_EQ(server.Register(regWrites.at(ndx).registerNumber), regWrites.at(ndx).registerValue);
+
+			//	One message per register write, but all in flight at once...
+			server.ResetNumMessages();
+			std::vector<NTV2SetRegisters*> msgs;
+			std::vector<NTV2RPCRequestID> ids(kNumRegs, 0);
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				msgs.push_back(new NTV2SetRegisters(NTV2RegWrites(1, NTV2RegInfo(regWrites.at(ndx).registerNumber, ndx))));
+			server.Pause();		//	Prove that none has to complete before the next is submitted
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				CHECK(client.NTV2SubmitMessageRemote(*msgs.at(ndx), ids.at(ndx)));
+			CHECK_EQ(client.NTV2OutstandingRemote(), kNumRegs);
+			CHECK_EQ(server.Pending(), kNumRegs);
+			CHECK_FALSE(client.NTV2CompleteMessageRemote(ids.back(), 0));	//	Not serviced yet
+			server.Pause(false);
+			for (ULWord ndx(kNumRegs);  ndx > 0;  ndx--)	//	Collect in reverse order
+				CHECK(client.NTV2CompleteMessageRemote(ids.at(ndx-1), 1000));
+			CHECK_EQ(client.NTV2OutstandingRemote(), 0);
+			CHECK_EQ(server.NumMessages(), kNumRegs);
+			CHECK_EQ(server.MaxPending(), kNumRegs);
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				{CHECK_EQ(server.Register(regWrites.at(ndx).registerNumber), ndx);  delete msgs.at(ndx);}
+			CHECK_FALSE(client.NTV2CompleteMessageRemote(ids.front(), 0));	//	Already collected
+		}
+
+		SUBCASE("Requests that aren't pending")
+		{
+			NTV2SetRegisters setRegs(NTV2RegWrites(1, NTV2RegInfo(1000, 1)));
+			NTV2RPCRequestID id(0);
+			CHECK(client.NTV2SubmitMessageRemote(setRegs, id));
+			CHECK(client.NTV2CompleteMessageRemote(id, 1000));
+			//	Collecting it again fails at once, instead of waiting out the (default, very long) timeout...
+			const uint64_t startMs (AJATime::GetSystemMilliseconds());
+			CHECK_FALSE(client.NTV2CompleteMessageRemote(id));
+			CHECK_FALSE(client.NTV2CompleteMessageRemote(id + 1000));	//	Never submitted
+			CHECK(AJATime::GetSystemMilliseconds() - startMs < 1000);
+			CHECK_FALSE(client.PostCompletion(id, true));	//	Late reply for a collected request is ignored
+			CHECK_EQ(client.NTV2OutstandingRemote(), 0);
+
+			//	A submit that fails doesn't leave the request outstanding...
+			server.Refuse();
+			CHECK_FALSE(client.NTV2SubmitMessageRemote(setRegs, id));
+			CHECK_EQ(client.NTV2OutstandingRemote(), 0);
+			CHECK_FALSE(client.NTV2CompleteMessageRemote(id));
+			ULWord value(0);
+			CHECK_FALSE(client.NTV2ReadRegisterRemote(1000, value, 0xFFFFFFFF, 0));
+			CHECK_EQ(client.NTV2OutstandingRemote(), 0);
+			server.Refuse(false);
+			CHECK(client.NTV2ReadRegisterRemote(1000, value, 0xFFFFFFFF, 0));
+			CHECK_EQ(value, 1);
+		}
+
+		SUBCASE("Batched reads")
+		{
+			NTV2RegWrites failures;
+			CHECK(client.NTV2WriteRegistersRemote(regWrites, failures));
+			NTV2RegReads regReads;
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				regReads.push_back(NTV2RegInfo(regWrites.at(ndx).registerNumber));
+			CHECK(client.NTV2ReadRegistersRemote(regReads));	//	Falls back to single reads (loopback lacks NTV2GetRegisters)
+			for (ULWord ndx(0);  ndx < kNumRegs;  ndx++)
+				CHECK_EQ(regReads.at(ndx).registerValue, regWrites.at(ndx).registerValue);
+		}
+
+		SUBCASE("Server-pushed interrupts")
+		{
+			CHECK_FALSE(client.IsInterruptSubscribed(eOutput1));
+			CHECK_FALSE(client.NTV2WaitForInterruptRemote(eOutput1, 10));	//	Not subscribed, no polling fallback
+			CHECK(client.NTV2SubscribeInterruptRemote(eOutput1));
+			CHECK(client.IsInterruptSubscribed(eOutput1));
+			server.PushInterrupt(&client, eOutput1);
+			CHECK(client.NTV2WaitForInterruptRemote(eOutput1, 1000));
+			CHECK_FALSE(client.NTV2WaitForInterruptRemote(eOutput1, 10));	//	No more pushed
+			CHECK(client.PostInterrupt(eOutput1));		//	Arrives before anyone waits...
+			CHECK(client.PostInterrupt(eOutput1));
+			CHECK(client.NTV2WaitForInterruptRemote(eOutput1, 0));			//	...isn't lost...
+			CHECK_FALSE(client.NTV2WaitForInterruptRemote(eOutput1, 10));	//	...and both are consumed by one wait
+			CHECK(client.NTV2SubscribeInterruptRemote(eOutput1, false));
+			CHECK_FALSE(client.IsInterruptSubscribed(eOutput1));
+			CHECK_FALSE(client.PostInterrupt(eOutput1));
+		}
+	}	//	TEST_CASE("NTV2RPCClientAPI Loopback")
+}	//	TEST_SUITE("ntv2rpc")
+
+
+TEST_SUITE("ntv2supportlogger" * doctest::description("CNTV2SupportLogger tests")) {
+
+	TEST_CASE("ExpandDeviceSDRAMDump")
+	{
+		static const char * kDumpPath ("ut_sdram_dump.rle"),  * kRawPath ("ut_sdram_dump.raw");
+		//	A sparse dump of four 8-word frames:  frame 0 is 2 literals + a run of 6;  frame 2 is a single run of 8;
+		//	frames 1 & 3 are missing (failed to DMA)
+		static const ULWord kDump[] = {	8*sizeof(ULWord), 4,
+										0,	5*sizeof(ULWord),	2, 0x11111111, 0x22222222,  0x80000006, 0xDEADBEEF,
+										2,	2*sizeof(ULWord),	0x80000008, 0x5A5A5A5A};
+		std::ostringstream msgs;
+		{
+			std::ofstream ofs (kDumpPath, std::ios::binary);
+			ofs.write("NTV2SDRZ", 8);
+			for (size_t ndx(0);  ndx < sizeof(kDump) / sizeof(ULWord);  ndx++)
+				{const ULWord word(NTV2EndianSwap32HtoL(kDump[ndx]));  ofs.write(reinterpret_cast<const char*>(&word), sizeof(word));}
+		}
+		CHECK(CNTV2SupportLogger::ExpandDeviceSDRAMDump(kDumpPath, kRawPath, msgs));
+		ULWord raw[33];
+		std::ifstream ifs (kRawPath, std::ios::binary);
+		ifs.read(reinterpret_cast<char*>(raw), sizeof(raw));
+		CHECK_EQ(ifs.gcount(), std::streamsize(32 * sizeof(ULWord)));	//	All four frames
+		CHECK_EQ(raw[0], 0x11111111);
+		CHECK_EQ(raw[1], 0x22222222);
+		for (size_t ndx(2);  ndx < 8;  ndx++)
+			CHECK_EQ(raw[ndx], 0xDEADBEEF);
+		for (size_t ndx(8);  ndx < 16;  ndx++)
+			CHECK_EQ(raw[ndx], 0);				//	Frame 1 zero-filled
+		for (size_t ndx(16);  ndx < 24;  ndx++)
+			CHECK_EQ(raw[ndx], 0x5A5A5A5A);		//	Frame 2 where it belongs
+		for (size_t ndx(24);  ndx < 32;  ndx++)
+			CHECK_EQ(raw[ndx], 0);				//	Frame 3 zero-filled
+		ifs.close();
+
+		CHECK_FALSE(CNTV2SupportLogger::ExpandDeviceSDRAMDump(kRawPath, kDumpPath, msgs));	//	Not a compressed dump
+		CHECK_FALSE(CNTV2SupportLogger::ExpandDeviceSDRAMDump("ut_no_such_file.rle", kRawPath, msgs));
+		::remove(kDumpPath);
+		::remove(kRawPath);
+	}	//	TEST_CASE("ExpandDeviceSDRAMDump")
+}	//	TEST_SUITE("ntv2supportlogger")
+
+
+TEST_SUITE("ntv2timingrecorder" * doctest::description("CNTV2TimingRecorder tests")) {
+
+	TEST_CASE("NTV2TimingHistogram")
+	{
+		NTV2TimingHistogram histo(0, 10, 10);
+		CHECK_EQ(histo.GetCount(), 0);
+		CHECK_EQ(histo.GetPercentile(50.0), 0);
+		for (int64_t value(0);  value < 100;  value++)
+			histo.Add(value);
+		histo.Add(-5);		//	Underflow -- first bin
+		histo.Add(1000);	//	Overflow -- last bin
+		CHECK_EQ(histo.GetCount(), 102);
+		CHECK_EQ(histo.GetMin(), -5);
+		CHECK_EQ(histo.GetMax(), 1000);
+		CHECK_EQ(histo.GetBins().size(), 10);
+		CHECK_EQ(histo.GetBins().front(), 11);
+		CHECK_EQ(histo.GetBins().back(), 11);
+		CHECK_EQ(histo.GetPercentile(50.0), 50);
+		CHECK_EQ(histo.GetPercentile(100.0), 1000);
+		CHECK(histo.GetMean() == doctest::Approx(58.68).epsilon(0.01));
+		CHECK(histo.GetStdDev() > 0.0);
+		histo.Reset();
+		CHECK_EQ(histo.GetCount(), 0);
+		CHECK_EQ(histo.GetBins().size(), 10);
+	}	//	TEST_CASE("NTV2TimingHistogram")
+
+	TEST_CASE("NTV2ScopedTimer")
+	{
+		NTV2TimingHistogram histo(0, 1000, 100);	//	Microseconds
+		{
+			NTV2ScopedTimer timer(histo);
+			AJATime::Sleep(2);
+			CHECK(timer.GetElapsedNanoseconds() >= 2000000);
+		}
+		CHECK_EQ(histo.GetCount(), 1);
+		CHECK(histo.GetMin() >= 2000);
+		CHECK(histo.GetMin() < 100000);
+		{
+			AJALock lock;
+			NTV2ScopedTimer timer(histo, 1000000, &lock);	//	Milliseconds
+		}
+		CHECK_EQ(histo.GetCount(), 2);
+		CHECK_EQ(histo.GetMin(), 0);
+		{
+			NTV2ScopedTimer timer(histo);
+			timer.Cancel();
+		}
+		CHECK_EQ(histo.GetCount(), 2);
+	}	//	TEST_CASE("NTV2ScopedTimer")
+
+	TEST_CASE("CNTV2TimingRecorder")
+	{
+		const int64_t kPeriod (166666);	//	60fps, in 100ns units
+		CNTV2TimingRecorder recorder;
+		CHECK(recorder.SetFrameRate(NTV2_CHANNEL1, NTV2_FRAMERATE_6000));
+		CHECK_FALSE(recorder.SetFrameRate(NTV2_CHANNEL1, NTV2_FRAMERATE_UNKNOWN));
+
+		//	Capture:  20 msec latency, 1 msec DMAs, one late VBI, then 2 drops...
+		AUTOCIRCULATE_TRANSFER xfer;
+		int64_t frameTime (100000000);
+		for (ULWord frame(0);  frame < 10;  frame++)
+		{
+			FRAME_STAMP & stamp (xfer.acTransferStatus.acFrameStamp);
+			stamp.acFrameTime = frameTime + (frame == 5 ? 500 : 0);
+			stamp.acCurrentTime = stamp.acFrameTime + 200000;
+			xfer.acTransferStatus.acFramesDropped = frame == 9 ? 2 : 0;
+			xfer.acInUserCookie = frame;
+			CHECK(recorder.RecordCaptureTransfer(NTV2_CHANNEL1, xfer, 1000 * frame, 1000 * frame + 1000));
+			frameTime += kPeriod;
+		}
+		NTV2TimingHistogram histo (recorder.GetHistogram(NTV2_CHANNEL1, NTV2_TIMING_CAPTURE_LATENCY));
+		CHECK_EQ(histo.GetCount(), 10);
+		CHECK_EQ(histo.GetMin(), 20000);
+		CHECK_EQ(histo.GetMax(), 20000);
+		CHECK_EQ(recorder.GetHistogram(NTV2_CHANNEL1, NTV2_TIMING_DMA_DURATION).GetMean(), 1000.0);
+		histo = recorder.GetHistogram(NTV2_CHANNEL1, NTV2_TIMING_VBI_JITTER);
+		CHECK_EQ(histo.GetCount(), 9);
+		CHECK_EQ(histo.GetMin(), -50);
+		CHECK_EQ(histo.GetMax(), 50);
+		CHECK_EQ(recorder.GetDroppedFrames(NTV2_CHANNEL1), 2);
+		CHECK_EQ(recorder.GetRepeatedFrames(NTV2_CHANNEL1), 0);
+
+		//	Playout:  33 msec output latency, 100 msec end-to-end...
+		AUTOCIRCULATE_TRANSFER outXfer;
+		outXfer.acInUserCookie = 42;
+		outXfer.acTransferStatus.acFrameStamp.acCurrentTime = 500000000;
+		CHECK(recorder.RecordOutputTransfer(NTV2_CHANNEL2, outXfer, 5000, 5500, 4000));
+		CHECK_EQ(recorder.GetHistogram(NTV2_CHANNEL2, NTV2_TIMING_HOST_PROCESSING).GetMax(), 1000);
+		FRAME_STAMP onAir;
+		onAir.acCurrentUserCookie = 41;
+		CHECK_FALSE(recorder.RecordOutputFrameStamp(NTV2_CHANNEL2, onAir));		//	Unknown frame
+		onAir.acCurrentUserCookie = 42;
+		onAir.acCurrentFrameTime = 500330000;
+		CHECK(recorder.RecordOutputFrameStamp(NTV2_CHANNEL2, onAir));
+		CHECK_FALSE(recorder.RecordOutputFrameStamp(NTV2_CHANNEL2, onAir));		//	Already recorded
+		CHECK_EQ(recorder.GetHistogram(NTV2_CHANNEL2, NTV2_TIMING_OUTPUT_LATENCY).GetMax(), 33000);
+		xfer.acTransferStatus.acFrameStamp.acCurrentTime = 501000000;
+		CHECK_FALSE(recorder.RecordLoopback(NTV2_CHANNEL1, NTV2_CHANNEL2, 43, xfer));
+		CHECK(recorder.RecordLoopback(NTV2_CHANNEL1, NTV2_CHANNEL2, 42, xfer));
+		CHECK_FALSE(recorder.RecordLoopback(NTV2_CHANNEL1, NTV2_CHANNEL2, 42, xfer));	//	Counted once
+		CHECK_EQ(recorder.GetHistogram(NTV2_CHANNEL1, NTV2_TIMING_END_TO_END).GetMax(), 100000);
+
+		//	Output...
+		ostringstream csv, json, text;
+		CHECK(recorder.WriteCSV(csv));
+		const string csvStr(csv.str());
+		CHECK_EQ(std::count(csvStr.begin(), csvStr.end(), '\n'), 1 + 10 + 10 + 9 + 2 + 1 + 1);
+		CHECK(csv.str().find("1,captureLatency,0,100000000,20000") != string::npos);
+		CHECK(recorder.WriteJSON(json));
+		CHECK(json.str().find("\"dropped\": 2") != string::npos);
+		CHECK(json.str().find("\"endToEnd\": {\"count\": 1") != string::npos);
+		recorder.Print(text, false);
+		CHECK(text.str().find("Output Latency") != string::npos);
+		json << 2.25;	//	Caller's stream formatting is left alone
+		text << 2.25;
+		CHECK(json.str().find("]}\n2.25") != string::npos);
+		CHECK_EQ(text.str().substr(text.str().size() - 4), "2.25");
+
+		recorder.SetMaxSamples(5);
+		CHECK_EQ(recorder.GetSamples().size(), 5);
+		recorder.Reset();
+		CHECK(recorder.GetSamples().empty());
+		CHECK_EQ(recorder.GetDroppedFrames(NTV2_CHANNEL1), 0);
+		CHECK_EQ(recorder.GetHistogram(NTV2_CHANNEL1, NTV2_TIMING_CAPTURE_LATENCY).GetCount(), 0);
+	}	//	TEST_CASE("CNTV2TimingRecorder")
+
+	TEST_CASE("FrameCounter")
+	{
+		const NTV2PixelFormat pixelFormats[] = {NTV2_FBF_8BIT_YCBCR, NTV2_FBF_10BIT_YCBCR};
+		for (size_t ndx(0);  ndx < sizeof(pixelFormats) / sizeof(NTV2PixelFormat);  ndx++)
+		{
+			const NTV2FormatDescriptor fd(NTV2_FORMAT_1080i_5994, pixelFormats[ndx]);
+			NTV2Buffer frame(fd.GetTotalBytes());
+			CHECK(NTV2TestPatternGen().DrawTestPattern(NTV2_TestPatt_ColorBars75, fd, frame));
+			ULWord counter(0);
+			CHECK_FALSE(CNTV2TimingRecorder::DecodeFrameCounter(frame, fd, counter));
+			CHECK(CNTV2TimingRecorder::EncodeFrameCounter(frame, fd, 0x12345678));
+			CHECK(CNTV2TimingRecorder::DecodeFrameCounter(frame, fd, counter));
+			CHECK_EQ(counter, 0x12345678);
+			CHECK(CNTV2TimingRecorder::EncodeFrameCounter(frame, fd, 0));
+			CHECK(CNTV2TimingRecorder::DecodeFrameCounter(frame, fd, counter));
+			CHECK_EQ(counter, 0);
+		}
+		const NTV2FormatDescriptor argb(NTV2_FORMAT_1080i_5994, NTV2_FBF_ARGB);
+		NTV2Buffer frame(argb.GetTotalBytes());
+		CHECK_FALSE(CNTV2TimingRecorder::EncodeFrameCounter(frame, argb, 1));
+		NTV2Buffer tooSmall(1024);
+		CHECK_FALSE(CNTV2TimingRecorder::EncodeFrameCounter(tooSmall, NTV2FormatDescriptor(NTV2_FORMAT_1080i_5994, NTV2_FBF_8BIT_YCBCR), 1));
+	}	//	TEST_CASE("FrameCounter")
+}	//	TEST_SUITE("ntv2timingrecorder")
+
+
+TEST_SUITE("ntv2streamring" * doctest::description("NTV2StreamRing tests")) {
+
+	//	A fake stream driver:  each StreamChannelWait completes the oldest queued buffer (stamping a frame
+	//	counter into it), except every 7th, which it flushes. It's called from the application and Service
+	//	threads alike, so it locks.
+	class StreamMockDevice : public CNTV2Card
+	{
+		public:
+			StreamMockDevice ()	:	fFrame(0)	{_boardID = DEVICE_ID_KONA5;  _boardOpened = true;}
+			virtual ~StreamMockDevice ()		{_boardOpened = false;}
+			virtual bool	GetNUMANode (int & outNode)							{outNode = -1;  return false;}
+			virtual bool	DMABufferLock (const NTV2Buffer & inBuffer, bool inMap = false, bool inRDMA = false)	{(void) inMap; (void) inRDMA;  return !inBuffer.IsNULL();}
+			virtual bool	DMABufferUnlock (const NTV2Buffer & inBuffer)		{return !inBuffer.IsNULL();}
+			virtual bool	StreamChannelOps (const NTV2Channel inChannel, ULWord flags, NTV2StreamChannel & status)
+			{	(void) inChannel;
+				status.mStatus = NTV2_STREAM_STATUS_SUCCESS;
+				if (flags & NTV2_STREAM_CHANNEL_INITIALIZE)
+					{AJAAutoLock tmp(&fLock);  fQueued.clear();  fReleased.clear();}
+				if (flags & NTV2_STREAM_CHANNEL_WAIT)
+				{
+					AJATime::SleepInMicroseconds(100);
+					AJAAutoLock tmp(&fLock);
+					if (!fQueued.empty())
+					{
+						NTV2StreamBuffer done;
+						done.mBufferCookie = fQueued.front().first;
+						done.mBufferState = NTV2_STREAM_BUFFER_STATE_COMPLETED;
+						if (++fFrame % 7)
+							*reinterpret_cast<ULWord*>(fQueued.front().second) = fFrame;
+						else
+							done.mBufferState |= NTV2_STREAM_BUFFER_STATE_FLUSHED;
+						fReleased.push_back(done);
+						fQueued.pop_front();
+					}
+				}
+				return true;
+			}
+			virtual bool	StreamBufferOps (const NTV2Channel inChannel, NTV2Buffer & inBuffer, ULWord64 bufferCookie, ULWord flags, NTV2StreamBuffer & status)
+			{	(void) inChannel;
+				AJAAutoLock tmp(&fLock);
+				status.mStatus = NTV2_STREAM_STATUS_SUCCESS;
+				if (flags & NTV2_STREAM_BUFFER_QUEUE)
+					fQueued.push_back(std::make_pair(bufferCookie, inBuffer.GetHostPointer()));
+				else if (flags & NTV2_STREAM_BUFFER_RELEASE)
+				{
+					if (fReleased.empty())
+						status.mStatus = NTV2_STREAM_STATUS_FAIL;
+					else
+						{status = fReleased.front();  status.mStatus = NTV2_STREAM_STATUS_SUCCESS;  fReleased.pop_front();}
+				}
+				return true;
+			}
+		private:
+			AJALock									fLock;
+			std::deque<std::pair<ULWord64, void*> >	fQueued;	//	Cookie & host address of each queued buffer
+			std::deque<NTV2StreamBuffer>			fReleased;
+			ULWord									fFrame;
+	};	//	StreamMockDevice
+
+	typedef struct StreamServiceContext
+	{
+		NTV2StreamRing *	fpRing;
+		bool volatile		fQuit;
+	} StreamServiceContext;
+
+	static void StreamServiceThread (AJAThread * pThread, void * pContext)
+	{	(void) pThread;
+		StreamServiceContext * pCtx (reinterpret_cast<StreamServiceContext*>(pContext));
+		while (!pCtx->fQuit)
+			pCtx->fpRing->WaitAndService();
+	}
+
+	TEST_CASE("NTV2StreamRing Unopened")
+	{
+		CNTV2Card card;	//	Not open
+		NTV2StreamRing ring(card, NTV2_CHANNEL1, NTV2_MODE_DISPLAY);
+		CHECK_FALSE(ring.IsOpen());
+		CHECK_FALSE(ring.IsRunning());
+		CHECK_FALSE(ring.IsCapture());
+		CHECK_EQ(ring.GetChannel(), NTV2_CHANNEL1);
+		CHECK_FALSE(ring.Open(4, 1024));
+		CHECK_FALSE(ring.IsOpen());
+		CHECK_EQ(ring.GetBufferCount(), 0);
+		CHECK_FALSE(ring.Start());
+		CHECK_FALSE(ring.Service());
+		CHECK(ring.AcquireBuffer() == AJA_NULL);
+		NTV2Buffer notMine(1024);
+		CHECK_FALSE(ring.SubmitBuffer(&notMine));
+		CHECK_FALSE(ring.SubmitBuffer(AJA_NULL));
+
+		NTV2StreamRingStats stats;
+		CHECK(ring.GetStats(stats));
+		CHECK_EQ(stats.fQueued, 0);
+		CHECK_EQ(stats.fQueueDepth, 0);
+		CHECK_EQ(stats.fMinQueueDepth, 0);
+		CHECK_EQ(stats.fLatency.GetCount(), 0);
+		ring.Close();	//	Harmless when not open
+	}	//	TEST_CASE("NTV2StreamRing Unopened")
+
+	TEST_CASE("NTV2StreamRing Capture with Service thread")
+	{
+		static const ULWord kNumFrames (300);
+		StreamMockDevice device;
+		NTV2StreamRing ring(device, NTV2_CHANNEL1, NTV2_MODE_CAPTURE);
+		ring.SetAutoService(false);
+		REQUIRE(ring.Open(6, 4096));
+		CHECK_EQ(ring.GetTargetDepth(), 4);
+		REQUIRE(ring.Start());
+		CHECK_EQ(ring.GetQueueDepth(), 4);
+
+		//	Service (the free list's producer) runs on its own thread, while this one acquires & submits...
+		StreamServiceContext ctx = {&ring, false};
+		AJAThread serviceThread;
+		serviceThread.Attach(StreamServiceThread, &ctx);
+		REQUIRE(AJA_SUCCESS(serviceThread.Start()));
+		ULWord lastFrame(0), numAcquired(0);
+		for (;  numAcquired < kNumFrames;  numAcquired++)
+		{
+			NTV2Buffer * pBuffer (ring.AcquireBuffer(1000));
+			if (!pBuffer)
+				break;	//	Lost buffers would stall the ring
+			const ULWord frame (*reinterpret_cast<const ULWord*>(pBuffer->GetHostPointer()));
+			CHECK(frame > lastFrame);	//	In order, never delivered twice
+			lastFrame = frame;
+			CHECK(ring.SubmitBuffer(pBuffer));
+		}
+		ctx.fQuit = true;
+		serviceThread.Stop();
+		CHECK_EQ(numAcquired, kNumFrames);
+
+		NTV2StreamRingStats stats;
+		CHECK(ring.GetStats(stats));
+		CHECK(stats.fCompleted >= kNumFrames);
+		CHECK(stats.fFlushed > 0);
+		CHECK_EQ(stats.fQueued, stats.fCompleted + stats.fFlushed + stats.fQueueDepth);
+		CHECK(stats.fMaxQueueDepth <= ring.GetTargetDepth());
+		ring.Close();
+	}	//	TEST_CASE("NTV2StreamRing Capture with Service thread")
+
+	TEST_CASE("NTV2StreamRing Starvation")
+	{
+		StreamMockDevice device;
+		NTV2StreamRing ring(device, NTV2_CHANNEL1, NTV2_MODE_CAPTURE);
+		ring.SetAutoService(false);
+		REQUIRE(ring.Open(4, 4096, 2));
+		REQUIRE(ring.Start());
+		NTV2StreamRingStats stats;
+		for (int ndx(0);  ndx < 10;  ndx++)
+			CHECK(ring.WaitAndService());	//	The application never acquires, so the driver queue runs dry & stays dry
+		CHECK_EQ(ring.GetQueueDepth(), 0);
+		CHECK(ring.GetStats(stats));
+		CHECK_EQ(stats.fCompleted, 4);
+		CHECK_EQ(stats.fStarved, 1);	//	One dry spell, however many Service calls it lasts
+
+		NTV2Buffer * pBuffer (ring.AcquireBuffer());
+		REQUIRE(pBuffer);
+		CHECK(ring.SubmitBuffer(pBuffer));
+		CHECK(ring.Service());
+		CHECK_EQ(ring.GetQueueDepth(), 1);
+		CHECK(ring.WaitAndService());	//	Runs dry again
+		CHECK(ring.GetStats(stats));
+		CHECK_EQ(stats.fStarved, 2);
+		ring.Close();
+	}	//	TEST_CASE("NTV2StreamRing Starvation")
+}	//	TEST_SUITE("ntv2streamring")
+
+
+TEST_SUITE("ntv2capturefile" * doctest::description("CNTV2CaptureFileWriter & CNTV2CaptureFileReader tests")) {
+
+	TEST_CASE("Write & Read")
+	{
+		string path;
+		REQUIRE(AJA_SUCCESS(AJAFileIO::TempDirectory(path)));
+		aja::rstrip(path, string(1, AJA_PATHSEP));
+		path += string(1, AJA_PATHSEP) + "ntv2capturefile_" + aja::to_string(uint64_t(AJATime::GetSystemMilliseconds())) + ".ntv2cap";
+
+		const NTV2FormatDescriptor fd(NTV2_FORMAT_525_5994, NTV2_FBF_8BIT_YCBCR);
+		NTV2CaptureFileHeader hdr;
+		::memset(&hdr, 0, sizeof(hdr));
+		hdr.fVideoFormat = NTV2_FORMAT_525_5994;
+		hdr.fPixelFormat = NTV2_FBF_8BIT_YCBCR;
+		hdr.fWidth = fd.GetRasterWidth();
+		hdr.fHeight = fd.GetRasterHeight();
+		hdr.fRowBytes = fd.GetBytesPerRow();
+		hdr.fNumAudioChannels = 16;
+		hdr.fAudioSampleRate = 48000;
+		::strcpy(hdr.fDescription, "unit test");
+
+		const ULWord numFrames(10);
+		NTV2Buffer video(fd.GetTotalBytes()), audio(1601 * 16 * 4), anc(300);
+		{
+			CNTV2CaptureFileWriter writer;
+			CHECK_FALSE(writer.IsOpen());
+			REQUIRE(writer.Open(path, hdr, 3));
+			CHECK_FALSE(writer.Open(path, hdr, 3));
+			NTV2CaptureFrame frame;
+			for (ULWord ndx(0);  ndx < numFrames;  ndx++)
+			{
+				video.Fill(UByte(ndx));
+				audio.Fill(ULWord(0x01000000 * ndx));
+				anc.Fill(UByte(0x80 + ndx));
+				frame.fVideo.Set(video.GetHostPointer(), video.GetByteCount());
+				frame.fAudio.Set(audio.GetHostPointer(), ndx & 1 ? 1601 * 16 * 4 : 1602 * 16 * 4 - 4096);
+				frame.fAncF1.Set(anc.GetHostPointer(), anc.GetByteCount());
+				frame.fFrameStamp.acFrameTime = LWord64(1000 + 333 * ndx);
+				frame.fFrameStamp.acCurrentReps = ndx % 3;
+				frame.fTimeCodes.clear();
+				frame.fTimeCodes[NTV2_TCINDEX_SDI1] = NTV2_RP188(0, ndx, 0x100 + ndx);
+				CHECK(writer.WriteFrame(frame));
+			}
+			CHECK_EQ(writer.GetFrameCount(), numFrames);
+			CHECK(writer.Close());
+			CHECK_FALSE(writer.IsOpen());
+		}
+
+		CNTV2CaptureFileReader reader;
+		REQUIRE(reader.Open(path));
+		CHECK_FALSE(reader.WasRecovered());
+		CHECK_EQ(reader.GetFrameCount(), numFrames);
+		CHECK_EQ(reader.GetHeader().fPixelFormat, ULWord(NTV2_FBF_8BIT_YCBCR));
+		CHECK_EQ(reader.GetHeader().fNumAudioChannels, 16);
+		CHECK_EQ(string(reader.GetHeader().fDescription), "unit test");
+
+		//	Random access, in reverse
+		for (ULWord ndx(numFrames);  ndx--;  )
+		{
+			NTV2CaptureFileFrame frame;
+			REQUIRE(reader.GetFrame(ndx, frame));
+			CHECK_EQ(frame.fRecord->fFrameNumber, ndx);
+			CHECK_EQ(frame.fRecord->fCurrentReps, ndx % 3);
+			CHECK_EQ(frame.fVideo.GetByteCount(), video.GetByteCount());
+			CHECK_EQ(frame.fVideo.U8(0), UByte(ndx));
+			CHECK_EQ(frame.fVideo.U8(int(video.GetByteCount()) - 1), UByte(ndx));
+			CHECK_EQ(uint64_t(frame.fVideo.GetHostPointer()) % NTV2_CAPTUREFILE_ALIGNMENT, 0);
+			CHECK_EQ(frame.fAudio.GetByteCount(), ndx & 1 ? 1601 * 16 * 4 : 1602 * 16 * 4 - 4096);
+			CHECK_EQ(frame.fAudio.U32(0), 0x01000000 * ndx);
+			CHECK_EQ(frame.fAncF1.GetByteCount(), 300);
+			CHECK_EQ(frame.fAncF1.U8(299), UByte(0x80 + ndx));
+			CHECK(frame.fAncF2.IsNULL());
+			NTV2_RP188 tc;
+			CHECK(frame.GetTimeCode(tc, NTV2_TCINDEX_SDI1));
+			CHECK_EQ(tc.fLo, ndx);
+			CHECK_EQ(tc.fHi, 0x100 + ndx);
+			CHECK_FALSE(frame.GetTimeCode(tc, NTV2_TCINDEX_LTC1));
+		}
+		NTV2CaptureFileFrame frame;
+		CHECK_FALSE(reader.GetFrame(numFrames, frame));
+
+		//	Seek by time
+		ULWord64 frameNum(99);
+		CHECK_FALSE(reader.FindFrame(999, frameNum));
+		CHECK(reader.FindFrame(1000, frameNum));
+		CHECK_EQ(frameNum, 0);
+		CHECK(reader.FindFrame(1000 + 333 * 4 + 100, frameNum));
+		CHECK_EQ(frameNum, 4);
+		CHECK(reader.FindFrame(LWord64(1) << 40, frameNum));
+		CHECK_EQ(frameNum, numFrames - 1);
+		reader.Close();
+		CHECK_FALSE(reader.IsOpen());
+
+		//	Without the index (as if never closed), the frames are recovered
+		{
+			fstream file(path.c_str(), ios::in | ios::out | ios::binary);
+			REQUIRE(file.good());
+			file.seekp(offsetof(NTV2CaptureFileHeader, fFrameCount));
+			const ULWord64 zeroes[2] = {0, 0};
+			file.write(reinterpret_cast<const char*>(zeroes), sizeof(zeroes));
+			CHECK(file.good());
+			file.close();
+		}
+		REQUIRE(reader.Open(path));
+		CHECK(reader.WasRecovered());
+		CHECK_EQ(reader.GetFrameCount(), numFrames);
+		CHECK(reader.GetFrame(numFrames - 1, frame));
+		CHECK_EQ(frame.fVideo.U8(7), UByte(numFrames - 1));
+		reader.Close();
+
+		CHECK(AJA_SUCCESS(AJAFileIO::Delete(path)));
+		CHECK_FALSE(reader.Open(path));
+	}	//	TEST_CASE("Write & Read")
+}	//	TEST_SUITE("ntv2capturefile")
+
+
+#if defined(AJA_LINUX)
+TEST_SUITE("ntv2linuxdriverinterface" * doctest::description("CNTV2LinuxDriverInterface tests")) {
+
+	//	Reads registers from a fake register mapping. The device handle is /dev/null, so driver reads fail.
+	class MappedRegMockDevice : public CNTV2Card
+	{
+		public:
+			MappedRegMockDevice (const ULWord inNumRegs)
+			{
+				_boardID = DEVICE_ID_KONA5;
+				_hDevice = HANDLE(open("/dev/null", O_RDONLY));
+				const ULWord pageSize (ULWord(::getpagesize()));
+				const ULWord mapSize ((inNumRegs * ULWord(sizeof(ULWord)) + pageSize - 1) / pageSize * pageSize);
+				void * pMapping (mmap(AJA_NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+				if (pMapping == MAP_FAILED)
+					return;
+				ULWord * pRegs (reinterpret_cast<ULWord*>(pMapping));
+				for (ULWord regNum(0);  regNum < mapSize / sizeof(ULWord);  regNum++)
+					pRegs[regNum] = regNum;
+				_pMappedRegisters = pRegs;
+				_mappedRegistersSize = mapSize;
+				MappedRegisterWhitelist(DefaultMappedRegisterClasses(), inNumRegs, _mappedRegisterOK);
+			}
+			virtual ~MappedRegMockDevice ()
+			{
+				EnableMappedRegisterReads(false);	//	Unmaps the fake mapping
+				if (_hDevice != INVALID_HANDLE_VALUE)
+					close(int(_hDevice));
+				_hDevice = INVALID_HANDLE_VALUE;
+			}
+			void	SetMappedValue (const ULWord inRegNum, const ULWord inValue)	{const_cast<ULWord*>(_pMappedRegisters)[inRegNum] = inValue;}
+	};
+
+	TEST_CASE("Mapped register reads")
+	{
+		const ULWord kNumRegs (64);	//	Smaller than the page-sized mapping
+		MappedRegMockDevice device(kNumRegs);
+		REQUIRE(device.HasMappedRegisterReads());
+		const NTV2RegNumSet mapped (device.GetMappedRegisterNumbers());
+		REQUIRE_FALSE(mapped.empty());
+		CHECK(*mapped.rbegin() < kNumRegs);
+
+		//	Whitelisted registers come from the mapping, masked and shifted
+		ULWord value(0);
+		const ULWord regNum (*mapped.begin());
+		CHECK(device.ReadRegister(regNum, value));
+		CHECK_EQ(value, regNum);
+		device.SetMappedValue(regNum, 0x12345678);
+		CHECK(device.ReadRegister(regNum, value, 0x0000FF00, 8));
+		CHECK_EQ(value, 0x56);
+
+		//	All ones, registers that aren't whitelisted, registers past the window, and virtual registers go to the driver
+		device.SetMappedValue(regNum, 0xFFFFFFFF);
+		CHECK_FALSE(device.ReadRegister(regNum, value));
+		for (ULWord reg(0);  reg < kNumRegs;  reg++)
+			if (mapped.find(reg) == mapped.end())
+				CHECK_FALSE(device.ReadRegister(reg, value));
+		CHECK(mapped.find(kRegRS422Transmit) == mapped.end());
+		const NTV2RegNumSet inputRegs (CNTV2RegisterExpert::GetRegistersForClass(kRegClass_Input));
+		const NTV2RegNumSetConstIter pastWindow (inputRegs.lower_bound(kNumRegs));
+		REQUIRE(pastWindow != inputRegs.end());
+		CHECK(*pastWindow < VIRTUALREG_START);
+		CHECK_FALSE(device.ReadRegister(*pastWindow, value));
+		CHECK_FALSE(device.ReadRegister(kVRegDriverVersion, value));
+
+		//	Disabled
+		CHECK(device.EnableMappedRegisterReads(false));
+		CHECK_FALSE(device.HasMappedRegisterReads());
+		CHECK(device.GetMappedRegisterNumbers().empty());
+		CHECK_FALSE(device.ReadRegister(*mapped.rbegin(), value));
+	}	//	TEST_CASE("Mapped register reads")
+}	//	TEST_SUITE("ntv2linuxdriverinterface")
+#endif	//	defined(AJA_LINUX)
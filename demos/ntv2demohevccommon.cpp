@@ -9,6 +9,7 @@
 #include "ntv2devicescanner.h"
 #include "ntv2devicefeatures.h"
 #include "ntv2utils.h"
+#include "ajabase/common/videoutilities.h"
 #include <assert.h>
 #include <map>
 #include <sys/stat.h>
@@ -455,7 +456,8 @@ AJAStatus CNTV2DemoHevcCommon::ReadYuv420Frame(void* pBuffer, uint32_t numFrame)
     // Seek to the frame
     //fseek(mYuvFd, (mYuvFrameSize * numFrame), SEEK_SET);
 
-    // Read the Y plane
+    // Read the whole I420 frame as is -- ConvertYuv420FrameToNV12 converts it on another thread,
+    // so the conversion overlaps the file reads
     result = fread(pBuffer, 1, mYuvFrameSize, mYuvFd);
     if (result != (mYuvFrameSize))
         return AJA_STATUS_FAIL;
@@ -470,23 +472,10 @@ AJAStatus CNTV2DemoHevcCommon::ConvertYuv420FrameToNV12(void* pSrcBuffer, void*
     if (bufferSize != mYuvFrameSize)
         return AJA_STATUS_FAIL;
     
-    // Copy over Y plane
-    memcpy(pDstBuffer, pSrcBuffer, (mYuvFrameWidth * mYuvFrameHeight));
-    
-    char * srcCbPtr;
-    char * srcCrPtr;
-    char * destCbCrPtr;
-    
-    srcCbPtr = (char*)pSrcBuffer + (mYuvFrameWidth * mYuvFrameHeight);
-    srcCrPtr = (char*)pSrcBuffer + (mYuvFrameWidth * mYuvFrameHeight) + ((mYuvFrameWidth * mYuvFrameHeight) / 4);
-    destCbCrPtr = (char*)pDstBuffer + (mYuvFrameWidth * mYuvFrameHeight);
-    
-    // Now interleave Cb and Cr planes
-    for (uint32_t i = 0; i< (mYuvFrameWidth * mYuvFrameHeight) / 4; i++)
-    {
-        *destCbCrPtr++ = *srcCbPtr++;
-        *destCbCrPtr++ = *srcCrPtr++;
-    }
+    // Copy the Y plane and interleave the Cb and Cr planes
+    if (!AJA_ConvertYCbCrFrame(pSrcBuffer, AJA_PixelFormat_YCBCR8_420PL3, pDstBuffer, AJA_PixelFormat_YCBCR8_420PL2,
+                               mYuvFrameWidth, mYuvFrameHeight))
+        return AJA_STATUS_FAIL;
     
     return AJA_STATUS_SUCCESS;
 }
@@ -198,6 +198,12 @@ static void dmaSerialRelease(ULWord deviceNumber);
 
 static inline bool dmaPageRootAutoLock(PDMA_PAGE_ROOT pRoot);
 static inline bool dmaPageRootAutoMap(PDMA_PAGE_ROOT pRoot);
+static bool dmaPageRootMatchFind(struct ntv2_page_cache_node* pNode, void* pContext);
+static bool dmaPageRootMatchRemove(struct ntv2_page_cache_node* pNode, void* pContext);
+static bool dmaPageRootMatchIdle(struct ntv2_page_cache_node* pNode, void* pContext);
+static PDMA_PAGE_BUFFER dmaPageRootLookup(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
+										  PVOID pAddress, ULWord size, bool count);
+static void dmaPageRootStatistics(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot);
 
 static int dmaPageBufferInit(ULWord deviceNumber, PDMA_PAGE_BUFFER pBuffer,
 							 ULWord numPages, bool rdma);
@@ -1077,10 +1083,11 @@ int dmaTransfer(PDMA_PARAMS pDmaParams)
 									   videoCardBytes,
 									   false,
 									   dmaPageRootAutoMap(pDmaParams->pPageRoot));
-						pVideoPageBuffer = dmaPageRootFind(deviceNumber,
-														   pDmaParams->pPageRoot,
-														   pDmaParams->pVidUserVa,
-														   videoCardBytes);
+						pVideoPageBuffer = dmaPageRootLookup(deviceNumber,
+														     pDmaParams->pPageRoot,
+														     pDmaParams->pVidUserVa,
+														     videoCardBytes,
+														     false);
 						if (pVideoPageBuffer != NULL)
 						{
 							findVideo = true;
@@ -1269,10 +1276,11 @@ int dmaTransfer(PDMA_PARAMS pDmaParams)
 								   audioCardBytes,
 								   false,
 								   dmaPageRootAutoMap(pDmaParams->pPageRoot));
-					pAudioPageBuffer = dmaPageRootFind(deviceNumber,
-													   pDmaParams->pPageRoot,
-													   pDmaParams->pAudUserVa,
-													   audioCardBytes);
+					pAudioPageBuffer = dmaPageRootLookup(deviceNumber,
+													     pDmaParams->pPageRoot,
+													     pDmaParams->pAudUserVa,
+													     audioCardBytes,
+													     false);
 					if (pAudioPageBuffer != NULL)
 					{
 						findAudio = true;
@@ -1386,10 +1394,11 @@ int dmaTransfer(PDMA_PARAMS pDmaParams)
 								   ancF1CardBytes,
 								   false,
 								   dmaPageRootAutoMap(pDmaParams->pPageRoot));
-					pAncF1PageBuffer = dmaPageRootFind(deviceNumber,
-													   pDmaParams->pPageRoot,
-													   pDmaParams->pAncF1UserVa,
-													   ancF1CardBytes);
+					pAncF1PageBuffer = dmaPageRootLookup(deviceNumber,
+													     pDmaParams->pPageRoot,
+													     pDmaParams->pAncF1UserVa,
+													     ancF1CardBytes,
+													     false);
 					if (pAncF1PageBuffer != NULL)
 					{
 						findAncF1 = true;
@@ -1491,10 +1500,11 @@ int dmaTransfer(PDMA_PARAMS pDmaParams)
 								   ancF2CardBytes,
 								   false,
 								   dmaPageRootAutoMap(pDmaParams->pPageRoot));
-					pAncF2PageBuffer = dmaPageRootFind(deviceNumber,
-													   pDmaParams->pPageRoot,
-													   pDmaParams->pAncF2UserVa,
-													   ancF2CardBytes);
+					pAncF2PageBuffer = dmaPageRootLookup(deviceNumber,
+													     pDmaParams->pPageRoot,
+													     pDmaParams->pAncF2UserVa,
+													     ancF2CardBytes,
+													     false);
 					if (pAncF2PageBuffer != NULL)
 					{
 						findAncF2 = true;
@@ -2338,7 +2348,7 @@ int dmaPageRootInit(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot)
 		return -EINVAL;
 	
 	memset(pRoot, 0, sizeof(DMA_PAGE_ROOT));
-	INIT_LIST_HEAD(&pRoot->bufferHead);
+	ntv2_page_cache_init(&pRoot->bufferCache);
 	spin_lock_init(&pRoot->bufferLock);
 
 	return 0;
@@ -2346,6 +2356,7 @@ int dmaPageRootInit(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot)
 
 void dmaPageRootRelease(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot)
 {
+	struct ntv2_page_cache_node* pNode;
 	PDMA_PAGE_BUFFER pBuffer = NULL;
 	PDMA_PAGE_BUFFER pBufferLast = NULL;
 	unsigned long flags;
@@ -2357,14 +2368,14 @@ void dmaPageRootRelease(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot)
 		return;
 
 //	NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootRelease  release %lld bytes\n",
-//					  DMA_MSG_DEVICE, pRoot->lockTotalSize);
+//					  DMA_MSG_DEVICE, pRoot->bufferCache.stats.bytes);
 
 	// remove all locks
 	spin_lock_irqsave(&pRoot->bufferLock, flags);
-	while(!list_empty(&pRoot->bufferHead))
+	while((pNode = ntv2_page_cache_first(&pRoot->bufferCache)) != NULL)
 	{
 		// get current ref count
-		pBuffer = list_first_entry(&pRoot->bufferHead, DMA_PAGE_BUFFER, bufferEntry);
+		pBuffer = (PDMA_PAGE_BUFFER)pNode->owner;
 		if (pBuffer != pBufferLast)
 		{
 			pBufferLast = pBuffer;
@@ -2373,9 +2384,9 @@ void dmaPageRootRelease(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot)
 		refCount = pBuffer->refCount;
 		if (refCount <= 1)
 		{
-			// remove buffer from list
+			// remove buffer from cache
 			pBuffer->refCount--;
-			list_del_init(&pBuffer->bufferEntry);
+			ntv2_page_cache_remove(&pRoot->bufferCache, pNode);
 			spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 			dmaPageBufferRelease(deviceNumber, pBuffer);
 			kfree(pBuffer);
@@ -2396,10 +2407,9 @@ void dmaPageRootRelease(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot)
 		spin_lock_irqsave(&pRoot->bufferLock, flags);
 	}
 
-	pRoot->lockCounter = 0;
-	pRoot->lockTotalSize = 0;
 	spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 
+	dmaPageRootStatistics(deviceNumber, pRoot);
 	return;
 }
 
@@ -2417,7 +2427,7 @@ int dmaPageRootAdd(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
 					  DMA_MSG_DEVICE, (ULWord64)pAddress, size, rdma, map);
 
 	// use current buffer if found
-	pBuffer = dmaPageRootFind(deviceNumber, pRoot, pAddress, size);
+	pBuffer = dmaPageRootLookup(deviceNumber, pRoot, pAddress, size, false);
 	if (pBuffer != NULL)
 	{
 		dmaPageRootFree(deviceNumber, pBuffer);
@@ -2462,23 +2472,25 @@ int dmaPageRootAdd(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
 	}
 	
 	spin_lock_irqsave(&pRoot->bufferLock, flags);
-    pBuffer->pPageRoot = pRoot;
+	pBuffer->pPageRoot = pRoot;
 	pBuffer->refCount = 1;
-	pBuffer->lockCount = pRoot->lockCounter++;
 	pBuffer->lockSize = pBuffer->numPages * PAGE_SIZE;
-	pRoot->lockTotalSize += pBuffer->lockSize;
-	list_add_tail(&pBuffer->bufferEntry, &pRoot->bufferHead);
+	ntv2_page_cache_insert(&pRoot->bufferCache, &pBuffer->cacheNode,
+						   (ULWord64)pBuffer->pUserAddress, pBuffer->userSize,
+						   pBuffer->lockSize, pBuffer);
 	spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 
-	NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootAdd  cnt %lld  addr %016llx  size %lld\n",
-					  DMA_MSG_DEVICE, pBuffer->lockCount, (ULWord64)pBuffer->pUserAddress, pBuffer->lockSize);
+	NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootAdd  addr %016llx  size %lld\n",
+					  DMA_MSG_DEVICE, (ULWord64)pBuffer->pUserAddress, pBuffer->lockSize);
 
+	dmaPageRootStatistics(deviceNumber, pRoot);
 	return 0;
 }
 
 int dmaPageRootRemove(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
 					  PVOID pAddress, ULWord size)
 {
+	struct ntv2_page_cache_node* pNode;
 	PDMA_PAGE_BUFFER pBuffer;
 	unsigned long flags;
 
@@ -2490,24 +2502,24 @@ int dmaPageRootRemove(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
 	
 	// look for buffer
 	spin_lock_irqsave(&pRoot->bufferLock, flags);
-	list_for_each_entry(pBuffer, &pRoot->bufferHead, bufferEntry)
+	pNode = ntv2_page_cache_find(&pRoot->bufferCache, (ULWord64)pAddress,
+								 dmaPageRootMatchRemove, &size, false);
+	if (pNode != NULL)
 	{
-		if ((pBuffer->refCount > 1) ||
-			(pAddress != pBuffer->pUserAddress) ||
-			(size != pBuffer->userSize)) continue;
+		pBuffer = (PDMA_PAGE_BUFFER)pNode->owner;
 
-		// remove buffer from list
+		// remove buffer from cache
 		pBuffer->refCount--;
-		pRoot->lockTotalSize -= pBuffer->lockSize;
-		list_del_init(&pBuffer->bufferEntry);
+		ntv2_page_cache_remove(&pRoot->bufferCache, pNode);
 		spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 
-		NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootRemove  cnt %lld  addr %016llx  size %lld\n",
-						  DMA_MSG_DEVICE, pBuffer->lockCount, (ULWord64)pBuffer->pUserAddress, pBuffer->lockSize);
+		NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootRemove  addr %016llx  size %lld\n",
+						  DMA_MSG_DEVICE, (ULWord64)pBuffer->pUserAddress, pBuffer->lockSize);
 
 		dmaPageBufferRelease(deviceNumber, pBuffer);
 		kfree(pBuffer);
 
+		dmaPageRootStatistics(deviceNumber, pRoot);
 		return 0;
 	}
 
@@ -2521,52 +2533,42 @@ int dmaPageRootRemove(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
 
 int dmaPageRootPrune(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot, ULWord size)
 {
+	struct ntv2_page_cache_node* pNode;
 	PDMA_PAGE_BUFFER pBuffer;
-	PDMA_PAGE_BUFFER pPrune;
 	unsigned long flags;
-	LWord64 lockCount;
 
 	if (pRoot == NULL)
 		return -EINVAL;
 
 	NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootPrune  size %d  cur %lld  max %lld\n",
-					  DMA_MSG_DEVICE, size, pRoot->lockTotalSize, pRoot->lockMaxSize);
+					  DMA_MSG_DEVICE, size, pRoot->bufferCache.stats.bytes, pRoot->lockMaxSize);
 
 	if (size > pRoot->lockMaxSize)
 		size = pRoot->lockMaxSize;
 
 	spin_lock_irqsave(&pRoot->bufferLock, flags);
-	while ((pRoot->lockTotalSize + size) > pRoot->lockMaxSize)
+	while ((pRoot->bufferCache.stats.bytes + size) > pRoot->lockMaxSize)
 	{
-		// look for buffer with oldest lock count
-		pBuffer = NULL;
-		lockCount = 0x7fffffffffffffff;
-		list_for_each_entry(pPrune, &pRoot->bufferHead, bufferEntry)
-		{
-			if (pPrune->refCount > 1) continue;
-			if (pPrune->lockCount < lockCount)
-			{
-				pBuffer = pPrune;
-				lockCount = pPrune->lockCount;
-			}
-		}
+		// least recently used buffer that is not busy
+		pNode = ntv2_page_cache_oldest(&pRoot->bufferCache, dmaPageRootMatchIdle, NULL);
 
 		// no buffers available
-		if (pBuffer == NULL)
+		if (pNode == NULL)
 		{
 			spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 			NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootPrune failed\n", DMA_MSG_DEVICE);
+			dmaPageRootStatistics(deviceNumber, pRoot);
 			return -ENOMEM;
 		}
 		
-		// remove buffer from list
+		// remove buffer from cache
+		pBuffer = (PDMA_PAGE_BUFFER)pNode->owner;
 		pBuffer->refCount--;
-		pRoot->lockTotalSize -= pBuffer->lockSize;
-		list_del_init(&pBuffer->bufferEntry);
+		ntv2_page_cache_evict(&pRoot->bufferCache, pNode);
 		spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 
-		NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootPrune  cnt %lld  addr %016llx  size %lld \n",
-						  DMA_MSG_DEVICE, pBuffer->lockCount,  (ULWord64)pBuffer->pUserAddress, pBuffer->lockSize);
+		NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootPrune  addr %016llx  size %lld \n",
+						  DMA_MSG_DEVICE, (ULWord64)pBuffer->pUserAddress, pBuffer->lockSize);
 
 		dmaPageBufferRelease(deviceNumber, pBuffer);
 		kfree(pBuffer);
@@ -2574,6 +2576,7 @@ int dmaPageRootPrune(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot, ULWord size)
 	}
 	spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 	
+	dmaPageRootStatistics(deviceNumber, pRoot);
 	return 0;
 }
 
@@ -2605,10 +2608,35 @@ static inline bool dmaPageRootAutoMap(PDMA_PAGE_ROOT pRoot)
 	return pRoot->lockMap;
 }
 
-PDMA_PAGE_BUFFER dmaPageRootFind(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
-								 PVOID pAddress, ULWord size)
+static bool dmaPageRootMatchFind(struct ntv2_page_cache_node* pNode, void* pContext)
 {
-	PDMA_PAGE_BUFFER pBuffer;
+	PDMA_PAGE_BUFFER pBuffer = (PDMA_PAGE_BUFFER)pNode->owner;
+	ULWord size = *(ULWord*)pContext;
+
+	return (pBuffer->refCount > 0) && pBuffer->pageLock && (size <= pBuffer->userSize);
+}
+
+static bool dmaPageRootMatchRemove(struct ntv2_page_cache_node* pNode, void* pContext)
+{
+	PDMA_PAGE_BUFFER pBuffer = (PDMA_PAGE_BUFFER)pNode->owner;
+	ULWord size = *(ULWord*)pContext;
+
+	return (pBuffer->refCount <= 1) && (size == pBuffer->userSize);
+}
+
+static bool dmaPageRootMatchIdle(struct ntv2_page_cache_node* pNode, void* pContext)
+{
+	PDMA_PAGE_BUFFER pBuffer = (PDMA_PAGE_BUFFER)pNode->owner;
+
+	return (pBuffer->refCount <= 1);
+}
+
+static PDMA_PAGE_BUFFER dmaPageRootLookup(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
+										  PVOID pAddress, ULWord size, bool count)
+{
+	NTV2PrivateParams* pNTV2Params = getNTV2Params(deviceNumber);
+	struct ntv2_page_cache_node* pNode;
+	PDMA_PAGE_BUFFER pBuffer = NULL;
 	unsigned long flags;
 
 	if ((pRoot == NULL) || (pAddress == NULL) || (size == 0))
@@ -2616,29 +2644,39 @@ PDMA_PAGE_BUFFER dmaPageRootFind(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
 
 	// look for buffer
 	spin_lock_irqsave(&pRoot->bufferLock, flags);
-	list_for_each_entry(pBuffer, &pRoot->bufferHead, bufferEntry)
+	pNode = ntv2_page_cache_find(&pRoot->bufferCache, (ULWord64)pAddress,
+								 dmaPageRootMatchFind, &size, count);
+	if (pNode != NULL)
 	{
-		if ((pBuffer->refCount <= 0) || !pBuffer->pageLock ||
-			(pAddress != pBuffer->pUserAddress) ||
-			(size > pBuffer->userSize)) continue;
-
 		// found buffer
+		pBuffer = (PDMA_PAGE_BUFFER)pNode->owner;
 		pBuffer->refCount++;
-		pBuffer->lockCount = pRoot->lockCounter++; 
-		spin_unlock_irqrestore(&pRoot->bufferLock, flags);
+	}
+	spin_unlock_irqrestore(&pRoot->bufferLock, flags);
+
+	// device hit/miss counts are lock free (read by kVRegDmaPageCacheHits/Misses)
+	if (count && (pNTV2Params != NULL))
+		atomic64_inc((pBuffer != NULL)? &pNTV2Params->_dmaPageCacheHits : &pNTV2Params->_dmaPageCacheMisses);
 
+	if (pBuffer != NULL)
+	{
 		NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootFind  addr %016llx  size %d  found  addr %016llx  size %d\n",
 						  DMA_MSG_DEVICE, (ULWord64)pAddress, size,
 						  (ULWord64)pBuffer->pUserAddress, pBuffer->userSize);
 		return pBuffer;
 	}
-	spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 
 	NTV2_MSG_PAGE_MAP("%s%d: dmaPageRootFind  addr %016llx  size %d  not found\n",
 					  DMA_MSG_DEVICE, (ULWord64)pAddress, size);
 	return NULL;
 }
 
+PDMA_PAGE_BUFFER dmaPageRootFind(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot,
+								 PVOID pAddress, ULWord size)
+{
+	return dmaPageRootLookup(deviceNumber, pRoot, pAddress, size, true);
+}
+
 void dmaPageRootFree(ULWord deviceNumber, PDMA_PAGE_BUFFER pBuffer)
 {
 	unsigned long flags;
@@ -2660,6 +2698,38 @@ void dmaPageRootFree(ULWord deviceNumber, PDMA_PAGE_BUFFER pBuffer)
 	spin_unlock_irqrestore(&pRoot->bufferLock, flags);
 }
 
+static void dmaPageRootStatistics(ULWord deviceNumber, PDMA_PAGE_ROOT pRoot)
+{
+	NTV2PrivateParams* pNTV2Params = getNTV2Params(deviceNumber);
+	struct ntv2_page_cache_stats stats;
+	struct ntv2_page_cache_stats last;
+	ULWord* pVirtualRegs;
+	unsigned long flags;
+
+	if ((pNTV2Params == NULL) || (pRoot == NULL))
+		return;
+
+	// take the changes since last update (hits and misses are counted by dmaPageRootLookup)
+	spin_lock_irqsave(&pRoot->bufferLock, flags);
+	stats = pRoot->bufferCache.stats;
+	last = pRoot->publishedStats;
+	pRoot->publishedStats = stats;
+	spin_unlock_irqrestore(&pRoot->bufferLock, flags);
+
+	if ((stats.evictions == last.evictions) &&
+		(stats.buffers == last.buffers) &&
+		(stats.bytes == last.bytes))
+		return;
+
+	// accumulate all roots into the device virtual registers
+	pVirtualRegs = pNTV2Params->_virtualRegisterMem;
+	spin_lock_irqsave(&pNTV2Params->_virtualRegisterLock, flags);
+	pVirtualRegs[kVRegDmaPageCacheEvictions - VIRTUALREG_START] += (ULWord)(stats.evictions - last.evictions);
+	pVirtualRegs[kVRegDmaPageCacheBuffers - VIRTUALREG_START] += (ULWord)(stats.buffers - last.buffers);
+	pVirtualRegs[kVRegDmaPageCacheKBytes - VIRTUALREG_START] += (ULWord)((stats.bytes - last.bytes) / 1024);
+	spin_unlock_irqrestore(&pNTV2Params->_virtualRegisterLock, flags);
+}
+
 static int dmaPageBufferInit(ULWord deviceNumber, PDMA_PAGE_BUFFER pBuffer,
 							 ULWord numPages, bool rdma)
 {
@@ -2667,7 +2737,6 @@ static int dmaPageBufferInit(ULWord deviceNumber, PDMA_PAGE_BUFFER pBuffer,
 		return -EINVAL;
 	
 	memset(pBuffer, 0, sizeof(DMA_PAGE_BUFFER));
-	INIT_LIST_HEAD(&pBuffer->bufferEntry);
 
 	if (rdma)
 	{
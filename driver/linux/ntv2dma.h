@@ -12,6 +12,8 @@
 #ifndef NTV2DMA_HEADER
 #define NTV2DMA_HEADER
 
+#include "ntv2pagecache.h"
+
 #define DMA_NUM_ENGINES     8
 #define DMA_NUM_CONTEXTS    2
 
@@ -87,19 +89,18 @@ typedef struct _xlnxDmaDescriptor
 // dma page map
 typedef struct _dmaPageRoot
 {
-	struct list_head		bufferHead;			// locked buffer list
-	spinlock_t				bufferLock;			// lock buffer list
+	struct ntv2_page_cache	bufferCache;		// locked buffer index (address hash + lru)
+	struct ntv2_page_cache_stats	publishedStats;	// statistics last added to virtual registers
+	spinlock_t				bufferLock;			// lock buffer cache
 	bool					lockAuto;			// automatically lock buffers
 	bool					lockMap;			// automatically map buffers
-	LWord64					lockCounter;		// lock access counter
-	LWord64					lockTotalSize;		// current locked bytes
 	LWord64					lockMaxSize;		// maximum locked bytes
 	ULWord					engineRef[DMA_NUM_ENGINES];
 } DMA_PAGE_ROOT, *PDMA_PAGE_ROOT;
 
 typedef struct _dmaPageBuffer
 {
-	struct list_head		bufferEntry;		// locked buffer list
+	struct ntv2_page_cache_node	cacheNode;		// locked buffer cache entry
     PDMA_PAGE_ROOT          pPageRoot;          // owning root
 	LWord					refCount;			// reference count
 	void*					pUserAddress;		// user buffer address
@@ -115,7 +116,6 @@ typedef struct _dmaPageBuffer
 	ULWord					numSgs;				// pages mapped
 	struct scatterlist*		pSgList;			// scatter gather list
 	ULWord					sgListSize;			// scatter list allocation
-	LWord64					lockCount;			// lock access count
 	LWord64					lockSize;			// locked bytes
 	bool					rdma;				// use nvidia rdma
     void*                   rdmaContext;        // rdma context
@@ -39,6 +39,7 @@
 #include <linux/types.h>
 #include <linux/interrupt.h>
 #include <linux/delay.h>
+#include <linux/poll.h>
 #include <asm/delay.h>
 #include <asm/page.h>
 #include <linux/ioport.h>
@@ -656,6 +657,7 @@ static struct file_operations ntv2_fops =
 	.ioctl   = ntv2_ioctl,
 #endif
 	.mmap    = ntv2_mmap,
+	.poll    = ntv2_poll,
 	.open    = ntv2_open,
 	.release = ntv2_release
 };
@@ -1527,6 +1529,47 @@ int ntv2_ioctl(struct inode *inode, struct file *file, unsigned int cmd, unsigne
 		}
 		break;
 
+	case IOCTL_NTV2_INTERRUPT_EVENTS:
+		{
+			NTV2_INTERRUPT_EVENTS_STRUCT param;
+			ULWord64 count;
+			int intrIndex;
+
+			if (pFileData == NULL)
+				return -ENOMEM;
+			if(copy_from_user((void*)&param,(const void*) arg,sizeof(NTV2_INTERRUPT_EVENTS_STRUCT)))
+				return -EFAULT;
+
+			if (param.setMask)
+			{
+				// new subscription starts with no pending events
+				pFileData->interruptMask = param.subscribeMask & ((((ULWord64)1) << eNumInterruptTypes) - 1);
+				for (intrIndex = 0; intrIndex < eNumInterruptTypes; intrIndex++)
+					pFileData->interruptCount[intrIndex] = *((volatile ULWord64 *)&pNTV2Params->_interruptCount[intrIndex]);
+			}
+
+			param.subscribeMask = pFileData->interruptMask;
+			param.eventMask = 0;
+			for (intrIndex = 0; intrIndex < eNumInterruptTypes; intrIndex++)
+			{
+				param.eventCount[intrIndex] = 0;
+				param.eventTime[intrIndex] = 0;
+				if ((pFileData->interruptMask & (((ULWord64)1) << intrIndex)) == 0)
+					continue;
+				count = *((volatile ULWord64 *)&pNTV2Params->_interruptCount[intrIndex]);
+				if (count == pFileData->interruptCount[intrIndex])
+					continue;
+				param.eventMask |= ((ULWord64)1) << intrIndex;
+				param.eventCount[intrIndex] = (ULWord)(count - pFileData->interruptCount[intrIndex]);
+				param.eventTime[intrIndex] = *((volatile LWord64 *)&pNTV2Params->_interruptTime[intrIndex]);
+				pFileData->interruptCount[intrIndex] = count;
+			}
+
+			if(copy_to_user((void*)arg,(const void*) &param,sizeof(NTV2_INTERRUPT_EVENTS_STRUCT)))
+				return -EFAULT;
+		}
+		break;
+
 	case IOCTL_NTV2_SETUP_BOARD:
 		{
 		   SetupBoard(deviceNumber);
@@ -2121,6 +2164,7 @@ int ntv2_mmap(struct file *file,struct vm_area_struct* vma)
 #endif
 	NTV2PrivateParams* pNTV2Params;
 	ULWord size = vma->vm_end-vma->vm_start;
+	unsigned long registerAddress;
 	// MSG("%s%d: ntv2_mmap() %lx\n", getNTV2ModuleParams()->name,	deviceNumber, vma->vm_pgoff);
 
 	if ( !(pNTV2Params = getNTV2Params(deviceNumber)) )
@@ -2161,6 +2205,30 @@ int ntv2_mmap(struct file *file,struct vm_area_struct* vma)
 			return -EAGAIN;
 		break;
 
+	case 3:		//	Read-only, uncached register window for polling status registers without an ioctl per read
+		//	Same checks as ReadReg:  register access must be enabled, and the window can't go past the
+		//	video registers (see IsRegisterNumValid), which are in BAR1 on NWL devices
+		if (!pNTV2Params->registerEnable)
+			return -EACCES;
+		if ((vma->vm_flags & VM_WRITE) || (size > pNTV2Params->_VideoMemorySize))
+			return -EPERM;
+		registerAddress = pNTV2Params->_unmappedBAR0Address;
+		if (pNTV2Params->_VideoAddress == pNTV2Params->_mappedBAR1Address)
+			registerAddress = pNTV2Params->_unmappedBAR1Address;
+#if defined(KERNEL_6_3_0_VM_FLAGS)
+		vm_flags_clear(vma, VM_MAYWRITE);
+#else
+		vma->vm_flags &= ~VM_MAYWRITE;
+#endif
+		vma->vm_page_prot = pgprot_noncached(vma->vm_page_prot);
+#if !defined(RHEL4)
+		if ( remap_pfn_range(vma, vma->vm_start,registerAddress >> PAGE_SHIFT,size,vma->vm_page_prot))
+#else
+		if ( remap_page_range( vma, vma->vm_start, registerAddress, size, vma->vm_page_prot))
+#endif
+			return -EAGAIN;
+		break;
+
 	default:
 		return -EAGAIN;
 		break;
@@ -2204,6 +2272,38 @@ void InitInterruptBitLUT(void)
 	intrBitLut[eAuxVerticalInterrupt]	= NTV2_AUX_VERTICAL_INTERRUPT; 	// AV Interrupt reg
 }
 
+// Poll for subscribed interrupt events (see IOCTL_NTV2_INTERRUPT_EVENTS)
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(4,16,0))
+__poll_t ntv2_poll(struct file *file, poll_table *wait)
+#else
+unsigned int ntv2_poll(struct file *file, poll_table *wait)
+#endif
+{
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3,19,0))
+	UWord deviceNumber = MINOR(file->f_path.dentry->d_inode->i_rdev);
+#else
+	UWord deviceNumber = MINOR(file->f_dentry->d_inode->i_rdev);
+#endif
+	NTV2PrivateParams* pNTV2Params = getNTV2Params(deviceNumber);
+	PFILE_DATA pFileData = (PFILE_DATA)file->private_data;
+	unsigned int mask = 0;
+	int intrIndex;
+
+	if ((pNTV2Params == NULL) || (pFileData == NULL))
+		return POLLERR;
+
+	for (intrIndex = 0; intrIndex < eNumInterruptTypes; intrIndex++)
+	{
+		if ((pFileData->interruptMask & (((ULWord64)1) << intrIndex)) == 0)
+			continue;
+		poll_wait(file, &pNTV2Params->_interruptWait[intrIndex], wait);
+		if (*((volatile ULWord64 *)&pNTV2Params->_interruptCount[intrIndex]) != pFileData->interruptCount[intrIndex])
+			mask |= POLLIN | POLLRDNORM;
+	}
+
+	return mask;
+}
+
 /* Function to open device */
 int ntv2_open(struct inode *minode, struct file *mfile)
 {
@@ -2240,6 +2340,7 @@ int ntv2_open(struct inode *minode, struct file *mfile)
     pFileData = (PFILE_DATA)kmalloc(sizeof (FILE_DATA), GFP_ATOMIC);
 	if (pFileData != NULL)
 	{
+		pFileData->interruptMask = 0;
 		if (dmaPageRootInit(deviceNumber, &pFileData->dmaRoot) == 0)
 		{
 			mfile->private_data = pFileData;
@@ -2304,6 +2405,7 @@ int ntv2_release(struct inode *minode, struct file *mfile) {
 inline void
 interruptHousekeeping(NTV2PrivateParams* pNTV2Params, INTERRUPT_ENUMS interrupt)
 {
+	pNTV2Params->_interruptTime[interrupt] = ntv2Time100ns();
 	set_bit(0, (volatile unsigned long *)&pNTV2Params->_interruptHappened[interrupt]);
 	pNTV2Params->_interruptCount[interrupt]++;
 	wake_up(&pNTV2Params->_interruptWait[interrupt]);
@@ -3398,6 +3500,7 @@ static int probe(struct pci_dev *pdev, const struct pci_device_id *id)	/* New de
 	{
 		ntv2pp->_interruptCount[intrIndex] = 0;
 		ntv2pp->_interruptHappened[intrIndex] = 0;
+		ntv2pp->_interruptTime[intrIndex] = 0;
 		init_waitqueue_head(&ntv2pp->_interruptWait[intrIndex]);
 	}
 
@@ -3451,6 +3554,9 @@ static int probe(struct pci_dev *pdev, const struct pci_device_id *id)	/* New de
 
 	ntv2pp->_VirtualMailBoxTimeoutNS = 100000;	// In units of 100 ns, so this is 10 ms
 
+	atomic64_set(&ntv2pp->_dmaPageCacheHits, 0);
+	atomic64_set(&ntv2pp->_dmaPageCacheMisses, 0);
+
     WriteRegister(deviceNumber, kVRegUserDefinedDBB, 0x0, NO_MASK, NO_SHIFT);
     WriteRegister(deviceNumber, kVRegEnableBT2020, 0x0, NO_MASK, NO_SHIFT);
     WriteRegister(deviceNumber, kVRegDisableAutoVPID, 0x0, NO_MASK, NO_SHIFT);
@@ -3883,7 +3989,8 @@ static int probe(struct pci_dev *pdev, const struct pci_device_id *id)	/* New de
 		return res;
 	}
 
-	device = device_create(getNTV2ModuleParams()->class, NULL, dev,
+	// Parent it to the PCI device, so sysfs links /sys/class/ajantv2/ajantv2N/device to it (e.g. for numa_node)
+	device = device_create(getNTV2ModuleParams()->class, &pdev->dev, dev,
 		NULL, "ajantv2%d", deviceNumber);
 	if (IS_ERR(device))
 	{
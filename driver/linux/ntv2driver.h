@@ -17,6 +17,7 @@
 #define NTV2_DRIVER_HEADER
 
 #include <linux/fs.h>
+#include <linux/poll.h>
 
 // Defines
 #define NTV2_MAJOR 0
@@ -88,6 +89,11 @@ long        ntv2_ioctl(struct file *file, unsigned int cmd,  unsigned long arg);
 int         ntv2_ioctl(struct inode *inode, struct file *file, unsigned int cmd, unsigned long arg);
 #endif
 int         ntv2_mmap(struct file *file,struct vm_area_struct* vma);
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(4,16,0))
+__poll_t    ntv2_poll(struct file *file, poll_table *wait);
+#else
+unsigned int ntv2_poll(struct file *file, poll_table *wait);
+#endif
 int         ntv2_open(struct inode *minode, struct file *mfile);
 int         ntv2_release(struct inode *minode, struct file *mfile);
 
@@ -730,6 +730,14 @@ int WriteReg(	ULWord deviceNumber,
 			ntv2WritePciMaxReadRequestSize(&pNTV2Params->systemContext, registerValue);
 			break;
 
+		case kVRegDmaPageCacheHits:
+			atomic64_set(&pNTV2Params->_dmaPageCacheHits, registerValue);
+			break;
+
+		case kVRegDmaPageCacheMisses:
+			atomic64_set(&pNTV2Params->_dmaPageCacheMisses, registerValue);
+			break;
+
 		default:
 			// store virtual reg
 			pNTV2Params->_virtualRegisterMem[registerNumber - VIRTUALREG_START] = registerValue;
@@ -1112,6 +1120,14 @@ int ReadReg(    ULWord deviceNumber,
 		case kVRegPCIMaxReadRequestSize:
 			*registerValue = ntv2ReadPciMaxReadRequestSize(&pNTV2Params->systemContext);
 			return 0;
+
+		case kVRegDmaPageCacheHits:
+			*registerValue = (ULWord)atomic64_read(&pNTV2Params->_dmaPageCacheHits);
+			return 0;
+
+		case kVRegDmaPageCacheMisses:
+			*registerValue = (ULWord)atomic64_read(&pNTV2Params->_dmaPageCacheMisses);
+			return 0;
 			
 		default:
 			// return virtual reg
@@ -121,6 +121,8 @@ typedef struct ntv2_module_private
 typedef struct _fileData
 {
 	DMA_PAGE_ROOT dmaRoot;
+	ULWord64 interruptMask;							// subscribed interrupt events (bit per INTERRUPT_ENUMS)
+	ULWord64 interruptCount[eNumInterruptTypes];	// interrupt counts at the last event read
 } FILE_DATA, *PFILE_DATA;
 
 typedef enum
@@ -304,6 +306,7 @@ typedef struct ntv2_private
 
 	ULWord64 				_interruptCount[eNumInterruptTypes];
 	unsigned long			_interruptHappened[eNumInterruptTypes];
+	LWord64					_interruptTime[eNumInterruptTypes];	// time of the latest interrupt (100 ns)
 
 	struct semaphore        _I2CMutex;
 
@@ -397,6 +400,9 @@ typedef struct ntv2_private
 
 	ULWord _VirtualMailBoxTimeoutNS;			// 10478	//	Units are 100 ns, not nanoseconds!
 
+	atomic64_t _dmaPageCacheHits;				// kVRegDmaPageCacheHits (all clients)
+	atomic64_t _dmaPageCacheMisses;				// kVRegDmaPageCacheMisses (all clients)
+
 	// P2P  -  Peer to peer messaging
 	unsigned long _pMessageChannel1;			// control register kerenel address
 	unsigned long _pMessageChannel2;
@@ -54,6 +54,15 @@ static const uint32_t gNTV2InputSourceToANCChannel[NTV2_NUM_INPUTSOURCES+1] = {
 	extern uint32_t Ntv2DMATransferCon(Ntv2SystemContext* context, PAUTO_DMA_PARAMS pDmaParams);
 #endif
 
+// memory descriptors are only present in the mac transfer buffers
+#if defined(AJAMac)
+	#define AUTO_BUFFER_DESC(buffer)	((PVOID)(buffer).fIOMemoryDesc)
+	#define AUTO_BUFFER_MAP(buffer)		((PVOID)(buffer).fIOMemoryMap)
+#else
+	#define AUTO_BUFFER_DESC(buffer)	NULL
+	#define AUTO_BUFFER_MAP(buffer)		NULL
+#endif
+
 //-------------------------------------------------------------------------------------------------------
 //	AutoCirculateControl
 //-------------------------------------------------------------------------------------------------------
@@ -1519,8 +1528,8 @@ Ntv2Status AutoCircTransfer(NTV2AutoCirc* pAutoCirc,
 					dmaParams.dmaEngine = eVideoDmaEngine;
 					dmaParams.videoChannel = channel;
 					dmaParams.pVidUserVa = (PVOID)transfer.acVideoBuffer.fUserSpacePtr;
-					dmaParams.pVidDesc = (PVOID)transfer.acVideoBuffer.fIOMemoryDesc;
-					dmaParams.pVidMap = (PVOID)transfer.acVideoBuffer.fIOMemoryMap;
+					dmaParams.pVidDesc = AUTO_BUFFER_DESC(transfer.acVideoBuffer);
+					dmaParams.pVidMap = AUTO_BUFFER_MAP(transfer.acVideoBuffer);
 					dmaParams.videoFrame = frameNumber;
 					dmaParams.vidNumBytes = transfer.acVideoBuffer.fByteCount;
 					dmaParams.frameOffset = transfer.acInVideoDMAOffset;
@@ -1528,20 +1537,20 @@ Ntv2Status AutoCircTransfer(NTV2AutoCirc* pAutoCirc,
 					dmaParams.vidFramePitch = transfer.acInSegmentedDMAInfo.acSegmentDevicePitch;
 					dmaParams.numSegments = transfer.acInSegmentedDMAInfo.acNumSegments;
 					dmaParams.pAudUserVa = withAudio ? (PVOID)transfer.acAudioBuffer.fUserSpacePtr : NULL;
-					dmaParams.pAudDesc = withAudio ? (PVOID)transfer.acAudioBuffer.fIOMemoryDesc : NULL;
-					dmaParams.pAudMap = withAudio ? (PVOID)transfer.acAudioBuffer.fIOMemoryMap : NULL;
+					dmaParams.pAudDesc = withAudio ? AUTO_BUFFER_DESC(transfer.acAudioBuffer) : NULL;
+					dmaParams.pAudMap = withAudio ? AUTO_BUFFER_MAP(transfer.acAudioBuffer) : NULL;
 					dmaParams.audioSystem = pAuto->audioSystem;
 					dmaParams.audNumBytes = withAudio ? pAuto->audioTransferSize : 0;
 					dmaParams.audOffset = withAudio ? pAuto->audioTransferOffset : 0;
 					dmaParams.pAncF1UserVa = withAnc ? (PVOID)transfer.acANCBuffer.fUserSpacePtr : NULL;
-					dmaParams.pAncF1Desc = withAnc ? (PVOID)transfer.acANCBuffer.fIOMemoryDesc : NULL;
-					dmaParams.pAncF1Map = withAnc ? (PVOID)transfer.acANCBuffer.fIOMemoryMap : NULL;
+					dmaParams.pAncF1Desc = withAnc ? AUTO_BUFFER_DESC(transfer.acANCBuffer) : NULL;
+					dmaParams.pAncF1Map = withAnc ? AUTO_BUFFER_MAP(transfer.acANCBuffer) : NULL;
 					dmaParams.ancF1Frame = frameNumber;
 					dmaParams.ancF1NumBytes = withAnc ? pAuto->ancTransferSize : 0;
 					dmaParams.ancF1Offset = withAnc ? pAuto->ancTransferOffset : 0;
 					dmaParams.pAncF2UserVa = withAnc ? (PVOID)transfer.acANCField2Buffer.fUserSpacePtr : NULL;
-					dmaParams.pAncF2Desc = withAnc ? (PVOID)transfer.acANCField2Buffer.fIOMemoryDesc : NULL;
-					dmaParams.pAncF2Map = withAnc ? (PVOID)transfer.acANCField2Buffer.fIOMemoryMap : NULL;
+					dmaParams.pAncF2Desc = withAnc ? AUTO_BUFFER_DESC(transfer.acANCField2Buffer) : NULL;
+					dmaParams.pAncF2Map = withAnc ? AUTO_BUFFER_MAP(transfer.acANCField2Buffer) : NULL;
 					dmaParams.ancF2Frame = frameNumber;
 					dmaParams.ancF2NumBytes = withAnc ? pAuto->ancField2TransferSize : 0;
 					dmaParams.ancF2Offset = withAnc ? pAuto->ancField2TransferOffset : 0;
@@ -1565,8 +1574,8 @@ Ntv2Status AutoCircTransfer(NTV2AutoCirc* pAutoCirc,
 						dmaParams.dmaEngine = eVideoDmaEngine;
 						dmaParams.videoChannel = channel;
 						dmaParams.pVidUserVa = (PVOID)transfer.acVideoBuffer.fUserSpacePtr;
-						dmaParams.pVidDesc = (PVOID)transfer.acVideoBuffer.fIOMemoryDesc;
-						dmaParams.pVidMap = (PVOID)transfer.acVideoBuffer.fIOMemoryMap;
+						dmaParams.pVidDesc = AUTO_BUFFER_DESC(transfer.acVideoBuffer);
+						dmaParams.pVidMap = AUTO_BUFFER_MAP(transfer.acVideoBuffer);
 						dmaParams.videoFrame = frameNumber;
 						dmaParams.vidNumBytes = transfer.acVideoBuffer.fByteCount;
 						dmaParams.frameOffset = transfer.acInVideoDMAOffset;
@@ -1585,8 +1594,8 @@ Ntv2Status AutoCircTransfer(NTV2AutoCirc* pAutoCirc,
 					dmaParams.dmaEngine = eVideoDmaEngine;
 					dmaParams.videoChannel = channel;
 					dmaParams.pVidUserVa = (PVOID)pTransferStruct->acVideoBuffer.fUserSpacePtr;
-					dmaParams.pVidDesc = (PVOID)pTransferStruct->acVideoBuffer.fIOMemoryDesc;
-					dmaParams.pVidMap = (PVOID)pTransferStruct->acVideoBuffer.fIOMemoryMap;
+					dmaParams.pVidDesc = AUTO_BUFFER_DESC(pTransferStruct->acVideoBuffer);
+					dmaParams.pVidMap = AUTO_BUFFER_MAP(pTransferStruct->acVideoBuffer);
 					dmaParams.videoFrame = frameNumber;
 					dmaParams.vidNumBytes = pTransferStruct->acVideoBuffer.fByteCount;
 					dmaParams.frameOffset = pTransferStruct->acInVideoDMAOffset;
@@ -1594,20 +1603,20 @@ Ntv2Status AutoCircTransfer(NTV2AutoCirc* pAutoCirc,
 					dmaParams.vidFramePitch = pTransferStruct->acInSegmentedDMAInfo.acSegmentDevicePitch;
 					dmaParams.numSegments = pTransferStruct->acInSegmentedDMAInfo.acNumSegments;
 					dmaParams.pAudUserVa = withAudio ? (PVOID)pTransferStruct->acAudioBuffer.fUserSpacePtr : NULL;
-					dmaParams.pAudDesc = withAudio ? (PVOID)pTransferStruct->acAudioBuffer.fIOMemoryDesc : NULL;
-					dmaParams.pAudMap = withAudio ? (PVOID)pTransferStruct->acAudioBuffer.fIOMemoryMap : NULL;
+					dmaParams.pAudDesc = withAudio ? AUTO_BUFFER_DESC(pTransferStruct->acAudioBuffer) : NULL;
+					dmaParams.pAudMap = withAudio ? AUTO_BUFFER_MAP(pTransferStruct->acAudioBuffer) : NULL;
 					dmaParams.audioSystem = pAuto->audioSystem;
 					dmaParams.audNumBytes = withAudio ? pAuto->audioTransferSize : 0;
 					dmaParams.audOffset = withAudio ? pAuto->audioTransferOffset : 0;
 					dmaParams.pAncF1UserVa = withAnc ? (PVOID)pTransferStruct->acANCBuffer.fUserSpacePtr : NULL;
-					dmaParams.pAncF1Desc = withAnc ? (PVOID)pTransferStruct->acANCBuffer.fIOMemoryDesc : NULL;
-					dmaParams.pAncF1Map = withAnc ? (PVOID)pTransferStruct->acANCBuffer.fIOMemoryMap : NULL;
+					dmaParams.pAncF1Desc = withAnc ? AUTO_BUFFER_DESC(pTransferStruct->acANCBuffer) : NULL;
+					dmaParams.pAncF1Map = withAnc ? AUTO_BUFFER_MAP(pTransferStruct->acANCBuffer) : NULL;
 					dmaParams.ancF1Frame = frameNumber;
 					dmaParams.ancF1NumBytes = withAnc ? pAuto->ancTransferSize : 0;
 					dmaParams.ancF1Offset = withAnc ? pAuto->ancTransferOffset : 0;
 					dmaParams.pAncF2UserVa = withAnc ? (PVOID)pTransferStruct->acANCField2Buffer.fUserSpacePtr : NULL;
-					dmaParams.pAncF2Desc = withAnc ? (PVOID)pTransferStruct->acANCField2Buffer.fIOMemoryDesc : NULL;
-					dmaParams.pAncF2Map = withAnc ? (PVOID)pTransferStruct->acANCField2Buffer.fIOMemoryMap : NULL;
+					dmaParams.pAncF2Desc = withAnc ? AUTO_BUFFER_DESC(pTransferStruct->acANCField2Buffer) : NULL;
+					dmaParams.pAncF2Map = withAnc ? AUTO_BUFFER_MAP(pTransferStruct->acANCField2Buffer) : NULL;
 					dmaParams.ancF2Frame = frameNumber;
 					dmaParams.ancF2NumBytes = withAnc ? pAuto->ancField2TransferSize : 0;
 					dmaParams.ancF2Offset = withAnc ? pAuto->ancField2TransferOffset : 0;
@@ -1651,8 +1660,8 @@ Ntv2Status AutoCircTransfer(NTV2AutoCirc* pAutoCirc,
 			dmaParams.dmaEngine = eAudioDmaEngine;
 			dmaParams.videoChannel = channel;
 			dmaParams.pAudUserVa = (PVOID)pTransferStruct->acAudioBuffer.fUserSpacePtr;
-			dmaParams.pAudDesc = (PVOID)pTransferStruct->acAudioBuffer.fIOMemoryDesc;
-			dmaParams.pAudMap = (PVOID)pTransferStruct->acAudioBuffer.fIOMemoryMap;
+			dmaParams.pAudDesc = AUTO_BUFFER_DESC(pTransferStruct->acAudioBuffer);
+			dmaParams.pAudMap = AUTO_BUFFER_MAP(pTransferStruct->acAudioBuffer);
 			dmaParams.audioSystem = pAuto->audioSystem;
 			dmaParams.audNumBytes = pAuto->audioTransferSize;
 			dmaParams.audOffset = pAuto->audioTransferOffset;
@@ -3941,7 +3950,7 @@ bool AutoCircCanDoFieldMode(INTERNAL_AUTOCIRCULATE_STRUCT* pAuto)
 //	Real device drivers and fake devices must implement:
 Ntv2Status	AutoDmaTransfer(void* pContext, PAUTO_DMA_PARAMS pDmaParams)
 {
-#if defined(AJAMacDext)
+#if defined(AJAMacDext) || defined(AJAVirtual)
 	extern Ntv2Status ntv2DMATransferCon(Ntv2SystemContext* pSysCon, PAUTO_DMA_PARAMS pDmaParams);
 	return ntv2DMATransferCon((Ntv2SystemContext*) pContext, pDmaParams);
 #endif
@@ -3950,6 +3959,10 @@ Ntv2Status	AutoDmaTransfer(void* pContext, PAUTO_DMA_PARAMS pDmaParams)
 
 int64_t		AutoGetAudioClock(void* pContext)
 {
+#if defined(AJAVirtual)
+	extern int64_t ntv2AudioClockCon(Ntv2SystemContext* pSysCon);
+	return ntv2AudioClockCon((Ntv2SystemContext*) pContext);
+#endif
 	return 0;
 }
 
@@ -0,0 +1,153 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright (C) 2004 - 2022 AJA Video Systems, Inc.
+ */
+//========================================================================
+//
+//  ntv2pagecache.c
+//
+//==========================================================================
+
+#include "ntv2system.h"
+#include "ntv2pagecache.h"
+
+static uint32_t hash_index(uint64_t address)
+{
+	// fibonacci hash of the page number
+	return (uint32_t)(((address >> 12) * 0x9e3779b97f4a7c15ULL) >> (64 - NTV2_PAGE_CACHE_HASH_BITS));
+}
+
+static void lru_unlink(struct ntv2_page_cache_node *node)
+{
+	node->lru_prev->lru_next = node->lru_next;
+	node->lru_next->lru_prev = node->lru_prev;
+	node->lru_prev = node;
+	node->lru_next = node;
+}
+
+static void lru_append(struct ntv2_page_cache *cache, struct ntv2_page_cache_node *node)
+{
+	// most recently used goes before the sentinel
+	node->lru_next = &cache->lru_head;
+	node->lru_prev = cache->lru_head.lru_prev;
+	cache->lru_head.lru_prev->lru_next = node;
+	cache->lru_head.lru_prev = node;
+}
+
+void ntv2_page_cache_init(struct ntv2_page_cache *cache)
+{
+	if (cache == NULL)
+		return;
+
+	memset(cache, 0, sizeof(struct ntv2_page_cache));
+	cache->lru_head.lru_prev = &cache->lru_head;
+	cache->lru_head.lru_next = &cache->lru_head;
+}
+
+void ntv2_page_cache_insert(struct ntv2_page_cache *cache, struct ntv2_page_cache_node *node,
+							uint64_t address, uint32_t size, uint64_t bytes, void *owner)
+{
+	uint32_t index;
+
+	if ((cache == NULL) || (node == NULL))
+		return;
+
+	node->address = address;
+	node->size = size;
+	node->bytes = bytes;
+	node->owner = owner;
+
+	index = hash_index(address);
+	node->hash_next = cache->hash_table[index];
+	cache->hash_table[index] = node;
+	lru_append(cache, node);
+
+	cache->stats.buffers++;
+	cache->stats.bytes += bytes;
+}
+
+void ntv2_page_cache_remove(struct ntv2_page_cache *cache, struct ntv2_page_cache_node *node)
+{
+	struct ntv2_page_cache_node **link;
+
+	if ((cache == NULL) || (node == NULL))
+		return;
+
+	// unlink from hash bucket
+	link = &cache->hash_table[hash_index(node->address)];
+	while (*link != NULL)
+	{
+		if (*link == node)
+		{
+			*link = node->hash_next;
+			node->hash_next = NULL;
+			lru_unlink(node);
+			cache->stats.buffers--;
+			cache->stats.bytes -= node->bytes;
+			return;
+		}
+		link = &(*link)->hash_next;
+	}
+}
+
+void ntv2_page_cache_evict(struct ntv2_page_cache *cache, struct ntv2_page_cache_node *node)
+{
+	if ((cache == NULL) || (node == NULL))
+		return;
+
+	ntv2_page_cache_remove(cache, node);
+	cache->stats.evictions++;
+}
+
+struct ntv2_page_cache_node* ntv2_page_cache_find(struct ntv2_page_cache *cache, uint64_t address,
+												  ntv2_page_cache_match *match, void *context, bool count)
+{
+	struct ntv2_page_cache_node *node;
+
+	if (cache == NULL)
+		return NULL;
+
+	for (node = cache->hash_table[hash_index(address)]; node != NULL; node = node->hash_next)
+	{
+		if (node->address != address)
+			continue;
+		if ((match != NULL) && !match(node, context))
+			continue;
+
+		// found node so make it most recently used
+		lru_unlink(node);
+		lru_append(cache, node);
+		if (count)
+			cache->stats.hits++;
+		return node;
+	}
+
+	if (count)
+		cache->stats.misses++;
+	return NULL;
+}
+
+struct ntv2_page_cache_node* ntv2_page_cache_oldest(struct ntv2_page_cache *cache,
+													ntv2_page_cache_match *match, void *context)
+{
+	struct ntv2_page_cache_node *node;
+
+	if (cache == NULL)
+		return NULL;
+
+	for (node = cache->lru_head.lru_next; node != &cache->lru_head; node = node->lru_next)
+	{
+		if ((match == NULL) || match(node, context))
+			return node;
+	}
+
+	return NULL;
+}
+
+struct ntv2_page_cache_node* ntv2_page_cache_first(struct ntv2_page_cache *cache)
+{
+	if ((cache == NULL) || (cache->lru_head.lru_next == &cache->lru_head))
+		return NULL;
+
+	return cache->lru_head.lru_next;
+}
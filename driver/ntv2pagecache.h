@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright (C) 2004 - 2022 AJA Video Systems, Inc.
+ */
+//========================================================================
+//
+//  ntv2pagecache.h
+//
+//	Address indexed cache of locked user buffers with lru eviction order.
+//	The cache does no locking and no allocation, the owner provides both.
+//
+//==========================================================================
+
+#ifndef NTV2PAGECACHE_H
+#define NTV2PAGECACHE_H
+
+#include "ntv2system.h"
+
+#define NTV2_PAGE_CACHE_HASH_BITS	8
+#define NTV2_PAGE_CACHE_HASH_SIZE	(1 << NTV2_PAGE_CACHE_HASH_BITS)
+
+struct ntv2_page_cache_node;
+
+// match callback (return true to accept node)
+typedef bool ntv2_page_cache_match(struct ntv2_page_cache_node *node, void *context);
+
+struct ntv2_page_cache_node {
+	struct ntv2_page_cache_node*	hash_next;		// next node in hash bucket
+	struct ntv2_page_cache_node*	lru_prev;		// less recently used node
+	struct ntv2_page_cache_node*	lru_next;		// more recently used node
+	uint64_t						address;		// user buffer address (key)
+	uint32_t						size;			// user buffer size
+	uint64_t						bytes;			// locked bytes
+	void*							owner;			// object that contains the node
+};
+
+struct ntv2_page_cache_stats {
+	uint64_t						hits;			// lookups that found a buffer
+	uint64_t						misses;			// lookups that found no buffer
+	uint64_t						evictions;		// buffers removed to make room
+	uint64_t						buffers;		// buffers in cache
+	uint64_t						bytes;			// locked bytes in cache
+};
+
+struct ntv2_page_cache {
+	struct ntv2_page_cache_node*	hash_table[NTV2_PAGE_CACHE_HASH_SIZE];
+	struct ntv2_page_cache_node		lru_head;		// list sentinel (next is least recently used)
+	struct ntv2_page_cache_stats	stats;			// cache statistics
+};
+
+void ntv2_page_cache_init(struct ntv2_page_cache *cache);
+
+void ntv2_page_cache_insert(struct ntv2_page_cache *cache, struct ntv2_page_cache_node *node,
+							uint64_t address, uint32_t size, uint64_t bytes, void *owner);
+void ntv2_page_cache_remove(struct ntv2_page_cache *cache, struct ntv2_page_cache_node *node);
+void ntv2_page_cache_evict(struct ntv2_page_cache *cache, struct ntv2_page_cache_node *node);
+
+struct ntv2_page_cache_node* ntv2_page_cache_find(struct ntv2_page_cache *cache, uint64_t address,
+												  ntv2_page_cache_match *match, void *context, bool count);
+struct ntv2_page_cache_node* ntv2_page_cache_oldest(struct ntv2_page_cache *cache,
+													ntv2_page_cache_match *match, void *context);
+struct ntv2_page_cache_node* ntv2_page_cache_first(struct ntv2_page_cache *cache);
+
+#endif
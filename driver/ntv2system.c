@@ -341,9 +341,12 @@ void ntv2SemaphoreUp(Ntv2Semaphore* pSemaphore)
 	if(pSemaphore == NULL) return;
 }
 
+// the virtual device provides the clock (microseconds)
+extern int64_t ntv2TimeCounterCon(void);
+
 int64_t ntv2TimeCounter(void)
 {
-	return 0;
+	return ntv2TimeCounterCon();
 }
 
 int64_t ntv2TimeFrequency(void)
@@ -353,7 +356,7 @@ int64_t ntv2TimeFrequency(void)
 
 int64_t ntv2Time100ns(void)
 {
-	return 0;
+	return ntv2TimeCounterCon() * 10;
 }
 
 void ntv2TimeSleep(int64_t microseconds)
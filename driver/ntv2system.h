@@ -65,9 +65,10 @@
 	//MRBILL	#define ntv2WriteRegister32(reg, value)		
 	//MRBILL	#define ntv2ReadRegister32(reg)				
 
-	// virtual message abstraction
+	// virtual message abstraction (output provided by the virtual device)
 
-	#define ntv2Message(string, ...) 			printf(string, __VA_ARGS__); fflush(stdout)
+	void ntv2MessageCon(const char* pFormat, ...);
+	#define ntv2Message(string, ...) 			ntv2MessageCon(string, ##__VA_ARGS__)
 
 	// virtual spinlock abstraction
 
@@ -0,0 +1,534 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright (C) 2004 - 2022 AJA Video Systems, Inc.
+ */
+//========================================================================
+//
+//  ntv2acsim.c
+//
+//	AutoCirculate simulation.  Runs the common driver autocirculate engine
+//	against a virtual device with simulated clients that service their
+//	channels each vertical blank (or are late), then reports the per isr
+//	cost and the drop/repeat counts.  With no scenario options the built
+//	in suite runs and the exit status reports any failed expectation.
+//
+//==========================================================================
+
+#include "ntv2virtualdevice.h"
+#include "ntv2autocirc.h"
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define SIM_MAX_CHANNELS		8
+#define SIM_MAX_CIRCULATORS		(SIM_MAX_CHANNELS * 2)
+#define SIM_HISTOGRAM_SIZE		10000		// 10 ns buckets
+#define SIM_HISTOGRAM_SCALE		10
+
+struct sim_histogram {
+	uint64_t			count;
+	uint64_t			total;
+	uint64_t			max;
+	uint64_t			buckets[SIM_HISTOGRAM_SIZE + 1];
+};
+
+struct sim_params {
+	const char*			name;
+	uint32_t			outputs;			// playback channels
+	uint32_t			inputs;				// capture channels
+	uint32_t			frames;				// frames per channel
+	uint64_t			vbis;				// vertical blanks to simulate
+	uint32_t			late_percent;		// chance a client misses a vertical blank
+	uint32_t			stall_interval;		// all clients stall every n vertical blanks
+	uint32_t			stall_length;		// vertical blanks per stall
+	uint32_t			dma_fail_interval;	// fail every nth dma transfer
+	bool				interlaced;
+	uint32_t			seed;
+};
+
+struct sim_expect {
+	bool				no_drops;			// every circulator must have zero drops
+	bool				drops;				// every circulator must have some drops
+};
+
+struct sim_circulator {
+	NTV2Crosspoint		crosspoint;
+	char				name[8];
+	uint64_t			transfers;
+	uint32_t			processed;
+	uint32_t			dropped;
+};
+
+struct sim_result {
+	struct sim_histogram	isr;
+	struct sim_histogram	transfer;
+	struct sim_circulator	circulators[SIM_MAX_CIRCULATORS];
+	uint32_t				num_circulators;
+	uint64_t				late_services;
+	double					seconds;
+	bool					stopped;
+};
+
+static uint32_t s_random = 1;
+
+static uint32_t sim_random(void)
+{
+	// xorshift32
+	s_random ^= s_random << 13;
+	s_random ^= s_random >> 17;
+	s_random ^= s_random << 5;
+	return s_random;
+}
+
+static uint64_t sim_nanoseconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void histogram_add(struct sim_histogram *hist, uint64_t ns)
+{
+	uint64_t index = ns / SIM_HISTOGRAM_SCALE;
+
+	hist->count++;
+	hist->total += ns;
+	if (ns > hist->max)
+		hist->max = ns;
+	hist->buckets[(index < SIM_HISTOGRAM_SIZE) ? index : SIM_HISTOGRAM_SIZE]++;
+}
+
+static uint64_t histogram_percentile(struct sim_histogram *hist, double percent)
+{
+	uint64_t target = (uint64_t)((double)hist->count * percent / 100.0);
+	uint64_t sum = 0;
+	uint32_t i;
+
+	for (i = 0; i <= SIM_HISTOGRAM_SIZE; i++)
+	{
+		sum += hist->buckets[i];
+		if (sum > target)
+			return (i < SIM_HISTOGRAM_SIZE) ? (uint64_t)i * SIM_HISTOGRAM_SCALE : hist->max;
+	}
+	return hist->max;
+}
+
+static void histogram_print(const char *name, struct sim_histogram *hist)
+{
+	if (hist->count == 0)
+	{
+		printf("  %-9s none\n", name);
+		return;
+	}
+
+	printf("  %-9s %10llu calls  mean %6llu ns  p50 %6llu  p99 %6llu  p99.9 %6llu  max %8llu ns\n",
+		   name,
+		   (unsigned long long)hist->count,
+		   (unsigned long long)(hist->total / hist->count),
+		   (unsigned long long)histogram_percentile(hist, 50.0),
+		   (unsigned long long)histogram_percentile(hist, 99.0),
+		   (unsigned long long)histogram_percentile(hist, 99.9),
+		   (unsigned long long)hist->max);
+}
+
+static NTV2Crosspoint output_crosspoint(uint32_t index)
+{
+	static const NTV2Crosspoint crosspoints[SIM_MAX_CHANNELS] = {
+		NTV2CROSSPOINT_CHANNEL1, NTV2CROSSPOINT_CHANNEL2, NTV2CROSSPOINT_CHANNEL3, NTV2CROSSPOINT_CHANNEL4,
+		NTV2CROSSPOINT_CHANNEL5, NTV2CROSSPOINT_CHANNEL6, NTV2CROSSPOINT_CHANNEL7, NTV2CROSSPOINT_CHANNEL8};
+	return crosspoints[index];
+}
+
+static NTV2Crosspoint input_crosspoint(uint32_t index)
+{
+	static const NTV2Crosspoint crosspoints[SIM_MAX_CHANNELS] = {
+		NTV2CROSSPOINT_INPUT1, NTV2CROSSPOINT_INPUT2, NTV2CROSSPOINT_INPUT3, NTV2CROSSPOINT_INPUT4,
+		NTV2CROSSPOINT_INPUT5, NTV2CROSSPOINT_INPUT6, NTV2CROSSPOINT_INPUT7, NTV2CROSSPOINT_INPUT8};
+	return crosspoints[index];
+}
+
+static bool get_status(NTV2AutoCirc *pAutoCirc, NTV2Crosspoint crosspoint, AUTOCIRCULATE_STATUS *pStatus)
+{
+	memset(pStatus, 0, sizeof(AUTOCIRCULATE_STATUS));
+	pStatus->acCrosspoint = crosspoint;
+	return AutoCircGetStatus(pAutoCirc, pStatus) == NTV2_STATUS_SUCCESS;
+}
+
+static bool transfer_frame(NTV2AutoCirc *pAutoCirc, struct sim_circulator *circ,
+						   uint8_t *pBuffer, uint32_t size, struct sim_histogram *hist)
+{
+	AUTOCIRCULATE_TRANSFER transfer;
+	uint64_t start;
+	Ntv2Status status;
+
+	memset(&transfer, 0, sizeof(AUTOCIRCULATE_TRANSFER));
+	transfer.acCrosspoint = circ->crosspoint;
+	transfer.acDesiredFrame = NTV2_INVALID_FRAME;
+	transfer.acFrameRepeatCount = 1;
+	transfer.acVideoBuffer.fUserSpacePtr = (ULWord64)(uintptr_t)pBuffer;
+	transfer.acVideoBuffer.fByteCount = size;
+
+	start = sim_nanoseconds();
+	status = AutoCircTransfer(pAutoCirc, &transfer);
+	histogram_add(hist, sim_nanoseconds() - start);
+
+	if ((status != NTV2_STATUS_SUCCESS) ||
+		(transfer.acTransferStatus.acTransferFrame == NTV2_INVALID_FRAME))
+		return false;
+
+	circ->transfers++;
+	return true;
+}
+
+// service a channel the way the demo player and capture clients do
+static void service_circulator(NTV2AutoCirc *pAutoCirc, struct sim_circulator *circ, uint32_t frames,
+							   uint8_t *pBuffer, uint32_t size, struct sim_histogram *hist)
+{
+	AUTOCIRCULATE_STATUS status;
+	uint32_t i;
+
+	for (i = 0; i < frames; i++)
+	{
+		if (!get_status(pAutoCirc, circ->crosspoint, &status))
+			return;
+
+		if (NTV2_IS_INPUT_CROSSPOINT(circ->crosspoint))
+		{
+			if (status.acBufferLevel <= 1)
+				return;
+		}
+		else
+		{
+			if ((frames - status.acBufferLevel) <= 1)
+				return;
+		}
+
+		if (!transfer_frame(pAutoCirc, circ, pBuffer, size, hist))
+			return;
+	}
+}
+
+static bool run_scenario(const struct sim_params *params, struct sim_result *result)
+{
+	struct ntv2_virtual_device *ntv2_vdev = NULL;
+	NTV2AutoCirc *pAutoCirc = NULL;
+	uint8_t *pBuffer = NULL;
+	uint32_t bufferSize = 4096;
+	AUTOCIRCULATE_STATUS status;
+	uint64_t vbi;
+	uint64_t start;
+	uint32_t i;
+	bool success = false;
+
+	memset(result, 0, sizeof(struct sim_result));
+	if ((params->outputs > SIM_MAX_CHANNELS) ||
+		(params->inputs > SIM_MAX_CHANNELS) ||
+		(params->frames < 2) ||
+		((params->frames * SIM_MAX_CIRCULATORS) > MAX_FRAMEBUFFERS))
+	{
+		printf("error: bad scenario parameters\n");
+		return false;
+	}
+
+	s_random = (params->seed != 0) ? params->seed : 1;
+	ntv2_virtual_set_time(0);
+
+	ntv2_vdev = ntv2_virtual_device_open(DEVICE_ID_CORVID88);
+	pAutoCirc = (NTV2AutoCirc*)calloc(1, sizeof(NTV2AutoCirc));
+	pBuffer = (uint8_t*)calloc(1, bufferSize);
+	if ((ntv2_vdev == NULL) || (pAutoCirc == NULL) || (pBuffer == NULL))
+	{
+		printf("error: out of memory\n");
+		goto done;
+	}
+
+	ntv2_virtual_device_set_standard(ntv2_vdev,
+									 params->interlaced ? NTV2_STANDARD_1080 : NTV2_STANDARD_1080p,
+									 params->interlaced ? NTV2_FRAMERATE_3000 : NTV2_FRAMERATE_6000);
+	ntv2_vdev->dma_fail_interval = params->dma_fail_interval;
+
+	pAutoCirc->pSysCon = &ntv2_vdev->system_context;
+	pAutoCirc->deviceID = ntv2_vdev->device_id;
+	for (i = 0; i < NTV2_MAX_NUM_CHANNELS; i++)
+		pAutoCirc->ancInputChannel[i] = NTV2_CHANNEL_INVALID;
+	for (i = 0; i < NUM_CIRCULATORS; i++)
+	{
+		if (!ILLEGAL_CHANNELSPEC((NTV2Crosspoint)i))
+			AutoCircReset(pAutoCirc, (NTV2Crosspoint)i);
+	}
+
+	// outputs first then inputs, each with its own frame range
+	for (i = 0; i < (params->outputs + params->inputs); i++)
+	{
+		struct sim_circulator *circ = &result->circulators[i];
+		int32_t startFrame = (int32_t)(i * params->frames);
+		Ntv2Status acStatus;
+
+		if (i < params->outputs)
+		{
+			circ->crosspoint = output_crosspoint(i);
+			snprintf(circ->name, sizeof(circ->name), "out%u", i + 1);
+		}
+		else
+		{
+			circ->crosspoint = input_crosspoint(i - params->outputs);
+			snprintf(circ->name, sizeof(circ->name), "in%u", i - params->outputs + 1);
+		}
+		acStatus = AutoCircInit(pAutoCirc, circ->crosspoint, startFrame, startFrame + (int32_t)params->frames - 1,
+								NTV2_AUDIOSYSTEM_INVALID, 1,
+								false, false, false, false, false, false, false, false, false, false);
+		if (acStatus != NTV2_STATUS_SUCCESS)
+		{
+			printf("error: init %s failed %d\n", circ->name, acStatus);
+			goto done;
+		}
+		result->num_circulators++;
+
+		// preroll playback
+		if (NTV2_IS_OUTPUT_CROSSPOINT(circ->crosspoint))
+			service_circulator(pAutoCirc, circ, params->frames, pBuffer, bufferSize, &result->transfer);
+
+		if (AutoCircStart(pAutoCirc, circ->crosspoint, 0) != NTV2_STATUS_SUCCESS)
+		{
+			printf("error: start %s failed\n", circ->name);
+			goto done;
+		}
+	}
+
+	start = sim_nanoseconds();
+	for (vbi = 0; vbi < params->vbis; vbi++)
+	{
+		bool stalled = (params->stall_interval != 0) && (params->stall_length != 0) &&
+			((vbi % params->stall_interval) >= (params->stall_interval - params->stall_length));
+
+		ntv2_virtual_device_vbi(ntv2_vdev);
+
+		// interrupt service
+		for (i = 0; i < result->num_circulators; i++)
+		{
+			uint64_t isrStart = sim_nanoseconds();
+			AutoCirculate(pAutoCirc, result->circulators[i].crosspoint, (int32_t)ntv2Time100ns());
+			histogram_add(&result->isr, sim_nanoseconds() - isrStart);
+		}
+
+		// clients
+		for (i = 0; i < result->num_circulators; i++)
+		{
+			if (stalled ||
+				((params->late_percent != 0) && ((sim_random() % 100) < params->late_percent)))
+			{
+				result->late_services++;
+				continue;
+			}
+			service_circulator(pAutoCirc, &result->circulators[i], params->frames,
+							   pBuffer, bufferSize, &result->transfer);
+		}
+	}
+	result->seconds = (double)(sim_nanoseconds() - start) / 1000000000.0;
+
+	for (i = 0; i < result->num_circulators; i++)
+	{
+		struct sim_circulator *circ = &result->circulators[i];
+		if (get_status(pAutoCirc, circ->crosspoint, &status))
+		{
+			circ->processed = status.acFramesProcessed;
+			circ->dropped = status.acFramesDropped;
+		}
+		AutoCircStop(pAutoCirc, circ->crosspoint);
+	}
+
+	// stop completes on the following vertical blanks
+	for (vbi = 0; vbi < 4; vbi++)
+	{
+		ntv2_virtual_device_vbi(ntv2_vdev);
+		for (i = 0; i < result->num_circulators; i++)
+			AutoCirculate(pAutoCirc, result->circulators[i].crosspoint, (int32_t)ntv2Time100ns());
+	}
+
+	result->stopped = true;
+	for (i = 0; i < result->num_circulators; i++)
+	{
+		if (get_status(pAutoCirc, result->circulators[i].crosspoint, &status) &&
+			(status.acState != NTV2_AUTOCIRCULATE_DISABLED))
+			result->stopped = false;
+	}
+
+	success = true;
+
+done:
+	free(pBuffer);
+	free(pAutoCirc);
+	ntv2_virtual_device_close(ntv2_vdev);
+	return success;
+}
+
+static void print_result(const struct sim_params *params, struct sim_result *result)
+{
+	uint64_t processed = 0;
+	uint64_t dropped = 0;
+	uint64_t transfers = 0;
+	uint32_t i;
+
+	for (i = 0; i < result->num_circulators; i++)
+	{
+		processed += result->circulators[i].processed;
+		dropped += result->circulators[i].dropped;
+		transfers += result->circulators[i].transfers;
+	}
+
+	printf("%s: %u out %u in, %u frames, %llu vbis%s, late %u%%, stall %u/%u\n",
+		   params->name, params->outputs, params->inputs, params->frames,
+		   (unsigned long long)params->vbis, params->interlaced ? " (fields)" : "",
+		   params->late_percent, params->stall_length, params->stall_interval);
+	histogram_print("isr", &result->isr);
+	histogram_print("transfer", &result->transfer);
+	printf("  processed %llu  dropped %llu  transfers %llu  late services %llu  %.2f s\n",
+		   (unsigned long long)processed, (unsigned long long)dropped,
+		   (unsigned long long)transfers, (unsigned long long)result->late_services, result->seconds);
+
+	for (i = 0; i < result->num_circulators; i++)
+	{
+		struct sim_circulator *circ = &result->circulators[i];
+		if (circ->dropped != 0)
+			printf("    %-8s processed %u  %s %u\n", circ->name, circ->processed,
+				   NTV2_IS_INPUT_CROSSPOINT(circ->crosspoint) ? "dropped" : "repeated", circ->dropped);
+	}
+}
+
+static bool check_result(const struct sim_params *params, const struct sim_expect *expect,
+						 struct sim_result *result)
+{
+	bool pass = result->stopped;
+	uint32_t i;
+
+	if (!result->stopped)
+		printf("  FAIL: channels did not stop\n");
+
+	for (i = 0; i < result->num_circulators; i++)
+	{
+		struct sim_circulator *circ = &result->circulators[i];
+
+		if (circ->processed == 0)
+		{
+			printf("  FAIL: %s processed no frames\n", circ->name);
+			pass = false;
+		}
+		if (expect->no_drops && (circ->dropped != 0))
+		{
+			printf("  FAIL: %s dropped %u frames\n", circ->name, circ->dropped);
+			pass = false;
+		}
+		if (expect->drops && (circ->dropped == 0))
+		{
+			printf("  FAIL: %s dropped no frames\n", circ->name);
+			pass = false;
+		}
+	}
+
+	return pass;
+}
+
+static void usage(void)
+{
+	printf("usage: ntv2acsim [options]\n"
+		   "  -o <n>   playback channels (0-8)\n"
+		   "  -i <n>   capture channels (0-8)\n"
+		   "  -f <n>   frames per channel\n"
+		   "  -n <n>   vertical blanks\n"
+		   "  -l <n>   percent chance a client is late for a vertical blank\n"
+		   "  -s <n>   stall all clients every n vertical blanks\n"
+		   "  -t <n>   stall length in vertical blanks\n"
+		   "  -d <n>   fail every nth dma transfer\n"
+		   "  -I       interlaced (field interrupts)\n"
+		   "  -r <n>   random seed\n"
+		   "  -v       show driver messages\n"
+		   "with no scenario options the test suite is run\n");
+}
+
+int main(int argc, char* argv[])
+{
+	struct sim_params params;
+	struct sim_result *result;
+	bool custom = false;
+	bool pass = true;
+	int i;
+
+	memset(&params, 0, sizeof(params));
+	params.name = "custom";
+	params.outputs = SIM_MAX_CHANNELS;
+	params.inputs = SIM_MAX_CHANNELS;
+	params.frames = 7;
+	params.vbis = 1000000;
+	params.seed = 1;
+
+	for (i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		uint64_t value = ((i + 1) < argc) ? strtoull(argv[i + 1], NULL, 0) : 0;
+
+		if (strcmp(arg, "-I") == 0)			{ params.interlaced = true; custom = true; continue; }
+		if (strcmp(arg, "-v") == 0)			{ ntv2_virtual_set_verbose(true); continue; }
+		if ((i + 1) >= argc)				{ usage(); return 1; }
+
+		if (strcmp(arg, "-o") == 0)			params.outputs = (uint32_t)value;
+		else if (strcmp(arg, "-i") == 0)	params.inputs = (uint32_t)value;
+		else if (strcmp(arg, "-f") == 0)	params.frames = (uint32_t)value;
+		else if (strcmp(arg, "-n") == 0)	params.vbis = value;
+		else if (strcmp(arg, "-l") == 0)	params.late_percent = (uint32_t)value;
+		else if (strcmp(arg, "-s") == 0)	params.stall_interval = (uint32_t)value;
+		else if (strcmp(arg, "-t") == 0)	params.stall_length = (uint32_t)value;
+		else if (strcmp(arg, "-d") == 0)	params.dma_fail_interval = (uint32_t)value;
+		else if (strcmp(arg, "-r") == 0)	params.seed = (uint32_t)value;
+		else								{ usage(); return 1; }
+		custom = true;
+		i++;
+	}
+
+	result = (struct sim_result*)calloc(1, sizeof(struct sim_result));
+	if (result == NULL)
+		return 1;
+
+	if (custom)
+	{
+		struct sim_expect expect = { false, false };
+		pass = run_scenario(&params, result);
+		if (pass)
+		{
+			print_result(&params, result);
+			pass = check_result(&params, &expect, result);
+		}
+	}
+	else
+	{
+		static const struct {
+			struct sim_params	params;
+			struct sim_expect	expect;
+		} suite[] = {
+			//  name           out in  frames  vbis     late stall len  dma  fields seed     no drops drops
+			{{ "playback",     8,  0,  7,      100000,  0,   0,    0,   0,   false, 1 }, { true,  false }},
+			{{ "capture",      0,  8,  7,      100000,  0,   0,    0,   0,   false, 1 }, { true,  false }},
+			{{ "fields",       8,  8,  7,      100000,  0,   0,    0,   0,   true,  1 }, { true,  false }},
+			{{ "jitter",       8,  8,  7,      100000,  2,   0,    0,   0,   false, 1 }, { true,  false }},
+			{{ "stall",        8,  8,  7,      100000,  0,   1000, 10,  0,   false, 1 }, { false, true  }},
+			{{ "dma errors",   8,  8,  7,      100000,  0,   0,    0,   97,  false, 1 }, { false, false }},
+			{{ "benchmark",    8,  8,  7,      1000000, 1,   0,    0,   0,   false, 1 }, { false, false }},
+		};
+		uint32_t s;
+
+		for (s = 0; s < sizeof(suite) / sizeof(suite[0]); s++)
+		{
+			bool ok = run_scenario(&suite[s].params, result);
+			if (ok)
+			{
+				print_result(&suite[s].params, result);
+				ok = check_result(&suite[s].params, &suite[s].expect, result);
+			}
+			printf("  %s\n\n", ok ? "pass" : "FAIL");
+			pass = pass && ok;
+		}
+	}
+
+	free(result);
+	return pass ? 0 : 1;
+}
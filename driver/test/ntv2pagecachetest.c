@@ -0,0 +1,216 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright (C) 2004 - 2022 AJA Video Systems, Inc.
+ */
+//========================================================================
+//
+//  ntv2pagecachetest.c
+//
+//	Page cache test.  Runs the common driver locked buffer cache in user
+//	space: lookup, lru order, match callbacks, removal from crowded hash
+//	buckets and the statistics the driver publishes, then times lookups
+//	as the cache grows.  The exit status reports any failed check.
+//
+//==========================================================================
+
+#include "ntv2system.h"
+#include "ntv2pagecache.h"
+#include <time.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define TEST_MAX_NODES		4096
+#define TEST_PAGE_SIZE		4096
+#define TEST_LOOKUPS		1000000
+
+struct test_buffer {
+	struct ntv2_page_cache_node		node;
+	uint32_t						refs;
+};
+
+static struct test_buffer test_buffers[TEST_MAX_NODES];
+static uint32_t test_failures;
+
+#define TEST_CHECK(cond) \
+	do { if (!(cond)) { printf("  FAIL: %s:%d  %s\n", __func__, __LINE__, #cond); test_failures++; } } while (0)
+
+static uint64_t test_address(uint32_t index)
+{
+	// page aligned user addresses, spread like a real process heap
+	return 0x7f0000000000ULL + ((uint64_t)index * 3 * TEST_PAGE_SIZE);
+}
+
+static void test_insert(struct ntv2_page_cache *cache, uint32_t count)
+{
+	uint32_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		test_buffers[i].refs = 0;
+		ntv2_page_cache_insert(cache, &test_buffers[i].node, test_address(i),
+							   TEST_PAGE_SIZE, TEST_PAGE_SIZE, &test_buffers[i]);
+	}
+}
+
+static bool test_match_idle(struct ntv2_page_cache_node *node, void *context)
+{
+	return ((struct test_buffer*)node->owner)->refs == 0;
+}
+
+static bool test_match_size(struct ntv2_page_cache_node *node, void *context)
+{
+	return *(uint32_t*)context <= node->size;
+}
+
+static uint64_t test_nanoseconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void test_find(void)
+{
+	struct ntv2_page_cache cache;
+	struct ntv2_page_cache_node *node;
+	uint32_t size;
+
+	ntv2_page_cache_init(&cache);
+	TEST_CHECK(ntv2_page_cache_first(&cache) == NULL);
+	TEST_CHECK(ntv2_page_cache_find(&cache, test_address(0), NULL, NULL, true) == NULL);
+	TEST_CHECK(cache.stats.misses == 1);
+
+	test_insert(&cache, 16);
+	TEST_CHECK(cache.stats.buffers == 16);
+	TEST_CHECK(cache.stats.bytes == 16 * TEST_PAGE_SIZE);
+
+	node = ntv2_page_cache_find(&cache, test_address(5), NULL, NULL, true);
+	TEST_CHECK(node == &test_buffers[5].node);
+	TEST_CHECK(node->owner == &test_buffers[5]);
+	TEST_CHECK(cache.stats.hits == 1);
+
+	// an address inside a buffer is not its key
+	TEST_CHECK(ntv2_page_cache_find(&cache, test_address(5) + 8, NULL, NULL, true) == NULL);
+	TEST_CHECK(cache.stats.misses == 2);
+
+	// the match callback can reject the node
+	size = 2 * TEST_PAGE_SIZE;
+	TEST_CHECK(ntv2_page_cache_find(&cache, test_address(6), test_match_size, &size, true) == NULL);
+	size = TEST_PAGE_SIZE;
+	TEST_CHECK(ntv2_page_cache_find(&cache, test_address(6), test_match_size, &size, true) == &test_buffers[6].node);
+
+	// uncounted lookups leave the statistics alone
+	ntv2_page_cache_find(&cache, test_address(7), NULL, NULL, false);
+	ntv2_page_cache_find(&cache, test_address(99), NULL, NULL, false);
+	TEST_CHECK(cache.stats.hits == 2);
+	TEST_CHECK(cache.stats.misses == 3);
+}
+
+static void test_lru(void)
+{
+	struct ntv2_page_cache cache;
+
+	ntv2_page_cache_init(&cache);
+	test_insert(&cache, 4);
+
+	// insertion order until a lookup makes a buffer most recently used
+	TEST_CHECK(ntv2_page_cache_oldest(&cache, NULL, NULL) == &test_buffers[0].node);
+	ntv2_page_cache_find(&cache, test_address(0), NULL, NULL, true);
+	TEST_CHECK(ntv2_page_cache_oldest(&cache, NULL, NULL) == &test_buffers[1].node);
+	TEST_CHECK(ntv2_page_cache_first(&cache) == &test_buffers[1].node);
+
+	// busy buffers are skipped
+	test_buffers[1].refs = 1;
+	test_buffers[2].refs = 1;
+	TEST_CHECK(ntv2_page_cache_oldest(&cache, test_match_idle, NULL) == &test_buffers[3].node);
+	test_buffers[3].refs = 1;
+	TEST_CHECK(ntv2_page_cache_oldest(&cache, test_match_idle, NULL) == &test_buffers[0].node);
+	test_buffers[0].refs = 1;
+	TEST_CHECK(ntv2_page_cache_oldest(&cache, test_match_idle, NULL) == NULL);
+
+	// evict in lru order
+	test_buffers[0].refs = test_buffers[1].refs = test_buffers[2].refs = test_buffers[3].refs = 0;
+	ntv2_page_cache_evict(&cache, ntv2_page_cache_oldest(&cache, test_match_idle, NULL));
+	TEST_CHECK(cache.stats.evictions == 1);
+	TEST_CHECK(cache.stats.buffers == 3);
+	TEST_CHECK(cache.stats.bytes == 3 * TEST_PAGE_SIZE);
+	TEST_CHECK(ntv2_page_cache_find(&cache, test_address(1), NULL, NULL, false) == NULL);
+	TEST_CHECK(ntv2_page_cache_oldest(&cache, NULL, NULL) == &test_buffers[2].node);
+}
+
+static void test_remove(void)
+{
+	struct ntv2_page_cache cache;
+	uint32_t count = NTV2_PAGE_CACHE_HASH_SIZE * 4;
+	uint32_t i;
+
+	// more buffers than buckets, so buckets hold chains
+	ntv2_page_cache_init(&cache);
+	test_insert(&cache, count);
+	TEST_CHECK(cache.stats.buffers == count);
+
+	// remove every other buffer, from the middle, head and tail of chains
+	for (i = 0; i < count; i += 2)
+		ntv2_page_cache_remove(&cache, &test_buffers[i].node);
+	TEST_CHECK(cache.stats.buffers == count / 2);
+	TEST_CHECK(cache.stats.bytes == (uint64_t)(count / 2) * TEST_PAGE_SIZE);
+	TEST_CHECK(cache.stats.evictions == 0);
+
+	for (i = 0; i < count; i++)
+	{
+		struct ntv2_page_cache_node *node = ntv2_page_cache_find(&cache, test_address(i), NULL, NULL, true);
+		if ((i & 1) == 0)
+			TEST_CHECK(node == NULL);
+		else
+			TEST_CHECK(node == &test_buffers[i].node);
+	}
+	TEST_CHECK(cache.stats.hits == count / 2);
+	TEST_CHECK(cache.stats.misses == count / 2);
+
+	// removing a buffer that is not in the cache changes nothing
+	ntv2_page_cache_remove(&cache, &test_buffers[0].node);
+	TEST_CHECK(cache.stats.buffers == count / 2);
+
+	// drain through the lru list
+	while (ntv2_page_cache_first(&cache) != NULL)
+		ntv2_page_cache_remove(&cache, ntv2_page_cache_first(&cache));
+	TEST_CHECK(cache.stats.buffers == 0);
+	TEST_CHECK(cache.stats.bytes == 0);
+	for (i = 0; i < NTV2_PAGE_CACHE_HASH_SIZE; i++)
+		TEST_CHECK(cache.hash_table[i] == NULL);
+}
+
+static void test_timing(void)
+{
+	static struct ntv2_page_cache cache;
+	uint32_t count;
+
+	printf("  buffers   ns/lookup\n");
+	for (count = 16; count <= TEST_MAX_NODES; count *= 4)
+	{
+		uint64_t start;
+		uint64_t elapsed;
+		uint32_t i;
+
+		ntv2_page_cache_init(&cache);
+		test_insert(&cache, count);
+		start = test_nanoseconds();
+		for (i = 0; i < TEST_LOOKUPS; i++)
+			ntv2_page_cache_find(&cache, test_address((i * 7919) % count), NULL, NULL, true);
+		elapsed = test_nanoseconds() - start;
+		TEST_CHECK(cache.stats.hits == TEST_LOOKUPS);
+		printf("  %7d   %9.1f\n", count, (double)elapsed / TEST_LOOKUPS);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	test_find();
+	test_lru();
+	test_remove();
+	test_timing();
+
+	printf("%s\n", (test_failures == 0) ? "pass" : "FAIL");
+	return (test_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright (C) 2004 - 2022 AJA Video Systems, Inc.
+ */
+//========================================================================
+//
+//  ntv2virtualdevice.c
+//
+//==========================================================================
+
+#include "ntv2virtualdevice.h"
+#include "ntv2autofunc.h"
+#include "ntv2video.h"
+#include <stdarg.h>
+
+// field id status bits for output and input channels 1-8 (see IsFieldID0)
+#define NTV2_VIRTUAL_FIELD_BITS		(BIT_23 | BIT_21 | BIT_19 | BIT_5 | BIT_3 | BIT_1)
+#define NTV2_VIRTUAL_FIELD_BITS2	(BIT_21 | BIT_19 | BIT_17 | BIT_15 | BIT_13 | BIT_11 | \
+									 BIT_9 | BIT_7 | BIT_5 | BIT_3)
+
+static int64_t s_virtual_time = 0;
+static bool s_virtual_verbose = false;
+
+static struct ntv2_virtual_device* get_device(Ntv2SystemContext* context)
+{
+	if (context == NULL)
+		return NULL;
+	return (struct ntv2_virtual_device*)context->pDevice;
+}
+
+struct ntv2_virtual_device* ntv2_virtual_device_open(NTV2DeviceID device_id)
+{
+	struct ntv2_virtual_device *ntv2_vdev;
+
+	ntv2_vdev = (struct ntv2_virtual_device*)calloc(1, sizeof(struct ntv2_virtual_device));
+	if (ntv2_vdev == NULL)
+		return NULL;
+
+	ntv2_vdev->registers = (uint32_t*)calloc(NTV2_VIRTUAL_NUM_REGISTERS, sizeof(uint32_t));
+	if (ntv2_vdev->registers == NULL)
+	{
+		free(ntv2_vdev);
+		return NULL;
+	}
+
+	ntv2_vdev->system_context.pDevice = ntv2_vdev;
+	ntv2_vdev->device_id = device_id;
+	ntv2_vdev->registers[kRegBoardID] = (uint32_t)device_id;
+	ntv2_virtual_device_set_standard(ntv2_vdev, NTV2_STANDARD_1080p, NTV2_FRAMERATE_6000);
+
+	return ntv2_vdev;
+}
+
+void ntv2_virtual_device_close(struct ntv2_virtual_device *ntv2_vdev)
+{
+	if (ntv2_vdev == NULL)
+		return;
+
+	free(ntv2_vdev->registers);
+	free(ntv2_vdev);
+}
+
+void ntv2_virtual_device_set_standard(struct ntv2_virtual_device *ntv2_vdev,
+									  NTV2Standard standard, NTV2FrameRate rate)
+{
+	Ntv2SystemContext* context;
+
+	if (ntv2_vdev == NULL)
+		return;
+
+	context = &ntv2_vdev->system_context;
+	ntv2WriteRegisterMS(context, kRegGlobalControl, (uint32_t)standard, kRegMaskStandard, kRegShiftStandard);
+	ntv2WriteRegisterMS(context, kRegGlobalControl, (uint32_t)rate & 0x7, kRegMaskFrameRate, kRegShiftFrameRate);
+	ntv2WriteRegisterMS(context, kRegGlobalControl, ((uint32_t)rate >> 3) & 0x1, kRegMaskFrameRateHiBit, kRegShiftFrameRateHiBit);
+
+	// vertical blanks come at the field rate for interlaced standards
+	ntv2_vdev->interlaced = !NTV2_IS_PROGRESSIVE_STANDARD(standard);
+	ntv2_vdev->frame_time = GetFramePeriod(context, NTV2_CHANNEL1) / 10;
+	if (ntv2_vdev->interlaced)
+		ntv2_vdev->frame_time /= 2;
+}
+
+void ntv2_virtual_device_vbi(struct ntv2_virtual_device *ntv2_vdev)
+{
+	uint32_t* registers;
+
+	if (ntv2_vdev == NULL)
+		return;
+
+	s_virtual_time += ntv2_vdev->frame_time;
+
+	// field 0 on even vertical blanks
+	registers = ntv2_vdev->registers;
+	if (ntv2_vdev->interlaced && ((ntv2_vdev->vbi_count & 0x1) != 0))
+	{
+		registers[kRegStatus] |= NTV2_VIRTUAL_FIELD_BITS;
+		registers[kRegStatus2] |= NTV2_VIRTUAL_FIELD_BITS2;
+	}
+	else
+	{
+		registers[kRegStatus] &= ~NTV2_VIRTUAL_FIELD_BITS;
+		registers[kRegStatus2] &= ~NTV2_VIRTUAL_FIELD_BITS2;
+	}
+
+	ntv2_vdev->vbi_count++;
+}
+
+int64_t ntv2_virtual_time(void)
+{
+	return s_virtual_time;
+}
+
+void ntv2_virtual_set_time(int64_t time)
+{
+	s_virtual_time = time;
+}
+
+void ntv2_virtual_set_verbose(bool verbose)
+{
+	s_virtual_verbose = verbose;
+}
+
+// system abstraction hooks
+
+uint32_t ntv2ReadRegCon32(Ntv2SystemContext* context, uint32_t regNum)
+{
+	struct ntv2_virtual_device *ntv2_vdev = get_device(context);
+
+	if ((ntv2_vdev == NULL) || (regNum >= NTV2_VIRTUAL_NUM_REGISTERS))
+		return 0;
+	return ntv2_vdev->registers[regNum];
+}
+
+bool ntv2ReadRegMSCon32(Ntv2SystemContext* context, uint32_t regNum, uint32_t* regValue, uint32_t regMask, uint32_t regShift)
+{
+	struct ntv2_virtual_device *ntv2_vdev = get_device(context);
+
+	if ((ntv2_vdev == NULL) || (regValue == NULL) || (regNum >= NTV2_VIRTUAL_NUM_REGISTERS))
+		return false;
+	*regValue = (ntv2_vdev->registers[regNum] & regMask) >> regShift;
+	return true;
+}
+
+bool ntv2WriteRegCon32(Ntv2SystemContext* context, uint32_t regNum, uint32_t regValue)
+{
+	struct ntv2_virtual_device *ntv2_vdev = get_device(context);
+
+	if ((ntv2_vdev == NULL) || (regNum >= NTV2_VIRTUAL_NUM_REGISTERS))
+		return false;
+	ntv2_vdev->registers[regNum] = regValue;
+	return true;
+}
+
+bool ntv2WriteRegMSCon32(Ntv2SystemContext* context, uint32_t regNum, uint32_t regValue, uint32_t regMask, uint32_t regShift)
+{
+	struct ntv2_virtual_device *ntv2_vdev = get_device(context);
+	uint32_t value;
+
+	if ((ntv2_vdev == NULL) || (regNum >= NTV2_VIRTUAL_NUM_REGISTERS))
+		return false;
+	value = ntv2_vdev->registers[regNum] & ~regMask;
+	ntv2_vdev->registers[regNum] = value | ((regValue << regShift) & regMask);
+	return true;
+}
+
+bool ntv2WriteXlnxRegCon32(Ntv2SystemContext* context, uint32_t regNum, uint32_t regValue)
+{
+	return ntv2WriteRegCon32(context, regNum, regValue);
+}
+
+uint32_t ntv2ReadVirtRegCon32(Ntv2SystemContext* context, uint32_t regNum)
+{
+	return ntv2ReadRegCon32(context, regNum);
+}
+
+bool ntv2WriteVirtRegCon32(Ntv2SystemContext* context, uint32_t regNum, uint32_t data)
+{
+	return ntv2WriteRegCon32(context, regNum, data);
+}
+
+int64_t ntv2TimeCounterCon(void)
+{
+	return s_virtual_time;
+}
+
+void ntv2MessageCon(const char* pFormat, ...)
+{
+	va_list args;
+
+	if (!s_virtual_verbose)
+		return;
+
+	va_start(args, pFormat);
+	vprintf(pFormat, args);
+	va_end(args);
+	fflush(stdout);
+}
+
+// autocirculate hooks
+
+Ntv2Status ntv2DMATransferCon(Ntv2SystemContext* pSysCon, PAUTO_DMA_PARAMS pDmaParams)
+{
+	struct ntv2_virtual_device *ntv2_vdev = get_device(pSysCon);
+	struct ntv2_virtual_dma_stats *stats;
+
+	if ((ntv2_vdev == NULL) || (pDmaParams == NULL))
+		return NTV2_STATUS_BAD_PARAMETER;
+
+	stats = &ntv2_vdev->dma_stats;
+	stats->transfers++;
+	if ((ntv2_vdev->dma_fail_interval != 0) &&
+		((stats->transfers % ntv2_vdev->dma_fail_interval) == 0))
+	{
+		stats->failures++;
+		return NTV2_STATUS_IO_ERROR;
+	}
+
+	if (pDmaParams->toHost)
+		stats->to_host++;
+	else
+		stats->from_host++;
+	stats->bytes += (uint64_t)pDmaParams->vidNumBytes + pDmaParams->audNumBytes +
+		pDmaParams->ancF1NumBytes + pDmaParams->ancF2NumBytes;
+
+	return NTV2_STATUS_SUCCESS;
+}
+
+int64_t ntv2AudioClockCon(Ntv2SystemContext* pSysCon)
+{
+	// 48 khz sample clock
+	return (s_virtual_time * 48000) / 1000000;
+}
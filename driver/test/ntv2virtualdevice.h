@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright (C) 2004 - 2022 AJA Video Systems, Inc.
+ */
+//========================================================================
+//
+//  ntv2virtualdevice.h
+//
+//	Simulated device for running the common driver code in user space
+//	(AJAVirtual).  Provides the register file, clock, audio clock and dma
+//	hooks that ntv2system.c and ntv2autocirc.c expect from a real device.
+//
+//==========================================================================
+
+#ifndef NTV2VIRTUALDEVICE_H
+#define NTV2VIRTUALDEVICE_H
+
+#include "ntv2system.h"
+#include "ntv2publicinterface.h"
+
+#define NTV2_VIRTUAL_NUM_REGISTERS		(1 << 18)
+
+struct ntv2_virtual_dma_stats {
+	uint64_t			transfers;			// dma transfers requested
+	uint64_t			to_host;			// transfers from the device
+	uint64_t			from_host;			// transfers to the device
+	uint64_t			bytes;				// video + audio + anc bytes
+	uint64_t			failures;			// transfers failed by the simulation
+};
+
+struct ntv2_virtual_device {
+	Ntv2SystemContext				system_context;			// passed to the common driver code
+	NTV2DeviceID					device_id;
+	uint32_t*						registers;				// register file (real and virtual)
+	int64_t							frame_time;				// vertical blank period (microseconds)
+	uint64_t						vbi_count;				// vertical blanks since reset
+	bool							interlaced;				// toggle field id each vertical blank
+	uint32_t						dma_fail_interval;		// fail every nth transfer (0 = never)
+	struct ntv2_virtual_dma_stats	dma_stats;
+};
+
+struct ntv2_virtual_device* ntv2_virtual_device_open(NTV2DeviceID device_id);
+void ntv2_virtual_device_close(struct ntv2_virtual_device *ntv2_vdev);
+
+void ntv2_virtual_device_set_standard(struct ntv2_virtual_device *ntv2_vdev,
+									  NTV2Standard standard, NTV2FrameRate rate);
+
+// advance the clock one vertical blank and latch the hardware state
+void ntv2_virtual_device_vbi(struct ntv2_virtual_device *ntv2_vdev);
+
+// simulation clock (microseconds) shared by all virtual devices
+int64_t ntv2_virtual_time(void);
+void ntv2_virtual_set_time(int64_t time);
+
+// enable ntv2Message output from the common driver code
+void ntv2_virtual_set_verbose(bool verbose);
+
+#endif
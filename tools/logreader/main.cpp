@@ -450,7 +450,6 @@ class DebugInfoSettings
 
 int main(int argc, const char *argv[])
 {
-	int				samplesPerSec	(100);		//	Message log rate, messages per second (defaults to once per second)
 	int				pidFilter		(0);		//	Filter: process ID (defaults to 0 == don't filter by pid)
 	int				tidFilter		(0);		//	Filter: thread ID (defaults to 0 == don't filter by tid)
 	int				showVersion		(0);		//	Show version?
@@ -488,7 +487,6 @@ int main(int argc, const char *argv[])
 		{"tid",			0,		POPT_ARG_INT,		&tidFilter,			0,		"thread ID filter",				"thread ID"},
 		{"enable",		0,		POPT_ARG_NONE,		&enableDebugUnits,	0,		"enable debug units",			""},
 		{"format",		'f',	POPT_ARG_STRING,	&pFormatStr,		0,		"custom formatting",			"%I|%P|%T|%t|%D|%S|%F|%L|%M|%%"},
-//		{"rate",		'r',	POPT_ARG_INT,		&samplesPerSec,		0,		"polling rate",					"samples per second"					},
 		{"verbose",		'v',	POPT_ARG_NONE,		&gIsVerbose,		0,		"verbose output",				""},
 		{"version",		0,		POPT_ARG_NONE,		&showVersion,		0,		"show version & exit",			""},
 		{"stats",		0,		POPT_ARG_NONE,		&listStats,			0,		"list active stats",			""},
@@ -576,8 +574,6 @@ int main(int argc, const char *argv[])
 			cerr << "## NOTE: Filtering: Showing messages only from process " << DEC(filterPID) << endl;
 		if (filterTID)
 			cerr << "## NOTE: Filtering: Showing messages only from thread " << DEC(filterTID) << endl;
-		if (samplesPerSec)
-			cerr << "## NOTE: Will poll for messages " << DEC(samplesPerSec) << " times per second" << endl;
 		if (sevThreshold == AJA_DebugSeverity_Size)
 			cerr << "## NOTE: All messages will be written to stdout" << endl;
 		else
@@ -606,93 +602,71 @@ int main(int argc, const char *argv[])
         ::signal (SIGHUP, SignalHandler);
         ::signal (SIGQUIT, SignalHandler);
     #endif
+	//	Push the filters down into AJADebug, so filtered messages are never copied out of the ring...
+	AJADebugMessageFilter filter;
+	for (AJADebugUnit du(AJA_DebugUnit_Unknown);  du < AJA_DebugUnit_Size;  du = AJADebugUnit(du+1))
+		filter.SetUnit(int32_t(du), dbgInfo.HasDebugUnit(du));
+	for (AJADebugSeverity sev(AJA_DebugSeverity_Emergency);  sev < AJA_DebugSeverity_Size;  sev = AJADebugSeverity(sev+1))
+		filter.SetSeverity(int32_t(sev), dbgInfo.HasSeverity(sev));
+	filter.SetProcessId(filterPID);
+	filter.SetThreadId(filterTID);
+
 	AJATimeBase	mTimeBase;
-	double		mLastTime(-1.0);
 	int64_t		mFirstTime(0);
-	uint64_t	mLastIndex(0);
 	uint64_t	mReadIndex(0);
-	AJADebug::GetSequenceNumber(&mReadIndex);
+	vector<AJADebugMessage>	messages;
+	AJADebug::GetSequenceNumber(mReadIndex);
 	if (mReadIndex < 1)
 		mReadIndex = 1;
 	mTimeBase.SetTickRate(AJA_DEBUG_TICK_RATE);
 	do
 	{
-		uint64_t newIndex(0);
-	    uint64_t messageIndex(0);
-		while (AJA_SUCCESS(AJADebug::GetSequenceNumber(&newIndex))
-			 &&  newIndex > mLastIndex
-			 &&  AJA_SUCCESS(AJADebug::GetMessageSequenceNumber(mReadIndex, &messageIndex))
-			 &&  messageIndex > mLastIndex)
+		uint64_t lostCount(0);
+		if (AJA_FAILURE(AJADebug::GetMessages(mReadIndex, messages, AJADebug::MessageRingCapacity(), filter, lostCount)))
+			break;
+		if (lostCount)
+			cerr << "## WARNING: " << DEC(lostCount) << " message(s) lost -- overwritten before they could be read" << endl;
+		for (size_t ndx(0);  ndx < messages.size();  ndx++)
 		{
-	        uint32_t destination;
-	        mLastIndex = messageIndex;
-			if (AJA_SUCCESS(AJADebug::GetMessageDestination(mReadIndex, &destination))  &&  (destination != AJA_DEBUG_DESTINATION_NONE))
-			{
-		        int32_t groupIndex(0);
-				uint64_t time(0);
-		        int32_t severity(0);
-				const char* pMessage(AJA_NULL);
-				if (AJA_SUCCESS(AJADebug::GetMessageGroup(mReadIndex, &groupIndex))
-					&&  AJA_SUCCESS(AJADebug::GetMessageTime(mReadIndex, &time))
-					&&  AJA_SUCCESS(AJADebug::GetMessageSeverity(mReadIndex, &severity))
-					&&  AJA_SUCCESS(AJADebug::GetMessageText(mReadIndex, &pMessage)))
-				{
-					uint64_t pid(0);
-					uint64_t tid(0);
-					const string	msg(pMessage?pMessage:"");
-					if (!mFirstTime)
-						mFirstTime = int64_t(time);
-					const double currentTime (double(mTimeBase.MicrosecondsToSeconds(int64_t(time) - mFirstTime)));
-					if (mLastTime < 0)
-						mLastTime = currentTime;
-					AJADebug::GetProcessId(mReadIndex, &pid);
-					AJADebug::GetThreadId(mReadIndex,  &tid);
-					if ((!filterPID || (pid == filterPID))
-						&&  (!filterTID || (tid == filterTID))
-						&&  dbgInfo.HasSeverity(AJADebugSeverity(severity))
-						&&  dbgInfo.HasDebugUnit(AJADebugUnit(groupIndex)))
-					{
-						const string & severityStr (dbgInfo.SeverityToString(AJADebugSeverity(severity)));
-						int32_t lineNum(0);
-						AJADebug::GetMessageLineNumber(mReadIndex, &lineNum);
-						const char *	pFileName(AJA_NULL);
-						AJADebug::GetMessageFileName(mReadIndex, &pFileName);
-						const string	path(pFileName ? pFileName : "");
-						ostream &	outputStream (severity < sevThreshold ? cerr : cout);
-						if (formatStr.empty())
-							outputStream	<< DEC(messageIndex)
-											<< DLIM << DEC(pid)
-											<< DLIM << DEC(tid)
-											<< DLIM << currentTime
-											<< DLIM << dbgInfo.DebugUnitToString(AJADebugUnit(groupIndex))
-											<< DLIM << severityStr
-											<< DLIM << path
-											<< DLIM << DEC(lineNum)
-											<< DLIM << msg
-											<< endl;
-						else
-						{	//	Custom formatting:
-							string	outputString (formatStr);
-							aja::replace(outputString, kEscIndexNumber, NumToString(messageIndex));
-							aja::replace(outputString, kEscProcessID, NumToString(pid));
-							aja::replace(outputString, kEscThreadID, NumToString(tid));
-							aja::replace(outputString, kEscTimestamp, NumToString(currentTime));
-							aja::replace(outputString, kEscDebugUnit, dbgInfo.DebugUnitToString(AJADebugUnit(groupIndex)));
-							aja::replace(outputString, kEscSeverity, severityStr);
-							aja::replace(outputString, kEscLineNumber, NumToString(lineNum));
-							aja::replace(outputString, kEscMessage, msg);
-							aja::replace(outputString, kEscPercent, "%");
-							FormatPaths(outputString, path);
-							outputStream	<< outputString;	//	User responsible for linebreaks!
-						}
-					}	//	if not filtered out
-					mLastTime = currentTime;
-				}	//	if  GetMessageGroup|GetMessageTime|GetMessageSeverity|GetMessageText OK
-			}	//	if MessageDestination != "none"
-			mReadIndex++;	//	On to the next message
-		} // while GetSequenceNumber OK
-		if (samplesPerSec)
-			AJATime::SleepInMicroseconds(1000000 / uint32_t(samplesPerSec));
+			const AJADebugMessage &	message (messages.at(ndx));
+			const AJADebugSeverity	severity (AJADebugSeverity(message.severity));
+			const AJADebugUnit		debugUnit (AJADebugUnit(message.groupIndex));
+			if (!mFirstTime)
+				mFirstTime = message.time;
+			const double currentTime (double(mTimeBase.MicrosecondsToSeconds(message.time - mFirstTime)));
+			const string & severityStr (dbgInfo.SeverityToString(severity));
+			const string	path (message.fileName);
+			const string	msg (message.messageText);
+			ostream &	outputStream (severity < sevThreshold ? cerr : cout);
+			if (formatStr.empty())
+				outputStream	<< DEC(message.sequenceNumber)
+								<< DLIM << DEC(message.pid)
+								<< DLIM << DEC(message.tid)
+								<< DLIM << currentTime
+								<< DLIM << dbgInfo.DebugUnitToString(debugUnit)
+								<< DLIM << severityStr
+								<< DLIM << path
+								<< DLIM << DEC(message.lineNumber)
+								<< DLIM << msg
+								<< endl;
+			else
+			{	//	Custom formatting:
+				string	outputString (formatStr);
+				aja::replace(outputString, kEscIndexNumber, NumToString(message.sequenceNumber));
+				aja::replace(outputString, kEscProcessID, NumToString(message.pid));
+				aja::replace(outputString, kEscThreadID, NumToString(message.tid));
+				aja::replace(outputString, kEscTimestamp, NumToString(currentTime));
+				aja::replace(outputString, kEscDebugUnit, dbgInfo.DebugUnitToString(debugUnit));
+				aja::replace(outputString, kEscSeverity, severityStr);
+				aja::replace(outputString, kEscLineNumber, NumToString(message.lineNumber));
+				aja::replace(outputString, kEscMessage, msg);
+				aja::replace(outputString, kEscPercent, "%");
+				FormatPaths(outputString, path);
+				outputStream	<< outputString;	//	User responsible for linebreaks!
+			}
+		}	//	for each message
+		AJADebug::WaitForMessage(mReadIndex, 250);	//	Sleep until the next message arrives
 	} while (true);	//	Loop til ctrl-c
+	return 0;
 
 }	//	main
@@ -0,0 +1,258 @@
+/* SPDX-License-Identifier: MIT */
+/**
+	@file		ntv2latency/main.cpp
+	@brief		Command-line tool that measures AutoCirculate capture, playout, pass-through and loopback latency,
+				DMA duration, VBI jitter and dropped/repeated frames, using CNTV2TimingRecorder.
+	@copyright	(C) 2022 AJA Video Systems, Inc.  All rights reserved.
+**/
+
+//	Includes
+#include "ajabase/common/options_popt.h"
+#include "ajabase/system/systemtime.h"
+#include "ntv2devicescanner.h"
+#include "ntv2devicefeatures.h"
+#include "ntv2signalrouter.h"
+#include "ntv2testpatterngen.h"
+#include "ntv2timingrecorder.h"
+#include "ntv2utils.h"
+#include <fstream>
+#include <signal.h>
+
+using namespace std;
+
+
+static bool	gGlobalQuit	(false);	//	Set this "true" to exit gracefully
+
+static void SignalHandler (int inSignal)
+{
+	(void) inSignal;
+	gGlobalQuit = true;
+}
+
+
+/**
+	@brief		Configures a FrameStore for capture from the SDI input of the same number, or playout to the SDI output
+				of the same number, and initializes AutoCirculate on it.
+	@return		True if successful;  otherwise false.
+**/
+static bool SetupChannel (CNTV2Card & inDevice, const NTV2Channel inChannel, const bool inIsInput,
+							const NTV2VideoFormat inVideoFormat, const NTV2PixelFormat inPixelFormat, const UWord inNumFrames)
+{
+	inDevice.AutoCirculateStop(inChannel);
+	if (!inDevice.EnableChannel(inChannel))
+		return false;
+	if (!inDevice.SetMode(inChannel, inIsInput ? NTV2_MODE_CAPTURE : NTV2_MODE_DISPLAY))
+		return false;
+	if (!inDevice.SetVideoFormat(inVideoFormat, false, false, inChannel))
+		return false;
+	if (!inDevice.SetFrameBufferFormat(inChannel, inPixelFormat))
+		return false;
+	if (::NTV2DeviceHasBiDirectionalSDI(inDevice.GetDeviceID()))
+		inDevice.SetSDITransmitEnable(inChannel, !inIsInput);
+	if (inIsInput)
+	{
+		if (!inDevice.Connect(::GetFrameStoreInputXptFromChannel(inChannel), ::GetSDIInputOutputXptFromChannel(inChannel)))
+			return false;
+		return inDevice.AutoCirculateInitForInput(inChannel, inNumFrames);
+	}
+	inDevice.SetSDIOutputStandard(UWord(inChannel), ::GetNTV2StandardFromVideoFormat(inVideoFormat));
+	if (!inDevice.Connect(::GetSDIOutputInputXpt(inChannel), ::GetFrameStoreOutputXptFromChannel(inChannel)))
+		return false;
+	return inDevice.AutoCirculateInitForOutput(inChannel, inNumFrames);
+}
+
+
+/**
+	@brief		Main entry point for 'ntv2latency'.
+	@param[in]	argc	Number arguments specified on the command line, including the path to the executable.
+	@param[in]	argv	Array of 'const char' pointers, one for each argument.
+	@return		Result code, which must be zero if successful, or non-zero for failure.
+**/
+int main (int argc, const char ** argv)
+{
+	int			showVersion		(0);
+	char *		pDeviceSpec		(AJA_NULL);	//	Which device?
+	char *		pCSVPath		(AJA_NULL);	//	Per-frame CSV output file
+	char *		pJSONPath		(AJA_NULL);	//	Summary JSON output file
+	int			inputNumber		(0);		//	Input channel/SDI connector (0 = none)
+	int			outputNumber	(0);		//	Output channel/SDI connector (0 = none)
+	int			numSeconds		(10);		//	How long to measure
+	int			numFrames		(7);		//	AutoCirculate frames per channel
+	int			passThrough		(0);		//	Play captured frames (instead of a counting test pattern)?
+	int			showHistograms	(0);		//	Print histograms?
+	poptContext	optionsContext;				//	Context for parsing command line arguments
+
+	//	Command line option descriptions:
+	const struct poptOption userOptionsTable [] =
+	{
+		{"version",		0,		POPT_ARG_NONE,		&showVersion,	0,	"show version & exit",				AJA_NULL				},
+		{"device",		'd',	POPT_ARG_STRING,	&pDeviceSpec,	0,	"device to use",					"index#|serial#|model"	},
+		{"input",		'i',	POPT_ARG_INT,		&inputNumber,	0,	"SDI input/channel to capture",		"1-8"					},
+		{"output",		'o',	POPT_ARG_INT,		&outputNumber,	0,	"SDI output/channel to play",		"1-8"					},
+		{"seconds",		's',	POPT_ARG_INT,		&numSeconds,	0,	"seconds to measure",				"1-3600"				},
+		{"frames",		'f',	POPT_ARG_INT,		&numFrames,		0,	"AutoCirculate frames per channel",	"2-60"					},
+		{"passthrough",	'p',	POPT_ARG_NONE,		&passThrough,	0,	"play captured frames",				AJA_NULL				},
+		{"histograms",	'H',	POPT_ARG_NONE,		&showHistograms,0,	"print histograms",					AJA_NULL				},
+		{"csv",			0,		POPT_ARG_STRING,	&pCSVPath,		0,	"write per-frame samples to CSV",	"path"					},
+		{"json",		0,		POPT_ARG_STRING,	&pJSONPath,		0,	"write summary to JSON",			"path"					},
+		POPT_AUTOHELP
+		POPT_TABLEEND
+	};
+
+	//	Read command line arguments...
+	optionsContext = ::poptGetContext (AJA_NULL, argc, argv, userOptionsTable, 0);
+	if (::poptGetNextOpt (optionsContext) < -1)
+		{cerr << "## ERROR:  Bad command line argument(s)" << endl;		return 1;}
+	optionsContext = ::poptFreeContext (optionsContext);
+	if (showVersion)
+		{cout << argv[0] << ", NTV2 SDK " << ::NTV2Version() << endl;  return 0;}
+
+	if (!inputNumber  &&  !outputNumber)
+		{cerr << "## ERROR:  Specify '--input', '--output', or both" << endl;  return 1;}
+	if (inputNumber < 0  ||  inputNumber > 8  ||  outputNumber < 0  ||  outputNumber > 8)
+		{cerr << "## ERROR:  Input/output must be 1 thru 8" << endl;  return 1;}
+	if (inputNumber  &&  inputNumber == outputNumber)
+		{cerr << "## ERROR:  Input and output must use different channels" << endl;  return 1;}
+	if (passThrough  &&  (!inputNumber  ||  !outputNumber))
+		{cerr << "## ERROR:  '--passthrough' requires '--input' and '--output'" << endl;  return 1;}
+	if (numSeconds < 1  ||  numSeconds > 3600  ||  numFrames < 2  ||  numFrames > 60)
+		{cerr << "## ERROR:  Bad '--seconds' or '--frames' value" << endl;  return 1;}
+
+	const string	deviceSpec	(pDeviceSpec ? pDeviceSpec : "0");
+	CNTV2Card		device;
+	if (!CNTV2DeviceScanner::GetFirstDeviceFromArgument (deviceSpec, device))
+		{cerr << "## ERROR:  Device '" << deviceSpec << "' not found" << endl;  return 2;}
+
+	const bool				doInput		(inputNumber > 0);
+	const bool				doOutput	(outputNumber > 0);
+	const bool				doLoopback	(doInput  &&  doOutput  &&  !passThrough);
+	const NTV2Channel		inChannel	(doInput ? NTV2Channel(inputNumber - 1) : NTV2_CHANNEL_INVALID);
+	const NTV2Channel		outChannel	(doOutput ? NTV2Channel(outputNumber - 1) : NTV2_CHANNEL_INVALID);
+	const NTV2PixelFormat	pixelFormat	(NTV2_FBF_8BIT_YCBCR);
+
+	//	Use the input signal's format, otherwise the output channel's current format...
+	NTV2VideoFormat videoFormat (NTV2_FORMAT_UNKNOWN);
+	if (doInput)
+		videoFormat = device.GetInputVideoFormat(::NTV2ChannelToInputSource(inChannel));
+	else
+		device.GetVideoFormat(videoFormat, outChannel);
+	if (!NTV2_IS_VALID_VIDEO_FORMAT(videoFormat))
+		{cerr << "## ERROR:  No video format" << (doInput ? " detected on input" : " on output channel") << endl;  return 2;}
+	const NTV2FormatDescriptor	fd (videoFormat, pixelFormat);
+
+	NTV2EveryFrameTaskMode savedTaskMode (NTV2_OEM_TASKS);
+	device.GetEveryFrameServices(savedTaskMode);
+	device.SetEveryFrameServices(NTV2_OEM_TASKS);
+	if (doInput  &&  !::SetupChannel(device, inChannel, true, videoFormat, pixelFormat, UWord(numFrames)))
+		{cerr << "## ERROR:  Unable to configure input channel " << inputNumber << endl;  device.SetEveryFrameServices(savedTaskMode);  return 3;}
+	if (doOutput  &&  !::SetupChannel(device, outChannel, false, videoFormat, pixelFormat, UWord(numFrames)))
+		{cerr << "## ERROR:  Unable to configure output channel " << outputNumber << endl;  device.SetEveryFrameServices(savedTaskMode);  return 3;}
+	if (doInput  &&  doOutput)
+		device.SetReference(::NTV2InputSourceToReferenceSource(::NTV2ChannelToInputSource(inChannel)));
+
+	CNTV2TimingRecorder	recorder;
+	if (doInput)
+		recorder.SetFrameRate(inChannel, ::GetNTV2FrameRateFromVideoFormat(videoFormat));
+	if (doOutput)
+		recorder.SetFrameRate(outChannel, ::GetNTV2FrameRateFromVideoFormat(videoFormat));
+
+	//	Host buffers...
+	NTV2Buffer	pattern (fd.GetTotalBytes()),  inBuffer (fd.GetTotalBytes()),  outBuffer (fd.GetTotalBytes());
+	NTV2TestPatternGen().DrawTestPattern(NTV2_TestPatt_ColorBars75, fd, pattern);
+	AUTOCIRCULATE_TRANSFER	inXfer, outXfer;
+	inXfer.SetVideoBuffer(reinterpret_cast<ULWord*>(inBuffer.GetHostPointer()), inBuffer.GetByteCount());
+	outXfer.SetVideoBuffer(reinterpret_cast<ULWord*>(outBuffer.GetHostPointer()), outBuffer.GetByteCount());
+
+	::signal (SIGINT, SignalHandler);
+	cout << "## NOTE:  Measuring " << ::NTV2VideoFormatToString(videoFormat) << (doInput ? " capture" : "")
+		<< (doOutput ? " playout" : "") << (doLoopback ? " loopback" : "") << (passThrough ? " pass-through" : "")
+		<< " for " << numSeconds << " seconds -- Ctrl-C to stop" << endl;
+	if (doInput)
+		device.AutoCirculateStart(inChannel);
+	if (doOutput)
+		device.AutoCirculateStart(outChannel);
+
+	const uint64_t	endTime			(AJATime::GetSystemMicroseconds() + uint64_t(numSeconds) * 1000000);
+	ULWord			outCounter		(0),  captureCounter(0),  loopbacks(0);
+	uint64_t		captureEndTime	(0);
+	bool			haveCapture		(false);
+	while (!gGlobalQuit  &&  AJATime::GetSystemMicroseconds() < endTime)
+	{
+		AUTOCIRCULATE_STATUS	acStatus;
+		bool					didWork	(false);
+
+		if (doInput  &&  device.AutoCirculateGetStatus(inChannel, acStatus)  &&  acStatus.HasAvailableInputFrame())
+		{
+			inXfer.acInUserCookie = captureCounter++;
+			const uint64_t startTime (AJATime::GetSystemMicroseconds());
+			if (device.AutoCirculateTransfer(inChannel, inXfer))
+			{
+				captureEndTime = AJATime::GetSystemMicroseconds();
+				recorder.RecordCaptureTransfer(inChannel, inXfer, startTime, captureEndTime);
+				haveCapture = true;
+				ULWord counter(0);
+				if (doLoopback  &&  CNTV2TimingRecorder::DecodeFrameCounter(inBuffer, fd, counter))
+					if (recorder.RecordLoopback(inChannel, outChannel, counter, inXfer))
+						loopbacks++;
+			}
+			didWork = true;
+		}
+
+		if (doOutput  &&  device.AutoCirculateGetStatus(outChannel, acStatus))
+		{
+			FRAME_STAMP	frameStamp;
+			if (acStatus.acActiveFrame >= 0  &&  device.AutoCirculateGetFrameStamp(outChannel, ULWord(acStatus.acActiveFrame), frameStamp))
+				recorder.RecordOutputFrameStamp(outChannel, frameStamp);
+			if (acStatus.CanAcceptMoreOutputFrames()  &&  (!passThrough  ||  haveCapture))
+			{
+				if (passThrough)
+					outBuffer.CopyFrom(inBuffer, 0, 0, inBuffer.GetByteCount());
+				else
+				{
+					outBuffer.CopyFrom(pattern, 0, 0, pattern.GetByteCount());
+					CNTV2TimingRecorder::EncodeFrameCounter(outBuffer, fd, outCounter);
+				}
+				outXfer.acInUserCookie = passThrough ? inXfer.acInUserCookie : outCounter;
+				outCounter++;
+				const uint64_t startTime (AJATime::GetSystemMicroseconds());
+				if (device.AutoCirculateTransfer(outChannel, outXfer))
+					recorder.RecordOutputTransfer(outChannel, outXfer, startTime, AJATime::GetSystemMicroseconds(),
+												passThrough ? captureEndTime : 0);
+				haveCapture = false;
+				didWork = true;
+			}
+		}
+
+		if (!didWork)
+		{
+			if (doInput)
+				device.WaitForInputVerticalInterrupt(inChannel);
+			else
+				device.WaitForOutputVerticalInterrupt(outChannel);
+		}
+	}	//	loop til done
+
+	if (doInput)
+		device.AutoCirculateStop(inChannel);
+	if (doOutput)
+		device.AutoCirculateStop(outChannel);
+	device.SetEveryFrameServices(savedTaskMode);
+
+	recorder.Print(cout, showHistograms ? true : false);
+	if (doLoopback  &&  !loopbacks)
+		cerr << "## WARNING:  No loopback frames detected -- is output " << outputNumber << " connected to input " << inputNumber << "?" << endl;
+	if (pCSVPath)
+	{
+		ofstream csv (pCSVPath);
+		if (!csv  ||  !recorder.WriteCSV(csv))
+			{cerr << "## ERROR:  Unable to write '" << pCSVPath << "'" << endl;  return 4;}
+	}
+	if (pJSONPath)
+	{
+		ofstream json (pJSONPath);
+		if (!json  ||  !recorder.WriteJSON(json))
+			{cerr << "## ERROR:  Unable to write '" << pJSONPath << "'" << endl;  return 4;}
+	}
+	return 0;
+
+}	//	main
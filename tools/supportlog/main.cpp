@@ -37,8 +37,8 @@ static void SignalHandler (int inSignal)
 
 int main(int argc, const char ** argv)
 {
-	char	*pDeviceSpec(AJA_NULL), *pInputFileName(AJA_NULL);
-	int		doStdout(0), doSDRAM(0), waitSeconds(0), forceLoad(0), isVerbose(0), showVersion(0);
+	char	*pDeviceSpec(AJA_NULL), *pInputFileName(AJA_NULL), *pExpandFileName(AJA_NULL);
+	int		doStdout(0), doSDRAM(0), doCompress(0), waitSeconds(0), forceLoad(0), isVerbose(0), showVersion(0);
 	CNTV2Card device;
 	poptContext	optionsContext;	//	Context for parsing command line arguments
 
@@ -51,6 +51,8 @@ int main(int argc, const char ** argv)
 		{"forceload",	'f',	POPT_ARG_NONE,		&forceLoad,			0,	"load onto different device",		AJA_NULL},
 		{"stdout",		's',	POPT_ARG_NONE,		&doStdout,			0,	"dump to stdout instead of file?",	AJA_NULL},
 		{"sdram",		'r',	POPT_ARG_NONE,		&doSDRAM,			0,	"dump device SDRAM to .raw file?",	AJA_NULL},
+		{"compress",	'c',	POPT_ARG_NONE,		&doCompress,		0,	"compress SDRAM dump to .rle file?",	AJA_NULL},
+		{"expand",		'x',	POPT_ARG_STRING,	&pExpandFileName,	0,	"expand .rle SDRAM dump to .raw file",	"path to .rle file"},
 		{"verbose",		'v',	POPT_ARG_NONE,		&isVerbose,			0,	"verbose mode?",					AJA_NULL},
 		{"wait",		'w',	POPT_ARG_INT,		&waitSeconds,		0,	"time to wait before capture",		"seconds"},
 		POPT_AUTOHELP
@@ -66,11 +68,22 @@ int main(int argc, const char ** argv)
 		{cout << argv[0] << ", NTV2 SDK " << ::NTV2Version() << endl;  return 0;}
 
 	const string inputFile (pInputFileName ? pInputFileName : "");
+	const string expandFile (pExpandFileName ? pExpandFileName : "");
+	if (!expandFile.empty())
+	{	//	Expanding a compressed SDRAM dump doesn't need a device...
+		string rawFile (expandFile.substr(0, expandFile.rfind('.')));
+		rawFile += ".raw";
+		if (!CNTV2SupportLogger::ExpandDeviceSDRAMDump (expandFile, rawFile, isVerbose ? cout : cerr))
+			return 1;
+		return 0;	//	Done!
+	}
 	const string deviceSpec	(pDeviceSpec ? pDeviceSpec : "0");
 	if (!CNTV2DeviceScanner::GetFirstDeviceFromArgument(deviceSpec, device))
 		{cerr << "## ERROR: Device '" << deviceSpec << "' failed to open or does not exist" << endl;  return 2;}
 	if (doStdout && doSDRAM)
 		{cerr << "## ERROR: '--stdout' and '--sdram' options conflict -- use one or the other, but not both" << endl;  return 2;}
+	if (doCompress && !doSDRAM)
+		{cerr << "## ERROR: '--compress' requires '--sdram'" << endl;  return 2;}
 	const string deviceName (CNTV2DeviceScanner::GetDeviceRefName(device));
 
 	::signal (SIGINT, SignalHandler);
@@ -113,7 +126,7 @@ int main(int argc, const char ** argv)
 	{	//	Write log to file...
 		ostringstream SupportLogFileName, RamDumpFileName;
 		SupportLogFileName << CNTV2SupportLogger::InventLogFilePathAndName(device);
-		RamDumpFileName << CNTV2SupportLogger::InventLogFilePathAndName(device, "aja_sdram", "raw");
+		RamDumpFileName << CNTV2SupportLogger::InventLogFilePathAndName(device, "aja_sdram", doCompress ? "rle" : "raw");
 		ofstream ofs(SupportLogFileName.str());
 		if (ofs)
 		{
@@ -123,11 +136,10 @@ int main(int argc, const char ** argv)
 		if (isVerbose)
 			cout << "## NOTE: Support log for device '" << deviceName << "' written to '" << SupportLogFileName.str() << "'" << endl;
 		if (doSDRAM)
-		{	ostringstream oss;
-			if (!CNTV2SupportLogger::DumpDeviceSDRAM (device, RamDumpFileName.str(), oss))
+		{	//	In verbose mode, show progress as the dump proceeds...
+			ostringstream oss;
+			if (!CNTV2SupportLogger::DumpDeviceSDRAM (device, RamDumpFileName.str(), isVerbose ? cout : oss, doCompress ? true : false))
 				cerr << oss.str();
-			else if (isVerbose  &&  !oss.str().empty())
-				cout << oss.str();
 		}
 	}
 	return 0;